@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include <windows.h>
+
+#include <nvapi.h>
+
+namespace nvcli {
+enum class NvApiId : NvU32 {
+#define NVCLI_NVAPI_ENTRY(fn) fn,
+#include "cli/nvapi_entries.h"
+#undef NVCLI_NVAPI_ENTRY
+  Count
+};
+
+// Table of NVAPI entry points. Commands call through NvApi() instead of the NvAPI_* free functions so the driver can
+// be swapped for a recording or replaying implementation.
+struct NvApiBackend {
+#define NVCLI_NVAPI_ENTRY(fn) decltype(&::fn) fn;
+#include "cli/nvapi_entries.h"
+#undef NVCLI_NVAPI_ENTRY
+};
+
+template <NvApiId Id> struct NvApiEntry;
+
+#define NVCLI_NVAPI_ENTRY(fn)                                                                                         \
+  template <> struct NvApiEntry<NvApiId::fn> {                                                                         \
+    using Fn = decltype(&::fn);                                                                                        \
+    static Fn &Slot(NvApiBackend &backend) { return backend.fn; }                                                      \
+  };
+#include "cli/nvapi_entries.h"
+#undef NVCLI_NVAPI_ENTRY
+
+const NvApiBackend &NvApi();
+// Installs a new active table and returns the one it replaces, so a layer can forward to it.
+NvApiBackend ReplaceNvApiBackend(const NvApiBackend &backend);
+const char *NvApiName(NvApiId id);
+bool SelectNvApiBackend(const char *spec);
+} // namespace nvcli
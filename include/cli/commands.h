@@ -7,6 +7,8 @@
 
 #include "cli/common.h"
 
+#include <unordered_map>
+
 namespace nvcli {
 void PrintGpuHeader(NvU32 index, NvPhysicalGpuHandle handle);
 void PrintBusInfo(NvPhysicalGpuHandle handle);
@@ -19,19 +21,35 @@ void PrintUtilizationInfo(NvPhysicalGpuHandle handle);
 void PrintClockInfo(NvPhysicalGpuHandle handle);
 void PrintCoolerInfo(NvPhysicalGpuHandle handle);
 void PrintHexBytes(const NvU8 *data, NvU32 size);
+// Reads an EDID dump of 1 to NV_EDID_DATA_SIZE_MAX bytes, prints the reason on failure.
+bool ReadEdidFile(const char *path, std::vector<NvU8> *out);
 double TimingRefreshHz(const NV_TIMING &timing);
+bool ParseInt(const char *text, NvS32 *out);
+bool ParseVfeVarOverrideType(const char *value, NvU8 *out);
+// Perf limit names by limit ID from NvAPI_GPU_PerfLimitsGetInfo, limits without a name are left out.
+NvAPI_Status LoadPerfLimitNames(NvPhysicalGpuHandle handle, std::unordered_map<NvU32, std::string> *names);
 const char *GsyncConnectorName(NVAPI_GSYNC_GPU_TOPOLOGY_CONNECTOR connector);
 bool GetGsyncHandleByIndex(NvU32 index, NvGSyncDeviceHandle *outHandle);
 const char *HdmiFrlRateName(NV_HDMI_FRL_RATE rate);
+const char *DpLinkRateName(NV_DP_LINK_RATE rate);
+const char *DpLaneCountName(NV_DP_LANE_COUNT lanes);
+const char *DpColorFormatName(NV_DP_COLOR_FORMAT format);
+const char *DpDynamicRangeName(NV_DP_DYNAMIC_RANGE range);
+const char *DpColorimetryName(NV_DP_COLORIMETRY colorimetry);
+const char *DpBpcName(NV_DP_BPC bpc);
 
 int CmdInfo();
 int CmdDisplayIds(int argc, char **argv);
 int CmdDisplayEdid(int argc, char **argv);
 int CmdDisplayTiming(int argc, char **argv);
+int CmdDisplaySnapshot(int argc, char **argv);
 int CmdDisplayList();
 int CmdDisplayGet(int argc, char **argv);
 int CmdDisplaySet(int argc, char **argv);
 int CmdDisplayCustom(int argc, char **argv);
+int CmdDisplayCustomCalc(int argc, char **argv);
+int CmdDisplayCustomValidate(int argc, char **argv);
+int CmdDisplayCustomSweep(int argc, char **argv);
 int CmdDisplayMonitorCaps(int argc, char **argv);
 int CmdDisplayMonitorColorCaps(int argc, char **argv);
 int CmdDisplayScaling(int argc, char **argv);
@@ -66,6 +84,11 @@ int CmdDrsSettingGet(int argc, char **argv);
 int CmdDrsSettingSet(int argc, char **argv);
 int CmdDrsProfileCreate(int argc, char **argv);
 int CmdDrsProfileDelete(int argc, char **argv);
+int CmdDrsApply(int argc, char **argv);
+int CmdDrsExport(int argc, char **argv);
+int CmdDrsImport(int argc, char **argv);
+int CmdDrsQuery(int argc, char **argv);
+int CmdDrsDiff(int argc, char **argv);
 int CmdDrs(int argc, char **argv);
 int CmdVideoColorGet(NvDisplayHandle handle, bool useDefault);
 int CmdVideoColorGet(int argc, char **argv, bool useDefault);
@@ -117,6 +140,8 @@ int CmdGpuVoltageControlSet(int argc, char **argv);
 int CmdGpuMemory(int argc, char **argv);
 int CmdGpuClocks(int argc, char **argv);
 int CmdGpuUtilization(int argc, char **argv);
+int CmdGpuSample(int argc, char **argv);
+int CmdGpuPmumon(int argc, char **argv);
 int CmdGpuDynamicPstatesSet(int argc, char **argv);
 int CmdGpuForcePstate(int argc, char **argv);
 int CmdGpuForcePstateEx(int argc, char **argv);
@@ -139,8 +164,16 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv);
 int CmdGpuPstates20Set(int argc, char **argv);
 int CmdGpuVfTables(int argc, char **argv);
 int CmdGpuVfInject(int argc, char **argv);
+int CmdGpuVfCurve(int argc, char **argv);
+int CmdGpuVfCompare(int argc, char **argv);
 int CmdGpuVf(int argc, char **argv);
 int CmdGpuOcScanner(int argc, char **argv);
+int CmdGpuTune(int argc, char **argv);
+int CmdGpuEnergyStart(int argc, char **argv);
+int CmdGpuEnergyRead(int argc, char **argv);
+int CmdGpuEnergyStop(int argc, char **argv);
+int CmdGpuEnergyRun(int argc, char **argv);
+int CmdGpuEnergy(int argc, char **argv);
 int CmdGpuVpstatesInfo(int argc, char **argv);
 int CmdGpuVpstatesControl(int argc, char **argv);
 int CmdGpuVpstatesSet(int argc, char **argv);
@@ -152,10 +185,12 @@ int CmdGpuVfeVar(int argc, char **argv);
 int CmdGpuVfeEqusInfo(int argc, char **argv);
 int CmdGpuVfeEqusControl(int argc, char **argv);
 int CmdGpuVfeEqusSet(int argc, char **argv);
+int CmdGpuVfeEqusEval(int argc, char **argv);
 int CmdGpuVfeEqu(int argc, char **argv);
 int CmdGpuPerfLimitsInfo(int argc, char **argv);
 int CmdGpuPerfLimitsStatus(int argc, char **argv);
 int CmdGpuPerfLimitsSet(int argc, char **argv);
+int CmdGpuPerfLimitsWatch(int argc, char **argv);
 int CmdGpuPerfLimits(int argc, char **argv);
 int CmdGpu(int argc, char **argv);
 int CmdDisplay(int argc, char **argv);
@@ -165,4 +200,11 @@ int CmdOgl(int argc, char **argv);
 int CmdVr(int argc, char **argv);
 int CmdStereo(int argc, char **argv);
 int CmdSys(int argc, char **argv);
+int RunCommand(int argc, char **argv);
+bool SplitCommandLine(const std::string &line, std::vector<std::string> &args);
+int CmdBatch(int argc, char **argv);
+int CmdServe(int argc, char **argv);
+int CmdBenchApi(int argc, char **argv);
+int CmdBench(int argc, char **argv);
+int CmdLog(int argc, char **argv);
 } // namespace nvcli
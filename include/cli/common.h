@@ -12,18 +12,40 @@
 #include <cctype>
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <string>
 #include <vector>
 
 #include <nvapi.h>
 
+#include "cli/backend.h"
+#include "cli/output.h"
+
 namespace nvcli {
 extern const char *kToolName;
 constexpr NvU32 kMaxDisplayPaths = 16;
 
 std::string NvapiStatusString(NvAPI_Status status);
 void PrintNvapiError(const char *prefix, NvAPI_Status status);
+
+// Prints one query result: the NVAPI error when status failed, otherwise `record` with a structured format and `text`
+// for the text format. Returns whether the call succeeded.
+template <typename RecordFn, typename TextFn>
+bool ReportResult(NvAPI_Status status, const char *errorPrefix, RecordFn &&record, TextFn &&text) {
+  if (status != NVAPI_OK) {
+    PrintNvapiError(errorPrefix, status);
+    return false;
+  }
+  if (StructuredOutput()) {
+    record();
+  } else {
+    text();
+  }
+  return true;
+}
+
 bool ParseUint(const char *text, NvU32 *out);
+bool ParseDoubleValue(const char *value, double *out);
 bool ParseSrcDevicePair(const char *text, NvU32 *srcId, NvU32 *device);
 bool GetDisplayHandleByIndex(NvU32 index, NvDisplayHandle *outHandle);
 double KBToMiB(NvU32 kb);
@@ -43,6 +65,9 @@ const char *ClockDomainIdName(NV_GPU_CLOCK_DOMAIN_ID domain);
 const char *ClockPstateUsageName(NV_GPU_CLOCK_INFO_DOMAIN_PSTATE_USAGE usage);
 const char *PerfLimitInputTypeName(NV_GPU_PERF_LIMIT_STATUS_INPUT_TYPE type);
 const char *PerfLimitPstatePointName(NV_GPU_PERF_LIMIT_INPUT_DATA_PSTATE_POINT point);
+// Name of an NV_GPU_PERF_POLICY_ID_SW bit, NULL for ids without one.
+const char *PerfPolicyName(NvU32 id);
+const char *PowerChannelRailName(NV_GPU_POWER_CHANNEL_POWER_RAIL rail);
 const char *VpstateTypeName(NV_GPU_PERF_VPSTATE_TYPE type);
 const char *VfeVarTypeName(NV_GPU_PERF_VFE_VAR_TYPE type);
 const char *VfeVarOverrideTypeName(NvU8 type);
@@ -61,9 +86,14 @@ bool ParsePerfVoltageDomainId(const char *value, NV_GPU_PERF_VOLTAGE_DOMAIN_ID *
 bool ParsePerfLimitInputType(const char *value, NV_GPU_PERF_LIMIT_STATUS_INPUT_TYPE *out);
 bool ParsePerfLimitPstatePoint(const char *value, NV_GPU_PERF_LIMIT_INPUT_DATA_PSTATE_POINT *out);
 std::string ToLowerAscii(const char *value);
+bool WildcardMatch(const char *pattern, const char *text);
 bool ParseBoolValue(const char *value, bool *out);
 bool Utf8ToNvUnicode(const char *input, NvAPI_UnicodeString out);
 std::string NvUnicodeToUtf8(const NvAPI_UnicodeString value);
+// Longest UTF-8 form of an NvAPI_UnicodeString, terminator included.
+constexpr size_t kNvUnicodeUtf8Max = NVAPI_UNICODE_STRING_MAX * 3 + 1;
+// Converts into a caller buffer for paths that must not allocate, returns out.
+const char *NvUnicodeToUtf8(const NvAPI_UnicodeString value, char (&out)[kNvUnicodeUtf8Max]);
 std::string GuidToString(const NvGUID &guid);
 const char *TargetViewModeName(NV_TARGET_VIEW_MODE mode);
 const char *MosaicTopoTypeName(NV_MOSAIC_TOPO_TYPE type);
@@ -71,6 +101,8 @@ const char *MosaicTopoName(NV_MOSAIC_TOPO topo);
 const char *GsyncDisplaySyncStateName(NVAPI_GSYNC_DISPLAY_SYNC_STATE state);
 const char *DpNodeTypeName(NV_DP_NODE_TYPE type);
 bool CollectGpus(bool hasIndex, NvU32 index, std::vector<NvPhysicalGpuHandle> &handles, std::vector<NvU32> &indices);
+void SetGpuJobs(NvU32 jobs);
+int ForEachGpu(size_t count, const std::function<int(size_t i)> &body);
 bool MaskE32Has(const NV_GPU_BOARDOBJGRP_MASK_E32 &mask, NvU32 index);
 bool MaskE255Has(const NV_GPU_BOARDOBJGRP_MASK_E255 &mask, NvU32 index);
 void PrintUsage();
@@ -90,12 +122,17 @@ const SubcommandEntry *FindSubcommand(const SubcommandEntry *entries, size_t cou
 int DispatchSubcommand(const char *group, int argc, char **argv, const SubcommandEntry *entries, size_t count,
                        void (*printUsage)());
 
+// Set when an NVAPI call timed out and is still running on another thread, the session then skips NvAPI_UnloadEx so the
+// library is not unloaded underneath it.
+void KeepNvApiLoaded();
+bool NvApiKeptLoaded();
+
 class NvApiSession {
 public:
-  NvApiSession() : m_status(NvAPI_InitializeEx(NV_DISPLAY_DRIVER)) {}
+  NvApiSession() : m_status(NvApi().NvAPI_InitializeEx(NV_DISPLAY_DRIVER)) {}
 
   ~NvApiSession() {
-    if (m_status == NVAPI_OK) { NvAPI_UnloadEx(NV_DISPLAY_DRIVER); }
+    if (m_status == NVAPI_OK && !NvApiKeptLoaded()) { NvApi().NvAPI_UnloadEx(NV_DISPLAY_DRIVER); }
   }
 
   bool ok() const { return m_status == NVAPI_OK; }
@@ -106,14 +143,25 @@ private:
   NvAPI_Status m_status;
 };
 
+// Offline commands start without an NvApiSession. DeferNvApi marks the process as such, RequireNvApi then loads
+// NVAPI on first use for the few lookups that still need the driver and is a no-op otherwise.
+void DeferNvApi();
+bool RequireNvApi();
+
+// Returns the DRS session kept open by long-running modes (serve), or NULL when every command opens its own.
+NvDRSSessionHandle ResidentDrsSession();
+void SetResidentDrsSession(NvDRSSessionHandle handle);
+
 class DrsSession {
 public:
-  DrsSession() : m_handle(NULL), m_status(NvAPI_DRS_CreateSession(&m_handle)) {
-    if (m_status == NVAPI_OK) { m_status = NvAPI_DRS_LoadSettings(m_handle); }
+  DrsSession() : m_handle(ResidentDrsSession()), m_status(NVAPI_OK), m_owned(m_handle == NULL) {
+    if (!m_owned) { return; }
+    m_status = NvApi().NvAPI_DRS_CreateSession(&m_handle);
+    if (m_status == NVAPI_OK) { m_status = NvApi().NvAPI_DRS_LoadSettings(m_handle); }
   }
 
   ~DrsSession() {
-    if (m_status == NVAPI_OK && m_handle) { NvAPI_DRS_DestroySession(m_handle); }
+    if (m_owned && m_status == NVAPI_OK && m_handle) { NvApi().NvAPI_DRS_DestroySession(m_handle); }
   }
 
   bool ok() const { return m_status == NVAPI_OK; }
@@ -122,8 +170,13 @@ public:
 
   NvDRSSessionHandle handle() const { return m_handle; }
 
+  // Drops unsaved changes. An owned session is destroyed without saving anyway, a resident one is reloaded so later
+  // commands do not see the discarded edits.
+  NvAPI_Status Revert() { return m_owned ? NVAPI_OK : NvApi().NvAPI_DRS_LoadSettings(m_handle); }
+
 private:
   NvDRSSessionHandle m_handle;
   NvAPI_Status m_status;
+  bool m_owned;
 };
 } // namespace nvcli
@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include "cli/common.h"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nvcli {
+// Plain copy of a DRS profile, filled from a loaded session or from an image file.
+struct DrsDbApp {
+  std::string name;
+  std::string friendlyName;
+  std::string launcher;
+  std::string fileInFolder;
+  std::string commandLine;
+  bool isPredefined;
+  bool isMetro;
+  bool isCommandLine;
+};
+
+struct DrsDbSetting {
+  NvU32 id;
+  std::string name;
+  NVDRS_SETTING_TYPE type;
+  // The current value is the driver default, not a user override.
+  bool isPredefined;
+  NvU32 dword;
+  std::string text;
+  std::vector<NvU8> binary;
+};
+
+struct DrsDbProfile {
+  std::string name;
+  bool isPredefined;
+  std::vector<DrsDbApp> apps;
+  std::vector<DrsDbSetting> settings;
+};
+
+void ToDrsDbSetting(const NVDRS_SETTING &setting, DrsDbSetting *out);
+// Short value text for listings: 0x%08X for DWORDs, quoted strings, binary[N].
+std::string DescribeDrsValue(const DrsDbSetting &setting);
+// STRING and WSTRING compare as the same type.
+bool SameDrsValue(const DrsDbSetting &a, const DrsDbSetting &b);
+
+// The part of NvAPI_DRS_GetProfileInfo the reader needs, small enough to keep per profile.
+struct DrsProfileHeader {
+  std::string name;
+  bool isPredefined = false;
+  NvU32 numOfApps = 0;
+  NvU32 numOfSettings = 0;
+};
+
+// Reads one profile with its applications and settings, the enumeration buffers are reused between calls.
+class DrsProfileReader {
+public:
+  explicit DrsProfileReader(NvDRSSessionHandle session) : m_session(session) {}
+
+  bool ReadHeader(NvDRSProfileHandle handle, DrsProfileHeader *out);
+  bool Read(NvDRSProfileHandle handle, DrsDbProfile *out);
+  // For callers that already hold the header, skips the GetProfileInfo call.
+  bool Read(NvDRSProfileHandle handle, const DrsProfileHeader &header, DrsDbProfile *out);
+
+private:
+  NvDRSSessionHandle m_session;
+  DrsProfileHeader m_header;
+  std::vector<NVDRS_APPLICATION> m_apps;
+  std::vector<NVDRS_SETTING> m_settings;
+};
+
+// Enumerates every profile with its applications and settings. visit returns false to stop early.
+bool ReadDrsSession(NvDRSSessionHandle session,
+                    const std::function<bool(const DrsDbProfile &, NvDRSProfileHandle)> &visit);
+
+// In-process copy of one session's profiles with hash lookups by profile name, application and setting. Load it
+// right after opening the DrsSession, every lookup afterwards runs without NVAPI calls (setting names that no profile
+// uses are resolved through NVAPI once and cached). Callers that change the session report it through the Set/Remove
+// methods so the index stays in step, it is not shared between sessions.
+class DrsIndex {
+public:
+  static constexpr size_t kNone = ~static_cast<size_t>(0);
+
+  bool Load(NvDRSSessionHandle session);
+
+  size_t size() const { return m_profiles.size(); }
+  const DrsDbProfile &profile(size_t index) const { return m_profiles[index]; }
+  NvDRSProfileHandle handle(size_t index) const { return m_handles[index]; }
+  // Deleted profiles keep their slot so indices stay stable.
+  bool removed(size_t index) const { return m_handles[index] == NULL; }
+
+  size_t FindProfile(const std::string &name) const;
+  // Profiles that list the executable, normally at most one.
+  const std::vector<size_t> &ProfilesForApp(const std::string &appName) const;
+  const DrsDbApp *FindApp(size_t profile, const std::string &appName) const;
+  const DrsDbSetting *FindSetting(size_t profile, NvU32 id) const;
+  bool SettingId(const std::string &name, NvU32 *id);
+
+  size_t AddProfile(const std::string &name, NvDRSProfileHandle handle);
+  void RemoveProfile(size_t profile);
+  void SetApp(size_t profile, const DrsDbApp &app);
+  void RemoveApp(size_t profile, const std::string &appName);
+  void SetSetting(size_t profile, const DrsDbSetting &setting);
+  void RemoveSetting(size_t profile, NvU32 id);
+
+private:
+  void IndexProfile(size_t profile);
+  void IndexSettingName(const DrsDbSetting &setting);
+
+  std::vector<DrsDbProfile> m_profiles;
+  std::vector<NvDRSProfileHandle> m_handles;
+  std::vector<std::unordered_map<NvU32, size_t>> m_settingSlots;
+  std::unordered_map<std::string, size_t> m_profileByName;
+  std::unordered_map<std::string, std::vector<size_t>> m_appOwners;
+  std::unordered_map<std::string, NvU32> m_settingIds;
+};
+
+// Binary image of a DRS database: the profile records in enumeration order, a string table shared by every name and
+// string value, and an open-addressing hash index over the case-folded profile names.
+class DrsImageWriter {
+public:
+  DrsImageWriter() = default;
+  ~DrsImageWriter();
+
+  DrsImageWriter(const DrsImageWriter &) = delete;
+  DrsImageWriter &operator=(const DrsImageWriter &) = delete;
+
+  // Writes to path.tmp, Close renames it over path once the image is complete. A writer destroyed without a
+  // successful Close removes the temporary file and leaves path untouched.
+  bool Open(const char *path, NvU32 driverVersion, const char *branch);
+  // Profiles are written as they are added, only the string table and the index are held until Close.
+  bool Add(const DrsDbProfile &profile);
+  bool Close();
+
+private:
+  NvU32 AddString(const std::string &text);
+
+  FILE *m_file = nullptr;
+  std::string m_path;
+  std::string m_tempPath;
+  NvU64 m_offset = 0;
+  NvU32 m_driverVersion = 0;
+  NvU32 m_branch = 0;
+  std::vector<char> m_strings;
+  std::unordered_map<std::string, NvU32> m_stringIndex;
+  std::vector<std::pair<NvU32, NvU64>> m_profiles;
+  std::vector<NvU8> m_record;
+  bool m_failed = false;
+};
+
+class DrsImage {
+public:
+  // Reads the whole image into memory, later lookups do not touch the file.
+  bool Open(const char *path);
+
+  NvU32 driverVersion() const { return m_driverVersion; }
+  const char *branch() const { return String(m_branch); }
+  NvU32 profileCount() const { return m_profileCount; }
+
+  bool FindProfile(const char *name, DrsDbProfile *out) const;
+  // Decodes every profile in the order they were exported.
+  bool ReadProfiles(std::vector<DrsDbProfile> *out) const;
+  // Name and record offset of every profile, taken from the hash index without decoding any record, in bucket order.
+  bool ListProfiles(std::vector<std::pair<const char *, NvU64>> *out) const;
+  bool ReadProfile(NvU64 offset, DrsDbProfile *out) const { return DecodeProfile(offset, out, nullptr); }
+
+private:
+  const char *String(NvU32 offset) const;
+  bool DecodeProfile(NvU64 offset, DrsDbProfile *out, NvU64 *next) const;
+
+  std::vector<NvU8> m_data;
+  NvU32 m_driverVersion = 0;
+  NvU32 m_branch = 0;
+  NvU32 m_profileCount = 0;
+  NvU64 m_recordsEnd = 0;
+  NvU64 m_stringsOffset = 0;
+  NvU64 m_stringsSize = 0;
+  NvU64 m_indexOffset = 0;
+  NvU32 m_indexBuckets = 0;
+};
+
+// Desired state for drs apply and drs import. Entries with remove set are deleted when present.
+struct DrsManifestApp {
+  DrsDbApp app;
+  bool remove;
+  NvU32 line;
+};
+
+// A setting given by name keeps it in setting.name until ApplyDrsManifest resolves the id through the index.
+struct DrsManifestSetting {
+  DrsDbSetting setting;
+  bool remove;
+  bool byName;
+  NvU32 line;
+};
+
+struct DrsManifestProfile {
+  std::string name;
+  bool remove;
+  NvU32 line;
+  std::vector<DrsManifestApp> apps;
+  std::vector<DrsManifestSetting> settings;
+};
+
+// Applies the manifest in one session with a single NvAPI_DRS_SaveSettings, nothing is saved if any step fails. With
+// prune, user profiles, applications and setting overrides the manifest does not mention are removed as well.
+int ApplyDrsManifest(const char *source, std::vector<DrsManifestProfile> profiles, bool dryRun, bool prune);
+} // namespace nvcli
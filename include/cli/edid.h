@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <nvapi.h>
+
+namespace nvcli {
+// Decoded EDID base block with its CTA-861 and DisplayID extensions. The decoder only reads the bytes it is given, it
+// makes no NVAPI calls, so EDID dumps can be decoded without a GPU.
+enum EdidTimingSource : NvU8 { kEdidSourceBase = 0, kEdidSourceCta = 1, kEdidSourceDisplayId = 2 };
+
+struct EdidTiming {
+  NvU32 pixelClockKhz;
+  NvU16 hActive;
+  NvU16 hFrontPorch;
+  NvU16 hSync;
+  NvU16 hBlank;
+  NvU16 vActive;
+  NvU16 vFrontPorch;
+  NvU16 vSync;
+  NvU16 vBlank;
+  NvU16 widthMm;
+  NvU16 heightMm;
+  bool interlaced;
+  bool hSyncPositive;
+  bool vSyncPositive;
+  bool preferred;
+  NvU8 source;
+};
+
+struct EdidStandardTiming {
+  NvU16 width;
+  NvU16 height;
+  NvU8 refreshHz;
+};
+
+// Refresh range a sink accepts, from the range limits descriptor, the HDMI Forum VSDB, the AMD VSDB or a DisplayID
+// range limits block.
+struct EdidVrrRange {
+  std::string source;
+  NvU16 minHz;
+  NvU16 maxHz;
+};
+
+struct EdidInfo {
+  NvU32 size;
+  NvU8 extensionCount;
+  std::string manufacturer;
+  NvU16 productCode;
+  NvU32 serialNumber;
+  NvU8 week;
+  NvU16 year;
+  bool modelYear;
+  NvU8 version;
+  NvU8 revision;
+  std::string name;
+  std::string serialText;
+  bool digital;
+  // Bits per color, 0 when not defined.
+  NvU8 bitDepth;
+  NvU8 interfaceType;
+  NvU8 widthCm;
+  NvU8 heightCm;
+  // Gamma * 100, 0 when not defined.
+  NvU16 gamma100;
+  // Red, green, blue and white x/y as 10-bit fractions of 1024.
+  NvU16 chromaticity[8];
+  NvU32 establishedTimings;
+  std::vector<EdidStandardTiming> standardTimings;
+  std::vector<EdidTiming> timings;
+
+  bool hasRangeLimits;
+  NvU16 rangeMinVHz;
+  NvU16 rangeMaxVHz;
+  NvU16 rangeMinHKhz;
+  NvU16 rangeMaxHKhz;
+  NvU16 rangeMaxPixelClockMhz;
+
+  bool hasCta;
+  NvU8 ctaRevision;
+  bool underscan;
+  bool basicAudio;
+  bool ycbcr444;
+  bool ycbcr422;
+  std::vector<NvU8> vics;
+  NvU8 nativeVic;
+  std::vector<NvU8> ycbcr420Vics;
+  NvU8 audioDescriptors;
+
+  bool hdmi;
+  NvU16 physicalAddress;
+  NvU16 hdmiMaxTmdsMhz;
+  bool hdmiForum;
+  NvU16 hfMaxTmdsMhz;
+  bool scdc;
+  bool allm;
+  // Max_FRL_Rate code: 0 TMDS only, 1 3G x3, 2 6G x3, 3 6G x4, 4 8G x4, 5 10G x4, 6 12G x4.
+  NvU8 maxFrlRate;
+
+  bool hasHdrStaticMetadata;
+  // Bit 0 SDR, 1 HDR gamma, 2 SMPTE ST 2084, 3 HLG.
+  NvU8 eotfMask;
+  NvU8 staticMetadataMask;
+  // Raw code values, 0 when the optional byte is absent.
+  NvU8 maxLuminanceCode;
+  NvU8 maxFrameAverageCode;
+  NvU8 minLuminanceCode;
+  bool hasHdrDynamicMetadata;
+  // CTA colorimetry bits 0..7, bit 8 ICtCp, bit 9 DCI-P3.
+  NvU16 colorimetryMask;
+
+  bool dsc;
+  bool dscNative420;
+  bool dscAllBpp;
+  // Bitmask of 10, 12 and 16 bpc support in bits 0..2.
+  NvU8 dscBpcMask;
+  // DSC_Max_Slices and DSC_Max_FRL_Rate codes from the HF-VSDB.
+  NvU8 dscMaxSlicesCode;
+  NvU8 dscMaxFrlRate;
+  NvU8 dscTotalChunkKBytes;
+
+  std::vector<EdidVrrRange> vrr;
+
+  bool hasDisplayId;
+  NvU8 displayIdVersion;
+  bool tiled;
+  NvU8 tilesH;
+  NvU8 tilesV;
+  NvU8 tileX;
+  NvU8 tileY;
+  NvU16 tileWidth;
+  NvU16 tileHeight;
+
+  // Checksum errors, truncated blocks and unknown extensions. The rest of the EDID is still decoded.
+  std::vector<std::string> problems;
+};
+
+// Returns false only when the data is not an EDID (short or missing the base block header).
+bool DecodeEdid(const NvU8 *data, NvU32 size, EdidInfo *out);
+
+// FNV-1a 64 over the raw bytes, the cache key for decoded EDIDs.
+NvU64 EdidHash(const NvU8 *data, NvU32 size);
+
+double EdidTimingRefreshHz(const EdidTiming &timing);
+// Nits from the CTA HDR static metadata code values.
+double EdidMaxLuminance(NvU8 code);
+double EdidMinLuminance(NvU8 maxCode, NvU8 minCode);
+
+// Last EDID seen for one display, used to skip the full fetch when nothing changed.
+struct EdidDisplayRecord {
+  NvU32 edidId;
+  NvU32 size;
+  NvU64 prefixHash;
+  NvU64 hash;
+};
+
+// Directory of decoded EDIDs keyed by hash (<hash>.edc), plus one small record per display and EDID flag. Each cache
+// file holds the raw EDID next to the decoded form and is only used when the raw bytes match, a file written by an
+// older decoder version is ignored and rewritten.
+class EdidCache {
+public:
+  bool Open(const char *dir);
+
+  bool Load(NvU64 hash, const NvU8 *data, NvU32 dataSize, NvU32 totalSize, EdidInfo *out) const;
+  bool Store(NvU64 hash, const NvU8 *data, NvU32 size, const EdidInfo &info) const;
+
+  bool LoadDisplay(NvU32 displayId, NvU32 flag, EdidDisplayRecord *out) const;
+  bool StoreDisplay(NvU32 displayId, NvU32 flag, const EdidDisplayRecord &record) const;
+
+private:
+  std::string m_dir;
+};
+} // namespace nvcli
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+// NVAPI entry points routed through NvApiBackend. Included repeatedly with NVCLI_NVAPI_ENTRY defined, so there is
+// no include guard. Entry points that need D3D interface types (NvAPI_D3D_*, stereo shader constants) are called
+// directly from d3d.cpp and stereo.cpp and are not listed here.
+
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_BpcConfiguration)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_DeleteCustomDisplay)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_DisableDirectMode)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_EnableDirectMode)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_EnumCustomDisplay)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_EnumHDMIStereoModes)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_EnumerateDirectModeDisplays)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetDirectModeDisplayHandleFromDisplayId)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetDisplayBlankingState)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetDisplayHandleFromDisplayId)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetDisplayIdByDisplayName)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetDisplayIdFromDirectModeDisplayHandle)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetDisplayIdFromDisplayHandle)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetFeatureConfig)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetGDIPrimaryDisplayId)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetHDMIStereoSettings)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetMonitorCapabilities)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetMonitorColorCapabilities)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetScalingCaps)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetScalingCapsOverride)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetTiming)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetTimingInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetViewPortInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_GetWideColorRange)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_RevertCustomDisplayTrial)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_SaveCustomDisplay)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_SetDisplayBlankingState)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_SetFeatureConfig)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_SetHDMIStereoSettings)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_SetScalingCapsOverride)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_SetViewPortInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_SetWideColorRange)
+NVCLI_NVAPI_ENTRY(NvAPI_DISP_TryCustomDisplay)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_CreateApplication)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_CreateProfile)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_CreateSession)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_DeleteApplication)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_DeleteProfile)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_DeleteProfileSetting)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_DestroySession)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_EnumApplications)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_EnumProfiles)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_EnumSettings)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_FindProfileByName)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_GetApplicationInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_GetNumProfiles)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_GetProfileInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_GetSetting)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_GetSettingIdFromName)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_LoadSettings)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_SaveSettings)
+NVCLI_NVAPI_ENTRY(NvAPI_DRS_SetSetting)
+NVCLI_NVAPI_ENTRY(NvAPI_Disp_GetHdrCapabilities)
+NVCLI_NVAPI_ENTRY(NvAPI_Disp_HdrColorControl)
+NVCLI_NVAPI_ENTRY(NvAPI_Disp_HdrSessionControl)
+NVCLI_NVAPI_ENTRY(NvAPI_EnumLogicalGPUs)
+NVCLI_NVAPI_ENTRY(NvAPI_EnumNvidiaDisplayHandle)
+NVCLI_NVAPI_ENTRY(NvAPI_EnumPhysicalGPUs)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClearPCIELinkAERInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClearPCIELinkErrorInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanArbitersGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanArbitersGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanArbitersGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanArbitersSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanCoolersGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanCoolersGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanCoolersGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanCoolersSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanPoliciesGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanPoliciesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanPoliciesGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientFanPoliciesSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientIllumDevicesGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientIllumDevicesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientIllumDevicesSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientIllumZonesGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientIllumZonesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientIllumZonesSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientPowerPoliciesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientPowerPoliciesGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientPowerPoliciesSetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientPowerTopologyGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientPowerTopologyGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientRevertOc)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientStartOcScanner)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientStopOcScanner)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientThermalPoliciesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientThermalPoliciesGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClientThermalPoliciesSetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockAdcDevicesGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockAdcDevicesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockAdcDevicesGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockAdcDevicesSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClientClkDomainsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClientClkVfPointsGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClientClkVfPointsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClientClkVfPointsGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClientClkVfPointsSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkDomainFreqsEnum)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkDomainRpc)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkDomainsGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkDomainsGetFreqInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkDomainsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkDomainsSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkEnumsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkFreqControllerGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkFreqControllerGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkFreqControllersGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkFreqControllersSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkProgsGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkProgsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkProgsGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkProgsSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkPropRegimesGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkPropRegimesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkPropRegimesSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkPropTopRelsGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkPropTopRelsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkPropTopRelsSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkPropTopsGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkPropTopsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkPropTopsGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkPropTopsSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVfPointsGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVfPointsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVfPointsGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVfPointsSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVfRelsGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVfRelsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVfRelsGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVfRelsSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVoltControllerGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVoltControllerGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVoltControllersGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockClkVoltControllersSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockCounterMeasureAvgFreq)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockNafllDevicesGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockNafllDevicesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockNafllDevicesGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockNafllDevicesSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ClockPmumonClkDomainsGetSamples)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ControlASPM)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_EnableDynamicPstates)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanArbiterGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanArbiterGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanCoolerGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanCoolerGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanCoolerGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanCoolerSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanPmumonFanCoolersGetSamples)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanPolicyGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanPolicyGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanPolicyGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanPolicySetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_FanTestGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ForceGC6Exit)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GC6Control)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetAllClockFrequencies)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetAllDisplayIds)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetBarInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetBoardInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetBusId)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetBusSlotId)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetBusType)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetConnectedDisplayIds)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetConnectedSLIOutputs)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetCoolerPolicyTable)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetCoolerSettings)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetCoreVoltage)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetCoreVoltageControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetCurrentPstate)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetCurrentThermalLevel)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetDeepIdleState)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetDeepIdleStatistics)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetDynamicPstatesInfoEx)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetECCConfigurationInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetECCErrorInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetECCErrorInfoEx)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetECCStatusInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetEdidEx)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetEdidEx2)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetFullName)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetIRQ)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetMemoryInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetPCIEInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetPCIELinkSwitchErrorInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetPCIIdentifiers)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetPerfLimit)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetPhysicalFrameBufferSize)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetPowerConnectorStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetPstates20)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetPstates20Private)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetRamBankCount)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetRamBusWidth)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetRamType)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetSerialNumber)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetSupportedSLIViews)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetTachReading)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetThermalSettings)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetThermalSimulationMode)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetThermalSlowdownState)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetVbiosOEMRevision)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetVbiosRevision)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetVbiosVersionString)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetVirtualFrameBufferSize)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetVoltageDomainsInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetVoltageDomainsStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_GetVoltages)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_Get_DisplayPort_DongleInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ManufacturingInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfLimitsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfLimitsGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfLimitsSetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfPmumonPerfPoliciesGetSamples)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfPoliciesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfPoliciesGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVfChangeInject)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVfTablesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVfeEquGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVfeEquGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVfeEquSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVfeVarGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVfeVarGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVfeVarSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVpstatesGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVpstatesGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PerfVpstatesSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerCappingGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerCappingSlowdownGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerDeviceGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerDeviceGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerLeakageGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerLeakageGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerMonitorGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerMonitorGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerPolicyGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerPolicyGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerPolicyGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_PowerPolicySetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_QueryDPTopology)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ResetECCErrorInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_RestoreCoolerPolicyTable)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_RestoreCoolerSettings)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetCoolerLevels)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetCoolerPolicyTable)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetCoreVoltageControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetCurrentPCIESpeed)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetCurrentPCIEWidth)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetDeepIdleState)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetDeepIdleStatisticsMode)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetECCConfiguration)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetForcePstate)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetForcePstateEx)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetPerfLimit)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetPstates20)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetPstates20Private)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetThermalSimulationMode)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_SetThermalSlowdownState)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermChannelGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermChannelGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermChannelGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermChannelSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermDeviceGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermHwFsSlowdownAmountGet)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermMonitorsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermMonitorsGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermalHwFsGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermalHwFsSetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermalPmumonThermChannelsGetSamples)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermalPolicyGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermalPolicyGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermalPolicyGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GPU_ThermalPolicySetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_GSync_DisableSync)
+NVCLI_NVAPI_ENTRY(NvAPI_GSync_EnableSync)
+NVCLI_NVAPI_ENTRY(NvAPI_GSync_EnumSyncDevices)
+NVCLI_NVAPI_ENTRY(NvAPI_GSync_GetControlParameters)
+NVCLI_NVAPI_ENTRY(NvAPI_GSync_GetStatusParameters)
+NVCLI_NVAPI_ENTRY(NvAPI_GSync_GetSyncStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_GSync_GetTopology)
+NVCLI_NVAPI_ENTRY(NvAPI_GSync_QueryCapabilities)
+NVCLI_NVAPI_ENTRY(NvAPI_GSync_SetControlParameters)
+NVCLI_NVAPI_ENTRY(NvAPI_GSync_SetSyncStateSettings)
+NVCLI_NVAPI_ENTRY(NvAPI_GetAssociatedDisplayOutputId)
+NVCLI_NVAPI_ENTRY(NvAPI_GetAssociatedNvidiaDisplayName)
+NVCLI_NVAPI_ENTRY(NvAPI_GetDisplayPortInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GetDisplaySettings)
+NVCLI_NVAPI_ENTRY(NvAPI_GetErrorMessage)
+NVCLI_NVAPI_ENTRY(NvAPI_GetHDMISupportInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_GetHdcpHdmiDiagnostics)
+NVCLI_NVAPI_ENTRY(NvAPI_GetInterfaceVersionString)
+NVCLI_NVAPI_ENTRY(NvAPI_GetLogicalGPUFromPhysicalGPU)
+NVCLI_NVAPI_ENTRY(NvAPI_GetPhysicalGPUsFromLogicalGPU)
+NVCLI_NVAPI_ENTRY(NvAPI_InitializeEx)
+NVCLI_NVAPI_ENTRY(NvAPI_Mosaic_EnableCurrentTopo)
+NVCLI_NVAPI_ENTRY(NvAPI_Mosaic_GetCurrentTopo)
+NVCLI_NVAPI_ENTRY(NvAPI_Mosaic_GetDisplayCapabilities)
+NVCLI_NVAPI_ENTRY(NvAPI_Mosaic_GetSingleGpuMosaicCaps)
+NVCLI_NVAPI_ENTRY(NvAPI_Mosaic_GetSupportedTopoInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_OGL_ExpertModeDefaultsGet)
+NVCLI_NVAPI_ENTRY(NvAPI_OGL_ExpertModeDefaultsSet)
+NVCLI_NVAPI_ENTRY(NvAPI_OGL_ExpertModeGet)
+NVCLI_NVAPI_ENTRY(NvAPI_OGL_ExpertModeSet)
+NVCLI_NVAPI_ENTRY(NvAPI_PCF_MasterGetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_PCF_MasterGetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_PCF_MasterGetStatus)
+NVCLI_NVAPI_ENTRY(NvAPI_PCF_MasterSetControl)
+NVCLI_NVAPI_ENTRY(NvAPI_SYS_GetChipSetSliBondInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_SYS_GetDriverAndBranchVersion)
+NVCLI_NVAPI_ENTRY(NvAPI_SYS_GetGpuCount)
+NVCLI_NVAPI_ENTRY(NvAPI_SYS_GetSMPInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_SetDisplayPort)
+NVCLI_NVAPI_ENTRY(NvAPI_SetDisplaySettings)
+NVCLI_NVAPI_ENTRY(NvAPI_SetHDMIAudioStreamMute)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_Activate)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_AppHandShake)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_CaptureJpegImage)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_CapturePngImage)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_CreateConfigurationProfileRegistryKey)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_Deactivate)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_Debug_WasLastDrawStereoized)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_DecreaseConvergence)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_DecreaseSeparation)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_DeleteConfigurationProfileRegistryKey)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_DeleteConfigurationProfileValue)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_DestroyHandle)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_Disable)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_DongleControl)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_Dongle_Status)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_Enable)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_ForceToScreenDepth)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetAppInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetConvergence)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetCursorSeparation)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetDefaultProfile)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetEyeSeparation)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetFrustumAdjustMode)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetInfo)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetSeparation)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetStereoCaps)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetStereoCapsInternal)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetStereoDiag)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetStereoSupport)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetSurfaceCreationMode)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_GetWindowedMode)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_HandShake_Message_Control)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_HandShake_Trigger_Activation)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_IncreaseConvergence)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_IncreaseSeparation)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_InitActivation)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_Is3DCursorSupported)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_IsAccessoryDisplayEnabled)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_IsActivated)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_IsDisplayAegisDTType)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_IsEnabled)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_IsWindowedModeSupported)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_ModeEnumControl)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_ReverseStereoBlitControl)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetActiveEye)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetConfigurationProfileValue)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetConvergence)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetCursorSeparation)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetDefaultProfile)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetDriverMode)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetFrustumAdjustMode)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetNotificationMessage)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetSeparation)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetSurfaceCreationMode)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetVideoControl)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetVideoMetadata)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_SetWindowedMode)
+NVCLI_NVAPI_ENTRY(NvAPI_Stereo_Trigger_Activation)
+NVCLI_NVAPI_ENTRY(NvAPI_UnloadEx)
+NVCLI_NVAPI_ENTRY(NvAPI_Video_ColorControl_Get)
+NVCLI_NVAPI_ENTRY(NvAPI_Video_ColorControl_GetDefault)
+NVCLI_NVAPI_ENTRY(NvAPI_Video_ColorControl_Set)
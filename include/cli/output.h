@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <nvapi.h>
+
+namespace nvcli {
+enum class OutputFormat { Text, Json, Ndjson, Csv };
+
+constexpr size_t kMaxRecordSize = 4096;
+
+bool ParseOutputFormat(const char *value, OutputFormat *out);
+void SetOutputFormat(OutputFormat format);
+OutputFormat GetOutputFormat();
+bool StructuredOutput();
+
+// Writes to stdout, or to the buffer of the innermost OutputCapture active on the calling thread. With a structured
+// format every completed line becomes a "text" record.
+int Printf(const char *format, ...);
+
+// Writes output previously collected by an OutputCapture to the current destination without re-wrapping it.
+void WriteOutput(const std::string &data);
+
+// Closes the stdout stream (the JSON array, pending text) at process exit.
+void FinishOutput();
+
+// Turns a captured record stream into a complete document in the selected format, used for serve responses.
+void FinishCapturedOutput(std::string *output);
+
+// One CSV field, quoted with embedded quotes doubled when it holds a comma, quote or line break. For files a command
+// writes itself, record output is escaped by RecordWriter.
+std::string CsvField(const char *value);
+
+// GPU index added to every record written by the calling thread, set by PrintGpuHeader.
+void SetRecordGpu(NvU32 index);
+void ClearRecordGpu();
+
+// Start of a Printf line held until its newline while a structured format is selected.
+struct PendingText {
+  char data[kMaxRecordSize];
+  size_t size = 0;
+};
+
+class OutputCapture {
+public:
+  explicit OutputCapture(std::string *buffer);
+  ~OutputCapture();
+
+  OutputCapture(const OutputCapture &) = delete;
+  OutputCapture &operator=(const OutputCapture &) = delete;
+
+private:
+  std::string *m_previous;
+  std::mutex *m_previousLock;
+  PendingText m_previousPending;
+};
+
+// Hands the calling thread's destination to threads it starts: while a Worker lives on a thread, its Printf and records
+// go where the creator's would, into the creator's OutputCapture when one is active, with every append to that buffer
+// serialized. Create the share before the threads and keep it until they are joined.
+class OutputShare {
+public:
+  OutputShare();
+  ~OutputShare();
+
+  OutputShare(const OutputShare &) = delete;
+  OutputShare &operator=(const OutputShare &) = delete;
+
+  class Worker {
+  public:
+    explicit Worker(OutputShare &share);
+    ~Worker();
+
+    Worker(const Worker &) = delete;
+    Worker &operator=(const Worker &) = delete;
+
+  private:
+    std::string *m_previous;
+    std::mutex *m_previousLock;
+    PendingText m_previousPending;
+  };
+
+private:
+  std::string *m_buffer;
+  std::mutex m_lock;
+  std::mutex *m_sharedLock;
+  std::mutex *m_previousLock;
+};
+
+// Starts every text line the calling thread prints with prefix, captured or not, so several threads can stream their
+// lines at once and each line still says where it came from. Structured records carry the GPU through SetRecordGpu
+// instead.
+class OutputLinePrefix {
+public:
+  explicit OutputLinePrefix(const std::string &prefix);
+  ~OutputLinePrefix();
+
+  OutputLinePrefix(const OutputLinePrefix &) = delete;
+  OutputLinePrefix &operator=(const OutputLinePrefix &) = delete;
+
+private:
+  std::string m_previous;
+};
+
+// Applies the JSON array framing to a stream of records on one destination and splits CSV into one table per record
+// type. The first table is streamed, rows of every other header are held and written as their own tables by Finish().
+class OutputFramer {
+public:
+  explicit OutputFramer(FILE *file) : m_file(file), m_buffer(nullptr) {}
+  explicit OutputFramer(std::string *buffer) : m_file(nullptr), m_buffer(buffer) {}
+
+  OutputFramer(const OutputFramer &) = delete;
+  OutputFramer &operator=(const OutputFramer &) = delete;
+
+  void Write(const char *data, size_t size);
+  void Finish();
+
+private:
+  struct CsvTable {
+    std::string header;
+    std::string rows;
+  };
+
+  void Put(const char *data, size_t size);
+  void PutCsvLine(const char *data, size_t size);
+
+  FILE *m_file;
+  std::string *m_buffer;
+  bool m_started = false;
+  char m_header[kMaxRecordSize];
+  size_t m_headerSize = 0;
+  std::vector<CsvTable> m_tables;
+  // Table the rows after the last header go to, SIZE_MAX for the streamed one.
+  size_t m_table = SIZE_MAX;
+};
+
+// Builds one record in fixed buffers and emits it on End() or destruction, a record that got no fields is dropped.
+// Inactive (every call a no-op) when the output format is text, so callers keep their Printf path for that case.
+class RecordWriter {
+public:
+  explicit RecordWriter(const char *type, OutputFramer *target = nullptr);
+  ~RecordWriter() { End(); }
+
+  RecordWriter(const RecordWriter &) = delete;
+  RecordWriter &operator=(const RecordWriter &) = delete;
+
+  bool active() const { return m_active; }
+
+  RecordWriter &Field(const char *key, const char *value);
+  RecordWriter &Field(const char *key, const std::string &value) { return Field(key, value.c_str()); }
+  RecordWriter &Field(const char *key, NvU32 value);
+  RecordWriter &Field(const char *key, NvS32 value);
+  RecordWriter &Field(const char *key, NvU64 value);
+  RecordWriter &Field(const char *key, NvS64 value);
+  RecordWriter &Field(const char *key, double value);
+  RecordWriter &Field(const char *key, bool value);
+  RecordWriter &Hex(const char *key, NvU64 value, int digits = 8);
+  RecordWriter &Null(const char *key);
+  void End();
+
+private:
+  void BeginField(const char *key);
+  void EndField();
+  void Append(char *buffer, size_t *size, const char *data, size_t length);
+  void AppendValue(const char *data, size_t length, bool quoted);
+
+  OutputFramer *m_target;
+  bool m_active;
+  bool m_overflow = false;
+  bool m_truncated = false;
+  NvU32 m_fields = 0;
+  size_t m_rowMark = 0;
+  size_t m_headerMark = 0;
+  char m_row[kMaxRecordSize];
+  size_t m_rowSize = 0;
+  char m_header[kMaxRecordSize];
+  size_t m_headerSize = 0;
+};
+} // namespace nvcli
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <nvapi.h>
+
+namespace nvcli {
+struct RawApiArgs {
+  NvU32 index = 0;
+  bool hasIndex = false;
+  bool raw = false;
+  const char *inPath = nullptr;
+  const char *outPath = nullptr;
+  bool hasDomain = false;
+  NvU32 domain = 0;
+  bool hasClassType = false;
+  NvU32 classType = 0;
+};
+
+struct ApiSpec {
+  const char *name;
+  const char *desc;
+  size_t size;
+  NvU32 version;
+  bool isSet;
+  NvAPI_Status (*call)(NvPhysicalGpuHandle, void *);
+  void (*prepare)(void *, const RawApiArgs &);
+};
+
+struct ApiSpecGroup {
+  const char *name;
+  const ApiSpec *specs;
+  size_t count;
+};
+
+// The clock, power and thermal spec tables behind the gpu clock/power/thermal api commands.
+const ApiSpecGroup *RawApiGroups(size_t *count);
+} // namespace nvcli
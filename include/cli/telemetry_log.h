@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <nvapi.h>
+
+namespace nvcli {
+// Append-only columnar log of sampled metrics. Rows are buffered into blocks, every column of a block is stored as a
+// presence bitmap plus zigzag varint deltas, so slowly changing counters cost a byte or less per sample. Closing the
+// log appends a block index, a log that was not closed is still readable by walking the block headers.
+constexpr NvU32 kTelemetryRowsPerBlock = 1024;
+
+struct TelemetryBlockInfo {
+  NvU64 offset;
+  NvU64 firstUs;
+  NvU64 lastUs;
+  NvU32 rows;
+};
+
+class TelemetryLogWriter {
+public:
+  TelemetryLogWriter() = default;
+  ~TelemetryLogWriter() { Close(); }
+
+  TelemetryLogWriter(const TelemetryLogWriter &) = delete;
+  TelemetryLogWriter &operator=(const TelemetryLogWriter &) = delete;
+
+  // Creates the file, or appends to an existing log that has the same columns.
+  bool Open(const char *path, const std::vector<std::string> &columns);
+  bool ok() const { return m_file != nullptr; }
+
+  // Values set between BeginRow and EndRow form one row, columns not set are stored as absent.
+  void BeginRow(NvU64 timestampUs);
+  void Set(size_t column, NvS64 value);
+  void EndRow();
+  bool Close();
+
+private:
+  bool FlushBlock();
+
+  FILE *m_file = nullptr;
+  size_t m_columnCount = 0;
+  std::vector<TelemetryBlockInfo> m_blocks;
+  std::vector<NvU64> m_timestamps;
+  std::vector<NvS64> m_values;
+  std::vector<NvU8> m_present;
+  bool m_failed = false;
+};
+
+class TelemetryLogReader {
+public:
+  TelemetryLogReader() = default;
+  ~TelemetryLogReader();
+
+  TelemetryLogReader(const TelemetryLogReader &) = delete;
+  TelemetryLogReader &operator=(const TelemetryLogReader &) = delete;
+
+  bool Open(const char *path);
+  const std::vector<std::string> &columns() const { return m_columns; }
+  const std::vector<TelemetryBlockInfo> &blocks() const { return m_blocks; }
+  bool indexed() const { return m_indexed; }
+  NvU64 dataEnd() const { return m_dataEnd; }
+
+  // First block whose last timestamp is at or after timestampUs, blocks().size() if none.
+  size_t FindBlock(NvU64 timestampUs) const;
+
+  // Decodes the timestamps and the requested columns of one block. values holds rows x wanted.size() entries and
+  // present the matching flags.
+  bool ReadBlock(size_t block, const std::vector<size_t> &wanted, std::vector<NvU64> *timestamps,
+                 std::vector<NvS64> *values, std::vector<NvU8> *present);
+
+private:
+  bool ReadHeader();
+  bool ReadIndex(NvU64 fileSize);
+  bool ScanBlocks(NvU64 fileSize);
+
+  FILE *m_file = nullptr;
+  std::vector<std::string> m_columns;
+  std::vector<TelemetryBlockInfo> m_blocks;
+  NvU64 m_headerSize = 0;
+  NvU64 m_dataEnd = 0;
+  bool m_indexed = false;
+};
+} // namespace nvcli
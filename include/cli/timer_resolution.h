@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include <windows.h>
+#include <timeapi.h>
+
+namespace nvcli {
+// Raises the system timer resolution for the lifetime of a poll loop, the default 15.6 ms tick would otherwise
+// dominate short intervals.
+class TimerResolution {
+public:
+  TimerResolution() : m_ok(timeBeginPeriod(1) == TIMERR_NOERROR) {}
+
+  ~TimerResolution() {
+    if (m_ok) { timeEndPeriod(1); }
+  }
+
+  TimerResolution(const TimerResolution &) = delete;
+  TimerResolution &operator=(const TimerResolution &) = delete;
+
+private:
+  bool m_ok;
+};
+} // namespace nvcli
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <nvapi.h>
+
+namespace nvcli {
+// VESA CVT 1.2 (CRT blanking, reduced blanking v1 and v2) and GTF with the default C/M/K/J parameters, computed in
+// process without margins. Like the EDID decoder this makes no NVAPI calls, so candidate modes can be generated and
+// checked without a display.
+enum TimingFormula : NvU8 { kTimingCvt = 0, kTimingCvtRb = 1, kTimingCvtRb2 = 2, kTimingGtf = 3 };
+
+const char *TimingFormulaName(TimingFormula formula);
+bool ParseTimingFormula(const char *value, TimingFormula *out);
+
+// Fills HVisible..pclk and the etc block (rounded refresh, rrx1k, aspect, status as NVAPI_TIMING_TYPE, name). pclk is
+// in 10 kHz units, so the 1 kHz clock step of CVT-RB2 is rounded to it. For interlaced modes VVisible and VTotal cover
+// the whole frame and the porches and sync are per field. Returns false for sizes or rates the formulas cannot produce.
+bool ComputeTiming(TimingFormula formula, NvU32 width, NvU32 height, double refreshHz, bool interlaced,
+                   NV_TIMING *out);
+
+// One requested mode of a batch, the refresh is the frame rate.
+struct TimingMode {
+  NvU32 width;
+  NvU32 height;
+  double refreshHz;
+};
+
+// Appends WxH@R, or every step of WxH@R1-R2:STEP from R1 up to and including R2.
+bool ParseTimingModeSpec(const char *value, std::vector<TimingMode> *out);
+// One mode spec per line, blank lines and lines starting with # are skipped. Prints the reason on failure.
+bool ReadTimingModesFile(const char *path, std::vector<TimingMode> *out);
+
+enum TimingLinkType : NvU8 { kTimingLinkNone = 0, kTimingLinkDp = 1, kTimingLinkTmds = 2, kTimingLinkFrl = 3 };
+
+// What a candidate is checked against, a zero limit is not checked.
+struct TimingLimits {
+  NvU32 maxPixelClockKhz;
+  // EDID display range limits.
+  bool hasRange;
+  NvU16 minVHz;
+  NvU16 maxVHz;
+  NvU16 minHKhz;
+  NvU16 maxHKhz;
+  TimingLinkType link;
+  // DP and FRL lanes and per-lane rate, 8b/10b and 16b/18b coding is applied by the validator.
+  NvU32 lanes;
+  NvU32 laneMbps;
+  NvU32 maxTmdsKhz;
+};
+
+// Parses dp:LANES:GBPS, frl:LANES:GBPS or tmds:MHZ.
+bool ParseTimingLink(const char *value, TimingLimits *limits);
+std::string DescribeTimingLink(const TimingLimits &limits);
+
+// Data rate a timing needs on the link, in kbit/s for DP and FRL and as TMDS character rate in kHz for TMDS.
+NvU64 TimingLinkLoad(const NV_TIMING &timing, NvU32 bpc, TimingLinkType link);
+NvU64 TimingLinkCapacity(const TimingLimits &limits);
+
+// Appends one message per violated limit and returns true when there were none.
+bool ValidateTiming(const NV_TIMING &timing, NvU32 bpc, const TimingLimits &limits,
+                    std::vector<std::string> *problems);
+} // namespace nvcli
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include "cli/common.h"
+
+#include <future>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace nvcli {
+struct TopologyLogicalGpu {
+  NvLogicalGpuHandle handle;
+  // Status of NvAPI_GetPhysicalGPUsFromLogicalGPU, physical is empty when it failed.
+  NvAPI_Status status;
+  std::vector<NvPhysicalGpuHandle> physical;
+};
+
+struct TopologyDisplay {
+  NvU32 index;
+  NvDisplayHandle handle;
+  bool hasDisplayId;
+  NvU32 displayId;
+  bool hasOutputId;
+  NvU32 outputId;
+};
+
+// Process-wide copy of the GPU and display enumeration, so batch and serve do not walk NvAPI_EnumPhysicalGPUs and
+// NvAPI_EnumNvidiaDisplayHandle for every command. Physical GPUs, logical GPUs and display handles are each enumerated
+// on first use and kept until Invalidate, a failed enumeration is not cached. Display IDs and output IDs of every
+// handle are resolved the first time a lookup needs them. Commands that change the display topology call Invalidate,
+// serve also runs a TopologyWatcher. Safe to use from ForEachGpu workers.
+class TopologyCache {
+public:
+  NvAPI_Status PhysicalGpus(std::vector<NvPhysicalGpuHandle> *out);
+  NvAPI_Status LogicalGpus(std::vector<TopologyLogicalGpu> *out);
+  // Index of the handle in PhysicalGpus order.
+  bool PhysicalGpuIndex(NvPhysicalGpuHandle handle, NvU32 *index);
+
+  NvU32 DisplayCount();
+  bool DisplayByIndex(NvU32 index, TopologyDisplay *out);
+  // Only displays that have an NVIDIA display handle (active ones) are found.
+  bool DisplayById(NvU32 displayId, TopologyDisplay *out);
+
+  void Invalidate();
+
+private:
+  bool LoadGpusLocked();
+  bool LoadLogicalGpusLocked();
+  void LoadDisplaysLocked();
+  void ResolveDisplayIdsLocked();
+
+  std::mutex m_lock;
+  bool m_gpusLoaded = false;
+  NvAPI_Status m_gpuStatus = NVAPI_OK;
+  std::vector<NvPhysicalGpuHandle> m_gpus;
+  std::unordered_map<NvPhysicalGpuHandle, NvU32> m_gpuIndex;
+  bool m_logicalLoaded = false;
+  NvAPI_Status m_logicalStatus = NVAPI_OK;
+  std::vector<TopologyLogicalGpu> m_logical;
+  bool m_displaysLoaded = false;
+  bool m_displayIdsResolved = false;
+  std::vector<TopologyDisplay> m_displays;
+  std::unordered_map<NvU32, size_t> m_displayById;
+};
+
+TopologyCache &Topology();
+
+// Invalidates Topology() on WM_DISPLAYCHANGE and device arrival/removal, from a hidden window on its own thread.
+class TopologyWatcher {
+public:
+  TopologyWatcher() = default;
+  ~TopologyWatcher() { Stop(); }
+
+  TopologyWatcher(const TopologyWatcher &) = delete;
+  TopologyWatcher &operator=(const TopologyWatcher &) = delete;
+
+  bool Start();
+  void Stop();
+
+private:
+  void Run(std::promise<bool> *created);
+
+  std::thread m_thread;
+  DWORD m_threadId = 0;
+};
+} // namespace nvcli
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include <windows.h>
+
+#include <nvapi.h>
+
+namespace nvcli {
+// Wraps the active backend so every NVAPI call is timed into a per-thread buffer. Install after --backend is applied,
+// the trace layer forwards to whatever table was active at that point.
+bool EnableNvApiTrace(const char *path);
+bool NvApiTraceEnabled();
+// Writes the Chrome trace JSON. Call while NVAPI is still initialized, status strings are resolved through it.
+bool WriteNvApiTrace();
+
+// Marks a command on the trace timeline so the NVAPI calls it makes nest under it. No-op unless tracing is enabled.
+class TraceSpan {
+public:
+  TraceSpan(int argc, char **argv);
+  ~TraceSpan();
+
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+  int m_argc;
+  char **m_argv;
+  NvU64 m_startNs;
+};
+} // namespace nvcli
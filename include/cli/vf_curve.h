@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <nvapi.h>
+
+namespace nvcli {
+struct VfPoint {
+  NvU32 voltageUv;
+  NvU32 freqKhz;
+};
+
+// The V/F curve of one clock domain on one board, points sorted by voltage. Frequency is kept non-decreasing (a point
+// below an earlier one is raised to it, Adjusted() counts them) so the curve can be interpolated monotonically and
+// inverted. Like the EDID decoder this makes no NVAPI calls, curves from a saved file behave the same as live ones.
+class VfCurve {
+public:
+  VfCurve() = default;
+  // Points with a zero voltage or frequency are dropped, for equal voltages the highest frequency is kept.
+  VfCurve(const std::string &label, const std::string &domain, std::vector<VfPoint> points);
+
+  const std::string &Label() const { return m_label; }
+  const std::string &Domain() const { return m_domain; }
+  const std::vector<VfPoint> &Points() const { return m_points; }
+  bool Empty() const { return m_points.empty(); }
+  NvU32 Adjusted() const { return m_adjusted; }
+
+  // Monotone piecewise cubic (Fritsch-Carlson) through the points, clamped to the first and last point outside them.
+  double FreqAt(double voltageUv) const;
+  // Lowest voltage at which the curve reaches freqKhz, negative when the curve never does.
+  double VoltageFor(double freqKhz) const;
+
+  // One line: vf1 LABEL DOMAIN COUNT UV:KHZ followed by COUNT-1 voltage:frequency deltas to the previous point.
+  std::string Serialize() const;
+  // Parses a Serialize() line, the points go through the same normalization.
+  static bool Parse(const std::string &line, VfCurve *out);
+
+private:
+  double Segment(size_t i, double voltageUv) const;
+
+  std::string m_label;
+  std::string m_domain;
+  std::vector<VfPoint> m_points;
+  std::vector<double> m_slopes;
+  NvU32 m_adjusted = 0;
+};
+
+// One curve per programmable client clock domain, from the points between vfPointIdxFirst and vfPointIdxLast.
+void VfCurvesFromClient(const NV_GPU_CLOCK_CLIENT_CLK_DOMAINS_INFO &domains,
+                        const NV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_STATUS &status, const std::string &label,
+                        std::vector<VfCurve> *out);
+// One curve per VF tables index (domain and pstate), each entry giving the highest frequency at its voltage.
+void VfCurvesFromTables(const NV_GPU_PERF_VF_TABLES &tables, const std::string &label, std::vector<VfCurve> *out);
+
+// Curves of one domain resampled on a shared voltage grid over the range every curve covers. The reference at each
+// grid point is the median frequency, order ranks the curves by their mean offset to it, best bin first.
+struct VfComparison {
+  std::vector<double> gridUv;
+  std::vector<double> medianKhz;
+  // deltaKhz[curve][grid point]
+  std::vector<std::vector<double>> deltaKhz;
+  std::vector<double> meanDeltaKhz;
+  std::vector<double> minDeltaKhz;
+  std::vector<double> maxDeltaKhz;
+  std::vector<size_t> order;
+};
+
+// Reads Serialize() lines, blank lines and lines starting with # are skipped. Prints the reason on failure.
+bool ReadVfCurveFile(const char *path, std::vector<VfCurve> *out);
+// Writes one Serialize() line per curve, replacing the file.
+bool WriteVfCurveFile(const char *path, const std::vector<VfCurve> &curves);
+
+// stepUv of 0 picks 32 grid intervals. Fails when the curves share no voltage range.
+bool CompareVfCurves(const std::vector<const VfCurve *> &curves, double stepUv, VfComparison *out,
+                     std::string *error);
+} // namespace nvcli
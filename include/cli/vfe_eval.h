@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <nvapi.h>
+
+namespace nvcli {
+constexpr NvU32 kVfeVarCount = NV_GPU_PERF_VFE_VAR_MAX_V1;
+constexpr NvU32 kVfeEquCount = NV_GPU_PERF_VFE_EQU_MAX_V1;
+// NV_GPU_PERF_VFE_VAR_IDX_INVALID and NV_GPU_PERF_VFE_EQU_IDX_INVALID expand to NV_U8_MAX, which nvapi.h never defines.
+constexpr NvU8 kVfeIdxInvalid = 0xFF;
+
+// One VFE variable as the evaluator needs it, merged from the info (type, operands, fuse value) and the control
+// (override, output range). A range with min >= max is not applied.
+struct VfeVarDef {
+  NvU8 index;
+  NV_GPU_PERF_VFE_VAR_TYPE type;
+  NvU8 varIdx0;
+  NvU8 varIdx1;
+  bool hasFuse;
+  double fuseValue;
+  NvU8 overrideType;
+  double overrideValue;
+  double rangeMin;
+  double rangeMax;
+};
+
+// One VFE equation, merged the same way. child0/child1 are equIdxTrue/equIdxFalse for COMPARE, equIdx0/equIdx1 for
+// MINMAX and equIdxToScale for EQUATION_SCALAR.
+struct VfeEquDef {
+  NvU8 index;
+  NV_GPU_PERF_VFE_EQU_TYPE type;
+  NvU8 varIdx;
+  NvU8 equIdxNext;
+  NvU8 outputType;
+  NvU8 child0;
+  NvU8 child1;
+  NvU8 compareFunc;
+  double criteria;
+  bool max;
+  double coeffs[NV_GPU_PERF_VFE_EQU_QUADRATIC_COEFF_COUNT];
+  double rangeMin;
+  double rangeMax;
+};
+
+// The override block of the SINGLE var types, NULL for derived vars and types without one.
+NV_GPU_PERF_VFE_VAR_CONTROL_SINGLE *GetVfeVarSingleControl(NV_GPU_PERF_VFE_VAR_CONTROL_V1 &var);
+const NV_GPU_PERF_VFE_VAR_CONTROL_SINGLE *GetVfeVarSingleControl(const NV_GPU_PERF_VFE_VAR_CONTROL_V1 &var);
+
+// Builds the definitions from the four VFE getters, only entries set in the info masks are returned.
+void VfeDefsFromNvapi(const NV_GPU_PERF_VFE_VARS_INFO &varsInfo, const NV_GPU_PERF_VFE_VARS_CONTROL &varsControl,
+                      const NV_GPU_PERF_VFE_EQUS_INFO &equsInfo, const NV_GPU_PERF_VFE_EQUS_CONTROL &equsControl,
+                      std::vector<VfeVarDef> *vars, std::vector<VfeEquDef> *equs);
+
+enum VfeOp : NvU8 {
+  kVfeOpInput = 0,
+  kVfeOpConst,
+  kVfeOpProduct,
+  kVfeOpSum,
+  kVfeOpQuadratic,
+  kVfeOpCompare,
+  kVfeOpMinMax,
+  kVfeOpScale,
+  // An equation list: the equation in a plus the rest of the list in b.
+  kVfeOpList,
+};
+
+// Operands are indices of earlier nodes, -1 for none. An input node reads inputs[source] and applies the var override
+// (overrideType, value in k[0]), fuse vars are folded into constants with the override already applied.
+struct VfeNode {
+  VfeOp op;
+  NvU8 source;
+  NvU8 overrideType;
+  NvU8 compareFunc;
+  bool max;
+  NvS32 a;
+  NvS32 b;
+  NvS32 c;
+  double k[NV_GPU_PERF_VFE_EQU_QUADRATIC_COEFF_COUNT];
+  double rangeMin;
+  double rangeMax;
+};
+
+// The var and equation graph flattened into nodes in topological order, so one evaluation is a single forward pass
+// over a vector with no recursion, list walking or index lookups. Equation lists become chains of kVfeOpList nodes,
+// both branches of a COMPARE are computed and the condition selects one.
+class VfeProgram {
+public:
+  // Fails on a reference to a var or equation that does not exist and on cycles, naming the entry.
+  bool Compile(const std::vector<VfeVarDef> &vars, const std::vector<VfeEquDef> &equs, std::string *error);
+
+  // inputs[var] is the value of each SINGLE var before its override (sensed temperature, voltage, frequency).
+  // values receives one result per node.
+  void Evaluate(const double *inputs, std::vector<double> *values) const;
+
+  // Node holding the result of the equation list starting at equ, or of var, -1 when it does not exist.
+  NvS32 EquationNode(NvU32 equ) const { return equ < kVfeEquCount ? m_equNode[equ] : -1; }
+  NvS32 VarNode(NvU32 var) const { return var < kVfeVarCount ? m_varNode[var] : -1; }
+  NvU8 OutputType(NvU32 equ) const { return equ < kVfeEquCount ? m_outputType[equ] : 0; }
+  // Equations no other equation points to, the entry points the rest of the perf code uses.
+  const std::vector<NvU8> &Roots() const { return m_roots; }
+  const std::vector<VfeNode> &Nodes() const { return m_nodes; }
+
+private:
+  bool CompileVar(NvU32 var, std::string *error);
+  bool CompileList(NvU32 equ, std::string *error);
+
+  const VfeVarDef *m_varDefs[kVfeVarCount] = {};
+  const VfeEquDef *m_equDefs[kVfeEquCount] = {};
+  // 0 not visited, 1 on the current path, 2 compiled.
+  NvU8 m_varState[kVfeVarCount] = {};
+  NvU8 m_equState[kVfeEquCount] = {};
+  NvS32 m_varNode[kVfeVarCount] = {};
+  NvS32 m_equNode[kVfeEquCount] = {};
+  NvU8 m_outputType[kVfeEquCount] = {};
+  std::vector<NvU8> m_roots;
+  std::vector<VfeNode> m_nodes;
+};
+
+const char *VfeOpName(VfeOp op);
+} // namespace nvcli
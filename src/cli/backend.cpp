@@ -0,0 +1,741 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/backend.h"
+#include "cli/common.h"
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace nvcli {
+namespace {
+const char *const kNvApiNames[] = {
+#define NVCLI_NVAPI_ENTRY(fn) #fn,
+#include "cli/nvapi_entries.h"
+#undef NVCLI_NVAPI_ENTRY
+};
+
+constexpr uintptr_t kReplayGpuHandleBase = 0x1000;
+constexpr uintptr_t kReplayDisplayHandleBase = 0x2000;
+constexpr uintptr_t kReplayDrsSessionHandle = 0x3000;
+constexpr uintptr_t kReplayDrsProfileHandleBase = 0x100000;
+constexpr uintptr_t kReplayDrsProfileHandleLimit = 0x100000;
+
+NvApiBackend MakeDriverBackend() {
+  NvApiBackend backend = {};
+#define NVCLI_NVAPI_ENTRY(fn) backend.fn = &::fn;
+#include "cli/nvapi_entries.h"
+#undef NVCLI_NVAPI_ENTRY
+  return backend;
+}
+
+// Record and replay key payloads by the GPU/display enumeration index, so the handle tables are kept here. For replay
+// they hold synthetic handles derived from the manifest. DRS profiles are numbered in the order record first sees
+// them; replay stores that number in the synthetic handle instead.
+struct BackendState {
+  BackendState() : driver(MakeDriverBackend()), active(driver) {}
+
+  std::string dir;
+  NvApiBackend driver;
+  NvApiBackend active;
+  std::mutex lock;
+  std::vector<NvPhysicalGpuHandle> gpus;
+  std::vector<NvDisplayHandle> displays;
+  std::map<NvDRSProfileHandle, NvU32> profiles;
+  std::map<std::string, std::vector<NvU8>> payloads;
+};
+
+BackendState &State() {
+  static BackendState state;
+  return state;
+}
+
+std::string PayloadPath(NvApiId id, const std::string &suffix) {
+  return State().dir + "/" + NvApiName(id) + suffix + ".bin";
+}
+
+std::string ManifestPath() { return State().dir + "/manifest.txt"; }
+
+bool GpuSuffix(NvPhysicalGpuHandle gpu, std::string *suffix) {
+  BackendState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock);
+  for (size_t i = 0; i < state.gpus.size(); ++i) {
+    if (state.gpus[i] == gpu) {
+      *suffix = "_gpu" + std::to_string(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool DisplaySuffix(NvDisplayHandle display, std::string *suffix) {
+  BackendState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock);
+  for (size_t i = 0; i < state.displays.size(); ++i) {
+    if (state.displays[i] == display) {
+      *suffix = "_disp" + std::to_string(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string DisplayIdSuffix(NvU32 displayId) {
+  char buffer[32] = {};
+  std::snprintf(buffer, sizeof(buffer), "_id0x%08X", displayId);
+  return std::string(buffer);
+}
+
+// NV_DECLARE_HANDLE types point to `struct name__ { int unused; }` and are never dereferenced.
+template <typename T, typename = void> struct IsHandleStruct : std::false_type {};
+template <typename T> struct IsHandleStruct<T, decltype(void(std::declval<T &>().unused))> : std::true_type {};
+
+// Only plain out-structs, scalars and short strings are replayable. Handle and void pointers are skipped.
+template <typename T> constexpr bool IsPayload() {
+  return !std::is_void<T>::value && !std::is_pointer<T>::value && !IsHandleStruct<T>::value;
+}
+
+template <typename T> constexpr size_t PayloadSize() {
+  return std::is_same<typename std::remove_cv<T>::type, char>::value ? NVAPI_SHORT_STRING_MAX : sizeof(T);
+}
+
+NvU64 InputHash(const void *data, size_t size, NvU64 hash = 0xCBF29CE484222325ull) {
+  const NvU8 *bytes = static_cast<const NvU8 *>(data);
+  for (size_t i = 0; i < size; ++i) { hash = (hash ^ bytes[i]) * 0x100000001B3ull; }
+  return hash;
+}
+
+NvU64 NameHash(const NvU16 *name, NvU64 hash = 0xCBF29CE484222325ull) {
+  size_t length = 0;
+  while (name && length < NVAPI_UNICODE_STRING_MAX && name[length] != 0) { ++length; }
+  return InputHash(name, length * sizeof(NvU16), hash);
+}
+
+std::string HashKey(NvU64 hash) {
+  char buffer[32] = {};
+  std::snprintf(buffer, sizeof(buffer), "_h%016llX", static_cast<unsigned long long>(hash));
+  return std::string(buffer);
+}
+
+// Struct payloads are also keyed by a hash of the struct as the command passed it in, before the driver fills it.
+// Commands zero their structs and set the version and the input fields (domain masks, sensor or lane indices, flags),
+// so two calls that differ only in what they ask for get separate payloads.
+template <typename T> std::string InputKeyOf(T) { return std::string(); }
+
+template <typename T> std::string InputKeyOf(T *data) {
+  if constexpr (IsPayload<T>() && std::is_class<T>::value && !std::is_const<T>::value) {
+    if (data) { return HashKey(InputHash(data, sizeof(T))); }
+  }
+  return std::string();
+}
+
+// The payload is the last argument of every call the Record/Replay overloads below cover.
+template <typename... Args> std::string InputKey(Args... args) {
+  std::string key;
+  ((key = InputKeyOf(args)), ...);
+  return key;
+}
+
+const std::vector<NvU8> *LoadPayload(NvApiId id, const std::string &suffix) {
+  std::string path = PayloadPath(id, suffix);
+  BackendState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock);
+  auto it = state.payloads.find(path);
+  if (it != state.payloads.end()) { return it->second.empty() ? nullptr : &it->second; }
+
+  std::vector<NvU8> &data = state.payloads[path];
+  FILE *file = nullptr;
+  if (fopen_s(&file, path.c_str(), "rb") != 0 || !file) { return nullptr; }
+  NvU8 chunk[4096];
+  size_t read = 0;
+  while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) { data.insert(data.end(), chunk, chunk + read); }
+  std::fclose(file);
+  return data.empty() ? nullptr : &data;
+}
+
+void StorePayload(NvApiId id, const std::string &suffix, const void *data, size_t size) {
+  std::string path = PayloadPath(id, suffix);
+  BackendState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock);
+  FILE *file = nullptr;
+  if (fopen_s(&file, path.c_str(), "wb") != 0 || !file) { return; }
+  std::fwrite(data, 1, size, file);
+  std::fclose(file);
+}
+
+void WriteManifest() {
+  BackendState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock);
+  FILE *file = nullptr;
+  if (fopen_s(&file, ManifestPath().c_str(), "wb") != 0 || !file) { return; }
+  std::fprintf(file, "gpus=%zu\n", state.gpus.size());
+  std::fprintf(file, "displays=%zu\n", state.displays.size());
+  std::fclose(file);
+}
+
+bool ReadManifest(NvU32 *gpuCount, NvU32 *displayCount) {
+  FILE *file = nullptr;
+  if (fopen_s(&file, ManifestPath().c_str(), "rb") != 0 || !file) { return false; }
+  char line[128] = {};
+  while (std::fgets(line, sizeof(line), file)) {
+    char *sep = std::strchr(line, '=');
+    if (!sep) { continue; }
+    *sep = '\0';
+    char *value = sep + 1;
+    value[std::strcspn(value, "\r\n")] = '\0';
+    if (std::strcmp(line, "gpus") == 0) { ParseUint(value, gpuCount); }
+    if (std::strcmp(line, "displays") == 0) { ParseUint(value, displayCount); }
+  }
+  std::fclose(file);
+  return true;
+}
+
+template <typename T> void RecordPayload(NvApiId id, const std::string &suffix, T *data) {
+  if constexpr (IsPayload<T>() && !std::is_const<T>::value) {
+    if (data) { StorePayload(id, suffix, data, PayloadSize<T>()); }
+  }
+}
+
+template <typename... Args> void Record(NvApiId, const std::string &, Args...) {}
+
+template <typename T> void Record(NvApiId id, const std::string &key, T *data) { RecordPayload(id, key, data); }
+
+template <typename T> void Record(NvApiId id, const std::string &key, NvPhysicalGpuHandle gpu, T *data) {
+  std::string suffix;
+  if (GpuSuffix(gpu, &suffix)) { RecordPayload(id, suffix + key, data); }
+}
+
+template <typename T>
+void Record(NvApiId id, const std::string &key, NvPhysicalGpuHandle gpu, NvU32 index, T *data) {
+  std::string suffix;
+  if (GpuSuffix(gpu, &suffix)) { RecordPayload(id, suffix + "_" + std::to_string(index) + key, data); }
+}
+
+template <typename T> void Record(NvApiId id, const std::string &key, NvDisplayHandle display, T *data) {
+  std::string suffix;
+  if (DisplaySuffix(display, &suffix)) { RecordPayload(id, suffix + key, data); }
+}
+
+template <typename T> void Record(NvApiId id, const std::string &key, NvU32 displayId, T *data) {
+  RecordPayload(id, DisplayIdSuffix(displayId) + key, data);
+}
+
+// On a key miss, a payload recorded for the same call with another struct version still answers
+// INCOMPATIBLE_STRUCT_VERSION, so the version fallback loops in the commands walk down to the recorded one.
+bool RecordedVersion(NvApiId id, const std::string &suffix, NvU32 *version) {
+  WIN32_FIND_DATAA found = {};
+  HANDLE find = FindFirstFileA(PayloadPath(id, suffix + "_h*").c_str(), &found);
+  if (find == INVALID_HANDLE_VALUE) { return false; }
+  FindClose(find);
+  const std::string name = found.cFileName;
+  const size_t prefix = std::strlen(NvApiName(id));
+  if (name.size() < prefix + 4) { return false; }
+  const std::vector<NvU8> *payload = LoadPayload(id, name.substr(prefix, name.size() - prefix - 4));
+  if (!payload || payload->size() < sizeof(NvU32)) { return false; }
+  std::memcpy(version, payload->data(), sizeof(NvU32));
+  return true;
+}
+
+// Replays a recorded payload into the caller's struct. Versioned structs must match the recorded version, which keeps
+// the version fallback loops in the commands on the same path they took against the driver. A payload without the
+// input key (one written by `gpu clock --out`) answers any input.
+template <typename T> NvAPI_Status ReplayPayload(NvApiId id, const std::string &suffix, T *data) {
+  if constexpr (!IsPayload<T>()) {
+    return NVAPI_NOT_SUPPORTED;
+  } else if constexpr (std::is_const<T>::value) {
+    return data ? NVAPI_OK : NVAPI_INVALID_ARGUMENT;
+  } else {
+    if (!data) { return NVAPI_INVALID_ARGUMENT; }
+    const std::string key = InputKeyOf(data);
+    const std::vector<NvU8> *payload = LoadPayload(id, suffix + key);
+    if (!payload && !key.empty()) { payload = LoadPayload(id, suffix); }
+    const size_t size = PayloadSize<T>();
+    const bool versioned = std::is_class<T>::value && size >= sizeof(NvU32);
+    NvU32 requested = 0;
+    if (versioned) { std::memcpy(&requested, data, sizeof(requested)); }
+    if (!payload) {
+      NvU32 recorded = 0;
+      if (versioned && RecordedVersion(id, suffix, &recorded) && recorded != requested) {
+        return NVAPI_INCOMPATIBLE_STRUCT_VERSION;
+      }
+      return NVAPI_NOT_SUPPORTED;
+    }
+    if (versioned && payload->size() >= sizeof(NvU32)) {
+      NvU32 recorded = 0;
+      std::memcpy(&recorded, payload->data(), sizeof(recorded));
+      if (requested != recorded) { return NVAPI_INCOMPATIBLE_STRUCT_VERSION; }
+    }
+    std::memcpy(data, payload->data(), payload->size() < size ? payload->size() : size);
+    return NVAPI_OK;
+  }
+}
+
+template <typename... Args> NvAPI_Status Replay(NvApiId, Args...) { return NVAPI_NOT_SUPPORTED; }
+
+template <typename T> NvAPI_Status Replay(NvApiId id, T *data) { return ReplayPayload(id, std::string(), data); }
+
+template <typename T> NvAPI_Status Replay(NvApiId id, NvPhysicalGpuHandle gpu, T *data) {
+  std::string suffix;
+  if (!GpuSuffix(gpu, &suffix)) { return NVAPI_EXPECTED_PHYSICAL_GPU_HANDLE; }
+  return ReplayPayload(id, suffix, data);
+}
+
+template <typename T> NvAPI_Status Replay(NvApiId id, NvPhysicalGpuHandle gpu, NvU32 index, T *data) {
+  std::string suffix;
+  if (!GpuSuffix(gpu, &suffix)) { return NVAPI_EXPECTED_PHYSICAL_GPU_HANDLE; }
+  return ReplayPayload(id, suffix + "_" + std::to_string(index), data);
+}
+
+template <typename T> NvAPI_Status Replay(NvApiId id, NvDisplayHandle display, T *data) {
+  std::string suffix;
+  if (!DisplaySuffix(display, &suffix)) { return NVAPI_EXPECTED_DISPLAY_HANDLE; }
+  return ReplayPayload(id, suffix, data);
+}
+
+template <typename T> NvAPI_Status Replay(NvApiId id, NvU32 displayId, T *data) {
+  return ReplayPayload(id, DisplayIdSuffix(displayId), data);
+}
+
+template <NvApiId Id, typename Fn = typename NvApiEntry<Id>::Fn> struct RecordEntry;
+
+template <NvApiId Id, typename... Args> struct RecordEntry<Id, NvAPI_Status(__cdecl *)(Args...)> {
+  static NvAPI_Status __cdecl Call(Args... args) {
+    // Taken before the call, the driver overwrites the struct.
+    const std::string key = InputKey(args...);
+    NvAPI_Status status = NvApiEntry<Id>::Slot(State().driver)(args...);
+    if (status == NVAPI_OK) { Record(Id, key, args...); }
+    return status;
+  }
+};
+
+template <NvApiId Id, typename Fn = typename NvApiEntry<Id>::Fn> struct ReplayEntry;
+
+template <NvApiId Id, typename... Args> struct ReplayEntry<Id, NvAPI_Status(__cdecl *)(Args...)> {
+  static NvAPI_Status __cdecl Call(Args... args) { return Replay(Id, args...); }
+};
+
+NvAPI_Status __cdecl RecordEnumPhysicalGPUs(NvPhysicalGpuHandle handles[NVAPI_MAX_PHYSICAL_GPUS], NvU32 *count) {
+  BackendState &state = State();
+  NvAPI_Status status = state.driver.NvAPI_EnumPhysicalGPUs(handles, count);
+  if (status != NVAPI_OK) { return status; }
+  {
+    std::lock_guard<std::mutex> guard(state.lock);
+    state.gpus.assign(handles, handles + *count);
+  }
+  WriteManifest();
+  return status;
+}
+
+NvAPI_Status __cdecl RecordEnumNvidiaDisplayHandle(NvU32 index, NvDisplayHandle *handle) {
+  BackendState &state = State();
+  NvAPI_Status status = state.driver.NvAPI_EnumNvidiaDisplayHandle(index, handle);
+  if (status != NVAPI_OK) { return status; }
+  {
+    std::lock_guard<std::mutex> guard(state.lock);
+    if (index < state.displays.size()) {
+      state.displays[index] = *handle;
+    } else if (index == state.displays.size()) {
+      state.displays.push_back(*handle);
+    }
+  }
+  WriteManifest();
+  return status;
+}
+
+NvAPI_Status __cdecl ReplayDriverType(NV_DRIVER_TYPE) { return NVAPI_OK; }
+
+NvAPI_Status __cdecl ReplayGetErrorMessage(NvAPI_Status status, NvAPI_ShortString text) {
+  if (!text) { return NVAPI_INVALID_ARGUMENT; }
+  const char *name = nullptr;
+  switch (status) {
+  case NVAPI_OK: name = "Success"; break;
+  case NVAPI_ERROR: name = "Error"; break;
+  case NVAPI_INVALID_ARGUMENT: name = "Invalid argument"; break;
+  case NVAPI_NVIDIA_DEVICE_NOT_FOUND: name = "NVIDIA device not found"; break;
+  case NVAPI_END_ENUMERATION: name = "End of enumeration"; break;
+  case NVAPI_EXPECTED_PHYSICAL_GPU_HANDLE: name = "Expected physical GPU handle"; break;
+  case NVAPI_EXPECTED_DISPLAY_HANDLE: name = "Expected display handle"; break;
+  case NVAPI_INCOMPATIBLE_STRUCT_VERSION: name = "Incompatible struct version"; break;
+  case NVAPI_NOT_SUPPORTED: name = "Not supported (replay)"; break;
+  default: return NVAPI_ERROR;
+  }
+  strncpy_s(text, NVAPI_SHORT_STRING_MAX, name, _TRUNCATE);
+  return NVAPI_OK;
+}
+
+NvAPI_Status __cdecl ReplayEnumPhysicalGPUs(NvPhysicalGpuHandle handles[NVAPI_MAX_PHYSICAL_GPUS], NvU32 *count) {
+  if (!handles || !count) { return NVAPI_INVALID_ARGUMENT; }
+  BackendState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock);
+  if (state.gpus.empty()) { return NVAPI_NVIDIA_DEVICE_NOT_FOUND; }
+  for (size_t i = 0; i < state.gpus.size(); ++i) { handles[i] = state.gpus[i]; }
+  *count = static_cast<NvU32>(state.gpus.size());
+  return NVAPI_OK;
+}
+
+NvAPI_Status __cdecl ReplayEnumNvidiaDisplayHandle(NvU32 index, NvDisplayHandle *handle) {
+  if (!handle) { return NVAPI_INVALID_ARGUMENT; }
+  BackendState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock);
+  if (index >= state.displays.size()) { return NVAPI_END_ENUMERATION; }
+  *handle = state.displays[index];
+  return NVAPI_OK;
+}
+
+// DRS calls identify profiles by per-session handles, so they get their own entries. Each read stores the status next
+// to the payload (`[status][data]`), which also replays NVAPI_PROFILE_NOT_FOUND, NVAPI_SETTING_NOT_FOUND and the end
+// of an enumeration the way the driver answered them. Calls returning a profile handle store its profile number.
+bool ProfileSuffix(NvDRSProfileHandle profile, std::string *suffix) {
+  BackendState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock);
+  auto it = state.profiles.find(profile);
+  if (it == state.profiles.end()) { return false; }
+  *suffix = "_prof" + std::to_string(it->second);
+  return true;
+}
+
+NvU32 RecordProfile(NvDRSProfileHandle profile) {
+  BackendState &state = State();
+  std::lock_guard<std::mutex> guard(state.lock);
+  auto it = state.profiles.emplace(profile, static_cast<NvU32>(state.profiles.size())).first;
+  return it->second;
+}
+
+bool ReplayProfileSuffix(NvDRSProfileHandle profile, std::string *suffix) {
+  const uintptr_t value = reinterpret_cast<uintptr_t>(profile);
+  if (value < kReplayDrsProfileHandleBase || value - kReplayDrsProfileHandleBase >= kReplayDrsProfileHandleLimit) {
+    return false;
+  }
+  *suffix = "_prof" + std::to_string(value - kReplayDrsProfileHandleBase);
+  return true;
+}
+
+void StoreDrsResult(NvApiId id, const std::string &suffix, NvAPI_Status status, const void *data, size_t size) {
+  std::vector<NvU8> buffer(sizeof(NvAPI_Status) + size);
+  std::memcpy(buffer.data(), &status, sizeof(status));
+  if (size) { std::memcpy(buffer.data() + sizeof(status), data, size); }
+  StorePayload(id, suffix, buffer.data(), buffer.size());
+}
+
+// Copies at most `size` bytes of the recorded data to `data` and returns the recorded status, or NOT_SUPPORTED when
+// the call was never recorded.
+NvAPI_Status ReplayDrsResult(NvApiId id, const std::string &suffix, void *data, size_t size, size_t *copied) {
+  if (copied) { *copied = 0; }
+  const std::vector<NvU8> *payload = LoadPayload(id, suffix);
+  if (!payload || payload->size() < sizeof(NvAPI_Status)) { return NVAPI_NOT_SUPPORTED; }
+  NvAPI_Status status = NVAPI_OK;
+  std::memcpy(&status, payload->data(), sizeof(status));
+  size_t available = payload->size() - sizeof(status);
+  if (available > size) { available = size; }
+  if (available) { std::memcpy(data, payload->data() + sizeof(status), available); }
+  if (copied) { *copied = available; }
+  return status;
+}
+
+void StoreDrsProfile(NvApiId id, const std::string &suffix, NvAPI_Status status, const NvDRSProfileHandle *profile) {
+  const NvU32 number = status == NVAPI_OK ? RecordProfile(*profile) : 0;
+  StoreDrsResult(id, suffix, status, &number, sizeof(number));
+}
+
+NvAPI_Status ReplayDrsProfile(NvApiId id, const std::string &suffix, NvDRSProfileHandle *profile) {
+  NvU32 number = 0;
+  size_t copied = 0;
+  NvAPI_Status status = ReplayDrsResult(id, suffix, &number, sizeof(number), &copied);
+  if (status == NVAPI_OK) {
+    if (copied != sizeof(number) || number >= kReplayDrsProfileHandleLimit) { return NVAPI_NOT_SUPPORTED; }
+    *profile = reinterpret_cast<NvDRSProfileHandle>(kReplayDrsProfileHandleBase + number);
+  }
+  return status;
+}
+
+NvAPI_Status __cdecl RecordDrsCreateProfile(NvDRSSessionHandle session, NVDRS_PROFILE *info,
+                                            NvDRSProfileHandle *profile) {
+  const std::string key = InputKeyOf(info);
+  NvAPI_Status status = State().driver.NvAPI_DRS_CreateProfile(session, info, profile);
+  if (profile) { StoreDrsProfile(NvApiId::NvAPI_DRS_CreateProfile, key, status, profile); }
+  return status;
+}
+
+NvAPI_Status __cdecl RecordDrsEnumProfiles(NvDRSSessionHandle session, NvU32 index, NvDRSProfileHandle *profile) {
+  NvAPI_Status status = State().driver.NvAPI_DRS_EnumProfiles(session, index, profile);
+  if (profile) { StoreDrsProfile(NvApiId::NvAPI_DRS_EnumProfiles, "_" + std::to_string(index), status, profile); }
+  return status;
+}
+
+NvAPI_Status __cdecl RecordDrsFindProfileByName(NvDRSSessionHandle session, NvAPI_UnicodeString name,
+                                                NvDRSProfileHandle *profile) {
+  NvAPI_Status status = State().driver.NvAPI_DRS_FindProfileByName(session, name, profile);
+  if (profile) { StoreDrsProfile(NvApiId::NvAPI_DRS_FindProfileByName, HashKey(NameHash(name)), status, profile); }
+  return status;
+}
+
+NvAPI_Status __cdecl RecordDrsGetNumProfiles(NvDRSSessionHandle session, NvU32 *count) {
+  NvAPI_Status status = State().driver.NvAPI_DRS_GetNumProfiles(session, count);
+  if (count) { StoreDrsResult(NvApiId::NvAPI_DRS_GetNumProfiles, std::string(), status, count, sizeof(*count)); }
+  return status;
+}
+
+NvAPI_Status __cdecl RecordDrsGetProfileInfo(NvDRSSessionHandle session, NvDRSProfileHandle profile,
+                                             NVDRS_PROFILE *info) {
+  const std::string key = InputKeyOf(info);
+  NvAPI_Status status = State().driver.NvAPI_DRS_GetProfileInfo(session, profile, info);
+  std::string suffix;
+  if (info && ProfileSuffix(profile, &suffix)) {
+    StoreDrsResult(NvApiId::NvAPI_DRS_GetProfileInfo, suffix + key, status, info, sizeof(*info));
+  }
+  return status;
+}
+
+NvAPI_Status __cdecl RecordDrsGetSetting(NvDRSSessionHandle session, NvDRSProfileHandle profile, NvU32 settingId,
+                                         NVDRS_SETTING *setting) {
+  const std::string key = "_" + std::to_string(settingId) + InputKeyOf(setting);
+  NvAPI_Status status = State().driver.NvAPI_DRS_GetSetting(session, profile, settingId, setting);
+  std::string suffix;
+  if (setting && ProfileSuffix(profile, &suffix)) {
+    StoreDrsResult(NvApiId::NvAPI_DRS_GetSetting, suffix + key, status, setting, sizeof(*setting));
+  }
+  return status;
+}
+
+NvAPI_Status __cdecl RecordDrsGetApplicationInfo(NvDRSSessionHandle session, NvDRSProfileHandle profile,
+                                                 NvAPI_UnicodeString name, NVDRS_APPLICATION *app) {
+  const std::string key = app ? HashKey(InputHash(app, sizeof(*app), NameHash(name))) : std::string();
+  NvAPI_Status status = State().driver.NvAPI_DRS_GetApplicationInfo(session, profile, name, app);
+  std::string suffix;
+  if (app && ProfileSuffix(profile, &suffix)) {
+    StoreDrsResult(NvApiId::NvAPI_DRS_GetApplicationInfo, suffix + key, status, app, sizeof(*app));
+  }
+  return status;
+}
+
+NvAPI_Status __cdecl RecordDrsGetSettingIdFromName(NvAPI_UnicodeString name, NvU32 *settingId) {
+  NvAPI_Status status = State().driver.NvAPI_DRS_GetSettingIdFromName(name, settingId);
+  if (settingId) {
+    StoreDrsResult(NvApiId::NvAPI_DRS_GetSettingIdFromName, HashKey(NameHash(name)), status, settingId,
+                   sizeof(*settingId));
+  }
+  return status;
+}
+
+// EnumApplications and EnumSettings fill an array, keyed by the start index and the requested count. The stored data
+// is the returned count followed by the entries.
+template <NvApiId Id, typename T>
+NvAPI_Status __cdecl RecordDrsEnum(NvDRSSessionHandle session, NvDRSProfileHandle profile, NvU32 start,
+                                   NvU32 *count, T *items) {
+  const NvU32 requested = count ? *count : 0;
+  NvAPI_Status status = NvApiEntry<Id>::Slot(State().driver)(session, profile, start, count, items);
+  std::string suffix;
+  if (!count || !items || !ProfileSuffix(profile, &suffix)) { return status; }
+  const NvU32 returned = status == NVAPI_OK && *count <= requested ? *count : 0;
+  std::vector<NvU8> data(sizeof(returned) + returned * sizeof(T));
+  std::memcpy(data.data(), &returned, sizeof(returned));
+  if (returned) { std::memcpy(data.data() + sizeof(returned), items, returned * sizeof(T)); }
+  StoreDrsResult(Id, suffix + "_" + std::to_string(start) + "_" + std::to_string(requested), status, data.data(),
+                 data.size());
+  return status;
+}
+
+NvAPI_Status __cdecl ReplayDrsCreateSession(NvDRSSessionHandle *session) {
+  if (!session) { return NVAPI_INVALID_ARGUMENT; }
+  *session = reinterpret_cast<NvDRSSessionHandle>(kReplayDrsSessionHandle);
+  return NVAPI_OK;
+}
+
+// Loading, saving and destroying the session and every DRS change succeed without effect.
+NvAPI_Status __cdecl ReplayDrsSession(NvDRSSessionHandle) { return NVAPI_OK; }
+
+NvAPI_Status __cdecl ReplayDrsProfileChange(NvDRSSessionHandle, NvDRSProfileHandle profile) {
+  std::string suffix;
+  return ReplayProfileSuffix(profile, &suffix) ? NVAPI_OK : NVAPI_INVALID_HANDLE;
+}
+
+template <typename Arg> NvAPI_Status __cdecl ReplayDrsProfileChangeWith(NvDRSSessionHandle session,
+                                                                        NvDRSProfileHandle profile, Arg) {
+  return ReplayDrsProfileChange(session, profile);
+}
+
+NvAPI_Status __cdecl ReplayDrsCreateProfile(NvDRSSessionHandle, NVDRS_PROFILE *info, NvDRSProfileHandle *profile) {
+  if (!info || !profile) { return NVAPI_INVALID_ARGUMENT; }
+  return ReplayDrsProfile(NvApiId::NvAPI_DRS_CreateProfile, InputKeyOf(info), profile);
+}
+
+NvAPI_Status __cdecl ReplayDrsEnumProfiles(NvDRSSessionHandle, NvU32 index, NvDRSProfileHandle *profile) {
+  if (!profile) { return NVAPI_INVALID_ARGUMENT; }
+  return ReplayDrsProfile(NvApiId::NvAPI_DRS_EnumProfiles, "_" + std::to_string(index), profile);
+}
+
+NvAPI_Status __cdecl ReplayDrsFindProfileByName(NvDRSSessionHandle, NvAPI_UnicodeString name,
+                                                NvDRSProfileHandle *profile) {
+  if (!profile) { return NVAPI_INVALID_ARGUMENT; }
+  return ReplayDrsProfile(NvApiId::NvAPI_DRS_FindProfileByName, HashKey(NameHash(name)), profile);
+}
+
+NvAPI_Status __cdecl ReplayDrsGetNumProfiles(NvDRSSessionHandle, NvU32 *count) {
+  if (!count) { return NVAPI_INVALID_ARGUMENT; }
+  return ReplayDrsResult(NvApiId::NvAPI_DRS_GetNumProfiles, std::string(), count, sizeof(*count), nullptr);
+}
+
+NvAPI_Status __cdecl ReplayDrsGetProfileInfo(NvDRSSessionHandle, NvDRSProfileHandle profile, NVDRS_PROFILE *info) {
+  std::string suffix;
+  if (!info) { return NVAPI_INVALID_ARGUMENT; }
+  if (!ReplayProfileSuffix(profile, &suffix)) { return NVAPI_INVALID_HANDLE; }
+  return ReplayDrsResult(NvApiId::NvAPI_DRS_GetProfileInfo, suffix + InputKeyOf(info), info, sizeof(*info), nullptr);
+}
+
+NvAPI_Status __cdecl ReplayDrsGetSetting(NvDRSSessionHandle, NvDRSProfileHandle profile, NvU32 settingId,
+                                         NVDRS_SETTING *setting) {
+  std::string suffix;
+  if (!setting) { return NVAPI_INVALID_ARGUMENT; }
+  if (!ReplayProfileSuffix(profile, &suffix)) { return NVAPI_INVALID_HANDLE; }
+  suffix += "_" + std::to_string(settingId) + InputKeyOf(setting);
+  return ReplayDrsResult(NvApiId::NvAPI_DRS_GetSetting, suffix, setting, sizeof(*setting), nullptr);
+}
+
+NvAPI_Status __cdecl ReplayDrsGetApplicationInfo(NvDRSSessionHandle, NvDRSProfileHandle profile,
+                                                 NvAPI_UnicodeString name, NVDRS_APPLICATION *app) {
+  std::string suffix;
+  if (!app) { return NVAPI_INVALID_ARGUMENT; }
+  if (!ReplayProfileSuffix(profile, &suffix)) { return NVAPI_INVALID_HANDLE; }
+  suffix += HashKey(InputHash(app, sizeof(*app), NameHash(name)));
+  return ReplayDrsResult(NvApiId::NvAPI_DRS_GetApplicationInfo, suffix, app, sizeof(*app), nullptr);
+}
+
+NvAPI_Status __cdecl ReplayDrsGetSettingIdFromName(NvAPI_UnicodeString name, NvU32 *settingId) {
+  if (!settingId) { return NVAPI_INVALID_ARGUMENT; }
+  return ReplayDrsResult(NvApiId::NvAPI_DRS_GetSettingIdFromName, HashKey(NameHash(name)), settingId,
+                         sizeof(*settingId), nullptr);
+}
+
+template <NvApiId Id, typename T>
+NvAPI_Status __cdecl ReplayDrsEnum(NvDRSSessionHandle, NvDRSProfileHandle profile, NvU32 start, NvU32 *count,
+                                   T *items) {
+  std::string suffix;
+  if (!count || !items) { return NVAPI_INVALID_ARGUMENT; }
+  if (!ReplayProfileSuffix(profile, &suffix)) { return NVAPI_INVALID_HANDLE; }
+  suffix += "_" + std::to_string(start) + "_" + std::to_string(*count);
+  std::vector<NvU8> data(sizeof(NvU32) + static_cast<size_t>(*count) * sizeof(T));
+  size_t copied = 0;
+  NvAPI_Status status = ReplayDrsResult(Id, suffix, data.data(), data.size(), &copied);
+  if (status != NVAPI_OK) { return status; }
+  NvU32 returned = 0;
+  if (copied < sizeof(returned)) { return NVAPI_NOT_SUPPORTED; }
+  std::memcpy(&returned, data.data(), sizeof(returned));
+  if (returned > *count || copied < sizeof(returned) + returned * sizeof(T)) { return NVAPI_NOT_SUPPORTED; }
+  if (returned) { std::memcpy(items, data.data() + sizeof(returned), returned * sizeof(T)); }
+  *count = returned;
+  return NVAPI_OK;
+}
+
+bool SelectRecordBackend(const char *dir) {
+  BackendState &state = State();
+  if (!CreateDirectoryA(dir, NULL) && GetLastError() != ERROR_ALREADY_EXISTS) {
+    Printf("Failed to create record directory: %s\n", dir);
+    return false;
+  }
+  state.dir = dir;
+#define NVCLI_NVAPI_ENTRY(fn) state.active.fn = &RecordEntry<NvApiId::fn>::Call;
+#include "cli/nvapi_entries.h"
+#undef NVCLI_NVAPI_ENTRY
+  state.active.NvAPI_EnumPhysicalGPUs = RecordEnumPhysicalGPUs;
+  state.active.NvAPI_EnumNvidiaDisplayHandle = RecordEnumNvidiaDisplayHandle;
+  state.active.NvAPI_DRS_CreateProfile = RecordDrsCreateProfile;
+  state.active.NvAPI_DRS_EnumProfiles = RecordDrsEnumProfiles;
+  state.active.NvAPI_DRS_FindProfileByName = RecordDrsFindProfileByName;
+  state.active.NvAPI_DRS_GetNumProfiles = RecordDrsGetNumProfiles;
+  state.active.NvAPI_DRS_GetProfileInfo = RecordDrsGetProfileInfo;
+  state.active.NvAPI_DRS_GetSetting = RecordDrsGetSetting;
+  state.active.NvAPI_DRS_GetApplicationInfo = RecordDrsGetApplicationInfo;
+  state.active.NvAPI_DRS_GetSettingIdFromName = RecordDrsGetSettingIdFromName;
+  state.active.NvAPI_DRS_EnumApplications = RecordDrsEnum<NvApiId::NvAPI_DRS_EnumApplications, NVDRS_APPLICATION>;
+  state.active.NvAPI_DRS_EnumSettings = RecordDrsEnum<NvApiId::NvAPI_DRS_EnumSettings, NVDRS_SETTING>;
+  return true;
+}
+
+bool SelectReplayBackend(const char *dir) {
+  BackendState &state = State();
+  state.dir = dir;
+  NvU32 gpuCount = 0;
+  NvU32 displayCount = 0;
+  if (!ReadManifest(&gpuCount, &displayCount)) {
+    Printf("Failed to read replay manifest: %s\n", ManifestPath().c_str());
+    return false;
+  }
+  if (gpuCount > NVAPI_MAX_PHYSICAL_GPUS) {
+    Printf("Replay manifest lists too many GPUs: %u\n", gpuCount);
+    return false;
+  }
+
+  state.gpus.clear();
+  state.displays.clear();
+  for (NvU32 i = 0; i < gpuCount; ++i) {
+    state.gpus.push_back(reinterpret_cast<NvPhysicalGpuHandle>(kReplayGpuHandleBase + i));
+  }
+  for (NvU32 i = 0; i < displayCount; ++i) {
+    state.displays.push_back(reinterpret_cast<NvDisplayHandle>(kReplayDisplayHandleBase + i));
+  }
+
+#define NVCLI_NVAPI_ENTRY(fn) state.active.fn = &ReplayEntry<NvApiId::fn>::Call;
+#include "cli/nvapi_entries.h"
+#undef NVCLI_NVAPI_ENTRY
+  state.active.NvAPI_InitializeEx = ReplayDriverType;
+  state.active.NvAPI_UnloadEx = ReplayDriverType;
+  state.active.NvAPI_GetErrorMessage = ReplayGetErrorMessage;
+  state.active.NvAPI_EnumPhysicalGPUs = ReplayEnumPhysicalGPUs;
+  state.active.NvAPI_EnumNvidiaDisplayHandle = ReplayEnumNvidiaDisplayHandle;
+  state.active.NvAPI_DRS_CreateSession = ReplayDrsCreateSession;
+  state.active.NvAPI_DRS_DestroySession = ReplayDrsSession;
+  state.active.NvAPI_DRS_LoadSettings = ReplayDrsSession;
+  state.active.NvAPI_DRS_SaveSettings = ReplayDrsSession;
+  state.active.NvAPI_DRS_CreateProfile = ReplayDrsCreateProfile;
+  state.active.NvAPI_DRS_DeleteProfile = ReplayDrsProfileChange;
+  state.active.NvAPI_DRS_SetSetting = ReplayDrsProfileChangeWith<NVDRS_SETTING *>;
+  state.active.NvAPI_DRS_DeleteProfileSetting = ReplayDrsProfileChangeWith<NvU32>;
+  state.active.NvAPI_DRS_CreateApplication = ReplayDrsProfileChangeWith<NVDRS_APPLICATION *>;
+  state.active.NvAPI_DRS_DeleteApplication = ReplayDrsProfileChangeWith<NvU16 *>;
+  state.active.NvAPI_DRS_EnumProfiles = ReplayDrsEnumProfiles;
+  state.active.NvAPI_DRS_FindProfileByName = ReplayDrsFindProfileByName;
+  state.active.NvAPI_DRS_GetNumProfiles = ReplayDrsGetNumProfiles;
+  state.active.NvAPI_DRS_GetProfileInfo = ReplayDrsGetProfileInfo;
+  state.active.NvAPI_DRS_GetSetting = ReplayDrsGetSetting;
+  state.active.NvAPI_DRS_GetApplicationInfo = ReplayDrsGetApplicationInfo;
+  state.active.NvAPI_DRS_GetSettingIdFromName = ReplayDrsGetSettingIdFromName;
+  state.active.NvAPI_DRS_EnumApplications = ReplayDrsEnum<NvApiId::NvAPI_DRS_EnumApplications, NVDRS_APPLICATION>;
+  state.active.NvAPI_DRS_EnumSettings = ReplayDrsEnum<NvApiId::NvAPI_DRS_EnumSettings, NVDRS_SETTING>;
+  return true;
+}
+} // namespace
+
+const NvApiBackend &NvApi() { return State().active; }
+
+NvApiBackend ReplaceNvApiBackend(const NvApiBackend &backend) {
+  BackendState &state = State();
+  NvApiBackend previous = state.active;
+  state.active = backend;
+  return previous;
+}
+
+const char *NvApiName(NvApiId id) {
+  const size_t index = static_cast<size_t>(id);
+  if (index >= sizeof(kNvApiNames) / sizeof(kNvApiNames[0])) { return "NvAPI_Unknown"; }
+  return kNvApiNames[index];
+}
+
+bool SelectNvApiBackend(const char *spec) {
+  if (!spec || !*spec) { return false; }
+  if (std::strcmp(spec, "driver") == 0) {
+    BackendState &state = State();
+    state.active = state.driver;
+    return true;
+  }
+  if (std::strncmp(spec, "record:", 7) == 0 && spec[7] != '\0') { return SelectRecordBackend(spec + 7); }
+  if (std::strncmp(spec, "replay:", 7) == 0 && spec[7] != '\0') { return SelectReplayBackend(spec + 7); }
+  Printf("Invalid backend: %s (expected driver|record:DIR|replay:DIR)\n", spec);
+  return false;
+}
+} // namespace nvcli
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/trace.h"
+
+#include <chrono>
+
+namespace nvcli {
+namespace {
+int CmdInfoAdapter(int argc, char **argv) {
+  (void)argc;
+  (void)argv;
+  return CmdInfo();
+}
+
+int CmdHelpAdapter(int argc, char **argv) {
+  PrintUsageGroup(argc >= 1 ? argv[0] : nullptr);
+  return 0;
+}
+
+const SubcommandEntry kCommands[] = {
+    {"help", CmdHelpAdapter},
+    {"info", CmdInfoAdapter},
+    {"gpu", CmdGpu},
+    {"display", CmdDisplay},
+    {"mosaic", CmdMosaic},
+    {"sli", CmdSli},
+    {"gsync", CmdGsync},
+    {"drs", CmdDrs},
+    {"video", CmdVideo},
+    {"hdmi", CmdHdmi},
+    {"dp", CmdDp},
+    {"pcf", CmdPcf},
+    {"d3d", CmdD3d},
+    {"ogl", CmdOgl},
+    {"vr", CmdVr},
+    {"stereo", CmdStereo},
+    {"sys", CmdSys},
+    {"bench", CmdBench},
+    {"log", CmdLog},
+};
+
+bool ReadLine(FILE *file, std::string *line) {
+  line->clear();
+  char buffer[1024];
+  while (std::fgets(buffer, sizeof(buffer), file)) {
+    line->append(buffer);
+    if (!line->empty() && line->back() == '\n') { break; }
+  }
+  if (line->empty()) { return false; }
+  while (!line->empty() && (line->back() == '\n' || line->back() == '\r')) { line->pop_back(); }
+  return true;
+}
+} // namespace
+
+int RunCommand(int argc, char **argv) {
+  if (argc < 1) {
+    PrintUsage();
+    return 1;
+  }
+  const SubcommandEntry *entry = FindSubcommand(kCommands, sizeof(kCommands) / sizeof(kCommands[0]), argv[0]);
+  if (!entry) {
+    Printf("Unknown command: %s\n", argv[0]);
+    PrintUsage();
+    return 1;
+  }
+  TraceSpan span(argc, argv);
+  return entry->handler(argc - 1, argv + 1);
+}
+
+bool SplitCommandLine(const std::string &line, std::vector<std::string> &args) {
+  args.clear();
+  size_t pos = 0;
+  while (pos < line.size()) {
+    while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos]))) { ++pos; }
+    if (pos >= line.size()) { break; }
+
+    std::string arg;
+    bool quoted = false;
+    while (pos < line.size() && (quoted || !std::isspace(static_cast<unsigned char>(line[pos])))) {
+      if (line[pos] == '"') {
+        quoted = !quoted;
+      } else {
+        arg.push_back(line[pos]);
+      }
+      ++pos;
+    }
+    if (quoted) { return false; }
+    args.push_back(arg);
+  }
+  return true;
+}
+
+int CmdBatch(int argc, char **argv) {
+  const char *path = nullptr;
+  bool stopOnError = false;
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--stop-on-error") == 0) {
+      stopOnError = true;
+      continue;
+    }
+    if (!path) {
+      path = argv[i];
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+  if (!path) {
+    Printf("Missing batch file (use - for stdin).\n");
+    return 1;
+  }
+
+  FILE *file = stdin;
+  if (std::strcmp(path, "-") != 0) {
+    if (fopen_s(&file, path, "r") != 0 || !file) {
+      Printf("Failed to open %s\n", path);
+      return 1;
+    }
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const auto batchStart = Clock::now();
+  NvU32 lineNumber = 0;
+  NvU32 executed = 0;
+  NvU32 failed = 0;
+  std::string line;
+  std::vector<std::string> args;
+  std::vector<char *> argvLine;
+  while (ReadLine(file, &line)) {
+    ++lineNumber;
+    if (!SplitCommandLine(line, args)) {
+      Printf("[%u] unterminated quote: %s\n", lineNumber, line.c_str());
+      ++failed;
+      if (stopOnError) { break; }
+      continue;
+    }
+    if (args.empty() || args[0][0] == '#') { continue; }
+    if (args[0] == "batch") {
+      Printf("[%u] nested batch is not supported\n", lineNumber);
+      ++failed;
+      if (stopOnError) { break; }
+      continue;
+    }
+
+    argvLine.clear();
+    for (auto &arg : args) { argvLine.push_back(&arg[0]); }
+    argvLine.push_back(nullptr);
+
+    if (StructuredOutput()) {
+      RecordWriter("batch_command").Field("line", lineNumber).Field("command", line);
+    } else {
+      Printf("[%u] %s\n", lineNumber, line.c_str());
+    }
+    const auto start = Clock::now();
+    const int result = RunCommand(static_cast<int>(args.size()), argvLine.data());
+    const double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    if (StructuredOutput()) {
+      RecordWriter("batch_result").Field("line", lineNumber).Field("exit", result).Field("elapsed_ms", elapsedMs);
+    } else {
+      Printf("[%u] %s exit=%d %.3f ms\n", lineNumber, result == 0 ? "ok" : "failed", result, elapsedMs);
+    }
+    std::fflush(stdout);
+
+    ++executed;
+    if (result != 0) {
+      ++failed;
+      if (stopOnError) { break; }
+    }
+  }
+  if (file != stdin) { std::fclose(file); }
+
+  const double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - batchStart).count();
+  if (StructuredOutput()) {
+    RecordWriter("batch_summary").Field("commands", executed).Field("failed", failed).Field("elapsed_ms", totalMs);
+  } else {
+    Printf("Batch: %u commands, %u failed, %.3f ms\n", executed, failed, totalMs);
+  }
+  return failed == 0 ? 0 : 1;
+}
+} // namespace nvcli
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/raw_api.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace nvcli {
+namespace {
+struct BenchApiResult {
+  NvU32 iterations;
+  NvU32 failures;
+  NvAPI_Status lastFailure;
+  double p50Us;
+  double p90Us;
+  double p99Us;
+  double maxUs;
+  double meanUs;
+};
+
+// Nearest-rank percentile over sorted samples.
+double BenchPercentile(const std::vector<double> &sorted, NvU32 percent) {
+  if (sorted.empty()) { return 0.0; }
+  size_t rank = (sorted.size() * percent + 99) / 100;
+  if (rank == 0) { rank = 1; }
+  return sorted[rank - 1];
+}
+
+// Only the NVAPI call is timed, buffer setup is identical to RunRawApiCommand and stays outside the measurement.
+void BenchApiSpec(NvPhysicalGpuHandle gpu, const ApiSpec &spec, NvU32 warmup, NvU32 iterations,
+                  BenchApiResult *result) {
+  using BenchClock = std::chrono::steady_clock;
+  std::unique_ptr<NvU8[]> buffer(new NvU8[spec.size]);
+  const RawApiArgs args;
+  std::vector<double> samples;
+  samples.reserve(iterations);
+  *result = {};
+  result->iterations = iterations;
+  result->lastFailure = NVAPI_OK;
+
+  for (NvU32 i = 0; i < warmup + iterations; ++i) {
+    std::memset(buffer.get(), 0, spec.size);
+    *reinterpret_cast<NvU32 *>(buffer.get()) = spec.version;
+    if (spec.prepare) { spec.prepare(buffer.get(), args); }
+
+    const auto start = BenchClock::now();
+    const NvAPI_Status status = spec.call(gpu, buffer.get());
+    const double elapsedUs = std::chrono::duration<double, std::micro>(BenchClock::now() - start).count();
+    if (i < warmup) { continue; }
+    if (status != NVAPI_OK) {
+      ++result->failures;
+      result->lastFailure = status;
+      continue;
+    }
+    samples.push_back(elapsedUs);
+  }
+
+  if (samples.empty()) { return; }
+  std::sort(samples.begin(), samples.end());
+  double total = 0.0;
+  for (double sample : samples) { total += sample; }
+  result->p50Us = BenchPercentile(samples, 50);
+  result->p90Us = BenchPercentile(samples, 90);
+  result->p99Us = BenchPercentile(samples, 99);
+  result->maxUs = samples.back();
+  result->meanUs = total / samples.size();
+}
+
+void PrintBenchApiUsage() {
+  Printf("Usage: %s bench api [--index N] [--iterations N] [--warmup N] [--group clock|power|thermal]\n", kToolName);
+  Printf("       [--api NAME] [--out PATH] [--append]\n");
+}
+
+void PrintBenchUsage() { PrintUsageGroup("bench"); }
+
+const SubcommandEntry kBenchCommands[] = {
+    {"api", CmdBenchApi},
+};
+} // namespace
+
+int CmdBenchApi(int argc, char **argv) {
+  NvU32 index = 0;
+  bool hasIndex = false;
+  NvU32 iterations = 100;
+  NvU32 warmup = 3;
+  const char *groupName = nullptr;
+  const char *apiName = nullptr;
+  const char *outPath = nullptr;
+  bool append = false;
+
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "help") == 0) {
+      PrintBenchApiUsage();
+      return 0;
+    }
+    if (std::strcmp(argv[i], "--index") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
+        Printf("Invalid GPU index.\n");
+        return 1;
+      }
+      hasIndex = true;
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--iterations") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &iterations) || iterations == 0) {
+        Printf("Invalid value for --iterations\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--warmup") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &warmup)) {
+        Printf("Invalid value for --warmup\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--group") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --group\n");
+        return 1;
+      }
+      groupName = argv[i + 1];
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--api") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --api\n");
+        return 1;
+      }
+      apiName = argv[i + 1];
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--out") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --out\n");
+        return 1;
+      }
+      outPath = argv[i + 1];
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--append") == 0) {
+      append = true;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    PrintBenchApiUsage();
+    return 1;
+  }
+
+  size_t groupCount = 0;
+  const ApiSpecGroup *groups = RawApiGroups(&groupCount);
+  std::vector<std::pair<const ApiSpecGroup *, const ApiSpec *>> specs;
+  for (size_t g = 0; g < groupCount; ++g) {
+    const ApiSpecGroup &group = groups[g];
+    if (groupName && std::strcmp(groupName, group.name) != 0) { continue; }
+    for (size_t i = 0; i < group.count; ++i) {
+      // Setters would apply a zeroed control struct, only getters are benchmarked.
+      if (group.specs[i].isSet) { continue; }
+      if (apiName && std::strcmp(apiName, group.specs[i].name) != 0) { continue; }
+      specs.emplace_back(&group, &group.specs[i]);
+    }
+  }
+  if (specs.empty()) {
+    if (groupName && !apiName) {
+      Printf("Unknown api group: %s\n", groupName);
+    } else {
+      Printf("No getter api matches %s\n", apiName ? apiName : "");
+    }
+    return 1;
+  }
+
+  std::vector<NvPhysicalGpuHandle> handles;
+  std::vector<NvU32> indices;
+  if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
+
+  NvU32 driverVersion = 0;
+  NvAPI_ShortString branch = {0};
+  if (NvApi().NvAPI_SYS_GetDriverAndBranchVersion(&driverVersion, branch) != NVAPI_OK) {
+    driverVersion = 0;
+    branch[0] = '\0';
+  }
+
+  FILE *csv = nullptr;
+  if (outPath) {
+    bool writeHeader = true;
+    if (append) {
+      FILE *existing = nullptr;
+      if (fopen_s(&existing, outPath, "rb") == 0 && existing) {
+        writeHeader = std::fgetc(existing) == EOF;
+        std::fclose(existing);
+      }
+    }
+    if (fopen_s(&csv, outPath, append ? "a" : "w") != 0 || !csv) {
+      Printf("Failed to open %s\n", outPath);
+      return 1;
+    }
+    if (writeHeader) {
+      std::fprintf(csv, "driver_version,branch,gpu,gpu_name,group,api,iterations,failures,failure_rate,p50_us,"
+                        "p90_us,p99_us,max_us,mean_us,status\n");
+    }
+  }
+
+  // GPUs run one after another, ForEachGpu would put concurrent calls into the driver and skew the latencies.
+  for (size_t g = 0; g < handles.size(); ++g) {
+    NvAPI_ShortString gpuName = {0};
+    if (NvApi().NvAPI_GPU_GetFullName(handles[g], gpuName) != NVAPI_OK) { gpuName[0] = '\0'; }
+    if (!StructuredOutput()) {
+      Printf("GPU %u: %s (driver %u.%02u, %d getters x %u iterations)\n", indices[g], gpuName[0] ? gpuName : "-",
+             driverVersion / 100, driverVersion % 100, static_cast<int>(specs.size()), iterations);
+      Printf("  %-8s %-32s %9s %9s %9s %9s %9s %8s\n", "group", "api", "p50 us", "p90 us", "p99 us", "max us",
+             "mean us", "fail");
+    }
+
+    for (const auto &entry : specs) {
+      BenchApiResult result;
+      BenchApiSpec(handles[g], *entry.second, warmup, iterations, &result);
+      const double failureRate = static_cast<double>(result.failures) / result.iterations;
+      const std::string status = result.failures > 0 ? NvapiStatusString(result.lastFailure) : std::string("OK");
+
+      if (StructuredOutput()) {
+        RecordWriter("bench_api")
+            .Field("gpu", indices[g])
+            .Field("group", entry.first->name)
+            .Field("api", entry.second->name)
+            .Field("iterations", result.iterations)
+            .Field("failures", result.failures)
+            .Field("failure_rate", failureRate)
+            .Field("p50_us", result.p50Us)
+            .Field("p90_us", result.p90Us)
+            .Field("p99_us", result.p99Us)
+            .Field("max_us", result.maxUs)
+            .Field("mean_us", result.meanUs)
+            .Field("status", status);
+      } else {
+        Printf("  %-8s %-32s %9.2f %9.2f %9.2f %9.2f %9.2f %7.1f%%", entry.first->name, entry.second->name,
+               result.p50Us, result.p90Us, result.p99Us, result.maxUs, result.meanUs, failureRate * 100.0);
+        if (result.failures > 0) { Printf(" %s", status.c_str()); }
+        Printf("\n");
+      }
+
+      if (csv) {
+        std::fprintf(csv, "%u.%02u,%s,%u,%s,%s,%s,%u,%u,%.4f,%.3f,%.3f,%.3f,%.3f,%.3f,%s\n", driverVersion / 100,
+                     driverVersion % 100, CsvField(branch).c_str(), indices[g], CsvField(gpuName).c_str(),
+                     entry.first->name, entry.second->name, result.iterations, result.failures, failureRate,
+                     result.p50Us, result.p90Us, result.p99Us, result.maxUs, result.meanUs,
+                     CsvField(status.c_str()).c_str());
+      }
+    }
+  }
+
+  if (csv) {
+    const bool ok = std::ferror(csv) == 0;
+    std::fclose(csv);
+    if (!ok) {
+      Printf("Failed to write %s\n", outPath);
+      return 1;
+    }
+    if (!StructuredOutput()) { Printf("Wrote %s\n", outPath); }
+  }
+  return 0;
+}
+
+int CmdBench(int argc, char **argv) {
+  return DispatchSubcommand("bench", argc, argv, kBenchCommands, sizeof(kBenchCommands) / sizeof(kBenchCommands[0]),
+                            PrintBenchUsage);
+}
+} // namespace nvcli
@@ -4,6 +4,9 @@
  */
 
 #include "cli/common.h"
+#include "cli/topology.h"
+
+#include <atomic>
 
 namespace nvcli {
 const char *kToolName = "nvapi-cli";
@@ -12,12 +15,20 @@ std::string ToLowerAscii(const char *value);
 
 std::string NvapiStatusString(NvAPI_Status status) {
   NvAPI_ShortString err = {0};
-  if (NvAPI_GetErrorMessage(status, err) == NVAPI_OK) { return std::string(err); }
+  if (NvApi().NvAPI_GetErrorMessage(status, err) == NVAPI_OK) { return std::string(err); }
   return "NVAPI_ERROR";
 }
 
 void PrintNvapiError(const char *prefix, NvAPI_Status status) {
-  std::printf("%s: %s (0x%08X)\n", prefix, NvapiStatusString(status).c_str(), status);
+  if (StructuredOutput()) {
+    while (*prefix == ' ') { ++prefix; }
+    RecordWriter("error")
+        .Field("message", prefix)
+        .Field("status", NvapiStatusString(status))
+        .Field("code", static_cast<NvS32>(status));
+    return;
+  }
+  Printf("%s: %s (0x%08X)\n", prefix, NvapiStatusString(status).c_str(), status);
 }
 
 bool ParseUint(const char *text, NvU32 *out) {
@@ -29,6 +40,15 @@ bool ParseUint(const char *text, NvU32 *out) {
   return true;
 }
 
+bool ParseDoubleValue(const char *value, double *out) {
+  if (!value || !out) { return false; }
+  char *end = NULL;
+  double parsed = std::strtod(value, &end);
+  if (end == value || *end != '\0') { return false; }
+  *out = parsed;
+  return true;
+}
+
 bool ParseSrcDevicePair(const char *text, NvU32 *srcId, NvU32 *device) {
   if (!text || !srcId || !device) { return false; }
   const char *sep = std::strchr(text, ':');
@@ -40,16 +60,10 @@ bool ParseSrcDevicePair(const char *text, NvU32 *srcId, NvU32 *device) {
 
 bool GetDisplayHandleByIndex(NvU32 index, NvDisplayHandle *outHandle) {
   if (!outHandle) { return false; }
-  NvDisplayHandle handle = NULL;
-  NvU32 current = 0;
-  while (NvAPI_EnumNvidiaDisplayHandle(current, &handle) == NVAPI_OK) {
-    if (current == index) {
-      *outHandle = handle;
-      return true;
-    }
-    ++current;
-  }
-  return false;
+  TopologyDisplay display = {};
+  if (!Topology().DisplayByIndex(index, &display)) { return false; }
+  *outHandle = display.handle;
+  return true;
 }
 
 const SubcommandEntry *FindSubcommand(const SubcommandEntry *entries, size_t count, const char *name) {
@@ -66,9 +80,9 @@ int DispatchSubcommand(const char *group, int argc, char **argv, const Subcomman
     if (printUsage) {
       printUsage();
     } else if (group) {
-      std::printf("Missing %s subcommand.\n", group);
+      Printf("Missing %s subcommand.\n", group);
     } else {
-      std::printf("Missing subcommand.\n");
+      Printf("Missing subcommand.\n");
     }
     return 1;
   }
@@ -85,9 +99,9 @@ int DispatchSubcommand(const char *group, int argc, char **argv, const Subcomman
   const SubcommandEntry *entry = FindSubcommand(entries, count, argv[0]);
   if (!entry) {
     if (group) {
-      std::printf("Unknown %s subcommand: %s\n", group, argv[0]);
+      Printf("Unknown %s subcommand: %s\n", group, argv[0]);
     } else {
-      std::printf("Unknown subcommand: %s\n", argv[0]);
+      Printf("Unknown subcommand: %s\n", argv[0]);
     }
     if (printUsage) { printUsage(); }
     return 1;
@@ -292,6 +306,47 @@ const char *PerfLimitPstatePointName(NV_GPU_PERF_LIMIT_INPUT_DATA_PSTATE_POINT p
   }
 }
 
+const char *PerfPolicyName(NvU32 id) {
+  switch (id) {
+  case NV_GPU_PERF_POLICY_ID_SW_POWER:
+    return "power";
+  case NV_GPU_PERF_POLICY_ID_SW_THERMAL:
+    return "thermal";
+  case NV_GPU_PERF_POLICY_ID_SW_RELIABILITY:
+    return "reliability";
+  case NV_GPU_PERF_POLICY_ID_SW_OPERATING:
+    return "operating";
+  case NV_GPU_PERF_POLICY_ID_SW_UTILIZATION:
+    return "utilization";
+  case NV_GPU_PERF_POLICY_ID_SW_SLI_GPU_BOOST_SYNC:
+    return "sli-sync";
+  default:
+    return nullptr;
+  }
+}
+
+const char *PowerChannelRailName(NV_GPU_POWER_CHANNEL_POWER_RAIL rail) {
+  switch (rail) {
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_UNKNOWN: return "UNKNOWN";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_NVVDD: return "OUTPUT_NVVDD";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_FBVDD: return "OUTPUT_FBVDD";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_FBVDDQ: return "OUTPUT_FBVDDQ";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_FBVDD_Q: return "OUTPUT_FBVDD_Q";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_PEXVDD: return "OUTPUT_PEXVDD";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_A3V3: return "OUTPUT_A3V3";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_TOTAL_GPU: return "OUTPUT_TOTAL_GPU";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_PEX12V: return "INPUT_PEX12V";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_PEX3V3: return "INPUT_PEX3V3";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_EXT12V_8PIN0: return "INPUT_EXT12V_8PIN0";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_EXT12V_8PIN1: return "INPUT_EXT12V_8PIN1";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_EXT12V_6PIN0: return "INPUT_EXT12V_6PIN0";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_EXT12V_6PIN1: return "INPUT_EXT12V_6PIN1";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_TOTAL_BOARD: return "INPUT_TOTAL_BOARD";
+  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_TOTAL_BOARD2: return "INPUT_TOTAL_BOARD2";
+  default: return "UNKNOWN";
+  }
+}
+
 const char *VpstateTypeName(NV_GPU_PERF_VPSTATE_TYPE type) {
   switch (type) {
   case NV_GPU_PERF_VPSTATE_TYPE_2X: return "2X";
@@ -363,18 +418,18 @@ bool ParseGpuIndexArgs(int argc, char **argv, NvU32 *indexOut, bool *hasIndex) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return false;
       }
       if (!ParseUint(argv[i + 1], indexOut)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return false;
       }
       *hasIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return false;
   }
   return true;
@@ -386,22 +441,22 @@ bool ParseDisplayIdArg(int argc, char **argv, NvU32 *displayId) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --id\n");
+        Printf("Missing value for --id\n");
         return false;
       }
       if (!ParseUint(argv[i + 1], displayId)) {
-        std::printf("Invalid display id: %s\n", argv[i + 1]);
+        Printf("Invalid display id: %s\n", argv[i + 1]);
         return false;
       }
       found = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return false;
   }
   if (!found) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return false;
   }
   return true;
@@ -415,11 +470,11 @@ bool ParseDisplayIdsArgs(int argc, char **argv, NvU32 *gpuIndex, bool *hasIndex,
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return false;
       }
       if (!ParseUint(argv[i + 1], gpuIndex)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return false;
       }
       *hasIndex = true;
@@ -432,17 +487,17 @@ bool ParseDisplayIdsArgs(int argc, char **argv, NvU32 *gpuIndex, bool *hasIndex,
     }
     if (std::strcmp(argv[i], "--flags") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --flags\n");
+        Printf("Missing value for --flags\n");
         return false;
       }
       if (!ParseUint(argv[i + 1], flags)) {
-        std::printf("Invalid flags: %s\n", argv[i + 1]);
+        Printf("Invalid flags: %s\n", argv[i + 1]);
         return false;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return false;
   }
   return true;
@@ -454,7 +509,7 @@ bool ParseEdidFlagArg(int argc, char **argv, NV_EDID_FLAG *flag) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--flag") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --flag\n");
+        Printf("Missing value for --flag\n");
         return false;
       }
       const char *value = argv[i + 1];
@@ -475,7 +530,7 @@ bool ParseEdidFlagArg(int argc, char **argv, NV_EDID_FLAG *flag) {
       } else {
         NvU32 numeric = 0;
         if (!ParseUint(value, &numeric)) {
-          std::printf("Invalid flag: %s\n", value);
+          Printf("Invalid flag: %s\n", value);
           return false;
         }
         *flag = static_cast<NV_EDID_FLAG>(numeric);
@@ -645,6 +700,29 @@ std::string ToLowerAscii(const char *value) {
   return out;
 }
 
+// Case-insensitive match where '*' spans any run of characters and '?' matches one character.
+bool WildcardMatch(const char *pattern, const char *text) {
+  const char *star = nullptr;
+  const char *resume = nullptr;
+  while (*text) {
+    if (*pattern == '*') {
+      star = pattern++;
+      resume = text;
+    } else if (*pattern == '?' ||
+               std::tolower(static_cast<unsigned char>(*pattern)) == std::tolower(static_cast<unsigned char>(*text))) {
+      ++pattern;
+      ++text;
+    } else if (star) {
+      pattern = star + 1;
+      text = ++resume;
+    } else {
+      return false;
+    }
+  }
+  while (*pattern == '*') { ++pattern; }
+  return *pattern == '\0';
+}
+
 bool ParseBoolValue(const char *value, bool *out) {
   if (!value || !out) { return false; }
   std::string lowered = ToLowerAscii(value);
@@ -682,6 +760,18 @@ std::string NvUnicodeToUtf8(const NvAPI_UnicodeString value) {
   return out;
 }
 
+const char *NvUnicodeToUtf8(const NvAPI_UnicodeString value, char (&out)[kNvUnicodeUtf8Max]) {
+  out[0] = '\0';
+  if (!value) { return out; }
+  const wchar_t *wide = reinterpret_cast<const wchar_t *>(value);
+  size_t length = 0;
+  while (length < NVAPI_UNICODE_STRING_MAX && wide[length] != L'\0') { ++length; }
+  const int written = WideCharToMultiByte(CP_UTF8, 0, wide, static_cast<int>(length), out,
+                                          static_cast<int>(kNvUnicodeUtf8Max - 1), NULL, NULL);
+  out[written > 0 ? written : 0] = '\0';
+  return out;
+}
+
 std::string GuidToString(const NvGUID &guid) {
   char buffer[64] = {};
   std::snprintf(buffer, sizeof(buffer), "{%08X-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X}", guid.data1, guid.data2,
@@ -762,22 +852,22 @@ const char *DpNodeTypeName(NV_DP_NODE_TYPE type) {
 }
 
 bool CollectGpus(bool hasIndex, NvU32 index, std::vector<NvPhysicalGpuHandle> &handles, std::vector<NvU32> &indices) {
-  NvPhysicalGpuHandle gpus[NVAPI_MAX_PHYSICAL_GPUS] = {};
-  NvU32 gpuCount = 0;
-  NvAPI_Status status = NvAPI_EnumPhysicalGPUs(gpus, &gpuCount);
+  std::vector<NvPhysicalGpuHandle> gpus;
+  NvAPI_Status status = Topology().PhysicalGpus(&gpus);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_EnumPhysicalGPUs failed", status);
     return false;
   }
+  const NvU32 gpuCount = static_cast<NvU32>(gpus.size());
 
   if (gpuCount == 0) {
-    std::printf("No NVIDIA GPUs found.\n");
+    Printf("No NVIDIA GPUs found.\n");
     return false;
   }
 
   if (hasIndex) {
     if (index >= gpuCount) {
-      std::printf("GPU index %u out of range (0-%u).\n", index, gpuCount - 1);
+      Printf("GPU index %u out of range (0-%u).\n", index, gpuCount - 1);
       return false;
     }
     handles.push_back(gpus[index]);
@@ -810,386 +900,447 @@ bool MaskE255Has(const NV_GPU_BOARDOBJGRP_MASK_E255 &mask, NvU32 index) {
 
 namespace {
 void PrintUsageSummary() {
-  std::printf("Usage:\n");
-  std::printf("  %s help [group]\n", kToolName);
-  std::printf("  %s info\n", kToolName);
-  std::printf("  %s <group> <command> [options]\n", kToolName);
-  std::printf("    groups: gpu display mosaic sli gsync drs video hdmi dp pcf sys d3d ogl vr stereo\n");
-  std::printf("\n");
-  std::printf("Use \"%s help <group>\" or \"%s <group> help\" for details.\n", kToolName, kToolName);
-  std::printf("Use \"%s help all\" for the full list.\n", kToolName);
-  std::printf("\n");
+  Printf("Usage:\n");
+  Printf("  %s help [group]\n", kToolName);
+  Printf("  %s info\n", kToolName);
+  Printf("  %s batch FILE|- [--stop-on-error]\n", kToolName);
+  Printf("  %s serve [--pipe NAME]\n", kToolName);
+  Printf("  %s <group> <command> [options]\n", kToolName);
+  Printf("    groups: gpu display mosaic sli gsync drs video hdmi dp pcf sys d3d ogl vr stereo bench log\n");
+  Printf("\n");
+  Printf("Global options (before the group):\n");
+  Printf("  --backend driver|record:DIR|replay:DIR\n");
+  Printf("  --jobs N (GPUs queried in parallel, 0 = all, 1 = serial)\n");
+  Printf("  --format text|json|ndjson|csv\n");
+  Printf("  --trace FILE (Chrome trace JSON of every NVAPI call)\n");
+  Printf("\n");
+  Printf("Use \"%s help <group>\" or \"%s <group> help\" for details.\n", kToolName, kToolName);
+  Printf("Use \"%s help all\" for the full list.\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageInfo() {
-  std::printf("Info commands:\n");
-  std::printf("  %s info\n", kToolName);
-  std::printf("\n");
+  Printf("Info commands:\n");
+  Printf("  %s info\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageGpu() {
-  std::printf("GPU commands:\n");
-  std::printf("  %s gpu list\n", kToolName);
-  std::printf("  %s gpu memory [--index N]\n", kToolName);
-  std::printf("  %s gpu clocks [--index N]\n", kToolName);
-  std::printf("  %s gpu utilization [--index N]\n", kToolName);
-  std::printf("  %s gpu dynamic-pstates-set [--index N] --enable 0|1\n", kToolName);
-  std::printf("  %s gpu force-pstate [--index N] --pstate P0|auto [--fallback error|higher|lower]\n", kToolName);
-  std::printf("  %s gpu force-pstate-ex [--index N] --pstate P0|auto [--fallback error|higher|lower] [--async 0|1]\n",
-              kToolName);
-  std::printf("  %s gpu pstate [--index N]\n", kToolName);
-  std::printf("  %s gpu pstates20 [--index N]\n", kToolName);
-  std::printf("  %s gpu pstates20-set [--index N] --pstate P0 (--clock graphics|memory|processor|video --delta-khz N | "
-              "--voltage core --delta-uv N)\n",
-              kToolName);
-  std::printf("  %s gpu pstates20-private [--index N]\n", kToolName);
-  std::printf("  %s gpu pstates20-private-set [--index N] --pstate P0 (--clock-id ID --delta-khz N | --voltage-domain "
-              "core|fb|cold-core|core-nominal|ID (--delta-uv N | --target-uv N))\n",
-              kToolName);
-  std::printf("  %s gpu bus [--index N]\n", kToolName);
-  std::printf("  %s gpu vbios [--index N]\n", kToolName);
-  std::printf("  %s gpu cooler [--index N]\n", kToolName);
-  std::printf("  %s gpu cooler-policy get [--index N] --cooler N [--policy "
-              "manual|perf|temp-discrete|temp-cont|temp-cont-sw|default]\n",
-              kToolName);
-  std::printf("  %s gpu cooler-policy set [--index N] --cooler N --level-id N --level PCT [--policy "
-              "manual|perf|temp-discrete|temp-cont|temp-cont-sw|default]\n",
-              kToolName);
-  std::printf("  %s gpu cooler-policy restore [--index N] [--cooler N] [--policy "
-              "manual|perf|temp-discrete|temp-cont|temp-cont-sw|default]\n",
-              kToolName);
-  std::printf("  %s gpu bar [--index N]\n", kToolName);
-  std::printf("  %s gpu ecc status [--index N]\n", kToolName);
-  std::printf("  %s gpu ecc errors [--index N] [--raw]\n", kToolName);
-  std::printf("  %s gpu ecc config [--index N]\n", kToolName);
-  std::printf("  %s gpu ecc set [--index N] --enable 0|1 [--immediate 0|1] [--clear 0|1]\n", kToolName);
-  std::printf("  %s gpu ecc reset [--index N] --current 0|1 --aggregate 0|1\n", kToolName);
-  std::printf("  %s gpu board mfg [--index N]\n", kToolName);
-  std::printf("  %s gpu pcie info [--index N]\n", kToolName);
-  std::printf("  %s gpu pcie switch-errors [--index N]\n", kToolName);
-  std::printf("  %s gpu pcie errors [--index N]\n", kToolName);
-  std::printf("  %s gpu pcie aer [--index N]\n", kToolName);
-  std::printf("  %s gpu pcie aspm-set [--index N] --enable 0|1\n", kToolName);
-  std::printf("  %s gpu pcie width-set [--index N] --width N\n", kToolName);
-  std::printf("  %s gpu pcie speed-set [--index N] --speed N\n", kToolName);
-  std::printf("  %s gpu power [--index N]\n", kToolName);
-  std::printf("  %s gpu gc6 control [--index N] --op clear-stats|enable-stats|disable-stats|supported|enabled\n",
-              kToolName);
-  std::printf("  %s gpu gc6 force-exit [--index N]\n", kToolName);
-  std::printf("  %s gpu deep-idle state [--index N]\n", kToolName);
-  std::printf("  %s gpu deep-idle set [--index N] --state enabled|disabled\n", kToolName);
-  std::printf("  %s gpu deep-idle stats-mode [--index N] --mode nh|ve|ssc|fo [--reset 0|1]\n", kToolName);
-  std::printf("  %s gpu deep-idle stats [--index N]\n", kToolName);
-  std::printf("  %s gpu oc-scanner start [--index N]\n", kToolName);
-  std::printf("  %s gpu oc-scanner stop [--index N]\n", kToolName);
-  std::printf("  %s gpu oc-scanner revert [--index N]\n", kToolName);
-  std::printf("  %s gpu power limit [--index N]\n", kToolName);
-  std::printf("  %s gpu power limit-set [--index N] --limit 0-255|max [--flags HEX]\n", kToolName);
-  std::printf("  %s gpu power monitor info [--index N]\n", kToolName);
-  std::printf("  %s gpu power monitor status [--index N]\n", kToolName);
-  std::printf("  %s gpu power device info [--index N]\n", kToolName);
-  std::printf("  %s gpu power device status [--index N]\n", kToolName);
-  std::printf("  %s gpu power capping info [--index N]\n", kToolName);
-  std::printf("  %s gpu power capping slowdown [--index N]\n", kToolName);
-  std::printf("  %s gpu power leakage info [--index N]\n", kToolName);
-  std::printf("  %s gpu power leakage status [--index N]\n", kToolName);
-  std::printf("  %s gpu vf tables [--index N]\n", kToolName);
-  std::printf("  %s gpu vf inject [--index N] [--flags HEX] [--clk-domain ID --clk-khz N] [--volt-domain "
-              "logic|sram|msvdd|ID --volt-rail N --volt-uv N --volt-min-uv N]\n",
-              kToolName);
-  std::printf("  %s gpu vpstates info [--index N]\n", kToolName);
-  std::printf("  %s gpu vpstates control [--index N] [--original]\n", kToolName);
-  std::printf("  %s gpu vpstates set [--index N] --vpstate N (--clock N --target-mhz N [--min-eff-mhz N] | --group N "
-              "--value N)\n",
-              kToolName);
-  std::printf("  %s gpu vfe-var info [--index N]\n", kToolName);
-  std::printf("  %s gpu vfe-var control [--index N]\n", kToolName);
-  std::printf("  %s gpu vfe-var set [--index N] --var N --override-type none|value|offset|scale [--override-value F] "
-              "[--temp-hyst-pos C] [--temp-hyst-neg C]\n",
-              kToolName);
-  std::printf("  %s gpu vfe-equ info [--index N]\n", kToolName);
-  std::printf("  %s gpu vfe-equ control [--index N]\n", kToolName);
-  std::printf("  %s gpu vfe-equ set [--index N] --equ N (--compare-func eq|gte|gt --compare-crit F | --minmax min|max "
-              "| --coeffs A,B,C)\n",
-              kToolName);
-  std::printf("  %s gpu perf-limits info [--index N]\n", kToolName);
-  std::printf("  %s gpu perf-limits status [--index N]\n", kToolName);
-  std::printf("  %s gpu perf-limits set [--index N] --limit-id ID --type disabled|pstate|freq|vpstate [--pstate P0] "
-              "[--point nominal|min|max|mid] [--freq-khz N --domain ID] [--vpstate N]\n",
-              kToolName);
-  std::printf("  %s gpu voltage [--index N]\n", kToolName);
-  std::printf("  %s gpu voltage control-set [--index N] --enable 0|1\n", kToolName);
-  std::printf("  %s gpu thermal [--index N]\n", kToolName);
-  std::printf("  %s gpu thermal level [--index N]\n", kToolName);
-  std::printf("  %s gpu thermal slowdown [--index N]\n", kToolName);
-  std::printf("  %s gpu thermal slowdown-set [--index N] --state enabled|disabled\n", kToolName);
-  std::printf("  %s gpu thermal sim [--index N] [--sensor N]\n", kToolName);
-  std::printf("  %s gpu thermal sim-set [--index N] --sensor N --mode enabled|disabled [--temp C]\n", kToolName);
-  std::printf("  %s gpu fan set [--index N] --cooler N --level PCT [--policy "
-              "manual|perf|temp-discrete|temp-cont|temp-cont-sw|default]\n",
-              kToolName);
-  std::printf("  %s gpu fan restore [--index N] [--cooler N]\n", kToolName);
-  std::printf("  %s gpu client-fan coolers info [--index N]\n", kToolName);
-  std::printf("  %s gpu client-fan coolers status [--index N]\n", kToolName);
-  std::printf("  %s gpu client-fan coolers control [--index N]\n", kToolName);
-  std::printf("  %s gpu client-fan coolers set [--index N] --cooler N [--level PCT] [--enable 0|1] [--default]\n",
-              kToolName);
-  std::printf("  %s gpu client-fan policies info [--index N]\n", kToolName);
-  std::printf("  %s gpu client-fan policies status [--index N]\n", kToolName);
-  std::printf("  %s gpu client-fan policies control [--index N]\n", kToolName);
-  std::printf("  %s gpu client-fan policies set [--index N] --policy N --fan-stop 0|1 [--default]\n", kToolName);
-  std::printf("  %s gpu client-fan arbiters info [--index N]\n", kToolName);
-  std::printf("  %s gpu client-fan arbiters status [--index N]\n", kToolName);
-  std::printf("  %s gpu client-fan arbiters control [--index N]\n", kToolName);
-  std::printf("  %s gpu client-fan arbiters set [--index N] --arbiter N --fan-stop 0|1\n", kToolName);
-  std::printf("  %s gpu client-illum devices info [--index N]\n", kToolName);
-  std::printf("  %s gpu client-illum devices control [--index N]\n", kToolName);
-  std::printf("  %s gpu client-illum devices set [--index N] --device N --sync 0|1 [--timestamp-ms N]\n", kToolName);
-  std::printf("  %s gpu client-illum zones info [--index N]\n", kToolName);
-  std::printf("  %s gpu client-illum zones control [--index N]\n", kToolName);
-  std::printf(
+  Printf("GPU commands:\n");
+  Printf("  %s gpu list\n", kToolName);
+  Printf("  %s gpu memory [--index N]\n", kToolName);
+  Printf("  %s gpu clocks [--index N]\n", kToolName);
+  Printf("  %s gpu utilization [--index N]\n", kToolName);
+  Printf("  %s gpu sample [--index N] [--interval-ms N] [--duration S] [--out PATH] [--log PATH]\n", kToolName);
+  Printf("  %s gpu pmumon [--index N] [--source clocks,fans,thermal,perf-policies|all] [--interval-ms N]\n", kToolName);
+  Printf("     [--duration S] [--out PATH]\n");
+  Printf("  %s gpu dynamic-pstates-set [--index N] --enable 0|1\n", kToolName);
+  Printf("  %s gpu force-pstate [--index N] --pstate P0|auto [--fallback error|higher|lower]\n", kToolName);
+  Printf("  %s gpu force-pstate-ex [--index N] --pstate P0|auto [--fallback error|higher|lower] [--async 0|1]\n",
+         kToolName);
+  Printf("  %s gpu pstate [--index N]\n", kToolName);
+  Printf("  %s gpu pstates20 [--index N]\n", kToolName);
+  Printf("  %s gpu pstates20-set [--index N] --pstate P0 (--clock graphics|memory|processor|video --delta-khz N | "
+         "--voltage core --delta-uv N)\n",
+         kToolName);
+  Printf("  %s gpu pstates20-private [--index N]\n", kToolName);
+  Printf("  %s gpu pstates20-private-set [--index N] --pstate P0 (--clock-id ID --delta-khz N | --voltage-domain "
+         "core|fb|cold-core|core-nominal|ID (--delta-uv N | --target-uv N))\n",
+         kToolName);
+  Printf("  %s gpu bus [--index N]\n", kToolName);
+  Printf("  %s gpu vbios [--index N]\n", kToolName);
+  Printf("  %s gpu cooler [--index N]\n", kToolName);
+  Printf("  %s gpu cooler-policy get [--index N] --cooler N [--policy "
+         "manual|perf|temp-discrete|temp-cont|temp-cont-sw|default]\n",
+         kToolName);
+  Printf("  %s gpu cooler-policy set [--index N] --cooler N --level-id N --level PCT [--policy "
+         "manual|perf|temp-discrete|temp-cont|temp-cont-sw|default]\n",
+         kToolName);
+  Printf("  %s gpu cooler-policy restore [--index N] [--cooler N] [--policy "
+         "manual|perf|temp-discrete|temp-cont|temp-cont-sw|default]\n",
+         kToolName);
+  Printf("  %s gpu bar [--index N]\n", kToolName);
+  Printf("  %s gpu ecc status [--index N]\n", kToolName);
+  Printf("  %s gpu ecc errors [--index N] [--raw]\n", kToolName);
+  Printf("  %s gpu ecc config [--index N]\n", kToolName);
+  Printf("  %s gpu ecc set [--index N] --enable 0|1 [--immediate 0|1] [--clear 0|1]\n", kToolName);
+  Printf("  %s gpu ecc reset [--index N] --current 0|1 --aggregate 0|1\n", kToolName);
+  Printf("  %s gpu board mfg [--index N]\n", kToolName);
+  Printf("  %s gpu pcie info [--index N]\n", kToolName);
+  Printf("  %s gpu pcie switch-errors [--index N]\n", kToolName);
+  Printf("  %s gpu pcie errors [--index N]\n", kToolName);
+  Printf("  %s gpu pcie aer [--index N]\n", kToolName);
+  Printf("  %s gpu pcie aspm-set [--index N] --enable 0|1\n", kToolName);
+  Printf("  %s gpu pcie width-set [--index N] --width N\n", kToolName);
+  Printf("  %s gpu pcie speed-set [--index N] --speed N\n", kToolName);
+  Printf("  %s gpu power [--index N]\n", kToolName);
+  Printf("  %s gpu gc6 control [--index N] --op clear-stats|enable-stats|disable-stats|supported|enabled\n", kToolName);
+  Printf("  %s gpu gc6 force-exit [--index N]\n", kToolName);
+  Printf("  %s gpu deep-idle state [--index N]\n", kToolName);
+  Printf("  %s gpu deep-idle set [--index N] --state enabled|disabled\n", kToolName);
+  Printf("  %s gpu deep-idle stats-mode [--index N] --mode nh|ve|ssc|fo [--reset 0|1]\n", kToolName);
+  Printf("  %s gpu deep-idle stats [--index N]\n", kToolName);
+  Printf("  %s gpu oc-scanner start [--index N]\n", kToolName);
+  Printf("  %s gpu oc-scanner stop [--index N]\n", kToolName);
+  Printf("  %s gpu oc-scanner revert [--index N]\n", kToolName);
+  Printf("  %s gpu tune --journal PATH [--index N] --min N --max N [--knob clock|voltage] [--pstate P0] [--clock "
+         "graphics] [--voltage core] [--step N] [--strategy golden|bisect] [--target MHZ_PER_W] [--max-steps N] "
+         "[--settle-ms MS] [--window-ms MS] [--interval-ms MS] [--reject-limit NAME]... [--apply]\n",
+         kToolName);
+  Printf("  %s gpu tune --journal PATH\n", kToolName);
+  Printf("  %s gpu power limit [--index N]\n", kToolName);
+  Printf("  %s gpu power limit-set [--index N] --limit 0-255|max [--flags HEX]\n", kToolName);
+  Printf("  %s gpu power monitor info [--index N]\n", kToolName);
+  Printf("  %s gpu power monitor status [--index N]\n", kToolName);
+  Printf("  %s gpu power device info [--index N]\n", kToolName);
+  Printf("  %s gpu power device status [--index N]\n", kToolName);
+  Printf("  %s gpu power capping info [--index N]\n", kToolName);
+  Printf("  %s gpu power capping slowdown [--index N]\n", kToolName);
+  Printf("  %s gpu power leakage info [--index N]\n", kToolName);
+  Printf("  %s gpu power leakage status [--index N]\n", kToolName);
+  Printf("  %s gpu energy start --name NAME [--index N] [--state-dir DIR] [--force]\n", kToolName);
+  Printf("  %s gpu energy read --name NAME [--state-dir DIR]\n", kToolName);
+  Printf("  %s gpu energy stop --name NAME [--state-dir DIR]\n", kToolName);
+  Printf("  %s gpu energy run [--index N] [--interval-ms MS] -- CMD [ARGS...]\n", kToolName);
+  Printf("  %s gpu vf tables [--index N]\n", kToolName);
+  Printf("  %s gpu vf inject [--index N] [--flags HEX] [--clk-domain ID --clk-khz N] [--volt-domain "
+         "logic|sram|msvdd|ID --volt-rail N --volt-uv N --volt-min-uv N]\n",
+         kToolName);
+  Printf("  %s gpu vf curve [--index N] [--source client|tables] [--domain NAME] [--at UV]... [--at-mhz MHZ]... "
+         "[--summary] [--label TEXT] [--save FILE]\n",
+         kToolName);
+  Printf("  %s gpu vf compare [--index N] [--source client|tables] [--domain NAME] [--load FILE]... [--no-live] "
+         "[--step UV] [--points]\n",
+         kToolName);
+  Printf("  %s gpu vpstates info [--index N]\n", kToolName);
+  Printf("  %s gpu vpstates control [--index N] [--original]\n", kToolName);
+  Printf("  %s gpu vpstates set [--index N] --vpstate N (--clock N --target-mhz N [--min-eff-mhz N] | --group N "
+         "--value N)\n",
+         kToolName);
+  Printf("  %s gpu vfe-var info [--index N]\n", kToolName);
+  Printf("  %s gpu vfe-var control [--index N]\n", kToolName);
+  Printf("  %s gpu vfe-var set [--index N] --var N --override-type none|value|offset|scale [--override-value F] "
+         "[--temp-hyst-pos C] [--temp-hyst-neg C]\n",
+         kToolName);
+  Printf("  %s gpu vfe-equ info [--index N]\n", kToolName);
+  Printf("  %s gpu vfe-equ control [--index N]\n", kToolName);
+  Printf("  %s gpu vfe-equ set [--index N] --equ N (--compare-func eq|gte|gt --compare-crit F | --minmax min|max "
+         "| --coeffs A,B,C)\n",
+         kToolName);
+  Printf("  %s gpu vfe-equ eval [--index N] [--equ N]... [--temp C|A-B:STEP] [--voltage UV|A-B:STEP] "
+         "[--freq MHZ|A-B:STEP] [--var IDX=V|IDX=A-B:STEP]... [--override IDX=none|value|offset|scale:F]... "
+         "[--no-overrides] [--program]\n",
+         kToolName);
+  Printf("  %s gpu perf-limits info [--index N]\n", kToolName);
+  Printf("  %s gpu perf-limits status [--index N]\n", kToolName);
+  Printf("  %s gpu perf-limits watch [--index N] [--interval-ms MS] [--duration SEC]\n", kToolName);
+  Printf("  %s gpu perf-limits set [--index N] --limit-id ID --type disabled|pstate|freq|vpstate [--pstate P0] "
+         "[--point nominal|min|max|mid] [--freq-khz N --domain ID] [--vpstate N]\n",
+         kToolName);
+  Printf("  %s gpu voltage [--index N]\n", kToolName);
+  Printf("  %s gpu voltage control-set [--index N] --enable 0|1\n", kToolName);
+  Printf("  %s gpu thermal [--index N]\n", kToolName);
+  Printf("  %s gpu thermal level [--index N]\n", kToolName);
+  Printf("  %s gpu thermal slowdown [--index N]\n", kToolName);
+  Printf("  %s gpu thermal slowdown-set [--index N] --state enabled|disabled\n", kToolName);
+  Printf("  %s gpu thermal sim [--index N] [--sensor N]\n", kToolName);
+  Printf("  %s gpu thermal sim-set [--index N] --sensor N --mode enabled|disabled [--temp C]\n", kToolName);
+  Printf("  %s gpu fan set [--index N] --cooler N --level PCT [--policy "
+         "manual|perf|temp-discrete|temp-cont|temp-cont-sw|default]\n",
+         kToolName);
+  Printf("  %s gpu fan restore [--index N] [--cooler N]\n", kToolName);
+  Printf("  %s gpu client-fan coolers info [--index N]\n", kToolName);
+  Printf("  %s gpu client-fan coolers status [--index N]\n", kToolName);
+  Printf("  %s gpu client-fan coolers control [--index N]\n", kToolName);
+  Printf("  %s gpu client-fan coolers set [--index N] --cooler N [--level PCT] [--enable 0|1] [--default]\n",
+         kToolName);
+  Printf("  %s gpu client-fan policies info [--index N]\n", kToolName);
+  Printf("  %s gpu client-fan policies status [--index N]\n", kToolName);
+  Printf("  %s gpu client-fan policies control [--index N]\n", kToolName);
+  Printf("  %s gpu client-fan policies set [--index N] --policy N --fan-stop 0|1 [--default]\n", kToolName);
+  Printf("  %s gpu client-fan arbiters info [--index N]\n", kToolName);
+  Printf("  %s gpu client-fan arbiters status [--index N]\n", kToolName);
+  Printf("  %s gpu client-fan arbiters control [--index N]\n", kToolName);
+  Printf("  %s gpu client-fan arbiters set [--index N] --arbiter N --fan-stop 0|1\n", kToolName);
+  Printf("  %s gpu client-illum devices info [--index N]\n", kToolName);
+  Printf("  %s gpu client-illum devices control [--index N]\n", kToolName);
+  Printf("  %s gpu client-illum devices set [--index N] --device N --sync 0|1 [--timestamp-ms N]\n", kToolName);
+  Printf("  %s gpu client-illum zones info [--index N]\n", kToolName);
+  Printf("  %s gpu client-illum zones control [--index N]\n", kToolName);
+  Printf(
       "  %s gpu client-illum zones set [--index N] --zone N --mode "
       "manual-rgb|manual-rgbw|manual-single|manual-color-fixed --brightness N [--r N --g N --b N --w N] [--default]\n",
       kToolName);
-  std::printf("\n");
+  Printf("\n");
 }
 
 void PrintUsageDisplay() {
-  std::printf("Display commands:\n");
-  std::printf("  %s display list\n", kToolName);
-  std::printf("  %s display ids [--index N] [--all] [--flags HEX]\n", kToolName);
-  std::printf("  %s display edid --id HEX [--flag default|raw|cooked|forced|inf|hw|tiles]\n", kToolName);
-  std::printf("  %s display timing --id HEX\n", kToolName);
-  std::printf("  %s display get [--handle-index N]\n", kToolName);
-  std::printf("  %s display set [--handle-index N] <srcId:device> [srcId:device ...]\n", kToolName);
-  std::printf("  %s display custom list --id HEX\n", kToolName);
-  std::printf("  %s display custom try --id HEX --width W --height H --refresh R [--depth BPP] [--type "
-              "auto|cvt|cvt-rb|gtf|dmt|dmt-rb|eia861|analog-tv|nv-predefined] [--interlaced 0|1] [--hw-only 0|1] "
-              "[--cea-id N] [--tv-format N] [--psf-id N]\n",
-              kToolName);
-  std::printf("  %s display custom save --id HEX [--output-only 0|1] [--monitor-only 0|1]\n", kToolName);
-  std::printf("  %s display custom delete --id HEX --index N\n", kToolName);
-  std::printf("  %s display custom revert --id HEX\n", kToolName);
-  std::printf("  %s display monitor-caps --id HEX [--type generic|hdmi-vsdb|hdmi-vcdb|all]\n", kToolName);
-  std::printf("  %s display monitor-color-caps --id HEX\n", kToolName);
-  std::printf("  %s display scaling --id HEX\n", kToolName);
-  std::printf("  %s display scaling-override get --id HEX\n", kToolName);
-  std::printf("  %s display scaling-override set --id HEX [--preferred MODE] [--force-override]\n", kToolName);
-  std::printf("  %s display viewport get --id HEX\n", kToolName);
-  std::printf("  %s display viewport set --id HEX [--x N] [--y N] [--w N] [--h N] [--lock 0|1] [--zoom PCT]\n",
-              kToolName);
-  std::printf("  %s display feature get --id HEX\n", kToolName);
-  std::printf("  %s display feature set --id HEX [--pan-scan 0|1] [--gdi-primary 0|1]\n", kToolName);
-  std::printf("  %s display wide-color get --id HEX [--range xvycc]\n", kToolName);
-  std::printf("  %s display wide-color set --id HEX --enable 0|1 [--range xvycc]\n", kToolName);
-  std::printf("  %s display bpc get --id HEX\n", kToolName);
-  std::printf("  %s display bpc set --id HEX [--bpc default|6|8|10|12|16] [--dither 0|1] [--force-link 0|1] "
-              "[--force-rg-div 0|1]\n",
-              kToolName);
-  std::printf("  %s display blanking get --id HEX\n", kToolName);
-  std::printf("  %s display blanking set --id HEX --state 0|1 [--persist 0|1]\n", kToolName);
-  std::printf("  %s display hdr caps --id HEX\n", kToolName);
-  std::printf("  %s display hdr session get --id HEX\n", kToolName);
-  std::printf("  %s display hdr session set --id HEX --enable 0|1 [--expire SEC]\n", kToolName);
-  std::printf("  %s display hdr color get --id HEX\n", kToolName);
-  std::printf("  %s display hdr color set --id HEX [--mode MODE] [--format FORMAT] [--range RANGE] [--bpc BPC] "
-              "[--os-hdr default|on|off]\n",
-              kToolName);
-  std::printf("  %s display id-by-name --name NAME\n", kToolName);
-  std::printf("  %s display gdi-primary\n", kToolName);
-  std::printf("  %s display handle-from-id --id HEX\n", kToolName);
-  std::printf("  %s display id-from-handle --handle-index N\n", kToolName);
-  std::printf("\n");
+  Printf("Display commands:\n");
+  Printf("  %s display list\n", kToolName);
+  Printf("  %s display ids [--index N] [--all] [--flags HEX]\n", kToolName);
+  Printf("  %s display edid --id HEX [--flag default|raw|cooked|forced|inf|hw|tiles] [--decode] [--cache DIR]\n",
+         kToolName);
+  Printf("  %s display edid --file PATH [--decode] [--cache DIR]\n", kToolName);
+  Printf("  %s display timing --id HEX\n", kToolName);
+  Printf("  %s display snapshot [--index N] [--all]\n", kToolName);
+  Printf("  %s display get [--handle-index N]\n", kToolName);
+  Printf("  %s display set [--handle-index N] <srcId:device> [srcId:device ...]\n", kToolName);
+  Printf("  %s display custom list --id HEX\n", kToolName);
+  Printf("  %s display custom try --id HEX --width W --height H --refresh R [--depth BPP] [--type "
+         "auto|cvt|cvt-rb|gtf|dmt|dmt-rb|eia861|analog-tv|nv-predefined] [--interlaced 0|1] [--hw-only 0|1] "
+         "[--cea-id N] [--tv-format N] [--psf-id N] [--formula cvt|cvt-rb|cvt-rb2|gtf]\n",
+         kToolName);
+  Printf("  %s display custom calc --width W --height H --refresh R [--type cvt|cvt-rb|cvt-rb2|gtf|all] "
+         "[--interlaced 0|1]\n",
+         kToolName);
+  Printf("  %s display custom validate [--id HEX|--edid PATH] (--mode WxH@R[-R2:STEP] ...|--modes PATH) "
+         "[--type cvt|cvt-rb|cvt-rb2|gtf] [--interlaced 0|1] [--bpc N] [--max-pclk MHZ] "
+         "[--link dp:LANES:GBPS|frl:LANES:GBPS|tmds:MHZ]\n",
+         kToolName);
+  Printf("  %s display custom sweep --id HEX (--mode WxH@R[-R2:STEP] ...|--modes PATH) [--formula "
+         "cvt|cvt-rb|cvt-rb2|gtf] [--interlaced 0|1] [--depth BPP] [--settle MS] [--timeout MS] [--journal PATH "
+         "[--resume]]\n",
+         kToolName);
+  Printf("  %s display custom sweep --journal PATH\n", kToolName);
+  Printf("  %s display custom save --id HEX [--output-only 0|1] [--monitor-only 0|1]\n", kToolName);
+  Printf("  %s display custom delete --id HEX --index N\n", kToolName);
+  Printf("  %s display custom revert --id HEX\n", kToolName);
+  Printf("  %s display monitor-caps --id HEX [--type generic|hdmi-vsdb|hdmi-vcdb|all]\n", kToolName);
+  Printf("  %s display monitor-color-caps --id HEX\n", kToolName);
+  Printf("  %s display scaling --id HEX\n", kToolName);
+  Printf("  %s display scaling-override get --id HEX\n", kToolName);
+  Printf("  %s display scaling-override set --id HEX [--preferred MODE] [--force-override]\n", kToolName);
+  Printf("  %s display viewport get --id HEX\n", kToolName);
+  Printf("  %s display viewport set --id HEX [--x N] [--y N] [--w N] [--h N] [--lock 0|1] [--zoom PCT]\n", kToolName);
+  Printf("  %s display feature get --id HEX\n", kToolName);
+  Printf("  %s display feature set --id HEX [--pan-scan 0|1] [--gdi-primary 0|1]\n", kToolName);
+  Printf("  %s display wide-color get --id HEX [--range xvycc]\n", kToolName);
+  Printf("  %s display wide-color set --id HEX --enable 0|1 [--range xvycc]\n", kToolName);
+  Printf("  %s display bpc get --id HEX\n", kToolName);
+  Printf("  %s display bpc set --id HEX [--bpc default|6|8|10|12|16] [--dither 0|1] [--force-link 0|1] "
+         "[--force-rg-div 0|1]\n",
+         kToolName);
+  Printf("  %s display blanking get --id HEX\n", kToolName);
+  Printf("  %s display blanking set --id HEX --state 0|1 [--persist 0|1]\n", kToolName);
+  Printf("  %s display hdr caps --id HEX\n", kToolName);
+  Printf("  %s display hdr session get --id HEX\n", kToolName);
+  Printf("  %s display hdr session set --id HEX --enable 0|1 [--expire SEC]\n", kToolName);
+  Printf("  %s display hdr color get --id HEX\n", kToolName);
+  Printf("  %s display hdr color set --id HEX [--mode MODE] [--format FORMAT] [--range RANGE] [--bpc BPC] "
+         "[--os-hdr default|on|off]\n",
+         kToolName);
+  Printf("  %s display id-by-name --name NAME\n", kToolName);
+  Printf("  %s display gdi-primary\n", kToolName);
+  Printf("  %s display handle-from-id --id HEX\n", kToolName);
+  Printf("  %s display id-from-handle --handle-index N\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageMosaic() {
-  std::printf("Mosaic commands:\n");
-  std::printf("  %s mosaic caps [--index N]\n", kToolName);
-  std::printf(
+  Printf("Mosaic commands:\n");
+  Printf("  %s mosaic caps [--index N]\n", kToolName);
+  Printf(
       "  %s mosaic supported [--type all|basic|passive-stereo|scaled-clone|passive-stereo-scaled-clone] [--limit N]\n",
       kToolName);
-  std::printf("  %s mosaic current\n", kToolName);
-  std::printf("  %s mosaic enable --state 0|1\n", kToolName);
-  std::printf("  %s mosaic display-caps [--limit N]\n", kToolName);
-  std::printf("\n");
+  Printf("  %s mosaic current\n", kToolName);
+  Printf("  %s mosaic enable --state 0|1\n", kToolName);
+  Printf("  %s mosaic display-caps [--limit N]\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageSli() {
-  std::printf("SLI commands:\n");
-  std::printf("  %s sli status\n", kToolName);
-  std::printf("  %s sli views [--index N]\n", kToolName);
-  std::printf("\n");
+  Printf("SLI commands:\n");
+  Printf("  %s sli status\n", kToolName);
+  Printf("  %s sli views [--index N]\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageGsync() {
-  std::printf("G-Sync commands:\n");
-  std::printf("  %s gsync list\n", kToolName);
-  std::printf("  %s gsync caps --index N\n", kToolName);
-  std::printf("  %s gsync topo --index N\n", kToolName);
-  std::printf("  %s gsync sync get --index N\n", kToolName);
-  std::printf("  %s gsync sync set --index N --display-id HEX --state master|slave|unsynced [--no-validate] "
-              "[--send-start-event]\n",
-              kToolName);
-  std::printf("  %s gsync sync enable --index N --display-id HEX --state master|slave\n", kToolName);
-  std::printf("  %s gsync sync disable --index N --display-id HEX\n", kToolName);
-  std::printf("  %s gsync status --index N [--gpu-index N]\n", kToolName);
-  std::printf("  %s gsync control get --index N\n", kToolName);
-  std::printf(
+  Printf("G-Sync commands:\n");
+  Printf("  %s gsync list\n", kToolName);
+  Printf("  %s gsync caps --index N\n", kToolName);
+  Printf("  %s gsync topo --index N\n", kToolName);
+  Printf("  %s gsync sync get --index N\n", kToolName);
+  Printf("  %s gsync sync set --index N --display-id HEX --state master|slave|unsynced [--no-validate] "
+         "[--send-start-event]\n",
+         kToolName);
+  Printf("  %s gsync sync enable --index N --display-id HEX --state master|slave\n", kToolName);
+  Printf("  %s gsync sync disable --index N --display-id HEX\n", kToolName);
+  Printf("  %s gsync status --index N [--gpu-index N]\n", kToolName);
+  Printf("  %s gsync control get --index N\n", kToolName);
+  Printf(
       "  %s gsync control set --index N [--polarity rising|falling|both] [--video-mode none|ttl|ntsc|hdtv|composite] "
       "[--interval N] [--source vsync|housesync] [--interlace 0|1] [--sync-source-output 0|1]\n",
       kToolName);
-  std::printf("\n");
+  Printf("\n");
 }
 
 void PrintUsageDrs() {
-  std::printf("DRS commands:\n");
-  std::printf("  %s drs profiles\n", kToolName);
-  std::printf("  %s drs apps --profile NAME\n", kToolName);
-  std::printf("  %s drs settings --profile NAME [--start N] [--limit N]\n", kToolName);
-  std::printf("  %s drs setting get --profile NAME (--id ID|--name NAME)\n", kToolName);
-  std::printf("  %s drs setting set --profile NAME (--id ID|--name NAME) --dword VALUE\n", kToolName);
-  std::printf("  %s drs profile create --name NAME\n", kToolName);
-  std::printf("  %s drs profile delete --name NAME\n", kToolName);
-  std::printf("\n");
+  Printf("DRS commands:\n");
+  Printf("  %s drs profiles\n", kToolName);
+  Printf("  %s drs apps --profile NAME\n", kToolName);
+  Printf("  %s drs settings --profile NAME [--start N] [--limit N]\n", kToolName);
+  Printf("  %s drs setting get --profile NAME (--id ID|--name NAME)\n", kToolName);
+  Printf("  %s drs setting set --profile NAME (--id ID|--name NAME) --dword VALUE\n", kToolName);
+  Printf("  %s drs profile create --name NAME\n", kToolName);
+  Printf("  %s drs profile delete --name NAME\n", kToolName);
+  Printf("  %s drs apply FILE [--dry-run] [--prune]\n", kToolName);
+  Printf("  %s drs export --out FILE\n", kToolName);
+  Printf("  %s drs import FILE [--dry-run] [--prune]\n", kToolName);
+  Printf("  %s drs query [--where EXPR] [--apps-glob PATTERN] [--image FILE]\n", kToolName);
+  Printf("  %s drs diff A B\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageVideo() {
-  std::printf("Video commands:\n");
-  std::printf("  %s video color get [--handle-index N]\n", kToolName);
-  std::printf("  %s video color default [--handle-index N]\n", kToolName);
-  std::printf("  %s video color set [--handle-index N] [--brightness N] [--contrast N] [--hue N] [--saturation N] "
-              "[--color-temp N] [--ygamma N] [--rgamma N] [--ggamma N] [--bgamma N] [--override|--use-app]\n",
-              kToolName);
-  std::printf("\n");
+  Printf("Video commands:\n");
+  Printf("  %s video color get [--handle-index N]\n", kToolName);
+  Printf("  %s video color default [--handle-index N]\n", kToolName);
+  Printf("  %s video color set [--handle-index N] [--brightness N] [--contrast N] [--hue N] [--saturation N] "
+         "[--color-temp N] [--ygamma N] [--rgamma N] [--ggamma N] [--bgamma N] [--override|--use-app]\n",
+         kToolName);
+  Printf("\n");
 }
 
 void PrintUsageHdmi() {
-  std::printf("HDMI commands:\n");
-  std::printf("  %s hdmi support [--handle-index N] [--output-id HEX]\n", kToolName);
-  std::printf("  %s hdmi hdcp-diag --index N --id HEX\n", kToolName);
-  std::printf(
+  Printf("HDMI commands:\n");
+  Printf("  %s hdmi support [--handle-index N] [--output-id HEX]\n", kToolName);
+  Printf("  %s hdmi hdcp-diag --index N --id HEX\n", kToolName);
+  Printf(
       "  %s hdmi stereo modes --id HEX [--start N] [--count N] [--pass-through] [--width W --height H --refresh R]\n",
       kToolName);
-  std::printf("  %s hdmi stereo get --id HEX\n", kToolName);
-  std::printf("  %s hdmi stereo set --id HEX --type NAME|HEX\n", kToolName);
-  std::printf("  %s hdmi audio-mute --handle-index N --state 0|1 [--output-id HEX]\n", kToolName);
-  std::printf("\n");
+  Printf("  %s hdmi stereo get --id HEX\n", kToolName);
+  Printf("  %s hdmi stereo set --id HEX --type NAME|HEX\n", kToolName);
+  Printf("  %s hdmi audio-mute --handle-index N --state 0|1 [--output-id HEX]\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageDp() {
-  std::printf("DisplayPort commands:\n");
-  std::printf("  %s dp info [--id HEX] [--handle-index N] [--output-id HEX]\n", kToolName);
-  std::printf("  %s dp set [--id HEX] [--handle-index N] [--output-id HEX] [--link-rate RATE] [--lane-count N] "
-              "[--format FORMAT] [--range RANGE] [--colorimetry MODE] [--bpc BPC] [--hpd 0|1] [--defer 0|1] "
-              "[--chroma-lpf-off 0|1] [--dither-off 0|1] [--test-link-train 0|1] [--test-color-change 0|1]\n",
-              kToolName);
-  std::printf("  %s dp dongle [--index N] --output-id HEX\n", kToolName);
-  std::printf("  %s dp topology --id HEX\n", kToolName);
-  std::printf("\n");
+  Printf("DisplayPort commands:\n");
+  Printf("  %s dp info [--id HEX] [--handle-index N] [--output-id HEX]\n", kToolName);
+  Printf("  %s dp set [--id HEX] [--handle-index N] [--output-id HEX] [--link-rate RATE] [--lane-count N] "
+         "[--format FORMAT] [--range RANGE] [--colorimetry MODE] [--bpc BPC] [--hpd 0|1] [--defer 0|1] "
+         "[--chroma-lpf-off 0|1] [--dither-off 0|1] [--test-link-train 0|1] [--test-color-change 0|1]\n",
+         kToolName);
+  Printf("  %s dp dongle [--index N] --output-id HEX\n", kToolName);
+  Printf("  %s dp topology --id HEX\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsagePcf() {
-  std::printf("PCF commands:\n");
-  std::printf("  %s pcf master info\n", kToolName);
-  std::printf("  %s pcf master control\n", kToolName);
-  std::printf("  %s pcf master status\n", kToolName);
-  std::printf("  %s pcf master set --index N --bus-high N --bus-nominal N\n", kToolName);
-  std::printf("\n");
+  Printf("PCF commands:\n");
+  Printf("  %s pcf master info\n", kToolName);
+  Printf("  %s pcf master control\n", kToolName);
+  Printf("  %s pcf master status\n", kToolName);
+  Printf("  %s pcf master set --index N --bus-high N --bus-nominal N\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageSys() {
-  std::printf("SYS commands:\n");
-  std::printf("  %s sys gpu-count\n", kToolName);
-  std::printf("  %s sys smp [--default]\n", kToolName);
-  std::printf("  %s sys chipset-sli\n", kToolName);
-  std::printf("\n");
+  Printf("SYS commands:\n");
+  Printf("  %s sys gpu-count\n", kToolName);
+  Printf("  %s sys smp [--default]\n", kToolName);
+  Printf("  %s sys chipset-sli\n", kToolName);
+  Printf("\n");
+}
+
+void PrintUsageBench() {
+  Printf("BENCH commands:\n");
+  Printf("  %s bench api [--index N] [--iterations N] [--warmup N] [--group clock|power|thermal]\n", kToolName);
+  Printf("     [--api NAME] [--out PATH] [--append]\n");
+  Printf("\n");
+}
+
+void PrintUsageLog() {
+  Printf("LOG commands:\n");
+  Printf("  %s log info FILE\n", kToolName);
+  Printf("  %s log read FILE [--from S] [--to S] [--metric NAME[,NAME...]]\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageD3d() {
-  std::printf("D3D toolchain commands:\n");
-  std::printf("  %s d3d vrr get [--swapchain] [--surface HANDLE] [--present] [--debug]\n", kToolName);
-  std::printf("  %s d3d vrr set --state on|off [--swapchain] [--surface HANDLE] [--present] [--debug]\n", kToolName);
-  std::printf("  %s d3d latency get [--out PATH] [--raw]\n", kToolName);
-  std::printf("  %s d3d latency mark --frame ID --type TYPE\n", kToolName);
-  std::printf("  %s d3d ansel set [--modifier none|ctrl|shift|alt] [--enable-key VK] [--feature NAME:STATE[:VK]]\n",
-              kToolName);
-  std::printf("\n");
+  Printf("D3D toolchain commands:\n");
+  Printf("  %s d3d vrr get [--swapchain] [--surface HANDLE] [--present] [--debug]\n", kToolName);
+  Printf("  %s d3d vrr set --state on|off [--swapchain] [--surface HANDLE] [--present] [--debug]\n", kToolName);
+  Printf("  %s d3d latency get [--out PATH] [--raw]\n", kToolName);
+  Printf("  %s d3d latency mark --frame ID --type TYPE\n", kToolName);
+  Printf("  %s d3d ansel set [--modifier none|ctrl|shift|alt] [--enable-key VK] [--feature NAME:STATE[:VK]]\n",
+         kToolName);
+  Printf("\n");
 }
 
 void PrintUsageOgl() {
-  std::printf("OpenGL commands:\n");
-  std::printf("  %s ogl expert get\n", kToolName);
-  std::printf("  %s ogl expert set --detail MASK --report MASK --output MASK\n", kToolName);
-  std::printf("  %s ogl expert defaults-get\n", kToolName);
-  std::printf("  %s ogl expert defaults-set --detail MASK --report MASK --output MASK\n", kToolName);
-  std::printf("\n");
+  Printf("OpenGL commands:\n");
+  Printf("  %s ogl expert get\n", kToolName);
+  Printf("  %s ogl expert set --detail MASK --report MASK --output MASK\n", kToolName);
+  Printf("  %s ogl expert defaults-get\n", kToolName);
+  Printf("  %s ogl expert defaults-set --detail MASK --report MASK --output MASK\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageVr() {
-  std::printf("VR commands:\n");
-  std::printf("  %s vr direct-mode enable --vendor-id ID\n", kToolName);
-  std::printf("  %s vr direct-mode disable --vendor-id ID\n", kToolName);
-  std::printf("  %s vr direct-mode list --vendor-id ID [--flag capable|enabled]\n", kToolName);
-  std::printf("  %s vr direct-mode handle-from-id --display-id HEX\n", kToolName);
-  std::printf("  %s vr direct-mode id-from-handle --display-id HEX --context HEX\n", kToolName);
-  std::printf("\n");
+  Printf("VR commands:\n");
+  Printf("  %s vr direct-mode enable --vendor-id ID\n", kToolName);
+  Printf("  %s vr direct-mode disable --vendor-id ID\n", kToolName);
+  Printf("  %s vr direct-mode list --vendor-id ID [--flag capable|enabled]\n", kToolName);
+  Printf("  %s vr direct-mode handle-from-id --display-id HEX\n", kToolName);
+  Printf("  %s vr direct-mode id-from-handle --display-id HEX --context HEX\n", kToolName);
+  Printf("\n");
 }
 
 void PrintUsageStereo() {
-  std::printf("Stereo commands:\n");
-  std::printf("  %s stereo enable\n", kToolName);
-  std::printf("  %s stereo disable\n", kToolName);
-  std::printf("  %s stereo is-enabled\n", kToolName);
-  std::printf("  %s stereo windowed get\n", kToolName);
-  std::printf("  %s stereo windowed set --mode off|auto|persistent [--flags N]\n", kToolName);
-  std::printf("  %s stereo windowed supported\n", kToolName);
-  std::printf("  %s stereo caps get|internal\n", kToolName);
-  std::printf("  %s stereo caps monitor --monitor-index N | --id HEX\n", kToolName);
-  std::printf("  %s stereo info [--handle-index N]\n", kToolName);
-  std::printf("  %s stereo app-info [--handle-index N]\n", kToolName);
-  std::printf("  %s stereo mode-enum get\n", kToolName);
-  std::printf("  %s stereo mode-enum set --command enable|disable [--data N]\n", kToolName);
-  std::printf("  %s stereo accessory\n", kToolName);
-  std::printf("  %s stereo dongle control --command NAME [--data N] [--handle-index N]\n", kToolName);
-  std::printf("  %s stereo dongle status --id HEX --param N\n", kToolName);
-  std::printf("  %s stereo aegis --panel-id N\n", kToolName);
-  std::printf("  %s stereo default-profile get\n", kToolName);
-  std::printf("  %s stereo default-profile set --name NAME\n", kToolName);
-  std::printf("  %s stereo profile create|delete --type default|dx9|dx10\n", kToolName);
-  std::printf("  %s stereo profile set --type TYPE --id convergence|frustum (--dword N|--float F)\n", kToolName);
-  std::printf("  %s stereo profile delete-value --type TYPE --id convergence|frustum\n", kToolName);
-  std::printf("  %s stereo driver-mode set --mode automatic|direct\n", kToolName);
-  std::printf("  %s stereo activate|deactivate|is-activated\n", kToolName);
-  std::printf("  %s stereo separation get|set|inc|dec [--value PCT]\n", kToolName);
-  std::printf("  %s stereo convergence get|set|inc|dec [--value F]\n", kToolName);
-  std::printf("  %s stereo frustum get|set --mode none|stretch|clear-edges\n", kToolName);
-  std::printf("  %s stereo capture jpeg --quality 0-100\n", kToolName);
-  std::printf("  %s stereo capture png\n", kToolName);
-  std::printf("  %s stereo init-activation --flag immediate|delayed\n", kToolName);
-  std::printf("  %s stereo trigger-activation\n", kToolName);
-  std::printf("  %s stereo reverse-blit --enable 0|1\n", kToolName);
-  std::printf("  %s stereo notify --hwnd HEX --message-id N\n", kToolName);
-  std::printf("  %s stereo active-eye set --eye left|right|mono\n", kToolName);
-  std::printf("  %s stereo eye-separation get\n", kToolName);
-  std::printf("  %s stereo cursor supported|get|set [--value PCT]\n", kToolName);
-  std::printf("  %s stereo surface get|set --mode auto|force-stereo|force-mono\n", kToolName);
-  std::printf("  %s stereo debug last-draw\n", kToolName);
-  std::printf("  %s stereo force-to-screen --enable 0|1\n", kToolName);
-  std::printf("  %s stereo video-control --layout NAME --client-id N --enable 0|1\n", kToolName);
-  std::printf("  %s stereo video-metadata --width W --height H --src HEX --dst HEX\n", kToolName);
-  std::printf("  %s stereo handshake challenge\n", kToolName);
-  std::printf("  %s stereo handshake response --guid GUID --response-hex HEX\n", kToolName);
-  std::printf("  %s stereo handshake-trigger\n", kToolName);
-  std::printf("  %s stereo handshake-message --enable 0|1\n", kToolName);
-  std::printf("  %s stereo profile-name set --name NAME [--flags N]\n", kToolName);
-  std::printf("  %s stereo diag\n", kToolName);
-  std::printf(
-      "  %s stereo shader set --stage vs|ps --type f|i|b --start N --count N --mono PATH --left PATH --right PATH\n",
-      kToolName);
-  std::printf(
-      "  %s stereo shader get --stage vs|ps --type f|i|b --start N --count N --mono PATH --left PATH --right PATH\n",
-      kToolName);
-  std::printf("\n");
+  Printf("Stereo commands:\n");
+  Printf("  %s stereo enable\n", kToolName);
+  Printf("  %s stereo disable\n", kToolName);
+  Printf("  %s stereo is-enabled\n", kToolName);
+  Printf("  %s stereo windowed get\n", kToolName);
+  Printf("  %s stereo windowed set --mode off|auto|persistent [--flags N]\n", kToolName);
+  Printf("  %s stereo windowed supported\n", kToolName);
+  Printf("  %s stereo caps get|internal\n", kToolName);
+  Printf("  %s stereo caps monitor --monitor-index N | --id HEX\n", kToolName);
+  Printf("  %s stereo info [--handle-index N]\n", kToolName);
+  Printf("  %s stereo app-info [--handle-index N]\n", kToolName);
+  Printf("  %s stereo mode-enum get\n", kToolName);
+  Printf("  %s stereo mode-enum set --command enable|disable [--data N]\n", kToolName);
+  Printf("  %s stereo accessory\n", kToolName);
+  Printf("  %s stereo dongle control --command NAME [--data N] [--handle-index N]\n", kToolName);
+  Printf("  %s stereo dongle status --id HEX --param N\n", kToolName);
+  Printf("  %s stereo aegis --panel-id N\n", kToolName);
+  Printf("  %s stereo default-profile get\n", kToolName);
+  Printf("  %s stereo default-profile set --name NAME\n", kToolName);
+  Printf("  %s stereo profile create|delete --type default|dx9|dx10\n", kToolName);
+  Printf("  %s stereo profile set --type TYPE --id convergence|frustum (--dword N|--float F)\n", kToolName);
+  Printf("  %s stereo profile delete-value --type TYPE --id convergence|frustum\n", kToolName);
+  Printf("  %s stereo driver-mode set --mode automatic|direct\n", kToolName);
+  Printf("  %s stereo activate|deactivate|is-activated\n", kToolName);
+  Printf("  %s stereo separation get|set|inc|dec [--value PCT]\n", kToolName);
+  Printf("  %s stereo convergence get|set|inc|dec [--value F]\n", kToolName);
+  Printf("  %s stereo frustum get|set --mode none|stretch|clear-edges\n", kToolName);
+  Printf("  %s stereo capture jpeg --quality 0-100\n", kToolName);
+  Printf("  %s stereo capture png\n", kToolName);
+  Printf("  %s stereo init-activation --flag immediate|delayed\n", kToolName);
+  Printf("  %s stereo trigger-activation\n", kToolName);
+  Printf("  %s stereo reverse-blit --enable 0|1\n", kToolName);
+  Printf("  %s stereo notify --hwnd HEX --message-id N\n", kToolName);
+  Printf("  %s stereo active-eye set --eye left|right|mono\n", kToolName);
+  Printf("  %s stereo eye-separation get\n", kToolName);
+  Printf("  %s stereo cursor supported|get|set [--value PCT]\n", kToolName);
+  Printf("  %s stereo surface get|set --mode auto|force-stereo|force-mono\n", kToolName);
+  Printf("  %s stereo debug last-draw\n", kToolName);
+  Printf("  %s stereo force-to-screen --enable 0|1\n", kToolName);
+  Printf("  %s stereo video-control --layout NAME --client-id N --enable 0|1\n", kToolName);
+  Printf("  %s stereo video-metadata --width W --height H --src HEX --dst HEX\n", kToolName);
+  Printf("  %s stereo handshake challenge\n", kToolName);
+  Printf("  %s stereo handshake response --guid GUID --response-hex HEX\n", kToolName);
+  Printf("  %s stereo handshake-trigger\n", kToolName);
+  Printf("  %s stereo handshake-message --enable 0|1\n", kToolName);
+  Printf("  %s stereo profile-name set --name NAME [--flags N]\n", kToolName);
+  Printf("  %s stereo diag\n", kToolName);
+  Printf("  %s stereo shader set --stage vs|ps --type f|i|b --start N --count N --mono PATH --left PATH --right PATH\n",
+         kToolName);
+  Printf("  %s stereo shader get --stage vs|ps --type f|i|b --start N --count N --mono PATH --left PATH --right PATH\n",
+         kToolName);
+  Printf("\n");
 }
 
 void PrintUsageAll() {
@@ -1209,6 +1360,8 @@ void PrintUsageAll() {
   PrintUsageOgl();
   PrintUsageVr();
   PrintUsageStereo();
+  PrintUsageBench();
+  PrintUsageLog();
 }
 } // namespace
 
@@ -1287,8 +1440,16 @@ void PrintUsageGroup(const char *group) {
     PrintUsageStereo();
     return;
   }
+  if (key == "bench") {
+    PrintUsageBench();
+    return;
+  }
+  if (key == "log") {
+    PrintUsageLog();
+    return;
+  }
 
-  std::printf("Unknown help group: %s\n", group);
+  Printf("Unknown help group: %s\n", group);
   PrintUsageSummary();
 }
 
@@ -1312,41 +1473,73 @@ void InitDrsSetting(NVDRS_SETTING *setting) {
   setting->binaryCurrentValue.valueLength = NVAPI_BINARY_DATA_MAX;
 }
 
+// Names and values are converted into stack buffers, listing a profile does not allocate per setting.
 void PrintDrsSetting(const NVDRS_SETTING &setting) {
-  std::string name = NvUnicodeToUtf8(setting.settingName);
-  std::printf("  0x%08X %s (%s) ", setting.settingId, name.empty() ? "<unnamed>" : name.c_str(),
-              DrsSettingTypeName(setting.settingType));
+  char name[kNvUnicodeUtf8Max];
+  NvUnicodeToUtf8(setting.settingName, name);
+  if (StructuredOutput()) {
+    RecordWriter record("drs_setting");
+    record.Hex("id", setting.settingId)
+        .Field("name", name)
+        .Field("setting_type", DrsSettingTypeName(setting.settingType));
+    switch (setting.settingType) {
+    case NVDRS_DWORD_TYPE: record.Field("value", setting.u32CurrentValue); break;
+    case NVDRS_STRING_TYPE:
+    case NVDRS_WSTRING_TYPE: {
+      char value[kNvUnicodeUtf8Max];
+      record.Field("value", NvUnicodeToUtf8(setting.wszCurrentValue, value));
+      break;
+    }
+    case NVDRS_BINARY_TYPE: {
+      // Bounded so the hex dump always fits one record, value_length still carries the full size.
+      const NvU32 maxDump = 1024;
+      const NvU32 length = setting.binaryCurrentValue.valueLength;
+      const NvU32 dumpCount = std::min<NvU32>(length, maxDump);
+      char hex[maxDump * 2 + 1];
+      for (NvU32 i = 0; i < dumpCount; ++i) {
+        std::snprintf(&hex[i * 2], 3, "%02X", setting.binaryCurrentValue.valueData[i]);
+      }
+      hex[dumpCount * 2] = '\0';
+      record.Field("value_length", length).Field("value", hex);
+      break;
+    }
+    default: record.Null("value"); break;
+    }
+    return;
+  }
+
+  Printf("  0x%08X %s (%s) ", setting.settingId, name[0] ? name : "<unnamed>", DrsSettingTypeName(setting.settingType));
 
   switch (setting.settingType) {
-  case NVDRS_DWORD_TYPE: std::printf("value=0x%08X (%u)", setting.u32CurrentValue, setting.u32CurrentValue); break;
+  case NVDRS_DWORD_TYPE: Printf("value=0x%08X (%u)", setting.u32CurrentValue, setting.u32CurrentValue); break;
   case NVDRS_STRING_TYPE:
   case NVDRS_WSTRING_TYPE: {
-    std::string value = NvUnicodeToUtf8(setting.wszCurrentValue);
-    std::printf("value=\"%s\"", value.c_str());
+    char value[kNvUnicodeUtf8Max];
+    Printf("value=\"%s\"", NvUnicodeToUtf8(setting.wszCurrentValue, value));
     break;
   }
   case NVDRS_BINARY_TYPE: {
     const NvU32 length = setting.binaryCurrentValue.valueLength;
-    std::printf("valueLen=%u data=", length);
+    Printf("valueLen=%u data=", length);
     const NvU32 maxDump = 32;
     NvU32 dumpCount = length < maxDump ? length : maxDump;
-    for (NvU32 i = 0; i < dumpCount; ++i) { std::printf("%02X", setting.binaryCurrentValue.valueData[i]); }
-    if (length > maxDump) { std::printf("..."); }
+    for (NvU32 i = 0; i < dumpCount; ++i) { Printf("%02X", setting.binaryCurrentValue.valueData[i]); }
+    if (length > maxDump) { Printf("..."); }
     break;
   }
-  default: std::printf("value=<unsupported>"); break;
+  default: Printf("value=<unsupported>"); break;
   }
-  std::printf("\n");
+  Printf("\n");
 }
 
 bool GetDrsProfileByName(NvDRSSessionHandle session, const char *name, NvDRSProfileHandle *outProfile) {
   if (!name || !outProfile) { return false; }
   NvAPI_UnicodeString wideName = {};
   if (!Utf8ToNvUnicode(name, wideName)) {
-    std::printf("Invalid profile name encoding.\n");
+    Printf("Invalid profile name encoding.\n");
     return false;
   }
-  NvAPI_Status status = NvAPI_DRS_FindProfileByName(session, wideName, outProfile);
+  NvAPI_Status status = NvApi().NvAPI_DRS_FindProfileByName(session, wideName, outProfile);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DRS_FindProfileByName failed", status);
     return false;
@@ -1354,18 +1547,46 @@ bool GetDrsProfileByName(NvDRSSessionHandle session, const char *name, NvDRSProf
   return true;
 }
 
+namespace {
+bool g_nvapiDeferred = false;
+std::atomic<bool> g_nvapiKeptLoaded{false};
+} // namespace
+
+void KeepNvApiLoaded() { g_nvapiKeptLoaded = true; }
+
+bool NvApiKeptLoaded() { return g_nvapiKeptLoaded; }
+
+void DeferNvApi() { g_nvapiDeferred = true; }
+
+bool RequireNvApi() {
+  if (!g_nvapiDeferred) { return true; }
+  // Unloaded at exit like the session main would have held.
+  static NvApiSession session;
+  if (!session.ok()) { PrintNvapiError("NvAPI_InitializeEx failed", session.status()); }
+  return session.ok();
+}
+
 bool GetDrsSettingIdByName(const char *name, NvU32 *outId) {
   if (!name || !outId) { return false; }
+  if (!RequireNvApi()) { return false; }
   NvAPI_UnicodeString wideName = {};
   if (!Utf8ToNvUnicode(name, wideName)) {
-    std::printf("Invalid setting name encoding.\n");
+    Printf("Invalid setting name encoding.\n");
     return false;
   }
-  NvAPI_Status status = NvAPI_DRS_GetSettingIdFromName(wideName, outId);
+  NvAPI_Status status = NvApi().NvAPI_DRS_GetSettingIdFromName(wideName, outId);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DRS_GetSettingIdFromName failed", status);
     return false;
   }
   return true;
 }
+
+namespace {
+NvDRSSessionHandle g_residentDrsSession = NULL;
+} // namespace
+
+NvDRSSessionHandle ResidentDrsSession() { return g_residentDrsSession; }
+
+void SetResidentDrsSession(NvDRSSessionHandle handle) { g_residentDrsSession = handle; }
 } // namespace nvcli
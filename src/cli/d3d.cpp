@@ -62,7 +62,7 @@ struct D3DContext {
 };
 
 void PrintHresult(const char *prefix, HRESULT hr) {
-  std::printf("%s: 0x%08X\n", prefix, static_cast<unsigned int>(hr));
+  Printf("%s: 0x%08X\n", prefix, static_cast<unsigned int>(hr));
 }
 
 HWND CreateHiddenWindow() {
@@ -112,7 +112,7 @@ bool CreateD3D11Device(D3DContext &ctx) {
   factory->Release();
 
   if (!adapter) {
-    std::printf("No NVIDIA adapter found for D3D device creation.\n");
+    Printf("No NVIDIA adapter found for D3D device creation.\n");
     return false;
   }
 
@@ -161,7 +161,7 @@ bool CreateSwapChain(D3DContext &ctx, DebugLog *debugLog) {
 
   ctx.window = CreateHiddenWindow();
   if (!ctx.window) {
-    std::printf("Failed to create hidden window.\n");
+    Printf("Failed to create hidden window.\n");
     Log("Failed to create hidden window.");
     return false;
   }
@@ -187,7 +187,7 @@ bool CreateSwapChain(D3DContext &ctx, DebugLog *debugLog) {
     __try {
       hr = factory2->CreateSwapChainForHwnd(ctx.device, ctx.window, &desc1, nullptr, nullptr, &swapChain1);
     } __except (EXCEPTION_EXECUTE_HANDLER) {
-      std::printf("CreateSwapChainForHwnd raised exception 0x%08X\n", GetExceptionCode());
+      Printf("CreateSwapChainForHwnd raised exception 0x%08X\n", GetExceptionCode());
       char msg[96] = {};
       std::snprintf(msg, sizeof(msg), "CreateSwapChainForHwnd exception 0x%08X", GetExceptionCode());
       Log(msg);
@@ -218,7 +218,7 @@ bool CreateSwapChain(D3DContext &ctx, DebugLog *debugLog) {
     __try {
       hr = factory->CreateSwapChain(ctx.device, &desc, &ctx.swapChain);
     } __except (EXCEPTION_EXECUTE_HANDLER) {
-      std::printf("CreateSwapChain raised exception 0x%08X\n", GetExceptionCode());
+      Printf("CreateSwapChain raised exception 0x%08X\n", GetExceptionCode());
       char msg[80] = {};
       std::snprintf(msg, sizeof(msg), "CreateSwapChain exception 0x%08X", GetExceptionCode());
       Log(msg);
@@ -236,7 +236,7 @@ bool CreateSwapChain(D3DContext &ctx, DebugLog *debugLog) {
   __try {
     hr = ctx.swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), reinterpret_cast<void **>(&ctx.backBuffer));
   } __except (EXCEPTION_EXECUTE_HANDLER) {
-    std::printf("GetBuffer raised exception 0x%08X\n", GetExceptionCode());
+    Printf("GetBuffer raised exception 0x%08X\n", GetExceptionCode());
     char msg[72] = {};
     std::snprintf(msg, sizeof(msg), "GetBuffer exception 0x%08X", GetExceptionCode());
     Log(msg);
@@ -252,7 +252,7 @@ bool CreateSwapChain(D3DContext &ctx, DebugLog *debugLog) {
   __try {
     status = NvAPI_D3D_GetObjectHandleForResource(ctx.device, ctx.backBuffer, &ctx.surfaceHandle);
   } __except (EXCEPTION_EXECUTE_HANDLER) {
-    std::printf("NvAPI_D3D_GetObjectHandleForResource raised exception 0x%08X\n", GetExceptionCode());
+    Printf("NvAPI_D3D_GetObjectHandleForResource raised exception 0x%08X\n", GetExceptionCode());
     return false;
   }
   if (status != NVAPI_OK) {
@@ -392,9 +392,9 @@ bool ParseAnselFeatureSpec(const char *text, NVAPI_ANSEL_FEATURE_CONFIGURATION_S
 void DumpHex(const void *data, size_t size) {
   const unsigned char *bytes = static_cast<const unsigned char *>(data);
   for (size_t i = 0; i < size; ++i) {
-    if (i % 16 == 0) { std::printf("    "); }
-    std::printf("%02X ", bytes[i]);
-    if (i % 16 == 15 || i + 1 == size) { std::printf("\n"); }
+    if (i % 16 == 0) { Printf("    "); }
+    Printf("%02X ", bytes[i]);
+    if (i % 16 == 15 || i + 1 == size) { Printf("\n"); }
   }
 }
 
@@ -402,13 +402,13 @@ bool WriteBinaryFile(const char *path, const void *data, size_t size) {
   if (!path || !data || size == 0) { return false; }
   FILE *file = nullptr;
   if (fopen_s(&file, path, "wb") != 0 || !file) {
-    std::printf("Failed to open output file: %s\n", path);
+    Printf("Failed to open output file: %s\n", path);
     return false;
   }
   size_t written = std::fwrite(data, 1, size, file);
   std::fclose(file);
   if (written != size) {
-    std::printf("Failed to write output file: %s\n", path);
+    Printf("Failed to write output file: %s\n", path);
     return false;
   }
   return true;
@@ -421,7 +421,7 @@ bool SafeD3DSetVRRState(IUnknown *deviceOrContext, NVDX_ObjectHandle surfaceHand
   __try {
     status = NvAPI_D3D_SetVRRState(deviceOrContext, surfaceHandle, enable);
   } __except (EXCEPTION_EXECUTE_HANDLER) {
-    std::printf("NvAPI_D3D_SetVRRState raised exception 0x%08X\n", GetExceptionCode());
+    Printf("NvAPI_D3D_SetVRRState raised exception 0x%08X\n", GetExceptionCode());
     *statusOut = NVAPI_ERROR;
     return false;
   }
@@ -436,7 +436,7 @@ bool SafeD3DGetVRRState(IUnknown *deviceOrContext, NVDX_ObjectHandle surfaceHand
   __try {
     status = NvAPI_D3D_GetVRRState(deviceOrContext, surfaceHandle, isEnabled, isRequested);
   } __except (EXCEPTION_EXECUTE_HANDLER) {
-    std::printf("NvAPI_D3D_GetVRRState raised exception 0x%08X\n", GetExceptionCode());
+    Printf("NvAPI_D3D_GetVRRState raised exception 0x%08X\n", GetExceptionCode());
     *statusOut = NVAPI_ERROR;
     return false;
   }
@@ -445,18 +445,18 @@ bool SafeD3DGetVRRState(IUnknown *deviceOrContext, NVDX_ObjectHandle surfaceHand
 }
 
 void PrintD3dUsage() {
-  std::printf("D3D toolchain commands:\n");
-  std::printf("  %s d3d vrr get [--swapchain] [--surface HANDLE] [--present] [--debug]\n", kToolName);
-  std::printf("  %s d3d vrr set --state on|off [--swapchain] [--surface HANDLE] [--present] [--debug]\n", kToolName);
-  std::printf("  %s d3d latency get [--out PATH] [--raw]\n", kToolName);
-  std::printf("  %s d3d latency mark --frame ID --type TYPE\n", kToolName);
-  std::printf("  %s d3d ansel set [--modifier none|ctrl|shift|alt] [--enable-key VK] [--feature NAME:STATE[:VK]]\n",
-              kToolName);
+  Printf("D3D toolchain commands:\n");
+  Printf("  %s d3d vrr get [--swapchain] [--surface HANDLE] [--present] [--debug]\n", kToolName);
+  Printf("  %s d3d vrr set --state on|off [--swapchain] [--surface HANDLE] [--present] [--debug]\n", kToolName);
+  Printf("  %s d3d latency get [--out PATH] [--raw]\n", kToolName);
+  Printf("  %s d3d latency mark --frame ID --type TYPE\n", kToolName);
+  Printf("  %s d3d ansel set [--modifier none|ctrl|shift|alt] [--enable-key VK] [--feature NAME:STATE[:VK]]\n",
+         kToolName);
 }
 
 int CmdD3dVrr(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing vrr command.\n");
+    Printf("Missing vrr command.\n");
     return 1;
   }
 
@@ -471,7 +471,7 @@ int CmdD3dVrr(int argc, char **argv) {
   DebugLog debugLog;
   auto DebugPrint = [&](const char *msg) {
     if (debug) {
-      std::printf("%s\n", msg);
+      Printf("%s\n", msg);
       debugLog.Log(msg);
     }
   };
@@ -481,7 +481,7 @@ int CmdD3dVrr(int argc, char **argv) {
   } else if (std::strcmp(argv[0], "set") == 0) {
     doSet = true;
   } else {
-    std::printf("Unknown vrr command: %s\n", argv[0]);
+    Printf("Unknown vrr command: %s\n", argv[0]);
     return 1;
   }
 
@@ -500,11 +500,11 @@ int CmdD3dVrr(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--surface") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --surface\n");
+        Printf("Missing value for --surface\n");
         return 1;
       }
       if (!ParseU64(argv[i + 1], &surfaceValue)) {
-        std::printf("Invalid surface handle: %s\n", argv[i + 1]);
+        Printf("Invalid surface handle: %s\n", argv[i + 1]);
         return 1;
       }
       hasSurface = true;
@@ -513,18 +513,18 @@ int CmdD3dVrr(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--state") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --state\n");
+        Printf("Missing value for --state\n");
         return 1;
       }
       if (!ParseBoolWord(argv[i + 1], &enable)) {
-        std::printf("Invalid state: %s\n", argv[i + 1]);
+        Printf("Invalid state: %s\n", argv[i + 1]);
         return 1;
       }
       hasState = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -533,12 +533,12 @@ int CmdD3dVrr(int argc, char **argv) {
   }
 
   if (doSet && !hasState) {
-    std::printf("Missing required --state on|off for vrr set.\n");
+    Printf("Missing required --state on|off for vrr set.\n");
     return 1;
   }
 
   if (!createSwapchain && !hasSurface) {
-    std::printf("Missing --swapchain or --surface HANDLE.\n");
+    Printf("Missing --swapchain or --surface HANDLE.\n");
     return 1;
   }
 
@@ -560,7 +560,7 @@ int CmdD3dVrr(int argc, char **argv) {
     DebugPrint("D3D VRR: swapchain created");
     surfaceHandle = ctx.surfaceHandle;
     if (!surfaceHandle) {
-      std::printf("Failed to obtain a valid surface handle.\n");
+      Printf("Failed to obtain a valid surface handle.\n");
       ctx.Cleanup();
       return 1;
     }
@@ -581,7 +581,7 @@ int CmdD3dVrr(int argc, char **argv) {
       return 1;
     }
     if (status == NVAPI_OK) {
-      std::printf("VRR state updated.\n");
+      Printf("VRR state updated.\n");
     } else {
       PrintNvapiError("NvAPI_D3D_SetVRRState failed", status);
     }
@@ -594,8 +594,8 @@ int CmdD3dVrr(int argc, char **argv) {
       return 1;
     }
     if (status == NVAPI_OK) {
-      std::printf("VRR enabled: %s\n", isEnabled ? "yes" : "no");
-      std::printf("VRR requested: %s\n", isRequested ? "yes" : "no");
+      Printf("VRR enabled: %s\n", isEnabled ? "yes" : "no");
+      Printf("VRR requested: %s\n", isRequested ? "yes" : "no");
     } else {
       PrintNvapiError("NvAPI_D3D_GetVRRState failed", status);
     }
@@ -607,7 +607,7 @@ int CmdD3dVrr(int argc, char **argv) {
 
 int CmdD3dLatency(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing latency command.\n");
+    Printf("Missing latency command.\n");
     return 1;
   }
 
@@ -618,7 +618,7 @@ int CmdD3dLatency(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--out") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --out\n");
+          Printf("Missing value for --out\n");
           return 1;
         }
         outPath = argv[i + 1];
@@ -629,7 +629,7 @@ int CmdD3dLatency(int argc, char **argv) {
         raw = true;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
 
@@ -658,11 +658,11 @@ int CmdD3dLatency(int argc, char **argv) {
 
     if (latestIndex >= 0) {
       const auto &report = params.frameReport[latestIndex];
-      std::printf("Latency frame: %llu\n", static_cast<unsigned long long>(report.frameID));
-      std::printf("  gpuActiveRenderTimeUs=%u\n", report.gpuActiveRenderTimeUs);
-      std::printf("  gpuFrameTimeUs=%u\n", report.gpuFrameTimeUs);
+      Printf("Latency frame: %llu\n", static_cast<unsigned long long>(report.frameID));
+      Printf("  gpuActiveRenderTimeUs=%u\n", report.gpuActiveRenderTimeUs);
+      Printf("  gpuFrameTimeUs=%u\n", report.gpuFrameTimeUs);
     } else {
-      std::printf("No latency frames recorded.\n");
+      Printf("No latency frames recorded.\n");
     }
 
     if (outPath) {
@@ -670,7 +670,7 @@ int CmdD3dLatency(int argc, char **argv) {
         ctx.Cleanup();
         return 1;
       }
-      std::printf("Wrote output: %s\n", outPath);
+      Printf("Wrote output: %s\n", outPath);
     }
 
     if (raw) { DumpHex(&params, sizeof(params)); }
@@ -688,11 +688,11 @@ int CmdD3dLatency(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--frame") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --frame\n");
+          Printf("Missing value for --frame\n");
           return 1;
         }
         if (!ParseU64(argv[i + 1], &frameId)) {
-          std::printf("Invalid frame id: %s\n", argv[i + 1]);
+          Printf("Invalid frame id: %s\n", argv[i + 1]);
           return 1;
         }
         hasFrame = true;
@@ -701,23 +701,23 @@ int CmdD3dLatency(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--type") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --type\n");
+          Printf("Missing value for --type\n");
           return 1;
         }
         if (!ParseLatencyMarkerType(argv[i + 1], &marker)) {
-          std::printf("Invalid marker type: %s\n", argv[i + 1]);
+          Printf("Invalid marker type: %s\n", argv[i + 1]);
           return 1;
         }
         hasType = true;
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
 
     if (!hasFrame || !hasType) {
-      std::printf("Missing required --frame and/or --type\n");
+      Printf("Missing required --frame and/or --type\n");
       return 1;
     }
 
@@ -739,23 +739,23 @@ int CmdD3dLatency(int argc, char **argv) {
       return 1;
     }
 
-    std::printf("Latency marker set.\n");
+    Printf("Latency marker set.\n");
     ctx.Cleanup();
     return 0;
   }
 
-  std::printf("Unknown latency command: %s\n", argv[0]);
+  Printf("Unknown latency command: %s\n", argv[0]);
   return 1;
 }
 
 int CmdD3dAnsel(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing ansel command.\n");
+    Printf("Missing ansel command.\n");
     return 1;
   }
 
   if (std::strcmp(argv[0], "set") != 0) {
-    std::printf("Unknown ansel command: %s\n", argv[0]);
+    Printf("Unknown ansel command: %s\n", argv[0]);
     return 1;
   }
 
@@ -767,11 +767,11 @@ int CmdD3dAnsel(int argc, char **argv) {
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "--modifier") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --modifier\n");
+        Printf("Missing value for --modifier\n");
         return 1;
       }
       if (!ParseAnselModifier(argv[i + 1], &modifier)) {
-        std::printf("Invalid modifier: %s\n", argv[i + 1]);
+        Printf("Invalid modifier: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
@@ -779,11 +779,11 @@ int CmdD3dAnsel(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--enable-key") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --enable-key\n");
+        Printf("Missing value for --enable-key\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &enableKey)) {
-        std::printf("Invalid enable key: %s\n", argv[i + 1]);
+        Printf("Invalid enable key: %s\n", argv[i + 1]);
         return 1;
       }
       hasEnableKey = true;
@@ -792,19 +792,19 @@ int CmdD3dAnsel(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--feature") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --feature\n");
+        Printf("Missing value for --feature\n");
         return 1;
       }
       NVAPI_ANSEL_FEATURE_CONFIGURATION_STRUCT feature = {};
       if (!ParseAnselFeatureSpec(argv[i + 1], &feature)) {
-        std::printf("Invalid feature spec: %s\n", argv[i + 1]);
+        Printf("Invalid feature spec: %s\n", argv[i + 1]);
         return 1;
       }
       features.push_back(feature);
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -828,7 +828,7 @@ int CmdD3dAnsel(int argc, char **argv) {
     return 1;
   }
 
-  std::printf("Ansel configuration updated.\n");
+  Printf("Ansel configuration updated.\n");
   ctx.Cleanup();
   return 0;
 }
@@ -4,18 +4,10 @@
  */
 
 #include "cli/commands.h"
+#include "cli/topology.h"
 
 namespace nvcli {
 namespace {
-bool ParseDoubleValue(const char *value, double *out) {
-  if (!value || !out) { return false; }
-  char *end = NULL;
-  double parsed = std::strtod(value, &end);
-  if (end == value || *end != '\0') { return false; }
-  *out = parsed;
-  return true;
-}
-
 const char *MonitorCapsTypeName(NV_MONITOR_CAPS_TYPE type) {
   switch (type) {
   case NV_MONITOR_CAPS_TYPE_HDMI_VSDB: return "HDMI_VSDB";
@@ -46,27 +38,6 @@ bool ParseMonitorCapsType(const char *value, NV_MONITOR_CAPS_TYPE *out) {
   return true;
 }
 
-const char *DpColorFormatName(NV_DP_COLOR_FORMAT format) {
-  switch (format) {
-  case NV_DP_COLOR_FORMAT_RGB: return "RGB";
-  case NV_DP_COLOR_FORMAT_YCbCr422: return "YCbCr422";
-  case NV_DP_COLOR_FORMAT_YCbCr444: return "YCbCr444";
-  default: return "UNKNOWN";
-  }
-}
-
-const char *DpBpcName(NV_DP_BPC bpc) {
-  switch (bpc) {
-  case NV_DP_BPC_DEFAULT: return "DEFAULT";
-  case NV_DP_BPC_6: return "6";
-  case NV_DP_BPC_8: return "8";
-  case NV_DP_BPC_10: return "10";
-  case NV_DP_BPC_12: return "12";
-  case NV_DP_BPC_16: return "16";
-  default: return "UNKNOWN";
-  }
-}
-
 const char *BpcName(NV_BPC bpc) {
   switch (bpc) {
   case NV_BPC_DEFAULT: return "default";
@@ -195,21 +166,20 @@ bool ParseWideColorRange(const char *value, NV_WIDE_COLOR_RANGE *out) {
 }
 
 void PrintScalingCapsV1(const NV_GET_SCALING_CAPS_V1 &caps) {
-  std::printf("Scaling caps (v1):\n");
-  std::printf("  gpuScaling=%u gpuAspect=%u monitorScaling=%u centerScaling=%u\n", caps.isGPUScalingAvailable ? 1 : 0,
-              caps.isGPUFixedAspectRatioScalingAvailable ? 1 : 0, caps.isMonitorScalingAvailable ? 1 : 0,
-              caps.isCenterScalingAvailable ? 1 : 0);
+  Printf("Scaling caps (v1):\n");
+  Printf("  gpuScaling=%u gpuAspect=%u monitorScaling=%u centerScaling=%u\n", caps.isGPUScalingAvailable ? 1 : 0,
+         caps.isGPUFixedAspectRatioScalingAvailable ? 1 : 0, caps.isMonitorScalingAvailable ? 1 : 0,
+         caps.isCenterScalingAvailable ? 1 : 0);
 }
 
 void PrintScalingCapsV2(const NV_GET_SCALING_CAPS_V2 &caps) {
-  std::printf("Scaling caps (v2):\n");
-  std::printf("  gpuFull=%u gpuAspect=%u monitorFull=%u center=%u\n", caps.isGPUScalingAvailable ? 1 : 0,
-              caps.isGPUFixedAspectRatioScalingAvailable ? 1 : 0, caps.isMonitorScalingAvailable ? 1 : 0,
-              caps.isCenterScalingAvailable ? 1 : 0);
-  std::printf("  gpuAspectClosest=%u gpuCenterClosest=%u gpuInteger=%u\n",
-              caps.isGPUScalingToAspectScanoutToClosest ? 1 : 0, caps.isGPUScanoutToClosest ? 1 : 0,
-              caps.isGpuRepeatToAspectScanoutToNative ? 1 : 0);
-  std::printf("  default=%s current=%s\n", ScalingName(caps.defaultScaling), ScalingName(caps.currentScaling));
+  Printf("Scaling caps (v2):\n");
+  Printf("  gpuFull=%u gpuAspect=%u monitorFull=%u center=%u\n", caps.isGPUScalingAvailable ? 1 : 0,
+         caps.isGPUFixedAspectRatioScalingAvailable ? 1 : 0, caps.isMonitorScalingAvailable ? 1 : 0,
+         caps.isCenterScalingAvailable ? 1 : 0);
+  Printf("  gpuAspectClosest=%u gpuCenterClosest=%u gpuInteger=%u\n", caps.isGPUScalingToAspectScanoutToClosest ? 1 : 0,
+         caps.isGPUScanoutToClosest ? 1 : 0, caps.isGpuRepeatToAspectScanoutToNative ? 1 : 0);
+  Printf("  default=%s current=%s\n", ScalingName(caps.defaultScaling), ScalingName(caps.currentScaling));
 }
 
 bool ApplyForcedScalingCapsV1(NV_GET_SCALING_CAPS_V1 &caps, NV_SCALING preferred) {
@@ -252,7 +222,7 @@ int CmdDisplayMonitorCaps(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -261,7 +231,7 @@ int CmdDisplayMonitorCaps(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--type") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --type\n");
+        Printf("Missing value for --type\n");
         return 1;
       }
       std::string lowered = ToLowerAscii(argv[i + 1]);
@@ -269,7 +239,7 @@ int CmdDisplayMonitorCaps(int argc, char **argv) {
         allTypes = true;
         hasType = true;
       } else if (!ParseMonitorCapsType(argv[i + 1], &type)) {
-        std::printf("Invalid monitor caps type: %s\n", argv[i + 1]);
+        Printf("Invalid monitor caps type: %s\n", argv[i + 1]);
         return 1;
       } else {
         hasType = true;
@@ -277,12 +247,12 @@ int CmdDisplayMonitorCaps(int argc, char **argv) {
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
 
@@ -301,57 +271,54 @@ int CmdDisplayMonitorCaps(int argc, char **argv) {
     caps.size = static_cast<NvU16>(sizeof(caps));
     caps.infoType = types[i];
 
-    NvAPI_Status status = NvAPI_DISP_GetMonitorCapabilities(displayId, &caps);
+    NvAPI_Status status = NvApi().NvAPI_DISP_GetMonitorCapabilities(displayId, &caps);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_DISP_GetMonitorCapabilities failed", status);
       continue;
     }
 
-    std::printf("Monitor caps type=%s connector=%s valid=%u\n",
-                MonitorCapsTypeName(static_cast<NV_MONITOR_CAPS_TYPE>(caps.infoType)),
-                ConnectorTypeName(static_cast<NV_MONITOR_CONN_TYPE>(caps.connectorType)), caps.bIsValidInfo ? 1 : 0);
+    Printf("Monitor caps type=%s connector=%s valid=%u\n",
+           MonitorCapsTypeName(static_cast<NV_MONITOR_CAPS_TYPE>(caps.infoType)),
+           ConnectorTypeName(static_cast<NV_MONITOR_CONN_TYPE>(caps.connectorType)), caps.bIsValidInfo ? 1 : 0);
 
     if (!caps.bIsValidInfo) { continue; }
 
     if (caps.infoType == NV_MONITOR_CAPS_TYPE_GENERIC) {
       const NV_MONITOR_CAPS_GENERIC &info = caps.data.caps;
-      std::printf("  vrr=%u ulmb=%u trueGsync=%u rla=%u\n", info.supportVRR ? 1 : 0, info.supportULMB ? 1 : 0,
-                  info.isTrueGsync ? 1 : 0, info.isRLACapable ? 1 : 0);
+      Printf("  vrr=%u ulmb=%u trueGsync=%u rla=%u\n", info.supportVRR ? 1 : 0, info.supportULMB ? 1 : 0,
+             info.isTrueGsync ? 1 : 0, info.isRLACapable ? 1 : 0);
     } else if (caps.infoType == NV_MONITOR_CAPS_TYPE_HDMI_VSDB) {
       const NV_MONITOR_CAPS_VSDB &info = caps.data.vsdb;
-      std::printf("  physAddr=%u.%u.%u.%u maxTmdsClock=%u\n", info.sourcePhysicalAddressA, info.sourcePhysicalAddressB,
-                  info.sourcePhysicalAddressC, info.sourcePhysicalAddressD, info.maxTmdsClock);
-      std::printf("  deepColor: ycbcr444=%u 30=%u 36=%u 48=%u ai=%u dualDvi=%u\n",
-                  info.supportDeepColorYCbCr444 ? 1 : 0, info.supportDeepColor30bits ? 1 : 0,
-                  info.supportDeepColor36bits ? 1 : 0, info.supportDeepColor48bits ? 1 : 0, info.supportAI ? 1 : 0,
-                  info.supportDualDviOperation ? 1 : 0);
-      std::printf("  cnc: graphics=%u photo=%u cinema=%u game=%u\n", info.cnc0SupportGraphicsTextContent ? 1 : 0,
-                  info.cnc1SupportPhotoContent ? 1 : 0, info.cnc2SupportCinemaContent ? 1 : 0,
-                  info.cnc3SupportGameContent ? 1 : 0);
-      std::printf("  latency: has=%u interlaced=%u video=%u audio=%u\n", info.hasLatencyField ? 1 : 0,
-                  info.hasInterlacedLatencyField ? 1 : 0, info.videoLatency, info.audioLatency);
-      std::printf("  latencyInterlaced: video=%u audio=%u\n", info.interlacedVideoLatency, info.interlacedAudioLatency);
-      std::printf("  vic: has=%u len=%u 3d: has=%u len=%u\n", info.hasVicEntries ? 1 : 0, info.hdmiVicLength,
-                  info.has3dEntries ? 1 : 0, info.hdmi3dLength);
+      Printf("  physAddr=%u.%u.%u.%u maxTmdsClock=%u\n", info.sourcePhysicalAddressA, info.sourcePhysicalAddressB,
+             info.sourcePhysicalAddressC, info.sourcePhysicalAddressD, info.maxTmdsClock);
+      Printf("  deepColor: ycbcr444=%u 30=%u 36=%u 48=%u ai=%u dualDvi=%u\n", info.supportDeepColorYCbCr444 ? 1 : 0,
+             info.supportDeepColor30bits ? 1 : 0, info.supportDeepColor36bits ? 1 : 0,
+             info.supportDeepColor48bits ? 1 : 0, info.supportAI ? 1 : 0, info.supportDualDviOperation ? 1 : 0);
+      Printf("  cnc: graphics=%u photo=%u cinema=%u game=%u\n", info.cnc0SupportGraphicsTextContent ? 1 : 0,
+             info.cnc1SupportPhotoContent ? 1 : 0, info.cnc2SupportCinemaContent ? 1 : 0,
+             info.cnc3SupportGameContent ? 1 : 0);
+      Printf("  latency: has=%u interlaced=%u video=%u audio=%u\n", info.hasLatencyField ? 1 : 0,
+             info.hasInterlacedLatencyField ? 1 : 0, info.videoLatency, info.audioLatency);
+      Printf("  latencyInterlaced: video=%u audio=%u\n", info.interlacedVideoLatency, info.interlacedAudioLatency);
+      Printf("  vic: has=%u len=%u 3d: has=%u len=%u\n", info.hasVicEntries ? 1 : 0, info.hdmiVicLength,
+             info.has3dEntries ? 1 : 0, info.hdmi3dLength);
       if (info.hasVicEntries && info.hdmiVicLength > 0) {
-        std::printf("  hdmiVic:");
+        Printf("  hdmiVic:");
         for (NvU8 j = 0; j < info.hdmiVicLength && j < sizeof(info.hdmi_vic); ++j) {
-          std::printf(" %02X", info.hdmi_vic[j]);
+          Printf(" %02X", info.hdmi_vic[j]);
         }
-        std::printf("\n");
+        Printf("\n");
       }
       if (info.has3dEntries && info.hdmi3dLength > 0) {
-        std::printf("  hdmi3d:");
-        for (NvU8 j = 0; j < info.hdmi3dLength && j < sizeof(info.hdmi_3d); ++j) {
-          std::printf(" %02X", info.hdmi_3d[j]);
-        }
-        std::printf("\n");
+        Printf("  hdmi3d:");
+        for (NvU8 j = 0; j < info.hdmi3dLength && j < sizeof(info.hdmi_3d); ++j) { Printf(" %02X", info.hdmi_3d[j]); }
+        Printf("\n");
       }
     } else if (caps.infoType == NV_MONITOR_CAPS_TYPE_HDMI_VCDB) {
       const NV_MONITOR_CAPS_VCDB &info = caps.data.vcdb;
-      std::printf("  quantYcc=%u quantRgb=%u scanPref=%u scanIT=%u scanCE=%u\n", info.quantizationRangeYcc,
-                  info.quantizationRangeRgb, info.scanInfoPreferredVideoFormat, info.scanInfoITVideoFormats,
-                  info.scanInfoCEVideoFormats);
+      Printf("  quantYcc=%u quantRgb=%u scanPref=%u scanIT=%u scanCE=%u\n", info.quantizationRangeYcc,
+             info.quantizationRangeRgb, info.scanInfoPreferredVideoFormat, info.scanInfoITVideoFormats,
+             info.scanInfoCEVideoFormats);
     }
   }
 
@@ -363,30 +330,29 @@ int CmdDisplayMonitorColorCaps(int argc, char **argv) {
   if (!ParseDisplayIdArg(argc, argv, &displayId)) { return 1; }
 
   NvU32 count = 0;
-  NvAPI_Status status = NvAPI_DISP_GetMonitorColorCapabilities(displayId, NULL, &count);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetMonitorColorCapabilities(displayId, NULL, &count);
   if (status != NVAPI_OK && status != NVAPI_INSUFFICIENT_BUFFER) {
     PrintNvapiError("NvAPI_DISP_GetMonitorColorCapabilities failed", status);
     return 1;
   }
 
   if (count == 0) {
-    std::printf("No monitor color caps reported.\n");
+    Printf("No monitor color caps reported.\n");
     return 0;
   }
 
   std::vector<NV_MONITOR_COLOR_CAPS> caps(count);
   for (NvU32 i = 0; i < count; ++i) { caps[i].version = NV_MONITOR_COLOR_CAPS_VER; }
 
-  status = NvAPI_DISP_GetMonitorColorCapabilities(displayId, caps.data(), &count);
+  status = NvApi().NvAPI_DISP_GetMonitorColorCapabilities(displayId, caps.data(), &count);
   if (status != NVAPI_OK && status != NVAPI_INSUFFICIENT_BUFFER) {
     PrintNvapiError("NvAPI_DISP_GetMonitorColorCapabilities failed", status);
     return 1;
   }
 
-  std::printf("Monitor color caps: entries=%u\n", count);
+  Printf("Monitor color caps: entries=%u\n", count);
   for (NvU32 i = 0; i < count; ++i) {
-    std::printf("  [%u] format=%s bpc=%s\n", i, DpColorFormatName(caps[i].colorFormat),
-                DpBpcName(caps[i].backendBitDepths));
+    Printf("  [%u] format=%s bpc=%s\n", i, DpColorFormatName(caps[i].colorFormat), DpBpcName(caps[i].backendBitDepths));
   }
   return 0;
 }
@@ -397,11 +363,11 @@ int CmdDisplayScaling(int argc, char **argv) {
 
   NV_GET_SCALING_CAPS caps = {};
   caps.version = NV_GET_SCALING_CAPS_VER;
-  NvAPI_Status status = NvAPI_DISP_GetScalingCaps(displayId, &caps);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetScalingCaps(displayId, &caps);
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     NV_GET_SCALING_CAPS_V1 capsV1 = {};
     capsV1.version = NV_GET_SCALING_CAPS_VER1;
-    status = NvAPI_DISP_GetScalingCaps(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&capsV1));
+    status = NvApi().NvAPI_DISP_GetScalingCaps(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&capsV1));
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_DISP_GetScalingCaps failed", status);
       return 1;
@@ -424,11 +390,11 @@ int CmdDisplayScalingOverrideGet(int argc, char **argv) {
 
   NV_GET_SCALING_CAPS caps = {};
   caps.version = NV_GET_SCALING_CAPS_VER;
-  NvAPI_Status status = NvAPI_DISP_GetScalingCapsOverride(displayId, &caps);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetScalingCapsOverride(displayId, &caps);
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     NV_GET_SCALING_CAPS_V1 capsV1 = {};
     capsV1.version = NV_GET_SCALING_CAPS_VER1;
-    status = NvAPI_DISP_GetScalingCapsOverride(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&capsV1));
+    status = NvApi().NvAPI_DISP_GetScalingCapsOverride(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&capsV1));
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_DISP_GetScalingCapsOverride failed", status);
       return 1;
@@ -454,7 +420,7 @@ int CmdDisplayScalingOverrideSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -463,7 +429,7 @@ int CmdDisplayScalingOverrideSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--preferred") == 0) {
       if (i + 1 >= argc || !ParseScalingMode(argv[i + 1], &preferred)) {
-        std::printf("Invalid preferred scaling mode.\n");
+        Printf("Invalid preferred scaling mode.\n");
         return 1;
       }
       ++i;
@@ -473,17 +439,17 @@ int CmdDisplayScalingOverrideSet(int argc, char **argv) {
       forceOverride = true;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
 
   if (forceOverride && preferred == NV_SCALING_DEFAULT) {
-    std::printf("--force-override requires --preferred.\n");
+    Printf("--force-override requires --preferred.\n");
     return 1;
   }
 
@@ -491,13 +457,13 @@ int CmdDisplayScalingOverrideSet(int argc, char **argv) {
   bool capsFromOverride = false;
   NV_GET_SCALING_CAPS caps = {};
   caps.version = NV_GET_SCALING_CAPS_VER;
-  NvAPI_Status status = NvAPI_DISP_GetScalingCapsOverride(displayId, &caps);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetScalingCapsOverride(displayId, &caps);
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     usedV1 = true;
   } else if (status == NVAPI_OK) {
     capsFromOverride = true;
   } else if (status != NVAPI_OK) {
-    status = NvAPI_DISP_GetScalingCaps(displayId, &caps);
+    status = NvApi().NvAPI_DISP_GetScalingCaps(displayId, &caps);
     if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
       usedV1 = true;
     } else if (status != NVAPI_OK) {
@@ -509,9 +475,9 @@ int CmdDisplayScalingOverrideSet(int argc, char **argv) {
   if (usedV1) {
     NV_GET_SCALING_CAPS_V1 capsV1 = {};
     capsV1.version = NV_GET_SCALING_CAPS_VER1;
-    status = NvAPI_DISP_GetScalingCapsOverride(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&capsV1));
+    status = NvApi().NvAPI_DISP_GetScalingCapsOverride(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&capsV1));
     if (status != NVAPI_OK) {
-      status = NvAPI_DISP_GetScalingCaps(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&capsV1));
+      status = NvApi().NvAPI_DISP_GetScalingCaps(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&capsV1));
       if (status != NVAPI_OK) {
         PrintNvapiError("NvAPI_DISP_GetScalingCapsOverride failed", status);
         return 1;
@@ -522,7 +488,7 @@ int CmdDisplayScalingOverrideSet(int argc, char **argv) {
       if (emptyCaps) {
         NV_GET_SCALING_CAPS_V1 fallback = {};
         fallback.version = NV_GET_SCALING_CAPS_VER1;
-        status = NvAPI_DISP_GetScalingCaps(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&fallback));
+        status = NvApi().NvAPI_DISP_GetScalingCaps(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&fallback));
         if (status == NVAPI_OK) {
           capsV1 = fallback;
         } else {
@@ -534,22 +500,23 @@ int CmdDisplayScalingOverrideSet(int argc, char **argv) {
 
     if (forceOverride) {
       if (!ApplyForcedScalingCapsV1(capsV1, preferred)) {
-        std::printf("Force override is not supported for preferred scaling %s on caps v1.\n", ScalingName(preferred));
+        Printf("Force override is not supported for preferred scaling %s on caps v1.\n", ScalingName(preferred));
         return 1;
       }
       capsV1.version = NV_GET_SCALING_CAPS_VER1;
     }
 
     PrintScalingCapsV1(capsV1);
-    std::printf("Preferred scaling=%s\n", ScalingName(preferred));
+    Printf("Preferred scaling=%s\n", ScalingName(preferred));
 
-    status = NvAPI_DISP_SetScalingCapsOverride(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&capsV1), preferred);
+    status = NvApi().NvAPI_DISP_SetScalingCapsOverride(displayId, reinterpret_cast<NV_GET_SCALING_CAPS *>(&capsV1),
+                                                       preferred);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_DISP_SetScalingCapsOverride failed", status);
       return 1;
     }
 
-    std::printf("Scaling override updated.\n");
+    Printf("Scaling override updated.\n");
     return 0;
   }
 
@@ -562,7 +529,7 @@ int CmdDisplayScalingOverrideSet(int argc, char **argv) {
     if (emptyCaps) {
       NV_GET_SCALING_CAPS fallback = {};
       fallback.version = NV_GET_SCALING_CAPS_VER;
-      status = NvAPI_DISP_GetScalingCaps(displayId, &fallback);
+      status = NvApi().NvAPI_DISP_GetScalingCaps(displayId, &fallback);
       if (status == NVAPI_OK) {
         caps = fallback;
       } else {
@@ -574,22 +541,22 @@ int CmdDisplayScalingOverrideSet(int argc, char **argv) {
 
   if (forceOverride) {
     if (!ApplyForcedScalingCapsV2(capsV2, preferred)) {
-      std::printf("Force override is not supported for preferred scaling %s.\n", ScalingName(preferred));
+      Printf("Force override is not supported for preferred scaling %s.\n", ScalingName(preferred));
       return 1;
     }
     caps.version = NV_GET_SCALING_CAPS_VER;
   }
 
   PrintScalingCapsV2(capsV2);
-  std::printf("Preferred scaling=%s\n", ScalingName(preferred));
+  Printf("Preferred scaling=%s\n", ScalingName(preferred));
 
-  status = NvAPI_DISP_SetScalingCapsOverride(displayId, &caps, preferred);
+  status = NvApi().NvAPI_DISP_SetScalingCapsOverride(displayId, &caps, preferred);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_SetScalingCapsOverride failed", status);
     return 1;
   }
 
-  std::printf("Scaling override updated.\n");
+  Printf("Scaling override updated.\n");
   return 0;
 }
 
@@ -602,7 +569,7 @@ int CmdDisplayScalingOverride(int argc, char **argv) {
   if (std::strcmp(argv[0], "get") == 0) { return CmdDisplayScalingOverrideGet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdDisplayScalingOverrideSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown display scaling-override subcommand: %s\n", argv[0]);
+  Printf("Unknown display scaling-override subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -612,15 +579,15 @@ int CmdDisplayViewportGet(int argc, char **argv) {
 
   NV_VIEW_PORT_INFO info = {};
   info.version = NV_VIEW_PORT_INFO_VER;
-  NvAPI_Status status = NvAPI_DISP_GetViewPortInfo(displayId, &info);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetViewPortInfo(displayId, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetViewPortInfo failed", status);
     return 1;
   }
 
-  std::printf("Viewport: x=%u y=%u w=%u h=%u lock=%u\n", info.viewPort.x, info.viewPort.y, info.viewPort.w,
-              info.viewPort.h, info.viewPortLockState ? 1 : 0);
-  std::printf("  zoom=%.3f%% (raw=%u)\n", static_cast<double>(info.zoomValue) / 1000.0, info.zoomValue);
+  Printf("Viewport: x=%u y=%u w=%u h=%u lock=%u\n", info.viewPort.x, info.viewPort.y, info.viewPort.w, info.viewPort.h,
+         info.viewPortLockState ? 1 : 0);
+  Printf("  zoom=%.3f%% (raw=%u)\n", static_cast<double>(info.zoomValue) / 1000.0, info.zoomValue);
   return 0;
 }
 
@@ -644,7 +611,7 @@ int CmdDisplayViewportSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -653,7 +620,7 @@ int CmdDisplayViewportSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--x") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &x)) {
-        std::printf("Invalid --x value.\n");
+        Printf("Invalid --x value.\n");
         return 1;
       }
       hasX = true;
@@ -662,7 +629,7 @@ int CmdDisplayViewportSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--y") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &y)) {
-        std::printf("Invalid --y value.\n");
+        Printf("Invalid --y value.\n");
         return 1;
       }
       hasY = true;
@@ -671,7 +638,7 @@ int CmdDisplayViewportSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--w") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &w)) {
-        std::printf("Invalid --w value.\n");
+        Printf("Invalid --w value.\n");
         return 1;
       }
       hasW = true;
@@ -680,7 +647,7 @@ int CmdDisplayViewportSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--h") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &h)) {
-        std::printf("Invalid --h value.\n");
+        Printf("Invalid --h value.\n");
         return 1;
       }
       hasH = true;
@@ -689,7 +656,7 @@ int CmdDisplayViewportSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--lock") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &lock)) {
-        std::printf("Invalid --lock value.\n");
+        Printf("Invalid --lock value.\n");
         return 1;
       }
       hasLock = true;
@@ -698,30 +665,30 @@ int CmdDisplayViewportSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--zoom") == 0) {
       if (i + 1 >= argc || !ParseDoubleValue(argv[i + 1], &zoom)) {
-        std::printf("Invalid --zoom value.\n");
+        Printf("Invalid --zoom value.\n");
         return 1;
       }
       hasZoom = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
 
   if (!hasX && !hasY && !hasW && !hasH && !hasLock && !hasZoom) {
-    std::printf("No viewport changes specified.\n");
+    Printf("No viewport changes specified.\n");
     return 1;
   }
 
   NV_VIEW_PORT_INFO info = {};
   info.version = NV_VIEW_PORT_INFO_VER;
-  NvAPI_Status status = NvAPI_DISP_GetViewPortInfo(displayId, &info);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetViewPortInfo(displayId, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetViewPortInfo failed", status);
     return 1;
@@ -741,24 +708,23 @@ int CmdDisplayViewportSet(int argc, char **argv) {
   }
   if (hasZoom) {
     if (zoom < 0.0) {
-      std::printf("Zoom must be non-negative.\n");
+      Printf("Zoom must be non-negative.\n");
       return 1;
     }
     info.zoomValue = static_cast<NvU32>(zoom * 1000.0 + 0.5);
     setFlags |= NV_VIEW_PORT_INFO_SET_ZOOM;
   }
 
-  std::printf("Viewport set: x=%u y=%u w=%u h=%u lock=%u zoom=%.3f%%\n", info.viewPort.x, info.viewPort.y,
-              info.viewPort.w, info.viewPort.h, info.viewPortLockState ? 1 : 0,
-              static_cast<double>(info.zoomValue) / 1000.0);
+  Printf("Viewport set: x=%u y=%u w=%u h=%u lock=%u zoom=%.3f%%\n", info.viewPort.x, info.viewPort.y, info.viewPort.w,
+         info.viewPort.h, info.viewPortLockState ? 1 : 0, static_cast<double>(info.zoomValue) / 1000.0);
 
-  status = NvAPI_DISP_SetViewPortInfo(displayId, &info, setFlags);
+  status = NvApi().NvAPI_DISP_SetViewPortInfo(displayId, &info, setFlags);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_SetViewPortInfo failed", status);
     return 1;
   }
 
-  std::printf("Viewport updated.\n");
+  Printf("Viewport updated.\n");
   return 0;
 }
 
@@ -771,7 +737,7 @@ int CmdDisplayViewport(int argc, char **argv) {
   if (std::strcmp(argv[0], "get") == 0) { return CmdDisplayViewportGet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdDisplayViewportSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown display viewport subcommand: %s\n", argv[0]);
+  Printf("Unknown display viewport subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -781,14 +747,14 @@ int CmdDisplayFeatureGet(int argc, char **argv) {
 
   NV_DISPLAY_FEATURE_CONFIG config = {};
   config.version = NV_DISPLAY_FEATURE_CONFIG_VER;
-  NvAPI_Status status = NvAPI_DISP_GetFeatureConfig(displayId, &config);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetFeatureConfig(displayId, &config);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetFeatureConfig failed", status);
     return 1;
   }
 
-  std::printf("Feature config: panScan=%u gdiPrimarySync=%u\n", config.isPanAndScanEnabled ? 1 : 0,
-              config.modulePresentSyncGDIPrimaryTarget ? 1 : 0);
+  Printf("Feature config: panScan=%u gdiPrimarySync=%u\n", config.isPanAndScanEnabled ? 1 : 0,
+         config.modulePresentSyncGDIPrimaryTarget ? 1 : 0);
   return 0;
 }
 
@@ -803,7 +769,7 @@ int CmdDisplayFeatureSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -812,7 +778,7 @@ int CmdDisplayFeatureSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--pan-scan") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &panScan)) {
-        std::printf("Invalid --pan-scan value.\n");
+        Printf("Invalid --pan-scan value.\n");
         return 1;
       }
       hasPanScan = true;
@@ -821,30 +787,30 @@ int CmdDisplayFeatureSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--gdi-primary") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &gdiPrimary)) {
-        std::printf("Invalid --gdi-primary value.\n");
+        Printf("Invalid --gdi-primary value.\n");
         return 1;
       }
       hasGdiPrimary = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
 
   if (!hasPanScan && !hasGdiPrimary) {
-    std::printf("No feature changes specified.\n");
+    Printf("No feature changes specified.\n");
     return 1;
   }
 
   NV_DISPLAY_FEATURE_CONFIG config = {};
   config.version = NV_DISPLAY_FEATURE_CONFIG_VER;
-  NvAPI_Status status = NvAPI_DISP_GetFeatureConfig(displayId, &config);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetFeatureConfig(displayId, &config);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetFeatureConfig failed", status);
     return 1;
@@ -853,16 +819,16 @@ int CmdDisplayFeatureSet(int argc, char **argv) {
   if (hasPanScan) { config.isPanAndScanEnabled = panScan ? 1 : 0; }
   if (hasGdiPrimary) { config.modulePresentSyncGDIPrimaryTarget = gdiPrimary ? 1 : 0; }
 
-  std::printf("Feature set: panScan=%u gdiPrimarySync=%u\n", config.isPanAndScanEnabled ? 1 : 0,
-              config.modulePresentSyncGDIPrimaryTarget ? 1 : 0);
+  Printf("Feature set: panScan=%u gdiPrimarySync=%u\n", config.isPanAndScanEnabled ? 1 : 0,
+         config.modulePresentSyncGDIPrimaryTarget ? 1 : 0);
 
-  status = NvAPI_DISP_SetFeatureConfig(displayId, &config);
+  status = NvApi().NvAPI_DISP_SetFeatureConfig(displayId, &config);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_SetFeatureConfig failed", status);
     return 1;
   }
 
-  std::printf("Feature config updated.\n");
+  Printf("Feature config updated.\n");
   return 0;
 }
 
@@ -875,7 +841,7 @@ int CmdDisplayFeature(int argc, char **argv) {
   if (std::strcmp(argv[0], "get") == 0) { return CmdDisplayFeatureGet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdDisplayFeatureSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown display feature subcommand: %s\n", argv[0]);
+  Printf("Unknown display feature subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -887,7 +853,7 @@ int CmdDisplayWideColorGet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -896,31 +862,31 @@ int CmdDisplayWideColorGet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--range") == 0) {
       if (i + 1 >= argc || !ParseWideColorRange(argv[i + 1], &range)) {
-        std::printf("Invalid --range value.\n");
+        Printf("Invalid --range value.\n");
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
 
   NV_WIDE_COLOR_RANGE_SETTING setting = {};
   setting.version = NV_WIDE_COLOR_RANGE_SETTING_VER;
   setting.colorRange = range;
-  NvAPI_Status status = NvAPI_DISP_GetWideColorRange(displayId, &setting);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetWideColorRange(displayId, &setting);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetWideColorRange failed", status);
     return 1;
   }
 
-  std::printf("Wide color range: range=%s enable=%u\n", WideColorRangeName(setting.colorRange), setting.enable ? 1 : 0);
+  Printf("Wide color range: range=%s enable=%u\n", WideColorRangeName(setting.colorRange), setting.enable ? 1 : 0);
   return 0;
 }
 
@@ -934,7 +900,7 @@ int CmdDisplayWideColorSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -943,7 +909,7 @@ int CmdDisplayWideColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--enable") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &enable)) {
-        std::printf("Invalid --enable value.\n");
+        Printf("Invalid --enable value.\n");
         return 1;
       }
       hasEnable = true;
@@ -952,18 +918,18 @@ int CmdDisplayWideColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--range") == 0) {
       if (i + 1 >= argc || !ParseWideColorRange(argv[i + 1], &range)) {
-        std::printf("Invalid --range value.\n");
+        Printf("Invalid --range value.\n");
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId || !hasEnable) {
-    std::printf("Missing required --id and --enable\n");
+    Printf("Missing required --id and --enable\n");
     return 1;
   }
 
@@ -972,15 +938,15 @@ int CmdDisplayWideColorSet(int argc, char **argv) {
   setting.colorRange = range;
   setting.enable = enable ? 1 : 0;
 
-  std::printf("Wide color set: range=%s enable=%u\n", WideColorRangeName(setting.colorRange), setting.enable ? 1 : 0);
+  Printf("Wide color set: range=%s enable=%u\n", WideColorRangeName(setting.colorRange), setting.enable ? 1 : 0);
 
-  NvAPI_Status status = NvAPI_DISP_SetWideColorRange(displayId, &setting);
+  NvAPI_Status status = NvApi().NvAPI_DISP_SetWideColorRange(displayId, &setting);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_SetWideColorRange failed", status);
     return 1;
   }
 
-  std::printf("Wide color range updated.\n");
+  Printf("Wide color range updated.\n");
   return 0;
 }
 
@@ -993,7 +959,7 @@ int CmdDisplayWideColor(int argc, char **argv) {
   if (std::strcmp(argv[0], "get") == 0) { return CmdDisplayWideColorGet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdDisplayWideColorSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown display wide-color subcommand: %s\n", argv[0]);
+  Printf("Unknown display wide-color subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -1005,15 +971,15 @@ int CmdDisplayBpcGet(int argc, char **argv) {
   config.version = NV_BPC_CONFIG_VER;
   config.displayId = displayId;
   config.cmd = NV_BPC_CONFIG_CMD_GET;
-  NvAPI_Status status = NvAPI_DISP_BpcConfiguration(&config);
+  NvAPI_Status status = NvApi().NvAPI_DISP_BpcConfiguration(&config);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_BpcConfiguration failed", status);
     return 1;
   }
 
-  std::printf("BPC config: bpc=%s (raw=%u) ditherOff=%u forceLink=%u forceRGDiv=%u\n",
-              BpcName(static_cast<NV_BPC>(config.bpc)), config.bpc, config.ditherOff ? 1 : 0,
-              config.forceAtCurLinkConfig ? 1 : 0, config.forceRGDivMode ? 1 : 0);
+  Printf("BPC config: bpc=%s (raw=%u) ditherOff=%u forceLink=%u forceRGDiv=%u\n",
+         BpcName(static_cast<NV_BPC>(config.bpc)), config.bpc, config.ditherOff ? 1 : 0,
+         config.forceAtCurLinkConfig ? 1 : 0, config.forceRGDivMode ? 1 : 0);
   return 0;
 }
 
@@ -1032,7 +998,7 @@ int CmdDisplayBpcSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -1041,7 +1007,7 @@ int CmdDisplayBpcSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--bpc") == 0) {
       if (i + 1 >= argc || !ParseBpcValue(argv[i + 1], &bpc)) {
-        std::printf("Invalid --bpc value. Expected default|6|8|10|12|16.\n");
+        Printf("Invalid --bpc value. Expected default|6|8|10|12|16.\n");
         return 1;
       }
       hasBpc = true;
@@ -1050,7 +1016,7 @@ int CmdDisplayBpcSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--dither") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &dither)) {
-        std::printf("Invalid --dither value.\n");
+        Printf("Invalid --dither value.\n");
         return 1;
       }
       hasDither = true;
@@ -1059,7 +1025,7 @@ int CmdDisplayBpcSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--force-link") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &forceLink)) {
-        std::printf("Invalid --force-link value.\n");
+        Printf("Invalid --force-link value.\n");
         return 1;
       }
       hasForceLink = true;
@@ -1068,24 +1034,24 @@ int CmdDisplayBpcSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--force-rg-div") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &forceRgDiv)) {
-        std::printf("Invalid --force-rg-div value.\n");
+        Printf("Invalid --force-rg-div value.\n");
         return 1;
       }
       hasForceRgDiv = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
 
   if (!hasBpc && !hasDither && !hasForceLink && !hasForceRgDiv) {
-    std::printf("No BPC changes specified.\n");
+    Printf("No BPC changes specified.\n");
     return 1;
   }
 
@@ -1093,7 +1059,7 @@ int CmdDisplayBpcSet(int argc, char **argv) {
   config.version = NV_BPC_CONFIG_VER;
   config.displayId = displayId;
   config.cmd = NV_BPC_CONFIG_CMD_GET;
-  NvAPI_Status status = NvAPI_DISP_BpcConfiguration(&config);
+  NvAPI_Status status = NvApi().NvAPI_DISP_BpcConfiguration(&config);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_BpcConfiguration failed", status);
     return 1;
@@ -1106,17 +1072,16 @@ int CmdDisplayBpcSet(int argc, char **argv) {
 
   config.cmd = NV_BPC_CONFIG_CMD_SET;
 
-  std::printf("BPC set: bpc=%s (raw=%u) ditherOff=%u forceLink=%u forceRGDiv=%u\n",
-              BpcName(static_cast<NV_BPC>(config.bpc)), config.bpc, config.ditherOff ? 1 : 0,
-              config.forceAtCurLinkConfig ? 1 : 0, config.forceRGDivMode ? 1 : 0);
+  Printf("BPC set: bpc=%s (raw=%u) ditherOff=%u forceLink=%u forceRGDiv=%u\n", BpcName(static_cast<NV_BPC>(config.bpc)),
+         config.bpc, config.ditherOff ? 1 : 0, config.forceAtCurLinkConfig ? 1 : 0, config.forceRGDivMode ? 1 : 0);
 
-  status = NvAPI_DISP_BpcConfiguration(&config);
+  status = NvApi().NvAPI_DISP_BpcConfiguration(&config);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_BpcConfiguration failed", status);
     return 1;
   }
 
-  std::printf("BPC configuration updated.\n");
+  Printf("BPC configuration updated.\n");
   return 0;
 }
 
@@ -1129,7 +1094,7 @@ int CmdDisplayBpc(int argc, char **argv) {
   if (std::strcmp(argv[0], "get") == 0) { return CmdDisplayBpcGet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdDisplayBpcSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown display bpc subcommand: %s\n", argv[0]);
+  Printf("Unknown display bpc subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -1139,14 +1104,14 @@ int CmdDisplayBlankingGet(int argc, char **argv) {
 
   NV_DISPLAY_BLANKING_INFO info = {};
   info.version = NV_DISPLAY_BLANKING_INFO_VER;
-  NvAPI_Status status = NvAPI_DISP_GetDisplayBlankingState(displayId, &info);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetDisplayBlankingState(displayId, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetDisplayBlankingState failed", status);
     return 1;
   }
 
-  std::printf("Display blanking: state=%u persist=%u\n", info.blankingState ? 1 : 0,
-              info.persistBlankingAcrossHotPlugUnplug ? 1 : 0);
+  Printf("Display blanking: state=%u persist=%u\n", info.blankingState ? 1 : 0,
+         info.persistBlankingAcrossHotPlugUnplug ? 1 : 0);
   return 0;
 }
 
@@ -1161,7 +1126,7 @@ int CmdDisplayBlankingSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -1170,7 +1135,7 @@ int CmdDisplayBlankingSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--state") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &state)) {
-        std::printf("Invalid --state value.\n");
+        Printf("Invalid --state value.\n");
         return 1;
       }
       hasState = true;
@@ -1179,25 +1144,25 @@ int CmdDisplayBlankingSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--persist") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &persist)) {
-        std::printf("Invalid --persist value.\n");
+        Printf("Invalid --persist value.\n");
         return 1;
       }
       hasPersist = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId || !hasState) {
-    std::printf("Missing required --id and --state\n");
+    Printf("Missing required --id and --state\n");
     return 1;
   }
 
   NV_DISPLAY_BLANKING_INFO info = {};
   info.version = NV_DISPLAY_BLANKING_INFO_VER;
-  NvAPI_Status status = NvAPI_DISP_GetDisplayBlankingState(displayId, &info);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetDisplayBlankingState(displayId, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetDisplayBlankingState failed", status);
     return 1;
@@ -1206,16 +1171,16 @@ int CmdDisplayBlankingSet(int argc, char **argv) {
   info.blankingState = state ? 1 : 0;
   if (hasPersist) { info.persistBlankingAcrossHotPlugUnplug = persist ? 1 : 0; }
 
-  std::printf("Display blanking set: state=%u persist=%u\n", info.blankingState ? 1 : 0,
-              info.persistBlankingAcrossHotPlugUnplug ? 1 : 0);
+  Printf("Display blanking set: state=%u persist=%u\n", info.blankingState ? 1 : 0,
+         info.persistBlankingAcrossHotPlugUnplug ? 1 : 0);
 
-  status = NvAPI_DISP_SetDisplayBlankingState(displayId, &info);
+  status = NvApi().NvAPI_DISP_SetDisplayBlankingState(displayId, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_SetDisplayBlankingState failed", status);
     return 1;
   }
 
-  std::printf("Display blanking updated.\n");
+  Printf("Display blanking updated.\n");
   return 0;
 }
 
@@ -1228,7 +1193,7 @@ int CmdDisplayBlanking(int argc, char **argv) {
   if (std::strcmp(argv[0], "get") == 0) { return CmdDisplayBlankingGet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdDisplayBlankingSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown display blanking subcommand: %s\n", argv[0]);
+  Printf("Unknown display blanking subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -1237,42 +1202,42 @@ int CmdDisplayIdByName(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--name") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --name\n");
+        Printf("Missing value for --name\n");
         return 1;
       }
       name = argv[i + 1];
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!name) {
-    std::printf("Missing required --name\n");
+    Printf("Missing required --name\n");
     return 1;
   }
 
   NvU32 displayId = 0;
-  NvAPI_Status status = NvAPI_DISP_GetDisplayIdByDisplayName(name, &displayId);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetDisplayIdByDisplayName(name, &displayId);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetDisplayIdByDisplayName failed", status);
     return 1;
   }
 
-  std::printf("Display name \"%s\" id=0x%08X\n", name, displayId);
+  Printf("Display name \"%s\" id=0x%08X\n", name, displayId);
   return 0;
 }
 
 int CmdDisplayGdiPrimary() {
   NvU32 displayId = 0;
-  NvAPI_Status status = NvAPI_DISP_GetGDIPrimaryDisplayId(&displayId);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetGDIPrimaryDisplayId(&displayId);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetGDIPrimaryDisplayId failed", status);
     return 1;
   }
 
-  std::printf("GDI primary display id=0x%08X\n", displayId);
+  Printf("GDI primary display id=0x%08X\n", displayId);
   return 0;
 }
 
@@ -1280,14 +1245,19 @@ int CmdDisplayHandleFromId(int argc, char **argv) {
   NvU32 displayId = 0;
   if (!ParseDisplayIdArg(argc, argv, &displayId)) { return 1; }
 
+  TopologyDisplay display = {};
   NvDisplayHandle handle = NULL;
-  NvAPI_Status status = NvAPI_DISP_GetDisplayHandleFromDisplayId(displayId, &handle);
-  if (status != NVAPI_OK) {
-    PrintNvapiError("NvAPI_DISP_GetDisplayHandleFromDisplayId failed", status);
-    return 1;
+  if (Topology().DisplayById(displayId, &display)) {
+    handle = display.handle;
+  } else {
+    NvAPI_Status status = NvApi().NvAPI_DISP_GetDisplayHandleFromDisplayId(displayId, &handle);
+    if (status != NVAPI_OK) {
+      PrintNvapiError("NvAPI_DISP_GetDisplayHandleFromDisplayId failed", status);
+      return 1;
+    }
   }
 
-  std::printf("Display handle for id=0x%08X is 0x%p\n", displayId, handle);
+  Printf("Display handle for id=0x%08X is 0x%p\n", displayId, handle);
   return 0;
 }
 
@@ -1298,36 +1268,38 @@ int CmdDisplayIdFromHandle(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--handle-index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &handleIndex)) {
-        std::printf("Invalid handle index.\n");
+        Printf("Invalid handle index.\n");
         return 1;
       }
       hasHandleIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasHandleIndex) {
-    std::printf("Missing required --handle-index\n");
+    Printf("Missing required --handle-index\n");
     return 1;
   }
 
-  NvDisplayHandle handle = NULL;
-  if (!GetDisplayHandleByIndex(handleIndex, &handle)) {
-    std::printf("Display handle index %u not found.\n", handleIndex);
+  TopologyDisplay display = {};
+  if (!Topology().DisplayByIndex(handleIndex, &display)) {
+    Printf("Display handle index %u not found.\n", handleIndex);
     return 1;
   }
 
-  NvU32 displayId = 0;
-  NvAPI_Status status = NvAPI_DISP_GetDisplayIdFromDisplayHandle(handle, &displayId);
-  if (status != NVAPI_OK) {
-    PrintNvapiError("NvAPI_DISP_GetDisplayIdFromDisplayHandle failed", status);
-    return 1;
+  NvU32 displayId = display.displayId;
+  if (!display.hasDisplayId) {
+    NvAPI_Status status = NvApi().NvAPI_DISP_GetDisplayIdFromDisplayHandle(display.handle, &displayId);
+    if (status != NVAPI_OK) {
+      PrintNvapiError("NvAPI_DISP_GetDisplayIdFromDisplayHandle failed", status);
+      return 1;
+    }
   }
 
-  std::printf("Display id for handle index %u is 0x%08X\n", handleIndex, displayId);
+  Printf("Display id for handle index %u is 0x%08X\n", handleIndex, displayId);
   return 0;
 }
 } // namespace nvcli
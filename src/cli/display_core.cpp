@@ -4,27 +4,26 @@
  */
 
 #include "cli/commands.h"
+#include "cli/topology.h"
 
 namespace nvcli {
 int CmdDisplayList() {
-  NvU32 index = 0;
-  NvDisplayHandle handle = NULL;
-  while (NvAPI_EnumNvidiaDisplayHandle(index, &handle) == NVAPI_OK) {
+  const NvU32 count = Topology().DisplayCount();
+  for (NvU32 index = 0; index < count; ++index) {
+    TopologyDisplay display = {};
+    if (!Topology().DisplayByIndex(index, &display)) { break; }
     NvAPI_ShortString name = {0};
-    NvAPI_Status status = NvAPI_GetAssociatedNvidiaDisplayName(handle, name);
+    NvAPI_Status status = NvApi().NvAPI_GetAssociatedNvidiaDisplayName(display.handle, name);
     if (status != NVAPI_OK) { strncpy_s(name, sizeof(name), "<name unavailable>", _TRUNCATE); }
 
-    NvU32 outputId = 0;
-    status = NvAPI_GetAssociatedDisplayOutputId(handle, &outputId);
-    if (status == NVAPI_OK) {
-      std::printf("[%u] handle=0x%p name=%s output=0x%08X\n", index, handle, name, outputId);
+    if (display.hasOutputId) {
+      Printf("[%u] handle=0x%p name=%s output=0x%08X\n", index, display.handle, name, display.outputId);
     } else {
-      std::printf("[%u] handle=0x%p name=%s\n", index, handle, name);
+      Printf("[%u] handle=0x%p name=%s\n", index, display.handle, name);
     }
-    ++index;
   }
 
-  if (index == 0) { std::printf("No NVIDIA displays found.\n"); }
+  if (count == 0) { Printf("No NVIDIA displays found.\n"); }
   return 0;
 }
 
@@ -33,23 +32,23 @@ int CmdDisplayGet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--handle-index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --handle-index\n");
+        Printf("Missing value for --handle-index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &handleIndex)) {
-        std::printf("Invalid handle index: %s\n", argv[i + 1]);
+        Printf("Invalid handle index: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
     } else {
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
   }
 
   NvDisplayHandle handle = NULL;
   if (!GetDisplayHandleByIndex(handleIndex, &handle)) {
-    std::printf("Display handle index %u not found.\n", handleIndex);
+    Printf("Display handle index %u not found.\n", handleIndex);
     return 1;
   }
 
@@ -57,15 +56,15 @@ int CmdDisplayGet(int argc, char **argv) {
   for (NvU32 i = 0; i < kMaxDisplayPaths; ++i) { paths[i].version = NV_DISP_PATH_VER; }
 
   NvU32 pathCount = kMaxDisplayPaths;
-  NvAPI_Status status = NvAPI_GetDisplaySettings(handle, paths, &pathCount);
+  NvAPI_Status status = NvApi().NvAPI_GetDisplaySettings(handle, paths, &pathCount);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GetDisplaySettings failed", status);
     return 1;
   }
 
-  std::printf("Display paths: %u\n", pathCount);
+  Printf("Display paths: %u\n", pathCount);
   for (NvU32 i = 0; i < pathCount; ++i) {
-    std::printf("  [%u] srcID=%u device=0x%08X\n", i, paths[i].srcID, paths[i].device);
+    Printf("  [%u] srcID=%u device=0x%08X\n", i, paths[i].srcID, paths[i].device);
   }
   return 0;
 }
@@ -78,11 +77,11 @@ int CmdDisplaySet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--handle-index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --handle-index\n");
+        Printf("Missing value for --handle-index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &handleIndex)) {
-        std::printf("Invalid handle index: %s\n", argv[i + 1]);
+        Printf("Invalid handle index: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
@@ -91,7 +90,7 @@ int CmdDisplaySet(int argc, char **argv) {
     NvU32 srcId = 0;
     NvU32 device = 0;
     if (!ParseSrcDevicePair(argv[i], &srcId, &device)) {
-      std::printf("Invalid path format: %s (expected srcId:device)\n", argv[i]);
+      Printf("Invalid path format: %s (expected srcId:device)\n", argv[i]);
       return 1;
     }
 
@@ -103,28 +102,30 @@ int CmdDisplaySet(int argc, char **argv) {
   }
 
   if (paths.empty()) {
-    std::printf("No display paths provided.\n");
+    Printf("No display paths provided.\n");
     return 1;
   }
 
   NvDisplayHandle handle = NULL;
   if (!GetDisplayHandleByIndex(handleIndex, &handle)) {
-    std::printf("Display handle index %u not found.\n", handleIndex);
+    Printf("Display handle index %u not found.\n", handleIndex);
     return 1;
   }
 
-  std::printf("Requested display paths:\n");
+  Printf("Requested display paths:\n");
   for (size_t i = 0; i < paths.size(); ++i) {
-    std::printf("  [%u] srcID=%u device=0x%08X\n", static_cast<unsigned>(i), paths[i].srcID, paths[i].device);
+    Printf("  [%u] srcID=%u device=0x%08X\n", static_cast<unsigned>(i), paths[i].srcID, paths[i].device);
   }
 
-  NvAPI_Status status = NvAPI_SetDisplaySettings(handle, &paths[0], static_cast<NvU32>(paths.size()));
+  NvAPI_Status status = NvApi().NvAPI_SetDisplaySettings(handle, &paths[0], static_cast<NvU32>(paths.size()));
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_SetDisplaySettings failed", status);
     return 1;
   }
+  // Display handles and their indices change with the enabled display set.
+  Topology().Invalidate();
 
-  std::printf("Display settings applied.\n");
+  Printf("Display settings applied.\n");
   return 0;
 }
 } // namespace nvcli
@@ -4,6 +4,20 @@
  */
 
 #include "cli/commands.h"
+#include "cli/timing_calc.h"
+#include "cli/topology.h"
+
+#include <io.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
 
 namespace nvcli {
 namespace {
@@ -94,12 +108,12 @@ bool ParseTimingOverride(const char *value, NV_TIMING_OVERRIDE *out) {
 
 void PrintCustomDisplay(const NV_CUSTOM_DISPLAY &custom, NvU32 index) {
   double refresh = TimingRefreshHz(custom.timing);
-  std::printf("  [%u] %ux%u depth=%u format=%u ratio=%.3f/%.3f hwOnly=%u\n", index, custom.width, custom.height,
-              custom.depth, static_cast<unsigned>(custom.colorFormat), custom.xRatio, custom.yRatio,
-              custom.hwModeSetOnly ? 1 : 0);
-  std::printf("       timing: %ux%u %s pclk=%.3f MHz refresh=%.2f Hz\n", custom.timing.HVisible, custom.timing.VVisible,
-              custom.timing.interlaced ? "interlaced" : "progressive", static_cast<double>(custom.timing.pclk) / 100.0,
-              refresh);
+  Printf("  [%u] %ux%u depth=%u format=%u ratio=%.3f/%.3f hwOnly=%u\n", index, custom.width, custom.height,
+         custom.depth, static_cast<unsigned>(custom.colorFormat), custom.xRatio, custom.yRatio,
+         custom.hwModeSetOnly ? 1 : 0);
+  Printf("       timing: %ux%u %s pclk=%.3f MHz refresh=%.2f Hz\n", custom.timing.HVisible, custom.timing.VVisible,
+         custom.timing.interlaced ? "interlaced" : "progressive", static_cast<double>(custom.timing.pclk) / 100.0,
+         refresh);
 }
 
 bool BuildTiming(NvU32 displayId, NvU32 width, NvU32 height, float refresh, NV_TIMING_OVERRIDE type, bool interlaced,
@@ -114,7 +128,7 @@ bool BuildTiming(NvU32 displayId, NvU32 width, NvU32 height, float refresh, NV_T
 
   if (type == NV_TIMING_OVERRIDE_EIA861) {
     if (!hasCeaId) {
-      std::printf("Missing --cea-id for timing type EIA861.\n");
+      Printf("Missing --cea-id for timing type EIA861.\n");
       return false;
     }
     input.width = 0;
@@ -123,7 +137,7 @@ bool BuildTiming(NvU32 displayId, NvU32 width, NvU32 height, float refresh, NV_T
     input.flag.ceaId = static_cast<NvU32>(ceaId);
   } else if (type == NV_TIMING_OVERRIDE_ANALOG_TV) {
     if (!hasTvFormat) {
-      std::printf("Missing --tv-format for timing type ANALOG_TV.\n");
+      Printf("Missing --tv-format for timing type ANALOG_TV.\n");
       return false;
     }
     input.width = 0;
@@ -132,7 +146,7 @@ bool BuildTiming(NvU32 displayId, NvU32 width, NvU32 height, float refresh, NV_T
     input.flag.tvFormat = static_cast<NvU32>(tvFormat);
   } else if (type == NV_TIMING_OVERRIDE_NV_PREDEFINED) {
     if (!hasPsfId) {
-      std::printf("Missing --psf-id for timing type NV_PREDEFINED.\n");
+      Printf("Missing --psf-id for timing type NV_PREDEFINED.\n");
       return false;
     }
     input.width = 0;
@@ -141,7 +155,7 @@ bool BuildTiming(NvU32 displayId, NvU32 width, NvU32 height, float refresh, NV_T
     input.flag.nvPsfId = static_cast<NvU32>(psfId);
   } else {
     if (width == 0 || height == 0 || refresh <= 0.0f) {
-      std::printf("Missing --width/--height/--refresh for timing calculation.\n");
+      Printf("Missing --width/--height/--refresh for timing calculation.\n");
       return false;
     }
     input.width = width;
@@ -149,7 +163,7 @@ bool BuildTiming(NvU32 displayId, NvU32 width, NvU32 height, float refresh, NV_T
     input.rr = refresh;
   }
 
-  NvAPI_Status status = NvAPI_DISP_GetTiming(displayId, &input, outTiming);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetTiming(displayId, &input, outTiming);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetTiming failed", status);
     return false;
@@ -158,17 +172,8 @@ bool BuildTiming(NvU32 displayId, NvU32 width, NvU32 height, float refresh, NV_T
   return true;
 }
 
-bool BuildCustomDisplay(NvU32 displayId, NvU32 width, NvU32 height, float refresh, NvU32 depth, NV_TIMING_OVERRIDE type,
-                        bool interlaced, bool hwOnly, bool hasCeaId, NvU32 ceaId, bool hasTvFormat, NvU32 tvFormat,
-                        bool hasPsfId, NvU32 psfId, NV_CUSTOM_DISPLAY *outCustom) {
-  if (!outCustom) { return false; }
-
-  NV_TIMING timing = {};
-  if (!BuildTiming(displayId, width, height, refresh, type, interlaced, hasCeaId, ceaId, hasTvFormat, tvFormat,
-                   hasPsfId, psfId, &timing)) {
-    return false;
-  }
-
+void FillCustomDisplay(NvU32 width, NvU32 height, NvU32 depth, bool hwOnly, const NV_TIMING &timing,
+                       NV_CUSTOM_DISPLAY *outCustom) {
   if (width == 0) { width = timing.HVisible; }
   if (height == 0) { height = timing.VVisible; }
 
@@ -186,8 +191,203 @@ bool BuildCustomDisplay(NvU32 displayId, NvU32 width, NvU32 height, float refres
   outCustom->yRatio = 1.0f;
   outCustom->timing = timing;
   outCustom->hwModeSetOnly = hwOnly ? 1 : 0;
+}
+
+std::atomic<bool> g_sweepStop{false};
+
+BOOL WINAPI SweepCtrlHandler(DWORD type) {
+  if (type != CTRL_C_EVENT && type != CTRL_BREAK_EVENT) { return FALSE; }
+  g_sweepStop = true;
+  return TRUE;
+}
+
+std::string SweepModeKey(const TimingMode &mode) {
+  char key[48];
+  std::snprintf(key, sizeof(key), "%ux%u@%.3f", mode.width, mode.height, mode.refreshHz);
+  return key;
+}
+
+// Runs one NVAPI call on a detached thread and waits at most timeoutMs. A call that does not come back is left
+// running on its thread.
+bool CallWithTimeout(NvU32 timeoutMs, std::function<NvAPI_Status()> call, NvAPI_Status *status) {
+  auto result = std::make_shared<std::promise<NvAPI_Status>>();
+  std::future<NvAPI_Status> future = result->get_future();
+  std::thread([result, call] { result->set_value(call()); }).detach();
+  if (future.wait_for(std::chrono::milliseconds(timeoutMs)) != std::future_status::ready) { return false; }
+  *status = future.get();
+  return true;
+}
+
+// Append-only text journal of a sweep. Every line is flushed to disk before the step it describes runs, so after a
+// crash or a killed process the next run finds a "try" without a "revert" and reverts that display first.
+//   sweep <displayId> <formula> <modes>
+//   try <displayId> <mode>
+//   result <displayId> <mode> <result>
+//   revert <displayId> ok
+class SweepJournal {
+public:
+  ~SweepJournal() {
+    if (m_file) { std::fclose(m_file); }
+  }
+
+  bool Open(const char *path) {
+    FILE *existing = nullptr;
+    if (fopen_s(&existing, path, "r") == 0 && existing) {
+      char line[256];
+      while (std::fgets(line, sizeof(line), existing)) {
+        char verb[16] = {0};
+        unsigned displayId = 0;
+        char mode[48] = {0};
+        if (std::sscanf(line, "%15s %x %47s", verb, &displayId, mode) < 2) { continue; }
+        if (std::strcmp(verb, "try") == 0) { m_pending[displayId] = true; }
+        // Only a revert that completed clears the trial, a failed one is retried by the next run.
+        if (std::strcmp(verb, "revert") == 0 && std::strcmp(mode, "ok") == 0) { m_pending[displayId] = false; }
+        if (std::strcmp(verb, "result") == 0 && mode[0]) { m_done.insert(SweepDoneKey(displayId, mode)); }
+      }
+      std::fclose(existing);
+    }
+    if (fopen_s(&m_file, path, "a") != 0 || !m_file) {
+      Printf("Failed to open journal %s\n", path);
+      m_file = nullptr;
+      return false;
+    }
+    return true;
+  }
+
+  bool IsOpen() const { return m_file != nullptr; }
+
+  // Displays left in a trial by an earlier run.
+  std::vector<NvU32> Pending() const {
+    std::vector<NvU32> pending;
+    for (const auto &entry : m_pending) {
+      if (entry.second) { pending.push_back(entry.first); }
+    }
+    return pending;
+  }
+
+  bool Done(NvU32 displayId, const std::string &mode) const {
+    return m_done.count(SweepDoneKey(displayId, mode)) != 0;
+  }
+
+  void Write(const char *format, ...) {
+    if (!m_file) { return; }
+    va_list args;
+    va_start(args, format);
+    std::vfprintf(m_file, format, args);
+    va_end(args);
+    std::fputc('\n', m_file);
+    std::fflush(m_file);
+    _commit(_fileno(m_file));
+  }
+
+private:
+  static std::string SweepDoneKey(NvU32 displayId, const std::string &mode) {
+    char prefix[16];
+    std::snprintf(prefix, sizeof(prefix), "%08X ", displayId);
+    return prefix + mode;
+  }
+
+  FILE *m_file = nullptr;
+  std::map<NvU32, bool> m_pending;
+  std::set<std::string> m_done;
+};
+
+// Displays with a try or revert that timed out. The call is still running inside NVAPI on its detached thread and
+// another call on that display would race it, so they stay blocked until the process exits (a serve or batch session
+// included). NVAPI is then kept loaded at exit as well.
+std::mutex g_stuckLock;
+std::set<NvU32> g_stuckDisplays;
+
+bool DisplayStuck(NvU32 displayId) {
+  std::lock_guard<std::mutex> guard(g_stuckLock);
+  return g_stuckDisplays.count(displayId) != 0;
+}
+
+void BlockStuckDisplay(NvU32 displayId, bool journaled) {
+  {
+    std::lock_guard<std::mutex> guard(g_stuckLock);
+    g_stuckDisplays.insert(displayId);
+  }
+  KeepNvApiLoaded();
+  if (journaled) {
+    Printf("Trial on 0x%08X is left pending in the journal, run the sweep again with --journal from a new process to "
+           "revert it.\n",
+           displayId);
+  } else {
+    Printf("Trial on 0x%08X may still be active, revert it with display custom revert --id 0x%08X from a new "
+           "process.\n",
+           displayId, displayId);
+  }
+}
+
+bool RefuseStuckDisplay(NvU32 displayId) {
+  if (!DisplayStuck(displayId)) { return false; }
+  Printf("Display 0x%08X has an NVAPI call that did not return, it is blocked until this process exits\n", displayId);
+  return true;
+}
+
+// Reverts the trial on a display and journals it, false when the revert did not complete. Only a completed revert is
+// journaled, so a failed one stays pending. A revert that does not return blocks the display.
+bool SweepRevert(NvU32 displayId, NvU32 timeoutMs, SweepJournal *journal) {
+  if (RefuseStuckDisplay(displayId)) { return false; }
+  NvAPI_Status status = NVAPI_OK;
+  if (!CallWithTimeout(timeoutMs, [displayId] {
+        NvU32 displayIds[1] = {displayId};
+        return NvApi().NvAPI_DISP_RevertCustomDisplayTrial(displayIds, 1);
+      }, &status)) {
+    Printf("NvAPI_DISP_RevertCustomDisplayTrial on 0x%08X did not return within %u ms\n", displayId, timeoutMs);
+    BlockStuckDisplay(displayId, journal->IsOpen());
+    return false;
+  }
+  Topology().Invalidate();
+  if (status != NVAPI_OK) {
+    PrintNvapiError("NvAPI_DISP_RevertCustomDisplayTrial failed", status);
+    return false;
+  }
+  journal->Write("revert 0x%08X ok", displayId);
   return true;
 }
+
+// The backend timing that carries the requested mode, the driver may round the pixel clock by up to 0.5%.
+bool FindAppliedTiming(NvU32 displayId, const NV_TIMING &expected, NV_TIMING *applied, std::string *detail) {
+  NvU32 count = 0;
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetTimingInfo(displayId, &count, NULL);
+  std::vector<NV_BACKEND_TIMING_INFO> timings;
+  if (status == NVAPI_OK && count > 0) {
+    timings.assign(count, NV_BACKEND_TIMING_INFO{});
+    for (auto &timing : timings) { timing.version = NV_BACKEND_TIMING_INFO_VER; }
+    status = NvApi().NvAPI_DISP_GetTimingInfo(displayId, &count, timings.data());
+  }
+  if (status != NVAPI_OK) {
+    *detail = std::string("NvAPI_DISP_GetTimingInfo: ") + NvapiStatusString(status);
+    return false;
+  }
+  timings.resize(count);
+
+  // Without an exact match the entry of the same size, else the first one, is reported.
+  const NV_TIMING *closest = nullptr;
+  for (const auto &entry : timings) {
+    const NV_TIMING &timing = entry.timingInfo;
+    if (timing.HVisible != expected.HVisible || timing.VVisible != expected.VVisible) { continue; }
+    const NvU32 diff = timing.pclk > expected.pclk ? timing.pclk - expected.pclk : expected.pclk - timing.pclk;
+    if (timing.HTotal == expected.HTotal && timing.VTotal == expected.VTotal && diff * 200 <= expected.pclk) {
+      *applied = timing;
+      return true;
+    }
+    if (!closest) { closest = &timing; }
+  }
+  if (!closest && !timings.empty()) { closest = &timings[0].timingInfo; }
+  if (!closest) {
+    *detail = "no backend timing";
+    return false;
+  }
+  *applied = *closest;
+  char text[96];
+  std::snprintf(text, sizeof(text), "applied %ux%u total=%ux%u pclk=%.2f MHz", closest->HVisible, closest->VVisible,
+                closest->HTotal, closest->VTotal, closest->pclk / 100.0);
+  *detail = text;
+  return false;
+}
 } // namespace
 
 int CmdDisplayCustomList(int argc, char **argv) {
@@ -199,20 +399,20 @@ int CmdDisplayCustomList(int argc, char **argv) {
   while (true) {
     NV_CUSTOM_DISPLAY custom = {};
     custom.version = NV_CUSTOM_DISPLAY_VER;
-    NvAPI_Status status = NvAPI_DISP_EnumCustomDisplay(displayId, index, &custom);
+    NvAPI_Status status = NvApi().NvAPI_DISP_EnumCustomDisplay(displayId, index, &custom);
     if (status == NVAPI_END_ENUMERATION) { break; }
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_DISP_EnumCustomDisplay failed", status);
       return 1;
     }
 
-    if (!any) { std::printf("Custom displays for 0x%08X:\n", displayId); }
+    if (!any) { Printf("Custom displays for 0x%08X:\n", displayId); }
     any = true;
     PrintCustomDisplay(custom, index);
     ++index;
   }
 
-  if (!any) { std::printf("No custom displays found for 0x%08X.\n", displayId); }
+  if (!any) { Printf("No custom displays found for 0x%08X.\n", displayId); }
   return 0;
 }
 
@@ -232,11 +432,13 @@ int CmdDisplayCustomTry(int argc, char **argv) {
   NvU32 tvFormat = 0;
   bool hasPsfId = false;
   NvU32 psfId = 0;
+  bool hasFormula = false;
+  TimingFormula formula = kTimingCvtRb;
 
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -245,7 +447,7 @@ int CmdDisplayCustomTry(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--width") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &width)) {
-        std::printf("Invalid --width value.\n");
+        Printf("Invalid --width value.\n");
         return 1;
       }
       ++i;
@@ -253,7 +455,7 @@ int CmdDisplayCustomTry(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--height") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &height)) {
-        std::printf("Invalid --height value.\n");
+        Printf("Invalid --height value.\n");
         return 1;
       }
       ++i;
@@ -261,7 +463,7 @@ int CmdDisplayCustomTry(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--refresh") == 0) {
       if (i + 1 >= argc || !ParseFloatValue(argv[i + 1], &refresh)) {
-        std::printf("Invalid --refresh value.\n");
+        Printf("Invalid --refresh value.\n");
         return 1;
       }
       ++i;
@@ -269,7 +471,7 @@ int CmdDisplayCustomTry(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--depth") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &depth)) {
-        std::printf("Invalid --depth value.\n");
+        Printf("Invalid --depth value.\n");
         return 1;
       }
       ++i;
@@ -277,7 +479,7 @@ int CmdDisplayCustomTry(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--type") == 0) {
       if (i + 1 >= argc || !ParseTimingOverride(argv[i + 1], &type)) {
-        std::printf("Invalid --type value.\n");
+        Printf("Invalid --type value.\n");
         return 1;
       }
       ++i;
@@ -285,7 +487,7 @@ int CmdDisplayCustomTry(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--interlaced") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &interlaced)) {
-        std::printf("Invalid --interlaced value.\n");
+        Printf("Invalid --interlaced value.\n");
         return 1;
       }
       ++i;
@@ -293,7 +495,7 @@ int CmdDisplayCustomTry(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--hw-only") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &hwOnly)) {
-        std::printf("Invalid --hw-only value.\n");
+        Printf("Invalid --hw-only value.\n");
         return 1;
       }
       ++i;
@@ -301,7 +503,7 @@ int CmdDisplayCustomTry(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--cea-id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &ceaId)) {
-        std::printf("Invalid --cea-id value.\n");
+        Printf("Invalid --cea-id value.\n");
         return 1;
       }
       hasCeaId = true;
@@ -310,7 +512,7 @@ int CmdDisplayCustomTry(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--tv-format") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &tvFormat)) {
-        std::printf("Invalid --tv-format value.\n");
+        Printf("Invalid --tv-format value.\n");
         return 1;
       }
       hasTvFormat = true;
@@ -319,45 +521,69 @@ int CmdDisplayCustomTry(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--psf-id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &psfId)) {
-        std::printf("Invalid --psf-id value.\n");
+        Printf("Invalid --psf-id value.\n");
         return 1;
       }
       hasPsfId = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    if (std::strcmp(argv[i], "--formula") == 0) {
+      if (i + 1 >= argc || !ParseTimingFormula(argv[i + 1], &formula)) {
+        Printf("Invalid --formula value.\n");
+        return 1;
+      }
+      hasFormula = true;
+      ++i;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
+  if (RefuseStuckDisplay(displayId)) { return 1; }
 
   if (type == NV_TIMING_OVERRIDE_CUST) {
-    std::printf("NV_TIMING_OVERRIDE_CUST requires explicit timing fields and is not supported by this command.\n");
+    Printf("NV_TIMING_OVERRIDE_CUST requires explicit timing fields and is not supported by this command.\n");
     return 1;
   }
 
-  NV_CUSTOM_DISPLAY custom = {};
-  if (!BuildCustomDisplay(displayId, width, height, refresh, depth, type, interlaced, hwOnly, hasCeaId, ceaId,
-                          hasTvFormat, tvFormat, hasPsfId, psfId, &custom)) {
+  // --formula computes the timing in process instead of asking the driver through NvAPI_DISP_GetTiming.
+  NV_TIMING timing = {};
+  if (hasFormula) {
+    if (width == 0 || height == 0 || refresh <= 0.0f) {
+      Printf("Missing --width/--height/--refresh for timing calculation.\n");
+      return 1;
+    }
+    if (!ComputeTiming(formula, width, height, refresh, interlaced, &timing)) {
+      Printf("%s cannot produce %ux%u@%.3f Hz\n", TimingFormulaName(formula), width, height, refresh);
+      return 1;
+    }
+  } else if (!BuildTiming(displayId, width, height, refresh, type, interlaced, hasCeaId, ceaId, hasTvFormat,
+                          tvFormat, hasPsfId, psfId, &timing)) {
     return 1;
   }
+  // The formulas round the width to their cell granularity, the desktop size follows the computed timing.
+  NV_CUSTOM_DISPLAY custom = {};
+  FillCustomDisplay(hasFormula ? 0 : width, hasFormula ? 0 : height, depth, hwOnly, timing, &custom);
 
   double actualRefresh = TimingRefreshHz(custom.timing);
-  std::printf("Custom display try: %ux%u@%.3fHz depth=%u type=%s interlaced=%u hwOnly=%u\n", custom.width,
-              custom.height, actualRefresh, depth, TimingOverrideName(type), interlaced ? 1 : 0, hwOnly ? 1 : 0);
+  Printf("Custom display try: %ux%u@%.3fHz depth=%u type=%s interlaced=%u hwOnly=%u\n", custom.width, custom.height,
+         actualRefresh, depth, hasFormula ? TimingFormulaName(formula) : TimingOverrideName(type), interlaced ? 1 : 0,
+         hwOnly ? 1 : 0);
 
   NvU32 displayIds[1] = {displayId};
-  NvAPI_Status status = NvAPI_DISP_TryCustomDisplay(displayIds, 1, &custom);
+  NvAPI_Status status = NvApi().NvAPI_DISP_TryCustomDisplay(displayIds, 1, &custom);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_TryCustomDisplay failed", status);
     return 1;
   }
 
-  std::printf("Custom display applied (trial).\n");
+  Printf("Custom display applied (trial).\n");
   return 0;
 }
 
@@ -370,7 +596,7 @@ int CmdDisplayCustomSave(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -379,7 +605,7 @@ int CmdDisplayCustomSave(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--output-only") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &outputOnly)) {
-        std::printf("Invalid --output-only value.\n");
+        Printf("Invalid --output-only value.\n");
         return 1;
       }
       ++i;
@@ -387,31 +613,32 @@ int CmdDisplayCustomSave(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--monitor-only") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &monitorOnly)) {
-        std::printf("Invalid --monitor-only value.\n");
+        Printf("Invalid --monitor-only value.\n");
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
+  if (RefuseStuckDisplay(displayId)) { return 1; }
 
-  std::printf("Custom display save: outputOnly=%u monitorOnly=%u\n", outputOnly ? 1 : 0, monitorOnly ? 1 : 0);
+  Printf("Custom display save: outputOnly=%u monitorOnly=%u\n", outputOnly ? 1 : 0, monitorOnly ? 1 : 0);
 
   NvU32 displayIds[1] = {displayId};
-  NvAPI_Status status = NvAPI_DISP_SaveCustomDisplay(displayIds, 1, outputOnly ? 1 : 0, monitorOnly ? 1 : 0);
+  NvAPI_Status status = NvApi().NvAPI_DISP_SaveCustomDisplay(displayIds, 1, outputOnly ? 1 : 0, monitorOnly ? 1 : 0);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_SaveCustomDisplay failed", status);
     return 1;
   }
 
-  std::printf("Custom display saved.\n");
+  Printf("Custom display saved.\n");
   return 0;
 }
 
@@ -424,7 +651,7 @@ int CmdDisplayCustomDelete(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -433,41 +660,41 @@ int CmdDisplayCustomDelete(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid --index value.\n");
+        Printf("Invalid --index value.\n");
         return 1;
       }
       hasIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId || !hasIndex) {
-    std::printf("Missing required --id and --index\n");
+    Printf("Missing required --id and --index\n");
     return 1;
   }
 
   NV_CUSTOM_DISPLAY custom = {};
   custom.version = NV_CUSTOM_DISPLAY_VER;
-  NvAPI_Status status = NvAPI_DISP_EnumCustomDisplay(displayId, index, &custom);
+  NvAPI_Status status = NvApi().NvAPI_DISP_EnumCustomDisplay(displayId, index, &custom);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_EnumCustomDisplay failed", status);
     return 1;
   }
 
-  std::printf("Custom display delete index=%u:\n", index);
+  Printf("Custom display delete index=%u:\n", index);
   PrintCustomDisplay(custom, index);
 
   NvU32 displayIds[1] = {displayId};
-  status = NvAPI_DISP_DeleteCustomDisplay(displayIds, 1, &custom);
+  status = NvApi().NvAPI_DISP_DeleteCustomDisplay(displayIds, 1, &custom);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_DeleteCustomDisplay failed", status);
     return 1;
   }
 
-  std::printf("Custom display deleted.\n");
+  Printf("Custom display deleted.\n");
   return 0;
 }
 
@@ -478,35 +705,271 @@ int CmdDisplayCustomRevert(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
+  if (RefuseStuckDisplay(displayId)) { return 1; }
 
-  std::printf("Custom display revert trial for 0x%08X.\n", displayId);
+  Printf("Custom display revert trial for 0x%08X.\n", displayId);
 
   NvU32 displayIds[1] = {displayId};
-  NvAPI_Status status = NvAPI_DISP_RevertCustomDisplayTrial(displayIds, 1);
+  NvAPI_Status status = NvApi().NvAPI_DISP_RevertCustomDisplayTrial(displayIds, 1);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_RevertCustomDisplayTrial failed", status);
     return 1;
   }
 
-  std::printf("Custom display trial reverted.\n");
+  Printf("Custom display trial reverted.\n");
   return 0;
 }
 
+int CmdDisplayCustomSweep(int argc, char **argv) {
+  NvU32 displayId = 0;
+  bool hasDisplayId = false;
+  std::vector<TimingMode> modes;
+  const char *modesPath = nullptr;
+  const char *journalPath = nullptr;
+  bool resume = false;
+  TimingFormula formula = kTimingCvtRb;
+  bool interlaced = false;
+  NvU32 depth = 0;
+  NvU32 settleMs = 1000;
+  NvU32 timeoutMs = 10000;
+
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--id") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
+        Printf("Invalid display id.\n");
+        return 1;
+      }
+      hasDisplayId = true;
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--mode") == 0) {
+      if (i + 1 >= argc || !ParseTimingModeSpec(argv[i + 1], &modes)) {
+        Printf("Invalid --mode value, expected WxH@R or WxH@R1-R2:STEP.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--modes") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --modes\n");
+        return 1;
+      }
+      modesPath = argv[++i];
+      continue;
+    }
+    if (std::strcmp(argv[i], "--journal") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --journal\n");
+        return 1;
+      }
+      journalPath = argv[++i];
+      continue;
+    }
+    if (std::strcmp(argv[i], "--resume") == 0) {
+      resume = true;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--formula") == 0) {
+      if (i + 1 >= argc || !ParseTimingFormula(argv[i + 1], &formula)) {
+        Printf("Invalid --formula value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--interlaced") == 0) {
+      if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &interlaced)) {
+        Printf("Invalid --interlaced value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--depth") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &depth)) {
+        Printf("Invalid --depth value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--settle") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &settleMs)) {
+        Printf("Invalid --settle value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--timeout") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &timeoutMs) || timeoutMs == 0) {
+        Printf("Invalid --timeout value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+
+  if (modesPath && !ReadTimingModesFile(modesPath, &modes)) { return 1; }
+  if (resume && !journalPath) {
+    Printf("--resume needs --journal\n");
+    return 1;
+  }
+  if (modes.empty() && !journalPath) {
+    Printf("Missing required --mode or --modes\n");
+    return 1;
+  }
+  if (!modes.empty() && !hasDisplayId) {
+    Printf("Missing required --id\n");
+    return 1;
+  }
+
+  if (hasDisplayId && RefuseStuckDisplay(displayId)) { return 1; }
+
+  // Trials an interrupted run left behind are reverted before anything else, with only --journal that is all it does.
+  SweepJournal journal;
+  if (journalPath) {
+    if (!journal.Open(journalPath)) { return 1; }
+    for (NvU32 pending : journal.Pending()) {
+      Printf("Reverting trial left on 0x%08X by an interrupted sweep\n", pending);
+      if (!SweepRevert(pending, timeoutMs, &journal)) { return 1; }
+    }
+    if (modes.empty()) { return 0; }
+  }
+
+  journal.Write("sweep 0x%08X %s %u", displayId, TimingFormulaName(formula), static_cast<NvU32>(modes.size()));
+  g_sweepStop = false;
+  SetConsoleCtrlHandler(SweepCtrlHandler, TRUE);
+  if (!StructuredOutput()) { Printf("%-22s %-10s %s\n", "mode", "result", "detail"); }
+
+  NvU32 passed = 0;
+  NvU32 failed = 0;
+  NvU32 skipped = 0;
+  bool aborted = false;
+  bool hung = false;
+  for (const TimingMode &mode : modes) {
+    if (g_sweepStop) { break; }
+    const std::string key = SweepModeKey(mode);
+    if (resume && journal.Done(displayId, key)) {
+      ++skipped;
+      continue;
+    }
+
+    NV_TIMING timing = {};
+    NV_TIMING applied = {};
+    const char *result = "pass";
+    std::string detail;
+    bool tried = false;
+    if (!ComputeTiming(formula, mode.width, mode.height, mode.refreshHz, interlaced, &timing)) {
+      result = "invalid";
+      detail = std::string(TimingFormulaName(formula)) + " cannot produce this mode";
+    } else {
+      NV_CUSTOM_DISPLAY custom = {};
+      FillCustomDisplay(0, 0, depth, false, timing, &custom);
+      journal.Write("try 0x%08X %s", displayId, key.c_str());
+      tried = true;
+      NvAPI_Status status = NVAPI_OK;
+      if (!CallWithTimeout(timeoutMs, [displayId, custom]() mutable {
+            NvU32 displayIds[1] = {displayId};
+            return NvApi().NvAPI_DISP_TryCustomDisplay(displayIds, 1, &custom);
+          }, &status)) {
+        result = "timeout";
+        detail = "NvAPI_DISP_TryCustomDisplay did not return";
+        aborted = true;
+        hung = true;
+      } else if (status != NVAPI_OK) {
+        result = "rejected";
+        detail = NvapiStatusString(status);
+      } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(settleMs));
+        if (FindAppliedTiming(displayId, timing, &applied, &detail)) {
+          char text[64];
+          std::snprintf(text, sizeof(text), "%.3f Hz pclk=%.2f MHz", TimingRefreshHz(applied), applied.pclk / 100.0);
+          detail = text;
+        } else {
+          result = "mismatch";
+        }
+      }
+    }
+
+    if (std::strcmp(result, "pass") == 0) {
+      ++passed;
+    } else {
+      ++failed;
+    }
+    journal.Write("result 0x%08X %s %s", displayId, key.c_str(), result);
+    if (StructuredOutput()) {
+      RecordWriter record("custom_sweep");
+      record.Hex("display_id", displayId)
+          .Field("width", mode.width)
+          .Field("height", mode.height)
+          .Field("requested_hz", mode.refreshHz)
+          .Field("formula", TimingFormulaName(formula))
+          .Field("result", result);
+      if (timing.pclk) {
+        record.Field("pclk_khz", static_cast<NvU32>(timing.pclk) * 10);
+      } else {
+        record.Null("pclk_khz");
+      }
+      if (applied.pclk) {
+        record.Field("applied_hz", TimingRefreshHz(applied))
+            .Field("applied_pclk_khz", static_cast<NvU32>(applied.pclk) * 10);
+      } else {
+        record.Null("applied_hz").Null("applied_pclk_khz");
+      }
+      record.Field("detail", detail);
+    } else {
+      Printf("%-22s %-10s %s\n", key.c_str(), result, detail.c_str());
+    }
+
+    // A rejected try can still leave a partial trial, so every attempt is reverted. When the revert itself does not
+    // complete the display state is unknown and the sweep stops, the journal keeps the pending trial. A try that is
+    // still running is not reverted at all, see BlockStuckDisplay.
+    if (tried && !hung && !SweepRevert(displayId, timeoutMs, &journal)) { aborted = true; }
+    if (aborted) { break; }
+  }
+  SetConsoleCtrlHandler(SweepCtrlHandler, FALSE);
+
+  const bool interrupted = g_sweepStop && !aborted;
+  const NvU32 total = static_cast<NvU32>(modes.size());
+  if (StructuredOutput()) {
+    RecordWriter record("custom_sweep_summary");
+    record.Hex("display_id", displayId)
+        .Field("modes", total)
+        .Field("passed", passed)
+        .Field("failed", failed)
+        .Field("skipped", skipped)
+        .Field("not_run", total - passed - failed - skipped)
+        .Field("aborted", aborted)
+        .Field("interrupted", interrupted);
+  } else {
+    Printf("%u modes: %u pass, %u fail, %u skipped, %u not run%s\n", total, passed, failed, skipped,
+           total - passed - failed - skipped, aborted ? " (aborted)" : interrupted ? " (interrupted)" : "");
+  }
+  if (hung) { BlockStuckDisplay(displayId, journal.IsOpen()); }
+  return aborted || interrupted ? 1 : 0;
+}
+
 int CmdDisplayCustom(int argc, char **argv) {
   if (argc < 1) {
     PrintUsageGroup("display");
@@ -518,8 +981,11 @@ int CmdDisplayCustom(int argc, char **argv) {
   if (std::strcmp(argv[0], "save") == 0) { return CmdDisplayCustomSave(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "delete") == 0) { return CmdDisplayCustomDelete(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "revert") == 0) { return CmdDisplayCustomRevert(argc - 1, argv + 1); }
+  if (std::strcmp(argv[0], "calc") == 0) { return CmdDisplayCustomCalc(argc - 1, argv + 1); }
+  if (std::strcmp(argv[0], "validate") == 0) { return CmdDisplayCustomValidate(argc - 1, argv + 1); }
+  if (std::strcmp(argv[0], "sweep") == 0) { return CmdDisplayCustomSweep(argc - 1, argv + 1); }
 
-  std::printf("Unknown display custom subcommand: %s\n", argv[0]);
+  Printf("Unknown display custom subcommand: %s\n", argv[0]);
   return 1;
 }
 } // namespace nvcli
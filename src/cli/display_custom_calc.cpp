@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/edid.h"
+#include "cli/timing_calc.h"
+#include "cli/topology.h"
+
+#include <cmath>
+
+namespace nvcli {
+namespace {
+// Lanes and per-lane Gbps of the HF-VSDB Max_FRL_Rate codes 1..6.
+constexpr NvU32 kFrlLanes[] = {0, 3, 3, 4, 4, 4, 4};
+constexpr NvU32 kFrlLaneMbps[] = {0, 3000, 6000, 6000, 8000, 10000, 12000};
+
+// Range limits, max pixel clock and the HDMI link from a decoded EDID. DP links are not described in the EDID.
+void LimitsFromEdid(const EdidInfo &info, TimingLimits *limits) {
+  if (info.hasRangeLimits) {
+    limits->hasRange = true;
+    limits->minVHz = info.rangeMinVHz;
+    limits->maxVHz = info.rangeMaxVHz;
+    limits->minHKhz = info.rangeMinHKhz;
+    limits->maxHKhz = info.rangeMaxHKhz;
+    limits->maxPixelClockKhz = static_cast<NvU32>(info.rangeMaxPixelClockMhz) * 1000;
+  }
+  if (info.hdmiForum && info.maxFrlRate > 0 && info.maxFrlRate < sizeof(kFrlLanes) / sizeof(kFrlLanes[0])) {
+    limits->link = kTimingLinkFrl;
+    limits->lanes = kFrlLanes[info.maxFrlRate];
+    limits->laneMbps = kFrlLaneMbps[info.maxFrlRate];
+    return;
+  }
+  const NvU16 maxTmdsMhz = info.hfMaxTmdsMhz ? info.hfMaxTmdsMhz : info.hdmiMaxTmdsMhz;
+  if (info.hdmi && maxTmdsMhz) {
+    limits->link = kTimingLinkTmds;
+    limits->maxTmdsKhz = static_cast<NvU32>(maxTmdsMhz) * 1000;
+  }
+}
+
+bool DecodeLimitsEdid(const std::vector<NvU8> &data, TimingLimits *limits) {
+  EdidInfo info;
+  if (!DecodeEdid(data.data(), static_cast<NvU32>(data.size()), &info)) {
+    Printf("Not an EDID: %u bytes without a valid base block header\n", static_cast<NvU32>(data.size()));
+    return false;
+  }
+  LimitsFromEdid(info, limits);
+  return true;
+}
+
+// The EDID of the display plus the DP link the GPU trained, which replaces the HDMI link of the EDID when present.
+bool LoadLiveLimits(NvU32 displayId, TimingLimits *limits) {
+  std::vector<NvU8> data(NV_EDID_DATA_SIZE_MAX, 0);
+  NvU32 size = NV_EDID_DATA_SIZE_MAX;
+  NV_EDID_FLAG flag = NV_EDID_FLAG_DEFAULT;
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetEdidEx2(displayId, &flag, data.data(), &size);
+  if (status != NVAPI_OK) {
+    PrintNvapiError("NvAPI_GPU_GetEdidEx2 failed", status);
+    return false;
+  }
+  data.resize(std::min<NvU32>(size, NV_EDID_DATA_SIZE_MAX));
+  if (!DecodeLimitsEdid(data, limits)) { return false; }
+
+  TopologyDisplay display = {};
+  const bool hasHandle = Topology().DisplayById(displayId, &display) && display.hasOutputId;
+  NV_DISPLAY_PORT_INFO dp = {};
+  dp.version = NV_DISPLAY_PORT_INFO_VER;
+  status = NvApi().NvAPI_GetDisplayPortInfo(hasHandle ? display.handle : NULL,
+                                            hasHandle ? display.outputId : displayId, &dp);
+  if (status == NVAPI_OK && dp.isDp && dp.maxLaneCount && dp.maxLinkRate) {
+    limits->link = kTimingLinkDp;
+    limits->lanes = static_cast<NvU32>(dp.maxLaneCount);
+    limits->laneMbps = static_cast<NvU32>(dp.maxLinkRate) * 270;
+  }
+  return true;
+}
+
+void PrintTimingText(TimingFormula formula, const NV_TIMING &timing) {
+  const bool interlaced = timing.interlaced == NV_TIMING_INTERLACED;
+  const NvU32 fields = interlaced ? 2 : 1;
+  const NvU32 hBack = timing.HTotal - timing.HVisible - timing.HFrontPorch - timing.HSyncWidth;
+  const NvU32 vBack = (timing.VTotal - timing.VVisible) / fields - timing.VFrontPorch - timing.VSyncWidth;
+  Printf("%s %ux%u@%.3f Hz %s (%s)\n", TimingFormulaName(formula), timing.HVisible, timing.VVisible,
+         TimingRefreshHz(timing), interlaced ? "interlaced" : "progressive", timing.etc.name);
+  Printf("  pclk: %.2f MHz hfreq: %.3f kHz\n", timing.pclk / 100.0, timing.pclk * 10.0 / timing.HTotal);
+  Printf("  H: active=%u front=%u sync=%u back=%u total=%u sync=%c\n", timing.HVisible, timing.HFrontPorch,
+         timing.HSyncWidth, hBack, timing.HTotal, timing.HSyncPol == NV_TIMING_H_SYNC_POSITIVE ? '+' : '-');
+  Printf("  V: active=%u front=%u sync=%u back=%u total=%u sync=%c\n", timing.VVisible, timing.VFrontPorch,
+         timing.VSyncWidth, vBack, timing.VTotal, timing.VSyncPol == NV_TIMING_V_SYNC_POSITIVE ? '+' : '-');
+}
+
+void PrintTimingRecord(TimingFormula formula, const NV_TIMING &timing) {
+  RecordWriter record("timing_calc");
+  record.Field("formula", TimingFormulaName(formula))
+      .Field("width", static_cast<NvU32>(timing.HVisible))
+      .Field("height", static_cast<NvU32>(timing.VVisible))
+      .Field("interlaced", timing.interlaced == NV_TIMING_INTERLACED)
+      .Field("refresh_hz", TimingRefreshHz(timing))
+      .Field("pclk_khz", static_cast<NvU32>(timing.pclk) * 10)
+      .Field("h_front_porch", static_cast<NvU32>(timing.HFrontPorch))
+      .Field("h_sync", static_cast<NvU32>(timing.HSyncWidth))
+      .Field("h_total", static_cast<NvU32>(timing.HTotal))
+      .Field("h_sync_positive", timing.HSyncPol == NV_TIMING_H_SYNC_POSITIVE)
+      .Field("v_front_porch", static_cast<NvU32>(timing.VFrontPorch))
+      .Field("v_sync", static_cast<NvU32>(timing.VSyncWidth))
+      .Field("v_total", static_cast<NvU32>(timing.VTotal))
+      .Field("v_sync_positive", timing.VSyncPol == NV_TIMING_V_SYNC_POSITIVE)
+      .Field("name", reinterpret_cast<const char *>(timing.etc.name));
+}
+
+void PrintLimits(const TimingLimits &limits, NvU32 bpc) {
+  if (StructuredOutput()) {
+    RecordWriter record("timing_limits");
+    record.Field("max_pclk_khz", limits.maxPixelClockKhz).Field("has_range", limits.hasRange);
+    if (limits.hasRange) {
+      record.Field("min_v_hz", static_cast<NvU32>(limits.minVHz))
+          .Field("max_v_hz", static_cast<NvU32>(limits.maxVHz))
+          .Field("min_h_khz", static_cast<NvU32>(limits.minHKhz))
+          .Field("max_h_khz", static_cast<NvU32>(limits.maxHKhz));
+    }
+    record.Field("link", DescribeTimingLink(limits)).Field("link_capacity", TimingLinkCapacity(limits));
+    record.Field("bpc", bpc);
+    return;
+  }
+  Printf("Limits: pclk ");
+  if (limits.maxPixelClockKhz) {
+    Printf("<= %.3f MHz", limits.maxPixelClockKhz / 1000.0);
+  } else {
+    Printf("unchecked");
+  }
+  if (limits.hasRange) {
+    Printf(", V %u-%u Hz, H %u-%u kHz", limits.minVHz, limits.maxVHz, limits.minHKhz, limits.maxHKhz);
+  }
+  Printf(", link %s, %u bpc\n", DescribeTimingLink(limits).c_str(), bpc);
+}
+} // namespace
+
+int CmdDisplayCustomCalc(int argc, char **argv) {
+  NvU32 width = 0;
+  NvU32 height = 0;
+  double refresh = 0.0;
+  bool interlaced = false;
+  bool allFormulas = false;
+  TimingFormula formula = kTimingCvtRb;
+
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--width") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &width)) {
+        Printf("Invalid --width value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--height") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &height)) {
+        Printf("Invalid --height value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--refresh") == 0) {
+      if (i + 1 >= argc || !ParseDoubleValue(argv[i + 1], &refresh)) {
+        Printf("Invalid --refresh value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--type") == 0) {
+      if (i + 1 < argc && std::strcmp(argv[i + 1], "all") == 0) {
+        allFormulas = true;
+      } else if (i + 1 >= argc || !ParseTimingFormula(argv[i + 1], &formula)) {
+        Printf("Invalid --type value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--interlaced") == 0) {
+      if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &interlaced)) {
+        Printf("Invalid --interlaced value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+
+  if (width == 0 || height == 0 || refresh <= 0.0) {
+    Printf("Missing required --width, --height and --refresh\n");
+    return 1;
+  }
+
+  const NvU8 first = allFormulas ? kTimingCvt : formula;
+  const NvU8 last = allFormulas ? kTimingGtf : formula;
+  int result = 0;
+  for (NvU8 i = first; i <= last; ++i) {
+    const TimingFormula current = static_cast<TimingFormula>(i);
+    NV_TIMING timing = {};
+    if (!ComputeTiming(current, width, height, refresh, interlaced, &timing)) {
+      Printf("%s cannot produce %ux%u@%.3f Hz\n", TimingFormulaName(current), width, height, refresh);
+      result = 1;
+      continue;
+    }
+    if (StructuredOutput()) {
+      PrintTimingRecord(current, timing);
+    } else {
+      PrintTimingText(current, timing);
+    }
+  }
+  return result;
+}
+
+int CmdDisplayCustomValidate(int argc, char **argv) {
+  NvU32 displayId = 0;
+  bool hasDisplayId = false;
+  const char *edidPath = nullptr;
+  const char *modesPath = nullptr;
+  const char *linkSpec = nullptr;
+  double maxPclkMhz = 0.0;
+  NvU32 bpc = 8;
+  bool interlaced = false;
+  TimingFormula formula = kTimingCvtRb;
+  std::vector<TimingMode> candidates;
+
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--id") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
+        Printf("Invalid display id.\n");
+        return 1;
+      }
+      hasDisplayId = true;
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--edid") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --edid\n");
+        return 1;
+      }
+      edidPath = argv[++i];
+      continue;
+    }
+    if (std::strcmp(argv[i], "--mode") == 0) {
+      if (i + 1 >= argc || !ParseTimingModeSpec(argv[i + 1], &candidates)) {
+        Printf("Invalid --mode value, expected WxH@R or WxH@R1-R2:STEP.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--modes") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --modes\n");
+        return 1;
+      }
+      modesPath = argv[++i];
+      continue;
+    }
+    if (std::strcmp(argv[i], "--link") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --link\n");
+        return 1;
+      }
+      linkSpec = argv[++i];
+      continue;
+    }
+    if (std::strcmp(argv[i], "--max-pclk") == 0) {
+      if (i + 1 >= argc || !ParseDoubleValue(argv[i + 1], &maxPclkMhz) || maxPclkMhz <= 0.0) {
+        Printf("Invalid --max-pclk value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--bpc") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &bpc) || bpc < 6 || bpc > 16) {
+        Printf("Invalid --bpc value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--type") == 0) {
+      if (i + 1 >= argc || !ParseTimingFormula(argv[i + 1], &formula)) {
+        Printf("Invalid --type value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--interlaced") == 0) {
+      if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &interlaced)) {
+        Printf("Invalid --interlaced value.\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+
+  if (hasDisplayId && edidPath) {
+    Printf("Use either --id or --edid, not both\n");
+    return 1;
+  }
+  if (modesPath && !ReadTimingModesFile(modesPath, &candidates)) { return 1; }
+  if (candidates.empty()) {
+    Printf("Missing required --mode or --modes\n");
+    return 1;
+  }
+
+  // Explicit --link and --max-pclk override what the EDID and the DP info report.
+  TimingLimits limits = {};
+  if (hasDisplayId && !LoadLiveLimits(displayId, &limits)) { return 1; }
+  if (edidPath) {
+    std::vector<NvU8> data;
+    if (!ReadEdidFile(edidPath, &data) || !DecodeLimitsEdid(data, &limits)) { return 1; }
+  }
+  if (linkSpec && !ParseTimingLink(linkSpec, &limits)) {
+    Printf("Invalid --link value, expected dp:LANES:GBPS, frl:LANES:GBPS or tmds:MHZ.\n");
+    return 1;
+  }
+  if (maxPclkMhz > 0.0) { limits.maxPixelClockKhz = static_cast<NvU32>(std::lround(maxPclkMhz * 1000.0)); }
+  PrintLimits(limits, bpc);
+
+  NvU32 passed = 0;
+  NvU32 failed = 0;
+  std::vector<std::string> problems;
+  for (const TimingMode &candidate : candidates) {
+    NV_TIMING timing = {};
+    problems.clear();
+    const bool computed =
+        ComputeTiming(formula, candidate.width, candidate.height, candidate.refreshHz, interlaced, &timing);
+    if (!computed) {
+      problems.push_back(std::string(TimingFormulaName(formula)) + " cannot produce this mode");
+    } else {
+      ValidateTiming(timing, bpc, limits, &problems);
+    }
+    const bool ok = problems.empty();
+    if (ok) {
+      ++passed;
+    } else {
+      ++failed;
+    }
+
+    std::string joined;
+    for (const auto &problem : problems) {
+      if (!joined.empty()) { joined += "; "; }
+      joined += problem;
+    }
+    if (StructuredOutput()) {
+      RecordWriter record("timing_candidate");
+      record.Field("width", candidate.width)
+          .Field("height", candidate.height)
+          .Field("requested_hz", candidate.refreshHz)
+          .Field("formula", TimingFormulaName(formula))
+          .Field("interlaced", interlaced);
+      if (computed) {
+        record.Field("refresh_hz", TimingRefreshHz(timing))
+            .Field("pclk_khz", static_cast<NvU32>(timing.pclk) * 10)
+            .Field("h_total", static_cast<NvU32>(timing.HTotal))
+            .Field("v_total", static_cast<NvU32>(timing.VTotal))
+            .Field("link_load", TimingLinkLoad(timing, bpc, limits.link));
+      } else {
+        record.Null("refresh_hz").Null("pclk_khz").Null("h_total").Null("v_total").Null("link_load");
+      }
+      record.Field("ok", ok).Field("problems", joined);
+      continue;
+    }
+    if (!computed) {
+      Printf("  %ux%u@%.3f %s\n", candidate.width, candidate.height, candidate.refreshHz, joined.c_str());
+      continue;
+    }
+    Printf("  %ux%u@%.3f pclk=%.2f MHz total=%ux%u %s%s\n", candidate.width, candidate.height, candidate.refreshHz,
+           timing.pclk / 100.0, timing.HTotal, timing.VTotal, ok ? "ok" : "FAIL: ", joined.c_str());
+  }
+
+  if (StructuredOutput()) {
+    RecordWriter record("timing_validate_summary");
+    record.Field("formula", TimingFormulaName(formula))
+        .Field("candidates", static_cast<NvU32>(candidates.size()))
+        .Field("passed", passed)
+        .Field("failed", failed);
+  } else {
+    Printf("%u candidates (%s): %u pass, %u fail\n", static_cast<NvU32>(candidates.size()), TimingFormulaName(formula),
+           passed, failed);
+  }
+  return 0;
+}
+} // namespace nvcli
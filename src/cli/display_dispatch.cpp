@@ -33,6 +33,7 @@ int CmdDisplay(int argc, char **argv) {
       {"ids", CmdDisplayIds},
       {"edid", CmdDisplayEdid},
       {"timing", CmdDisplayTiming},
+      {"snapshot", CmdDisplaySnapshot},
       {"get", CmdDisplayGet},
       {"set", CmdDisplaySet},
       {"custom", CmdDisplayCustom},
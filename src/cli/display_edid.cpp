@@ -4,8 +4,244 @@
  */
 
 #include "cli/commands.h"
+#include "cli/edid.h"
+
+#include <algorithm>
 
 namespace nvcli {
+namespace {
+const char *const kEdidInterfaceNames[] = {"undefined", "DVI", "HDMI-a", "HDMI-b", "MDDI", "DisplayPort"};
+const char *const kEdidSourceNames[] = {"base", "cta", "displayid"};
+const char *const kEdidEotfNames[] = {"SDR", "HDR-gamma", "PQ", "HLG"};
+const char *const kEdidColorimetryNames[] = {"xvYCC601",   "xvYCC709",  "sYCC601",   "opYCC601", "opRGB",
+                                             "BT2020cYCC", "BT2020YCC", "BT2020RGB", "ICtCp",    "DCI-P3"};
+const char *const kEdidFrlNames[] = {"none", "3G x3", "6G x3", "6G x4", "8G x4", "10G x4", "12G x4"};
+const char *const kEdidDscSliceNames[] = {"none",        "1 @340MHz",   "2 @340MHz",  "4 @340MHz",
+                                          "8 @340MHz",   "8 @400MHz",   "12 @400MHz", "16 @400MHz"};
+// Established timings indexed by bit, byte 0x23 is bits 23..16 and byte 0x25 bits 7..0.
+const char *const kEdidEstablishedNames[] = {
+    nullptr,        nullptr,       nullptr,       nullptr,      nullptr,       nullptr,
+    nullptr,        "1152x870@75", "1280x1024@75", "1024x768@75", "1024x768@70", "1024x768@60",
+    "1024x768@87i", "832x624@75",  "800x600@75",  "800x600@72",  "800x600@60",  "800x600@56",
+    "640x480@75",   "640x480@72",  "640x480@67",  "640x480@60",  "720x400@88",  "720x400@70"};
+
+template <size_t N> const char *EdidName(const char *const (&names)[N], NvU32 index) {
+  return index < N ? names[index] : "reserved";
+}
+
+std::string EdidMaskNames(NvU32 mask, const char *const *names, NvU32 count) {
+  std::string out;
+  for (NvU32 bit = 0; bit < count; ++bit) {
+    if (!(mask & (1u << bit)) || !names[bit]) { continue; }
+    if (!out.empty()) { out += ' '; }
+    out += names[bit];
+  }
+  return out;
+}
+
+std::string EdidVicList(const std::vector<NvU8> &vics, NvU8 native) {
+  std::string out;
+  char text[16];
+  for (NvU8 vic : vics) {
+    std::snprintf(text, sizeof(text), "%s%u%s", out.empty() ? "" : " ", vic, vic == native ? "*" : "");
+    out += text;
+  }
+  return out;
+}
+
+std::string EdidPhysicalAddress(NvU16 address) {
+  char text[16];
+  std::snprintf(text, sizeof(text), "%u.%u.%u.%u", address >> 12, (address >> 8) & 0xF, (address >> 4) & 0xF,
+                address & 0xF);
+  return text;
+}
+
+void PrintEdidRecords(const EdidInfo &info) {
+  char version[8];
+  std::snprintf(version, sizeof(version), "%u.%u", info.version, info.revision);
+  RecordWriter record("edid_info");
+  record.Field("manufacturer", info.manufacturer)
+      .Hex("product", info.productCode, 4)
+      .Field("serial", info.serialNumber)
+      .Field("name", info.name)
+      .Field("serial_text", info.serialText)
+      .Field("week", static_cast<NvU32>(info.week))
+      .Field("year", static_cast<NvU32>(info.year))
+      .Field("version", version)
+      .Field("digital", info.digital)
+      .Field("bit_depth", static_cast<NvU32>(info.bitDepth))
+      .Field("interface", EdidName(kEdidInterfaceNames, info.interfaceType))
+      .Field("width_cm", static_cast<NvU32>(info.widthCm))
+      .Field("height_cm", static_cast<NvU32>(info.heightCm))
+      .Field("extensions", static_cast<NvU32>(info.extensionCount))
+      .Field("cta_revision", static_cast<NvU32>(info.ctaRevision))
+      .Field("vics", EdidVicList(info.vics, info.nativeVic))
+      .Field("hdmi", info.hdmi)
+      .Field("hdmi_forum", info.hdmiForum)
+      .Field("max_tmds_mhz", static_cast<NvU32>(info.hfMaxTmdsMhz ? info.hfMaxTmdsMhz : info.hdmiMaxTmdsMhz))
+      .Field("max_frl", EdidName(kEdidFrlNames, info.maxFrlRate))
+      .Field("hdr_eotf", EdidMaskNames(info.eotfMask, kEdidEotfNames, 4))
+      .Field("hdr_max_nits", EdidMaxLuminance(info.maxLuminanceCode))
+      .Field("hdr_max_frame_avg_nits", EdidMaxLuminance(info.maxFrameAverageCode))
+      .Field("hdr_min_nits", EdidMinLuminance(info.maxLuminanceCode, info.minLuminanceCode))
+      .Field("colorimetry", EdidMaskNames(info.colorimetryMask, kEdidColorimetryNames, 10))
+      .Field("dsc", info.dsc)
+      .Field("dsc_max_slices", EdidName(kEdidDscSliceNames, info.dscMaxSlicesCode))
+      .Field("dsc_max_frl", EdidName(kEdidFrlNames, info.dscMaxFrlRate))
+      .Field("dsc_total_chunk_kbytes", static_cast<NvU32>(info.dscTotalChunkKBytes))
+      .Field("displayid_version", static_cast<NvU32>(info.displayIdVersion))
+      .Field("tiles_h", static_cast<NvU32>(info.tiled ? info.tilesH : 0))
+      .Field("tiles_v", static_cast<NvU32>(info.tiled ? info.tilesV : 0));
+  record.End();
+
+  for (size_t i = 0; i < info.timings.size(); ++i) {
+    const EdidTiming &timing = info.timings[i];
+    RecordWriter("edid_timing")
+        .Field("index", static_cast<NvU32>(i))
+        .Field("source", EdidName(kEdidSourceNames, timing.source))
+        .Field("width", static_cast<NvU32>(timing.hActive))
+        .Field("height", static_cast<NvU32>(timing.vActive))
+        .Field("refresh_hz", EdidTimingRefreshHz(timing))
+        .Field("pixel_clock_khz", timing.pixelClockKhz)
+        .Field("h_front_porch", static_cast<NvU32>(timing.hFrontPorch))
+        .Field("h_sync", static_cast<NvU32>(timing.hSync))
+        .Field("h_blank", static_cast<NvU32>(timing.hBlank))
+        .Field("v_front_porch", static_cast<NvU32>(timing.vFrontPorch))
+        .Field("v_sync", static_cast<NvU32>(timing.vSync))
+        .Field("v_blank", static_cast<NvU32>(timing.vBlank))
+        .Field("interlaced", timing.interlaced)
+        .Field("preferred", timing.preferred);
+  }
+  for (const auto &range : info.vrr) {
+    RecordWriter("edid_vrr")
+        .Field("source", range.source)
+        .Field("min_hz", static_cast<NvU32>(range.minHz))
+        .Field("max_hz", static_cast<NvU32>(range.maxHz));
+  }
+  for (const auto &problem : info.problems) { RecordWriter("edid_problem").Field("message", problem); }
+}
+
+void PrintEdidInfo(const EdidInfo &info) {
+  if (StructuredOutput()) {
+    PrintEdidRecords(info);
+    return;
+  }
+
+  Printf("Monitor: %s 0x%04X \"%s\" serial=%u", info.manufacturer.c_str(), info.productCode, info.name.c_str(),
+         info.serialNumber);
+  if (!info.serialText.empty()) { Printf(" \"%s\"", info.serialText.c_str()); }
+  Printf("\n");
+  if (info.modelYear) {
+    Printf("Made: model year %u, EDID %u.%u\n", info.year, info.version, info.revision);
+  } else {
+    Printf("Made: week %u %u, EDID %u.%u\n", info.week, info.year, info.version, info.revision);
+  }
+  Printf("Input: %s", info.digital ? "digital" : "analog");
+  if (info.bitDepth) { Printf(" %u bpc", info.bitDepth); }
+  if (info.interfaceType) { Printf(" %s", EdidName(kEdidInterfaceNames, info.interfaceType)); }
+  Printf(", %ux%u cm", info.widthCm, info.heightCm);
+  if (info.gamma100) { Printf(", gamma %.2f", info.gamma100 / 100.0); }
+  Printf("\n");
+  const NvU16 *c = info.chromaticity;
+  Printf("Chromaticity: R %.3f,%.3f G %.3f,%.3f B %.3f,%.3f W %.3f,%.3f\n", c[0] / 1024.0, c[1] / 1024.0,
+         c[2] / 1024.0, c[3] / 1024.0, c[4] / 1024.0, c[5] / 1024.0, c[6] / 1024.0, c[7] / 1024.0);
+  if (info.hasRangeLimits) {
+    Printf("Range limits: %u-%u Hz vertical, %u-%u kHz horizontal, max %u MHz\n", info.rangeMinVHz, info.rangeMaxVHz,
+           info.rangeMinHKhz, info.rangeMaxHKhz, info.rangeMaxPixelClockMhz);
+  }
+  if (info.establishedTimings) {
+    Printf("Established: %s\n", EdidMaskNames(info.establishedTimings, kEdidEstablishedNames, 24).c_str());
+  }
+  if (!info.standardTimings.empty()) {
+    Printf("Standard:");
+    for (const auto &timing : info.standardTimings) {
+      Printf(" %ux%u@%u", timing.width, timing.height, timing.refreshHz);
+    }
+    Printf("\n");
+  }
+
+  Printf("Timings: %zu\n", info.timings.size());
+  for (size_t i = 0; i < info.timings.size(); ++i) {
+    const EdidTiming &t = info.timings[i];
+    Printf("  [%zu] %ux%u%s %.3f Hz pclk=%.3f MHz h=%u/%u/%u v=%u/%u/%u %ch %cv", i, t.hActive, t.vActive,
+           t.interlaced ? "i" : "p", EdidTimingRefreshHz(t), t.pixelClockKhz / 1000.0, t.hFrontPorch, t.hSync,
+           t.hBlank, t.vFrontPorch, t.vSync, t.vBlank, t.hSyncPositive ? '+' : '-', t.vSyncPositive ? '+' : '-');
+    if (t.widthMm || t.heightMm) { Printf(" %ux%u mm", t.widthMm, t.heightMm); }
+    Printf(" %s%s\n", EdidName(kEdidSourceNames, t.source), t.preferred ? " preferred" : "");
+  }
+
+  if (info.hasCta) {
+    Printf("CTA-861 rev %u:%s%s%s%s, %u audio descriptors\n", info.ctaRevision, info.underscan ? " underscan" : "",
+           info.basicAudio ? " basic-audio" : "", info.ycbcr444 ? " ycbcr444" : "", info.ycbcr422 ? " ycbcr422" : "",
+           info.audioDescriptors);
+    if (!info.vics.empty()) { Printf("  VICs: %s\n", EdidVicList(info.vics, info.nativeVic).c_str()); }
+    if (!info.ycbcr420Vics.empty()) { Printf("  YCbCr 4:2:0 VICs: %s\n", EdidVicList(info.ycbcr420Vics, 0).c_str()); }
+    if (info.hdmi) {
+      Printf("  HDMI: physical address %s, max TMDS %u MHz\n", EdidPhysicalAddress(info.physicalAddress).c_str(),
+             info.hdmiMaxTmdsMhz);
+    }
+    if (info.hdmiForum) {
+      Printf("  HDMI Forum: max TMDS %u MHz, FRL %s%s%s\n", info.hfMaxTmdsMhz, EdidName(kEdidFrlNames, info.maxFrlRate),
+             info.scdc ? ", SCDC" : "", info.allm ? ", ALLM" : "");
+    }
+  }
+  if (info.hasHdrStaticMetadata) {
+    Printf("HDR: EOTF %s", EdidMaskNames(info.eotfMask, kEdidEotfNames, 4).c_str());
+    if (info.maxLuminanceCode) { Printf(", max %.1f nits", EdidMaxLuminance(info.maxLuminanceCode)); }
+    if (info.maxFrameAverageCode) {
+      Printf(", max frame-average %.1f nits", EdidMaxLuminance(info.maxFrameAverageCode));
+    }
+    if (info.minLuminanceCode) {
+      Printf(", min %.4f nits", EdidMinLuminance(info.maxLuminanceCode, info.minLuminanceCode));
+    }
+    Printf("%s\n", info.hasHdrDynamicMetadata ? ", dynamic metadata" : "");
+  }
+  if (info.colorimetryMask) {
+    Printf("Colorimetry: %s\n", EdidMaskNames(info.colorimetryMask, kEdidColorimetryNames, 10).c_str());
+  }
+  for (const auto &range : info.vrr) { Printf("VRR: %u-%u Hz (%s)\n", range.minHz, range.maxHz, range.source.c_str()); }
+  if (info.dsc) {
+    Printf("DSC 1.2:");
+    if (info.dscBpcMask & 1) { Printf(" 10bpc"); }
+    if (info.dscBpcMask & 2) { Printf(" 12bpc"); }
+    if (info.dscBpcMask & 4) { Printf(" 16bpc"); }
+    Printf("%s%s, max slices %s, FRL %s, total chunk %u KB\n", info.dscAllBpp ? " all-bpp" : "",
+           info.dscNative420 ? " native-420" : "", EdidName(kEdidDscSliceNames, info.dscMaxSlicesCode),
+           EdidName(kEdidFrlNames, info.dscMaxFrlRate), info.dscTotalChunkKBytes);
+  }
+  if (info.hasDisplayId) {
+    Printf("DisplayID %u.%u", info.displayIdVersion >> 4, info.displayIdVersion & 0xF);
+    if (info.tiled) {
+      Printf(": tiled %ux%u at %u,%u tile %ux%u", info.tilesH, info.tilesV, info.tileX, info.tileY, info.tileWidth,
+             info.tileHeight);
+    }
+    Printf("\n");
+  }
+  if (!info.problems.empty()) {
+    Printf("Problems:\n");
+    for (const auto &problem : info.problems) { Printf("  %s\n", problem.c_str()); }
+  }
+}
+} // namespace
+
+bool ReadEdidFile(const char *path, std::vector<NvU8> *out) {
+  FILE *file = nullptr;
+  if (fopen_s(&file, path, "rb") != 0 || !file) {
+    Printf("Failed to open %s\n", path);
+    return false;
+  }
+  out->assign(NV_EDID_DATA_SIZE_MAX + 1, 0);
+  const size_t read = std::fread(out->data(), 1, out->size(), file);
+  const bool failed = std::ferror(file) != 0;
+  std::fclose(file);
+  if (failed || read == 0 || read > NV_EDID_DATA_SIZE_MAX) {
+    Printf("%s: expected 1 to %u bytes of EDID data\n", path, NV_EDID_DATA_SIZE_MAX);
+    return false;
+  }
+  out->resize(read);
+  return true;
+}
+
 int CmdDisplayIds(int argc, char **argv) {
   NvU32 gpuIndex = 0;
   bool hasIndex = false;
@@ -17,69 +253,191 @@ int CmdDisplayIds(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, gpuIndex, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NvU32 count = 0;
     NvAPI_Status status = NVAPI_OK;
     if (all) {
-      status = NvAPI_GPU_GetAllDisplayIds(handles[i], NULL, &count);
+      status = NvApi().NvAPI_GPU_GetAllDisplayIds(handles[i], NULL, &count);
     } else {
-      status = NvAPI_GPU_GetConnectedDisplayIds(handles[i], NULL, &count, flags);
+      status = NvApi().NvAPI_GPU_GetConnectedDisplayIds(handles[i], NULL, &count, flags);
     }
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetDisplayIds failed", status);
-      continue;
+      return 0;
     }
     if (count == 0) {
-      std::printf("  No display IDs found.\n");
-      continue;
+      Printf("  No display IDs found.\n");
+      return 0;
     }
 
     std::vector<NV_GPU_DISPLAYIDS> displayIds(count);
     for (NvU32 j = 0; j < count; ++j) { displayIds[j].version = NV_GPU_DISPLAYIDS_VER; }
 
     if (all) {
-      status = NvAPI_GPU_GetAllDisplayIds(handles[i], displayIds.data(), &count);
+      status = NvApi().NvAPI_GPU_GetAllDisplayIds(handles[i], displayIds.data(), &count);
     } else {
-      status = NvAPI_GPU_GetConnectedDisplayIds(handles[i], displayIds.data(), &count, flags);
+      status = NvApi().NvAPI_GPU_GetConnectedDisplayIds(handles[i], displayIds.data(), &count, flags);
     }
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetDisplayIds failed", status);
-      continue;
+      return 0;
     }
 
     for (NvU32 j = 0; j < count; ++j) {
       const NV_GPU_DISPLAYIDS &info = displayIds[j];
-      std::printf("  displayId=0x%08X connector=%s active=%u connected=%u osVisible=%u\n", info.displayId,
-                  ConnectorTypeName(info.connectorType), info.isActive, info.isConnected, info.isOSVisible);
+      Printf("  displayId=0x%08X connector=%s active=%u connected=%u osVisible=%u\n", info.displayId,
+             ConnectorTypeName(info.connectorType), info.isActive, info.isConnected, info.isOSVisible);
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdDisplayEdid(int argc, char **argv) {
-  NvU32 displayId = 0;
-  if (!ParseDisplayIdArg(argc, argv, &displayId)) { return 1; }
-
   NV_EDID_FLAG flag = NV_EDID_FLAG_DEFAULT;
   if (!ParseEdidFlagArg(argc, argv, &flag)) { return 1; }
 
-  NvU8 edidData[NV_EDID_DATA_SIZE_MAX] = {};
-  NvU32 size = NV_EDID_DATA_SIZE_MAX;
-  NvAPI_Status status = NvAPI_GPU_GetEdidEx2(displayId, &flag, edidData, &size);
-  if (status != NVAPI_OK) {
-    PrintNvapiError("NvAPI_GPU_GetEdidEx2 failed", status);
+  NvU32 displayId = 0;
+  bool hasId = false;
+  bool decode = false;
+  const char *filePath = nullptr;
+  const char *cacheDir = nullptr;
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--decode") == 0) {
+      decode = true;
+      continue;
+    }
+    const bool known = std::strcmp(argv[i], "--id") == 0 || std::strcmp(argv[i], "--flag") == 0 ||
+                       std::strcmp(argv[i], "--file") == 0 || std::strcmp(argv[i], "--cache") == 0;
+    if (!known) {
+      Printf("Unknown option: %s\n", argv[i]);
+      return 1;
+    }
+    if (i + 1 >= argc) {
+      Printf("Missing value for %s\n", argv[i]);
+      return 1;
+    }
+    const char *value = argv[++i];
+    if (std::strcmp(argv[i - 1], "--id") == 0) {
+      if (!ParseUint(value, &displayId)) {
+        Printf("Invalid display id: %s\n", value);
+        return 1;
+      }
+      hasId = true;
+    } else if (std::strcmp(argv[i - 1], "--file") == 0) {
+      filePath = value;
+    } else if (std::strcmp(argv[i - 1], "--cache") == 0) {
+      cacheDir = value;
+      decode = true;
+    }
+  }
+  if (hasId == (filePath != nullptr)) {
+    Printf(hasId ? "--id and --file are exclusive\n" : "Missing required --id or --file\n");
     return 1;
   }
 
-  std::printf("EDID for displayId=0x%08X size=%u flag=%u\n", displayId, size, flag);
-  if (size >= 128) {
-    NvU8 extensionCount = edidData[0x7E];
-    std::printf("Extensions: %u\n", extensionCount);
+  EdidCache cache;
+  if (cacheDir && !cache.Open(cacheDir)) { return 1; }
+
+  // With a cache, one NvAPI_GPU_GetEdidEx call returns the first 256 bytes, the total size and the driver's EDID
+  // counter. If they match the last record for this display the decoded copy is used without the full fetch.
+  std::vector<NvU8> data;
+  EdidInfo info;
+  NvU64 hash = 0;
+  const char *cacheState = cacheDir ? "miss" : "off";
+  bool resolved = false;
+  bool probed = false;
+  EdidDisplayRecord record = {};
+  NV_EDID_FLAG usedFlag = flag;
+  if (filePath) {
+    if (!ReadEdidFile(filePath, &data)) { return 1; }
+  } else {
+    if (cacheDir) {
+      NV_EDID probe = {};
+      probe.version = NV_EDID_VER;
+      NV_EDID_FLAG probeFlag = flag;
+      if (NvApi().NvAPI_GPU_GetEdidEx(displayId, &probeFlag, &probe) == NVAPI_OK && probe.sizeofEDID > 0) {
+        const NvU32 prefix = std::min<NvU32>(probe.sizeofEDID, NV_EDID_DATA_SIZE);
+        EdidDisplayRecord last = {};
+        probed = true;
+        record.edidId = probe.edidId;
+        record.size = probe.sizeofEDID;
+        record.prefixHash = EdidHash(probe.EDID_Data, prefix);
+        if (cache.LoadDisplay(displayId, flag, &last) && last.edidId == record.edidId && last.size == record.size &&
+            last.prefixHash == record.prefixHash &&
+            cache.Load(last.hash, probe.EDID_Data, prefix, last.size, &info)) {
+          hash = last.hash;
+          cacheState = "unchanged";
+          resolved = true;
+        } else if (probe.sizeofEDID <= NV_EDID_DATA_SIZE) {
+          data.assign(probe.EDID_Data, probe.EDID_Data + probe.sizeofEDID);
+        }
+        usedFlag = probeFlag;
+      }
+    }
+    if (!resolved && data.empty()) {
+      data.assign(NV_EDID_DATA_SIZE_MAX, 0);
+      NvU32 size = NV_EDID_DATA_SIZE_MAX;
+      usedFlag = flag;
+      NvAPI_Status status = NvApi().NvAPI_GPU_GetEdidEx2(displayId, &usedFlag, data.data(), &size);
+      if (status != NVAPI_OK) {
+        PrintNvapiError("NvAPI_GPU_GetEdidEx2 failed", status);
+        return 1;
+      }
+      data.resize(std::min<NvU32>(size, NV_EDID_DATA_SIZE_MAX));
+    }
+  }
+  const NvU32 size = resolved ? info.size : static_cast<NvU32>(data.size());
+
+  if (!decode) {
+    if (filePath) {
+      Printf("EDID from %s size=%u\n", filePath, size);
+    } else {
+      Printf("EDID for displayId=0x%08X size=%u flag=%u\n", displayId, size, usedFlag);
+    }
+    if (size >= 128) {
+      NvU8 extensionCount = data[0x7E];
+      Printf("Extensions: %u\n", extensionCount);
+    }
+    PrintHexBytes(data.data(), size);
+    return 0;
+  }
+
+  if (!resolved) {
+    hash = EdidHash(data.data(), size);
+    if (cacheDir && cache.Load(hash, data.data(), size, size, &info)) {
+      cacheState = "hit";
+    } else {
+      if (!DecodeEdid(data.data(), size, &info)) {
+        Printf("Not an EDID: %u bytes without a valid base block header\n", size);
+        return 1;
+      }
+      if (cacheDir && !cache.Store(hash, data.data(), size, info)) { Printf("Failed to write EDID cache entry\n"); }
+    }
+    if (probed) {
+      record.hash = hash;
+      cache.StoreDisplay(displayId, flag, record);
+    }
+  }
+
+  if (StructuredOutput()) {
+    RecordWriter edidRecord("edid");
+    if (filePath) {
+      edidRecord.Field("file", filePath);
+    } else {
+      edidRecord.Hex("display_id", displayId).Field("flag", static_cast<NvU32>(usedFlag));
+    }
+    edidRecord.Field("size", size).Hex("hash", hash, 16).Field("cache", cacheState);
+  } else {
+    if (filePath) {
+      Printf("EDID from %s size=%u\n", filePath, size);
+    } else {
+      Printf("EDID for displayId=0x%08X size=%u flag=%u\n", displayId, size, usedFlag);
+    }
+    Printf("Hash: %016llX (cache: %s)\n", static_cast<unsigned long long>(hash), cacheState);
   }
-  PrintHexBytes(edidData, size);
+  PrintEdidInfo(info);
   return 0;
 }
 
@@ -88,31 +446,31 @@ int CmdDisplayTiming(int argc, char **argv) {
   if (!ParseDisplayIdArg(argc, argv, &displayId)) { return 1; }
 
   NvU32 count = 0;
-  NvAPI_Status status = NvAPI_DISP_GetTimingInfo(displayId, &count, NULL);
+  NvAPI_Status status = NvApi().NvAPI_DISP_GetTimingInfo(displayId, &count, NULL);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetTimingInfo failed", status);
     return 1;
   }
   if (count == 0) {
-    std::printf("No timing info available.\n");
+    Printf("No timing info available.\n");
     return 0;
   }
 
   std::vector<NV_BACKEND_TIMING_INFO> timings(count);
   for (NvU32 i = 0; i < count; ++i) { timings[i].version = NV_BACKEND_TIMING_INFO_VER; }
 
-  status = NvAPI_DISP_GetTimingInfo(displayId, &count, timings.data());
+  status = NvApi().NvAPI_DISP_GetTimingInfo(displayId, &count, timings.data());
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DISP_GetTimingInfo failed", status);
     return 1;
   }
 
-  std::printf("Timing info for displayId=0x%08X entries=%u\n", displayId, count);
+  Printf("Timing info for displayId=0x%08X entries=%u\n", displayId, count);
   for (NvU32 i = 0; i < count; ++i) {
     const NV_TIMING &timing = timings[i].timingInfo;
     double refresh = TimingRefreshHz(timing);
-    std::printf("  [%u] %ux%u %s pclk=%.3f MHz refresh=%.2f Hz\n", i, timing.HVisible, timing.VVisible,
-                timing.interlaced ? "interlaced" : "progressive", static_cast<double>(timing.pclk) / 100.0, refresh);
+    Printf("  [%u] %ux%u %s pclk=%.3f MHz refresh=%.2f Hz\n", i, timing.HVisible, timing.VVisible,
+           timing.interlaced ? "interlaced" : "progressive", static_cast<double>(timing.pclk) / 100.0, refresh);
   }
   return 0;
 }
@@ -209,32 +209,31 @@ bool ParseOsHdrState(const char *value, NV_OS_HDR_STATE *out) {
 
 void PrintHdrStaticMetadata(const NV_HDR_COLOR_DATA &data) {
   const auto &md = data.mastering_display_data;
-  std::printf("  mastering: primaries=(%u,%u) (%u,%u) (%u,%u) white=(%u,%u)\n", md.displayPrimary_x0,
-              md.displayPrimary_y0, md.displayPrimary_x1, md.displayPrimary_y1, md.displayPrimary_x2,
-              md.displayPrimary_y2, md.displayWhitePoint_x, md.displayWhitePoint_y);
-  std::printf("  mastering: maxLum=%u minLum=%u maxCLL=%u maxFALL=%u\n", md.max_display_mastering_luminance,
-              md.min_display_mastering_luminance, md.max_content_light_level, md.max_frame_average_light_level);
+  Printf("  mastering: primaries=(%u,%u) (%u,%u) (%u,%u) white=(%u,%u)\n", md.displayPrimary_x0, md.displayPrimary_y0,
+         md.displayPrimary_x1, md.displayPrimary_y1, md.displayPrimary_x2, md.displayPrimary_y2, md.displayWhitePoint_x,
+         md.displayWhitePoint_y);
+  Printf("  mastering: maxLum=%u minLum=%u maxCLL=%u maxFALL=%u\n", md.max_display_mastering_luminance,
+         md.min_display_mastering_luminance, md.max_content_light_level, md.max_frame_average_light_level);
 }
 
 void PrintHdrCapabilities(const NV_HDR_CAPABILITIES &caps) {
-  std::printf("HDR caps:\n");
-  std::printf("  hdrGamma=%u st2084=%u edr=%u sdrGamma=%u dolbyVision=%u expandDefault=%u\n",
-              caps.isTraditionalHdrGammaSupported ? 1 : 0, caps.isST2084EotfSupported ? 1 : 0,
-              caps.isEdrSupported ? 1 : 0, caps.isTraditionalSdrGammaSupported ? 1 : 0,
-              caps.isDolbyVisionSupported ? 1 : 0, caps.driverExpandDefaultHdrParameters ? 1 : 0);
-  std::printf("  staticMetadataId=%u\n", caps.static_metadata_descriptor_id);
-  std::printf("  display primaries=(%u,%u) (%u,%u) (%u,%u) white=(%u,%u)\n", caps.display_data.displayPrimary_x0,
-              caps.display_data.displayPrimary_y0, caps.display_data.displayPrimary_x1,
-              caps.display_data.displayPrimary_y1, caps.display_data.displayPrimary_x2,
-              caps.display_data.displayPrimary_y2, caps.display_data.displayWhitePoint_x,
-              caps.display_data.displayWhitePoint_y);
-  std::printf("  display luminance: max=%u min=%u maxFALL=%u\n", caps.display_data.desired_content_max_luminance,
-              caps.display_data.desired_content_min_luminance,
-              caps.display_data.desired_content_max_frame_average_luminance);
-  std::printf("  dolbyVision: vsvdbVer=%u dmVer=%u 2160p60=%u yuv422_12b=%u globalDimming=%u\n",
-              caps.dv_static_metadata.VSVDB_version, caps.dv_static_metadata.dm_version,
-              caps.dv_static_metadata.supports_2160p60hz ? 1 : 0, caps.dv_static_metadata.supports_YUV422_12bit ? 1 : 0,
-              caps.dv_static_metadata.supports_global_dimming ? 1 : 0);
+  Printf("HDR caps:\n");
+  Printf("  hdrGamma=%u st2084=%u edr=%u sdrGamma=%u dolbyVision=%u expandDefault=%u\n",
+         caps.isTraditionalHdrGammaSupported ? 1 : 0, caps.isST2084EotfSupported ? 1 : 0, caps.isEdrSupported ? 1 : 0,
+         caps.isTraditionalSdrGammaSupported ? 1 : 0, caps.isDolbyVisionSupported ? 1 : 0,
+         caps.driverExpandDefaultHdrParameters ? 1 : 0);
+  Printf("  staticMetadataId=%u\n", caps.static_metadata_descriptor_id);
+  Printf("  display primaries=(%u,%u) (%u,%u) (%u,%u) white=(%u,%u)\n", caps.display_data.displayPrimary_x0,
+         caps.display_data.displayPrimary_y0, caps.display_data.displayPrimary_x1, caps.display_data.displayPrimary_y1,
+         caps.display_data.displayPrimary_x2, caps.display_data.displayPrimary_y2,
+         caps.display_data.displayWhitePoint_x, caps.display_data.displayWhitePoint_y);
+  Printf("  display luminance: max=%u min=%u maxFALL=%u\n", caps.display_data.desired_content_max_luminance,
+         caps.display_data.desired_content_min_luminance,
+         caps.display_data.desired_content_max_frame_average_luminance);
+  Printf("  dolbyVision: vsvdbVer=%u dmVer=%u 2160p60=%u yuv422_12b=%u globalDimming=%u\n",
+         caps.dv_static_metadata.VSVDB_version, caps.dv_static_metadata.dm_version,
+         caps.dv_static_metadata.supports_2160p60hz ? 1 : 0, caps.dv_static_metadata.supports_YUV422_12bit ? 1 : 0,
+         caps.dv_static_metadata.supports_global_dimming ? 1 : 0);
 }
 } // namespace
 
@@ -244,7 +243,7 @@ int CmdDisplayHdrCaps(int argc, char **argv) {
 
   NV_HDR_CAPABILITIES caps = {};
   caps.version = NV_HDR_CAPABILITIES_VER;
-  NvAPI_Status status = NvAPI_Disp_GetHdrCapabilities(displayId, &caps);
+  NvAPI_Status status = NvApi().NvAPI_Disp_GetHdrCapabilities(displayId, &caps);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Disp_GetHdrCapabilities failed", status);
     return 1;
@@ -261,14 +260,14 @@ int CmdDisplayHdrSessionGet(int argc, char **argv) {
   NV_HDR_SESSION_CONFIG_DATA data = {};
   data.version = NV_HDR_SESSION_CONFIG_DATA_VER;
   data.cmd = NV_HDR_CONTROL_CMD_GET;
-  NvAPI_Status status = NvAPI_Disp_HdrSessionControl(displayId, &data);
+  NvAPI_Status status = NvApi().NvAPI_Disp_HdrSessionControl(displayId, &data);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Disp_HdrSessionControl failed", status);
     return 1;
   }
 
-  std::printf("HDR session: enabled=%u hdrOn=%u expire=%u\n", data.bSessionState ? 1 : 0, data.bHDRState ? 1 : 0,
-              data.sessionExpireTime);
+  Printf("HDR session: enabled=%u hdrOn=%u expire=%u\n", data.bSessionState ? 1 : 0, data.bHDRState ? 1 : 0,
+         data.sessionExpireTime);
   return 0;
 }
 
@@ -283,7 +282,7 @@ int CmdDisplayHdrSessionSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -292,7 +291,7 @@ int CmdDisplayHdrSessionSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--enable") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &enable)) {
-        std::printf("Invalid --enable value.\n");
+        Printf("Invalid --enable value.\n");
         return 1;
       }
       hasEnable = true;
@@ -301,23 +300,23 @@ int CmdDisplayHdrSessionSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--expire") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &expire)) {
-        std::printf("Invalid --expire value.\n");
+        Printf("Invalid --expire value.\n");
         return 1;
       }
       hasExpire = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
   if (!hasEnable) {
-    std::printf("Missing required --enable\n");
+    Printf("Missing required --enable\n");
     return 1;
   }
 
@@ -327,15 +326,15 @@ int CmdDisplayHdrSessionSet(int argc, char **argv) {
   data.bSessionState = enable ? 1 : 0;
   if (hasExpire) { data.sessionExpireTime = expire; }
 
-  std::printf("HDR session set: enable=%u expire=%u\n", data.bSessionState ? 1 : 0, data.sessionExpireTime);
+  Printf("HDR session set: enable=%u expire=%u\n", data.bSessionState ? 1 : 0, data.sessionExpireTime);
 
-  NvAPI_Status status = NvAPI_Disp_HdrSessionControl(displayId, &data);
+  NvAPI_Status status = NvApi().NvAPI_Disp_HdrSessionControl(displayId, &data);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Disp_HdrSessionControl failed", status);
     return 1;
   }
 
-  std::printf("HDR session updated.\n");
+  Printf("HDR session updated.\n");
   return 0;
 }
 
@@ -348,7 +347,7 @@ int CmdDisplayHdrSession(int argc, char **argv) {
   if (std::strcmp(argv[0], "get") == 0) { return CmdDisplayHdrSessionGet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdDisplayHdrSessionSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown display hdr session subcommand: %s\n", argv[0]);
+  Printf("Unknown display hdr session subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -359,16 +358,16 @@ int CmdDisplayHdrColorGet(int argc, char **argv) {
   NV_HDR_COLOR_DATA data = {};
   data.version = NV_HDR_COLOR_DATA_VER;
   data.cmd = NV_HDR_CMD_GET;
-  NvAPI_Status status = NvAPI_Disp_HdrColorControl(displayId, &data);
+  NvAPI_Status status = NvApi().NvAPI_Disp_HdrColorControl(displayId, &data);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Disp_HdrColorControl failed", status);
     return 1;
   }
 
-  std::printf("HDR color: mode=%s format=%s range=%s bpc=%s osHdr=%s\n", HdrModeName(data.hdrMode),
-              ColorFormatName(data.hdrColorFormat), DynamicRangeName(data.hdrDynamicRange), BpcName(data.hdrBpc),
-              OsHdrStateName(data.osHdrMode));
-  std::printf("  staticMetadataId=%u\n", data.static_metadata_descriptor_id);
+  Printf("HDR color: mode=%s format=%s range=%s bpc=%s osHdr=%s\n", HdrModeName(data.hdrMode),
+         ColorFormatName(data.hdrColorFormat), DynamicRangeName(data.hdrDynamicRange), BpcName(data.hdrBpc),
+         OsHdrStateName(data.osHdrMode));
+  Printf("  staticMetadataId=%u\n", data.static_metadata_descriptor_id);
   PrintHdrStaticMetadata(data);
   return 0;
 }
@@ -390,7 +389,7 @@ int CmdDisplayHdrColorSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -399,7 +398,7 @@ int CmdDisplayHdrColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--mode") == 0) {
       if (i + 1 >= argc || !ParseHdrMode(argv[i + 1], &mode)) {
-        std::printf("Invalid --mode value.\n");
+        Printf("Invalid --mode value.\n");
         return 1;
       }
       hasMode = true;
@@ -408,7 +407,7 @@ int CmdDisplayHdrColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--format") == 0) {
       if (i + 1 >= argc || !ParseColorFormat(argv[i + 1], &format)) {
-        std::printf("Invalid --format value.\n");
+        Printf("Invalid --format value.\n");
         return 1;
       }
       hasFormat = true;
@@ -417,7 +416,7 @@ int CmdDisplayHdrColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--range") == 0) {
       if (i + 1 >= argc || !ParseDynamicRange(argv[i + 1], &range)) {
-        std::printf("Invalid --range value.\n");
+        Printf("Invalid --range value.\n");
         return 1;
       }
       hasRange = true;
@@ -426,7 +425,7 @@ int CmdDisplayHdrColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--bpc") == 0) {
       if (i + 1 >= argc || !ParseBpc(argv[i + 1], &bpc)) {
-        std::printf("Invalid --bpc value.\n");
+        Printf("Invalid --bpc value.\n");
         return 1;
       }
       hasBpc = true;
@@ -435,30 +434,30 @@ int CmdDisplayHdrColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--os-hdr") == 0) {
       if (i + 1 >= argc || !ParseOsHdrState(argv[i + 1], &osHdr)) {
-        std::printf("Invalid --os-hdr value.\n");
+        Printf("Invalid --os-hdr value.\n");
         return 1;
       }
       hasOsHdr = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
   if (!hasMode && !hasFormat && !hasRange && !hasBpc && !hasOsHdr) {
-    std::printf("No HDR color changes specified.\n");
+    Printf("No HDR color changes specified.\n");
     return 1;
   }
 
   NV_HDR_COLOR_DATA data = {};
   data.version = NV_HDR_COLOR_DATA_VER;
   data.cmd = NV_HDR_CMD_GET;
-  NvAPI_Status status = NvAPI_Disp_HdrColorControl(displayId, &data);
+  NvAPI_Status status = NvApi().NvAPI_Disp_HdrColorControl(displayId, &data);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Disp_HdrColorControl failed", status);
     return 1;
@@ -472,17 +471,17 @@ int CmdDisplayHdrColorSet(int argc, char **argv) {
 
   data.cmd = NV_HDR_CMD_SET;
 
-  std::printf("HDR color set: mode=%s format=%s range=%s bpc=%s osHdr=%s\n", HdrModeName(data.hdrMode),
-              ColorFormatName(data.hdrColorFormat), DynamicRangeName(data.hdrDynamicRange), BpcName(data.hdrBpc),
-              OsHdrStateName(data.osHdrMode));
+  Printf("HDR color set: mode=%s format=%s range=%s bpc=%s osHdr=%s\n", HdrModeName(data.hdrMode),
+         ColorFormatName(data.hdrColorFormat), DynamicRangeName(data.hdrDynamicRange), BpcName(data.hdrBpc),
+         OsHdrStateName(data.osHdrMode));
 
-  status = NvAPI_Disp_HdrColorControl(displayId, &data);
+  status = NvApi().NvAPI_Disp_HdrColorControl(displayId, &data);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Disp_HdrColorControl failed", status);
     return 1;
   }
 
-  std::printf("HDR color configuration updated.\n");
+  Printf("HDR color configuration updated.\n");
   return 0;
 }
 
@@ -495,7 +494,7 @@ int CmdDisplayHdrColor(int argc, char **argv) {
   if (std::strcmp(argv[0], "get") == 0) { return CmdDisplayHdrColorGet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdDisplayHdrColorSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown display hdr color subcommand: %s\n", argv[0]);
+  Printf("Unknown display hdr color subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -509,7 +508,7 @@ int CmdDisplayHdr(int argc, char **argv) {
   if (std::strcmp(argv[0], "session") == 0) { return CmdDisplayHdrSession(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "color") == 0) { return CmdDisplayHdrColor(argc - 1, argv + 1); }
 
-  std::printf("Unknown display hdr subcommand: %s\n", argv[0]);
+  Printf("Unknown display hdr subcommand: %s\n", argv[0]);
   return 1;
 }
 } // namespace nvcli
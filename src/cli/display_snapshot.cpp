@@ -0,0 +1,411 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/topology.h"
+
+#include <unordered_map>
+
+namespace nvcli {
+namespace {
+struct SnapshotHandle {
+  NvU32 index;
+  NvDisplayHandle handle;
+  std::string name;
+  bool hasOutputId;
+  NvU32 outputId;
+};
+
+struct SnapshotDisplay {
+  NvU32 gpuIndex;
+  NV_GPU_DISPLAYIDS ids;
+  // Index into the handle list, kNoHandle for displays without an NVIDIA display handle (inactive ones).
+  size_t handle;
+};
+
+constexpr size_t kNoHandle = ~static_cast<size_t>(0);
+
+// Everything read for one display, filled on a pool worker before anything is printed.
+struct SnapshotProps {
+  NvAPI_Status timingStatus;
+  std::vector<NV_BACKEND_TIMING_INFO> timings;
+  NvAPI_Status dpStatus;
+  NV_DISPLAY_PORT_INFO dp;
+  NvAPI_Status hdmiStatus;
+  NV_HDMI_SUPPORT_INFO hdmi;
+  NvAPI_Status hdrStatus;
+  NV_HDR_CAPABILITIES hdr;
+  NvAPI_Status monitorStatus[3];
+  NV_MONITOR_CAPABILITIES monitor[3];
+};
+
+const NV_MONITOR_CAPS_TYPE kSnapshotMonitorTypes[3] = {NV_MONITOR_CAPS_TYPE_GENERIC, NV_MONITOR_CAPS_TYPE_HDMI_VSDB,
+                                                       NV_MONITOR_CAPS_TYPE_HDMI_VCDB};
+
+bool CollectDisplayIds(NvPhysicalGpuHandle gpu, bool all, std::vector<NV_GPU_DISPLAYIDS> *out) {
+  NvU32 count = 0;
+  NvAPI_Status status = all ? NvApi().NvAPI_GPU_GetAllDisplayIds(gpu, NULL, &count)
+                            : NvApi().NvAPI_GPU_GetConnectedDisplayIds(gpu, NULL, &count, 0);
+  if (status == NVAPI_OK && count > 0) {
+    out->assign(count, NV_GPU_DISPLAYIDS{});
+    for (auto &entry : *out) { entry.version = NV_GPU_DISPLAYIDS_VER; }
+    status = all ? NvApi().NvAPI_GPU_GetAllDisplayIds(gpu, out->data(), &count)
+                 : NvApi().NvAPI_GPU_GetConnectedDisplayIds(gpu, out->data(), &count, 0);
+    out->resize(count);
+  }
+  if (status != NVAPI_OK) {
+    out->clear();
+    PrintNvapiError("NvAPI_GPU_GetDisplayIds failed", status);
+    return false;
+  }
+  return true;
+}
+
+// Handles, display IDs and output IDs come from the topology cache, only the names are read here, so the per-display
+// work never walks the handle list again.
+void CollectDisplayHandles(std::vector<SnapshotHandle> *handles, std::unordered_map<NvU32, size_t> *byDisplayId) {
+  const NvU32 count = Topology().DisplayCount();
+  for (NvU32 index = 0; index < count; ++index) {
+    TopologyDisplay display = {};
+    if (!Topology().DisplayByIndex(index, &display)) { break; }
+    SnapshotHandle entry = {};
+    entry.index = index;
+    entry.handle = display.handle;
+    NvAPI_ShortString name = {0};
+    if (NvApi().NvAPI_GetAssociatedNvidiaDisplayName(display.handle, name) == NVAPI_OK) { entry.name = name; }
+    entry.hasOutputId = display.hasOutputId;
+    entry.outputId = display.outputId;
+    if (display.hasDisplayId) { byDisplayId->emplace(display.displayId, handles->size()); }
+    handles->push_back(entry);
+  }
+}
+
+void ReadSnapshotProps(const SnapshotDisplay &display, const SnapshotHandle *handle, SnapshotProps *props) {
+  const NvU32 displayId = display.ids.displayId;
+
+  NvU32 count = 0;
+  props->timingStatus = NvApi().NvAPI_DISP_GetTimingInfo(displayId, &count, NULL);
+  if (props->timingStatus == NVAPI_OK && count > 0) {
+    props->timings.assign(count, NV_BACKEND_TIMING_INFO{});
+    for (auto &timing : props->timings) { timing.version = NV_BACKEND_TIMING_INFO_VER; }
+    props->timingStatus = NvApi().NvAPI_DISP_GetTimingInfo(displayId, &count, props->timings.data());
+    props->timings.resize(props->timingStatus == NVAPI_OK ? count : 0);
+  }
+
+  // A display ID works in place of the handle and output ID, the handle is used when the display has one.
+  NvDisplayHandle displayHandle = handle && handle->hasOutputId ? handle->handle : NULL;
+  const NvU32 outputId = handle && handle->hasOutputId ? handle->outputId : displayId;
+
+  props->dp = {};
+  props->dp.version = NV_DISPLAY_PORT_INFO_VER;
+  props->dpStatus = NvApi().NvAPI_GetDisplayPortInfo(displayHandle, outputId, &props->dp);
+
+  props->hdmi = {};
+  props->hdmi.version = NV_HDMI_SUPPORT_INFO_VER;
+  props->hdmiStatus = NvApi().NvAPI_GetHDMISupportInfo(displayHandle, outputId, &props->hdmi);
+
+  props->hdr = {};
+  props->hdr.version = NV_HDR_CAPABILITIES_VER;
+  props->hdrStatus = NvApi().NvAPI_Disp_GetHdrCapabilities(displayId, &props->hdr);
+
+  for (size_t i = 0; i < 3; ++i) {
+    NV_MONITOR_CAPABILITIES &caps = props->monitor[i];
+    caps = {};
+    caps.version = NV_MONITOR_CAPABILITIES_VER;
+    caps.size = static_cast<NvU16>(sizeof(caps));
+    caps.infoType = kSnapshotMonitorTypes[i];
+    props->monitorStatus[i] = NvApi().NvAPI_DISP_GetMonitorCapabilities(displayId, &caps);
+  }
+}
+
+const NV_MONITOR_CAPABILITIES *ValidMonitorCaps(const SnapshotProps &props, size_t i) {
+  if (props.monitorStatus[i] != NVAPI_OK || !props.monitor[i].bIsValidInfo) { return nullptr; }
+  return &props.monitor[i];
+}
+
+void PrintSnapshotRecords(const SnapshotDisplay &display, const SnapshotHandle *handle, const SnapshotProps *props) {
+  const NV_GPU_DISPLAYIDS &ids = display.ids;
+  {
+    RecordWriter record("display_snapshot");
+    record.Hex("display_id", ids.displayId)
+        .Field("connector", ConnectorTypeName(ids.connectorType))
+        .Field("active", ids.isActive != 0)
+        .Field("connected", ids.isConnected != 0)
+        .Field("os_visible", ids.isOSVisible != 0)
+        .Field("dynamic", ids.isDynamic != 0)
+        .Field("mst_root", ids.isMultiStreamRootNode != 0)
+        .Field("tile", ids.isTile != 0)
+        .Field("dsc_capable", ids.isDscCapable != 0);
+    if (handle) {
+      record.Field("handle_index", handle->index).Field("name", handle->name);
+      if (handle->hasOutputId) {
+        record.Hex("output_id", handle->outputId);
+      } else {
+        record.Null("output_id");
+      }
+    } else {
+      record.Null("handle_index").Null("name").Null("output_id");
+    }
+  }
+  if (!props) { return; }
+
+  if (props->timingStatus != NVAPI_OK) {
+    RecordWriter("display_snapshot_timing")
+        .Hex("display_id", ids.displayId)
+        .Field("status", NvapiStatusString(props->timingStatus));
+  }
+  for (size_t i = 0; i < props->timings.size(); ++i) {
+    const NV_TIMING &timing = props->timings[i].timingInfo;
+    RecordWriter("display_snapshot_timing")
+        .Hex("display_id", ids.displayId)
+        .Field("index", static_cast<NvU32>(i))
+        .Field("width", static_cast<NvU32>(timing.HVisible))
+        .Field("height", static_cast<NvU32>(timing.VVisible))
+        .Field("interlaced", timing.interlaced != 0)
+        .Field("pixel_clock_khz", static_cast<NvU32>(timing.pclk) * 10)
+        .Field("refresh_hz", TimingRefreshHz(timing));
+  }
+
+  {
+    RecordWriter record("display_snapshot_dp");
+    record.Hex("display_id", ids.displayId);
+    const NV_DISPLAY_PORT_INFO &dp = props->dp;
+    if (props->dpStatus != NVAPI_OK) {
+      record.Field("status", NvapiStatusString(props->dpStatus));
+    } else {
+      record.Field("is_dp", dp.isDp != 0)
+          .Field("internal", dp.isInternalDp != 0)
+          .Hex("dpcd", dp.dpcd_ver)
+          .Field("max_link_rate", DpLinkRateName(dp.maxLinkRate))
+          .Field("max_lanes", DpLaneCountName(dp.maxLaneCount))
+          .Field("link_rate", DpLinkRateName(dp.curLinkRate))
+          .Field("lanes", DpLaneCountName(dp.curLaneCount))
+          .Field("color_format", DpColorFormatName(dp.colorFormat))
+          .Field("dynamic_range", DpDynamicRangeName(dp.dynamicRange))
+          .Field("colorimetry", DpColorimetryName(dp.colorimetry))
+          .Field("bpc", DpBpcName(dp.bpc));
+    }
+  }
+
+  {
+    RecordWriter record("display_snapshot_hdmi");
+    record.Hex("display_id", ids.displayId);
+    const NV_HDMI_SUPPORT_INFO &hdmi = props->hdmi;
+    if (props->hdmiStatus != NVAPI_OK) {
+      record.Field("status", NvapiStatusString(props->hdmiStatus));
+    } else {
+      record.Field("gpu_capable", hdmi.isGpuHDMICapable != 0)
+          .Field("monitor_hdmi", hdmi.isMonHDMI != 0)
+          .Field("audio", hdmi.isMonBasicAudioCapable != 0)
+          .Field("ycbcr444", hdmi.isMonYCbCr444Capable != 0)
+          .Field("ycbcr422", hdmi.isMonYCbCr422Capable != 0)
+          .Field("ycbcr420", hdmi.isMonYCbCr420Capable != 0)
+          .Field("bpc10", hdmi.is10BPCSupported != 0)
+          .Field("bpc12", hdmi.is12BPCSupported != 0)
+          .Field("st2084", hdmi.isST2084EotfSupported != 0)
+          .Field("max_monitor_frl", HdmiFrlRateName(hdmi.maxMonFrlRate))
+          .Field("max_gpu_frl", HdmiFrlRateName(hdmi.maxGpuFrlRate));
+    }
+  }
+
+  {
+    RecordWriter record("display_snapshot_hdr");
+    record.Hex("display_id", ids.displayId);
+    const NV_HDR_CAPABILITIES &hdr = props->hdr;
+    if (props->hdrStatus != NVAPI_OK) {
+      record.Field("status", NvapiStatusString(props->hdrStatus));
+    } else {
+      record.Field("st2084", hdr.isST2084EotfSupported != 0)
+          .Field("hdr_gamma", hdr.isTraditionalHdrGammaSupported != 0)
+          .Field("edr", hdr.isEdrSupported != 0)
+          .Field("dolby_vision", hdr.isDolbyVisionSupported != 0)
+          .Field("max_luminance", static_cast<NvU32>(hdr.display_data.desired_content_max_luminance))
+          .Field("min_luminance", static_cast<NvU32>(hdr.display_data.desired_content_min_luminance))
+          .Field("max_fall", static_cast<NvU32>(hdr.display_data.desired_content_max_frame_average_luminance));
+    }
+  }
+
+  {
+    RecordWriter record("display_snapshot_monitor");
+    record.Hex("display_id", ids.displayId);
+    if (const NV_MONITOR_CAPABILITIES *caps = ValidMonitorCaps(*props, 0)) {
+      const NV_MONITOR_CAPS_GENERIC &info = caps->data.caps;
+      record.Field("vrr", info.supportVRR != 0)
+          .Field("ulmb", info.supportULMB != 0)
+          .Field("true_gsync", info.isTrueGsync != 0)
+          .Field("rla", info.isRLACapable != 0);
+    } else {
+      record.Null("vrr");
+    }
+    if (const NV_MONITOR_CAPABILITIES *caps = ValidMonitorCaps(*props, 1)) {
+      const NV_MONITOR_CAPS_VSDB &info = caps->data.vsdb;
+      record.Field("max_tmds_clock", static_cast<NvU32>(info.maxTmdsClock))
+          .Field("video_latency", static_cast<NvU32>(info.videoLatency))
+          .Field("audio_latency", static_cast<NvU32>(info.audioLatency));
+    }
+    if (const NV_MONITOR_CAPABILITIES *caps = ValidMonitorCaps(*props, 2)) {
+      const NV_MONITOR_CAPS_VCDB &info = caps->data.vcdb;
+      record.Field("quant_range_ycc", static_cast<NvU32>(info.quantizationRangeYcc))
+          .Field("quant_range_rgb", static_cast<NvU32>(info.quantizationRangeRgb));
+    }
+  }
+}
+
+void PrintSnapshotText(const SnapshotDisplay &display, const SnapshotHandle *handle, const SnapshotProps *props) {
+  const NV_GPU_DISPLAYIDS &ids = display.ids;
+  Printf("GPU[%u] displayId=0x%08X connector=%s active=%u connected=%u osVisible=%u\n", display.gpuIndex,
+         ids.displayId, ConnectorTypeName(ids.connectorType), ids.isActive, ids.isConnected, ids.isOSVisible);
+  if (handle) {
+    Printf("  handle[%u]=0x%p name=%s", handle->index, handle->handle,
+           handle->name.empty() ? "<name unavailable>" : handle->name.c_str());
+    if (handle->hasOutputId) { Printf(" output=0x%08X", handle->outputId); }
+    Printf("\n");
+  } else {
+    Printf("  handle: none\n");
+  }
+  if (!props) { return; }
+
+  if (props->timingStatus != NVAPI_OK) {
+    Printf("  timing: %s\n", NvapiStatusString(props->timingStatus).c_str());
+  }
+  for (size_t i = 0; i < props->timings.size(); ++i) {
+    const NV_TIMING &timing = props->timings[i].timingInfo;
+    Printf("  timing[%zu]: %ux%u %s pclk=%.3f MHz refresh=%.2f Hz\n", i, timing.HVisible, timing.VVisible,
+           timing.interlaced ? "interlaced" : "progressive", static_cast<double>(timing.pclk) / 100.0,
+           TimingRefreshHz(timing));
+  }
+
+  const NV_DISPLAY_PORT_INFO &dp = props->dp;
+  if (props->dpStatus != NVAPI_OK) {
+    Printf("  dp: %s\n", NvapiStatusString(props->dpStatus).c_str());
+  } else if (!dp.isDp) {
+    Printf("  dp: isDp=0\n");
+  } else {
+    Printf("  dp: dpcd=0x%08X link=%sx%s (max %sx%s) format=%s range=%s colorimetry=%s bpc=%s internal=%u\n",
+           dp.dpcd_ver, DpLinkRateName(dp.curLinkRate), DpLaneCountName(dp.curLaneCount),
+           DpLinkRateName(dp.maxLinkRate), DpLaneCountName(dp.maxLaneCount), DpColorFormatName(dp.colorFormat),
+           DpDynamicRangeName(dp.dynamicRange), DpColorimetryName(dp.colorimetry), DpBpcName(dp.bpc),
+           dp.isInternalDp ? 1 : 0);
+  }
+
+  const NV_HDMI_SUPPORT_INFO &hdmi = props->hdmi;
+  if (props->hdmiStatus != NVAPI_OK) {
+    Printf("  hdmi: %s\n", NvapiStatusString(props->hdmiStatus).c_str());
+  } else {
+    Printf("  hdmi: gpuCapable=%u monHdmi=%u audio=%u ycbcr444=%u ycbcr422=%u ycbcr420=%u bpc10=%u bpc12=%u "
+           "st2084=%u frl=%s/%s\n",
+           hdmi.isGpuHDMICapable ? 1 : 0, hdmi.isMonHDMI ? 1 : 0, hdmi.isMonBasicAudioCapable ? 1 : 0,
+           hdmi.isMonYCbCr444Capable ? 1 : 0, hdmi.isMonYCbCr422Capable ? 1 : 0, hdmi.isMonYCbCr420Capable ? 1 : 0,
+           hdmi.is10BPCSupported ? 1 : 0, hdmi.is12BPCSupported ? 1 : 0, hdmi.isST2084EotfSupported ? 1 : 0,
+           HdmiFrlRateName(hdmi.maxMonFrlRate), HdmiFrlRateName(hdmi.maxGpuFrlRate));
+  }
+
+  const NV_HDR_CAPABILITIES &hdr = props->hdr;
+  if (props->hdrStatus != NVAPI_OK) {
+    Printf("  hdr: %s\n", NvapiStatusString(props->hdrStatus).c_str());
+  } else {
+    Printf("  hdr: st2084=%u hdrGamma=%u edr=%u dolbyVision=%u luminance: max=%u min=%u maxFALL=%u\n",
+           hdr.isST2084EotfSupported ? 1 : 0, hdr.isTraditionalHdrGammaSupported ? 1 : 0,
+           hdr.isEdrSupported ? 1 : 0, hdr.isDolbyVisionSupported ? 1 : 0,
+           hdr.display_data.desired_content_max_luminance, hdr.display_data.desired_content_min_luminance,
+           hdr.display_data.desired_content_max_frame_average_luminance);
+  }
+
+  Printf("  monitor:");
+  if (const NV_MONITOR_CAPABILITIES *caps = ValidMonitorCaps(*props, 0)) {
+    const NV_MONITOR_CAPS_GENERIC &info = caps->data.caps;
+    Printf(" vrr=%u ulmb=%u trueGsync=%u rla=%u", info.supportVRR ? 1 : 0, info.supportULMB ? 1 : 0,
+           info.isTrueGsync ? 1 : 0, info.isRLACapable ? 1 : 0);
+  } else {
+    Printf(" generic=unavailable");
+  }
+  if (const NV_MONITOR_CAPABILITIES *caps = ValidMonitorCaps(*props, 1)) {
+    const NV_MONITOR_CAPS_VSDB &info = caps->data.vsdb;
+    Printf(" maxTmdsClock=%u latency=%u/%u", info.maxTmdsClock, info.videoLatency, info.audioLatency);
+  }
+  if (const NV_MONITOR_CAPABILITIES *caps = ValidMonitorCaps(*props, 2)) {
+    const NV_MONITOR_CAPS_VCDB &info = caps->data.vcdb;
+    Printf(" quantYcc=%u quantRgb=%u", info.quantizationRangeYcc, info.quantizationRangeRgb);
+  }
+  Printf("\n");
+}
+} // namespace
+
+int CmdDisplaySnapshot(int argc, char **argv) {
+  NvU32 gpuIndex = 0;
+  bool hasIndex = false;
+  bool all = false;
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--index") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &gpuIndex)) {
+        Printf("Invalid GPU index.\n");
+        return 1;
+      }
+      hasIndex = true;
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--all") == 0) {
+      all = true;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+
+  std::vector<NvPhysicalGpuHandle> gpus;
+  std::vector<NvU32> gpuIndices;
+  if (!CollectGpus(hasIndex, gpuIndex, gpus, gpuIndices)) { return 1; }
+
+  int result = 0;
+  std::vector<SnapshotDisplay> displays;
+  std::vector<NV_GPU_DISPLAYIDS> ids;
+  for (size_t i = 0; i < gpus.size(); ++i) {
+    if (!CollectDisplayIds(gpus[i], all, &ids)) {
+      result = 1;
+      continue;
+    }
+    for (const auto &entry : ids) { displays.push_back({gpuIndices[i], entry, kNoHandle}); }
+  }
+
+  std::vector<SnapshotHandle> handles;
+  std::unordered_map<NvU32, size_t> handleByDisplayId;
+  CollectDisplayHandles(&handles, &handleByDisplayId);
+  for (auto &display : displays) {
+    auto found = handleByDisplayId.find(display.ids.displayId);
+    if (found != handleByDisplayId.end()) { display.handle = found->second; }
+  }
+
+  if (StructuredOutput()) {
+    RecordWriter("display_snapshot_summary")
+        .Field("gpus", static_cast<NvU32>(gpus.size()))
+        .Field("displays", static_cast<NvU32>(displays.size()))
+        .Field("handles", static_cast<NvU32>(handles.size()));
+  } else {
+    Printf("Display snapshot: gpus=%zu displays=%zu handles=%zu\n", gpus.size(), displays.size(), handles.size());
+  }
+
+  // The per-display queries are independent, so they share the GPU worker pool (--jobs) and each display's output is
+  // written in enumeration order once its worker finishes.
+  const int status = ForEachGpu(displays.size(), [&](size_t i) {
+    const SnapshotDisplay &display = displays[i];
+    const SnapshotHandle *handle = display.handle == kNoHandle ? nullptr : &handles[display.handle];
+    SetRecordGpu(display.gpuIndex);
+
+    // Properties of a disconnected display (--all) are not read, the driver only reports its ID.
+    SnapshotProps props = {};
+    const bool connected = display.ids.isConnected != 0;
+    if (connected) { ReadSnapshotProps(display, handle, &props); }
+
+    if (StructuredOutput()) {
+      PrintSnapshotRecords(display, handle, connected ? &props : nullptr);
+    } else {
+      PrintSnapshotText(display, handle, connected ? &props : nullptr);
+    }
+    return 0;
+  });
+  return result != 0 ? result : status;
+}
+} // namespace nvcli
@@ -4,11 +4,9 @@
  */
 
 #include "cli/commands.h"
+#include "cli/topology.h"
 
 namespace nvcli {
-namespace {
-void PrintDpUsage() { PrintUsageGroup("dp"); }
-
 const char *DpLinkRateName(NV_DP_LINK_RATE rate) {
   switch (rate) {
   case NV_DP_1_62GBPS: return "1.62";
@@ -70,6 +68,9 @@ const char *DpBpcName(NV_DP_BPC bpc) {
   }
 }
 
+namespace {
+void PrintDpUsage() { PrintUsageGroup("dp"); }
+
 bool ParseDpLinkRate(const char *value, NV_DP_LINK_RATE *out) {
   if (!value || !out) { return false; }
   std::string lowered = ToLowerAscii(value);
@@ -232,21 +233,21 @@ bool ResolveDisplayPortTarget(bool hasDisplayId, NvU32 displayId, NvU32 handleIn
     return true;
   }
 
-  NvDisplayHandle handle = NULL;
-  if (!GetDisplayHandleByIndex(handleIndex, &handle)) {
-    std::printf("Display handle index %u not found.\n", handleIndex);
+  TopologyDisplay display = {};
+  if (!Topology().DisplayByIndex(handleIndex, &display)) {
+    Printf("Display handle index %u not found.\n", handleIndex);
     return false;
   }
 
   if (!hasOutputId) {
-    NvAPI_Status status = NvAPI_GetAssociatedDisplayOutputId(handle, &outputId);
-    if (status != NVAPI_OK) {
-      PrintNvapiError("NvAPI_GetAssociatedDisplayOutputId failed", status);
+    if (!display.hasOutputId) {
+      Printf("No output ID for display handle index %u.\n", handleIndex);
       return false;
     }
+    outputId = display.outputId;
   }
 
-  *handleOut = handle;
+  *handleOut = display.handle;
   *outputOut = outputId;
   return true;
 }
@@ -262,7 +263,7 @@ int CmdDpInfo(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -271,7 +272,7 @@ int CmdDpInfo(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--handle-index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &handleIndex)) {
-        std::printf("Invalid handle index.\n");
+        Printf("Invalid handle index.\n");
         return 1;
       }
       ++i;
@@ -279,14 +280,14 @@ int CmdDpInfo(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--output-id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &outputId)) {
-        std::printf("Invalid output id.\n");
+        Printf("Invalid output id.\n");
         return 1;
       }
       hasOutputId = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -299,37 +300,36 @@ int CmdDpInfo(int argc, char **argv) {
 
   NV_DISPLAY_PORT_INFO info = {};
   info.version = NV_DISPLAY_PORT_INFO_VER;
-  NvAPI_Status status = NvAPI_GetDisplayPortInfo(handle, resolvedOutput, &info);
+  NvAPI_Status status = NvApi().NvAPI_GetDisplayPortInfo(handle, resolvedOutput, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GetDisplayPortInfo failed", status);
     return 1;
   }
 
-  std::printf("DisplayPort info: outputId=0x%08X\n", resolvedOutput);
-  std::printf("  dpcd=0x%08X maxRate=%s maxLanes=%s currentRate=%s currentLanes=%s\n", info.dpcd_ver,
-              DpLinkRateName(info.maxLinkRate), DpLaneCountName(info.maxLaneCount), DpLinkRateName(info.curLinkRate),
-              DpLaneCountName(info.curLaneCount));
-  std::printf("  format=%s range=%s colorimetry=%s bpc=%s\n", DpColorFormatName(info.colorFormat),
-              DpDynamicRangeName(info.dynamicRange), DpColorimetryName(info.colorimetry), DpBpcName(info.bpc));
-  std::printf("  flags: isDp=%u internal=%u colorCtrl=%u\n", info.isDp ? 1 : 0, info.isInternalDp ? 1 : 0,
-              info.isColorCtrlSupported ? 1 : 0);
-  std::printf("  bpcSupported: 6=%u 8=%u 10=%u 12=%u 16=%u\n", info.is6BPCSupported ? 1 : 0,
-              info.is8BPCSupported ? 1 : 0, info.is10BPCSupported ? 1 : 0, info.is12BPCSupported ? 1 : 0,
-              info.is16BPCSupported ? 1 : 0);
-  std::printf("  ycbcrSupported: 420=%u 422=%u 444=%u\n", info.isYCrCb420Supported ? 1 : 0,
-              info.isYCrCb422Supported ? 1 : 0, info.isYCrCb444Supported ? 1 : 0);
-  std::printf("  currentMode: rgb444=%u ycbcr444=%u ycbcr422=%u ycbcr420=%u\n",
-              info.isRgb444SupportedOnCurrentMode ? 1 : 0, info.isYCbCr444SupportedOnCurrentMode ? 1 : 0,
-              info.isYCbCr422SupportedOnCurrentMode ? 1 : 0, info.isYCbCr420SupportedOnCurrentMode ? 1 : 0);
-  std::printf("  currentBpc: 6=%u 8=%u 10=%u 12=%u 16=%u\n", info.is6BPCSupportedOnCurrentMode ? 1 : 0,
-              info.is8BPCSupportedOnCurrentMode ? 1 : 0, info.is10BPCSupportedOnCurrentMode ? 1 : 0,
-              info.is12BPCSupportedOnCurrentMode ? 1 : 0, info.is16BPCSupportedOnCurrentMode ? 1 : 0);
-  std::printf("  extColorimetry: xvYCC601=%u xvYCC709=%u sYCC601=%u adobeYCC601=%u adobeRGB=%u bt2020rgb=%u "
-              "bt2020ycc=%u bt2020cycc=%u\n",
-              info.isMonxvYCC601Capable ? 1 : 0, info.isMonxvYCC709Capable ? 1 : 0, info.isMonsYCC601Capable ? 1 : 0,
-              info.isMonAdobeYCC601Capable ? 1 : 0, info.isMonAdobeRGBCapable ? 1 : 0,
-              info.isMonBT2020RGBCapable ? 1 : 0, info.isMonBT2020YCCCapable ? 1 : 0,
-              info.isMonBT2020cYCCCapable ? 1 : 0);
+  Printf("DisplayPort info: outputId=0x%08X\n", resolvedOutput);
+  Printf("  dpcd=0x%08X maxRate=%s maxLanes=%s currentRate=%s currentLanes=%s\n", info.dpcd_ver,
+         DpLinkRateName(info.maxLinkRate), DpLaneCountName(info.maxLaneCount), DpLinkRateName(info.curLinkRate),
+         DpLaneCountName(info.curLaneCount));
+  Printf("  format=%s range=%s colorimetry=%s bpc=%s\n", DpColorFormatName(info.colorFormat),
+         DpDynamicRangeName(info.dynamicRange), DpColorimetryName(info.colorimetry), DpBpcName(info.bpc));
+  Printf("  flags: isDp=%u internal=%u colorCtrl=%u\n", info.isDp ? 1 : 0, info.isInternalDp ? 1 : 0,
+         info.isColorCtrlSupported ? 1 : 0);
+  Printf("  bpcSupported: 6=%u 8=%u 10=%u 12=%u 16=%u\n", info.is6BPCSupported ? 1 : 0, info.is8BPCSupported ? 1 : 0,
+         info.is10BPCSupported ? 1 : 0, info.is12BPCSupported ? 1 : 0, info.is16BPCSupported ? 1 : 0);
+  Printf("  ycbcrSupported: 420=%u 422=%u 444=%u\n", info.isYCrCb420Supported ? 1 : 0, info.isYCrCb422Supported ? 1 : 0,
+         info.isYCrCb444Supported ? 1 : 0);
+  Printf("  currentMode: rgb444=%u ycbcr444=%u ycbcr422=%u ycbcr420=%u\n", info.isRgb444SupportedOnCurrentMode ? 1 : 0,
+         info.isYCbCr444SupportedOnCurrentMode ? 1 : 0, info.isYCbCr422SupportedOnCurrentMode ? 1 : 0,
+         info.isYCbCr420SupportedOnCurrentMode ? 1 : 0);
+  Printf("  currentBpc: 6=%u 8=%u 10=%u 12=%u 16=%u\n", info.is6BPCSupportedOnCurrentMode ? 1 : 0,
+         info.is8BPCSupportedOnCurrentMode ? 1 : 0, info.is10BPCSupportedOnCurrentMode ? 1 : 0,
+         info.is12BPCSupportedOnCurrentMode ? 1 : 0, info.is16BPCSupportedOnCurrentMode ? 1 : 0);
+  Printf("  extColorimetry: xvYCC601=%u xvYCC709=%u sYCC601=%u adobeYCC601=%u adobeRGB=%u bt2020rgb=%u "
+         "bt2020ycc=%u bt2020cycc=%u\n",
+         info.isMonxvYCC601Capable ? 1 : 0, info.isMonxvYCC709Capable ? 1 : 0, info.isMonsYCC601Capable ? 1 : 0,
+         info.isMonAdobeYCC601Capable ? 1 : 0, info.isMonAdobeRGBCapable ? 1 : 0,
+         info.isMonBT2020RGBCapable ? 1 : 0, info.isMonBT2020YCCCapable ? 1 : 0,
+         info.isMonBT2020cYCCCapable ? 1 : 0);
   return 0;
 }
 
@@ -369,7 +369,7 @@ int CmdDpSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -378,7 +378,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--handle-index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &handleIndex)) {
-        std::printf("Invalid handle index.\n");
+        Printf("Invalid handle index.\n");
         return 1;
       }
       ++i;
@@ -386,7 +386,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--output-id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &outputId)) {
-        std::printf("Invalid output id.\n");
+        Printf("Invalid output id.\n");
         return 1;
       }
       hasOutputId = true;
@@ -395,7 +395,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--link-rate") == 0) {
       if (i + 1 >= argc || !ParseDpLinkRate(argv[i + 1], &linkRate)) {
-        std::printf("Invalid --link-rate value.\n");
+        Printf("Invalid --link-rate value.\n");
         return 1;
       }
       hasLinkRate = true;
@@ -404,7 +404,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--lane-count") == 0) {
       if (i + 1 >= argc || !ParseDpLaneCount(argv[i + 1], &laneCount)) {
-        std::printf("Invalid --lane-count value.\n");
+        Printf("Invalid --lane-count value.\n");
         return 1;
       }
       hasLaneCount = true;
@@ -413,7 +413,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--format") == 0) {
       if (i + 1 >= argc || !ParseDpColorFormat(argv[i + 1], &colorFormat)) {
-        std::printf("Invalid --format value.\n");
+        Printf("Invalid --format value.\n");
         return 1;
       }
       hasColorFormat = true;
@@ -422,7 +422,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--range") == 0) {
       if (i + 1 >= argc || !ParseDpDynamicRange(argv[i + 1], &dynamicRange)) {
-        std::printf("Invalid --range value.\n");
+        Printf("Invalid --range value.\n");
         return 1;
       }
       hasDynamicRange = true;
@@ -431,7 +431,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--colorimetry") == 0) {
       if (i + 1 >= argc || !ParseDpColorimetry(argv[i + 1], &colorimetry)) {
-        std::printf("Invalid --colorimetry value.\n");
+        Printf("Invalid --colorimetry value.\n");
         return 1;
       }
       hasColorimetry = true;
@@ -440,7 +440,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--bpc") == 0) {
       if (i + 1 >= argc || !ParseDpBpc(argv[i + 1], &bpc)) {
-        std::printf("Invalid --bpc value.\n");
+        Printf("Invalid --bpc value.\n");
         return 1;
       }
       hasBpc = true;
@@ -449,7 +449,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--hpd") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &hpd)) {
-        std::printf("Invalid --hpd value.\n");
+        Printf("Invalid --hpd value.\n");
         return 1;
       }
       hasHpd = true;
@@ -458,7 +458,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--defer") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &defer)) {
-        std::printf("Invalid --defer value.\n");
+        Printf("Invalid --defer value.\n");
         return 1;
       }
       hasDefer = true;
@@ -467,7 +467,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--chroma-lpf-off") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &chromaLpfOff)) {
-        std::printf("Invalid --chroma-lpf-off value.\n");
+        Printf("Invalid --chroma-lpf-off value.\n");
         return 1;
       }
       hasChromaLpfOff = true;
@@ -476,7 +476,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--dither-off") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &ditherOff)) {
-        std::printf("Invalid --dither-off value.\n");
+        Printf("Invalid --dither-off value.\n");
         return 1;
       }
       hasDitherOff = true;
@@ -485,7 +485,7 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--test-link-train") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &testLinkTrain)) {
-        std::printf("Invalid --test-link-train value.\n");
+        Printf("Invalid --test-link-train value.\n");
         return 1;
       }
       hasTestLinkTrain = true;
@@ -494,25 +494,25 @@ int CmdDpSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--test-color-change") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &testColorChange)) {
-        std::printf("Invalid --test-color-change value.\n");
+        Printf("Invalid --test-color-change value.\n");
         return 1;
       }
       hasTestColorChange = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId && !hasOutputId) {
-    std::printf("Missing required --id or --output-id\n");
+    Printf("Missing required --id or --output-id\n");
     return 1;
   }
 
   if (!hasLinkRate && !hasLaneCount && !hasColorFormat && !hasDynamicRange && !hasColorimetry && !hasBpc && !hasHpd &&
       !hasDefer && !hasChromaLpfOff && !hasDitherOff && !hasTestLinkTrain && !hasTestColorChange) {
-    std::printf("No DisplayPort changes specified.\n");
+    Printf("No DisplayPort changes specified.\n");
     return 1;
   }
 
@@ -525,7 +525,7 @@ int CmdDpSet(int argc, char **argv) {
 
   NV_DISPLAY_PORT_INFO info = {};
   info.version = NV_DISPLAY_PORT_INFO_VER;
-  NvAPI_Status status = NvAPI_GetDisplayPortInfo(handle, resolvedOutput, &info);
+  NvAPI_Status status = NvApi().NvAPI_GetDisplayPortInfo(handle, resolvedOutput, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GetDisplayPortInfo failed", status);
     return 1;
@@ -553,20 +553,20 @@ int CmdDpSet(int argc, char **argv) {
   if (hasTestLinkTrain) { config.testLinkTrain = testLinkTrain ? 1 : 0; }
   if (hasTestColorChange) { config.testColorChange = testColorChange ? 1 : 0; }
 
-  std::printf("DisplayPort set: linkRate=%s laneCount=%s format=%s range=%s colorimetry=%s bpc=%s\n",
-              DpLinkRateName(config.linkRate), DpLaneCountName(config.laneCount), DpColorFormatName(config.colorFormat),
-              DpDynamicRangeName(config.dynamicRange), DpColorimetryName(config.colorimetry), DpBpcName(config.bpc));
-  std::printf("  flags: hpd=%u defer=%u chromaLpfOff=%u ditherOff=%u testLinkTrain=%u testColorChange=%u\n",
-              config.isHPD ? 1 : 0, config.isSetDeferred ? 1 : 0, config.isChromaLpfOff ? 1 : 0,
-              config.isDitherOff ? 1 : 0, config.testLinkTrain ? 1 : 0, config.testColorChange ? 1 : 0);
+  Printf("DisplayPort set: linkRate=%s laneCount=%s format=%s range=%s colorimetry=%s bpc=%s\n",
+         DpLinkRateName(config.linkRate), DpLaneCountName(config.laneCount), DpColorFormatName(config.colorFormat),
+         DpDynamicRangeName(config.dynamicRange), DpColorimetryName(config.colorimetry), DpBpcName(config.bpc));
+  Printf("  flags: hpd=%u defer=%u chromaLpfOff=%u ditherOff=%u testLinkTrain=%u testColorChange=%u\n",
+         config.isHPD ? 1 : 0, config.isSetDeferred ? 1 : 0, config.isChromaLpfOff ? 1 : 0, config.isDitherOff ? 1 : 0,
+         config.testLinkTrain ? 1 : 0, config.testColorChange ? 1 : 0);
 
-  status = NvAPI_SetDisplayPort(handle, resolvedOutput, &config);
+  status = NvApi().NvAPI_SetDisplayPort(handle, resolvedOutput, &config);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_SetDisplayPort failed", status);
     return 1;
   }
 
-  std::printf("DisplayPort configuration updated.\n");
+  Printf("DisplayPort configuration updated.\n");
   return 0;
 }
 
@@ -579,7 +579,7 @@ int CmdDpDongle(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index.\n");
+        Printf("Invalid GPU index.\n");
         return 1;
       }
       hasIndex = true;
@@ -588,19 +588,19 @@ int CmdDpDongle(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--output-id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &outputId)) {
-        std::printf("Invalid output id.\n");
+        Printf("Invalid output id.\n");
         return 1;
       }
       hasOutputId = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasOutputId) {
-    std::printf("Missing required --output-id\n");
+    Printf("Missing required --output-id\n");
     return 1;
   }
 
@@ -608,41 +608,40 @@ int CmdDpDongle(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_NVAPI_GET_DP_DONGLE_INFO info = {};
     info.version = NV_NVAPI_GET_DP_DONGLE_INFO_VER;
     info.input.displayMask = outputId;
-    NvAPI_Status status = NvAPI_GPU_Get_DisplayPort_DongleInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_Get_DisplayPort_DongleInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_Get_DisplayPort_DongleInfo failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  DP dongle outputId=0x%08X\n", outputId);
-    std::printf("    isDP2DVI=%u isDP2HDMI=%u isDP2VGA=%u\n", info.output.isDP2DVI ? 1 : 0,
-                info.output.isDP2HDMI ? 1 : 0, info.output.isDP2VGA ? 1 : 0);
-    std::printf("    isDP2DVIActive=%u isDP2HDMIActive=%u\n", info.output.isDP2DVIActive ? 1 : 0,
-                info.output.isDP2HDMIActive ? 1 : 0);
-    std::printf("    isDMS592DVI=%u isDMS592VGA=%u\n", info.output.isDMS592DVI ? 1 : 0,
-                info.output.isDMS592VGA ? 1 : 0);
-  }
-  return 0;
+    Printf("  DP dongle outputId=0x%08X\n", outputId);
+    Printf("    isDP2DVI=%u isDP2HDMI=%u isDP2VGA=%u\n", info.output.isDP2DVI ? 1 : 0, info.output.isDP2HDMI ? 1 : 0,
+           info.output.isDP2VGA ? 1 : 0);
+    Printf("    isDP2DVIActive=%u isDP2HDMIActive=%u\n", info.output.isDP2DVIActive ? 1 : 0,
+           info.output.isDP2HDMIActive ? 1 : 0);
+    Printf("    isDMS592DVI=%u isDMS592VGA=%u\n", info.output.isDMS592DVI ? 1 : 0, info.output.isDMS592VGA ? 1 : 0);
+    return 0;
+  });
 }
 
 void PrintDpNodeInfo(const NV_DP_NODE_INFO &node) {
-  std::printf("  node displayId=0x%08X type=%s guid=%s\n", node.displayId, DpNodeTypeName(node.nodeType),
-              GuidToString(node.guid).c_str());
-
-  std::printf("    flags: multi=%u video=%u audio=%u loop=%u redundant=%u mustDisc=%u zombie=%u cableOk=%u\n",
-              node.flags.isMultistream ? 1 : 0, node.flags.isVideoSink ? 1 : 0, node.flags.isAudioSink ? 1 : 0,
-              node.flags.isLoop ? 1 : 0, node.flags.isRedundant ? 1 : 0, node.flags.isMustDisconnect ? 1 : 0,
-              node.flags.isZombie ? 1 : 0, node.flags.isCableOk ? 1 : 0);
-  std::printf("    flags: powerSuspended=%u active=%u hdcpCapable=%u hdcpPath=%u hdcpActive=%u revoked=%u\n",
-              node.flags.isPowerSuspended ? 1 : 0, node.flags.isActive ? 1 : 0, node.flags.isHdcpCapable ? 1 : 0,
-              node.flags.isPathHdcpCapable ? 1 : 0, node.flags.isHdcpActive ? 1 : 0, node.flags.isRevoked ? 1 : 0);
-  std::printf("    ports: valid=0x%04X input=0x%04X internal=0x%04X\n", node.branchDevicePortsInfo.validPortsMask,
-              node.branchDevicePortsInfo.inputPortsMask, node.branchDevicePortsInfo.internalPortsMask);
+  Printf("  node displayId=0x%08X type=%s guid=%s\n", node.displayId, DpNodeTypeName(node.nodeType),
+         GuidToString(node.guid).c_str());
+
+  Printf("    flags: multi=%u video=%u audio=%u loop=%u redundant=%u mustDisc=%u zombie=%u cableOk=%u\n",
+         node.flags.isMultistream ? 1 : 0, node.flags.isVideoSink ? 1 : 0, node.flags.isAudioSink ? 1 : 0,
+         node.flags.isLoop ? 1 : 0, node.flags.isRedundant ? 1 : 0, node.flags.isMustDisconnect ? 1 : 0,
+         node.flags.isZombie ? 1 : 0, node.flags.isCableOk ? 1 : 0);
+  Printf("    flags: powerSuspended=%u active=%u hdcpCapable=%u hdcpPath=%u hdcpActive=%u revoked=%u\n",
+         node.flags.isPowerSuspended ? 1 : 0, node.flags.isActive ? 1 : 0, node.flags.isHdcpCapable ? 1 : 0,
+         node.flags.isPathHdcpCapable ? 1 : 0, node.flags.isHdcpActive ? 1 : 0, node.flags.isRevoked ? 1 : 0);
+  Printf("    ports: valid=0x%04X input=0x%04X internal=0x%04X\n", node.branchDevicePortsInfo.validPortsMask,
+         node.branchDevicePortsInfo.inputPortsMask, node.branchDevicePortsInfo.internalPortsMask);
 }
 
 int CmdDpTopology(int argc, char **argv) {
@@ -654,7 +653,7 @@ int CmdDpTopology(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -663,37 +662,37 @@ int CmdDpTopology(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--flags") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &flags)) {
-        std::printf("Invalid flags.\n");
+        Printf("Invalid flags.\n");
         return 1;
       }
       hasFlags = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDisplayId) {
-    std::printf("Missing required --id\n");
+    Printf("Missing required --id\n");
     return 1;
   }
 
   if (hasFlags) {
-    std::printf("DP topology flags are not supported by this NVAPI build. Re-run without --flags.\n");
+    Printf("DP topology flags are not supported by this NVAPI build. Re-run without --flags.\n");
     return 1;
   }
 
   NvU32 nodeCount = NV_DP_MAX_TOPOLOGY_NODES;
   std::vector<NV_DP_NODE_INFO> nodes(nodeCount);
   for (NvU32 i = 0; i < nodeCount; ++i) { nodes[i].version = NV_DP_NODE_INFO_VER; }
-  NvAPI_Status status = NvAPI_GPU_QueryDPTopology(displayId, nodes.data(), &nodeCount);
+  NvAPI_Status status = NvApi().NvAPI_GPU_QueryDPTopology(displayId, nodes.data(), &nodeCount);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GPU_QueryDPTopology failed", status);
     return 1;
   }
 
-  std::printf("DP topology nodes: %u\n", nodeCount);
+  Printf("DP topology nodes: %u\n", nodeCount);
   for (NvU32 i = 0; i < nodeCount; ++i) { PrintDpNodeInfo(nodes[i]); }
   return 0;
 }
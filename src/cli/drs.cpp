@@ -43,16 +43,16 @@ int CmdDrsProfiles() {
   }
 
   NvU32 count = 0;
-  NvAPI_Status status = NvAPI_DRS_GetNumProfiles(session.handle(), &count);
+  NvAPI_Status status = NvApi().NvAPI_DRS_GetNumProfiles(session.handle(), &count);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DRS_GetNumProfiles failed", status);
     return 1;
   }
 
-  std::printf("DRS profiles: %u\n", count);
+  Printf("DRS profiles: %u\n", count);
   for (NvU32 i = 0; i < count; ++i) {
     NvDRSProfileHandle profile = NULL;
-    status = NvAPI_DRS_EnumProfiles(session.handle(), i, &profile);
+    status = NvApi().NvAPI_DRS_EnumProfiles(session.handle(), i, &profile);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_DRS_EnumProfiles failed", status);
       return 1;
@@ -60,15 +60,15 @@ int CmdDrsProfiles() {
 
     NVDRS_PROFILE info = {};
     info.version = NVDRS_PROFILE_VER;
-    status = NvAPI_DRS_GetProfileInfo(session.handle(), profile, &info);
+    status = NvApi().NvAPI_DRS_GetProfileInfo(session.handle(), profile, &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_DRS_GetProfileInfo failed", status);
       return 1;
     }
 
     std::string name = NvUnicodeToUtf8(info.profileName);
-    std::printf("  [%u] %s predefined=%u apps=%u settings=%u\n", i, name.empty() ? "<unnamed>" : name.c_str(),
-                info.isPredefined, info.numOfApps, info.numOfSettings);
+    Printf("  [%u] %s predefined=%u apps=%u settings=%u\n", i, name.empty() ? "<unnamed>" : name.c_str(),
+           info.isPredefined, info.numOfApps, info.numOfSettings);
   }
 
   return 0;
@@ -79,19 +79,19 @@ int CmdDrsApps(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--profile") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --profile\n");
+        Printf("Missing value for --profile\n");
         return 1;
       }
       profileName = argv[i + 1];
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!profileName) {
-    std::printf("Missing required --profile\n");
+    Printf("Missing required --profile\n");
     return 1;
   }
 
@@ -104,7 +104,7 @@ int CmdDrsApps(int argc, char **argv) {
   NvDRSProfileHandle profile = NULL;
   if (!GetDrsProfileByName(session.handle(), profileName, &profile)) { return 1; }
 
-  std::printf("Applications for profile: %s\n", profileName);
+  Printf("Applications for profile: %s\n", profileName);
   NvU32 start = 0;
   const NvU32 batchSize = 32;
   while (true) {
@@ -115,7 +115,7 @@ int CmdDrsApps(int argc, char **argv) {
       apps[i].version = NVDRS_APPLICATION_VER;
     }
 
-    NvAPI_Status status = NvAPI_DRS_EnumApplications(session.handle(), profile, start, &count, apps.data());
+    NvAPI_Status status = NvApi().NvAPI_DRS_EnumApplications(session.handle(), profile, start, &count, apps.data());
     if (status == NVAPI_END_ENUMERATION || count == 0) { break; }
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_DRS_EnumApplications failed", status);
@@ -125,8 +125,8 @@ int CmdDrsApps(int argc, char **argv) {
     for (NvU32 i = 0; i < count; ++i) {
       std::string appName = NvUnicodeToUtf8(apps[i].appName);
       std::string friendly = NvUnicodeToUtf8(apps[i].userFriendlyName);
-      std::printf("  %s (%s)\n", appName.empty() ? "<unnamed>" : appName.c_str(),
-                  friendly.empty() ? "<no description>" : friendly.c_str());
+      Printf("  %s (%s)\n", appName.empty() ? "<unnamed>" : appName.c_str(),
+             friendly.empty() ? "<no description>" : friendly.c_str());
     }
 
     start += count;
@@ -143,7 +143,7 @@ int CmdDrsSettings(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--profile") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --profile\n");
+        Printf("Missing value for --profile\n");
         return 1;
       }
       profileName = argv[i + 1];
@@ -152,11 +152,11 @@ int CmdDrsSettings(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--start") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --start\n");
+        Printf("Missing value for --start\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &start)) {
-        std::printf("Invalid start: %s\n", argv[i + 1]);
+        Printf("Invalid start: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
@@ -164,22 +164,22 @@ int CmdDrsSettings(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--limit") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --limit\n");
+        Printf("Missing value for --limit\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &limit)) {
-        std::printf("Invalid limit: %s\n", argv[i + 1]);
+        Printf("Invalid limit: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!profileName) {
-    std::printf("Missing required --profile\n");
+    Printf("Missing required --profile\n");
     return 1;
   }
 
@@ -192,7 +192,11 @@ int CmdDrsSettings(int argc, char **argv) {
   NvDRSProfileHandle profile = NULL;
   if (!GetDrsProfileByName(session.handle(), profileName, &profile)) { return 1; }
 
-  std::printf("Settings for profile: %s\n", profileName);
+  if (StructuredOutput()) {
+    RecordWriter("drs_profile").Field("name", profileName);
+  } else {
+    Printf("Settings for profile: %s\n", profileName);
+  }
 
   NvU32 printed = 0;
   const NvU32 batchSize = 32;
@@ -202,7 +206,7 @@ int CmdDrsSettings(int argc, char **argv) {
     std::vector<NVDRS_SETTING> settings(count);
     for (NvU32 i = 0; i < count; ++i) { InitDrsSetting(&settings[i]); }
 
-    NvAPI_Status status = NvAPI_DRS_EnumSettings(session.handle(), profile, index, &count, settings.data());
+    NvAPI_Status status = NvApi().NvAPI_DRS_EnumSettings(session.handle(), profile, index, &count, settings.data());
     if (status == NVAPI_END_ENUMERATION || count == 0) { break; }
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_DRS_EnumSettings failed", status);
@@ -216,7 +220,7 @@ int CmdDrsSettings(int argc, char **argv) {
     index += count;
   }
 
-  if (printed == 0) { std::printf("  <no settings>\n"); }
+  if (printed == 0) { Printf("  <no settings>\n"); }
   return 0;
 }
 
@@ -229,7 +233,7 @@ int CmdDrsSettingGet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--profile") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --profile\n");
+        Printf("Missing value for --profile\n");
         return 1;
       }
       profileName = argv[i + 1];
@@ -238,11 +242,11 @@ int CmdDrsSettingGet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --id\n");
+        Printf("Missing value for --id\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &settingId)) {
-        std::printf("Invalid id: %s\n", argv[i + 1]);
+        Printf("Invalid id: %s\n", argv[i + 1]);
         return 1;
       }
       hasId = true;
@@ -251,23 +255,23 @@ int CmdDrsSettingGet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--name") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --name\n");
+        Printf("Missing value for --name\n");
         return 1;
       }
       settingName = argv[i + 1];
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!profileName) {
-    std::printf("Missing required --profile\n");
+    Printf("Missing required --profile\n");
     return 1;
   }
   if (!hasId && !settingName) {
-    std::printf("Missing required --id or --name\n");
+    Printf("Missing required --id or --name\n");
     return 1;
   }
 
@@ -286,7 +290,7 @@ int CmdDrsSettingGet(int argc, char **argv) {
 
   NVDRS_SETTING setting;
   InitDrsSetting(&setting);
-  NvAPI_Status status = NvAPI_DRS_GetSetting(session.handle(), profile, settingId, &setting);
+  NvAPI_Status status = NvApi().NvAPI_DRS_GetSetting(session.handle(), profile, settingId, &setting);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DRS_GetSetting failed", status);
     return 1;
@@ -307,7 +311,7 @@ int CmdDrsSettingSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--profile") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --profile\n");
+        Printf("Missing value for --profile\n");
         return 1;
       }
       profileName = argv[i + 1];
@@ -316,11 +320,11 @@ int CmdDrsSettingSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--id") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --id\n");
+        Printf("Missing value for --id\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &settingId)) {
-        std::printf("Invalid id: %s\n", argv[i + 1]);
+        Printf("Invalid id: %s\n", argv[i + 1]);
         return 1;
       }
       hasId = true;
@@ -329,7 +333,7 @@ int CmdDrsSettingSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--name") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --name\n");
+        Printf("Missing value for --name\n");
         return 1;
       }
       settingName = argv[i + 1];
@@ -338,31 +342,31 @@ int CmdDrsSettingSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--dword") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --dword\n");
+        Printf("Missing value for --dword\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &value)) {
-        std::printf("Invalid dword value: %s\n", argv[i + 1]);
+        Printf("Invalid dword value: %s\n", argv[i + 1]);
         return 1;
       }
       hasValue = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!profileName) {
-    std::printf("Missing required --profile\n");
+    Printf("Missing required --profile\n");
     return 1;
   }
   if (!hasId && !settingName) {
-    std::printf("Missing required --id or --name\n");
+    Printf("Missing required --id or --name\n");
     return 1;
   }
   if (!hasValue) {
-    std::printf("Missing required --dword\n");
+    Printf("Missing required --dword\n");
     return 1;
   }
 
@@ -370,7 +374,7 @@ int CmdDrsSettingSet(int argc, char **argv) {
     if (!GetDrsSettingIdByName(settingName, &settingId)) { return 1; }
   }
 
-  std::printf("DRS set: profile=%s settingId=0x%08X value=0x%08X (%u)\n", profileName, settingId, value, value);
+  Printf("DRS set: profile=%s settingId=0x%08X value=0x%08X (%u)\n", profileName, settingId, value, value);
 
   DrsSession session;
   if (!session.ok()) {
@@ -390,19 +394,19 @@ int CmdDrsSettingSet(int argc, char **argv) {
   setting.isCurrentPredefined = 0;
   setting.isPredefinedValid = 0;
 
-  NvAPI_Status status = NvAPI_DRS_SetSetting(session.handle(), profile, &setting);
+  NvAPI_Status status = NvApi().NvAPI_DRS_SetSetting(session.handle(), profile, &setting);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DRS_SetSetting failed", status);
     return 1;
   }
 
-  status = NvAPI_DRS_SaveSettings(session.handle());
+  status = NvApi().NvAPI_DRS_SaveSettings(session.handle());
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DRS_SaveSettings failed", status);
     return 1;
   }
 
-  std::printf("DRS setting updated.\n");
+  Printf("DRS setting updated.\n");
   return 0;
 }
 
@@ -412,23 +416,23 @@ int CmdDrsProfileCreate(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--name") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --name\n");
+        Printf("Missing value for --name\n");
         return 1;
       }
       profileName = argv[i + 1];
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!profileName) {
-    std::printf("Missing required --name\n");
+    Printf("Missing required --name\n");
     return 1;
   }
 
-  std::printf("DRS create profile: %s\n", profileName);
+  Printf("DRS create profile: %s\n", profileName);
 
   DrsSession session;
   if (!session.ok()) {
@@ -439,24 +443,24 @@ int CmdDrsProfileCreate(int argc, char **argv) {
   NVDRS_PROFILE profile = {};
   profile.version = NVDRS_PROFILE_VER;
   if (!Utf8ToNvUnicode(profileName, profile.profileName)) {
-    std::printf("Invalid profile name encoding.\n");
+    Printf("Invalid profile name encoding.\n");
     return 1;
   }
 
   NvDRSProfileHandle handle = NULL;
-  NvAPI_Status status = NvAPI_DRS_CreateProfile(session.handle(), &profile, &handle);
+  NvAPI_Status status = NvApi().NvAPI_DRS_CreateProfile(session.handle(), &profile, &handle);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DRS_CreateProfile failed", status);
     return 1;
   }
 
-  status = NvAPI_DRS_SaveSettings(session.handle());
+  status = NvApi().NvAPI_DRS_SaveSettings(session.handle());
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DRS_SaveSettings failed", status);
     return 1;
   }
 
-  std::printf("DRS profile created.\n");
+  Printf("DRS profile created.\n");
   return 0;
 }
 
@@ -466,23 +470,23 @@ int CmdDrsProfileDelete(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--name") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --name\n");
+        Printf("Missing value for --name\n");
         return 1;
       }
       profileName = argv[i + 1];
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!profileName) {
-    std::printf("Missing required --name\n");
+    Printf("Missing required --name\n");
     return 1;
   }
 
-  std::printf("DRS delete profile: %s\n", profileName);
+  Printf("DRS delete profile: %s\n", profileName);
 
   DrsSession session;
   if (!session.ok()) {
@@ -493,19 +497,19 @@ int CmdDrsProfileDelete(int argc, char **argv) {
   NvDRSProfileHandle profile = NULL;
   if (!GetDrsProfileByName(session.handle(), profileName, &profile)) { return 1; }
 
-  NvAPI_Status status = NvAPI_DRS_DeleteProfile(session.handle(), profile);
+  NvAPI_Status status = NvApi().NvAPI_DRS_DeleteProfile(session.handle(), profile);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DRS_DeleteProfile failed", status);
     return 1;
   }
 
-  status = NvAPI_DRS_SaveSettings(session.handle());
+  status = NvApi().NvAPI_DRS_SaveSettings(session.handle());
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_DRS_SaveSettings failed", status);
     return 1;
   }
 
-  std::printf("DRS profile deleted.\n");
+  Printf("DRS profile deleted.\n");
   return 0;
 }
 
@@ -518,7 +522,9 @@ int CmdDrs(int argc, char **argv) {
   static const SubcommandEntry kSubcommands[] = {
       {"profiles", CmdDrsProfilesAdapter}, {"apps", CmdDrsApps},
       {"settings", CmdDrsSettings},        {"setting", CmdDrsSettingDispatch},
-      {"profile", CmdDrsProfileDispatch},
+      {"profile", CmdDrsProfileDispatch},  {"apply", CmdDrsApply},
+      {"export", CmdDrsExport},            {"import", CmdDrsImport},
+      {"query", CmdDrsQuery},              {"diff", CmdDrsDiff},
   };
 
   return DispatchSubcommand("drs", argc, argv, kSubcommands, sizeof(kSubcommands) / sizeof(kSubcommands[0]),
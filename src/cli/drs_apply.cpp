@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/drs_image.h"
+
+namespace nvcli {
+namespace {
+struct DrsApplyStats {
+  NvU32 profiles = 0;
+  NvU32 apps = 0;
+  NvU32 settings = 0;
+  NvU32 unchanged = 0;
+
+  NvU32 changes() const { return profiles + apps + settings; }
+};
+
+bool ManifestError(const char *path, NvU32 line, const char *message, const std::string &detail) {
+  Printf("%s:%u: %s%s%s\n", path, line, message, detail.empty() ? "" : ": ", detail.c_str());
+  return false;
+}
+
+// One directive per line, tokens split like batch files (double quotes group words):
+//   profile NAME [delete]
+//   app EXE [delete]
+//   setting ID|NAME VALUE | string TEXT | delete
+// app and setting lines belong to the closest profile line above them.
+bool ParseDrsManifest(const char *path, std::vector<DrsManifestProfile> *profiles) {
+  FILE *file = nullptr;
+  if (fopen_s(&file, path, "r") != 0 || !file) {
+    Printf("Failed to open %s\n", path);
+    return false;
+  }
+
+  bool ok = true;
+  NvU32 lineNumber = 0;
+  std::string line;
+  std::vector<std::string> args;
+  char buffer[1024];
+  while (ok && std::fgets(buffer, sizeof(buffer), file)) {
+    line.assign(buffer);
+    while (!line.empty() && line.back() != '\n' && std::fgets(buffer, sizeof(buffer), file)) { line.append(buffer); }
+    while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) { line.pop_back(); }
+    ++lineNumber;
+    if (!SplitCommandLine(line, args)) {
+      ok = ManifestError(path, lineNumber, "unterminated quote", std::string());
+      break;
+    }
+    if (args.empty() || args[0][0] == '#') { continue; }
+
+    const std::string &keyword = args[0];
+    const bool remove = args.size() == 3 && args[2] == "delete";
+    if (keyword == "profile") {
+      if (args.size() != 2 && !remove) {
+        ok = ManifestError(path, lineNumber, "expected: profile NAME [delete]", std::string());
+        break;
+      }
+      DrsManifestProfile profile = {};
+      profile.name = args[1];
+      profile.remove = remove;
+      profile.line = lineNumber;
+      profiles->push_back(profile);
+      continue;
+    }
+
+    if (profiles->empty()) {
+      ok = ManifestError(path, lineNumber, "directive before the first profile line", keyword);
+      break;
+    }
+    DrsManifestProfile &profile = profiles->back();
+    if (profile.remove) {
+      ok = ManifestError(path, lineNumber, "profile is deleted, cannot change it", profile.name);
+      break;
+    }
+
+    if (keyword == "app") {
+      if (args.size() != 2 && !remove) {
+        ok = ManifestError(path, lineNumber, "expected: app EXE [delete]", std::string());
+        break;
+      }
+      DrsManifestApp app = {};
+      app.app.name = args[1];
+      app.remove = remove;
+      app.line = lineNumber;
+      profile.apps.push_back(app);
+      continue;
+    }
+
+    if (keyword == "setting") {
+      const bool isString = args.size() == 4 && args[2] == "string";
+      if (args.size() != 3 && !isString) {
+        ok = ManifestError(path, lineNumber, "expected: setting ID|NAME (VALUE|string TEXT|delete)", std::string());
+        break;
+      }
+      DrsManifestSetting setting = {};
+      setting.remove = remove;
+      setting.line = lineNumber;
+      setting.setting.type = isString ? NVDRS_WSTRING_TYPE : NVDRS_DWORD_TYPE;
+      if (!ParseUint(args[1].c_str(), &setting.setting.id)) {
+        setting.setting.name = args[1];
+        setting.byName = true;
+      }
+      if (isString) {
+        NvAPI_UnicodeString check = {};
+        if (!Utf8ToNvUnicode(args[3].c_str(), check)) {
+          ok = ManifestError(path, lineNumber, "invalid string value", args[3]);
+          break;
+        }
+        setting.setting.text = args[3];
+      } else if (!remove && !ParseUint(args[2].c_str(), &setting.setting.dword)) {
+        ok = ManifestError(path, lineNumber, "invalid dword value", args[2]);
+        break;
+      }
+      profile.settings.push_back(setting);
+      continue;
+    }
+
+    ok = ManifestError(path, lineNumber, "unknown directive", keyword);
+  }
+  std::fclose(file);
+  return ok;
+}
+
+bool ApplyFailed(const DrsManifestProfile &profile, NvU32 line, const char *call, NvAPI_Status status) {
+  if (line > 0) {
+    Printf("Line %u: ", line);
+  } else {
+    Printf("Profile %s: ", profile.name.c_str());
+  }
+  PrintNvapiError(call, status);
+  return false;
+}
+
+void PrintApplyChange(const char *action, const std::string &profile, const char *target, const std::string &detail) {
+  if (StructuredOutput()) {
+    RecordWriter("drs_apply_change")
+        .Field("action", action)
+        .Field("profile", profile)
+        .Field("target", target)
+        .Field("detail", detail);
+    return;
+  }
+  Printf("  %-14s %s%s%s%s%s\n", action, profile.c_str(), *target ? " " : "", target, detail.empty() ? "" : " ",
+         detail.c_str());
+}
+
+// The diff is computed against the index, only the changes themselves go through NVAPI.
+bool ApplyDrsSettings(NvDRSSessionHandle session, DrsIndex &index, size_t slot, const DrsManifestProfile &profile,
+                      DrsApplyStats *stats) {
+  char target[16];
+  for (const auto &entry : profile.settings) {
+    const DrsDbSetting &wanted = entry.setting;
+    std::snprintf(target, sizeof(target), "0x%08X", wanted.id);
+    const DrsDbSetting *current = index.FindSetting(slot, wanted.id);
+
+    if (entry.remove) {
+      if (!current || current->isPredefined) {
+        ++stats->unchanged;
+        continue;
+      }
+      const NvAPI_Status status = NvApi().NvAPI_DRS_DeleteProfileSetting(session, index.handle(slot), wanted.id);
+      if (status != NVAPI_OK) {
+        return ApplyFailed(profile, entry.line, "NvAPI_DRS_DeleteProfileSetting failed", status);
+      }
+      PrintApplyChange("delete-setting", profile.name, target, DescribeDrsValue(*current));
+      index.RemoveSetting(slot, wanted.id);
+      ++stats->settings;
+      continue;
+    }
+
+    if (current && SameDrsValue(*current, wanted)) {
+      ++stats->unchanged;
+      continue;
+    }
+
+    NVDRS_SETTING setting;
+    InitDrsSetting(&setting);
+    setting.settingId = wanted.id;
+    setting.settingType = wanted.type;
+    setting.settingLocation = NVDRS_CURRENT_PROFILE_LOCATION;
+    switch (wanted.type) {
+    case NVDRS_DWORD_TYPE: setting.u32CurrentValue = wanted.dword; break;
+    case NVDRS_BINARY_TYPE:
+      setting.binaryCurrentValue.valueLength = static_cast<NvU32>(wanted.binary.size());
+      if (!wanted.binary.empty()) {
+        std::memcpy(setting.binaryCurrentValue.valueData, wanted.binary.data(), wanted.binary.size());
+      }
+      break;
+    default: Utf8ToNvUnicode(wanted.text.c_str(), setting.wszCurrentValue); break;
+    }
+    const NvAPI_Status status = NvApi().NvAPI_DRS_SetSetting(session, index.handle(slot), &setting);
+    if (status != NVAPI_OK) { return ApplyFailed(profile, entry.line, "NvAPI_DRS_SetSetting failed", status); }
+    const std::string before = current ? DescribeDrsValue(*current) : std::string("<unset>");
+    PrintApplyChange("set-setting", profile.name, target, before + " -> " + DescribeDrsValue(wanted));
+    DrsDbSetting stored = wanted;
+    stored.isPredefined = false;
+    index.SetSetting(slot, stored);
+    ++stats->settings;
+  }
+  return true;
+}
+
+// An executable belongs to one profile, adding it to a second one is refused here by name instead of by the
+// NVAPI_EXECUTABLE_ALREADY_IN_USE from NvAPI_DRS_CreateApplication.
+bool ApplyDrsApps(NvDRSSessionHandle session, DrsIndex &index, size_t slot, const DrsManifestProfile &profile,
+                  DrsApplyStats *stats) {
+  for (const auto &entry : profile.apps) {
+    const DrsDbApp &wanted = entry.app;
+    const bool present = index.FindApp(slot, wanted.name) != nullptr;
+    if (present != entry.remove) {
+      ++stats->unchanged;
+      continue;
+    }
+    const std::vector<size_t> &owners = index.ProfilesForApp(wanted.name);
+    if (!entry.remove && !owners.empty()) {
+      if (entry.line > 0) {
+        Printf("Line %u: ", entry.line);
+      } else {
+        Printf("Profile %s: ", profile.name.c_str());
+      }
+      Printf("%s already belongs to profile %s\n", wanted.name.c_str(), index.profile(owners.front()).name.c_str());
+      return false;
+    }
+
+    NVDRS_APPLICATION app = {};
+    app.version = NVDRS_APPLICATION_VER;
+    if (!Utf8ToNvUnicode(wanted.name.c_str(), app.appName)) {
+      Printf("Profile %s: invalid application name encoding: %s\n", profile.name.c_str(), wanted.name.c_str());
+      return false;
+    }
+    if (entry.remove) {
+      const NvAPI_Status status = NvApi().NvAPI_DRS_DeleteApplication(session, index.handle(slot), app.appName);
+      if (status != NVAPI_OK) {
+        return ApplyFailed(profile, entry.line, "NvAPI_DRS_DeleteApplication failed", status);
+      }
+      index.RemoveApp(slot, wanted.name);
+    } else {
+      Utf8ToNvUnicode(wanted.friendlyName.c_str(), app.userFriendlyName);
+      Utf8ToNvUnicode(wanted.launcher.c_str(), app.launcher);
+      Utf8ToNvUnicode(wanted.fileInFolder.c_str(), app.fileInFolder);
+      Utf8ToNvUnicode(wanted.commandLine.c_str(), app.commandLine);
+      app.isMetro = wanted.isMetro ? 1 : 0;
+      app.isCommandLine = wanted.isCommandLine ? 1 : 0;
+      const NvAPI_Status status = NvApi().NvAPI_DRS_CreateApplication(session, index.handle(slot), &app);
+      if (status != NVAPI_OK) {
+        return ApplyFailed(profile, entry.line, "NvAPI_DRS_CreateApplication failed", status);
+      }
+      index.SetApp(slot, wanted);
+    }
+    PrintApplyChange(entry.remove ? "delete-app" : "add-app", profile.name, wanted.name.c_str(), std::string());
+    ++stats->apps;
+  }
+  return true;
+}
+
+bool ApplyDrsProfile(NvDRSSessionHandle session, DrsIndex &index, const DrsManifestProfile &profile,
+                     DrsApplyStats *stats) {
+  size_t slot = index.FindProfile(profile.name);
+  if (profile.remove) {
+    if (slot == DrsIndex::kNone) {
+      ++stats->unchanged;
+      return true;
+    }
+    const NvAPI_Status status = NvApi().NvAPI_DRS_DeleteProfile(session, index.handle(slot));
+    if (status != NVAPI_OK) { return ApplyFailed(profile, profile.line, "NvAPI_DRS_DeleteProfile failed", status); }
+    PrintApplyChange("delete-profile", profile.name, "", std::string());
+    index.RemoveProfile(slot);
+    ++stats->profiles;
+    return true;
+  }
+
+  if (slot != DrsIndex::kNone) {
+    ++stats->unchanged;
+  } else {
+    NVDRS_PROFILE info = {};
+    info.version = NVDRS_PROFILE_VER;
+    if (!Utf8ToNvUnicode(profile.name.c_str(), info.profileName)) {
+      Printf("Invalid profile name encoding: %s\n", profile.name.c_str());
+      return false;
+    }
+    NvDRSProfileHandle handle = NULL;
+    const NvAPI_Status status = NvApi().NvAPI_DRS_CreateProfile(session, &info, &handle);
+    if (status != NVAPI_OK) { return ApplyFailed(profile, profile.line, "NvAPI_DRS_CreateProfile failed", status); }
+    PrintApplyChange("create-profile", profile.name, "", std::string());
+    slot = index.AddProfile(profile.name, handle);
+    ++stats->profiles;
+  }
+  return ApplyDrsApps(session, index, slot, profile, stats) && ApplyDrsSettings(session, index, slot, profile, stats);
+}
+
+// Adds a remove entry for every user profile, application and setting override in the session that the manifest
+// does not list. Predefined profiles and applications cannot be deleted and are left alone.
+void AddPruneEntries(const DrsIndex &index, std::vector<DrsManifestProfile> *profiles) {
+  std::unordered_map<std::string, size_t> byName;
+  for (size_t i = 0; i < profiles->size(); ++i) {
+    if (!(*profiles)[i].remove) { byName[ToLowerAscii((*profiles)[i].name.c_str())] = i; }
+  }
+
+  std::vector<DrsManifestProfile> removed;
+  for (size_t slot = 0; slot < index.size(); ++slot) {
+    if (index.removed(slot)) { continue; }
+    const DrsDbProfile &live = index.profile(slot);
+    auto it = byName.find(ToLowerAscii(live.name.c_str()));
+    if (it == byName.end()) {
+      if (!live.isPredefined) {
+        DrsManifestProfile entry = {};
+        entry.name = live.name;
+        entry.remove = true;
+        removed.push_back(entry);
+      }
+      continue;
+    }
+
+    DrsManifestProfile &wanted = (*profiles)[it->second];
+    std::unordered_map<std::string, bool> apps;
+    for (const auto &app : wanted.apps) { apps[ToLowerAscii(app.app.name.c_str())] = true; }
+    for (const auto &app : live.apps) {
+      if (app.isPredefined || apps.count(ToLowerAscii(app.name.c_str())) > 0) { continue; }
+      DrsManifestApp entry = {};
+      entry.app = app;
+      entry.remove = true;
+      wanted.apps.push_back(entry);
+    }
+
+    std::unordered_map<NvU32, bool> settings;
+    for (const auto &setting : wanted.settings) { settings[setting.setting.id] = true; }
+    for (const auto &setting : live.settings) {
+      if (setting.isPredefined || settings.count(setting.id) > 0) { continue; }
+      DrsManifestSetting entry = {};
+      entry.setting = setting;
+      entry.remove = true;
+      wanted.settings.push_back(entry);
+    }
+  }
+  profiles->insert(profiles->end(), removed.begin(), removed.end());
+}
+
+// Names repeat across profiles, the index resolves each distinct one through NVAPI at most once.
+bool ResolveManifestSettings(const char *source, DrsIndex &index, std::vector<DrsManifestProfile> *profiles) {
+  for (auto &profile : *profiles) {
+    for (auto &entry : profile.settings) {
+      if (!entry.byName || index.SettingId(entry.setting.name, &entry.setting.id)) { continue; }
+      return ManifestError(source, entry.line, "unknown setting", entry.setting.name);
+    }
+  }
+  return true;
+}
+
+bool ParseApplyOptions(int argc, char **argv, const char **path, bool *dryRun, bool *prune) {
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--dry-run") == 0) {
+      *dryRun = true;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--prune") == 0) {
+      *prune = true;
+      continue;
+    }
+    if (argv[i][0] == '-' || *path) {
+      Printf("Unknown option: %s\n", argv[i]);
+      return false;
+    }
+    *path = argv[i];
+  }
+  if (!*path) {
+    Printf("Missing input file\n");
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int ApplyDrsManifest(const char *source, std::vector<DrsManifestProfile> profiles, bool dryRun, bool prune) {
+  DrsSession session;
+  if (!session.ok()) {
+    PrintNvapiError("NvAPI_DRS_CreateSession/LoadSettings failed", session.status());
+    return 1;
+  }
+
+  // One enumeration pass up front, the per-entry comparisons then run against the index.
+  DrsIndex index;
+  if (!index.Load(session.handle())) { return 1; }
+  if (!ResolveManifestSettings(source, index, &profiles)) { return 1; }
+  if (prune) { AddPruneEntries(index, &profiles); }
+
+  // Every change goes to the in-memory session only, so a failed step is rolled back by not saving.
+  DrsApplyStats stats;
+  if (!StructuredOutput()) { Printf("DRS apply: %s\n", source); }
+  bool ok = true;
+  for (const auto &profile : profiles) {
+    if (!ApplyDrsProfile(session.handle(), index, profile, &stats)) {
+      ok = false;
+      break;
+    }
+  }
+
+  if (ok && !dryRun && stats.changes() > 0) {
+    const NvAPI_Status status = NvApi().NvAPI_DRS_SaveSettings(session.handle());
+    if (status != NVAPI_OK) {
+      PrintNvapiError("NvAPI_DRS_SaveSettings failed", status);
+      ok = false;
+    }
+  }
+  // serve already reloads its resident session after a failed drs command, only a dry run needs the explicit revert.
+  if (ok && dryRun) {
+    const NvAPI_Status revert = session.Revert();
+    if (revert != NVAPI_OK) { PrintNvapiError("NvAPI_DRS_LoadSettings failed while discarding changes", revert); }
+  }
+
+  const char *result = !ok ? "rolled-back" : dryRun ? "dry-run" : stats.changes() > 0 ? "saved" : "unchanged";
+  if (StructuredOutput()) {
+    RecordWriter("drs_apply")
+        .Field("path", source)
+        .Field("result", result)
+        .Field("profiles", stats.profiles)
+        .Field("apps", stats.apps)
+        .Field("settings", stats.settings)
+        .Field("unchanged", stats.unchanged);
+  } else {
+    Printf("Changes: %u (profiles %u, apps %u, settings %u), unchanged %u\n", stats.changes(), stats.profiles,
+           stats.apps, stats.settings, stats.unchanged);
+    if (!ok) {
+      Printf("DRS apply failed, no changes were saved.\n");
+    } else if (dryRun) {
+      Printf("Dry run, no changes were saved.\n");
+    } else if (stats.changes() > 0) {
+      Printf("DRS settings saved.\n");
+    } else {
+      Printf("DRS settings already match.\n");
+    }
+  }
+  return ok ? 0 : 1;
+}
+
+int CmdDrsApply(int argc, char **argv) {
+  const char *path = nullptr;
+  bool dryRun = false;
+  bool prune = false;
+  if (!ParseApplyOptions(argc, argv, &path, &dryRun, &prune)) { return 1; }
+
+  // The whole manifest is parsed before the session is opened, setting names are resolved before anything changes.
+  std::vector<DrsManifestProfile> profiles;
+  if (!ParseDrsManifest(path, &profiles)) { return 1; }
+  return ApplyDrsManifest(path, std::move(profiles), dryRun, prune);
+}
+
+int CmdDrsImport(int argc, char **argv) {
+  const char *path = nullptr;
+  bool dryRun = false;
+  bool prune = false;
+  if (!ParseApplyOptions(argc, argv, &path, &dryRun, &prune)) { return 1; }
+
+  DrsImage image;
+  std::vector<DrsDbProfile> imported;
+  if (!image.Open(path)) { return 1; }
+  if (!image.ReadProfiles(&imported)) {
+    Printf("%s: corrupt profile records\n", path);
+    return 1;
+  }
+
+  // Settings that held the driver default at export time are not pinned as overrides, so a newer driver keeps its
+  // own defaults for them.
+  std::vector<DrsManifestProfile> profiles;
+  profiles.reserve(imported.size());
+  for (const auto &source : imported) {
+    DrsManifestProfile profile = {};
+    profile.name = source.name;
+    for (const auto &app : source.apps) {
+      DrsManifestApp entry = {};
+      entry.app = app;
+      profile.apps.push_back(entry);
+    }
+    for (const auto &setting : source.settings) {
+      if (setting.isPredefined) { continue; }
+      DrsManifestSetting entry = {};
+      entry.setting = setting;
+      profile.settings.push_back(entry);
+    }
+    profiles.push_back(std::move(profile));
+  }
+  return ApplyDrsManifest(path, std::move(profiles), dryRun, prune);
+}
+
+int CmdDrsExport(int argc, char **argv) {
+  const char *outPath = nullptr;
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--out") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --out\n");
+        return 1;
+      }
+      outPath = argv[i + 1];
+      ++i;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+  if (!outPath) {
+    Printf("Missing required --out\n");
+    return 1;
+  }
+
+  DrsSession session;
+  if (!session.ok()) {
+    PrintNvapiError("NvAPI_DRS_CreateSession/LoadSettings failed", session.status());
+    return 1;
+  }
+
+  NvU32 driverVersion = 0;
+  NvAPI_ShortString branch = {0};
+  if (NvApi().NvAPI_SYS_GetDriverAndBranchVersion(&driverVersion, branch) != NVAPI_OK) {
+    driverVersion = 0;
+    branch[0] = '\0';
+  }
+
+  DrsImageWriter writer;
+  if (!writer.Open(outPath, driverVersion, branch)) { return 1; }
+  NvU32 profiles = 0;
+  NvU32 apps = 0;
+  NvU32 settings = 0;
+  bool written = true;
+  const bool read = ReadDrsSession(session.handle(), [&](const DrsDbProfile &profile, NvDRSProfileHandle) {
+    written = writer.Add(profile);
+    ++profiles;
+    apps += static_cast<NvU32>(profile.apps.size());
+    settings += static_cast<NvU32>(profile.settings.size());
+    return written;
+  });
+  // Without Close the writer's destructor drops the partial image and outPath keeps its old content.
+  if (!written || (read && !writer.Close())) {
+    Printf("Failed to write %s\n", outPath);
+    return 1;
+  }
+  if (!read) { return 1; }
+
+  if (StructuredOutput()) {
+    RecordWriter("drs_export")
+        .Field("path", outPath)
+        .Field("profiles", profiles)
+        .Field("apps", apps)
+        .Field("settings", settings);
+  } else {
+    Printf("Exported %u profiles, %u applications, %u settings to %s\n", profiles, apps, settings, outPath);
+  }
+  return 0;
+}
+} // namespace nvcli
@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/drs_image.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace nvcli {
+namespace {
+// One side of the diff. Only the sorted profile names are held, each profile is read from the image or the session
+// when the merge reaches it, so at most one profile per side is decoded at a time.
+class DrsDiffSource {
+public:
+  bool Open(const char *spec) {
+    m_label = spec;
+    if (ToLowerAscii(spec) == "live") { return OpenLive(); }
+    if (!m_image.Open(spec)) { return false; }
+    std::vector<std::pair<const char *, NvU64>> profiles;
+    if (!m_image.ListProfiles(&profiles)) {
+      Printf("%s: corrupt profile index\n", spec);
+      return false;
+    }
+    m_entries.reserve(profiles.size());
+    for (const auto &profile : profiles) {
+      m_entries.push_back({ToLowerAscii(profile.first), profile.second, NULL, DrsProfileHeader()});
+    }
+    m_driverVersion = m_image.driverVersion();
+    m_branch = m_image.branch();
+    Sort();
+    return true;
+  }
+
+  const std::string &label() const { return m_label; }
+  NvU32 driverVersion() const { return m_driverVersion; }
+  const std::string &branch() const { return m_branch; }
+  size_t size() const { return m_entries.size(); }
+  const std::string &key(size_t index) const { return m_entries[index].key; }
+
+  bool Read(size_t index, DrsDbProfile *out) {
+    const Entry &entry = m_entries[index];
+    if (m_reader) { return m_reader->Read(entry.handle, entry.header, out); }
+    if (m_image.ReadProfile(entry.offset, out)) { return true; }
+    Printf("%s: corrupt profile record\n", m_label.c_str());
+    return false;
+  }
+
+private:
+  struct Entry {
+    std::string key;
+    NvU64 offset;
+    NvDRSProfileHandle handle;
+    // Live profiles only, read once while listing so Read does not ask for it again.
+    DrsProfileHeader header;
+  };
+
+  bool OpenLive() {
+    if (!RequireNvApi()) { return false; }
+    m_session.reset(new DrsSession());
+    if (!m_session->ok()) {
+      PrintNvapiError("NvAPI_DRS_CreateSession/LoadSettings failed", m_session->status());
+      return false;
+    }
+    NvDRSSessionHandle session = m_session->handle();
+    NvU32 count = 0;
+    NvAPI_Status status = NvApi().NvAPI_DRS_GetNumProfiles(session, &count);
+    if (status != NVAPI_OK) {
+      PrintNvapiError("NvAPI_DRS_GetNumProfiles failed", status);
+      return false;
+    }
+    m_reader.reset(new DrsProfileReader(session));
+    m_entries.reserve(count);
+    for (NvU32 i = 0; i < count; ++i) {
+      NvDRSProfileHandle handle = NULL;
+      status = NvApi().NvAPI_DRS_EnumProfiles(session, i, &handle);
+      if (status != NVAPI_OK) {
+        PrintNvapiError("NvAPI_DRS_EnumProfiles failed", status);
+        return false;
+      }
+      DrsProfileHeader header;
+      if (!m_reader->ReadHeader(handle, &header)) { return false; }
+      std::string key = ToLowerAscii(header.name.c_str());
+      m_entries.push_back({std::move(key), 0, handle, std::move(header)});
+    }
+
+    NvAPI_ShortString branch = {0};
+    if (NvApi().NvAPI_SYS_GetDriverAndBranchVersion(&m_driverVersion, branch) != NVAPI_OK) {
+      m_driverVersion = 0;
+      branch[0] = '\0';
+    }
+    m_branch = branch;
+    Sort();
+    return true;
+  }
+
+  void Sort() {
+    std::sort(m_entries.begin(), m_entries.end(), [](const Entry &a, const Entry &b) { return a.key < b.key; });
+  }
+
+  std::string m_label;
+  NvU32 m_driverVersion = 0;
+  std::string m_branch;
+  std::vector<Entry> m_entries;
+  DrsImage m_image;
+  std::unique_ptr<DrsSession> m_session;
+  std::unique_ptr<DrsProfileReader> m_reader;
+};
+
+struct DrsDiffCounts {
+  NvU32 added = 0;
+  NvU32 removed = 0;
+  NvU32 changed = 0;
+};
+
+struct DrsDiffStats {
+  DrsDiffCounts profiles;
+  DrsDiffCounts apps;
+  DrsDiffCounts settings;
+  NvU32 unchanged = 0;
+};
+
+// Unlike the listings, binary values are written out in full so changes past the first bytes are visible.
+std::string DiffValueText(const DrsDbSetting &setting) {
+  std::string text = DescribeDrsValue(setting);
+  if (setting.type == NVDRS_BINARY_TYPE && !setting.binary.empty()) {
+    static const char kHex[] = "0123456789ABCDEF";
+    text += ' ';
+    for (NvU8 byte : setting.binary) {
+      text += kHex[byte >> 4];
+      text += kHex[byte & 0xF];
+    }
+  }
+  if (setting.isPredefined) { text += " (default)"; }
+  return text;
+}
+
+void AppendAppField(std::string *detail, const char *field, const std::string &before, const std::string &after) {
+  if (before == after) { return; }
+  if (!detail->empty()) { *detail += ", "; }
+  *detail += std::string(field) + " \"" + before + "\" -> \"" + after + "\"";
+}
+
+void AppendAppFlag(std::string *detail, const char *field, bool before, bool after) {
+  if (before == after) { return; }
+  if (!detail->empty()) { *detail += ", "; }
+  *detail += std::string(field) + (before ? " 1 -> 0" : " 0 -> 1");
+}
+
+std::string DescribeAppChange(const DrsDbApp &before, const DrsDbApp &after) {
+  std::string detail;
+  AppendAppField(&detail, "friendly", before.friendlyName, after.friendlyName);
+  AppendAppField(&detail, "launcher", before.launcher, after.launcher);
+  AppendAppField(&detail, "file-in-folder", before.fileInFolder, after.fileInFolder);
+  AppendAppField(&detail, "command-line", before.commandLine, after.commandLine);
+  AppendAppFlag(&detail, "predefined", before.isPredefined, after.isPredefined);
+  AppendAppFlag(&detail, "metro", before.isMetro, after.isMetro);
+  AppendAppFlag(&detail, "is-command-line", before.isCommandLine, after.isCommandLine);
+  return detail;
+}
+
+// Prints the differences of one profile. The profile line is written before its first difference, so profiles that
+// match on both sides produce no output.
+class DrsProfileDiff {
+public:
+  DrsProfileDiff(const std::string &profile, DrsDiffStats *stats) : m_profile(profile), m_stats(stats) {}
+
+  bool changed() const { return m_changed; }
+
+  void Header(const char *detail) {
+    if (m_changed) { return; }
+    m_changed = true;
+    ++m_stats->profiles.changed;
+    if (StructuredOutput()) {
+      RecordWriter("drs_diff")
+          .Field("change", "changed")
+          .Field("kind", "profile")
+          .Field("profile", m_profile)
+          .Field("detail", detail ? detail : "");
+    } else {
+      Printf("~ profile %s%s%s\n", m_profile.c_str(), detail ? " " : "", detail ? detail : "");
+    }
+  }
+
+  void App(const char *change, const DrsDbApp &app, const std::string &detail) {
+    Header(nullptr);
+    if (StructuredOutput()) {
+      RecordWriter record("drs_diff");
+      record.Field("change", change).Field("kind", "app").Field("profile", m_profile).Field("name", app.name);
+      if (!detail.empty()) { record.Field("detail", detail); }
+    } else {
+      Printf("    %c app %s%s%s\n", ChangeMark(change), app.name.c_str(), detail.empty() ? "" : ": ", detail.c_str());
+    }
+  }
+
+  void Setting(const char *change, const DrsDbSetting *before, const DrsDbSetting *after) {
+    Header(nullptr);
+    const DrsDbSetting &setting = after ? *after : *before;
+    const std::string beforeText = before ? DiffValueText(*before) : std::string();
+    const std::string afterText = after ? DiffValueText(*after) : std::string();
+    if (StructuredOutput()) {
+      RecordWriter record("drs_diff");
+      record.Field("change", change)
+          .Field("kind", "setting")
+          .Field("profile", m_profile)
+          .Hex("id", setting.id)
+          .Field("name", setting.name);
+      if (before) {
+        record.Field("before", beforeText);
+      } else {
+        record.Null("before");
+      }
+      if (after) {
+        record.Field("after", afterText);
+      } else {
+        record.Null("after");
+      }
+      return;
+    }
+    const char *name = setting.name.empty() ? "<unnamed>" : setting.name.c_str();
+    if (before && after) {
+      Printf("    ~ setting 0x%08X %s: %s -> %s\n", setting.id, name, beforeText.c_str(), afterText.c_str());
+    } else {
+      Printf("    %c setting 0x%08X %s = %s\n", ChangeMark(change), setting.id, name,
+             before ? beforeText.c_str() : afterText.c_str());
+    }
+  }
+
+private:
+  static char ChangeMark(const char *change) {
+    if (std::strcmp(change, "added") == 0) { return '+'; }
+    return std::strcmp(change, "removed") == 0 ? '-' : '~';
+  }
+
+  const std::string &m_profile;
+  DrsDiffStats *m_stats;
+  bool m_changed = false;
+};
+
+void PrintProfileOnlyIn(const char *change, const DrsDbProfile &profile) {
+  if (StructuredOutput()) {
+    RecordWriter("drs_diff")
+        .Field("change", change)
+        .Field("kind", "profile")
+        .Field("profile", profile.name)
+        .Field("predefined", profile.isPredefined)
+        .Field("apps", static_cast<NvU32>(profile.apps.size()))
+        .Field("settings", static_cast<NvU32>(profile.settings.size()));
+  } else {
+    Printf("%c profile %s predefined=%u apps=%zu settings=%zu\n", change[0] == 'a' ? '+' : '-', profile.name.c_str(),
+           profile.isPredefined ? 1u : 0u, profile.apps.size(), profile.settings.size());
+  }
+}
+
+bool AppLess(const DrsDbApp &a, const DrsDbApp &b) {
+  return ToLowerAscii(a.name.c_str()) < ToLowerAscii(b.name.c_str());
+}
+
+bool SettingLess(const DrsDbSetting &a, const DrsDbSetting &b) { return a.id < b.id; }
+
+// Both profiles are sorted in place (applications by case-folded name, settings by ID) and walked side by side.
+void DiffProfile(DrsDbProfile &before, DrsDbProfile &after, DrsDiffStats *stats) {
+  DrsProfileDiff diff(after.name, stats);
+  if (before.isPredefined != after.isPredefined) {
+    diff.Header(after.isPredefined ? "predefined 0 -> 1" : "predefined 1 -> 0");
+  }
+
+  std::sort(before.apps.begin(), before.apps.end(), AppLess);
+  std::sort(after.apps.begin(), after.apps.end(), AppLess);
+  size_t a = 0;
+  size_t b = 0;
+  while (a < before.apps.size() || b < after.apps.size()) {
+    int order = 0;
+    if (a >= before.apps.size()) {
+      order = 1;
+    } else if (b >= after.apps.size()) {
+      order = -1;
+    } else {
+      order = ToLowerAscii(before.apps[a].name.c_str()).compare(ToLowerAscii(after.apps[b].name.c_str()));
+    }
+    if (order < 0) {
+      diff.App("removed", before.apps[a++], std::string());
+      ++stats->apps.removed;
+    } else if (order > 0) {
+      diff.App("added", after.apps[b++], std::string());
+      ++stats->apps.added;
+    } else {
+      const std::string detail = DescribeAppChange(before.apps[a], after.apps[b]);
+      if (!detail.empty()) {
+        diff.App("changed", after.apps[b], detail);
+        ++stats->apps.changed;
+      }
+      ++a;
+      ++b;
+    }
+  }
+
+  std::sort(before.settings.begin(), before.settings.end(), SettingLess);
+  std::sort(after.settings.begin(), after.settings.end(), SettingLess);
+  a = 0;
+  b = 0;
+  while (a < before.settings.size() || b < after.settings.size()) {
+    if (b >= after.settings.size() || (a < before.settings.size() && before.settings[a].id < after.settings[b].id)) {
+      diff.Setting("removed", &before.settings[a++], nullptr);
+      ++stats->settings.removed;
+    } else if (a >= before.settings.size() || after.settings[b].id < before.settings[a].id) {
+      diff.Setting("added", nullptr, &after.settings[b++]);
+      ++stats->settings.added;
+    } else {
+      const DrsDbSetting &left = before.settings[a++];
+      const DrsDbSetting &right = after.settings[b++];
+      if (SameDrsValue(left, right) && left.isPredefined == right.isPredefined) { continue; }
+      diff.Setting("changed", &left, &right);
+      ++stats->settings.changed;
+    }
+  }
+  if (!diff.changed()) { ++stats->unchanged; }
+}
+
+void PrintDiffSource(const char *mark, const DrsDiffSource &source) {
+  if (StructuredOutput()) {
+    RecordWriter("drs_diff_source")
+        .Field("side", mark[0] == '-' ? "a" : "b")
+        .Field("source", source.label())
+        .Field("driver_version", source.driverVersion())
+        .Field("branch", source.branch())
+        .Field("profiles", static_cast<NvU32>(source.size()));
+  } else {
+    Printf("%s %s (driver %u %s, %zu profiles)\n", mark, source.label().c_str(), source.driverVersion(),
+           source.branch().empty() ? "<unknown branch>" : source.branch().c_str(), source.size());
+  }
+}
+} // namespace
+
+int CmdDrsDiff(int argc, char **argv) {
+  if (argc < 2) {
+    Printf("Missing diff sources (export files or live)\n");
+    return 1;
+  }
+  if (argc > 2) {
+    Printf("Unknown option: %s\n", argv[2]);
+    return 1;
+  }
+
+  DrsDiffSource before;
+  DrsDiffSource after;
+  if (!before.Open(argv[0]) || !after.Open(argv[1])) { return 1; }
+  PrintDiffSource("---", before);
+  PrintDiffSource("+++", after);
+
+  DrsDiffStats stats;
+  DrsDbProfile left;
+  DrsDbProfile right;
+  size_t a = 0;
+  size_t b = 0;
+  while (a < before.size() || b < after.size()) {
+    if (b >= after.size() || (a < before.size() && before.key(a) < after.key(b))) {
+      if (!before.Read(a++, &left)) { return 1; }
+      PrintProfileOnlyIn("removed", left);
+      ++stats.profiles.removed;
+    } else if (a >= before.size() || after.key(b) < before.key(a)) {
+      if (!after.Read(b++, &right)) { return 1; }
+      PrintProfileOnlyIn("added", right);
+      ++stats.profiles.added;
+    } else {
+      if (!before.Read(a++, &left) || !after.Read(b++, &right)) { return 1; }
+      DiffProfile(left, right, &stats);
+    }
+  }
+
+  if (StructuredOutput()) {
+    RecordWriter("drs_diff_summary")
+        .Field("profiles_added", stats.profiles.added)
+        .Field("profiles_removed", stats.profiles.removed)
+        .Field("profiles_changed", stats.profiles.changed)
+        .Field("profiles_unchanged", stats.unchanged)
+        .Field("apps_added", stats.apps.added)
+        .Field("apps_removed", stats.apps.removed)
+        .Field("apps_changed", stats.apps.changed)
+        .Field("settings_added", stats.settings.added)
+        .Field("settings_removed", stats.settings.removed)
+        .Field("settings_changed", stats.settings.changed);
+  } else {
+    Printf("Profiles: %u added, %u removed, %u changed, %u unchanged\n", stats.profiles.added, stats.profiles.removed,
+           stats.profiles.changed, stats.unchanged);
+    Printf("Applications: %u added, %u removed, %u changed\n", stats.apps.added, stats.apps.removed,
+           stats.apps.changed);
+    Printf("Settings: %u added, %u removed, %u changed\n", stats.settings.added, stats.settings.removed,
+           stats.settings.changed);
+  }
+  return 0;
+}
+} // namespace nvcli
@@ -0,0 +1,621 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/drs_image.h"
+
+namespace nvcli {
+namespace {
+// Layout (little endian):
+//   header   magic[8] driverVersion:u32 branch:u32 profiles:u32 buckets:u32 stringsOffset:u64 indexOffset:u64
+//   profile  name:u32 predefined:u32 apps:u32 settings:u32, then the app and setting entries
+//   app      name:u32 friendlyName:u32 launcher:u32 fileInFolder:u32 commandLine:u32 flags:u32
+//   setting  id:u32 name:u32 type:u8 predefined:u8 pad[2] value:u32, binary settings append value bytes
+//   strings  NUL-terminated UTF-8, referenced by offset, offset 0 is the empty string
+//   index    buckets x (hash:u32 name:u32 recordOffset:u64), name 0xFFFFFFFF marks an empty bucket
+constexpr char kDrsImageMagic[8] = {'N', 'V', 'D', 'R', 'S', 'I', 'M', '1'};
+constexpr size_t kDrsImageHeaderSize = 40;
+constexpr size_t kDrsImageBucketSize = 16;
+constexpr NvU32 kDrsImageEmptyBucket = 0xFFFFFFFFu;
+constexpr NvU32 kDrsAppPredefined = 0x1;
+constexpr NvU32 kDrsAppMetro = 0x2;
+constexpr NvU32 kDrsAppCommandLine = 0x4;
+
+template <typename T> void AppendPod(std::vector<NvU8> &out, T value) {
+  const size_t at = out.size();
+  out.resize(at + sizeof(T));
+  std::memcpy(out.data() + at, &value, sizeof(T));
+}
+
+template <typename T> bool ReadPod(const std::vector<NvU8> &data, NvU64 end, NvU64 *offset, T *value) {
+  if (*offset > end || end - *offset < sizeof(T)) { return false; }
+  std::memcpy(value, data.data() + *offset, sizeof(T));
+  *offset += sizeof(T);
+  return true;
+}
+
+// FNV-1a over the case-folded name, DRS profile lookups are case-insensitive.
+NvU32 HashProfileName(const std::string &name) {
+  NvU32 hash = 2166136261u;
+  for (char c : ToLowerAscii(name.c_str())) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+NvU32 IndexBuckets(NvU32 profiles) {
+  NvU32 buckets = 1;
+  while (buckets < profiles * 2) { buckets <<= 1; }
+  return buckets;
+}
+
+bool EnumDrsApps(NvDRSSessionHandle session, NvDRSProfileHandle profile, NvU32 expected,
+                 std::vector<NVDRS_APPLICATION> &buffer, std::vector<DrsDbApp> *out) {
+  if (buffer.size() < expected) { buffer.resize(expected); }
+  if (buffer.empty()) { buffer.resize(1); }
+  NvU32 start = 0;
+  while (true) {
+    NvU32 count = static_cast<NvU32>(buffer.size());
+    for (NvU32 i = 0; i < count; ++i) {
+      std::memset(&buffer[i], 0, sizeof(NVDRS_APPLICATION));
+      buffer[i].version = NVDRS_APPLICATION_VER;
+    }
+    NvAPI_Status status = NvApi().NvAPI_DRS_EnumApplications(session, profile, start, &count, buffer.data());
+    if (status == NVAPI_END_ENUMERATION || (status == NVAPI_OK && count == 0)) { return true; }
+    if (status != NVAPI_OK) {
+      PrintNvapiError("NvAPI_DRS_EnumApplications failed", status);
+      return false;
+    }
+    for (NvU32 i = 0; i < count; ++i) {
+      const NVDRS_APPLICATION &app = buffer[i];
+      DrsDbApp entry;
+      entry.name = NvUnicodeToUtf8(app.appName);
+      entry.friendlyName = NvUnicodeToUtf8(app.userFriendlyName);
+      entry.launcher = NvUnicodeToUtf8(app.launcher);
+      entry.fileInFolder = NvUnicodeToUtf8(app.fileInFolder);
+      entry.commandLine = NvUnicodeToUtf8(app.commandLine);
+      entry.isPredefined = app.isPredefined != 0;
+      entry.isMetro = app.isMetro != 0;
+      entry.isCommandLine = app.isCommandLine != 0;
+      out->push_back(entry);
+    }
+    start += count;
+  }
+}
+
+bool EnumDrsSettings(NvDRSSessionHandle session, NvDRSProfileHandle profile, NvU32 expected,
+                     std::vector<NVDRS_SETTING> &buffer, std::vector<DrsDbSetting> *out) {
+  if (buffer.size() < expected) { buffer.resize(expected); }
+  if (buffer.empty()) { buffer.resize(1); }
+  NvU32 start = 0;
+  while (true) {
+    NvU32 count = static_cast<NvU32>(buffer.size());
+    for (NvU32 i = 0; i < count; ++i) { InitDrsSetting(&buffer[i]); }
+    NvAPI_Status status = NvApi().NvAPI_DRS_EnumSettings(session, profile, start, &count, buffer.data());
+    if (status == NVAPI_END_ENUMERATION || (status == NVAPI_OK && count == 0)) { return true; }
+    if (status != NVAPI_OK) {
+      PrintNvapiError("NvAPI_DRS_EnumSettings failed", status);
+      return false;
+    }
+    for (NvU32 i = 0; i < count; ++i) {
+      DrsDbSetting entry;
+      ToDrsDbSetting(buffer[i], &entry);
+      out->push_back(std::move(entry));
+    }
+    start += count;
+  }
+}
+} // namespace
+
+void ToDrsDbSetting(const NVDRS_SETTING &setting, DrsDbSetting *out) {
+  out->id = setting.settingId;
+  out->name = NvUnicodeToUtf8(setting.settingName);
+  out->type = setting.settingType;
+  out->isPredefined = setting.isCurrentPredefined != 0;
+  out->dword = 0;
+  out->text.clear();
+  out->binary.clear();
+  switch (setting.settingType) {
+  case NVDRS_DWORD_TYPE: out->dword = setting.u32CurrentValue; break;
+  case NVDRS_STRING_TYPE:
+  case NVDRS_WSTRING_TYPE: out->text = NvUnicodeToUtf8(setting.wszCurrentValue); break;
+  case NVDRS_BINARY_TYPE: {
+    const NvU32 length = std::min<NvU32>(setting.binaryCurrentValue.valueLength, NVAPI_BINARY_DATA_MAX);
+    out->binary.assign(setting.binaryCurrentValue.valueData, setting.binaryCurrentValue.valueData + length);
+    break;
+  }
+  default: break;
+  }
+}
+
+std::string DescribeDrsValue(const DrsDbSetting &setting) {
+  char text[32];
+  switch (setting.type) {
+  case NVDRS_DWORD_TYPE: std::snprintf(text, sizeof(text), "0x%08X", setting.dword); return text;
+  case NVDRS_STRING_TYPE:
+  case NVDRS_WSTRING_TYPE: return "\"" + setting.text + "\"";
+  case NVDRS_BINARY_TYPE: std::snprintf(text, sizeof(text), "binary[%zu]", setting.binary.size()); return text;
+  default: return DrsSettingTypeName(setting.type);
+  }
+}
+
+bool SameDrsValue(const DrsDbSetting &a, const DrsDbSetting &b) {
+  const bool aString = a.type == NVDRS_STRING_TYPE || a.type == NVDRS_WSTRING_TYPE;
+  const bool bString = b.type == NVDRS_STRING_TYPE || b.type == NVDRS_WSTRING_TYPE;
+  if (aString || bString) { return aString && bString && a.text == b.text; }
+  if (a.type != b.type) { return false; }
+  if (a.type == NVDRS_BINARY_TYPE) { return a.binary == b.binary; }
+  return a.dword == b.dword;
+}
+
+// One GetProfileInfo per profile sizes the application and setting buffers, so each list is normally fetched with a
+// single enumeration call instead of fixed-size pages.
+bool DrsProfileReader::ReadHeader(NvDRSProfileHandle handle, DrsProfileHeader *out) {
+  NVDRS_PROFILE info = {};
+  info.version = NVDRS_PROFILE_VER;
+  const NvAPI_Status status = NvApi().NvAPI_DRS_GetProfileInfo(m_session, handle, &info);
+  if (status != NVAPI_OK) {
+    PrintNvapiError("NvAPI_DRS_GetProfileInfo failed", status);
+    return false;
+  }
+  out->name = NvUnicodeToUtf8(info.profileName);
+  out->isPredefined = info.isPredefined != 0;
+  out->numOfApps = info.numOfApps;
+  out->numOfSettings = info.numOfSettings;
+  return true;
+}
+
+bool DrsProfileReader::Read(NvDRSProfileHandle handle, DrsDbProfile *out) {
+  return ReadHeader(handle, &m_header) && Read(handle, m_header, out);
+}
+
+bool DrsProfileReader::Read(NvDRSProfileHandle handle, const DrsProfileHeader &header, DrsDbProfile *out) {
+  out->name = header.name;
+  out->isPredefined = header.isPredefined;
+  out->apps.clear();
+  out->settings.clear();
+  if (header.numOfApps > 0 && !EnumDrsApps(m_session, handle, header.numOfApps, m_apps, &out->apps)) { return false; }
+  return header.numOfSettings == 0 ||
+         EnumDrsSettings(m_session, handle, header.numOfSettings, m_settings, &out->settings);
+}
+
+bool ReadDrsSession(NvDRSSessionHandle session,
+                    const std::function<bool(const DrsDbProfile &, NvDRSProfileHandle)> &visit) {
+  NvU32 count = 0;
+  NvAPI_Status status = NvApi().NvAPI_DRS_GetNumProfiles(session, &count);
+  if (status != NVAPI_OK) {
+    PrintNvapiError("NvAPI_DRS_GetNumProfiles failed", status);
+    return false;
+  }
+
+  DrsProfileReader reader(session);
+  DrsDbProfile profile;
+  for (NvU32 i = 0; i < count; ++i) {
+    NvDRSProfileHandle handle = NULL;
+    status = NvApi().NvAPI_DRS_EnumProfiles(session, i, &handle);
+    if (status != NVAPI_OK) {
+      PrintNvapiError("NvAPI_DRS_EnumProfiles failed", status);
+      return false;
+    }
+    if (!reader.Read(handle, &profile)) { return false; }
+    if (!visit(profile, handle)) { break; }
+  }
+  return true;
+}
+
+bool DrsIndex::Load(NvDRSSessionHandle session) {
+  m_profiles.clear();
+  m_handles.clear();
+  m_settingSlots.clear();
+  m_profileByName.clear();
+  m_appOwners.clear();
+  return ReadDrsSession(session, [this](const DrsDbProfile &profile, NvDRSProfileHandle handle) {
+    m_profiles.push_back(profile);
+    m_handles.push_back(handle);
+    m_settingSlots.emplace_back();
+    IndexProfile(m_profiles.size() - 1);
+    return true;
+  });
+}
+
+void DrsIndex::IndexProfile(size_t profile) {
+  const DrsDbProfile &entry = m_profiles[profile];
+  m_profileByName[ToLowerAscii(entry.name.c_str())] = profile;
+  for (const auto &app : entry.apps) { m_appOwners[ToLowerAscii(app.name.c_str())].push_back(profile); }
+  auto &slots = m_settingSlots[profile];
+  for (size_t i = 0; i < entry.settings.size(); ++i) {
+    slots[entry.settings[i].id] = i;
+    IndexSettingName(entry.settings[i]);
+  }
+}
+
+void DrsIndex::IndexSettingName(const DrsDbSetting &setting) {
+  if (setting.name.empty()) { return; }
+  m_settingIds.emplace(ToLowerAscii(setting.name.c_str()), setting.id);
+}
+
+size_t DrsIndex::FindProfile(const std::string &name) const {
+  auto it = m_profileByName.find(ToLowerAscii(name.c_str()));
+  return it == m_profileByName.end() ? kNone : it->second;
+}
+
+const std::vector<size_t> &DrsIndex::ProfilesForApp(const std::string &appName) const {
+  static const std::vector<size_t> kEmpty;
+  auto it = m_appOwners.find(ToLowerAscii(appName.c_str()));
+  return it == m_appOwners.end() ? kEmpty : it->second;
+}
+
+// The owner table answers whether the profile lists the executable at all, only a hit scans the profile's apps.
+const DrsDbApp *DrsIndex::FindApp(size_t profile, const std::string &appName) const {
+  const std::vector<size_t> &owners = ProfilesForApp(appName);
+  if (std::find(owners.begin(), owners.end(), profile) == owners.end()) { return nullptr; }
+  for (const auto &app : m_profiles[profile].apps) {
+    if (_stricmp(app.name.c_str(), appName.c_str()) == 0) { return &app; }
+  }
+  return nullptr;
+}
+
+const DrsDbSetting *DrsIndex::FindSetting(size_t profile, NvU32 id) const {
+  auto it = m_settingSlots[profile].find(id);
+  return it == m_settingSlots[profile].end() ? nullptr : &m_profiles[profile].settings[it->second];
+}
+
+bool DrsIndex::SettingId(const std::string &name, NvU32 *id) {
+  const std::string lowered = ToLowerAscii(name.c_str());
+  auto it = m_settingIds.find(lowered);
+  if (it != m_settingIds.end()) {
+    *id = it->second;
+    return true;
+  }
+  if (!GetDrsSettingIdByName(name.c_str(), id)) { return false; }
+  m_settingIds.emplace(lowered, *id);
+  return true;
+}
+
+size_t DrsIndex::AddProfile(const std::string &name, NvDRSProfileHandle handle) {
+  DrsDbProfile profile;
+  profile.name = name;
+  profile.isPredefined = false;
+  m_profiles.push_back(profile);
+  m_handles.push_back(handle);
+  m_settingSlots.emplace_back();
+  IndexProfile(m_profiles.size() - 1);
+  return m_profiles.size() - 1;
+}
+
+void DrsIndex::RemoveProfile(size_t profile) {
+  while (!m_profiles[profile].apps.empty()) {
+    const std::string appName = m_profiles[profile].apps.back().name;
+    RemoveApp(profile, appName);
+  }
+  m_profileByName.erase(ToLowerAscii(m_profiles[profile].name.c_str()));
+  m_profiles[profile].settings.clear();
+  m_settingSlots[profile].clear();
+  m_handles[profile] = NULL;
+}
+
+void DrsIndex::SetApp(size_t profile, const DrsDbApp &app) {
+  if (FindApp(profile, app.name)) { return; }
+  m_profiles[profile].apps.push_back(app);
+  m_appOwners[ToLowerAscii(app.name.c_str())].push_back(profile);
+}
+
+void DrsIndex::RemoveApp(size_t profile, const std::string &appName) {
+  const std::string lowered = ToLowerAscii(appName.c_str());
+  auto &apps = m_profiles[profile].apps;
+  apps.erase(std::remove_if(apps.begin(), apps.end(),
+                            [&](const DrsDbApp &app) { return ToLowerAscii(app.name.c_str()) == lowered; }),
+             apps.end());
+  auto it = m_appOwners.find(lowered);
+  if (it == m_appOwners.end()) { return; }
+  it->second.erase(std::remove(it->second.begin(), it->second.end(), profile), it->second.end());
+  if (it->second.empty()) { m_appOwners.erase(it); }
+}
+
+void DrsIndex::SetSetting(size_t profile, const DrsDbSetting &setting) {
+  auto &slots = m_settingSlots[profile];
+  auto it = slots.find(setting.id);
+  if (it != slots.end()) {
+    m_profiles[profile].settings[it->second] = setting;
+  } else {
+    slots[setting.id] = m_profiles[profile].settings.size();
+    m_profiles[profile].settings.push_back(setting);
+  }
+  IndexSettingName(setting);
+}
+
+// Deleting a predefined setting restores its default in the driver, the index simply forgets the value.
+void DrsIndex::RemoveSetting(size_t profile, NvU32 id) {
+  auto &slots = m_settingSlots[profile];
+  auto it = slots.find(id);
+  if (it == slots.end()) { return; }
+  auto &settings = m_profiles[profile].settings;
+  const size_t slot = it->second;
+  slots.erase(it);
+  if (slot + 1 != settings.size()) {
+    settings[slot] = std::move(settings.back());
+    slots[settings[slot].id] = slot;
+  }
+  settings.pop_back();
+}
+
+DrsImageWriter::~DrsImageWriter() {
+  if (!m_file) { return; }
+  std::fclose(m_file);
+  std::remove(m_tempPath.c_str());
+}
+
+bool DrsImageWriter::Open(const char *path, NvU32 driverVersion, const char *branch) {
+  m_path = path;
+  m_tempPath = m_path + ".tmp";
+  if (fopen_s(&m_file, m_tempPath.c_str(), "wb") != 0 || !m_file) {
+    Printf("Failed to open %s\n", m_tempPath.c_str());
+    m_file = nullptr;
+    return false;
+  }
+  // The header is rewritten on Close once the string table and index offsets are known.
+  const NvU8 header[kDrsImageHeaderSize] = {};
+  m_failed = std::fwrite(header, 1, sizeof(header), m_file) != sizeof(header);
+  m_offset = kDrsImageHeaderSize;
+  m_driverVersion = driverVersion;
+  AddString(std::string());
+  m_branch = AddString(branch ? branch : "");
+  return !m_failed;
+}
+
+NvU32 DrsImageWriter::AddString(const std::string &text) {
+  auto it = m_stringIndex.find(text);
+  if (it != m_stringIndex.end()) { return it->second; }
+  const NvU32 offset = static_cast<NvU32>(m_strings.size());
+  m_strings.insert(m_strings.end(), text.begin(), text.end());
+  m_strings.push_back('\0');
+  m_stringIndex.emplace(text, offset);
+  return offset;
+}
+
+bool DrsImageWriter::Add(const DrsDbProfile &profile) {
+  if (!m_file || m_failed) { return false; }
+  m_record.clear();
+  const NvU32 name = AddString(profile.name);
+  AppendPod<NvU32>(m_record, name);
+  AppendPod<NvU32>(m_record, profile.isPredefined ? 1u : 0u);
+  AppendPod<NvU32>(m_record, static_cast<NvU32>(profile.apps.size()));
+  AppendPod<NvU32>(m_record, static_cast<NvU32>(profile.settings.size()));
+  for (const auto &app : profile.apps) {
+    AppendPod<NvU32>(m_record, AddString(app.name));
+    AppendPod<NvU32>(m_record, AddString(app.friendlyName));
+    AppendPod<NvU32>(m_record, AddString(app.launcher));
+    AppendPod<NvU32>(m_record, AddString(app.fileInFolder));
+    AppendPod<NvU32>(m_record, AddString(app.commandLine));
+    AppendPod<NvU32>(m_record, (app.isPredefined ? kDrsAppPredefined : 0u) | (app.isMetro ? kDrsAppMetro : 0u) |
+                                   (app.isCommandLine ? kDrsAppCommandLine : 0u));
+  }
+  for (const auto &setting : profile.settings) {
+    AppendPod<NvU32>(m_record, setting.id);
+    AppendPod<NvU32>(m_record, AddString(setting.name));
+    AppendPod<NvU8>(m_record, static_cast<NvU8>(setting.type));
+    AppendPod<NvU8>(m_record, setting.isPredefined ? 1 : 0);
+    AppendPod<NvU16>(m_record, 0);
+    switch (setting.type) {
+    case NVDRS_DWORD_TYPE: AppendPod<NvU32>(m_record, setting.dword); break;
+    case NVDRS_STRING_TYPE:
+    case NVDRS_WSTRING_TYPE: AppendPod<NvU32>(m_record, AddString(setting.text)); break;
+    case NVDRS_BINARY_TYPE:
+      AppendPod<NvU32>(m_record, static_cast<NvU32>(setting.binary.size()));
+      m_record.insert(m_record.end(), setting.binary.begin(), setting.binary.end());
+      break;
+    default: AppendPod<NvU32>(m_record, 0); break;
+    }
+  }
+  if (std::fwrite(m_record.data(), 1, m_record.size(), m_file) != m_record.size()) {
+    m_failed = true;
+    return false;
+  }
+  m_profiles.push_back({name, m_offset});
+  m_offset += m_record.size();
+  return true;
+}
+
+bool DrsImageWriter::Close() {
+  if (!m_file) { return false; }
+  const NvU64 stringsOffset = m_offset;
+  const NvU64 indexOffset = stringsOffset + m_strings.size();
+  const NvU32 buckets = IndexBuckets(static_cast<NvU32>(m_profiles.size()));
+
+  // Linear probing, the table is at most half full.
+  std::vector<NvU8> index(static_cast<size_t>(buckets) * kDrsImageBucketSize, 0);
+  for (size_t i = 0; i < buckets; ++i) { std::memcpy(&index[i * kDrsImageBucketSize + 4], &kDrsImageEmptyBucket, 4); }
+  for (const auto &profile : m_profiles) {
+    const NvU32 hash = HashProfileName(&m_strings[profile.first]);
+    NvU32 bucket = hash & (buckets - 1);
+    while (std::memcmp(&index[bucket * kDrsImageBucketSize + 4], &kDrsImageEmptyBucket, 4) != 0) {
+      bucket = (bucket + 1) & (buckets - 1);
+    }
+    NvU8 *entry = &index[bucket * kDrsImageBucketSize];
+    std::memcpy(entry, &hash, 4);
+    std::memcpy(entry + 4, &profile.first, 4);
+    std::memcpy(entry + 8, &profile.second, 8);
+  }
+
+  std::vector<NvU8> header;
+  header.insert(header.end(), kDrsImageMagic, kDrsImageMagic + sizeof(kDrsImageMagic));
+  AppendPod<NvU32>(header, m_driverVersion);
+  AppendPod<NvU32>(header, m_branch);
+  AppendPod<NvU32>(header, static_cast<NvU32>(m_profiles.size()));
+  AppendPod<NvU32>(header, buckets);
+  AppendPod<NvU64>(header, stringsOffset);
+  AppendPod<NvU64>(header, indexOffset);
+
+  bool ok = !m_failed && std::fwrite(m_strings.data(), 1, m_strings.size(), m_file) == m_strings.size() &&
+            std::fwrite(index.data(), 1, index.size(), m_file) == index.size() &&
+            std::fseek(m_file, 0, SEEK_SET) == 0 &&
+            std::fwrite(header.data(), 1, header.size(), m_file) == header.size();
+  if (std::fclose(m_file) != 0) { ok = false; }
+  m_file = nullptr;
+  if (!ok || !MoveFileExA(m_tempPath.c_str(), m_path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+    std::remove(m_tempPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool DrsImage::Open(const char *path) {
+  FILE *file = nullptr;
+  if (fopen_s(&file, path, "rb") != 0 || !file) {
+    Printf("Failed to open %s\n", path);
+    return false;
+  }
+  m_data.clear();
+  NvU8 buffer[65536];
+  size_t read = 0;
+  while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    m_data.insert(m_data.end(), buffer, buffer + read);
+  }
+  const bool readOk = std::ferror(file) == 0;
+  std::fclose(file);
+
+  const NvU64 size = m_data.size();
+  NvU64 offset = sizeof(kDrsImageMagic);
+  bool ok = readOk && size >= kDrsImageHeaderSize &&
+            std::memcmp(m_data.data(), kDrsImageMagic, sizeof(kDrsImageMagic)) == 0 &&
+            ReadPod(m_data, size, &offset, &m_driverVersion) && ReadPod(m_data, size, &offset, &m_branch) &&
+            ReadPod(m_data, size, &offset, &m_profileCount) && ReadPod(m_data, size, &offset, &m_indexBuckets) &&
+            ReadPod(m_data, size, &offset, &m_stringsOffset) && ReadPod(m_data, size, &offset, &m_indexOffset);
+  ok = ok && m_stringsOffset >= kDrsImageHeaderSize && m_stringsOffset < m_indexOffset && m_indexOffset <= size &&
+       m_indexBuckets > 0 && (m_indexBuckets & (m_indexBuckets - 1)) == 0 &&
+       size - m_indexOffset == static_cast<NvU64>(m_indexBuckets) * kDrsImageBucketSize &&
+       m_data[m_indexOffset - 1] == 0;
+  if (!ok) {
+    Printf("%s is not a DRS image\n", path);
+    m_data.clear();
+    return false;
+  }
+  m_recordsEnd = m_stringsOffset;
+  m_stringsSize = m_indexOffset - m_stringsOffset;
+  if (m_branch >= m_stringsSize) { m_branch = 0; }
+  return true;
+}
+
+const char *DrsImage::String(NvU32 offset) const {
+  if (offset >= m_stringsSize) { return ""; }
+  return reinterpret_cast<const char *>(m_data.data() + m_stringsOffset + offset);
+}
+
+bool DrsImage::DecodeProfile(NvU64 offset, DrsDbProfile *out, NvU64 *next) const {
+  NvU32 name = 0;
+  NvU32 predefined = 0;
+  NvU32 appCount = 0;
+  NvU32 settingCount = 0;
+  const NvU64 end = m_recordsEnd;
+  if (!ReadPod(m_data, end, &offset, &name) || !ReadPod(m_data, end, &offset, &predefined) ||
+      !ReadPod(m_data, end, &offset, &appCount) || !ReadPod(m_data, end, &offset, &settingCount)) {
+    return false;
+  }
+  out->name = String(name);
+  out->isPredefined = predefined != 0;
+  out->apps.clear();
+  out->settings.clear();
+
+  for (NvU32 i = 0; i < appCount; ++i) {
+    NvU32 fields[6] = {};
+    for (NvU32 &field : fields) {
+      if (!ReadPod(m_data, end, &offset, &field)) { return false; }
+    }
+    DrsDbApp app;
+    app.name = String(fields[0]);
+    app.friendlyName = String(fields[1]);
+    app.launcher = String(fields[2]);
+    app.fileInFolder = String(fields[3]);
+    app.commandLine = String(fields[4]);
+    app.isPredefined = (fields[5] & kDrsAppPredefined) != 0;
+    app.isMetro = (fields[5] & kDrsAppMetro) != 0;
+    app.isCommandLine = (fields[5] & kDrsAppCommandLine) != 0;
+    out->apps.push_back(std::move(app));
+  }
+
+  for (NvU32 i = 0; i < settingCount; ++i) {
+    NvU32 id = 0;
+    NvU32 settingName = 0;
+    NvU8 type = 0;
+    NvU8 isPredefined = 0;
+    NvU16 pad = 0;
+    NvU32 value = 0;
+    if (!ReadPod(m_data, end, &offset, &id) || !ReadPod(m_data, end, &offset, &settingName) ||
+        !ReadPod(m_data, end, &offset, &type) || !ReadPod(m_data, end, &offset, &isPredefined) ||
+        !ReadPod(m_data, end, &offset, &pad) || !ReadPod(m_data, end, &offset, &value)) {
+      return false;
+    }
+    DrsDbSetting setting;
+    setting.id = id;
+    setting.name = String(settingName);
+    setting.type = static_cast<NVDRS_SETTING_TYPE>(type);
+    setting.isPredefined = isPredefined != 0;
+    setting.dword = 0;
+    switch (setting.type) {
+    case NVDRS_DWORD_TYPE: setting.dword = value; break;
+    case NVDRS_STRING_TYPE:
+    case NVDRS_WSTRING_TYPE: setting.text = String(value); break;
+    case NVDRS_BINARY_TYPE:
+      if (value > NVAPI_BINARY_DATA_MAX || end - offset < value) { return false; }
+      setting.binary.assign(m_data.begin() + offset, m_data.begin() + offset + value);
+      offset += value;
+      break;
+    default: break;
+    }
+    out->settings.push_back(std::move(setting));
+  }
+  if (next) { *next = offset; }
+  return true;
+}
+
+bool DrsImage::FindProfile(const char *name, DrsDbProfile *out) const {
+  if (m_data.empty() || !name) { return false; }
+  const std::string lowered = ToLowerAscii(name);
+  const NvU32 hash = HashProfileName(lowered);
+  NvU32 bucket = hash & (m_indexBuckets - 1);
+  for (NvU32 probe = 0; probe < m_indexBuckets; ++probe) {
+    const NvU8 *entry = m_data.data() + m_indexOffset + static_cast<NvU64>(bucket) * kDrsImageBucketSize;
+    NvU32 entryHash = 0;
+    NvU32 entryName = 0;
+    NvU64 recordOffset = 0;
+    std::memcpy(&entryHash, entry, 4);
+    std::memcpy(&entryName, entry + 4, 4);
+    std::memcpy(&recordOffset, entry + 8, 8);
+    if (entryName == kDrsImageEmptyBucket) { return false; }
+    if (entryHash == hash && ToLowerAscii(String(entryName)) == lowered) {
+      return recordOffset >= kDrsImageHeaderSize && DecodeProfile(recordOffset, out, nullptr);
+    }
+    bucket = (bucket + 1) & (m_indexBuckets - 1);
+  }
+  return false;
+}
+
+bool DrsImage::ReadProfiles(std::vector<DrsDbProfile> *out) const {
+  out->clear();
+  out->reserve(m_profileCount);
+  NvU64 offset = kDrsImageHeaderSize;
+  while (offset < m_recordsEnd) {
+    out->emplace_back();
+    if (!DecodeProfile(offset, &out->back(), &offset)) { return false; }
+  }
+  return out->size() == m_profileCount;
+}
+
+bool DrsImage::ListProfiles(std::vector<std::pair<const char *, NvU64>> *out) const {
+  out->clear();
+  out->reserve(m_profileCount);
+  for (NvU32 bucket = 0; bucket < m_indexBuckets; ++bucket) {
+    const NvU8 *entry = m_data.data() + m_indexOffset + static_cast<NvU64>(bucket) * kDrsImageBucketSize;
+    NvU32 entryName = 0;
+    NvU64 recordOffset = 0;
+    std::memcpy(&entryName, entry + 4, 4);
+    std::memcpy(&recordOffset, entry + 8, 8);
+    if (entryName == kDrsImageEmptyBucket) { continue; }
+    if (recordOffset < kDrsImageHeaderSize || recordOffset >= m_recordsEnd) { return false; }
+    out->emplace_back(String(entryName), recordOffset);
+  }
+  return out->size() == m_profileCount;
+}
+} // namespace nvcli
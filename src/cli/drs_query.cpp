@@ -0,0 +1,567 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/drs_image.h"
+
+#include <cctype>
+
+namespace nvcli {
+namespace {
+enum class QueryField { Setting, Name, Value, Type, Profile, Predefined, App };
+enum class QueryOp { Eq, Ne, Lt, Le, Gt, Ge };
+enum class QueryNodeKind { And, Or, Not, Compare, Any };
+enum class QueryValueKind { Default, Number, Text };
+
+struct QueryNode {
+  QueryNodeKind kind;
+  size_t left;
+  size_t right;
+  QueryField field;
+  QueryOp op;
+  QueryValueKind valueKind;
+  NvU32 number;
+  // Glob pattern for names and string values, lowered type name for type.
+  std::string text;
+};
+
+struct QueryToken {
+  enum Kind { Word, Quoted, Operator, End } kind;
+  std::string text;
+  size_t offset;
+};
+
+bool IsQueryOperatorChar(char c) {
+  return c == '(' || c == ')' || c == '!' || c == '&' || c == '|' || c == '=' || c == '<' || c == '>';
+}
+
+bool TokenizeQuery(const char *expr, std::vector<QueryToken> *tokens) {
+  static const char *const kOperators[] = {"&&", "||", "==", "!=", "<=", ">=", "<", ">", "!", "(", ")"};
+  size_t i = 0;
+  const size_t length = std::strlen(expr);
+  while (i < length) {
+    if (std::isspace(static_cast<unsigned char>(expr[i]))) {
+      ++i;
+      continue;
+    }
+    QueryToken token = {QueryToken::Word, std::string(), i};
+    if (expr[i] == '"' || expr[i] == '\'') {
+      const char quote = expr[i];
+      const char *end = std::strchr(expr + i + 1, quote);
+      if (!end) {
+        Printf("Invalid --where expression at offset %zu: unterminated string\n", i);
+        return false;
+      }
+      token.kind = QueryToken::Quoted;
+      token.text.assign(expr + i + 1, end);
+      i = static_cast<size_t>(end - expr) + 1;
+    } else if (IsQueryOperatorChar(expr[i])) {
+      bool matched = false;
+      for (const char *op : kOperators) {
+        const size_t opLength = std::strlen(op);
+        if (std::strncmp(expr + i, op, opLength) != 0) { continue; }
+        token.kind = QueryToken::Operator;
+        token.text = op;
+        i += opLength;
+        matched = true;
+        break;
+      }
+      if (!matched) {
+        Printf("Invalid --where expression at offset %zu: unexpected '%c'\n", i, expr[i]);
+        return false;
+      }
+    } else {
+      const size_t start = i;
+      while (i < length && !std::isspace(static_cast<unsigned char>(expr[i])) && !IsQueryOperatorChar(expr[i])) { ++i; }
+      token.text.assign(expr + start, i - start);
+    }
+    tokens->push_back(token);
+  }
+  tokens->push_back({QueryToken::End, std::string(), length});
+  return true;
+}
+
+// Recursive descent over the tokens, || binds weaker than &&, ! applies to the next comparison or group. The nodes
+// are compiled once: setting names are resolved to IDs and values parsed before the scan starts.
+class QueryParser {
+public:
+  QueryParser(const std::vector<QueryToken> &tokens, std::vector<QueryNode> *nodes)
+      : m_tokens(tokens), m_nodes(nodes) {}
+
+  bool Parse(size_t *root) {
+    if (!ParseOr(root)) { return false; }
+    if (Peek().kind != QueryToken::End) { return Fail("unexpected token"); }
+    return true;
+  }
+
+private:
+  const QueryToken &Peek() const { return m_tokens[m_pos]; }
+
+  bool Accept(const char *op) {
+    if (Peek().kind != QueryToken::Operator || Peek().text != op) { return false; }
+    ++m_pos;
+    return true;
+  }
+
+  bool Fail(const char *message) const {
+    const QueryToken &token = Peek();
+    if (token.kind == QueryToken::End) {
+      Printf("Invalid --where expression: %s at end of input\n", message);
+    } else {
+      Printf("Invalid --where expression at offset %zu: %s near '%s'\n", token.offset, message, token.text.c_str());
+    }
+    return false;
+  }
+
+  size_t AddNode(QueryNodeKind kind, size_t left, size_t right) {
+    QueryNode node = {};
+    node.kind = kind;
+    node.left = left;
+    node.right = right;
+    m_nodes->push_back(node);
+    return m_nodes->size() - 1;
+  }
+
+  bool ParseOr(size_t *out) {
+    if (!ParseAnd(out)) { return false; }
+    while (Accept("||")) {
+      size_t right = 0;
+      if (!ParseAnd(&right)) { return false; }
+      *out = AddNode(QueryNodeKind::Or, *out, right);
+    }
+    return true;
+  }
+
+  bool ParseAnd(size_t *out) {
+    if (!ParseUnary(out)) { return false; }
+    while (Accept("&&")) {
+      size_t right = 0;
+      if (!ParseUnary(&right)) { return false; }
+      *out = AddNode(QueryNodeKind::And, *out, right);
+    }
+    return true;
+  }
+
+  bool ParseUnary(size_t *out) {
+    if (Accept("!")) {
+      size_t operand = 0;
+      if (!ParseUnary(&operand)) { return false; }
+      *out = AddNode(QueryNodeKind::Not, operand, 0);
+      return true;
+    }
+    if (Accept("(")) {
+      if (!ParseOr(out)) { return false; }
+      if (!Accept(")")) { return Fail("expected ')'"); }
+      return true;
+    }
+    return ParseCompare(out);
+  }
+
+  bool ParseCompare(size_t *out) {
+    static const struct {
+      const char *name;
+      QueryField field;
+    } kFields[] = {{"setting", QueryField::Setting}, {"name", QueryField::Name},
+                   {"value", QueryField::Value},     {"type", QueryField::Type},
+                   {"profile", QueryField::Profile}, {"predefined", QueryField::Predefined},
+                   {"app", QueryField::App}};
+    static const struct {
+      const char *text;
+      QueryOp op;
+    } kOps[] = {{"==", QueryOp::Eq}, {"!=", QueryOp::Ne}, {"<", QueryOp::Lt},
+                {"<=", QueryOp::Le}, {">", QueryOp::Gt},  {">=", QueryOp::Ge}};
+
+    if (Peek().kind != QueryToken::Word) { return Fail("expected a field"); }
+    QueryNode node = {};
+    node.kind = QueryNodeKind::Compare;
+    const std::string field = ToLowerAscii(Peek().text.c_str());
+    bool knownField = false;
+    for (const auto &entry : kFields) {
+      if (field != entry.name) { continue; }
+      node.field = entry.field;
+      knownField = true;
+    }
+    if (!knownField) { return Fail("unknown field"); }
+    ++m_pos;
+
+    bool knownOp = false;
+    if (Peek().kind == QueryToken::Operator) {
+      for (const auto &entry : kOps) {
+        if (Peek().text != entry.text) { continue; }
+        node.op = entry.op;
+        knownOp = true;
+      }
+    }
+    if (!knownOp) { return Fail("expected a comparison operator"); }
+    ++m_pos;
+
+    const QueryToken &rhs = Peek();
+    if (rhs.kind != QueryToken::Word && rhs.kind != QueryToken::Quoted) { return Fail("expected a value"); }
+    if (!CompileValue(rhs, &node)) { return false; }
+    ++m_pos;
+    m_nodes->push_back(node);
+    *out = m_nodes->size() - 1;
+    return true;
+  }
+
+  bool CompileValue(const QueryToken &rhs, QueryNode *node) {
+    const bool ordered = node->op != QueryOp::Eq && node->op != QueryOp::Ne;
+    const bool quoted = rhs.kind == QueryToken::Quoted;
+    switch (node->field) {
+    case QueryField::Setting:
+      if (ordered) { return Fail("setting only supports == and !="); }
+      node->valueKind = QueryValueKind::Number;
+      if (!quoted && ParseUint(rhs.text.c_str(), &node->number)) { return true; }
+      return GetDrsSettingIdByName(rhs.text.c_str(), &node->number);
+    case QueryField::Value:
+      if (!quoted && ToLowerAscii(rhs.text.c_str()) == "default") {
+        if (ordered) { return Fail("default only supports == and !="); }
+        node->valueKind = QueryValueKind::Default;
+        return true;
+      }
+      if (!quoted && ParseUint(rhs.text.c_str(), &node->number)) {
+        node->valueKind = QueryValueKind::Number;
+        return true;
+      }
+      if (ordered) { return Fail("string values only support == and !="); }
+      node->valueKind = QueryValueKind::Text;
+      node->text = rhs.text;
+      return true;
+    case QueryField::Type:
+      if (ordered) { return Fail("type only supports == and !="); }
+      node->text = ToLowerAscii(rhs.text.c_str());
+      if (node->text == "wstring") { node->text = "string"; }
+      if (node->text != "dword" && node->text != "string" && node->text != "binary") {
+        return Fail("type must be dword, string or binary");
+      }
+      return true;
+    case QueryField::Predefined:
+      if (ordered) { return Fail("predefined only supports == and !="); }
+      if (quoted || !ParseUint(rhs.text.c_str(), &node->number) || node->number > 1) {
+        return Fail("predefined must be 0 or 1");
+      }
+      return true;
+    default:
+      if (ordered) { return Fail("name patterns only support == and !="); }
+      node->valueKind = QueryValueKind::Text;
+      node->text = rhs.text;
+      return true;
+    }
+  }
+
+  const std::vector<QueryToken> &m_tokens;
+  std::vector<QueryNode> *m_nodes;
+  size_t m_pos = 0;
+};
+
+bool CompareNumber(QueryOp op, NvU32 lhs, NvU32 rhs) {
+  switch (op) {
+  case QueryOp::Eq: return lhs == rhs;
+  case QueryOp::Ne: return lhs != rhs;
+  case QueryOp::Lt: return lhs < rhs;
+  case QueryOp::Le: return lhs <= rhs;
+  case QueryOp::Gt: return lhs > rhs;
+  case QueryOp::Ge: return lhs >= rhs;
+  }
+  return false;
+}
+
+bool IsDrsStringType(NVDRS_SETTING_TYPE type) { return type == NVDRS_STRING_TYPE || type == NVDRS_WSTRING_TYPE; }
+
+const char *QueryTypeName(NVDRS_SETTING_TYPE type) {
+  if (IsDrsStringType(type)) { return "string"; }
+  return type == NVDRS_BINARY_TYPE ? "binary" : "dword";
+}
+
+class DrsQuery {
+public:
+  bool Compile(const char *where, const char *appsGlob) {
+    if (where) {
+      std::vector<QueryToken> tokens;
+      if (!TokenizeQuery(where, &tokens)) { return false; }
+      if (tokens.size() == 1) {
+        Printf("Invalid --where expression: empty\n");
+        return false;
+      }
+      if (!QueryParser(tokens, &m_nodes).Parse(&m_root)) { return false; }
+    }
+    if (appsGlob) {
+      QueryNode node = {};
+      node.kind = QueryNodeKind::Compare;
+      node.field = QueryField::App;
+      node.op = QueryOp::Eq;
+      node.valueKind = QueryValueKind::Text;
+      node.text = appsGlob;
+      m_nodes.push_back(node);
+      const size_t appNode = m_nodes.size() - 1;
+      if (where) {
+        QueryNode both = {};
+        both.kind = QueryNodeKind::And;
+        both.left = m_root;
+        both.right = appNode;
+        m_nodes.push_back(both);
+        m_root = m_nodes.size() - 1;
+      } else {
+        m_root = appNode;
+      }
+    }
+    m_root = Quantify(m_root);
+    CollectPositive(m_root, true);
+    return true;
+  }
+
+  // True when the expression tests setting fields, the settings that satisfy it are then listed with the profile.
+  bool settingScope() const { return m_hasAny; }
+
+  bool Match(const DrsDbProfile &profile) const { return Evaluate(m_root, profile, nullptr); }
+
+  // Settings of a matched profile that satisfy a setting group the match depends on, groups under ! are left out
+  // because they matched by finding no setting.
+  void MatchedSettings(const DrsDbProfile &profile, std::vector<const DrsDbSetting *> *out) const {
+    for (const auto &setting : profile.settings) {
+      for (size_t any : m_positive) {
+        if (!Evaluate(m_nodes[any].left, profile, &setting)) { continue; }
+        out->push_back(&setting);
+        break;
+      }
+    }
+  }
+
+private:
+  static bool IsSettingField(QueryField field) {
+    return field == QueryField::Setting || field == QueryField::Name || field == QueryField::Value ||
+           field == QueryField::Type;
+  }
+
+  // Setting comparisons joined by && and || only, a group that one setting has to satisfy as a whole.
+  bool SettingOnly(size_t index) const {
+    const QueryNode &node = m_nodes[index];
+    switch (node.kind) {
+    case QueryNodeKind::Compare: return IsSettingField(node.field);
+    case QueryNodeKind::And:
+    case QueryNodeKind::Or: return SettingOnly(node.left) && SettingOnly(node.right);
+    default: return false;
+    }
+  }
+
+  // Wraps every largest setting group in an Any node: "some setting of the profile satisfies the group". Everything
+  // around it, ! included, is then plain boolean logic over profiles, so !setting==X finds profiles without X and
+  // profile==Foo || setting==X also matches a Foo without settings.
+  size_t Quantify(size_t index) {
+    if (SettingOnly(index)) {
+      QueryNode any = {};
+      any.kind = QueryNodeKind::Any;
+      any.left = index;
+      m_nodes.push_back(any);
+      m_hasAny = true;
+      return m_nodes.size() - 1;
+    }
+    const QueryNodeKind kind = m_nodes[index].kind;
+    if (kind == QueryNodeKind::And || kind == QueryNodeKind::Or || kind == QueryNodeKind::Not) {
+      const size_t left = Quantify(m_nodes[index].left);
+      m_nodes[index].left = left;
+    }
+    if (kind == QueryNodeKind::And || kind == QueryNodeKind::Or) {
+      const size_t right = Quantify(m_nodes[index].right);
+      m_nodes[index].right = right;
+    }
+    return index;
+  }
+
+  void CollectPositive(size_t index, bool positive) {
+    const QueryNode &node = m_nodes[index];
+    switch (node.kind) {
+    case QueryNodeKind::Any:
+      if (positive) { m_positive.push_back(index); }
+      break;
+    case QueryNodeKind::Not: CollectPositive(node.left, !positive); break;
+    case QueryNodeKind::And:
+    case QueryNodeKind::Or:
+      CollectPositive(node.left, positive);
+      CollectPositive(node.right, positive);
+      break;
+    default: break;
+    }
+  }
+
+  bool Evaluate(size_t index, const DrsDbProfile &profile, const DrsDbSetting *setting) const {
+    const QueryNode &node = m_nodes[index];
+    switch (node.kind) {
+    case QueryNodeKind::And: return Evaluate(node.left, profile, setting) && Evaluate(node.right, profile, setting);
+    case QueryNodeKind::Or: return Evaluate(node.left, profile, setting) || Evaluate(node.right, profile, setting);
+    case QueryNodeKind::Not: return !Evaluate(node.left, profile, setting);
+    case QueryNodeKind::Any:
+      for (const auto &candidate : profile.settings) {
+        if (Evaluate(node.left, profile, &candidate)) { return true; }
+      }
+      return false;
+    case QueryNodeKind::Compare: break;
+    }
+
+    const bool equal = node.op == QueryOp::Eq;
+    switch (node.field) {
+    case QueryField::Profile: return WildcardMatch(node.text.c_str(), profile.name.c_str()) == equal;
+    case QueryField::Predefined: return ((profile.isPredefined ? 1u : 0u) == node.number) == equal;
+    case QueryField::App: {
+      bool any = false;
+      for (const auto &app : profile.apps) {
+        if (WildcardMatch(node.text.c_str(), app.name.c_str())) {
+          any = true;
+          break;
+        }
+      }
+      return any == equal;
+    }
+    default: break;
+    }
+
+    if (!setting) { return false; }
+    switch (node.field) {
+    case QueryField::Setting: return (setting->id == node.number) == equal;
+    case QueryField::Name: return WildcardMatch(node.text.c_str(), setting->name.c_str()) == equal;
+    case QueryField::Type: return (node.text == QueryTypeName(setting->type)) == equal;
+    default: break;
+    }
+
+    // A value of the wrong kind never matches, so value!=5 does not list string settings.
+    switch (node.valueKind) {
+    case QueryValueKind::Default: return setting->isPredefined == equal;
+    case QueryValueKind::Number:
+      return setting->type == NVDRS_DWORD_TYPE && CompareNumber(node.op, setting->dword, node.number);
+    case QueryValueKind::Text:
+      return IsDrsStringType(setting->type) && WildcardMatch(node.text.c_str(), setting->text.c_str()) == equal;
+    }
+    return false;
+  }
+
+  std::vector<QueryNode> m_nodes;
+  size_t m_root = 0;
+  std::vector<size_t> m_positive;
+  bool m_hasAny = false;
+};
+
+struct DrsQueryStats {
+  NvU32 profiles = 0;
+  NvU32 matched = 0;
+  NvU32 settings = 0;
+};
+
+void PrintQueryMatch(const DrsDbProfile &profile, const std::vector<const DrsDbSetting *> &settings,
+                     const char *appsGlob) {
+  if (StructuredOutput()) {
+    RecordWriter("drs_query_profile")
+        .Field("name", profile.name)
+        .Field("predefined", profile.isPredefined)
+        .Field("apps", static_cast<NvU32>(profile.apps.size()))
+        .Field("settings", static_cast<NvU32>(profile.settings.size()));
+  } else {
+    Printf("%s predefined=%u apps=%zu settings=%zu\n", profile.name.empty() ? "<unnamed>" : profile.name.c_str(),
+           profile.isPredefined ? 1u : 0u, profile.apps.size(), profile.settings.size());
+  }
+
+  if (appsGlob) {
+    for (const auto &app : profile.apps) {
+      if (!WildcardMatch(appsGlob, app.name.c_str())) { continue; }
+      if (StructuredOutput()) {
+        RecordWriter("drs_query_app").Field("profile", profile.name).Field("name", app.name);
+      } else {
+        Printf("  app %s\n", app.name.c_str());
+      }
+    }
+  }
+
+  for (const DrsDbSetting *setting : settings) {
+    const std::string value = DescribeDrsValue(*setting);
+    if (StructuredOutput()) {
+      RecordWriter("drs_query_setting")
+          .Field("profile", profile.name)
+          .Hex("id", setting->id)
+          .Field("name", setting->name)
+          .Field("setting_type", DrsSettingTypeName(setting->type))
+          .Field("value", value)
+          .Field("default", setting->isPredefined);
+    } else {
+      Printf("  0x%08X %s = %s%s\n", setting->id, setting->name.empty() ? "<unnamed>" : setting->name.c_str(),
+             value.c_str(), setting->isPredefined ? " (default)" : "");
+    }
+  }
+}
+} // namespace
+
+int CmdDrsQuery(int argc, char **argv) {
+  const char *where = nullptr;
+  const char *appsGlob = nullptr;
+  const char *imagePath = nullptr;
+  for (int i = 0; i < argc; ++i) {
+    const char **target = nullptr;
+    if (std::strcmp(argv[i], "--where") == 0) {
+      target = &where;
+    } else if (std::strcmp(argv[i], "--apps-glob") == 0) {
+      target = &appsGlob;
+    } else if (std::strcmp(argv[i], "--image") == 0) {
+      target = &imagePath;
+    } else {
+      Printf("Unknown option: %s\n", argv[i]);
+      return 1;
+    }
+    if (i + 1 >= argc) {
+      Printf("Missing value for %s\n", argv[i]);
+      return 1;
+    }
+    *target = argv[i + 1];
+    ++i;
+  }
+  if (!where && !appsGlob) {
+    Printf("Missing --where or --apps-glob\n");
+    return 1;
+  }
+
+  DrsQuery query;
+  if (!query.Compile(where, appsGlob)) { return 1; }
+
+  DrsQueryStats stats;
+  std::vector<const DrsDbSetting *> matches;
+  auto visit = [&](const DrsDbProfile &profile) {
+    ++stats.profiles;
+    if (!query.Match(profile)) { return; }
+    matches.clear();
+    query.MatchedSettings(profile, &matches);
+    ++stats.matched;
+    stats.settings += static_cast<NvU32>(matches.size());
+    PrintQueryMatch(profile, matches, appsGlob);
+  };
+
+  if (imagePath) {
+    DrsImage image;
+    if (!image.Open(imagePath)) { return 1; }
+    std::vector<DrsDbProfile> profiles;
+    if (!image.ReadProfiles(&profiles)) { return 1; }
+    for (const auto &profile : profiles) { visit(profile); }
+  } else {
+    DrsSession session;
+    if (!session.ok()) {
+      PrintNvapiError("NvAPI_DRS_CreateSession/LoadSettings failed", session.status());
+      return 1;
+    }
+    const bool read = ReadDrsSession(session.handle(), [&](const DrsDbProfile &profile, NvDRSProfileHandle) {
+      visit(profile);
+      return true;
+    });
+    if (!read) { return 1; }
+  }
+
+  if (StructuredOutput()) {
+    RecordWriter("drs_query_summary")
+        .Field("profiles", stats.profiles)
+        .Field("matched", stats.matched)
+        .Field("settings", stats.settings);
+  } else if (query.settingScope()) {
+    Printf("Matched %u settings in %u of %u profiles\n", stats.settings, stats.matched, stats.profiles);
+  } else {
+    Printf("Matched %u of %u profiles\n", stats.matched, stats.profiles);
+  }
+  return 0;
+}
+} // namespace nvcli
@@ -0,0 +1,697 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/edid.h"
+#include "cli/common.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <windows.h>
+
+namespace nvcli {
+namespace {
+const NvU8 kEdidHeader[8] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+const char kEdidCacheMagic[8] = {'N', 'V', 'E', 'D', 'I', 'D', 'C', '1'};
+const char kEdidDisplayMagic[8] = {'N', 'V', 'E', 'D', 'I', 'D', 'D', '1'};
+// Bumped whenever EdidInfo or the decoder output changes, older cache files are then decoded again.
+constexpr NvU32 kEdidCacheVersion = 1;
+
+constexpr NvU8 kCtaTagAudio = 1;
+constexpr NvU8 kCtaTagVideo = 2;
+constexpr NvU8 kCtaTagVendor = 3;
+constexpr NvU8 kCtaTagExtended = 7;
+constexpr NvU8 kCtaExtColorimetry = 5;
+constexpr NvU8 kCtaExtHdrStatic = 6;
+constexpr NvU8 kCtaExtHdrDynamic = 7;
+constexpr NvU8 kCtaExtYcbcr420Video = 14;
+constexpr NvU8 kCtaExtHdmiForumScdb = 0x79;
+
+constexpr NvU32 kOuiHdmi = 0x000C03;
+constexpr NvU32 kOuiHdmiForum = 0xC45DD8;
+constexpr NvU32 kOuiAmd = 0x00001A;
+
+void AddProblem(EdidInfo *out, const char *format, NvU32 first, NvU32 second = 0) {
+  char text[128];
+  std::snprintf(text, sizeof(text), format, first, second);
+  out->problems.push_back(text);
+}
+
+bool BlockChecksumOk(const NvU8 *block) {
+  NvU8 sum = 0;
+  for (NvU32 i = 0; i < 128; ++i) { sum = static_cast<NvU8>(sum + block[i]); }
+  return sum == 0;
+}
+
+// Descriptor text is terminated by 0x0A and padded with spaces.
+std::string DescriptorText(const NvU8 *text, size_t length) {
+  std::string out;
+  for (size_t i = 0; i < length && text[i] != 0x0A; ++i) {
+    out += (text[i] >= 0x20 && text[i] < 0x7F) ? static_cast<char>(text[i]) : '?';
+  }
+  while (!out.empty() && out.back() == ' ') { out.pop_back(); }
+  return out;
+}
+
+void AddVrrRange(EdidInfo *out, const char *source, NvU32 minHz, NvU32 maxHz) {
+  if (minHz == 0 || maxHz <= minHz) { return; }
+  out->vrr.push_back({source, static_cast<NvU16>(minHz), static_cast<NvU16>(maxHz)});
+}
+
+// 18-byte detailed timing descriptor, used by the base block and the CTA extension.
+void DecodeDetailedTiming(const NvU8 *d, NvU8 source, bool preferred, EdidInfo *out) {
+  EdidTiming timing = {};
+  timing.pixelClockKhz = static_cast<NvU32>(d[0] | (d[1] << 8)) * 10;
+  timing.hActive = static_cast<NvU16>(d[2] | ((d[4] & 0xF0) << 4));
+  timing.hBlank = static_cast<NvU16>(d[3] | ((d[4] & 0x0F) << 8));
+  timing.vActive = static_cast<NvU16>(d[5] | ((d[7] & 0xF0) << 4));
+  timing.vBlank = static_cast<NvU16>(d[6] | ((d[7] & 0x0F) << 8));
+  timing.hFrontPorch = static_cast<NvU16>(d[8] | ((d[11] & 0xC0) << 2));
+  timing.hSync = static_cast<NvU16>(d[9] | ((d[11] & 0x30) << 4));
+  timing.vFrontPorch = static_cast<NvU16>((d[10] >> 4) | ((d[11] & 0x0C) << 2));
+  timing.vSync = static_cast<NvU16>((d[10] & 0x0F) | ((d[11] & 0x03) << 4));
+  timing.widthMm = static_cast<NvU16>(d[12] | ((d[14] & 0xF0) << 4));
+  timing.heightMm = static_cast<NvU16>(d[13] | ((d[14] & 0x0F) << 8));
+  timing.interlaced = (d[17] & 0x80) != 0;
+  // Polarities are only defined for digital separate sync.
+  if ((d[17] & 0x18) == 0x18) {
+    timing.vSyncPositive = (d[17] & 0x04) != 0;
+    timing.hSyncPositive = (d[17] & 0x02) != 0;
+  }
+  timing.preferred = preferred;
+  timing.source = source;
+  out->timings.push_back(timing);
+}
+
+void DecodeRangeLimits(const NvU8 *d, EdidInfo *out) {
+  // EDID 1.4 offset flags add 255 to the rates above 255.
+  const NvU8 offsets = d[4];
+  out->hasRangeLimits = true;
+  out->rangeMinVHz = static_cast<NvU16>(d[5] + ((offsets & 0x03) == 0x03 ? 255 : 0));
+  out->rangeMaxVHz = static_cast<NvU16>(d[6] + ((offsets & 0x02) ? 255 : 0));
+  out->rangeMinHKhz = static_cast<NvU16>(d[7] + ((offsets & 0x0C) == 0x0C ? 255 : 0));
+  out->rangeMaxHKhz = static_cast<NvU16>(d[8] + ((offsets & 0x08) ? 255 : 0));
+  out->rangeMaxPixelClockMhz = static_cast<NvU16>(d[9] * 10);
+  AddVrrRange(out, "range-limits", out->rangeMinVHz, out->rangeMaxVHz);
+}
+
+void DecodeDescriptor(const NvU8 *d, bool first, EdidInfo *out) {
+  if (d[0] != 0 || d[1] != 0) {
+    DecodeDetailedTiming(d, kEdidSourceBase, first, out);
+    return;
+  }
+  switch (d[3]) {
+  case 0xFF: out->serialText = DescriptorText(d + 5, 13); break;
+  case 0xFC: out->name = DescriptorText(d + 5, 13); break;
+  case 0xFD: DecodeRangeLimits(d, out); break;
+  default: break;
+  }
+}
+
+void DecodeStandardTiming(NvU8 first, NvU8 second, NvU8 version, NvU8 revision, EdidInfo *out) {
+  if ((first == 0x01 && second == 0x01) || first == 0x00) { return; }
+  EdidStandardTiming timing = {};
+  timing.width = static_cast<NvU16>((first + 31) * 8);
+  switch (second >> 6) {
+  case 0:
+    // 16:10 since EDID 1.3, 1:1 before.
+    timing.height = (version == 1 && revision < 3) ? timing.width : static_cast<NvU16>(timing.width * 10 / 16);
+    break;
+  case 1: timing.height = static_cast<NvU16>(timing.width * 3 / 4); break;
+  case 2: timing.height = static_cast<NvU16>(timing.width * 4 / 5); break;
+  default: timing.height = static_cast<NvU16>(timing.width * 9 / 16); break;
+  }
+  timing.refreshHz = static_cast<NvU8>((second & 0x3F) + 60);
+  out->standardTimings.push_back(timing);
+}
+
+void DecodeBaseBlock(const NvU8 *b, EdidInfo *out) {
+  const NvU16 vendor = static_cast<NvU16>((b[8] << 8) | b[9]);
+  out->manufacturer.clear();
+  for (int shift = 10; shift >= 0; shift -= 5) {
+    const NvU8 letter = static_cast<NvU8>((vendor >> shift) & 0x1F);
+    out->manufacturer += (letter >= 1 && letter <= 26) ? static_cast<char>('A' + letter - 1) : '?';
+  }
+  out->productCode = static_cast<NvU16>(b[10] | (b[11] << 8));
+  out->serialNumber = static_cast<NvU32>(b[12] | (b[13] << 8) | (b[14] << 16)) | (static_cast<NvU32>(b[15]) << 24);
+  out->modelYear = b[16] == 0xFF;
+  out->week = out->modelYear ? 0 : b[16];
+  out->year = static_cast<NvU16>(1990 + b[17]);
+  out->version = b[18];
+  out->revision = b[19];
+
+  out->digital = (b[20] & 0x80) != 0;
+  if (out->digital && out->version == 1 && out->revision >= 4) {
+    static const NvU8 kDepth[8] = {0, 6, 8, 10, 12, 14, 16, 0};
+    out->bitDepth = kDepth[(b[20] >> 4) & 0x07];
+    out->interfaceType = b[20] & 0x0F;
+  }
+  out->widthCm = b[21];
+  out->heightCm = b[22];
+  out->gamma100 = b[23] == 0xFF ? 0 : static_cast<NvU16>(b[23] + 100);
+
+  const NvU8 lowRg = b[25];
+  const NvU8 lowBw = b[26];
+  const NvU8 lows[8] = {
+      static_cast<NvU8>((lowRg >> 6) & 3), static_cast<NvU8>((lowRg >> 4) & 3), static_cast<NvU8>((lowRg >> 2) & 3),
+      static_cast<NvU8>(lowRg & 3),        static_cast<NvU8>((lowBw >> 6) & 3), static_cast<NvU8>((lowBw >> 4) & 3),
+      static_cast<NvU8>((lowBw >> 2) & 3), static_cast<NvU8>(lowBw & 3)};
+  for (int i = 0; i < 8; ++i) { out->chromaticity[i] = static_cast<NvU16>((b[27 + i] << 2) | lows[i]); }
+
+  out->establishedTimings = static_cast<NvU32>(b[35] << 16) | static_cast<NvU32>(b[36] << 8) | b[37];
+  for (int i = 0; i < 8; ++i) { DecodeStandardTiming(b[38 + i * 2], b[39 + i * 2], b[18], b[19], out); }
+  for (int i = 0; i < 4; ++i) { DecodeDescriptor(b + 54 + i * 18, i == 0, out); }
+}
+
+// HF-VSDB and HF-SCDB share the layout from the version byte on.
+void DecodeHdmiForum(const NvU8 *p, size_t length, EdidInfo *out) {
+  out->hdmiForum = true;
+  if (length > 1) { out->hfMaxTmdsMhz = static_cast<NvU16>(p[1] * 5); }
+  if (length > 2) { out->scdc = (p[2] & 0x80) != 0; }
+  if (length > 3) { out->maxFrlRate = p[3] >> 4; }
+  if (length > 4) { out->allm = (p[4] & 0x02) != 0; }
+  if (length > 6) {
+    const NvU32 vrrMin = p[5] & 0x3F;
+    const NvU32 vrrMax = ((p[5] & 0xC0) << 2) | p[6];
+    AddVrrRange(out, "hdmi-forum", vrrMin, vrrMax);
+  }
+  if (length > 7) {
+    out->dsc = (p[7] & 0x80) != 0;
+    out->dscNative420 = (p[7] & 0x40) != 0;
+    out->dscAllBpp = (p[7] & 0x08) != 0;
+    out->dscBpcMask = p[7] & 0x07;
+  }
+  if (length > 8) {
+    out->dscMaxSlicesCode = p[8] & 0x0F;
+    out->dscMaxFrlRate = p[8] >> 4;
+  }
+  if (length > 9) { out->dscTotalChunkKBytes = p[9] & 0x3F; }
+}
+
+void DecodeVendorBlock(const NvU8 *p, size_t length, EdidInfo *out) {
+  if (length < 3) { return; }
+  const NvU32 oui = static_cast<NvU32>(p[0] | (p[1] << 8) | (p[2] << 16));
+  if (oui == kOuiHdmi) {
+    out->hdmi = true;
+    if (length >= 5) { out->physicalAddress = static_cast<NvU16>((p[3] << 8) | p[4]); }
+    if (length >= 7) { out->hdmiMaxTmdsMhz = static_cast<NvU16>(p[6] * 5); }
+  } else if (oui == kOuiHdmiForum) {
+    DecodeHdmiForum(p + 3, length - 3, out);
+  } else if (oui == kOuiAmd && length >= 7) {
+    AddVrrRange(out, "amd", p[5], p[6]);
+  }
+}
+
+void DecodeExtendedBlock(const NvU8 *p, size_t length, EdidInfo *out) {
+  if (length < 1) { return; }
+  const NvU8 *payload = p + 1;
+  const size_t payloadLength = length - 1;
+  switch (p[0]) {
+  case kCtaExtColorimetry:
+    if (payloadLength >= 2) { out->colorimetryMask = static_cast<NvU16>(payload[0] | ((payload[1] & 0xC0) << 2)); }
+    break;
+  case kCtaExtHdrStatic:
+    if (payloadLength < 2) { break; }
+    out->hasHdrStaticMetadata = true;
+    out->eotfMask = payload[0] & 0x3F;
+    out->staticMetadataMask = payload[1];
+    if (payloadLength > 2) { out->maxLuminanceCode = payload[2]; }
+    if (payloadLength > 3) { out->maxFrameAverageCode = payload[3]; }
+    if (payloadLength > 4) { out->minLuminanceCode = payload[4]; }
+    break;
+  case kCtaExtHdrDynamic: out->hasHdrDynamicMetadata = true; break;
+  case kCtaExtYcbcr420Video:
+    for (size_t i = 0; i < payloadLength; ++i) { out->ycbcr420Vics.push_back(payload[i]); }
+    break;
+  case kCtaExtHdmiForumScdb:
+    // Two reserved bytes precede the version byte.
+    if (payloadLength > 2) { DecodeHdmiForum(payload + 2, payloadLength - 2, out); }
+    break;
+  default: break;
+  }
+}
+
+void DecodeCtaBlock(const NvU8 *b, NvU32 index, EdidInfo *out) {
+  out->hasCta = true;
+  out->ctaRevision = b[1];
+  const NvU8 dtdOffset = b[2];
+  if (b[1] >= 2) {
+    out->underscan = (b[3] & 0x80) != 0;
+    out->basicAudio = (b[3] & 0x40) != 0;
+    out->ycbcr444 = (b[3] & 0x20) != 0;
+    out->ycbcr422 = (b[3] & 0x10) != 0;
+  }
+  if (dtdOffset == 0) { return; }
+  if (dtdOffset < 4 || dtdOffset > 127) {
+    AddProblem(out, "block %u: invalid CTA detailed timing offset", index);
+    return;
+  }
+
+  NvU32 at = 4;
+  while (at < dtdOffset) {
+    const NvU8 tag = b[at] >> 5;
+    const NvU32 length = b[at] & 0x1F;
+    if (at + 1 + length > dtdOffset) {
+      AddProblem(out, "block %u: CTA data block overruns the detailed timings", index);
+      break;
+    }
+    const NvU8 *p = b + at + 1;
+    switch (tag) {
+    case kCtaTagAudio: out->audioDescriptors = static_cast<NvU8>(out->audioDescriptors + length / 3); break;
+    case kCtaTagVideo:
+      for (NvU32 i = 0; i < length; ++i) {
+        // SVDs 129..192 mark the native format among VICs 1..64.
+        const bool native = p[i] >= 129 && p[i] <= 192;
+        const NvU8 vic = native ? static_cast<NvU8>(p[i] & 0x7F) : p[i];
+        if (native && out->nativeVic == 0) { out->nativeVic = vic; }
+        out->vics.push_back(vic);
+      }
+      break;
+    case kCtaTagVendor: DecodeVendorBlock(p, length, out); break;
+    case kCtaTagExtended: DecodeExtendedBlock(p, length, out); break;
+    default: break;
+    }
+    at += 1 + length;
+  }
+
+  for (NvU32 d = dtdOffset; d + 18 <= 127; d += 18) {
+    if (b[d] == 0 && b[d + 1] == 0) { break; }
+    DecodeDetailedTiming(b + d, kEdidSourceCta, false, out);
+  }
+}
+
+NvU32 ReadLe(const NvU8 *p, int bytes) {
+  NvU32 value = 0;
+  for (int i = bytes - 1; i >= 0; --i) { value = (value << 8) | p[i]; }
+  return value;
+}
+
+// Type I (DisplayID 1.x, 10 kHz units) and type VII (DisplayID 2.0, 1 kHz units) detailed timings, 20 bytes each.
+void DecodeDisplayIdTiming(const NvU8 *d, NvU32 clockUnitKhz, EdidInfo *out) {
+  EdidTiming timing = {};
+  timing.pixelClockKhz = (ReadLe(d, 3) + 1) * clockUnitKhz;
+  timing.preferred = (d[3] & 0x80) != 0;
+  timing.interlaced = (d[3] & 0x10) != 0;
+  timing.hActive = static_cast<NvU16>(ReadLe(d + 4, 2) + 1);
+  timing.hBlank = static_cast<NvU16>(ReadLe(d + 6, 2) + 1);
+  timing.hFrontPorch = static_cast<NvU16>((ReadLe(d + 8, 2) & 0x7FFF) + 1);
+  timing.hSyncPositive = (d[9] & 0x80) != 0;
+  timing.hSync = static_cast<NvU16>(ReadLe(d + 10, 2) + 1);
+  timing.vActive = static_cast<NvU16>(ReadLe(d + 12, 2) + 1);
+  timing.vBlank = static_cast<NvU16>(ReadLe(d + 14, 2) + 1);
+  timing.vFrontPorch = static_cast<NvU16>((ReadLe(d + 16, 2) & 0x7FFF) + 1);
+  timing.vSyncPositive = (d[17] & 0x80) != 0;
+  timing.vSync = static_cast<NvU16>(ReadLe(d + 18, 2) + 1);
+  timing.source = kEdidSourceDisplayId;
+  out->timings.push_back(timing);
+}
+
+void DecodeTiledTopology(const NvU8 *p, NvU32 length, EdidInfo *out) {
+  if (length < 8) { return; }
+  out->tiled = true;
+  out->tilesH = static_cast<NvU8>((((p[3] >> 6) & 3) << 4 | (p[1] >> 4)) + 1);
+  out->tilesV = static_cast<NvU8>((((p[3] >> 4) & 3) << 4 | (p[1] & 0x0F)) + 1);
+  out->tileX = static_cast<NvU8>(((p[3] >> 2) & 3) << 4 | (p[2] >> 4));
+  out->tileY = static_cast<NvU8>((p[3] & 3) << 4 | (p[2] & 0x0F));
+  out->tileWidth = static_cast<NvU16>(ReadLe(p + 4, 2) + 1);
+  out->tileHeight = static_cast<NvU16>(ReadLe(p + 6, 2) + 1);
+}
+
+void DecodeDisplayIdBlock(const NvU8 *b, NvU32 index, EdidInfo *out) {
+  // The DisplayID section follows the extension tag: version, payload size, product type, extension count.
+  const NvU8 *section = b + 1;
+  const NvU32 payload = section[1];
+  if (payload + 5 > 126) {
+    AddProblem(out, "block %u: DisplayID section overruns the block", index);
+    return;
+  }
+  out->hasDisplayId = true;
+  out->displayIdVersion = section[0];
+
+  NvU32 at = 4;
+  while (at + 3 <= 4 + payload) {
+    const NvU8 tag = section[at];
+    const NvU32 length = section[at + 2];
+    const NvU8 *p = section + at + 3;
+    if (tag == 0 && length == 0) { break; }
+    if (at + 3 + length > 4 + payload) {
+      AddProblem(out, "block %u: DisplayID data block overruns the section", index);
+      break;
+    }
+    switch (tag) {
+    case 0x03:
+    case 0x22:
+      for (NvU32 d = 0; d + 20 <= length; d += 20) { DecodeDisplayIdTiming(p + d, tag == 0x22 ? 1 : 10, out); }
+      break;
+    case 0x09:
+      if (length >= 15) { AddVrrRange(out, "displayid", p[10], p[11]); }
+      break;
+    case 0x25:
+      // Block revision 1 adds bits 9:8 of the maximum refresh rate.
+      if (length >= 9) {
+        const NvU32 maxHz = p[7] | ((section[at + 1] & 0x07) != 0 ? (p[8] & 0x03) << 8 : 0);
+        AddVrrRange(out, "displayid", p[6], maxHz);
+      }
+      break;
+    case 0x12:
+    case 0x28: DecodeTiledTopology(p, length, out); break;
+    default: break;
+    }
+    at += 3 + length;
+  }
+}
+
+// Flat little-endian serialization of EdidInfo for the cache. The same Transfer function drives both directions, so
+// writer and reader cannot drift apart.
+class EdidBlobWriter {
+public:
+  std::vector<NvU8> data;
+
+  template <typename T> void Pod(const T &value) {
+    const size_t at = data.size();
+    data.resize(at + sizeof(T));
+    std::memcpy(data.data() + at, &value, sizeof(T));
+  }
+
+  void operator()(bool &value) { Pod<NvU8>(value ? 1 : 0); }
+  void operator()(NvU8 &value) { Pod(value); }
+  void operator()(NvU16 &value) { Pod(value); }
+  void operator()(NvU32 &value) { Pod(value); }
+  void operator()(std::string &value) {
+    Pod(static_cast<NvU16>(value.size()));
+    data.insert(data.end(), value.begin(), value.end());
+  }
+  template <typename T> void operator()(std::vector<T> &values) {
+    Pod(static_cast<NvU16>(values.size()));
+    for (auto &value : values) { Transfer(*this, value); }
+  }
+};
+
+class EdidBlobReader {
+public:
+  EdidBlobReader(const NvU8 *data, size_t size) : m_data(data), m_size(size) {}
+
+  bool ok() const { return m_ok && m_offset == m_size; }
+
+  template <typename T> void Pod(T *value) {
+    if (!m_ok || m_size - m_offset < sizeof(T)) {
+      m_ok = false;
+      *value = T();
+      return;
+    }
+    std::memcpy(value, m_data + m_offset, sizeof(T));
+    m_offset += sizeof(T);
+  }
+
+  void operator()(bool &value) {
+    NvU8 raw = 0;
+    Pod(&raw);
+    value = raw != 0;
+  }
+  void operator()(NvU8 &value) { Pod(&value); }
+  void operator()(NvU16 &value) { Pod(&value); }
+  void operator()(NvU32 &value) { Pod(&value); }
+  void operator()(std::string &value) {
+    NvU16 length = 0;
+    Pod(&length);
+    if (!m_ok || m_size - m_offset < length) {
+      m_ok = false;
+      return;
+    }
+    value.assign(reinterpret_cast<const char *>(m_data + m_offset), length);
+    m_offset += length;
+  }
+  template <typename T> void operator()(std::vector<T> &values) {
+    NvU16 count = 0;
+    Pod(&count);
+    values.clear();
+    for (NvU16 i = 0; i < count && m_ok; ++i) {
+      values.emplace_back();
+      Transfer(*this, values.back());
+    }
+  }
+
+private:
+  const NvU8 *m_data;
+  size_t m_size;
+  size_t m_offset = 0;
+  bool m_ok = true;
+};
+
+template <typename Archive> void Transfer(Archive &ar, NvU8 &value) { ar(value); }
+
+template <typename Archive> void Transfer(Archive &ar, std::string &value) { ar(value); }
+
+template <typename Archive> void Transfer(Archive &ar, EdidStandardTiming &timing) {
+  ar(timing.width);
+  ar(timing.height);
+  ar(timing.refreshHz);
+}
+
+template <typename Archive> void Transfer(Archive &ar, EdidTiming &timing) {
+  ar(timing.pixelClockKhz);
+  ar(timing.hActive);
+  ar(timing.hFrontPorch);
+  ar(timing.hSync);
+  ar(timing.hBlank);
+  ar(timing.vActive);
+  ar(timing.vFrontPorch);
+  ar(timing.vSync);
+  ar(timing.vBlank);
+  ar(timing.widthMm);
+  ar(timing.heightMm);
+  ar(timing.interlaced);
+  ar(timing.hSyncPositive);
+  ar(timing.vSyncPositive);
+  ar(timing.preferred);
+  ar(timing.source);
+}
+
+template <typename Archive> void Transfer(Archive &ar, EdidVrrRange &range) {
+  ar(range.source);
+  ar(range.minHz);
+  ar(range.maxHz);
+}
+
+template <typename Archive> void Transfer(Archive &ar, EdidInfo &info) {
+  ar(info.size);
+  ar(info.extensionCount);
+  ar(info.manufacturer);
+  ar(info.productCode);
+  ar(info.serialNumber);
+  ar(info.week);
+  ar(info.year);
+  ar(info.modelYear);
+  ar(info.version);
+  ar(info.revision);
+  ar(info.name);
+  ar(info.serialText);
+  ar(info.digital);
+  ar(info.bitDepth);
+  ar(info.interfaceType);
+  ar(info.widthCm);
+  ar(info.heightCm);
+  ar(info.gamma100);
+  for (NvU16 &value : info.chromaticity) { ar(value); }
+  ar(info.establishedTimings);
+  ar(info.standardTimings);
+  ar(info.timings);
+  ar(info.hasRangeLimits);
+  ar(info.rangeMinVHz);
+  ar(info.rangeMaxVHz);
+  ar(info.rangeMinHKhz);
+  ar(info.rangeMaxHKhz);
+  ar(info.rangeMaxPixelClockMhz);
+  ar(info.hasCta);
+  ar(info.ctaRevision);
+  ar(info.underscan);
+  ar(info.basicAudio);
+  ar(info.ycbcr444);
+  ar(info.ycbcr422);
+  ar(info.vics);
+  ar(info.nativeVic);
+  ar(info.ycbcr420Vics);
+  ar(info.audioDescriptors);
+  ar(info.hdmi);
+  ar(info.physicalAddress);
+  ar(info.hdmiMaxTmdsMhz);
+  ar(info.hdmiForum);
+  ar(info.hfMaxTmdsMhz);
+  ar(info.scdc);
+  ar(info.allm);
+  ar(info.maxFrlRate);
+  ar(info.hasHdrStaticMetadata);
+  ar(info.eotfMask);
+  ar(info.staticMetadataMask);
+  ar(info.maxLuminanceCode);
+  ar(info.maxFrameAverageCode);
+  ar(info.minLuminanceCode);
+  ar(info.hasHdrDynamicMetadata);
+  ar(info.colorimetryMask);
+  ar(info.dsc);
+  ar(info.dscNative420);
+  ar(info.dscAllBpp);
+  ar(info.dscBpcMask);
+  ar(info.dscMaxSlicesCode);
+  ar(info.dscMaxFrlRate);
+  ar(info.dscTotalChunkKBytes);
+  ar(info.vrr);
+  ar(info.hasDisplayId);
+  ar(info.displayIdVersion);
+  ar(info.tiled);
+  ar(info.tilesH);
+  ar(info.tilesV);
+  ar(info.tileX);
+  ar(info.tileY);
+  ar(info.tileWidth);
+  ar(info.tileHeight);
+  ar(info.problems);
+}
+
+bool ReadWholeFile(const std::string &path, std::vector<NvU8> *out) {
+  FILE *file = nullptr;
+  if (fopen_s(&file, path.c_str(), "rb") != 0 || !file) { return false; }
+  out->clear();
+  NvU8 buffer[4096];
+  size_t read = 0;
+  while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) { out->insert(out->end(), buffer, buffer + read); }
+  const bool ok = std::ferror(file) == 0;
+  std::fclose(file);
+  return ok;
+}
+
+// Written to a temporary name and renamed, so a concurrent scan never reads a half-written entry.
+bool WriteWholeFile(const std::string &path, const std::vector<NvU8> &data) {
+  const std::string temp = path + ".tmp";
+  FILE *file = nullptr;
+  if (fopen_s(&file, temp.c_str(), "wb") != 0 || !file) { return false; }
+  const bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+  const bool closed = std::fclose(file) == 0;
+  if (!written || !closed || !MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+    std::remove(temp.c_str());
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+bool DecodeEdid(const NvU8 *data, NvU32 size, EdidInfo *out) {
+  *out = EdidInfo();
+  if (!data || size < 128 || std::memcmp(data, kEdidHeader, sizeof(kEdidHeader)) != 0) { return false; }
+  out->size = size;
+  out->extensionCount = data[0x7E];
+  if (!BlockChecksumOk(data)) { AddProblem(out, "block %u: checksum mismatch", 0); }
+  DecodeBaseBlock(data, out);
+
+  const NvU32 blocks = size / 128;
+  if (size % 128 != 0) { AddProblem(out, "%u trailing bytes after the last block", size % 128); }
+  if (blocks < 1u + out->extensionCount) {
+    AddProblem(out, "EDID declares %u extensions but is truncated", out->extensionCount);
+  }
+  for (NvU32 index = 1; index < blocks; ++index) {
+    const NvU8 *block = data + index * 128;
+    if (!BlockChecksumOk(block)) { AddProblem(out, "block %u: checksum mismatch", index); }
+    switch (block[0]) {
+    case 0x02: DecodeCtaBlock(block, index, out); break;
+    case 0x70: DecodeDisplayIdBlock(block, index, out); break;
+    // Block map, only present with more than one extension in EDID 1.3.
+    case 0xF0: break;
+    default: AddProblem(out, "block %u: unsupported extension tag 0x%02X", index, block[0]); break;
+    }
+  }
+  return true;
+}
+
+NvU64 EdidHash(const NvU8 *data, NvU32 size) {
+  NvU64 hash = 14695981039346656037ull;
+  for (NvU32 i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+double EdidTimingRefreshHz(const EdidTiming &timing) {
+  const double total = static_cast<double>(timing.hActive + timing.hBlank) * (timing.vActive + timing.vBlank);
+  if (total <= 0.0) { return 0.0; }
+  const double hz = timing.pixelClockKhz * 1000.0 / total;
+  return timing.interlaced ? hz * 2.0 : hz;
+}
+
+double EdidMaxLuminance(NvU8 code) { return code == 0 ? 0.0 : 50.0 * std::pow(2.0, code / 32.0); }
+
+double EdidMinLuminance(NvU8 maxCode, NvU8 minCode) {
+  const double ratio = minCode / 255.0;
+  return EdidMaxLuminance(maxCode) * ratio * ratio / 100.0;
+}
+
+bool EdidCache::Open(const char *dir) {
+  if (!CreateDirectoryA(dir, NULL) && GetLastError() != ERROR_ALREADY_EXISTS) {
+    Printf("Failed to create EDID cache directory: %s\n", dir);
+    return false;
+  }
+  m_dir = dir;
+  if (!m_dir.empty() && m_dir.back() != '\\' && m_dir.back() != '/') { m_dir += '\\'; }
+  return true;
+}
+
+bool EdidCache::Load(NvU64 hash, const NvU8 *data, NvU32 dataSize, NvU32 totalSize, EdidInfo *out) const {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llX.edc", static_cast<unsigned long long>(hash));
+  std::vector<NvU8> file;
+  if (!ReadWholeFile(m_dir + name, &file)) { return false; }
+
+  const size_t header = sizeof(kEdidCacheMagic) + 4 + 4;
+  NvU32 version = 0;
+  NvU32 rawSize = 0;
+  if (file.size() < header || std::memcmp(file.data(), kEdidCacheMagic, sizeof(kEdidCacheMagic)) != 0) {
+    return false;
+  }
+  std::memcpy(&version, file.data() + 8, 4);
+  std::memcpy(&rawSize, file.data() + 12, 4);
+  if (version != kEdidCacheVersion || rawSize != totalSize || file.size() - header < rawSize ||
+      dataSize > rawSize || std::memcmp(file.data() + header, data, dataSize) != 0) {
+    return false;
+  }
+  EdidBlobReader reader(file.data() + header + rawSize, file.size() - header - rawSize);
+  Transfer(reader, *out);
+  return reader.ok();
+}
+
+bool EdidCache::Store(NvU64 hash, const NvU8 *data, NvU32 size, const EdidInfo &info) const {
+  char name[32];
+  std::snprintf(name, sizeof(name), "%016llX.edc", static_cast<unsigned long long>(hash));
+  EdidBlobWriter writer;
+  writer.data.insert(writer.data.end(), kEdidCacheMagic, kEdidCacheMagic + sizeof(kEdidCacheMagic));
+  writer.Pod(kEdidCacheVersion);
+  writer.Pod(size);
+  writer.data.insert(writer.data.end(), data, data + size);
+  EdidInfo copy = info;
+  Transfer(writer, copy);
+  return WriteWholeFile(m_dir + name, writer.data);
+}
+
+bool EdidCache::LoadDisplay(NvU32 displayId, NvU32 flag, EdidDisplayRecord *out) const {
+  char name[48];
+  std::snprintf(name, sizeof(name), "display-%08X-%u.edd", displayId, flag);
+  std::vector<NvU8> file;
+  if (!ReadWholeFile(m_dir + name, &file)) { return false; }
+  if (file.size() != sizeof(kEdidDisplayMagic) + sizeof(*out) ||
+      std::memcmp(file.data(), kEdidDisplayMagic, sizeof(kEdidDisplayMagic)) != 0) {
+    return false;
+  }
+  std::memcpy(out, file.data() + sizeof(kEdidDisplayMagic), sizeof(*out));
+  return true;
+}
+
+bool EdidCache::StoreDisplay(NvU32 displayId, NvU32 flag, const EdidDisplayRecord &record) const {
+  char name[48];
+  std::snprintf(name, sizeof(name), "display-%08X-%u.edd", displayId, flag);
+  std::vector<NvU8> file(kEdidDisplayMagic, kEdidDisplayMagic + sizeof(kEdidDisplayMagic));
+  const NvU8 *raw = reinterpret_cast<const NvU8 *>(&record);
+  file.insert(file.end(), raw, raw + sizeof(record));
+  return WriteWholeFile(m_dir + name, file);
+}
+} // namespace nvcli
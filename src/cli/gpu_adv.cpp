@@ -4,53 +4,32 @@
  */
 
 #include "cli/commands.h"
+#include "cli/raw_api.h"
 
 #include <memory>
 #include <string>
 
 namespace nvcli {
-struct RawApiArgs {
-  NvU32 index = 0;
-  bool hasIndex = false;
-  bool raw = false;
-  const char *inPath = nullptr;
-  const char *outPath = nullptr;
-  bool hasDomain = false;
-  NvU32 domain = 0;
-  bool hasClassType = false;
-  NvU32 classType = 0;
-};
-
-struct ApiSpec {
-  const char *name;
-  const char *desc;
-  size_t size;
-  NvU32 version;
-  bool isSet;
-  NvAPI_Status (*call)(NvPhysicalGpuHandle, void *);
-  void (*prepare)(void *, const RawApiArgs &);
-};
-
 static bool ReadBinaryFile(const char *path, void *data, size_t size) {
   if (!path || !data || size == 0) { return false; }
   FILE *file = nullptr;
   if (fopen_s(&file, path, "rb") != 0 || !file) {
-    std::printf("Failed to open input file: %s\n", path);
+    Printf("Failed to open input file: %s\n", path);
     return false;
   }
   if (fseek(file, 0, SEEK_END) != 0) {
-    std::printf("Failed to seek input file: %s\n", path);
+    Printf("Failed to seek input file: %s\n", path);
     std::fclose(file);
     return false;
   }
   long length = ftell(file);
   if (length < 0) {
-    std::printf("Failed to read input file size: %s\n", path);
+    Printf("Failed to read input file size: %s\n", path);
     std::fclose(file);
     return false;
   }
   if (static_cast<size_t>(length) != size) {
-    std::printf("Input file size mismatch: %s (expected %zu bytes, got %ld)\n", path, size, length);
+    Printf("Input file size mismatch: %s (expected %zu bytes, got %ld)\n", path, size, length);
     std::fclose(file);
     return false;
   }
@@ -58,7 +37,7 @@ static bool ReadBinaryFile(const char *path, void *data, size_t size) {
   size_t read = std::fread(data, 1, size, file);
   std::fclose(file);
   if (read != size) {
-    std::printf("Failed to read input file: %s\n", path);
+    Printf("Failed to read input file: %s\n", path);
     return false;
   }
   return true;
@@ -68,13 +47,13 @@ static bool WriteBinaryFile(const char *path, const void *data, size_t size) {
   if (!path || !data || size == 0) { return false; }
   FILE *file = nullptr;
   if (fopen_s(&file, path, "wb") != 0 || !file) {
-    std::printf("Failed to open output file: %s\n", path);
+    Printf("Failed to open output file: %s\n", path);
     return false;
   }
   size_t written = std::fwrite(data, 1, size, file);
   std::fclose(file);
   if (written != size) {
-    std::printf("Failed to write output file: %s\n", path);
+    Printf("Failed to write output file: %s\n", path);
     return false;
   }
   return true;
@@ -92,9 +71,9 @@ static std::string AppendGpuIndexToPath(const char *path, NvU32 index) {
 static void DumpHex(const void *data, size_t size) {
   const unsigned char *bytes = static_cast<const unsigned char *>(data);
   for (size_t i = 0; i < size; ++i) {
-    if (i % 16 == 0) { std::printf("    "); }
-    std::printf("%02X ", bytes[i]);
-    if (i % 16 == 15 || i + 1 == size) { std::printf("\n"); }
+    if (i % 16 == 0) { Printf("    "); }
+    Printf("%02X ", bytes[i]);
+    if (i % 16 == 15 || i + 1 == size) { Printf("\n"); }
   }
 }
 
@@ -103,11 +82,11 @@ static bool ParseRawApiArgs(int argc, char **argv, RawApiArgs *out) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return false;
       }
       if (!ParseUint(argv[i + 1], &out->index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return false;
       }
       out->hasIndex = true;
@@ -120,7 +99,7 @@ static bool ParseRawApiArgs(int argc, char **argv, RawApiArgs *out) {
     }
     if (std::strcmp(argv[i], "--in") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --in\n");
+        Printf("Missing value for --in\n");
         return false;
       }
       out->inPath = argv[i + 1];
@@ -129,7 +108,7 @@ static bool ParseRawApiArgs(int argc, char **argv, RawApiArgs *out) {
     }
     if (std::strcmp(argv[i], "--out") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --out\n");
+        Printf("Missing value for --out\n");
         return false;
       }
       out->outPath = argv[i + 1];
@@ -138,11 +117,11 @@ static bool ParseRawApiArgs(int argc, char **argv, RawApiArgs *out) {
     }
     if (std::strcmp(argv[i], "--domain") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --domain\n");
+        Printf("Missing value for --domain\n");
         return false;
       }
       if (!ParseUint(argv[i + 1], &out->domain)) {
-        std::printf("Invalid domain value: %s\n", argv[i + 1]);
+        Printf("Invalid domain value: %s\n", argv[i + 1]);
         return false;
       }
       out->hasDomain = true;
@@ -151,18 +130,18 @@ static bool ParseRawApiArgs(int argc, char **argv, RawApiArgs *out) {
     }
     if (std::strcmp(argv[i], "--class") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --class\n");
+        Printf("Missing value for --class\n");
         return false;
       }
       if (!ParseUint(argv[i + 1], &out->classType)) {
-        std::printf("Invalid class value: %s\n", argv[i + 1]);
+        Printf("Invalid class value: %s\n", argv[i + 1]);
         return false;
       }
       out->hasClassType = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return false;
   }
   return true;
@@ -194,393 +173,419 @@ static void PrepareClockDomainsFreqInfo(void *data, const RawApiArgs &args) {
 }
 
 static NvAPI_Status CallClockCounterMeasureAvgFreq(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockCounterMeasureAvgFreq(gpu,
-                                              reinterpret_cast<NV_GPU_CLOCK_COUNTER_MEASURE_AVG_FREQ_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ClockCounterMeasureAvgFreq(
+      gpu, reinterpret_cast<NV_GPU_CLOCK_COUNTER_MEASURE_AVG_FREQ_PARAMS *>(data));
 }
 
 static NvAPI_Status CallClockClkDomainsGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkDomainsGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAINS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkDomainsGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAINS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkDomainsSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkDomainsSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAINS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkDomainsSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAINS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkDomainsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkDomainsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAINS_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkDomainsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAINS_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkDomainsGetFreqInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkDomainsGetFreqInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAINS_FREQ_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkDomainsGetFreqInfo(gpu,
+                                                      reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAINS_FREQ_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkDomainFreqsEnum(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkDomainFreqsEnum(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAIN_FREQS_ENUM *>(data));
+  return NvApi().NvAPI_GPU_ClockClkDomainFreqsEnum(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAIN_FREQS_ENUM *>(data));
 }
 
 static NvAPI_Status CallClockClkDomainRpc(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkDomainRpc(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAIN_RPC *>(data));
+  return NvApi().NvAPI_GPU_ClockClkDomainRpc(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_DOMAIN_RPC *>(data));
 }
 
 static NvAPI_Status CallClockClkProgsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkProgsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROGS_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkProgsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROGS_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkProgsGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkProgsGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROGS_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClockClkProgsGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROGS_STATUS *>(data));
 }
 
 static NvAPI_Status CallClockClkProgsGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkProgsGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROGS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkProgsGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROGS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkProgsSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkProgsSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROGS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkProgsSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROGS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkEnumsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkEnumsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_ENUMS_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkEnumsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_ENUMS_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkVfRelsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVfRelsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_RELS_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkVfRelsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_RELS_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkVfRelsGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVfRelsGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_RELS_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClockClkVfRelsGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_RELS_STATUS *>(data));
 }
 
 static NvAPI_Status CallClockClkVfRelsGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVfRelsGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_RELS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkVfRelsGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_RELS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkVfRelsSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVfRelsSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_RELS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkVfRelsSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_RELS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkVfPointsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVfPointsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_POINTS_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkVfPointsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_POINTS_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkVfPointsGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVfPointsGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_POINTS_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClockClkVfPointsGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_POINTS_STATUS *>(data));
 }
 
 static NvAPI_Status CallClockClkVfPointsGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVfPointsGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_POINTS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkVfPointsGetControl(gpu,
+                                                      reinterpret_cast<NV_GPU_CLOCK_CLK_VF_POINTS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkVfPointsSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVfPointsSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VF_POINTS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkVfPointsSetControl(gpu,
+                                                      reinterpret_cast<NV_GPU_CLOCK_CLK_VF_POINTS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkPropRegimesGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkPropRegimesGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_REGIMES_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkPropRegimesGetInfo(gpu,
+                                                      reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_REGIMES_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkPropRegimesGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkPropRegimesGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_REGIMES_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkPropRegimesGetControl(
+      gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_REGIMES_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkPropRegimesSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkPropRegimesSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_REGIMES_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkPropRegimesSetControl(
+      gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_REGIMES_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkPropTopsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkPropTopsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOPS_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkPropTopsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOPS_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkPropTopsGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkPropTopsGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOPS_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClockClkPropTopsGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOPS_STATUS *>(data));
 }
 
 static NvAPI_Status CallClockClkPropTopsGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkPropTopsGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOPS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkPropTopsGetControl(gpu,
+                                                      reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOPS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkPropTopsSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkPropTopsSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOPS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkPropTopsSetControl(gpu,
+                                                      reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOPS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkPropTopRelsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkPropTopRelsGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOP_RELS_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkPropTopRelsGetInfo(gpu,
+                                                      reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOP_RELS_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkPropTopRelsGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkPropTopRelsGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOP_RELS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkPropTopRelsGetControl(
+      gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOP_RELS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkPropTopRelsSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkPropTopRelsSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOP_RELS_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockClkPropTopRelsSetControl(
+      gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_PROP_TOP_RELS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockAdcDevicesGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockAdcDevicesGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_ADC_DEVICES_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockAdcDevicesGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_ADC_DEVICES_INFO *>(data));
 }
 
 static NvAPI_Status CallClockAdcDevicesGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockAdcDevicesGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_ADC_DEVICES_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClockAdcDevicesGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_ADC_DEVICES_STATUS *>(data));
 }
 
 static NvAPI_Status CallClockAdcDevicesGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockAdcDevicesGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_ADC_DEVICES_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockAdcDevicesGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_ADC_DEVICES_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockAdcDevicesSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockAdcDevicesSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_ADC_DEVICES_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockAdcDevicesSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_ADC_DEVICES_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockNafllDevicesGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockNafllDevicesGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_NAFLL_DEVICES_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockNafllDevicesGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_NAFLL_DEVICES_INFO *>(data));
 }
 
 static NvAPI_Status CallClockNafllDevicesGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockNafllDevicesGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_NAFLL_DEVICES_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClockNafllDevicesGetStatus(gpu, reinterpret_cast<NV_GPU_CLOCK_NAFLL_DEVICES_STATUS *>(data));
 }
 
 static NvAPI_Status CallClockNafllDevicesGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockNafllDevicesGetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_NAFLL_DEVICES_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockNafllDevicesGetControl(gpu,
+                                                       reinterpret_cast<NV_GPU_CLOCK_NAFLL_DEVICES_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockNafllDevicesSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockNafllDevicesSetControl(gpu, reinterpret_cast<NV_GPU_CLOCK_NAFLL_DEVICES_CONTROL *>(data));
+  return NvApi().NvAPI_GPU_ClockNafllDevicesSetControl(gpu,
+                                                       reinterpret_cast<NV_GPU_CLOCK_NAFLL_DEVICES_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkFreqControllersGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkFreqControllerGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_FREQ_CONTROLLERS_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkFreqControllerGetInfo(
+      gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_FREQ_CONTROLLERS_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkFreqControllersGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkFreqControllerGetStatus(gpu,
-                                                   reinterpret_cast<NV_GPU_CLOCK_CLK_FREQ_CONTROLLERS_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClockClkFreqControllerGetStatus(
+      gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_FREQ_CONTROLLERS_STATUS *>(data));
 }
 
 static NvAPI_Status CallClockClkFreqControllersGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkFreqControllersGetControl(
+  return NvApi().NvAPI_GPU_ClockClkFreqControllersGetControl(
       gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_FREQ_CONTROLLERS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkFreqControllersSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkFreqControllersSetControl(
+  return NvApi().NvAPI_GPU_ClockClkFreqControllersSetControl(
       gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_FREQ_CONTROLLERS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkVoltControllersGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVoltControllerGetInfo(gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VOLT_CONTROLLERS_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClockClkVoltControllerGetInfo(
+      gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VOLT_CONTROLLERS_INFO *>(data));
 }
 
 static NvAPI_Status CallClockClkVoltControllersGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVoltControllerGetStatus(gpu,
-                                                   reinterpret_cast<NV_GPU_CLOCK_CLK_VOLT_CONTROLLERS_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClockClkVoltControllerGetStatus(
+      gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VOLT_CONTROLLERS_STATUS *>(data));
 }
 
 static NvAPI_Status CallClockClkVoltControllersGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVoltControllersGetControl(
+  return NvApi().NvAPI_GPU_ClockClkVoltControllersGetControl(
       gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VOLT_CONTROLLERS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClkVoltControllersSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClkVoltControllersSetControl(
+  return NvApi().NvAPI_GPU_ClockClkVoltControllersSetControl(
       gpu, reinterpret_cast<NV_GPU_CLOCK_CLK_VOLT_CONTROLLERS_CONTROL *>(data));
 }
 
 static NvAPI_Status CallClockClientClkDomainsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClientClkDomainsGetInfo(gpu, reinterpret_cast<PNV_GPU_CLOCK_CLIENT_CLK_DOMAINS_INFO>(data));
+  return NvApi().NvAPI_GPU_ClockClientClkDomainsGetInfo(gpu,
+                                                        reinterpret_cast<PNV_GPU_CLOCK_CLIENT_CLK_DOMAINS_INFO>(data));
 }
 
 static NvAPI_Status CallClockClientClkVfPointsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClientClkVfPointsGetInfo(gpu, reinterpret_cast<PNV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_INFO>(data));
+  return NvApi().NvAPI_GPU_ClockClientClkVfPointsGetInfo(
+      gpu, reinterpret_cast<PNV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_INFO>(data));
 }
 
 static NvAPI_Status CallClockClientClkVfPointsGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClientClkVfPointsGetStatus(gpu,
-                                                   reinterpret_cast<PNV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_STATUS>(data));
+  return NvApi().NvAPI_GPU_ClockClientClkVfPointsGetStatus(
+      gpu, reinterpret_cast<PNV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_STATUS>(data));
 }
 
 static NvAPI_Status CallClockClientClkVfPointsGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClientClkVfPointsGetControl(gpu,
-                                                    reinterpret_cast<PNV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_CONTROL>(data));
+  return NvApi().NvAPI_GPU_ClockClientClkVfPointsGetControl(
+      gpu, reinterpret_cast<PNV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_CONTROL>(data));
 }
 
 static NvAPI_Status CallClockClientClkVfPointsSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockClientClkVfPointsSetControl(gpu,
-                                                    reinterpret_cast<PNV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_CONTROL>(data));
+  return NvApi().NvAPI_GPU_ClockClientClkVfPointsSetControl(
+      gpu, reinterpret_cast<PNV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_CONTROL>(data));
 }
 
 static NvAPI_Status CallClockPmumonClkDomainsGetSamples(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClockPmumonClkDomainsGetSamples(
+  return NvApi().NvAPI_GPU_ClockPmumonClkDomainsGetSamples(
       gpu, reinterpret_cast<NV_GPU_CLOCK_PMUMON_CLK_DOMAINS_GET_SAMPLES *>(data));
 }
 
 static NvAPI_Status CallPowerPolicyGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_PowerPolicyGetInfo(gpu, reinterpret_cast<NV_GPU_POWER_POLICY_INFO_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_PowerPolicyGetInfo(gpu, reinterpret_cast<NV_GPU_POWER_POLICY_INFO_PARAMS *>(data));
 }
 
 static NvAPI_Status CallPowerPolicyGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_PowerPolicyGetStatus(gpu, reinterpret_cast<NV_GPU_POWER_POLICY_STATUS_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_PowerPolicyGetStatus(gpu, reinterpret_cast<NV_GPU_POWER_POLICY_STATUS_PARAMS *>(data));
 }
 
 static NvAPI_Status CallPowerPolicyGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_PowerPolicyGetControl(gpu, reinterpret_cast<NV_GPU_POWER_POLICY_CONTROL_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_PowerPolicyGetControl(gpu, reinterpret_cast<NV_GPU_POWER_POLICY_CONTROL_PARAMS *>(data));
 }
 
 static NvAPI_Status CallPowerPolicySetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_PowerPolicySetControl(gpu, reinterpret_cast<NV_GPU_POWER_POLICY_CONTROL_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_PowerPolicySetControl(gpu, reinterpret_cast<NV_GPU_POWER_POLICY_CONTROL_PARAMS *>(data));
 }
 
 static NvAPI_Status CallClientPowerTopologyGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClientPowerTopologyGetInfo(gpu, reinterpret_cast<NV_GPU_CLIENT_POWER_TOPOLOGY_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClientPowerTopologyGetInfo(gpu, reinterpret_cast<NV_GPU_CLIENT_POWER_TOPOLOGY_INFO *>(data));
 }
 
 static NvAPI_Status CallClientPowerTopologyGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClientPowerTopologyGetStatus(gpu, reinterpret_cast<NV_GPU_CLIENT_POWER_TOPOLOGY_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClientPowerTopologyGetStatus(gpu,
+                                                        reinterpret_cast<NV_GPU_CLIENT_POWER_TOPOLOGY_STATUS *>(data));
 }
 
 static NvAPI_Status CallClientPowerPoliciesGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClientPowerPoliciesGetInfo(gpu, reinterpret_cast<NV_GPU_CLIENT_POWER_POLICIES_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClientPowerPoliciesGetInfo(gpu, reinterpret_cast<NV_GPU_CLIENT_POWER_POLICIES_INFO *>(data));
 }
 
 static NvAPI_Status CallClientPowerPoliciesGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClientPowerPoliciesGetStatus(gpu, reinterpret_cast<NV_GPU_CLIENT_POWER_POLICIES_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClientPowerPoliciesGetStatus(gpu,
+                                                        reinterpret_cast<NV_GPU_CLIENT_POWER_POLICIES_STATUS *>(data));
 }
 
 static NvAPI_Status CallClientPowerPoliciesSetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClientPowerPoliciesSetStatus(gpu, reinterpret_cast<NV_GPU_CLIENT_POWER_POLICIES_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClientPowerPoliciesSetStatus(gpu,
+                                                        reinterpret_cast<NV_GPU_CLIENT_POWER_POLICIES_STATUS *>(data));
 }
 
 static NvAPI_Status CallClientThermalPoliciesGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClientThermalPoliciesGetInfo(gpu, reinterpret_cast<NV_GPU_CLIENT_THERMAL_POLICIES_INFO *>(data));
+  return NvApi().NvAPI_GPU_ClientThermalPoliciesGetInfo(gpu,
+                                                        reinterpret_cast<NV_GPU_CLIENT_THERMAL_POLICIES_INFO *>(data));
 }
 
 static NvAPI_Status CallClientThermalPoliciesGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClientThermalPoliciesGetStatus(gpu, reinterpret_cast<NV_GPU_CLIENT_THERMAL_POLICIES_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClientThermalPoliciesGetStatus(
+      gpu, reinterpret_cast<NV_GPU_CLIENT_THERMAL_POLICIES_STATUS *>(data));
 }
 
 static NvAPI_Status CallClientThermalPoliciesSetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ClientThermalPoliciesSetStatus(gpu, reinterpret_cast<NV_GPU_CLIENT_THERMAL_POLICIES_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ClientThermalPoliciesSetStatus(
+      gpu, reinterpret_cast<NV_GPU_CLIENT_THERMAL_POLICIES_STATUS *>(data));
 }
 
 static NvAPI_Status CallFanArbiterGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanArbiterGetInfo(gpu, reinterpret_cast<NV_GPU_FAN_ARBITER_INFO_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanArbiterGetInfo(gpu, reinterpret_cast<NV_GPU_FAN_ARBITER_INFO_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanArbiterGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanArbiterGetStatus(gpu, reinterpret_cast<NV_GPU_FAN_ARBITER_STATUS_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanArbiterGetStatus(gpu, reinterpret_cast<NV_GPU_FAN_ARBITER_STATUS_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanCoolerGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanCoolerGetInfo(gpu, reinterpret_cast<NV_GPU_FAN_COOLER_INFO_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanCoolerGetInfo(gpu, reinterpret_cast<NV_GPU_FAN_COOLER_INFO_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanCoolerGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanCoolerGetStatus(gpu, reinterpret_cast<NV_GPU_FAN_COOLER_STATUS_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanCoolerGetStatus(gpu, reinterpret_cast<NV_GPU_FAN_COOLER_STATUS_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanCoolerGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanCoolerGetControl(gpu, reinterpret_cast<NV_GPU_FAN_COOLER_CONTROL_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanCoolerGetControl(gpu, reinterpret_cast<NV_GPU_FAN_COOLER_CONTROL_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanCoolerSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanCoolerSetControl(gpu, reinterpret_cast<NV_GPU_FAN_COOLER_CONTROL_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanCoolerSetControl(gpu, reinterpret_cast<NV_GPU_FAN_COOLER_CONTROL_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanPolicyGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanPolicyGetInfo(gpu, reinterpret_cast<NV_GPU_FAN_POLICY_INFO_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanPolicyGetInfo(gpu, reinterpret_cast<NV_GPU_FAN_POLICY_INFO_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanPolicyGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanPolicyGetStatus(gpu, reinterpret_cast<NV_GPU_FAN_POLICY_STATUS_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanPolicyGetStatus(gpu, reinterpret_cast<NV_GPU_FAN_POLICY_STATUS_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanPolicyGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanPolicyGetControl(gpu, reinterpret_cast<NV_GPU_FAN_POLICY_CONTROL_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanPolicyGetControl(gpu, reinterpret_cast<NV_GPU_FAN_POLICY_CONTROL_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanPolicySetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanPolicySetControl(gpu, reinterpret_cast<NV_GPU_FAN_POLICY_CONTROL_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanPolicySetControl(gpu, reinterpret_cast<NV_GPU_FAN_POLICY_CONTROL_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanTestGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanTestGetInfo(gpu, reinterpret_cast<NV_GPU_FAN_TEST_INFO_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_FanTestGetInfo(gpu, reinterpret_cast<NV_GPU_FAN_TEST_INFO_PARAMS *>(data));
 }
 
 static NvAPI_Status CallFanPmumonFanCoolersGetSamples(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_FanPmumonFanCoolersGetSamples(gpu,
-                                                 reinterpret_cast<NV_GPU_FAN_PMUMON_FAN_COOLERS_GET_SAMPLES *>(data));
+  return NvApi().NvAPI_GPU_FanPmumonFanCoolersGetSamples(
+      gpu, reinterpret_cast<NV_GPU_FAN_PMUMON_FAN_COOLERS_GET_SAMPLES *>(data));
 }
 
 static NvAPI_Status CallThermalPolicyGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermalPolicyGetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_POLICY_INFO_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermalPolicyGetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_POLICY_INFO_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermalPolicyGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermalPolicyGetStatus(gpu, reinterpret_cast<NV_GPU_THERMAL_POLICY_STATUS_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermalPolicyGetStatus(gpu, reinterpret_cast<NV_GPU_THERMAL_POLICY_STATUS_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermalPolicyGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermalPolicyGetControl(gpu, reinterpret_cast<NV_GPU_THERMAL_POLICY_CONTROL_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermalPolicyGetControl(gpu, reinterpret_cast<NV_GPU_THERMAL_POLICY_CONTROL_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermalPolicySetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermalPolicySetControl(gpu, reinterpret_cast<NV_GPU_THERMAL_POLICY_CONTROL_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermalPolicySetControl(gpu, reinterpret_cast<NV_GPU_THERMAL_POLICY_CONTROL_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermChannelGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermChannelGetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_CHANNEL_INFO_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermChannelGetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_CHANNEL_INFO_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermChannelGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermChannelGetStatus(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_CHANNEL_STATUS_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermChannelGetStatus(gpu,
+                                                 reinterpret_cast<NV_GPU_THERMAL_THERM_CHANNEL_STATUS_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermChannelGetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermChannelGetControl(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_CHANNEL_CONTROL_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermChannelGetControl(
+      gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_CHANNEL_CONTROL_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermChannelSetControl(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermChannelSetControl(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_CHANNEL_CONTROL_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermChannelSetControl(
+      gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_CHANNEL_CONTROL_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermDeviceGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermDeviceGetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_DEVICE_INFO_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermDeviceGetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_DEVICE_INFO_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermMonitorsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermMonitorsGetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_MONITORS_INFO *>(data));
+  return NvApi().NvAPI_GPU_ThermMonitorsGetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_MONITORS_INFO *>(data));
 }
 
 static NvAPI_Status CallThermMonitorsGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermMonitorsGetStatus(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_MONITORS_STATUS *>(data));
+  return NvApi().NvAPI_GPU_ThermMonitorsGetStatus(gpu, reinterpret_cast<NV_GPU_THERMAL_THERM_MONITORS_STATUS *>(data));
 }
 
 static NvAPI_Status CallThermHwFsSlowdownAmountGet(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermHwFsSlowdownAmountGet(gpu,
-                                              reinterpret_cast<NV_GPU_THERMAL_HWFS_SLOWDOWN_AMOUNT_GET_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermHwFsSlowdownAmountGet(
+      gpu, reinterpret_cast<NV_GPU_THERMAL_HWFS_SLOWDOWN_AMOUNT_GET_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermalHwFsGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermalHwFsGetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_HWFS_EVENT_SETTINGS_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermalHwFsGetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_HWFS_EVENT_SETTINGS_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermalHwFsSetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermalHwFsSetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_HWFS_EVENT_SETTINGS_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_ThermalHwFsSetInfo(gpu, reinterpret_cast<NV_GPU_THERMAL_HWFS_EVENT_SETTINGS_PARAMS *>(data));
 }
 
 static NvAPI_Status CallThermalPmumonThermChannelsGetSamples(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_ThermalPmumonThermChannelsGetSamples(
+  return NvApi().NvAPI_GPU_ThermalPmumonThermChannelsGetSamples(
       gpu, reinterpret_cast<NV_GPU_THERMAL_PMUMON_THERM_CHANNELS_GET_SAMPLES *>(data));
 }
 
 static NvAPI_Status CallPerfPoliciesGetInfo(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_PerfPoliciesGetInfo(gpu, reinterpret_cast<NV_GPU_PERF_POLICIES_INFO_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_PerfPoliciesGetInfo(gpu, reinterpret_cast<NV_GPU_PERF_POLICIES_INFO_PARAMS *>(data));
 }
 
 static NvAPI_Status CallPerfPoliciesGetStatus(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_PerfPoliciesGetStatus(gpu, reinterpret_cast<NV_GPU_PERF_POLICIES_STATUS_PARAMS *>(data));
+  return NvApi().NvAPI_GPU_PerfPoliciesGetStatus(gpu, reinterpret_cast<NV_GPU_PERF_POLICIES_STATUS_PARAMS *>(data));
 }
 
 static NvAPI_Status CallPerfPmumonPerfPoliciesGetSamples(NvPhysicalGpuHandle gpu, void *data) {
-  return NvAPI_GPU_PerfPmumonPerfPoliciesGetSamples(
+  return NvApi().NvAPI_GPU_PerfPmumonPerfPoliciesGetSamples(
       gpu, reinterpret_cast<NV_GPU_PERF_PMUMON_PERF_POLICIES_GET_SAMPLES *>(data));
 }
 
@@ -795,12 +800,12 @@ static const ApiSpec *FindApiSpec(const ApiSpec *specs, size_t count, const char
 }
 
 static void PrintApiList(const ApiSpec *specs, size_t count) {
-  for (size_t i = 0; i < count; ++i) { std::printf("  %s - %s\n", specs[i].name, specs[i].desc); }
+  for (size_t i = 0; i < count; ++i) { Printf("  %s - %s\n", specs[i].name, specs[i].desc); }
 }
 
 static int RunRawApiCommand(const char *groupLabel, const ApiSpec *specs, size_t count, int argc, char **argv) {
   if (argc < 1 || std::strcmp(argv[0], "list") == 0) {
-    std::printf("%s api list:\n", groupLabel);
+    Printf("%s api list:\n", groupLabel);
     PrintApiList(specs, count);
     return 0;
   }
@@ -811,13 +816,13 @@ static int RunRawApiCommand(const char *groupLabel, const ApiSpec *specs, size_t
 
   const ApiSpec *spec = FindApiSpec(specs, count, apiName);
   if (!spec) {
-    std::printf("Unknown %s api: %s\n", groupLabel, apiName);
+    Printf("Unknown %s api: %s\n", groupLabel, apiName);
     PrintApiList(specs, count);
     return 1;
   }
 
   if (spec->isSet && !args.inPath) {
-    std::printf("Missing required --in for %s api %s\n", groupLabel, apiName);
+    Printf("Missing required --in for %s api %s\n", groupLabel, apiName);
     return 1;
   }
 
@@ -826,7 +831,7 @@ static int RunRawApiCommand(const char *groupLabel, const ApiSpec *specs, size_t
   if (!CollectGpus(args.hasIndex, args.index, handles, indices)) { return 1; }
 
   bool multiGpu = handles.size() > 1;
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     std::unique_ptr<NvU8[]> buffer(new NvU8[spec->size]);
@@ -839,44 +844,43 @@ static int RunRawApiCommand(const char *groupLabel, const ApiSpec *specs, size_t
     NvAPI_Status status = spec->call(handles[i], buffer.get());
     if (status != NVAPI_OK) {
       PrintNvapiError("  NVAPI call failed", status);
-      continue;
+      return 0;
     }
 
     NvU32 version = *reinterpret_cast<NvU32 *>(buffer.get());
-    std::printf("  %s ok (size=%zu version=0x%08X)\n", apiName, spec->size, version);
+    Printf("  %s ok (size=%zu version=0x%08X)\n", apiName, spec->size, version);
 
     if (args.outPath) {
       std::string outPath = multiGpu ? AppendGpuIndexToPath(args.outPath, indices[i]) : std::string(args.outPath);
       if (!WriteBinaryFile(outPath.c_str(), buffer.get(), spec->size)) { return 1; }
-      std::printf("  Wrote output: %s\n", outPath.c_str());
+      Printf("  Wrote output: %s\n", outPath.c_str());
     }
 
     const bool dumpHex = args.raw || (!spec->isSet && !args.outPath);
     if (dumpHex) { DumpHex(buffer.get(), spec->size); }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 static void PrintClockUsage() {
-  std::printf("Clock API access:\n");
-  std::printf("  %s gpu clock list\n", kToolName);
-  std::printf("  %s gpu clock <name> [--index N] [--raw] [--out PATH] [--in PATH]\n", kToolName);
-  std::printf("  %s gpu clock api list\n", kToolName);
-  std::printf("  %s gpu clock api <name> [--index N] [--raw] [--out PATH] [--in PATH]\n", kToolName);
-  std::printf("     [--domain N] [--class N]\n");
+  Printf("Clock API access:\n");
+  Printf("  %s gpu clock list\n", kToolName);
+  Printf("  %s gpu clock <name> [--index N] [--raw] [--out PATH] [--in PATH]\n", kToolName);
+  Printf("  %s gpu clock api list\n", kToolName);
+  Printf("  %s gpu clock api <name> [--index N] [--raw] [--out PATH] [--in PATH]\n", kToolName);
+  Printf("     [--domain N] [--class N]\n");
 }
 
 static void PrintPowerUsage() {
-  std::printf("Power API access:\n");
-  std::printf("  %s gpu power api list\n", kToolName);
-  std::printf("  %s gpu power api <name> [--index N] [--raw] [--out PATH] [--in PATH]\n", kToolName);
+  Printf("Power API access:\n");
+  Printf("  %s gpu power api list\n", kToolName);
+  Printf("  %s gpu power api <name> [--index N] [--raw] [--out PATH] [--in PATH]\n", kToolName);
 }
 
 static void PrintThermalUsage() {
-  std::printf("Thermal API access:\n");
-  std::printf("  %s gpu thermal api list\n", kToolName);
-  std::printf("  %s gpu thermal api <name> [--index N] [--raw] [--out PATH] [--in PATH]\n", kToolName);
+  Printf("Thermal API access:\n");
+  Printf("  %s gpu thermal api list\n", kToolName);
+  Printf("  %s gpu thermal api <name> [--index N] [--raw] [--out PATH] [--in PATH]\n", kToolName);
 }
 
 int CmdGpuClock(int argc, char **argv) {
@@ -919,4 +923,15 @@ int CmdGpuThermalApi(int argc, char **argv) {
   return RunRawApiCommand("thermal", kThermalApiSpecs, sizeof(kThermalApiSpecs) / sizeof(kThermalApiSpecs[0]), argc,
                           argv);
 }
+
+static const ApiSpecGroup kApiSpecGroups[] = {
+    {"clock", kClockApiSpecs, sizeof(kClockApiSpecs) / sizeof(kClockApiSpecs[0])},
+    {"power", kPowerApiSpecs, sizeof(kPowerApiSpecs) / sizeof(kPowerApiSpecs[0])},
+    {"thermal", kThermalApiSpecs, sizeof(kThermalApiSpecs) / sizeof(kThermalApiSpecs[0])},
+};
+
+const ApiSpecGroup *RawApiGroups(size_t *count) {
+  *count = sizeof(kApiSpecGroups) / sizeof(kApiSpecGroups[0]);
+  return kApiSpecGroups;
+}
 } // namespace nvcli
@@ -97,28 +97,6 @@ const char *PowerChannelTypeName(NV_GPU_POWER_MONITOR_POWER_CHANNEL_TYPE type) {
   }
 }
 
-const char *PowerChannelRailName(NV_GPU_POWER_CHANNEL_POWER_RAIL rail) {
-  switch (rail) {
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_UNKNOWN: return "UNKNOWN";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_NVVDD: return "OUTPUT_NVVDD";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_FBVDD: return "OUTPUT_FBVDD";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_FBVDDQ: return "OUTPUT_FBVDDQ";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_FBVDD_Q: return "OUTPUT_FBVDD_Q";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_PEXVDD: return "OUTPUT_PEXVDD";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_A3V3: return "OUTPUT_A3V3";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_OUTPUT_TOTAL_GPU: return "OUTPUT_TOTAL_GPU";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_PEX12V: return "INPUT_PEX12V";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_PEX3V3: return "INPUT_PEX3V3";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_EXT12V_8PIN0: return "INPUT_EXT12V_8PIN0";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_EXT12V_8PIN1: return "INPUT_EXT12V_8PIN1";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_EXT12V_6PIN0: return "INPUT_EXT12V_6PIN0";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_EXT12V_6PIN1: return "INPUT_EXT12V_6PIN1";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_TOTAL_BOARD: return "INPUT_TOTAL_BOARD";
-  case NV_GPU_POWER_CHANNEL_POWER_RAIL_INPUT_TOTAL_BOARD2: return "INPUT_TOTAL_BOARD2";
-  default: return "UNKNOWN";
-  }
-}
-
 const char *LeakageTypeName(NV_GPU_POWER_LEAKAGE_TYPE type) {
   switch (type) {
   case NV_GPU_POWER_LEAKAGE_TYPE_DTCS10: return "DTCS10";
@@ -172,52 +150,52 @@ const char *IllumCtrlModeName(NV_GPU_CLIENT_ILLUM_CTRL_MODE mode) {
 void PrintClientFanCoolersInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_FAN_COOLERS_INFO info = {};
   info.version = NV_GPU_CLIENT_FAN_COOLERS_INFO_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientFanCoolersGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanCoolersGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientFanCoolersGetInfo failed", status);
     return;
   }
 
-  std::printf("  Client fan coolers supported: %u\n", info.bIsSupported ? 1 : 0);
-  std::printf("  Client fan coolers: %u\n", info.numCoolers);
+  Printf("  Client fan coolers supported: %u\n", info.bIsSupported ? 1 : 0);
+  Printf("  Client fan coolers: %u\n", info.numCoolers);
   for (NvU8 i = 0; i < info.numCoolers && i < NV_GPU_CLIENT_FAN_COOLERS_NUM_COOLERS_MAX; ++i) {
     const auto &cooler = info.coolers[i];
-    std::printf("    cooler[%u]: id=%s(%u) tach=%u rpm=%u-%u\n", i, ClientFanCoolerName(cooler.coolerId),
-                cooler.coolerId, cooler.bTachSupported ? 1u : 0u, cooler.rpmMin, cooler.rpmMax);
+    Printf("    cooler[%u]: id=%s(%u) tach=%u rpm=%u-%u\n", i, ClientFanCoolerName(cooler.coolerId), cooler.coolerId,
+           cooler.bTachSupported ? 1u : 0u, cooler.rpmMin, cooler.rpmMax);
   }
 }
 
 void PrintClientFanCoolersStatus(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_FAN_COOLERS_STATUS statusData = {};
   statusData.version = NV_GPU_CLIENT_FAN_COOLERS_STATUS_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientFanCoolersGetStatus(handle, &statusData);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanCoolersGetStatus(handle, &statusData);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientFanCoolersGetStatus failed", status);
     return;
   }
 
-  std::printf("  Client fan cooler status: %u\n", statusData.numCoolers);
+  Printf("  Client fan cooler status: %u\n", statusData.numCoolers);
   for (NvU8 i = 0; i < statusData.numCoolers && i < NV_GPU_CLIENT_FAN_COOLERS_NUM_COOLERS_MAX; ++i) {
     const auto &cooler = statusData.coolers[i];
-    std::printf("    cooler[%u]: id=%s(%u) rpm=%u level=%u-%u target=%u\n", i, ClientFanCoolerName(cooler.coolerId),
-                cooler.coolerId, cooler.rpmCurr, cooler.levelMin, cooler.levelMax, cooler.levelTarget);
+    Printf("    cooler[%u]: id=%s(%u) rpm=%u level=%u-%u target=%u\n", i, ClientFanCoolerName(cooler.coolerId),
+           cooler.coolerId, cooler.rpmCurr, cooler.levelMin, cooler.levelMax, cooler.levelTarget);
   }
 }
 
 void PrintClientFanCoolersControl(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_FAN_COOLERS_CONTROL control = {};
   control.version = NV_GPU_CLIENT_FAN_COOLERS_CONTROL_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientFanCoolersGetControl(handle, &control);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanCoolersGetControl(handle, &control);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientFanCoolersGetControl failed", status);
     return;
   }
 
-  std::printf("  Client fan cooler control: %u\n", control.numCoolers);
+  Printf("  Client fan cooler control: %u\n", control.numCoolers);
   for (NvU8 i = 0; i < control.numCoolers && i < NV_GPU_CLIENT_FAN_COOLERS_NUM_COOLERS_MAX; ++i) {
     const auto &cooler = control.coolers[i];
-    std::printf("    cooler[%u]: id=%s(%u) sim=%u%% active=%u\n", i, ClientFanCoolerName(cooler.coolerId),
-                cooler.coolerId, cooler.levelSim, cooler.bLevelSimActive ? 1u : 0u);
+    Printf("    cooler[%u]: id=%s(%u) sim=%u%% active=%u\n", i, ClientFanCoolerName(cooler.coolerId), cooler.coolerId,
+           cooler.levelSim, cooler.bLevelSimActive ? 1u : 0u);
   }
 }
 
@@ -235,11 +213,11 @@ int CmdGpuClientFanCoolersSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -248,11 +226,11 @@ int CmdGpuClientFanCoolersSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--cooler") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --cooler\n");
+        Printf("Missing value for --cooler\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &coolerIndex)) {
-        std::printf("Invalid cooler index: %s\n", argv[i + 1]);
+        Printf("Invalid cooler index: %s\n", argv[i + 1]);
         return 1;
       }
       hasCooler = true;
@@ -261,11 +239,11 @@ int CmdGpuClientFanCoolersSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--level") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --level\n");
+        Printf("Missing value for --level\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &level)) {
-        std::printf("Invalid level: %s\n", argv[i + 1]);
+        Printf("Invalid level: %s\n", argv[i + 1]);
         return 1;
       }
       hasLevel = true;
@@ -274,11 +252,11 @@ int CmdGpuClientFanCoolersSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--enable") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --enable\n");
+        Printf("Missing value for --enable\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &enable)) {
-        std::printf("Invalid enable value: %s\n", argv[i + 1]);
+        Printf("Invalid enable value: %s\n", argv[i + 1]);
         return 1;
       }
       hasEnable = true;
@@ -289,17 +267,17 @@ int CmdGpuClientFanCoolersSet(int argc, char **argv) {
       useDefault = true;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!useDefault) {
     if (!hasCooler) {
-      std::printf("Missing required --cooler\n");
+      Printf("Missing required --cooler\n");
       return 1;
     }
     if (hasLevel && level > 100) {
-      std::printf("Level must be between 0 and 100\n");
+      Printf("Level must be between 0 and 100\n");
       return 1;
     }
     if (!hasEnable && hasLevel) {
@@ -307,7 +285,7 @@ int CmdGpuClientFanCoolersSet(int argc, char **argv) {
       hasEnable = true;
     }
     if (hasEnable && enable && !hasLevel) {
-      std::printf("Missing required --level when enabling override\n");
+      Printf("Missing required --level when enabling override\n");
       return 1;
     }
   }
@@ -316,23 +294,22 @@ int CmdGpuClientFanCoolersSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_CLIENT_FAN_COOLERS_CONTROL control = {};
     control.version = NV_GPU_CLIENT_FAN_COOLERS_CONTROL_VER;
-    NvAPI_Status status = NvAPI_GPU_ClientFanCoolersGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanCoolersGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ClientFanCoolersGetControl failed", status);
-      continue;
+      return 0;
     }
 
     if (useDefault) {
       control.bDefault = 1;
     } else {
       if (coolerIndex >= control.numCoolers) {
-        std::printf("  Cooler index %u out of range (0-%u)\n", coolerIndex,
-                    control.numCoolers ? control.numCoolers - 1 : 0);
-        continue;
+        Printf("  Cooler index %u out of range (0-%u)\n", coolerIndex, control.numCoolers ? control.numCoolers - 1 : 0);
+        return 0;
       }
 
       auto &cooler = control.coolers[coolerIndex];
@@ -345,19 +322,19 @@ int CmdGpuClientFanCoolersSet(int argc, char **argv) {
       }
     }
 
-    status = NvAPI_GPU_ClientFanCoolersSetControl(handles[i], &control);
+    status = NvApi().NvAPI_GPU_ClientFanCoolersSetControl(handles[i], &control);
     if (status == NVAPI_OK) {
-      std::printf("  Client fan cooler control updated.\n");
+      Printf("  Client fan cooler control updated.\n");
     } else {
       PrintNvapiError("  NvAPI_GPU_ClientFanCoolersSetControl failed", status);
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuClientFanCoolers(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing client-fan coolers subcommand\n");
+    Printf("Missing client-fan coolers subcommand\n");
     return 1;
   }
   if (std::strcmp(argv[0], "info") == 0) {
@@ -368,11 +345,11 @@ int CmdGpuClientFanCoolers(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientFanCoolersInfo(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "status") == 0) {
     NvU32 index = 0;
@@ -381,11 +358,11 @@ int CmdGpuClientFanCoolers(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientFanCoolersStatus(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "control") == 0) {
     NvU32 index = 0;
@@ -394,74 +371,74 @@ int CmdGpuClientFanCoolers(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientFanCoolersControl(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "set") == 0) { return CmdGpuClientFanCoolersSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown client-fan coolers subcommand: %s\n", argv[0]);
+  Printf("Unknown client-fan coolers subcommand: %s\n", argv[0]);
   return 1;
 }
 
 void PrintClientFanPoliciesInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_FAN_POLICIES_INFO info = {};
   info.version = NV_GPU_CLIENT_FAN_POLICIES_INFO_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientFanPoliciesGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanPoliciesGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientFanPoliciesGetInfo failed", status);
     return;
   }
 
-  std::printf("  Client fan policies supported: %u\n", info.isSupported ? 1 : 0);
-  std::printf("  Client fan policies: %u\n", info.numPolicies);
+  Printf("  Client fan policies supported: %u\n", info.isSupported ? 1 : 0);
+  Printf("  Client fan policies: %u\n", info.numPolicies);
   for (NvU8 i = 0; i < info.numPolicies && i < NV_GPU_CLIENT_FAN_POLICIES_NUM_POLICIES_MAX; ++i) {
     const auto &policy = info.policies[i];
-    std::printf("    policy[%u]: id=%s(%u) idx=%u arbiterMask=0x%02X stopSupported=%u stopDefault=%u curveAdj=%u\n", i,
-                ClientFanPolicyName(policy.policyId), policy.policyId, policy.policyIdx, policy.arbiterMask,
-                policy.fanStopFeatureSupported ? 1u : 0u, policy.fanStopFeatureEnableDefault ? 1u : 0u,
-                policy.fanCurveAdjSupported ? 1u : 0u);
+    Printf("    policy[%u]: id=%s(%u) idx=%u arbiterMask=0x%02X stopSupported=%u stopDefault=%u curveAdj=%u\n", i,
+           ClientFanPolicyName(policy.policyId), policy.policyId, policy.policyIdx, policy.arbiterMask,
+           policy.fanStopFeatureSupported ? 1u : 0u, policy.fanStopFeatureEnableDefault ? 1u : 0u,
+           policy.fanCurveAdjSupported ? 1u : 0u);
   }
 }
 
 void PrintClientFanPoliciesStatus(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_FAN_POLICIES_STATUS statusData = {};
   statusData.version = NV_GPU_CLIENT_FAN_POLICIES_STATUS_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientFanPoliciesGetStatus(handle, &statusData);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanPoliciesGetStatus(handle, &statusData);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientFanPoliciesGetStatus failed", status);
     return;
   }
 
-  std::printf("  Client fan policy status: %u\n", statusData.numPolicies);
+  Printf("  Client fan policy status: %u\n", statusData.numPolicies);
   for (NvU8 i = 0; i < statusData.numPolicies && i < NV_GPU_CLIENT_FAN_POLICIES_NUM_POLICIES_MAX; ++i) {
     const auto &policy = statusData.policies[i];
-    std::printf("    policy[%u]: id=%s(%u) stopActive=%u\n", i, ClientFanPolicyName(policy.policyId), policy.policyId,
-                policy.fanStopFeatureActive ? 1u : 0u);
+    Printf("    policy[%u]: id=%s(%u) stopActive=%u\n", i, ClientFanPolicyName(policy.policyId), policy.policyId,
+           policy.fanStopFeatureActive ? 1u : 0u);
   }
 }
 
 void PrintClientFanPoliciesControl(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_FAN_POLICIES_CONTROL control = {};
   control.version = NV_GPU_CLIENT_FAN_POLICIES_CONTROL_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientFanPoliciesGetControl(handle, &control);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanPoliciesGetControl(handle, &control);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientFanPoliciesGetControl failed", status);
     return;
   }
 
-  std::printf("  Client fan policy control: %u\n", control.numPolicies);
+  Printf("  Client fan policy control: %u\n", control.numPolicies);
   for (NvU8 i = 0; i < control.numPolicies && i < NV_GPU_CLIENT_FAN_POLICIES_NUM_POLICIES_MAX; ++i) {
     const auto &policy = control.policies[i];
-    std::printf("    policy[%u]: id=%s(%u) idx=%u stopEnable=%u\n", i, ClientFanPolicyName(policy.policyId),
-                policy.policyId, policy.policyIdx, policy.fanStopFeatureEnable ? 1u : 0u);
+    Printf("    policy[%u]: id=%s(%u) idx=%u stopEnable=%u\n", i, ClientFanPolicyName(policy.policyId), policy.policyId,
+           policy.policyIdx, policy.fanStopFeatureEnable ? 1u : 0u);
     for (NvU32 p = 0; p < NV_GPU_CLIENT_FAN_POLICY_IIR_TJ_FIXED_DUAL_SLOPE_PWM_FAN_CURVE_PTS; ++p) {
       const auto &pt = policy.fanCurvePts[p];
       const float tj = static_cast<float>(pt.fanTj) / 256.0f;
       const float pwm = static_cast<float>(pt.fanPwm) / 65536.0f;
-      std::printf("      curve[%u]: tj=%.2fC pwm=%.2f%% rpm=%u\n", p, tj, pwm, pt.fanRpm);
+      Printf("      curve[%u]: tj=%.2fC pwm=%.2f%% rpm=%u\n", p, tj, pwm, pt.fanRpm);
     }
   }
 }
@@ -478,11 +455,11 @@ int CmdGpuClientFanPoliciesSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -491,11 +468,11 @@ int CmdGpuClientFanPoliciesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--policy") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --policy\n");
+        Printf("Missing value for --policy\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &policyIndex)) {
-        std::printf("Invalid policy index: %s\n", argv[i + 1]);
+        Printf("Invalid policy index: %s\n", argv[i + 1]);
         return 1;
       }
       hasPolicy = true;
@@ -504,11 +481,11 @@ int CmdGpuClientFanPoliciesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--fan-stop") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --fan-stop\n");
+        Printf("Missing value for --fan-stop\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &fanStopEnable)) {
-        std::printf("Invalid fan-stop value: %s\n", argv[i + 1]);
+        Printf("Invalid fan-stop value: %s\n", argv[i + 1]);
         return 1;
       }
       hasFanStop = true;
@@ -519,17 +496,17 @@ int CmdGpuClientFanPoliciesSet(int argc, char **argv) {
       useDefault = true;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!useDefault) {
     if (!hasPolicy) {
-      std::printf("Missing required --policy\n");
+      Printf("Missing required --policy\n");
       return 1;
     }
     if (!hasFanStop) {
-      std::printf("Missing required --fan-stop\n");
+      Printf("Missing required --fan-stop\n");
       return 1;
     }
   }
@@ -538,41 +515,41 @@ int CmdGpuClientFanPoliciesSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_CLIENT_FAN_POLICIES_CONTROL control = {};
     control.version = NV_GPU_CLIENT_FAN_POLICIES_CONTROL_VER;
-    NvAPI_Status status = NvAPI_GPU_ClientFanPoliciesGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanPoliciesGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ClientFanPoliciesGetControl failed", status);
-      continue;
+      return 0;
     }
 
     if (useDefault) {
       control.bDefault = 1;
     } else {
       if (policyIndex >= control.numPolicies) {
-        std::printf("  Policy index %u out of range (0-%u)\n", policyIndex,
-                    control.numPolicies ? control.numPolicies - 1 : 0);
-        continue;
+        Printf("  Policy index %u out of range (0-%u)\n", policyIndex,
+               control.numPolicies ? control.numPolicies - 1 : 0);
+        return 0;
       }
       auto &policy = control.policies[policyIndex];
       policy.fanStopFeatureEnable = fanStopEnable ? 1u : 0u;
     }
 
-    status = NvAPI_GPU_ClientFanPoliciesSetControl(handles[i], &control);
+    status = NvApi().NvAPI_GPU_ClientFanPoliciesSetControl(handles[i], &control);
     if (status == NVAPI_OK) {
-      std::printf("  Client fan policy control updated.\n");
+      Printf("  Client fan policy control updated.\n");
     } else {
       PrintNvapiError("  NvAPI_GPU_ClientFanPoliciesSetControl failed", status);
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuClientFanPolicies(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing client-fan policies subcommand\n");
+    Printf("Missing client-fan policies subcommand\n");
     return 1;
   }
   if (std::strcmp(argv[0], "info") == 0) {
@@ -582,11 +559,11 @@ int CmdGpuClientFanPolicies(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientFanPoliciesInfo(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "status") == 0) {
     NvU32 index = 0;
@@ -595,11 +572,11 @@ int CmdGpuClientFanPolicies(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientFanPoliciesStatus(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "control") == 0) {
     NvU32 index = 0;
@@ -608,67 +585,65 @@ int CmdGpuClientFanPolicies(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientFanPoliciesControl(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "set") == 0) { return CmdGpuClientFanPoliciesSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown client-fan policies subcommand: %s\n", argv[0]);
+  Printf("Unknown client-fan policies subcommand: %s\n", argv[0]);
   return 1;
 }
 
 void PrintClientFanArbitersInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_FAN_ARBITERS_INFO info = {};
   info.version = NV_GPU_CLIENT_FAN_ARBITERS_INFO_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientFanArbitersGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanArbitersGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientFanArbitersGetInfo failed", status);
     return;
   }
 
-  std::printf("  Client fan arbiters: %u\n", info.numArbiters);
+  Printf("  Client fan arbiters: %u\n", info.numArbiters);
   for (NvU8 i = 0; i < info.numArbiters && i < NV_GPU_CLIENT_FAN_ARBITERS_NUM_ARBITERS_MAX; ++i) {
     const auto &arbiter = info.arbiters[i];
-    std::printf("    arbiter[%u]: idx=%u cooler=%s(%u) stopSupported=%u stopDefault=%u\n", i, arbiter.arbiterIdx,
-                ClientFanCoolerName(arbiter.coolerId), arbiter.coolerId, arbiter.fanStopFeatureSupported ? 1u : 0u,
-                arbiter.fanStopFeatureEnableDefault ? 1u : 0u);
+    Printf("    arbiter[%u]: idx=%u cooler=%s(%u) stopSupported=%u stopDefault=%u\n", i, arbiter.arbiterIdx,
+           ClientFanCoolerName(arbiter.coolerId), arbiter.coolerId, arbiter.fanStopFeatureSupported ? 1u : 0u,
+           arbiter.fanStopFeatureEnableDefault ? 1u : 0u);
   }
 }
 
 void PrintClientFanArbitersStatus(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_FAN_ARBITERS_STATUS statusData = {};
   statusData.version = NV_GPU_CLIENT_FAN_ARBITERS_STATUS_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientFanArbitersGetStatus(handle, &statusData);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanArbitersGetStatus(handle, &statusData);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientFanArbitersGetStatus failed", status);
     return;
   }
 
-  std::printf("  Client fan arbiter status: %u\n", statusData.numArbiters);
+  Printf("  Client fan arbiter status: %u\n", statusData.numArbiters);
   for (NvU8 i = 0; i < statusData.numArbiters && i < NV_GPU_CLIENT_FAN_ARBITERS_NUM_ARBITERS_MAX; ++i) {
     const auto &arbiter = statusData.arbiters[i];
-    std::printf("    arbiter[%u]: idx=%u stopActive=%u\n", i, arbiter.arbiterIdx,
-                arbiter.fanStopFeatureActive ? 1u : 0u);
+    Printf("    arbiter[%u]: idx=%u stopActive=%u\n", i, arbiter.arbiterIdx, arbiter.fanStopFeatureActive ? 1u : 0u);
   }
 }
 
 void PrintClientFanArbitersControl(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_FAN_ARBITERS_CONTROL control = {};
   control.version = NV_GPU_CLIENT_FAN_ARBITERS_CONTROL_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientFanArbitersGetControl(handle, &control);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanArbitersGetControl(handle, &control);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientFanArbitersGetControl failed", status);
     return;
   }
 
-  std::printf("  Client fan arbiter control: %u\n", control.numArbiters);
+  Printf("  Client fan arbiter control: %u\n", control.numArbiters);
   for (NvU8 i = 0; i < control.numArbiters && i < NV_GPU_CLIENT_FAN_ARBITERS_NUM_ARBITERS_MAX; ++i) {
     const auto &arbiter = control.arbiters[i];
-    std::printf("    arbiter[%u]: idx=%u stopEnable=%u\n", i, arbiter.arbiterIdx,
-                arbiter.fanStopFeatureEnable ? 1u : 0u);
+    Printf("    arbiter[%u]: idx=%u stopEnable=%u\n", i, arbiter.arbiterIdx, arbiter.fanStopFeatureEnable ? 1u : 0u);
   }
 }
 
@@ -683,11 +658,11 @@ int CmdGpuClientFanArbitersSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -696,11 +671,11 @@ int CmdGpuClientFanArbitersSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--arbiter") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --arbiter\n");
+        Printf("Missing value for --arbiter\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &arbiterIndex)) {
-        std::printf("Invalid arbiter index: %s\n", argv[i + 1]);
+        Printf("Invalid arbiter index: %s\n", argv[i + 1]);
         return 1;
       }
       hasArbiter = true;
@@ -709,62 +684,62 @@ int CmdGpuClientFanArbitersSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--fan-stop") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --fan-stop\n");
+        Printf("Missing value for --fan-stop\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &fanStopEnable)) {
-        std::printf("Invalid fan-stop value: %s\n", argv[i + 1]);
+        Printf("Invalid fan-stop value: %s\n", argv[i + 1]);
         return 1;
       }
       hasFanStop = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasArbiter) {
-    std::printf("Missing required --arbiter\n");
+    Printf("Missing required --arbiter\n");
     return 1;
   }
   if (!hasFanStop) {
-    std::printf("Missing required --fan-stop\n");
+    Printf("Missing required --fan-stop\n");
     return 1;
   }
   std::vector<NvPhysicalGpuHandle> handles;
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_CLIENT_FAN_ARBITERS_CONTROL control = {};
     control.version = NV_GPU_CLIENT_FAN_ARBITERS_CONTROL_VER;
-    NvAPI_Status status = NvAPI_GPU_ClientFanArbitersGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ClientFanArbitersGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ClientFanArbitersGetControl failed", status);
-      continue;
+      return 0;
     }
     if (arbiterIndex >= control.numArbiters) {
-      std::printf("  Arbiter index %u out of range (0-%u)\n", arbiterIndex,
-                  control.numArbiters ? control.numArbiters - 1 : 0);
-      continue;
+      Printf("  Arbiter index %u out of range (0-%u)\n", arbiterIndex,
+             control.numArbiters ? control.numArbiters - 1 : 0);
+      return 0;
     }
     control.arbiters[arbiterIndex].fanStopFeatureEnable = fanStopEnable ? 1u : 0u;
 
-    status = NvAPI_GPU_ClientFanArbitersSetControl(handles[i], &control);
+    status = NvApi().NvAPI_GPU_ClientFanArbitersSetControl(handles[i], &control);
     if (status == NVAPI_OK) {
-      std::printf("  Client fan arbiter control updated.\n");
+      Printf("  Client fan arbiter control updated.\n");
     } else {
       PrintNvapiError("  NvAPI_GPU_ClientFanArbitersSetControl failed", status);
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuClientFanArbiters(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing client-fan arbiters subcommand\n");
+    Printf("Missing client-fan arbiters subcommand\n");
     return 1;
   }
   if (std::strcmp(argv[0], "info") == 0) {
@@ -774,11 +749,11 @@ int CmdGpuClientFanArbiters(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientFanArbitersInfo(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "status") == 0) {
     NvU32 index = 0;
@@ -787,11 +762,11 @@ int CmdGpuClientFanArbiters(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientFanArbitersStatus(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "control") == 0) {
     NvU32 index = 0;
@@ -800,41 +775,41 @@ int CmdGpuClientFanArbiters(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientFanArbitersControl(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "set") == 0) { return CmdGpuClientFanArbitersSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown client-fan arbiters subcommand: %s\n", argv[0]);
+  Printf("Unknown client-fan arbiters subcommand: %s\n", argv[0]);
   return 1;
 }
 
 void PrintClientIllumDevicesInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_ILLUM_DEVICE_INFO_PARAMS info = {};
   info.version = NV_GPU_CLIENT_ILLUM_DEVICE_INFO_PARAMS_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientIllumDevicesGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientIllumDevicesGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientIllumDevicesGetInfo failed", status);
     return;
   }
 
-  std::printf("  Illum devices: %u\n", info.numIllumDevices);
+  Printf("  Illum devices: %u\n", info.numIllumDevices);
   for (NvU32 i = 0; i < info.numIllumDevices && i < NV_GPU_CLIENT_ILLUM_DEVICE_NUM_DEVICES_MAX; ++i) {
     const auto &device = info.devices[i];
-    std::printf("    device[%u]: type=%s(%u) ctrlModeMask=0x%08X\n", i, IllumDeviceTypeName(device.type), device.type,
-                device.ctrlModeMask);
+    Printf("    device[%u]: type=%s(%u) ctrlModeMask=0x%08X\n", i, IllumDeviceTypeName(device.type), device.type,
+           device.ctrlModeMask);
 
     if (device.type == NV_GPU_CLIENT_ILLUM_DEVICE_TYPE_MCUV10) {
-      std::printf("      i2cDevIdx=%u\n", device.data.mcuv10.i2cDevIdx);
+      Printf("      i2cDevIdx=%u\n", device.data.mcuv10.i2cDevIdx);
     } else if (device.type == NV_GPU_CLIENT_ILLUM_DEVICE_TYPE_GPIO_PWM_RGBW_V10) {
-      std::printf("      pins: r=%u g=%u b=%u w=%u\n", device.data.gpioPwmRgbwv10.gpioPinRed,
-                  device.data.gpioPwmRgbwv10.gpioPinGreen, device.data.gpioPwmRgbwv10.gpioPinBlue,
-                  device.data.gpioPwmRgbwv10.gpioPinWhite);
+      Printf("      pins: r=%u g=%u b=%u w=%u\n", device.data.gpioPwmRgbwv10.gpioPinRed,
+             device.data.gpioPwmRgbwv10.gpioPinGreen, device.data.gpioPwmRgbwv10.gpioPinBlue,
+             device.data.gpioPwmRgbwv10.gpioPinWhite);
     } else if (device.type == NV_GPU_CLIENT_ILLUM_DEVICE_TYPE_GPIO_PWM_SINGLE_COLOR_V10) {
-      std::printf("      pin: single=%u\n", device.data.gpioPwmSingleColorv10.gpioPinSingleColor);
+      Printf("      pin: single=%u\n", device.data.gpioPwmSingleColorv10.gpioPinSingleColor);
     }
   }
 }
@@ -842,18 +817,17 @@ void PrintClientIllumDevicesInfo(NvPhysicalGpuHandle handle) {
 void PrintClientIllumDevicesControl(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_ILLUM_DEVICE_CONTROL_PARAMS control = {};
   control.version = NV_GPU_CLIENT_ILLUM_DEVICE_CONTROL_PARAMS_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientIllumDevicesGetControl(handle, &control);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientIllumDevicesGetControl(handle, &control);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientIllumDevicesGetControl failed", status);
     return;
   }
 
-  std::printf("  Illum device control: %u\n", control.numIllumDevices);
+  Printf("  Illum device control: %u\n", control.numIllumDevices);
   for (NvU32 i = 0; i < control.numIllumDevices && i < NV_GPU_CLIENT_ILLUM_DEVICE_NUM_DEVICES_MAX; ++i) {
     const auto &device = control.devices[i];
-    std::printf("    device[%u]: type=%s(%u) sync=%u timestamp=%llu\n", i, IllumDeviceTypeName(device.type),
-                device.type, device.syncData.bSync ? 1u : 0u,
-                static_cast<unsigned long long>(device.syncData.timeStampms));
+    Printf("    device[%u]: type=%s(%u) sync=%u timestamp=%llu\n", i, IllumDeviceTypeName(device.type), device.type,
+           device.syncData.bSync ? 1u : 0u, static_cast<unsigned long long>(device.syncData.timeStampms));
   }
 }
 
@@ -870,11 +844,11 @@ int CmdGpuClientIllumDevicesSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -883,11 +857,11 @@ int CmdGpuClientIllumDevicesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--device") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --device\n");
+        Printf("Missing value for --device\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &deviceIndex)) {
-        std::printf("Invalid device index: %s\n", argv[i + 1]);
+        Printf("Invalid device index: %s\n", argv[i + 1]);
         return 1;
       }
       hasDevice = true;
@@ -896,11 +870,11 @@ int CmdGpuClientIllumDevicesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--sync") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --sync\n");
+        Printf("Missing value for --sync\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &sync)) {
-        std::printf("Invalid sync value: %s\n", argv[i + 1]);
+        Printf("Invalid sync value: %s\n", argv[i + 1]);
         return 1;
       }
       hasSync = true;
@@ -909,107 +883,106 @@ int CmdGpuClientIllumDevicesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--timestamp-ms") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --timestamp-ms\n");
+        Printf("Missing value for --timestamp-ms\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &timestampMs)) {
-        std::printf("Invalid timestamp: %s\n", argv[i + 1]);
+        Printf("Invalid timestamp: %s\n", argv[i + 1]);
         return 1;
       }
       hasTimestamp = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasDevice) {
-    std::printf("Missing required --device\n");
+    Printf("Missing required --device\n");
     return 1;
   }
   if (!hasSync) {
-    std::printf("Missing required --sync\n");
+    Printf("Missing required --sync\n");
     return 1;
   }
   std::vector<NvPhysicalGpuHandle> handles;
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_CLIENT_ILLUM_DEVICE_CONTROL_PARAMS control = {};
     control.version = NV_GPU_CLIENT_ILLUM_DEVICE_CONTROL_PARAMS_VER;
-    NvAPI_Status status = NvAPI_GPU_ClientIllumDevicesGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ClientIllumDevicesGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ClientIllumDevicesGetControl failed", status);
-      continue;
+      return 0;
     }
     if (deviceIndex >= control.numIllumDevices) {
-      std::printf("  Device index %u out of range (0-%u)\n", deviceIndex,
-                  control.numIllumDevices ? control.numIllumDevices - 1 : 0);
-      continue;
+      Printf("  Device index %u out of range (0-%u)\n", deviceIndex,
+             control.numIllumDevices ? control.numIllumDevices - 1 : 0);
+      return 0;
     }
     auto &device = control.devices[deviceIndex];
     device.syncData.bSync = sync ? NV_TRUE : NV_FALSE;
     if (hasTimestamp) { device.syncData.timeStampms = static_cast<NvU64>(timestampMs); }
-    status = NvAPI_GPU_ClientIllumDevicesSetControl(handles[i], &control);
+    status = NvApi().NvAPI_GPU_ClientIllumDevicesSetControl(handles[i], &control);
     if (status == NVAPI_OK) {
-      std::printf("  Illum device control updated.\n");
+      Printf("  Illum device control updated.\n");
     } else {
       PrintNvapiError("  NvAPI_GPU_ClientIllumDevicesSetControl failed", status);
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 void PrintClientIllumZonesInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_ILLUM_ZONE_INFO_PARAMS info = {};
   info.version = NV_GPU_CLIENT_ILLUM_ZONE_INFO_PARAMS_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientIllumZonesGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientIllumZonesGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientIllumZonesGetInfo failed", status);
     return;
   }
 
-  std::printf("  Illum zones: %u\n", info.numIllumZones);
+  Printf("  Illum zones: %u\n", info.numIllumZones);
   for (NvU32 i = 0; i < info.numIllumZones && i < NV_GPU_CLIENT_ILLUM_ZONE_NUM_ZONES_MAX; ++i) {
     const auto &zone = info.zones[i];
-    std::printf("    zone[%u]: type=%s(%u) device=%u provider=%u location=%s(%u)\n", i, IllumZoneTypeName(zone.type),
-                zone.type, zone.illumDeviceIdx, zone.provIdx, IllumZoneLocationName(zone.zoneLocation),
-                zone.zoneLocation);
+    Printf("    zone[%u]: type=%s(%u) device=%u provider=%u location=%s(%u)\n", i, IllumZoneTypeName(zone.type),
+           zone.type, zone.illumDeviceIdx, zone.provIdx, IllumZoneLocationName(zone.zoneLocation), zone.zoneLocation);
   }
 }
 
 void PrintClientIllumZonesControl(NvPhysicalGpuHandle handle) {
   NV_GPU_CLIENT_ILLUM_ZONE_CONTROL_PARAMS control = {};
   control.version = NV_GPU_CLIENT_ILLUM_ZONE_CONTROL_PARAMS_VER;
-  NvAPI_Status status = NvAPI_GPU_ClientIllumZonesGetControl(handle, &control);
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClientIllumZonesGetControl(handle, &control);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_ClientIllumZonesGetControl failed", status);
     return;
   }
 
-  std::printf("  Illum zone control: %u\n", control.numIllumZonesControl);
+  Printf("  Illum zone control: %u\n", control.numIllumZonesControl);
   for (NvU32 i = 0; i < control.numIllumZonesControl && i < NV_GPU_CLIENT_ILLUM_ZONE_NUM_ZONES_MAX; ++i) {
     const auto &zone = control.zones[i];
-    std::printf("    zone[%u]: type=%s(%u) mode=%s(%u)\n", i, IllumZoneTypeName(zone.type), zone.type,
-                IllumCtrlModeName(zone.ctrlMode), zone.ctrlMode);
+    Printf("    zone[%u]: type=%s(%u) mode=%s(%u)\n", i, IllumZoneTypeName(zone.type), zone.type,
+           IllumCtrlModeName(zone.ctrlMode), zone.ctrlMode);
 
     if (zone.ctrlMode == NV_GPU_CLIENT_ILLUM_CTRL_MODE_MANUAL) {
       if (zone.type == NV_GPU_CLIENT_ILLUM_ZONE_TYPE_RGB) {
         const auto &rgb = zone.data.rgb.data.manualRGB.rgbParams;
-        std::printf("      rgb=%u,%u,%u brightness=%u\n", rgb.colorR, rgb.colorG, rgb.colorB, rgb.brightnessPct);
+        Printf("      rgb=%u,%u,%u brightness=%u\n", rgb.colorR, rgb.colorG, rgb.colorB, rgb.brightnessPct);
       } else if (zone.type == NV_GPU_CLIENT_ILLUM_ZONE_TYPE_RGBW) {
         const auto &rgbw = zone.data.rgbw.data.manualRGBW.rgbwParams;
-        std::printf("      rgbw=%u,%u,%u,%u brightness=%u\n", rgbw.colorR, rgbw.colorG, rgbw.colorB, rgbw.colorW,
-                    rgbw.brightnessPct);
+        Printf("      rgbw=%u,%u,%u,%u brightness=%u\n", rgbw.colorR, rgbw.colorG, rgbw.colorB, rgbw.colorW,
+               rgbw.brightnessPct);
       } else if (zone.type == NV_GPU_CLIENT_ILLUM_ZONE_TYPE_SINGLE_COLOR) {
         const auto &single = zone.data.singleColor.data.manualSingleColor.singleColorParams;
-        std::printf("      brightness=%u\n", single.brightnessPct);
+        Printf("      brightness=%u\n", single.brightnessPct);
       } else if (zone.type == NV_GPU_CLIENT_ILLUM_ZONE_TYPE_COLOR_FIXED) {
         const auto &fixed = zone.data.colorFixed.data.manualColorFixed.colorFixedParams;
-        std::printf("      brightness=%u\n", fixed.brightnessPct);
+        Printf("      brightness=%u\n", fixed.brightnessPct);
       }
     }
   }
@@ -1037,11 +1010,11 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -1050,11 +1023,11 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--zone") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --zone\n");
+        Printf("Missing value for --zone\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &zoneIndex)) {
-        std::printf("Invalid zone index: %s\n", argv[i + 1]);
+        Printf("Invalid zone index: %s\n", argv[i + 1]);
         return 1;
       }
       hasZone = true;
@@ -1063,7 +1036,7 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--mode") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --mode\n");
+        Printf("Missing value for --mode\n");
         return 1;
       }
       mode = ToLowerAscii(argv[i + 1]);
@@ -1073,11 +1046,11 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--brightness") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --brightness\n");
+        Printf("Missing value for --brightness\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &brightness)) {
-        std::printf("Invalid brightness: %s\n", argv[i + 1]);
+        Printf("Invalid brightness: %s\n", argv[i + 1]);
         return 1;
       }
       hasBrightness = true;
@@ -1086,11 +1059,11 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--r") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --r\n");
+        Printf("Missing value for --r\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &colorR)) {
-        std::printf("Invalid r: %s\n", argv[i + 1]);
+        Printf("Invalid r: %s\n", argv[i + 1]);
         return 1;
       }
       hasR = true;
@@ -1099,11 +1072,11 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--g") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --g\n");
+        Printf("Missing value for --g\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &colorG)) {
-        std::printf("Invalid g: %s\n", argv[i + 1]);
+        Printf("Invalid g: %s\n", argv[i + 1]);
         return 1;
       }
       hasG = true;
@@ -1112,11 +1085,11 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--b") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --b\n");
+        Printf("Missing value for --b\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &colorB)) {
-        std::printf("Invalid b: %s\n", argv[i + 1]);
+        Printf("Invalid b: %s\n", argv[i + 1]);
         return 1;
       }
       hasB = true;
@@ -1125,11 +1098,11 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--w") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --w\n");
+        Printf("Missing value for --w\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &colorW)) {
-        std::printf("Invalid w: %s\n", argv[i + 1]);
+        Printf("Invalid w: %s\n", argv[i + 1]);
         return 1;
       }
       hasW = true;
@@ -1140,29 +1113,29 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
       useDefault = true;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!useDefault) {
     if (!hasZone) {
-      std::printf("Missing required --zone\n");
+      Printf("Missing required --zone\n");
       return 1;
     }
     if (!hasMode) {
-      std::printf("Missing required --mode\n");
+      Printf("Missing required --mode\n");
       return 1;
     }
     if (!hasBrightness) {
-      std::printf("Missing required --brightness\n");
+      Printf("Missing required --brightness\n");
       return 1;
     }
     if (brightness > 100) {
-      std::printf("Brightness must be between 0 and 100\n");
+      Printf("Brightness must be between 0 and 100\n");
       return 1;
     }
     if ((hasR && colorR > 255) || (hasG && colorG > 255) || (hasB && colorB > 255) || (hasW && colorW > 255)) {
-      std::printf("Color values must be between 0 and 255\n");
+      Printf("Color values must be between 0 and 255\n");
       return 1;
     }
   }
@@ -1171,23 +1144,23 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_CLIENT_ILLUM_ZONE_CONTROL_PARAMS control = {};
     control.version = NV_GPU_CLIENT_ILLUM_ZONE_CONTROL_PARAMS_VER;
-    NvAPI_Status status = NvAPI_GPU_ClientIllumZonesGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ClientIllumZonesGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ClientIllumZonesGetControl failed", status);
-      continue;
+      return 0;
     }
 
     if (useDefault) {
       control.bDefault = 1;
     } else {
       if (zoneIndex >= control.numIllumZonesControl) {
-        std::printf("  Zone index %u out of range (0-%u)\n", zoneIndex,
-                    control.numIllumZonesControl ? control.numIllumZonesControl - 1 : 0);
-        continue;
+        Printf("  Zone index %u out of range (0-%u)\n", zoneIndex,
+               control.numIllumZonesControl ? control.numIllumZonesControl - 1 : 0);
+        return 0;
       }
 
       auto &zone = control.zones[zoneIndex];
@@ -1195,12 +1168,12 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
 
       if (mode == "manual-rgb") {
         if (zone.type != NV_GPU_CLIENT_ILLUM_ZONE_TYPE_RGB) {
-          std::printf("  Zone %u does not support RGB manual control.\n", zoneIndex);
-          continue;
+          Printf("  Zone %u does not support RGB manual control.\n", zoneIndex);
+          return 0;
         }
         if (!hasR || !hasG || !hasB) {
-          std::printf("  Missing required --r/--g/--b for manual-rgb\n");
-          continue;
+          Printf("  Missing required --r/--g/--b for manual-rgb\n");
+          return 0;
         }
         zone.data.rgb.data.manualRGB.rgbParams.colorR = static_cast<NvU8>(colorR);
         zone.data.rgb.data.manualRGB.rgbParams.colorG = static_cast<NvU8>(colorG);
@@ -1208,12 +1181,12 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
         zone.data.rgb.data.manualRGB.rgbParams.brightnessPct = static_cast<NvU8>(brightness);
       } else if (mode == "manual-rgbw") {
         if (zone.type != NV_GPU_CLIENT_ILLUM_ZONE_TYPE_RGBW) {
-          std::printf("  Zone %u does not support RGBW manual control.\n", zoneIndex);
-          continue;
+          Printf("  Zone %u does not support RGBW manual control.\n", zoneIndex);
+          return 0;
         }
         if (!hasR || !hasG || !hasB || !hasW) {
-          std::printf("  Missing required --r/--g/--b/--w for manual-rgbw\n");
-          continue;
+          Printf("  Missing required --r/--g/--b/--w for manual-rgbw\n");
+          return 0;
         }
         zone.data.rgbw.data.manualRGBW.rgbwParams.colorR = static_cast<NvU8>(colorR);
         zone.data.rgbw.data.manualRGBW.rgbwParams.colorG = static_cast<NvU8>(colorG);
@@ -1222,35 +1195,35 @@ int CmdGpuClientIllumZonesSet(int argc, char **argv) {
         zone.data.rgbw.data.manualRGBW.rgbwParams.brightnessPct = static_cast<NvU8>(brightness);
       } else if (mode == "manual-single") {
         if (zone.type != NV_GPU_CLIENT_ILLUM_ZONE_TYPE_SINGLE_COLOR) {
-          std::printf("  Zone %u does not support single-color manual control.\n", zoneIndex);
-          continue;
+          Printf("  Zone %u does not support single-color manual control.\n", zoneIndex);
+          return 0;
         }
         zone.data.singleColor.data.manualSingleColor.singleColorParams.brightnessPct = static_cast<NvU8>(brightness);
       } else if (mode == "manual-color-fixed") {
         if (zone.type != NV_GPU_CLIENT_ILLUM_ZONE_TYPE_COLOR_FIXED) {
-          std::printf("  Zone %u does not support color-fixed manual control.\n", zoneIndex);
-          continue;
+          Printf("  Zone %u does not support color-fixed manual control.\n", zoneIndex);
+          return 0;
         }
         zone.data.colorFixed.data.manualColorFixed.colorFixedParams.brightnessPct = static_cast<NvU8>(brightness);
       } else {
-        std::printf("  Unknown mode: %s\n", mode.c_str());
-        continue;
+        Printf("  Unknown mode: %s\n", mode.c_str());
+        return 0;
       }
     }
 
-    status = NvAPI_GPU_ClientIllumZonesSetControl(handles[i], &control);
+    status = NvApi().NvAPI_GPU_ClientIllumZonesSetControl(handles[i], &control);
     if (status == NVAPI_OK) {
-      std::printf("  Illum zone control updated.\n");
+      Printf("  Illum zone control updated.\n");
     } else {
       PrintNvapiError("  NvAPI_GPU_ClientIllumZonesSetControl failed", status);
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuClientIllumDevices(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing client-illum devices subcommand\n");
+    Printf("Missing client-illum devices subcommand\n");
     return 1;
   }
   if (std::strcmp(argv[0], "info") == 0) {
@@ -1260,11 +1233,11 @@ int CmdGpuClientIllumDevices(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientIllumDevicesInfo(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "control") == 0) {
     NvU32 index = 0;
@@ -1273,21 +1246,21 @@ int CmdGpuClientIllumDevices(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientIllumDevicesControl(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "set") == 0) { return CmdGpuClientIllumDevicesSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown client-illum devices subcommand: %s\n", argv[0]);
+  Printf("Unknown client-illum devices subcommand: %s\n", argv[0]);
   return 1;
 }
 
 int CmdGpuClientIllumZones(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing client-illum zones subcommand\n");
+    Printf("Missing client-illum zones subcommand\n");
     return 1;
   }
   if (std::strcmp(argv[0], "info") == 0) {
@@ -1297,11 +1270,11 @@ int CmdGpuClientIllumZones(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientIllumZonesInfo(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "control") == 0) {
     NvU32 index = 0;
@@ -1310,48 +1283,47 @@ int CmdGpuClientIllumZones(int argc, char **argv) {
     std::vector<NvPhysicalGpuHandle> handles;
     std::vector<NvU32> indices;
     if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-    for (size_t i = 0; i < handles.size(); ++i) {
+    return ForEachGpu(handles.size(), [&](size_t i) {
       PrintGpuHeader(indices[i], handles[i]);
       PrintClientIllumZonesControl(handles[i]);
-    }
-    return 0;
+      return 0;
+    });
   }
   if (std::strcmp(argv[0], "set") == 0) { return CmdGpuClientIllumZonesSet(argc - 1, argv + 1); }
 
-  std::printf("Unknown client-illum zones subcommand: %s\n", argv[0]);
+  Printf("Unknown client-illum zones subcommand: %s\n", argv[0]);
   return 1;
 }
 
 void PrintPowerMonitorInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_POWER_MONITOR_GET_INFO info = {};
   info.version = NV_GPU_POWER_MONITOR_GET_INFO_VER;
-  NvAPI_Status status = NvAPI_GPU_PowerMonitorGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_PowerMonitorGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerMonitorGetInfo failed", status);
     return;
   }
 
-  std::printf("  Power monitor supported: %u\n", info.bSupported);
-  std::printf("  Sampling: period=%u ms count=%u\n", info.samplingPeriodms, info.sampleCount);
-  std::printf("  Channel mask: 0x%08X\n", info.channelMask);
-  std::printf("  Channel rel mask: 0x%08X\n", info.chRelMask);
-  std::printf("  Total GPU mask: 0x%08X total channel idx=%u\n", info.totalGpuPowerChannelMask,
-              info.totalGpuChannelIdx);
+  Printf("  Power monitor supported: %u\n", info.bSupported);
+  Printf("  Sampling: period=%u ms count=%u\n", info.samplingPeriodms, info.sampleCount);
+  Printf("  Channel mask: 0x%08X\n", info.channelMask);
+  Printf("  Channel rel mask: 0x%08X\n", info.chRelMask);
+  Printf("  Total GPU mask: 0x%08X total channel idx=%u\n", info.totalGpuPowerChannelMask, info.totalGpuChannelIdx);
 
   for (NvU32 i = 0; i < NV_GPU_POWER_MONITOR_MAX_CHANNELS_V2; ++i) {
     if (!HasBit(info.channelMask, i)) { continue; }
     const auto &channel = info.channels[i];
-    std::printf("    channel[%u]: type=%s(%u) rail=%s(0x%02X) offset=%d mW limit=%u mW\n", i,
-                PowerChannelTypeName(channel.type), channel.type,
-                PowerChannelRailName(static_cast<NV_GPU_POWER_CHANNEL_POWER_RAIL>(channel.pwrRail)), channel.pwrRail,
-                channel.pwrOffsetmW, channel.pwrLimitmW);
+    Printf("    channel[%u]: type=%s(%u) rail=%s(0x%02X) offset=%d mW limit=%u mW\n", i,
+           PowerChannelTypeName(channel.type), channel.type,
+           PowerChannelRailName(static_cast<NV_GPU_POWER_CHANNEL_POWER_RAIL>(channel.pwrRail)), channel.pwrRail,
+           channel.pwrOffsetmW, channel.pwrLimitmW);
   }
 }
 
 void PrintPowerMonitorStatus(NvPhysicalGpuHandle handle) {
   NV_GPU_POWER_MONITOR_GET_INFO info = {};
   info.version = NV_GPU_POWER_MONITOR_GET_INFO_VER;
-  NvAPI_Status status = NvAPI_GPU_PowerMonitorGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_PowerMonitorGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerMonitorGetInfo failed", status);
     return;
@@ -1360,50 +1332,75 @@ void PrintPowerMonitorStatus(NvPhysicalGpuHandle handle) {
   NV_GPU_POWER_MONITOR_GET_STATUS statusData = {};
   statusData.version = NV_GPU_POWER_MONITOR_GET_STATUS_VER;
   statusData.channelMask = info.channelMask;
-  status = NvAPI_GPU_PowerMonitorGetStatus(handle, &statusData);
+  status = NvApi().NvAPI_GPU_PowerMonitorGetStatus(handle, &statusData);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerMonitorGetStatus failed", status);
     return;
   }
 
-  std::printf("  Total GPU power: %u mW\n", statusData.totalGpuPowermW);
+  if (StructuredOutput()) {
+    RecordWriter("power_monitor").Field("total_mw", statusData.totalGpuPowermW);
+    for (NvU32 i = 0; i < NV_GPU_POWER_MONITOR_MAX_CHANNELS_V2; ++i) {
+      if (!HasBit(statusData.channelMask, i)) { continue; }
+      const auto &channel = statusData.channels[i];
+      RecordWriter("power_channel")
+          .Field("channel", i)
+          .Field("avg_mw", channel.pwrAvgmW)
+          .Field("min_mw", channel.pwrMinmW)
+          .Field("max_mw", channel.pwrMaxmW)
+          .Field("curr_ma", channel.currmA)
+          .Field("volt_uv", channel.voltuV)
+          .Field("energy_mj", static_cast<NvU64>(channel.energymJ))
+          .Field("tuple_mw", channel.tuple.pwrmW)
+          .Field("tuple_ma", channel.tuple.currmA)
+          .Field("tuple_uv", channel.tuple.voltuV)
+          .Field("tuple_energy_mj", static_cast<NvU64>(channel.tuple.energymJ))
+          .Field("polled_mw", channel.tuplePolled.pwrmW)
+          .Field("polled_ma", channel.tuplePolled.currmA)
+          .Field("polled_uv", channel.tuplePolled.voltuV)
+          .Field("polled_energy_mj", static_cast<NvU64>(channel.tuplePolled.energymJ));
+    }
+    return;
+  }
+
+  Printf("  Total GPU power: %u mW\n", statusData.totalGpuPowermW);
   for (NvU32 i = 0; i < NV_GPU_POWER_MONITOR_MAX_CHANNELS_V2; ++i) {
     if (!HasBit(statusData.channelMask, i)) { continue; }
     const auto &channel = statusData.channels[i];
-    std::printf("    channel[%u]: avg=%u min=%u max=%u mW curr=%u mA volt=%u uV energy=%llu mJ\n", i, channel.pwrAvgmW,
-                channel.pwrMinmW, channel.pwrMaxmW, channel.currmA, channel.voltuV,
-                static_cast<unsigned long long>(channel.energymJ));
-    std::printf("      tuple: pwr=%u mW curr=%u mA volt=%u uV energy=%llu mJ\n", channel.tuple.pwrmW,
-                channel.tuple.currmA, channel.tuple.voltuV, static_cast<unsigned long long>(channel.tuple.energymJ));
-    std::printf("      polled: pwr=%u mW curr=%u mA volt=%u uV energy=%llu mJ\n", channel.tuplePolled.pwrmW,
-                channel.tuplePolled.currmA, channel.tuplePolled.voltuV,
-                static_cast<unsigned long long>(channel.tuplePolled.energymJ));
+    Printf("    channel[%u]: avg=%u min=%u max=%u mW curr=%u mA volt=%u uV energy=%llu mJ\n", i, channel.pwrAvgmW,
+           channel.pwrMinmW, channel.pwrMaxmW, channel.currmA, channel.voltuV,
+           static_cast<unsigned long long>(channel.energymJ));
+    Printf("      tuple: pwr=%u mW curr=%u mA volt=%u uV energy=%llu mJ\n", channel.tuple.pwrmW, channel.tuple.currmA,
+           channel.tuple.voltuV, static_cast<unsigned long long>(channel.tuple.energymJ));
+    Printf("      polled: pwr=%u mW curr=%u mA volt=%u uV energy=%llu mJ\n", channel.tuplePolled.pwrmW,
+           channel.tuplePolled.currmA, channel.tuplePolled.voltuV,
+           static_cast<unsigned long long>(channel.tuplePolled.energymJ));
   }
 }
 
 void PrintPowerDeviceInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_POWER_DEVICE_GET_INFO info = {};
   info.version = NV_GPU_POWER_DEVICE_GET_INFO_VER;
-  NvAPI_Status status = NvAPI_GPU_PowerDeviceGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_PowerDeviceGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerDeviceGetInfo failed", status);
     return;
   }
 
-  std::printf("  Power device mask: 0x%08X\n", info.pwrDeviceMask);
+  Printf("  Power device mask: 0x%08X\n", info.pwrDeviceMask);
   for (NvU32 i = 0; i < NV_GPU_POWER_DEVICE_MAX_DEVICES_V1; ++i) {
     if (!HasBit(info.pwrDeviceMask, i)) { continue; }
     const auto &device = info.devices[i];
-    std::printf("    device[%u]: type=%s(%u) rail=%s(0x%02X)\n", i,
-                PowerDeviceTypeName(static_cast<NV_GPU_POWER_DEVICE_TYPE>(device.type)), device.type,
-                PowerDeviceRailName(static_cast<NV_GPU_POWER_DEVICE_POWER_RAIL>(device.powerRail)), device.powerRail);
+    Printf("    device[%u]: type=%s(%u) rail=%s(0x%02X)\n", i,
+           PowerDeviceTypeName(static_cast<NV_GPU_POWER_DEVICE_TYPE>(device.type)), device.type,
+           PowerDeviceRailName(static_cast<NV_GPU_POWER_DEVICE_POWER_RAIL>(device.powerRail)), device.powerRail);
   }
 }
 
 void PrintPowerDeviceStatus(NvPhysicalGpuHandle handle) {
   NV_GPU_POWER_DEVICE_GET_INFO info = {};
   info.version = NV_GPU_POWER_DEVICE_GET_INFO_VER;
-  NvAPI_Status status = NvAPI_GPU_PowerDeviceGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_PowerDeviceGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerDeviceGetInfo failed", status);
     return;
@@ -1416,22 +1413,22 @@ void PrintPowerDeviceStatus(NvPhysicalGpuHandle handle) {
     if (HasBit(info.pwrDeviceMask, i)) { MaskE32Set(statusData.pwrDeviceMask, i); }
   }
 
-  status = NvAPI_GPU_PowerDeviceGetStatus(handle, &statusData);
+  status = NvApi().NvAPI_GPU_PowerDeviceGetStatus(handle, &statusData);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerDeviceGetStatus failed", status);
     return;
   }
 
-  std::printf("  Power device status:\n");
+  Printf("  Power device status:\n");
   for (NvU32 i = 0; i < NV_GPU_POWER_DEVICE_MAX_DEVICES_V1; ++i) {
     if (!MaskE32Has(statusData.pwrDeviceMask, i)) { continue; }
     const auto &device = statusData.devices[i];
-    std::printf("    device[%u]: type=%s(%u) providers=%u\n", i, PowerDeviceTypeName(device.type), device.type,
-                device.numProviders);
+    Printf("    device[%u]: type=%s(%u) providers=%u\n", i, PowerDeviceTypeName(device.type), device.type,
+           device.numProviders);
     for (NvU32 p = 0; p < device.numProviders && p < NV_GPU_POWER_DEVICE_MAX_PROVIDERS_V3; ++p) {
       const auto &provider = device.providers[p];
-      std::printf("      provider[%u]: pwr=%u mW curr=%u mA volt=%u uV thresholds=%u\n", p, provider.tuple.pwrmW,
-                  provider.tuple.currmA, provider.tuple.voltuV, provider.numThresholds);
+      Printf("      provider[%u]: pwr=%u mW curr=%u mA volt=%u uV thresholds=%u\n", p, provider.tuple.pwrmW,
+             provider.tuple.currmA, provider.tuple.voltuV, provider.numThresholds);
     }
   }
 }
@@ -1441,13 +1438,13 @@ void PrintPowerCappingInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_POWER_CAPPING_GET_INFO info = {};
   info.version = NV_GPU_POWER_CAPPING_GET_INFO_VER;
   NvAPI_Status status = NVAPI_NOT_SUPPORTED;
-  // Deprecated in release 400: NvAPI_GPU_PowerCappingGetInfo(handle, &info);
+  // Deprecated in release 400: NvApi().NvAPI_GPU_PowerCappingGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerCappingGetInfo failed", status);
     return;
   }
 
-  std::printf("  Power capping: alg=%u channelMask=0x%08X\n", info.alg, info.channelMask);
+  Printf("  Power capping: alg=%u channelMask=0x%08X\n", info.alg, info.channelMask);
 }
 
 void PrintPowerCappingSlowdownStatus(NvPhysicalGpuHandle handle) {
@@ -1455,36 +1452,36 @@ void PrintPowerCappingSlowdownStatus(NvPhysicalGpuHandle handle) {
   NV_GPU_POWER_CAPPING_SLOWDOWN_GET_STATUS info = {};
   info.version = NV_GPU_POWER_CAPPING_SLOWDOWN_GET_STATUS_VER;
   NvAPI_Status status = NVAPI_NOT_SUPPORTED;
-  // Deprecated in release 400: NvAPI_GPU_PowerCappingSlowdownGetStatus(handle, &info);
+  // Deprecated in release 400: NvApi().NvAPI_GPU_PowerCappingSlowdownGetStatus(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerCappingSlowdownGetStatus failed", status);
     return;
   }
 
-  std::printf("  Power capping slowdown: enabled=%u capRatio=%u factorIndex=%u factorCount=%u\n", info.bEnabled,
-              info.capRatio, info.factorIndex, info.factorCount);
+  Printf("  Power capping slowdown: enabled=%u capRatio=%u factorIndex=%u factorCount=%u\n", info.bEnabled,
+         info.capRatio, info.factorIndex, info.factorCount);
   for (NvU32 i = 0; i < info.factorCount && i < NV_GPU_POWER_CAPPING_SLOWDOWN_MAX_CHANNELS_V1; ++i) {
-    std::printf("    factor[%u]: %u/%u\n", i, info.factors[i].numerator, info.factors[i].denominator);
+    Printf("    factor[%u]: %u/%u\n", i, info.factors[i].numerator, info.factors[i].denominator);
   }
 }
 
 void PrintPowerLeakageInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_POWER_LEAKAGE_INFO_PARAMS info = {};
   info.version = NV_GPU_POWER_LEAKAGE_INFO_PARAMS_VER;
-  NvAPI_Status status = NvAPI_GPU_PowerLeakageGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_PowerLeakageGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerLeakageGetInfo failed", status);
     return;
   }
 
-  std::printf("  Leakage: iddqVer=%u swVer=%u iddqmA=%u mask=0x%08X\n", info.hwIddqVersion, info.iddqVersion,
-              info.iddqmA, info.leakageMask);
+  Printf("  Leakage: iddqVer=%u swVer=%u iddqmA=%u mask=0x%08X\n", info.hwIddqVersion, info.iddqVersion, info.iddqmA,
+         info.leakageMask);
 
   for (NvU32 i = 0; i < NV_GPU_POWER_LEAKAGE_MAX_LEAKAGES_V2; ++i) {
     if (!HasBit(info.leakageMask, i)) { continue; }
     const auto &leak = info.leakages[i];
-    std::printf("    leakage[%u]: type=%s(%u) fsEff=%u pgEff=%u\n", i, LeakageTypeName(leak.type), leak.type,
-                leak.fsEff, leak.pgEff);
+    Printf("    leakage[%u]: type=%s(%u) fsEff=%u pgEff=%u\n", i, LeakageTypeName(leak.type), leak.type, leak.fsEff,
+           leak.pgEff);
   }
 }
 
@@ -1492,7 +1489,7 @@ void PrintPowerLeakageStatus(NvPhysicalGpuHandle handle) {
   (void)handle;
   NV_GPU_POWER_LEAKAGE_INFO_PARAMS info = {};
   info.version = NV_GPU_POWER_LEAKAGE_INFO_PARAMS_VER;
-  NvAPI_Status status = NvAPI_GPU_PowerLeakageGetInfo(handle, &info);
+  NvAPI_Status status = NvApi().NvAPI_GPU_PowerLeakageGetInfo(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerLeakageGetInfo failed", status);
     return;
@@ -1504,50 +1501,50 @@ void PrintPowerLeakageStatus(NvPhysicalGpuHandle handle) {
   if (NV_GPU_POWER_LEAKAGE_MAX_LEAKAGES_V1 < 32) { leakMask &= ((1u << NV_GPU_POWER_LEAKAGE_MAX_LEAKAGES_V1) - 1u); }
   statusData.leakageMask = leakMask;
   status = NVAPI_NOT_SUPPORTED;
-  // Deprecated in release 295: NvAPI_GPU_PowerLeakageGetStatus(handle, &statusData);
+  // Deprecated in release 295: NvApi().NvAPI_GPU_PowerLeakageGetStatus(handle, &statusData);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_PowerLeakageGetStatus failed", status);
     return;
   }
 
-  std::printf("  Leakage status: tj=%.2f C\n", static_cast<float>(statusData.tj) / 256.0f);
+  Printf("  Leakage status: tj=%.2f C\n", static_cast<float>(statusData.tj) / 256.0f);
   for (NvU32 i = 0; i < NV_GPU_POWER_LEAKAGE_MAX_LEAKAGES_V1; ++i) {
     if (!HasBit(statusData.leakageMask, i)) { continue; }
     const auto &leak = statusData.leakages[i];
-    std::printf("    leakage[%u]: entries=%u\n", i, leak.numVoltEntries);
+    Printf("    leakage[%u]: entries=%u\n", i, leak.numVoltEntries);
     for (NvU32 v = 0; v < leak.numVoltEntries && v < NV_GPU_POWER_LEAKAGE_MAX_VOLTAGE_ENTRIES_V2; ++v) {
       const auto &entry = leak.voltEntries[v];
-      std::printf("      %u uV -> %u mW\n", entry.voltageuV, entry.pwrLeakagemW);
+      Printf("      %u uV -> %u mW\n", entry.voltageuV, entry.pwrLeakagemW);
     }
   }
 }
 
 int CmdGpuClientFan(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing client-fan subcommand\n");
+    Printf("Missing client-fan subcommand\n");
     return 1;
   }
   if (std::strcmp(argv[0], "coolers") == 0) { return CmdGpuClientFanCoolers(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "policies") == 0) { return CmdGpuClientFanPolicies(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "arbiters") == 0) { return CmdGpuClientFanArbiters(argc - 1, argv + 1); }
-  std::printf("Unknown client-fan subcommand: %s\n", argv[0]);
+  Printf("Unknown client-fan subcommand: %s\n", argv[0]);
   return 1;
 }
 
 int CmdGpuClientIllum(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing client-illum subcommand\n");
+    Printf("Missing client-illum subcommand\n");
     return 1;
   }
   if (std::strcmp(argv[0], "devices") == 0) { return CmdGpuClientIllumDevices(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "zones") == 0) { return CmdGpuClientIllumZones(argc - 1, argv + 1); }
-  std::printf("Unknown client-illum subcommand: %s\n", argv[0]);
+  Printf("Unknown client-illum subcommand: %s\n", argv[0]);
   return 1;
 }
 
 int CmdGpuPowerMonitor(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing power monitor subcommand\n");
+    Printf("Missing power monitor subcommand\n");
     return 1;
   }
   NvU32 index = 0;
@@ -1557,23 +1554,23 @@ int CmdGpuPowerMonitor(int argc, char **argv) {
   std::vector<NvPhysicalGpuHandle> handles;
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     if (std::strcmp(argv[0], "info") == 0) {
       PrintPowerMonitorInfo(handles[i]);
     } else if (std::strcmp(argv[0], "status") == 0) {
       PrintPowerMonitorStatus(handles[i]);
     } else {
-      std::printf("Unknown power monitor subcommand: %s\n", argv[0]);
+      Printf("Unknown power monitor subcommand: %s\n", argv[0]);
       return 1;
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuPowerDevice(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing power device subcommand\n");
+    Printf("Missing power device subcommand\n");
     return 1;
   }
   NvU32 index = 0;
@@ -1582,23 +1579,23 @@ int CmdGpuPowerDevice(int argc, char **argv) {
   std::vector<NvPhysicalGpuHandle> handles;
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     if (std::strcmp(argv[0], "info") == 0) {
       PrintPowerDeviceInfo(handles[i]);
     } else if (std::strcmp(argv[0], "status") == 0) {
       PrintPowerDeviceStatus(handles[i]);
     } else {
-      std::printf("Unknown power device subcommand: %s\n", argv[0]);
+      Printf("Unknown power device subcommand: %s\n", argv[0]);
       return 1;
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuPowerCapping(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing power capping subcommand\n");
+    Printf("Missing power capping subcommand\n");
     return 1;
   }
   NvU32 index = 0;
@@ -1607,23 +1604,23 @@ int CmdGpuPowerCapping(int argc, char **argv) {
   std::vector<NvPhysicalGpuHandle> handles;
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     if (std::strcmp(argv[0], "info") == 0) {
       PrintPowerCappingInfo(handles[i]);
     } else if (std::strcmp(argv[0], "slowdown") == 0) {
       PrintPowerCappingSlowdownStatus(handles[i]);
     } else {
-      std::printf("Unknown power capping subcommand: %s\n", argv[0]);
+      Printf("Unknown power capping subcommand: %s\n", argv[0]);
       return 1;
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuPowerLeakage(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing power leakage subcommand\n");
+    Printf("Missing power leakage subcommand\n");
     return 1;
   }
   NvU32 index = 0;
@@ -1632,18 +1629,18 @@ int CmdGpuPowerLeakage(int argc, char **argv) {
   std::vector<NvPhysicalGpuHandle> handles;
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     if (std::strcmp(argv[0], "info") == 0) {
       PrintPowerLeakageInfo(handles[i]);
     } else if (std::strcmp(argv[0], "status") == 0) {
       PrintPowerLeakageStatus(handles[i]);
     } else {
-      std::printf("Unknown power leakage subcommand: %s\n", argv[0]);
+      Printf("Unknown power leakage subcommand: %s\n", argv[0]);
       return 1;
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuOcScannerStart(int argc, char **argv) {
@@ -1655,19 +1652,18 @@ int CmdGpuOcScannerStart(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_CLIENT_START_OC_SCANNER_SETTINGS settings = {};
     settings.version = NV_GPU_CLIENT_START_OC_SCANNER_SETTINGS_VER;
-    NvAPI_Status status = NvAPI_GPU_ClientStartOcScanner(handles[i], &settings);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ClientStartOcScanner(handles[i], &settings);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ClientStartOcScanner failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  OC scanner start requested.\n");
-  }
-
-  return 0;
+    Printf("  OC scanner start requested.\n");
+    return 0;
+  });
 }
 
 int CmdGpuOcScannerStop(int argc, char **argv) {
@@ -1679,19 +1675,18 @@ int CmdGpuOcScannerStop(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_CLIENT_STOP_OC_SCANNER_SETTINGS settings = {};
     settings.version = NV_GPU_CLIENT_STOP_OC_SCANNER_SETTINGS_VER;
-    NvAPI_Status status = NvAPI_GPU_ClientStopOcScanner(handles[i], &settings);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ClientStopOcScanner(handles[i], &settings);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ClientStopOcScanner failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  OC scanner stop requested.\n");
-  }
-
-  return 0;
+    Printf("  OC scanner stop requested.\n");
+    return 0;
+  });
 }
 
 int CmdGpuOcScannerRevert(int argc, char **argv) {
@@ -1703,30 +1698,29 @@ int CmdGpuOcScannerRevert(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_CLIENT_REVERT_OC_SETTINGS settings = {};
     settings.version = NV_GPU_CLIENT_REVERT_OC_SETTINGS_VER;
-    NvAPI_Status status = NvAPI_GPU_ClientRevertOc(handles[i], &settings);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ClientRevertOc(handles[i], &settings);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ClientRevertOc failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  OC settings reverted.\n");
-  }
-
-  return 0;
+    Printf("  OC settings reverted.\n");
+    return 0;
+  });
 }
 
 int CmdGpuOcScanner(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing oc-scanner subcommand.\n");
+    Printf("Missing oc-scanner subcommand.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "start") == 0) { return CmdGpuOcScannerStart(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "stop") == 0) { return CmdGpuOcScannerStop(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "revert") == 0) { return CmdGpuOcScannerRevert(argc - 1, argv + 1); }
-  std::printf("Unknown oc-scanner subcommand: %s\n", argv[0]);
+  Printf("Unknown oc-scanner subcommand: %s\n", argv[0]);
   return 1;
 }
 
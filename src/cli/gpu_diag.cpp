@@ -84,11 +84,11 @@ std::string BufferToAscii(const NvU8 *data, size_t size, bool *hasNonPrintable)
 }
 
 void PrintPcieLinkInfo(const char *label, const NV_PCIE_LINK_INFO_V2 &info) {
-  std::printf("  %s:\n", label);
-  std::printf("    maxSpeed=%u Mbps maxWidth=%u gen=%s aspm=%s\n", info.maxSpeed, info.maxWidth,
-              PcieGenerationName(info.maxGeneration), PcieAspmStateName(info.supportedStates));
-  std::printf("    currentSpeed=%u Mbps currentWidth=%u gen=%s aspm=%s\n", info.currentSpeed, info.currentWidth,
-              PcieGenerationName(info.currentGeneration), PcieAspmStateName(info.currentState));
+  Printf("  %s:\n", label);
+  Printf("    maxSpeed=%u Mbps maxWidth=%u gen=%s aspm=%s\n", info.maxSpeed, info.maxWidth,
+         PcieGenerationName(info.maxGeneration), PcieAspmStateName(info.supportedStates));
+  Printf("    currentSpeed=%u Mbps currentWidth=%u gen=%s aspm=%s\n", info.currentSpeed, info.currentWidth,
+         PcieGenerationName(info.currentGeneration), PcieAspmStateName(info.currentState));
 }
 
 void PrintPcieErrorMask(const char *label, NvU32 mask) {
@@ -98,7 +98,7 @@ void PrintPcieErrorMask(const char *label, NvU32 mask) {
       {NV_PCIE_LINK_ERROR_FATAL_ERROR, "FATAL"},
       {NV_PCIE_LINK_ERROR_UNSUPP_REQUEST, "UNSUPPORTED_REQ"},
   };
-  std::printf("  %s: 0x%08X (%s)\n", label, mask, BuildFlagList(mask, flags).c_str());
+  Printf("  %s: 0x%08X (%s)\n", label, mask, BuildFlagList(mask, flags).c_str());
 }
 
 void PrintPcieAERMask(NvU32 mask) {
@@ -121,7 +121,7 @@ void PrintPcieAERMask(NvU32 mask) {
       {NV_PCIE_LINK_AER_CORR_RPLY_TIMEOUT, "CORR_RPLY_TIMEOUT"},
       {NV_PCIE_LINK_AER_CORR_ADVISORY_NONFATAL, "CORR_ADVISORY_NONFATAL"},
   };
-  std::printf("  AER: 0x%08X (%s)\n", mask, BuildFlagList(mask, flags).c_str());
+  Printf("  AER: 0x%08X (%s)\n", mask, BuildFlagList(mask, flags).c_str());
 }
 } // namespace
 
@@ -134,22 +134,21 @@ int CmdGpuEccStatus(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_ECC_STATUS_INFO info = {};
     info.version = NV_GPU_ECC_STATUS_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_GetECCStatusInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetECCStatusInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetECCStatusInfo failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  ECC supported: %s\n", info.isSupported ? "yes" : "no");
-    std::printf("  ECC enabled: %s\n", info.isEnabled ? "yes" : "no");
-    std::printf("  ECC configuration: %s (%u)\n", EccConfigName(info.configurationOptions), info.configurationOptions);
-  }
-
-  return 0;
+    Printf("  ECC supported: %s\n", info.isSupported ? "yes" : "no");
+    Printf("  ECC enabled: %s\n", info.isEnabled ? "yes" : "no");
+    Printf("  ECC configuration: %s (%u)\n", EccConfigName(info.configurationOptions), info.configurationOptions);
+    return 0;
+  });
 }
 
 int CmdGpuEccErrors(int argc, char **argv) {
@@ -163,18 +162,18 @@ int CmdGpuEccErrors(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -182,31 +181,30 @@ int CmdGpuEccErrors(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_ECC_ERROR_INFO info = {};
     info.version = NV_GPU_ECC_ERROR_INFO_VER;
     NvAPI_Status status = NVAPI_OK;
     if (raw) {
-      status = NvAPI_GPU_GetECCErrorInfoEx(handles[i], NVAPI_GPU_ECC_STATUS_FLAGS_TYPE_RAW, &info);
+      status = NvApi().NvAPI_GPU_GetECCErrorInfoEx(handles[i], NVAPI_GPU_ECC_STATUS_FLAGS_TYPE_RAW, &info);
     } else {
-      status = NvAPI_GPU_GetECCErrorInfo(handles[i], &info);
+      status = NvApi().NvAPI_GPU_GetECCErrorInfo(handles[i], &info);
     }
 
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetECCErrorInfo failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  ECC errors (current): single=%llu double=%llu\n",
-                static_cast<unsigned long long>(info.current.singleBitErrors),
-                static_cast<unsigned long long>(info.current.doubleBitErrors));
-    std::printf("  ECC errors (aggregate): single=%llu double=%llu\n",
-                static_cast<unsigned long long>(info.aggregate.singleBitErrors),
-                static_cast<unsigned long long>(info.aggregate.doubleBitErrors));
-  }
-
-  return 0;
+    Printf("  ECC errors (current): single=%llu double=%llu\n",
+           static_cast<unsigned long long>(info.current.singleBitErrors),
+           static_cast<unsigned long long>(info.current.doubleBitErrors));
+    Printf("  ECC errors (aggregate): single=%llu double=%llu\n",
+           static_cast<unsigned long long>(info.aggregate.singleBitErrors),
+           static_cast<unsigned long long>(info.aggregate.doubleBitErrors));
+    return 0;
+  });
 }
 
 int CmdGpuEccConfig(int argc, char **argv) {
@@ -218,19 +216,19 @@ int CmdGpuEccConfig(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_ECC_CONFIGURATION_INFO info = {};
     info.version = NV_GPU_ECC_CONFIGURATION_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_GetECCConfigurationInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetECCConfigurationInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetECCConfigurationInfo failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  ECC config stored: %s\n", info.isEnabled ? "enabled" : "disabled");
-    std::printf("  ECC default: %s\n", info.isEnabledByDefault ? "enabled" : "disabled");
-  }
-  return 0;
+    Printf("  ECC config stored: %s\n", info.isEnabled ? "enabled" : "disabled");
+    Printf("  ECC default: %s\n", info.isEnabledByDefault ? "enabled" : "disabled");
+    return 0;
+  });
 }
 
 int CmdGpuEccSet(int argc, char **argv) {
@@ -245,11 +243,11 @@ int CmdGpuEccSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -258,11 +256,11 @@ int CmdGpuEccSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--enable") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --enable\n");
+        Printf("Missing value for --enable\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &enable)) {
-        std::printf("Invalid value for --enable: %s\n", argv[i + 1]);
+        Printf("Invalid value for --enable: %s\n", argv[i + 1]);
         return 1;
       }
       hasEnable = true;
@@ -271,11 +269,11 @@ int CmdGpuEccSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--immediate") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --immediate\n");
+        Printf("Missing value for --immediate\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &immediate)) {
-        std::printf("Invalid value for --immediate: %s\n", argv[i + 1]);
+        Printf("Invalid value for --immediate: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
@@ -283,23 +281,23 @@ int CmdGpuEccSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--clear") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --clear\n");
+        Printf("Missing value for --clear\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &clear)) {
-        std::printf("Invalid value for --clear: %s\n", argv[i + 1]);
+        Printf("Invalid value for --clear: %s\n", argv[i + 1]);
         return 1;
       }
       hasClear = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasEnable) {
-    std::printf("Missing required --enable\n");
+    Printf("Missing required --enable\n");
     return 1;
   }
   if (!hasClear) { clear = !enable; }
@@ -308,40 +306,39 @@ int CmdGpuEccSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_ECC_STATUS_INFO statusInfo = {};
     statusInfo.version = NV_GPU_ECC_STATUS_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_GetECCStatusInfo(handles[i], &statusInfo);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetECCStatusInfo(handles[i], &statusInfo);
     if (status == NVAPI_OK && !statusInfo.isSupported) {
-      std::printf("  ECC not supported on this GPU.\n");
-      continue;
+      Printf("  ECC not supported on this GPU.\n");
+      return 0;
     }
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetECCStatusInfo failed", status);
-      continue;
+      return 0;
     }
 
-    status = NvAPI_GPU_SetECCConfiguration(handles[i], enable ? 1 : 0, immediate ? 1 : 0);
+    status = NvApi().NvAPI_GPU_SetECCConfiguration(handles[i], enable ? 1 : 0, immediate ? 1 : 0);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_SetECCConfiguration failed", status);
-      if (status == NVAPI_INVALID_USER_PRIVILEGE) { std::printf("  Try running the terminal as Administrator.\n"); }
-      continue;
+      if (status == NVAPI_INVALID_USER_PRIVILEGE) { Printf("  Try running the terminal as Administrator.\n"); }
+      return 0;
     }
 
-    std::printf("  ECC %s requested (immediate=%u).\n", enable ? "enable" : "disable", immediate ? 1 : 0);
+    Printf("  ECC %s requested (immediate=%u).\n", enable ? "enable" : "disable", immediate ? 1 : 0);
 
     if (clear) {
-      status = NvAPI_GPU_ResetECCErrorInfo(handles[i], 1, 1);
+      status = NvApi().NvAPI_GPU_ResetECCErrorInfo(handles[i], 1, 1);
       if (status != NVAPI_OK) {
         PrintNvapiError("  NvAPI_GPU_ResetECCErrorInfo failed", status);
-        continue;
+        return 0;
       }
-      std::printf("  ECC counters reset.\n");
+      Printf("  ECC counters reset.\n");
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuEccReset(int argc, char **argv) {
@@ -353,11 +350,11 @@ int CmdGpuEccReset(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -366,11 +363,11 @@ int CmdGpuEccReset(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--current") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --current\n");
+        Printf("Missing value for --current\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &resetCurrent)) {
-        std::printf("Invalid value for --current: %s\n", argv[i + 1]);
+        Printf("Invalid value for --current: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
@@ -378,22 +375,22 @@ int CmdGpuEccReset(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--aggregate") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --aggregate\n");
+        Printf("Missing value for --aggregate\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &resetAggregate)) {
-        std::printf("Invalid value for --aggregate: %s\n", argv[i + 1]);
+        Printf("Invalid value for --aggregate: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!resetCurrent && !resetAggregate) {
-    std::printf("Missing --current and/or --aggregate.\n");
+    Printf("Missing --current and/or --aggregate.\n");
     return 1;
   }
 
@@ -401,21 +398,21 @@ int CmdGpuEccReset(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
-    NvAPI_Status status = NvAPI_GPU_ResetECCErrorInfo(handles[i], resetCurrent ? 1 : 0, resetAggregate ? 1 : 0);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ResetECCErrorInfo(handles[i], resetCurrent ? 1 : 0, resetAggregate ? 1 : 0);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ResetECCErrorInfo failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  ECC counters reset.\n");
-  }
-  return 0;
+    Printf("  ECC counters reset.\n");
+    return 0;
+  });
 }
 
 int CmdGpuEcc(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing ecc subcommand.\n");
+    Printf("Missing ecc subcommand.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "status") == 0) { return CmdGpuEccStatus(argc - 1, argv + 1); }
@@ -423,7 +420,7 @@ int CmdGpuEcc(int argc, char **argv) {
   if (std::strcmp(argv[0], "config") == 0) { return CmdGpuEccConfig(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdGpuEccSet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "reset") == 0) { return CmdGpuEccReset(argc - 1, argv + 1); }
-  std::printf("Unknown ecc subcommand: %s\n", argv[0]);
+  Printf("Unknown ecc subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -438,18 +435,18 @@ int CmdGpuBoardInfo(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -457,57 +454,57 @@ int CmdGpuBoardInfo(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_BOARD_INFO_V3 info = {};
     NvU32 version = NV_BOARD_INFO_VER;
     info.version = version;
-    NvAPI_Status status = NvAPI_GPU_GetBoardInfo(handles[i], reinterpret_cast<NV_BOARD_INFO *>(&info));
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetBoardInfo(handles[i], reinterpret_cast<NV_BOARD_INFO *>(&info));
     if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
       version = NV_BOARD_INFO_VER2;
       info.version = version;
-      status = NvAPI_GPU_GetBoardInfo(handles[i], reinterpret_cast<NV_BOARD_INFO *>(&info));
+      status = NvApi().NvAPI_GPU_GetBoardInfo(handles[i], reinterpret_cast<NV_BOARD_INFO *>(&info));
     }
     if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
       version = NV_BOARD_INFO_VER1;
       info.version = version;
-      status = NvAPI_GPU_GetBoardInfo(handles[i], reinterpret_cast<NV_BOARD_INFO *>(&info));
+      status = NvApi().NvAPI_GPU_GetBoardInfo(handles[i], reinterpret_cast<NV_BOARD_INFO *>(&info));
     }
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetBoardInfo failed", status);
-      continue;
+      return 0;
     }
 
     bool nonPrintable = false;
     std::string boardNum = BufferToAscii(info.BoardNum, sizeof(info.BoardNum), &nonPrintable);
-    std::printf("  Board serial: %s\n", boardNum.empty() ? "<empty>" : boardNum.c_str());
+    Printf("  Board serial: %s\n", boardNum.empty() ? "<empty>" : boardNum.c_str());
     if (nonPrintable) {
-      std::printf("  Board serial (hex):\n");
+      Printf("  Board serial (hex):\n");
       PrintHexBytes(info.BoardNum, static_cast<NvU32>(sizeof(info.BoardNum)));
     }
 
     NvU64 serial = 0;
-    status = NvAPI_GPU_GetSerialNumber(handles[i], &serial);
-    if (status == NVAPI_OK) { std::printf("  GPU serial: 0x%016llX\n", static_cast<unsigned long long>(serial)); }
+    status = NvApi().NvAPI_GPU_GetSerialNumber(handles[i], &serial);
+    if (status == NVAPI_OK) { Printf("  GPU serial: 0x%016llX\n", static_cast<unsigned long long>(serial)); }
 
     if (version == NV_BOARD_INFO_VER2 || version == NV_BOARD_INFO_VER3) {
       bool partNonPrintable = false;
       std::string part = BufferToAscii(info.productPartNumber, sizeof(info.productPartNumber), &partNonPrintable);
-      std::printf("  Product part: %s\n", part.empty() ? "<empty>" : part.c_str());
-      std::printf("  Board revision: %u.%u.%u\n", info.boardRevision[0], info.boardRevision[1], info.boardRevision[2]);
-      std::printf("  Board type: %u\n", info.boardType);
+      Printf("  Product part: %s\n", part.empty() ? "<empty>" : part.c_str());
+      Printf("  Board revision: %u.%u.%u\n", info.boardRevision[0], info.boardRevision[1], info.boardRevision[2]);
+      Printf("  Board type: %u\n", info.boardType);
       if (raw || partNonPrintable) {
-        std::printf("  Product part (hex):\n");
+        Printf("  Product part (hex):\n");
         PrintHexBytes(info.productPartNumber, static_cast<NvU32>(sizeof(info.productPartNumber)));
       }
     }
 
     if (version == NV_BOARD_INFO_VER3 && raw) {
-      std::printf("  OEM info (hex):\n");
+      Printf("  OEM info (hex):\n");
       PrintHexBytes(info.oemInfo, static_cast<NvU32>(sizeof(info.oemInfo)));
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuBoardManufacturing(int argc, char **argv) {
@@ -519,28 +516,28 @@ int CmdGpuBoardManufacturing(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_MANUFACTURING_INFO info = {};
     info.version = NV_MANUFACTURING_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_ManufacturingInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ManufacturingInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ManufacturingInfo failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  ECID: 0x%016llX%016llX\n", static_cast<unsigned long long>(info.ecid[1]),
-                static_cast<unsigned long long>(info.ecid[0]));
-  }
-  return 0;
+    Printf("  ECID: 0x%016llX%016llX\n", static_cast<unsigned long long>(info.ecid[1]),
+           static_cast<unsigned long long>(info.ecid[0]));
+    return 0;
+  });
 }
 
 int CmdGpuBoard(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing board subcommand.\n");
+    Printf("Missing board subcommand.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "mfg") == 0) { return CmdGpuBoardManufacturing(argc - 1, argv + 1); }
-  std::printf("Unknown board subcommand: %s\n", argv[0]);
+  Printf("Unknown board subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -553,14 +550,14 @@ int CmdGpuPcieInfo(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_PCIE_INFO info = {};
     info.version = NV_PCIE_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_GetPCIEInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetPCIEInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetPCIEInfo failed", status);
-      continue;
+      return 0;
     }
 
     PrintPcieLinkInfo("Root", info.root);
@@ -569,12 +566,12 @@ int CmdGpuPcieInfo(int argc, char **argv) {
     PrintPcieLinkInfo("Downstream", info.downstream);
     PrintPcieLinkInfo("Board", info.board);
 
-    std::printf("  Surprise removal: vendor=0x%04X device=0x%04X supported=%s bus=%s\n",
-                info.rootPortSurpriseRemovalCaps.vendorId, info.rootPortSurpriseRemovalCaps.deviceId,
-                info.rootPortSurpriseRemovalCaps.isSurpriseRemovalSupported ? "yes" : "no",
-                SurpriseRemovalBusName(info.rootPortSurpriseRemovalCaps.removalBusType));
-  }
-  return 0;
+    Printf("  Surprise removal: vendor=0x%04X device=0x%04X supported=%s bus=%s\n",
+           info.rootPortSurpriseRemovalCaps.vendorId, info.rootPortSurpriseRemovalCaps.deviceId,
+           info.rootPortSurpriseRemovalCaps.isSurpriseRemovalSupported ? "yes" : "no",
+           SurpriseRemovalBusName(info.rootPortSurpriseRemovalCaps.removalBusType));
+    return 0;
+  });
 }
 
 int CmdGpuPcieErrors(int argc, char **argv) {
@@ -583,18 +580,18 @@ int CmdGpuPcieErrors(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -602,21 +599,21 @@ int CmdGpuPcieErrors(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_PCIE_LINK_ERROR_INFO info = {};
     info.version = NV_PCIE_LINK_ERROR_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_ClearPCIELinkErrorInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ClearPCIELinkErrorInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ClearPCIELinkErrorInfo failed", status);
-      continue;
+      return 0;
     }
 
     PrintPcieErrorMask("Root", info.root);
     PrintPcieErrorMask("GPU", info.gpu);
-    std::printf("  Flags: 0x%08X\n", info.flags);
-  }
-  return 0;
+    Printf("  Flags: 0x%08X\n", info.flags);
+    return 0;
+  });
 }
 
 int CmdGpuPcieAer(int argc, char **argv) {
@@ -625,18 +622,18 @@ int CmdGpuPcieAer(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -644,17 +641,17 @@ int CmdGpuPcieAer(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NvU32 mask = 0;
-    NvAPI_Status status = NvAPI_GPU_ClearPCIELinkAERInfo(handles[i], &mask);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ClearPCIELinkAERInfo(handles[i], &mask);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ClearPCIELinkAERInfo failed", status);
-      continue;
+      return 0;
     }
     PrintPcieAERMask(mask);
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuPcieSwitchErrors(int argc, char **argv) {
@@ -666,19 +663,19 @@ int CmdGpuPcieSwitchErrors(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_PCIELINK_SWITCH_ERROR_INFO info = {};
     info.version = NV_PCIELINK_SWITCH_ERROR_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_GetPCIELinkSwitchErrorInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetPCIELinkSwitchErrorInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetPCIELinkSwitchErrorInfo failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  Speed switch errors: %u\n", info.speedSwitchErrorCount);
-    std::printf("  Width switch errors: %u\n", info.widthSwitchErrorCount);
-  }
-  return 0;
+    Printf("  Speed switch errors: %u\n", info.speedSwitchErrorCount);
+    Printf("  Width switch errors: %u\n", info.widthSwitchErrorCount);
+    return 0;
+  });
 }
 
 int CmdGpuPcieSetWidth(int argc, char **argv) {
@@ -690,11 +687,11 @@ int CmdGpuPcieSetWidth(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -703,23 +700,23 @@ int CmdGpuPcieSetWidth(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--width") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --width\n");
+        Printf("Missing value for --width\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &width)) {
-        std::printf("Invalid width: %s\n", argv[i + 1]);
+        Printf("Invalid width: %s\n", argv[i + 1]);
         return 1;
       }
       hasWidth = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasWidth) {
-    std::printf("Missing required --width\n");
+    Printf("Missing required --width\n");
     return 1;
   }
 
@@ -727,18 +724,17 @@ int CmdGpuPcieSetWidth(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
-    NvAPI_Status status = NvAPI_GPU_SetCurrentPCIEWidth(handles[i], width);
+    NvAPI_Status status = NvApi().NvAPI_GPU_SetCurrentPCIEWidth(handles[i], width);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_SetCurrentPCIEWidth failed", status);
-      if (status == NVAPI_INVALID_USER_PRIVILEGE) { std::printf("  Try running the terminal as Administrator.\n"); }
-      continue;
+      if (status == NVAPI_INVALID_USER_PRIVILEGE) { Printf("  Try running the terminal as Administrator.\n"); }
+      return 0;
     }
-    std::printf("  PCIe width set: x%u\n", width);
-  }
-
-  return 0;
+    Printf("  PCIe width set: x%u\n", width);
+    return 0;
+  });
 }
 
 int CmdGpuPcieSetSpeed(int argc, char **argv) {
@@ -750,11 +746,11 @@ int CmdGpuPcieSetSpeed(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -763,23 +759,23 @@ int CmdGpuPcieSetSpeed(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--speed") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --speed\n");
+        Printf("Missing value for --speed\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &speed)) {
-        std::printf("Invalid speed: %s\n", argv[i + 1]);
+        Printf("Invalid speed: %s\n", argv[i + 1]);
         return 1;
       }
       hasSpeed = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasSpeed) {
-    std::printf("Missing required --speed\n");
+    Printf("Missing required --speed\n");
     return 1;
   }
 
@@ -787,22 +783,21 @@ int CmdGpuPcieSetSpeed(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
-    NvAPI_Status status = NvAPI_GPU_SetCurrentPCIESpeed(handles[i], speed);
+    NvAPI_Status status = NvApi().NvAPI_GPU_SetCurrentPCIESpeed(handles[i], speed);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_SetCurrentPCIESpeed failed", status);
-      if (status == NVAPI_INVALID_USER_PRIVILEGE) { std::printf("  Try running the terminal as Administrator.\n"); }
-      continue;
+      if (status == NVAPI_INVALID_USER_PRIVILEGE) { Printf("  Try running the terminal as Administrator.\n"); }
+      return 0;
     }
-    std::printf("  PCIe speed set: %u Mbps\n", speed);
-  }
-
-  return 0;
+    Printf("  PCIe speed set: %u Mbps\n", speed);
+    return 0;
+  });
 }
 int CmdGpuPcie(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing pcie subcommand.\n");
+    Printf("Missing pcie subcommand.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "info") == 0) { return CmdGpuPcieInfo(argc - 1, argv + 1); }
@@ -812,7 +807,7 @@ int CmdGpuPcie(int argc, char **argv) {
   if (std::strcmp(argv[0], "aspm-set") == 0) { return CmdGpuPcieAspmSet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "width-set") == 0) { return CmdGpuPcieSetWidth(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "speed-set") == 0) { return CmdGpuPcieSetSpeed(argc - 1, argv + 1); }
-  std::printf("Unknown pcie subcommand: %s\n", argv[0]);
+  Printf("Unknown pcie subcommand: %s\n", argv[0]);
   return 1;
 }
 } // namespace nvcli
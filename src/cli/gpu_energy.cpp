@@ -0,0 +1,577 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+
+#include <chrono>
+#include <memory>
+
+namespace nvcli {
+namespace {
+using EnergyClock = std::chrono::steady_clock;
+
+// Ceiling for a rail whose power monitor info carries no limit, and the cap for limits above it. A backwards counter
+// step is only unwrapped when the rail could have drawn the wrapped amount at this power between the two reads.
+constexpr NvU32 kMaxRailmW = 1000000;
+constexpr NvU64 kCounterWrapmJ = 0x100000000ull;
+constexpr size_t kMaxWindowName = 64;
+
+enum CounterState { kCounterOk = 0, kCounterWrapped = 1, kCounterReset = 2, kCounterAmbiguous = 3 };
+
+const char *CounterStateName(CounterState state) {
+  switch (state) {
+  case kCounterWrapped: return "wrapped";
+  case kCounterReset: return "reset";
+  case kCounterAmbiguous: return "ambiguous";
+  default: return "ok";
+  }
+}
+
+CounterState ParseCounterState(const char *text) {
+  if (std::strcmp(text, "wrapped") == 0) { return kCounterWrapped; }
+  if (std::strcmp(text, "reset") == 0) { return kCounterReset; }
+  if (std::strcmp(text, "ambiguous") == 0) { return kCounterAmbiguous; }
+  return kCounterOk;
+}
+
+struct ChannelEnergy {
+  NvU32 channel;
+  NvU32 rail;
+  NvU32 ceilingmW;
+  NvU64 lastmJ;
+  NvU64 accumulatedmJ;
+  NvU32 peakmW;
+  CounterState state;
+};
+
+struct GpuEnergy {
+  NvU32 index;
+  NvPhysicalGpuHandle handle;
+  NvU32 channelMask;
+  NvU32 totalChannel;
+  NvU64 lastUs;
+  std::vector<ChannelEnergy> channels;
+};
+
+// A named window outlives the process that started it, so times are steady_clock microseconds, which on Windows count
+// from boot and only go backwards across a restart.
+struct EnergyWindow {
+  std::string name;
+  NvU64 startUs;
+  std::vector<GpuEnergy> gpus;
+};
+
+NvU64 EnergyNowUs() {
+  return static_cast<NvU64>(
+      std::chrono::duration_cast<std::chrono::microseconds>(EnergyClock::now().time_since_epoch()).count());
+}
+
+NvU32 RailCeilingmW(NvU32 pwrLimitmW) { return pwrLimitmW > 0 && pwrLimitmW < kMaxRailmW ? pwrLimitmW : kMaxRailmW; }
+
+// energymJ is an NvU64, but boards that keep a 32-bit counter underneath wrap at 2^32 mJ, about four hours at 300 W.
+// A backwards step is unwrapped at 32 bits when the previous value fits and the rail could have drawn the result at its
+// ceiling since the last read. Otherwise the counter restarted (driver reload, GPU reset) and only the energy since
+// counts. When the rail could have drawn a whole 2^32 mJ since the last read, a wrap and a restart cannot be told
+// apart: the step is flagged ambiguous and, like a restart, only counts the energy since.
+CounterState CounterDelta(NvU64 lastmJ, NvU64 nowmJ, NvU32 ceilingmW, double elapsedS, NvU64 *deltamJ) {
+  if (nowmJ >= lastmJ) {
+    *deltamJ = nowmJ - lastmJ;
+    return kCounterOk;
+  }
+  *deltamJ = nowmJ;
+  const double limitmJ = (elapsedS + 1.0) * ceilingmW;
+  if (limitmJ >= static_cast<double>(kCounterWrapmJ)) { return kCounterAmbiguous; }
+  if (lastmJ >= kCounterWrapmJ) { return kCounterReset; }
+  const NvU64 wrapped = kCounterWrapmJ - lastmJ + nowmJ;
+  if (static_cast<double>(wrapped) > limitmJ) { return kCounterReset; }
+  *deltamJ = wrapped;
+  return kCounterWrapped;
+}
+
+NvAPI_Status ReadEnergyStatus(const GpuEnergy &gpu, NV_GPU_POWER_MONITOR_GET_STATUS *status) {
+  std::memset(status, 0, sizeof(*status));
+  status->version = NV_GPU_POWER_MONITOR_GET_STATUS_VER;
+  status->channelMask = gpu.channelMask;
+  return NvApi().NvAPI_GPU_PowerMonitorGetStatus(gpu.handle, status);
+}
+
+void PrintEnergyError(NvU32 index, const char *call, NvAPI_Status status) {
+  const std::string prefix = "GPU[" + std::to_string(index) + "] " + call + " failed";
+  PrintNvapiError(prefix.c_str(), status);
+}
+
+// Channels and rails come from the power monitor info, the counters from a first status read. The peak starts at 0,
+// pwrMaxmW of that read covers a period before the window opened.
+bool OpenGpuEnergy(NvPhysicalGpuHandle handle, NvU32 index, NV_GPU_POWER_MONITOR_GET_STATUS *status,
+                   GpuEnergy *out) {
+  NV_GPU_POWER_MONITOR_GET_INFO info = {};
+  info.version = NV_GPU_POWER_MONITOR_GET_INFO_VER;
+  NvAPI_Status result = NvApi().NvAPI_GPU_PowerMonitorGetInfo(handle, &info);
+  if (result != NVAPI_OK) {
+    PrintEnergyError(index, "NvAPI_GPU_PowerMonitorGetInfo", result);
+    return false;
+  }
+  if (!info.bSupported || info.channelMask == 0) {
+    Printf("GPU[%u] power monitor not supported.\n", index);
+    return false;
+  }
+
+  out->index = index;
+  out->handle = handle;
+  out->channelMask = info.channelMask;
+  out->totalChannel = info.totalGpuChannelIdx < NV_GPU_POWER_MONITOR_MAX_CHANNELS_V1 &&
+                              (info.channelMask & (1u << info.totalGpuChannelIdx))
+                          ? info.totalGpuChannelIdx
+                          : NV_GPU_POWER_MONITOR_MAX_CHANNELS_V1;
+  out->channels.clear();
+  result = ReadEnergyStatus(*out, status);
+  if (result != NVAPI_OK) {
+    PrintEnergyError(index, "NvAPI_GPU_PowerMonitorGetStatus", result);
+    return false;
+  }
+  out->lastUs = EnergyNowUs();
+  for (NvU32 i = 0; i < NV_GPU_POWER_MONITOR_MAX_CHANNELS_V1; ++i) {
+    if (!(info.channelMask & (1u << i))) { continue; }
+    out->channels.push_back({i, info.channels[i].pwrRail, RailCeilingmW(info.channels[i].pwrLimitmW),
+                             status->channels[i].energymJ, 0, 0, kCounterOk});
+  }
+  return true;
+}
+
+// Folds a status read into the running totals. The peak is the driver's own maximum over its sampling period at each
+// read, so it only covers the periods that were read.
+void AdvanceGpuEnergy(GpuEnergy &gpu, const NV_GPU_POWER_MONITOR_GET_STATUS &status, NvU64 nowUs) {
+  const double elapsedS = nowUs > gpu.lastUs ? (nowUs - gpu.lastUs) / 1e6 : 0.0;
+  for (auto &channel : gpu.channels) {
+    const auto &current = status.channels[channel.channel];
+    NvU64 deltamJ = 0;
+    const CounterState state = CounterDelta(channel.lastmJ, current.energymJ, channel.ceilingmW, elapsedS, &deltamJ);
+    channel.accumulatedmJ += deltamJ;
+    channel.lastmJ = current.energymJ;
+    channel.peakmW = std::max(channel.peakmW, current.pwrMaxmW);
+    channel.state = std::max(channel.state, state);
+  }
+  gpu.lastUs = nowUs;
+}
+
+// Power monitor on every selected GPU that has one. With --index a GPU without one is an error, otherwise it is left
+// out of the window.
+bool OpenEnergyGpus(bool hasIndex, NvU32 index, NV_GPU_POWER_MONITOR_GET_STATUS *status,
+                    std::vector<GpuEnergy> *out) {
+  std::vector<NvPhysicalGpuHandle> handles;
+  std::vector<NvU32> indices;
+  if (!CollectGpus(hasIndex, index, handles, indices)) { return false; }
+  for (size_t i = 0; i < handles.size(); ++i) {
+    GpuEnergy gpu;
+    if (!OpenGpuEnergy(handles[i], indices[i], status, &gpu)) {
+      if (hasIndex) { return false; }
+      continue;
+    }
+    out->push_back(std::move(gpu));
+  }
+  if (out->empty()) {
+    Printf("No GPU with a power monitor.\n");
+    return false;
+  }
+  return true;
+}
+
+void PrintEnergyReport(const std::string &name, const char *state, double durationS,
+                       const std::vector<GpuEnergy> &gpus, const NvS32 *exitCode) {
+  if (StructuredOutput()) {
+    RecordWriter window("energy_window");
+    window.Field("name", name).Field("state", state).Field("duration_s", durationS);
+    window.Field("gpus", static_cast<NvU32>(gpus.size()));
+    if (exitCode) {
+      window.Field("exit_code", *exitCode);
+    } else {
+      window.Null("exit_code");
+    }
+  } else {
+    Printf("Energy window %s %s, %.3f s", name.c_str(), state, durationS);
+    if (exitCode) { Printf(", exit code %d", *exitCode); }
+    Printf("\n");
+  }
+
+  for (const auto &gpu : gpus) {
+    if (StructuredOutput()) {
+      SetRecordGpu(gpu.index);
+    } else {
+      Printf("GPU[%u]\n", gpu.index);
+    }
+    for (const auto &channel : gpu.channels) {
+      const double joules = channel.accumulatedmJ / 1000.0;
+      const double averageW = durationS > 0.0 ? joules / durationS : 0.0;
+      const char *rail = PowerChannelRailName(static_cast<NV_GPU_POWER_CHANNEL_POWER_RAIL>(channel.rail));
+      const bool total = channel.channel == gpu.totalChannel;
+      if (StructuredOutput()) {
+        RecordWriter("energy_channel")
+            .Field("channel", channel.channel)
+            .Field("rail", rail)
+            .Field("total", total)
+            .Field("energy_j", joules)
+            .Field("avg_w", averageW)
+            .Field("peak_w", channel.peakmW / 1000.0)
+            .Field("counter", CounterStateName(channel.state));
+        continue;
+      }
+      Printf("  channel[%u] %-20s %14.3f J avg=%.3f W peak=%.3f W%s", channel.channel, rail, joules, averageW,
+             channel.peakmW / 1000.0, total ? " (total)" : "");
+      if (channel.state == kCounterWrapped) { Printf(" counter wrapped"); }
+      if (channel.state == kCounterReset) { Printf(" counter reset, lower bound"); }
+      if (channel.state == kCounterAmbiguous) { Printf(" counter went back after a long gap, lower bound"); }
+      Printf("\n");
+    }
+  }
+  ClearRecordGpu();
+}
+
+bool ValidWindowName(const char *name) {
+  const size_t length = std::strlen(name);
+  if (length == 0 || length > kMaxWindowName || name[0] == '.') { return false; }
+  for (size_t i = 0; i < length; ++i) {
+    const unsigned char c = static_cast<unsigned char>(name[i]);
+    if (!std::isalnum(c) && c != '-' && c != '_' && c != '.') { return false; }
+  }
+  return true;
+}
+
+// Windows live in %TEMP% unless --state-dir names a directory, e.g. one shared by a job scheduler.
+bool EnergyWindowPath(const char *stateDir, const char *name, std::string *out) {
+  std::string dir;
+  if (stateDir) {
+    if (!CreateDirectoryA(stateDir, NULL) && GetLastError() != ERROR_ALREADY_EXISTS) {
+      Printf("Failed to create state directory: %s\n", stateDir);
+      return false;
+    }
+    dir = stateDir;
+    if (!dir.empty() && dir.back() != '\\' && dir.back() != '/') { dir += '\\'; }
+  } else {
+    char temp[MAX_PATH + 1] = {0};
+    const DWORD length = GetTempPathA(sizeof(temp), temp);
+    if (length == 0 || length > sizeof(temp)) {
+      Printf("Failed to locate the temp directory.\n");
+      return false;
+    }
+    dir = temp;
+  }
+  *out = dir + "nvapi-cli-energy-" + name + ".txt";
+  return true;
+}
+
+// Rewritten whole on every start and read, then renamed over the old file:
+//   energy1 <name> <startUs>
+//   gpu <index> <channelMask> <totalChannel> <lastUs>
+//   ch <channel> <rail> <ceilingmW> <lastmJ> <accumulatedmJ> <peakmW> <ok|wrapped|reset|ambiguous>
+bool WriteEnergyWindow(const std::string &path, const EnergyWindow &window) {
+  const std::string temp = path + ".tmp";
+  FILE *file = nullptr;
+  if (fopen_s(&file, temp.c_str(), "w") != 0 || !file) {
+    Printf("Failed to write %s\n", temp.c_str());
+    return false;
+  }
+  std::fprintf(file, "energy1 %s %llu\n", window.name.c_str(), static_cast<unsigned long long>(window.startUs));
+  for (const auto &gpu : window.gpus) {
+    std::fprintf(file, "gpu %u %u %u %llu\n", gpu.index, gpu.channelMask, gpu.totalChannel,
+                 static_cast<unsigned long long>(gpu.lastUs));
+    for (const auto &channel : gpu.channels) {
+      std::fprintf(file, "ch %u %u %u %llu %llu %u %s\n", channel.channel, channel.rail, channel.ceilingmW,
+                   static_cast<unsigned long long>(channel.lastmJ),
+                   static_cast<unsigned long long>(channel.accumulatedmJ), channel.peakmW,
+                   CounterStateName(channel.state));
+    }
+  }
+  const bool written = std::ferror(file) == 0;
+  const bool closed = std::fclose(file) == 0;
+  if (!written || !closed || !MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+    std::remove(temp.c_str());
+    Printf("Failed to write %s\n", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool ReadEnergyWindow(const std::string &path, const char *name, EnergyWindow *out) {
+  FILE *file = nullptr;
+  if (fopen_s(&file, path.c_str(), "r") != 0 || !file) {
+    Printf("No open energy window named %s.\n", name);
+    return false;
+  }
+  bool valid = true;
+  bool header = false;
+  char line[256];
+  while (valid && std::fgets(line, sizeof(line), file)) {
+    char verb[16] = {0};
+    if (std::sscanf(line, "%15s", verb) != 1) { continue; }
+    if (std::strcmp(verb, "energy1") == 0) {
+      char windowName[kMaxWindowName + 1] = {0};
+      unsigned long long startUs = 0;
+      valid = !header && std::sscanf(line, "%*s %64s %llu", windowName, &startUs) == 2;
+      out->name = windowName;
+      out->startUs = startUs;
+      header = true;
+    } else if (std::strcmp(verb, "gpu") == 0) {
+      GpuEnergy gpu = {};
+      unsigned long long lastUs = 0;
+      valid = header && std::sscanf(line, "%*s %u %u %u %llu", &gpu.index, &gpu.channelMask, &gpu.totalChannel,
+                                    &lastUs) == 4;
+      gpu.lastUs = lastUs;
+      out->gpus.push_back(std::move(gpu));
+    } else if (std::strcmp(verb, "ch") == 0) {
+      ChannelEnergy channel = {};
+      unsigned long long lastmJ = 0;
+      unsigned long long accumulatedmJ = 0;
+      char state[16] = {0};
+      valid = !out->gpus.empty() &&
+              std::sscanf(line, "%*s %u %u %u %llu %llu %u %15s", &channel.channel, &channel.rail,
+                          &channel.ceilingmW, &lastmJ, &accumulatedmJ, &channel.peakmW, state) == 7 &&
+              channel.channel < NV_GPU_POWER_MONITOR_MAX_CHANNELS_V1;
+      channel.ceilingmW = RailCeilingmW(channel.ceilingmW);
+      channel.lastmJ = lastmJ;
+      channel.accumulatedmJ = accumulatedmJ;
+      channel.state = ParseCounterState(state);
+      if (valid) { out->gpus.back().channels.push_back(channel); }
+    }
+  }
+  std::fclose(file);
+  if (!valid || !header) {
+    Printf("Energy window file %s is damaged.\n", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+// Quotes one argument the way the CRT splits a command line, so the child gets back exactly what was passed after --.
+void AppendCommandArg(std::string *commandLine, const char *arg) {
+  if (!commandLine->empty()) { *commandLine += ' '; }
+  if (*arg && !std::strpbrk(arg, " \t\n\v\"")) {
+    *commandLine += arg;
+    return;
+  }
+  *commandLine += '"';
+  for (const char *p = arg;; ++p) {
+    size_t backslashes = 0;
+    while (*p == '\\') {
+      ++backslashes;
+      ++p;
+    }
+    if (*p == '\0') {
+      commandLine->append(backslashes * 2, '\\');
+      break;
+    }
+    commandLine->append(*p == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+    *commandLine += *p;
+  }
+  *commandLine += '"';
+}
+
+// The child shares the console and gets Ctrl+C itself, run keeps going so it can still report once the child exits.
+BOOL WINAPI EnergyRunCtrlHandler(DWORD type) { return type == CTRL_C_EVENT || type == CTRL_BREAK_EVENT; }
+
+struct WindowOptions {
+  const char *name = nullptr;
+  const char *stateDir = nullptr;
+  NvU32 index = 0;
+  bool hasIndex = false;
+  bool force = false;
+};
+
+bool ParseWindowOptions(int argc, char **argv, bool allowStart, WindowOptions *options) {
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--name") == 0 && i + 1 < argc) {
+      options->name = argv[++i];
+      continue;
+    }
+    if (std::strcmp(argv[i], "--state-dir") == 0 && i + 1 < argc) {
+      options->stateDir = argv[++i];
+      continue;
+    }
+    if (allowStart && std::strcmp(argv[i], "--index") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &options->index)) {
+        Printf("Invalid GPU index.\n");
+        return false;
+      }
+      options->hasIndex = true;
+      ++i;
+      continue;
+    }
+    if (allowStart && std::strcmp(argv[i], "--force") == 0) {
+      options->force = true;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return false;
+  }
+  if (!options->name) {
+    Printf("Missing --name\n");
+    return false;
+  }
+  if (!ValidWindowName(options->name)) {
+    Printf("Invalid window name: %s (letters, digits, '-', '_' and '.', at most %u characters)\n", options->name,
+           static_cast<unsigned>(kMaxWindowName));
+    return false;
+  }
+  return true;
+}
+
+// read and stop: one status read per GPU of the window, folded into its totals. Nothing is written back unless every
+// GPU was read, so a failed read or stop can simply be retried.
+int FinishEnergyWindow(int argc, char **argv, bool stop) {
+  WindowOptions options;
+  if (!ParseWindowOptions(argc, argv, false, &options)) { return 1; }
+  std::string path;
+  if (!EnergyWindowPath(options.stateDir, options.name, &path)) { return 1; }
+  EnergyWindow window;
+  if (!ReadEnergyWindow(path, options.name, &window)) { return 1; }
+
+  const NvU64 nowUs = EnergyNowUs();
+  bool restarted = nowUs < window.startUs;
+  for (const auto &gpu : window.gpus) { restarted = restarted || nowUs < gpu.lastUs; }
+  if (restarted) {
+    Printf("Energy window %s was started before the last restart, its counters are gone.\n", options.name);
+    if (stop) { std::remove(path.c_str()); }
+    return 1;
+  }
+
+  std::vector<NvPhysicalGpuHandle> handles;
+  std::vector<NvU32> indices;
+  if (!CollectGpus(false, 0, handles, indices)) { return 1; }
+  std::unique_ptr<NV_GPU_POWER_MONITOR_GET_STATUS> status(new NV_GPU_POWER_MONITOR_GET_STATUS());
+  for (auto &gpu : window.gpus) {
+    const auto found = std::find(indices.begin(), indices.end(), gpu.index);
+    if (found == indices.end()) {
+      Printf("GPU[%u] of energy window %s is no longer present.\n", gpu.index, options.name);
+      return 1;
+    }
+    gpu.handle = handles[found - indices.begin()];
+    NvAPI_Status result = ReadEnergyStatus(gpu, status.get());
+    if (result != NVAPI_OK) {
+      PrintEnergyError(gpu.index, "NvAPI_GPU_PowerMonitorGetStatus", result);
+      return 1;
+    }
+    AdvanceGpuEnergy(gpu, *status, nowUs);
+  }
+
+  if (stop) {
+    std::remove(path.c_str());
+  } else if (!WriteEnergyWindow(path, window)) {
+    return 1;
+  }
+  PrintEnergyReport(window.name, stop ? "closed" : "open", (nowUs - window.startUs) / 1e6, window.gpus, nullptr);
+  return 0;
+}
+} // namespace
+
+int CmdGpuEnergyStart(int argc, char **argv) {
+  WindowOptions options;
+  if (!ParseWindowOptions(argc, argv, true, &options)) { return 1; }
+  std::string path;
+  if (!EnergyWindowPath(options.stateDir, options.name, &path)) { return 1; }
+  FILE *existing = nullptr;
+  if (!options.force && fopen_s(&existing, path.c_str(), "r") == 0 && existing) {
+    std::fclose(existing);
+    Printf("Energy window %s is already open, stop it first or pass --force.\n", options.name);
+    return 1;
+  }
+
+  EnergyWindow window;
+  window.name = options.name;
+  std::unique_ptr<NV_GPU_POWER_MONITOR_GET_STATUS> status(new NV_GPU_POWER_MONITOR_GET_STATUS());
+  if (!OpenEnergyGpus(options.hasIndex, options.index, status.get(), &window.gpus)) { return 1; }
+  window.startUs = window.gpus.front().lastUs;
+  for (const auto &gpu : window.gpus) { window.startUs = std::min(window.startUs, gpu.lastUs); }
+  if (!WriteEnergyWindow(path, window)) { return 1; }
+  PrintEnergyReport(window.name, "started", 0.0, window.gpus, nullptr);
+  return 0;
+}
+
+int CmdGpuEnergyRead(int argc, char **argv) { return FinishEnergyWindow(argc, argv, false); }
+
+int CmdGpuEnergyStop(int argc, char **argv) { return FinishEnergyWindow(argc, argv, true); }
+
+int CmdGpuEnergyRun(int argc, char **argv) {
+  NvU32 index = 0;
+  bool hasIndex = false;
+  NvU32 intervalMs = 1000;
+  int commandStart = -1;
+
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--") == 0) {
+      commandStart = i + 1;
+      break;
+    }
+    if (std::strcmp(argv[i], "--index") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
+        Printf("Invalid GPU index.\n");
+        return 1;
+      }
+      hasIndex = true;
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--interval-ms") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &intervalMs) || intervalMs == 0) {
+        Printf("Invalid value for --interval-ms\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+  if (commandStart < 0 || commandStart >= argc) {
+    Printf("Missing command after --\n");
+    return 1;
+  }
+
+  std::string commandLine;
+  for (int i = commandStart; i < argc; ++i) { AppendCommandArg(&commandLine, argv[i]); }
+
+  std::vector<GpuEnergy> gpus;
+  std::unique_ptr<NV_GPU_POWER_MONITOR_GET_STATUS> status(new NV_GPU_POWER_MONITOR_GET_STATUS());
+  if (!OpenEnergyGpus(hasIndex, index, status.get(), &gpus)) { return 1; }
+
+  STARTUPINFOA startup = {};
+  startup.cb = sizeof(startup);
+  PROCESS_INFORMATION process = {};
+  std::vector<char> mutableLine(commandLine.begin(), commandLine.end());
+  mutableLine.push_back('\0');
+  const NvU64 startUs = EnergyNowUs();
+  if (!CreateProcessA(NULL, mutableLine.data(), NULL, NULL, TRUE, 0, NULL, NULL, &startup, &process)) {
+    Printf("Failed to start %s (error %lu)\n", argv[commandStart], GetLastError());
+    return 1;
+  }
+  for (auto &gpu : gpus) { gpu.lastUs = startUs; }
+
+  // Every interval refreshes the peaks and keeps the gap between counter reads short enough to unwrap them.
+  SetConsoleCtrlHandler(EnergyRunCtrlHandler, TRUE);
+  while (WaitForSingleObject(process.hProcess, intervalMs) == WAIT_TIMEOUT) {
+    for (auto &gpu : gpus) {
+      if (ReadEnergyStatus(gpu, status.get()) == NVAPI_OK) { AdvanceGpuEnergy(gpu, *status, EnergyNowUs()); }
+    }
+  }
+  const NvU64 endUs = EnergyNowUs();
+  SetConsoleCtrlHandler(EnergyRunCtrlHandler, FALSE);
+
+  DWORD exitCode = 1;
+  GetExitCodeProcess(process.hProcess, &exitCode);
+  CloseHandle(process.hThread);
+  CloseHandle(process.hProcess);
+
+  // A GPU whose last read fails still reports what earlier reads accumulated.
+  for (auto &gpu : gpus) {
+    NvAPI_Status result = ReadEnergyStatus(gpu, status.get());
+    if (result != NVAPI_OK) {
+      PrintEnergyError(gpu.index, "NvAPI_GPU_PowerMonitorGetStatus", result);
+      continue;
+    }
+    AdvanceGpuEnergy(gpu, *status, endUs);
+  }
+  const NvS32 childExit = static_cast<NvS32>(exitCode);
+  PrintEnergyReport(argv[commandStart], "finished", (endUs - startUs) / 1e6, gpus, &childExit);
+  return static_cast<int>(exitCode);
+}
+} // namespace nvcli
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/timer_resolution.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <thread>
+
+namespace nvcli {
+namespace {
+using WatchClock = std::chrono::steady_clock;
+
+struct LimitInterval {
+  NvU64 startUs;
+  NvU32 value;
+  NvU32 minValue;
+  NvU32 maxValue;
+  NV_GPU_CLOCK_DOMAIN_ID clockId;
+  // Last poll that reported the limit enabled, intervals not marked by the current poll have ended.
+  NvU64 seenPoll;
+};
+
+struct LimitTotals {
+  NvU32 intervals;
+  NvU64 activeUs;
+  NvU32 minValue;
+  NvU32 maxValue;
+};
+
+// One GPU being watched. The name table is read once up front, every poll reuses the same status buffer and only
+// walks the limits the driver returned.
+struct LimitWatch {
+  NvPhysicalGpuHandle handle;
+  NvU32 index;
+  std::unordered_map<NvU32, std::string> names;
+  std::unique_ptr<NV_GPU_PERF_LIMITS_STATUS> status;
+  std::map<NvU32, LimitInterval> active;
+  std::map<NvU32, LimitTotals> totals;
+  NvU64 polls;
+  NvU64 errors;
+  NvAPI_Status lastError;
+};
+
+std::atomic<bool> g_watchStop{false};
+
+BOOL WINAPI WatchCtrlHandler(DWORD type) {
+  if (type != CTRL_C_EVENT && type != CTRL_BREAK_EVENT) { return FALSE; }
+  g_watchStop = true;
+  return TRUE;
+}
+
+const char *LimitName(const LimitWatch &watch, NvU32 limitId) {
+  const auto found = watch.names.find(limitId);
+  return found != watch.names.end() ? found->second.c_str() : "-";
+}
+
+void EmitLimitEvent(const LimitWatch &watch, const char *event, NvU32 limitId, NvU64 timeUs,
+                    const LimitInterval &interval) {
+  const bool ended = std::strcmp(event, "end") == 0;
+  const double durationS = (timeUs - interval.startUs) / 1e6;
+  if (StructuredOutput()) {
+    SetRecordGpu(watch.index);
+    RecordWriter record("perf_limit_event");
+    record.Field("time_s", timeUs / 1e6)
+        .Field("event", event)
+        .Hex("limit_id", limitId)
+        .Field("name", LimitName(watch, limitId))
+        .Field("value", interval.value)
+        .Field("clock_domain", ClockDomainIdName(interval.clockId));
+    if (ended) {
+      record.Field("duration_s", durationS).Field("min_value", interval.minValue).Field("max_value", interval.maxValue);
+    } else {
+      record.Null("duration_s").Null("min_value").Null("max_value");
+    }
+    return;
+  }
+  if (ended) {
+    Printf("%10.3f GPU[%u] %-6s 0x%08X %-24s after %.3f s, value %u-%u\n", timeUs / 1e6, watch.index, event, limitId,
+           LimitName(watch, limitId), durationS, interval.minValue, interval.maxValue);
+  } else {
+    Printf("%10.3f GPU[%u] %-6s 0x%08X %-24s value %u %s\n", timeUs / 1e6, watch.index, event, limitId,
+           LimitName(watch, limitId), interval.value, ClockDomainIdName(interval.clockId));
+  }
+}
+
+void CloseInterval(LimitWatch &watch, NvU32 limitId, const LimitInterval &interval, NvU64 timeUs) {
+  LimitTotals &totals = watch.totals[limitId];
+  if (totals.intervals == 0) {
+    totals.minValue = interval.minValue;
+    totals.maxValue = interval.maxValue;
+  }
+  ++totals.intervals;
+  totals.activeUs += timeUs - interval.startUs;
+  totals.minValue = std::min(totals.minValue, interval.minValue);
+  totals.maxValue = std::max(totals.maxValue, interval.maxValue);
+}
+
+NV_GPU_PERF_LIMITS_STATUS *ResetLimitsStatus(NV_GPU_PERF_LIMITS_STATUS *status) {
+  status->version = NV_GPU_PERF_LIMITS_STATUS_VER;
+  status->numLimits = 0;
+  return status;
+}
+
+// Diffs one poll against the open intervals in place: newly enabled limits start, limits no longer enabled end and an
+// active limit whose imposed value moved reports a change.
+void PollLimits(LimitWatch &watch, NvU64 timeUs) {
+  NV_GPU_PERF_LIMITS_STATUS &status = *ResetLimitsStatus(watch.status.get());
+  const NvAPI_Status result = NvApi().NvAPI_GPU_PerfLimitsGetStatus(watch.handle, &status);
+  if (result != NVAPI_OK) {
+    ++watch.errors;
+    watch.lastError = result;
+    return;
+  }
+  ++watch.polls;
+
+  for (NvU32 l = 0; l < status.numLimits && l < NVAPI_PERF_LIMIT_ID_MAX_LIMITS; ++l) {
+    const auto &limit = status.limits[l];
+    if (!limit.output.bEnabled) { continue; }
+    const NvU32 limitId = static_cast<NvU32>(limit.limitId);
+    const NvU32 value = limit.output.value;
+    auto open = watch.active.find(limitId);
+    if (open == watch.active.end()) {
+      LimitInterval interval = {timeUs, value, value, value, limit.output.decoupledClockId, watch.polls};
+      EmitLimitEvent(watch, "start", limitId, timeUs, interval);
+      watch.active.emplace(limitId, interval);
+      continue;
+    }
+    LimitInterval &interval = open->second;
+    interval.seenPoll = watch.polls;
+    if (value != interval.value) {
+      interval.value = value;
+      interval.minValue = std::min(interval.minValue, value);
+      interval.maxValue = std::max(interval.maxValue, value);
+      interval.clockId = limit.output.decoupledClockId;
+      EmitLimitEvent(watch, "change", limitId, timeUs, interval);
+    }
+  }
+
+  for (auto it = watch.active.begin(); it != watch.active.end();) {
+    if (it->second.seenPoll == watch.polls) {
+      ++it;
+      continue;
+    }
+    EmitLimitEvent(watch, "end", it->first, timeUs, it->second);
+    CloseInterval(watch, it->first, it->second, timeUs);
+    it = watch.active.erase(it);
+  }
+}
+
+// Time per limit over the whole watch, intervals still open at the end count up to the last poll.
+void PrintLimitSummary(LimitWatch &watch, NvU64 endUs) {
+  for (const auto &entry : watch.active) { CloseInterval(watch, entry.first, entry.second, endUs); }
+  watch.active.clear();
+
+  std::vector<std::pair<NvU32, LimitTotals>> ranked(watch.totals.begin(), watch.totals.end());
+  std::stable_sort(ranked.begin(), ranked.end(), [](const std::pair<NvU32, LimitTotals> &a,
+                                                   const std::pair<NvU32, LimitTotals> &b) {
+    return a.second.activeUs > b.second.activeUs;
+  });
+
+  const double windowS = endUs / 1e6;
+  if (StructuredOutput()) {
+    SetRecordGpu(watch.index);
+    RecordWriter("perf_limit_watch")
+        .Field("duration_s", windowS)
+        .Field("polls", watch.polls)
+        .Field("errors", watch.errors)
+        .Field("limits", static_cast<NvU32>(ranked.size()));
+    for (const auto &entry : ranked) {
+      RecordWriter("perf_limit_summary")
+          .Hex("limit_id", entry.first)
+          .Field("name", LimitName(watch, entry.first))
+          .Field("intervals", entry.second.intervals)
+          .Field("active_s", entry.second.activeUs / 1e6)
+          .Field("active_pct", windowS > 0.0 ? entry.second.activeUs / 1e4 / windowS : 0.0)
+          .Field("min_value", entry.second.minValue)
+          .Field("max_value", entry.second.maxValue);
+    }
+    return;
+  }
+
+  Printf("GPU[%u] %.3f s, %llu polls, %llu failed\n", watch.index, windowS,
+         static_cast<unsigned long long>(watch.polls), static_cast<unsigned long long>(watch.errors));
+  if (ranked.empty()) {
+    Printf("  No limit was active.\n");
+    return;
+  }
+  for (const auto &entry : ranked) {
+    Printf("  0x%08X %-24s %9.3f s %6.2f%% %5u intervals, value %u-%u\n", entry.first, LimitName(watch, entry.first),
+           entry.second.activeUs / 1e6, windowS > 0.0 ? entry.second.activeUs / 1e4 / windowS : 0.0,
+           entry.second.intervals, entry.second.minValue, entry.second.maxValue);
+  }
+}
+} // namespace
+
+int CmdGpuPerfLimitsWatch(int argc, char **argv) {
+  NvU32 index = 0;
+  bool hasIndex = false;
+  NvU32 intervalMs = 10;
+  NvU32 durationSec = 60;
+
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--index") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
+        Printf("Invalid GPU index.\n");
+        return 1;
+      }
+      hasIndex = true;
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--interval-ms") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &intervalMs) || intervalMs == 0) {
+        Printf("Invalid value for --interval-ms\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--duration") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &durationSec)) {
+        Printf("Invalid value for --duration\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+
+  std::vector<NvPhysicalGpuHandle> handles;
+  std::vector<NvU32> indices;
+  if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
+
+  std::vector<LimitWatch> watches;
+  for (size_t i = 0; i < handles.size(); ++i) {
+    LimitWatch watch;
+    watch.handle = handles[i];
+    watch.index = indices[i];
+    watch.status.reset(new NV_GPU_PERF_LIMITS_STATUS());
+    watch.polls = 0;
+    watch.errors = 0;
+    watch.lastError = NVAPI_OK;
+    // A GPU that cannot report its limits now would only poll errors for the whole watch.
+    NvAPI_Status probe = NvApi().NvAPI_GPU_PerfLimitsGetStatus(handles[i], ResetLimitsStatus(watch.status.get()));
+    if (probe != NVAPI_OK) {
+      const std::string prefix = "GPU[" + std::to_string(indices[i]) + "] NvAPI_GPU_PerfLimitsGetStatus failed";
+      PrintNvapiError(prefix.c_str(), probe);
+      return 1;
+    }
+    // Without names the IDs are still watched, they just print without one.
+    NvAPI_Status status = LoadPerfLimitNames(handles[i], &watch.names);
+    if (status != NVAPI_OK && !StructuredOutput()) {
+      Printf("GPU[%u] limit names unavailable: %s\n", indices[i], NvapiStatusString(status).c_str());
+    }
+    watches.push_back(std::move(watch));
+  }
+
+  // --duration 0 runs until Ctrl+C, either way Ctrl+C ends the watch with the summary.
+  g_watchStop = false;
+  SetConsoleCtrlHandler(WatchCtrlHandler, TRUE);
+  if (!StructuredOutput()) {
+    Printf("%10s %-6s %-6s %-10s %-24s %s\n", "time_s", "gpu", "event", "limit", "name", "detail");
+  }
+
+  NvU64 lastUs = 0;
+  {
+    TimerResolution resolution;
+    const auto interval = std::chrono::milliseconds(intervalMs);
+    const auto start = WatchClock::now();
+    const auto end = start + std::chrono::seconds(durationSec);
+    auto deadline = start;
+    while (!g_watchStop && (durationSec == 0 || deadline < end)) {
+      std::this_thread::sleep_until(deadline);
+      lastUs = static_cast<NvU64>(
+          std::chrono::duration_cast<std::chrono::microseconds>(WatchClock::now() - start).count());
+      for (auto &watch : watches) { PollLimits(watch, lastUs); }
+
+      // Skip ticks that were missed entirely instead of bursting to catch up.
+      deadline += interval;
+      const auto after = WatchClock::now();
+      if (after > deadline + interval) { deadline = after - (after - deadline) % interval; }
+    }
+  }
+  SetConsoleCtrlHandler(WatchCtrlHandler, FALSE);
+
+  int result = 0;
+  for (auto &watch : watches) {
+    PrintLimitSummary(watch, lastUs);
+    if (watch.polls == 0 || watch.errors > 0) { result = 1; }
+  }
+  ClearRecordGpu();
+  // An empty summary is only meaningful when every poll succeeded.
+  for (const auto &watch : watches) {
+    if (watch.polls == 0) {
+      Printf("GPU[%u] no poll succeeded, the summary is empty.\n", watch.index);
+    } else if (watch.errors > 0) {
+      Printf("GPU[%u] %llu of %llu polls failed, last: %s\n", watch.index,
+             static_cast<unsigned long long>(watch.errors),
+             static_cast<unsigned long long>(watch.polls + watch.errors), NvapiStatusString(watch.lastError).c_str());
+    }
+  }
+  return result;
+}
+} // namespace nvcli
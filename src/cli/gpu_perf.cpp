@@ -4,6 +4,10 @@
  */
 
 #include "cli/commands.h"
+#include "cli/vfe_eval.h"
+
+#include <memory>
+#include <unordered_map>
 
 namespace nvcli {
 bool ParseFloat(const char *text, float *out) {
@@ -107,32 +111,6 @@ bool ParseCsvFloat3(const char *text, NvF32 coeffs[3]) {
   return true;
 }
 
-NV_GPU_PERF_VFE_VAR_CONTROL_SINGLE *GetVfeVarSingleControl(NV_GPU_PERF_VFE_VAR_CONTROL_V1 &var) {
-  switch (var.type) {
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE: return &var.data.single;
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_FREQUENCY: return &var.data.singleFreq.super;
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED: return &var.data.sensed.super;
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE:
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE_20: return &var.data.sensedFuse.super.super;
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_TEMP: return &var.data.sensedTemp.super.super;
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_VOLTAGE: return &var.data.singleVolt.super.super;
-  default: return NULL;
-  }
-}
-
-const NV_GPU_PERF_VFE_VAR_CONTROL_SINGLE *GetVfeVarSingleControl(const NV_GPU_PERF_VFE_VAR_CONTROL_V1 &var) {
-  switch (var.type) {
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE: return &var.data.single;
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_FREQUENCY: return &var.data.singleFreq.super;
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED: return &var.data.sensed.super;
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE:
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE_20: return &var.data.sensedFuse.super.super;
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_TEMP: return &var.data.sensedTemp.super.super;
-  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_VOLTAGE: return &var.data.singleVolt.super.super;
-  default: return NULL;
-  }
-}
-
 int CmdGpuPstates20(int argc, char **argv) {
   NvU32 index = 0;
   bool hasIndex = false;
@@ -142,61 +120,61 @@ int CmdGpuPstates20(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_PSTATES20_INFO info = {};
     info.version = NV_GPU_PERF_PSTATES20_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_GetPstates20(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetPstates20(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetPstates20 failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  Pstates20 editable=%u pstates=%u clocks=%u voltages=%u\n", info.bIsEditable ? 1 : 0, info.numPstates,
-                info.numClocks, info.numBaseVoltages);
+    Printf("  Pstates20 editable=%u pstates=%u clocks=%u voltages=%u\n", info.bIsEditable ? 1 : 0, info.numPstates,
+           info.numClocks, info.numBaseVoltages);
 
     for (NvU32 p = 0; p < info.numPstates; ++p) {
       const auto &pstate = info.pstates[p];
-      std::printf("  %s editable=%u\n", PstateName(pstate.pstateId), pstate.bIsEditable ? 1 : 0);
+      Printf("  %s editable=%u\n", PstateName(pstate.pstateId), pstate.bIsEditable ? 1 : 0);
 
       for (NvU32 c = 0; c < info.numClocks; ++c) {
         const auto &clock = pstate.clocks[c];
         if (clock.domainId == NVAPI_GPU_PUBLIC_CLOCK_UNDEFINED) { continue; }
 
-        std::printf("    clock[%u] %s type=%s editable=%u\n", c, ClockDomainName(clock.domainId),
-                    PstateClockTypeName(clock.typeId), clock.bIsEditable ? 1 : 0);
+        Printf("    clock[%u] %s type=%s editable=%u\n", c, ClockDomainName(clock.domainId),
+               PstateClockTypeName(clock.typeId), clock.bIsEditable ? 1 : 0);
         if (clock.typeId == NVAPI_GPU_PERF_PSTATE20_CLOCK_TYPE_SINGLE) {
-          std::printf("      freq=%u kHz\n", clock.data.single.freq_kHz);
+          Printf("      freq=%u kHz\n", clock.data.single.freq_kHz);
         } else {
-          std::printf("      freqRange=%u-%u kHz voltageDomain=%u minV=%u maxV=%u\n", clock.data.range.minFreq_kHz,
-                      clock.data.range.maxFreq_kHz, clock.data.range.domainId, clock.data.range.minVoltage_uV,
-                      clock.data.range.maxVoltage_uV);
+          Printf("      freqRange=%u-%u kHz voltageDomain=%u minV=%u maxV=%u\n", clock.data.range.minFreq_kHz,
+                 clock.data.range.maxFreq_kHz, clock.data.range.domainId, clock.data.range.minVoltage_uV,
+                 clock.data.range.maxVoltage_uV);
         }
-        std::printf("      delta=%d kHz (min=%d max=%d)\n", clock.freqDelta_kHz.value,
-                    clock.freqDelta_kHz.valueRange.min, clock.freqDelta_kHz.valueRange.max);
+        Printf("      delta=%d kHz (min=%d max=%d)\n", clock.freqDelta_kHz.value, clock.freqDelta_kHz.valueRange.min,
+               clock.freqDelta_kHz.valueRange.max);
       }
 
       for (NvU32 v = 0; v < info.numBaseVoltages; ++v) {
         const auto &volt = pstate.baseVoltages[v];
         if (volt.domainId == NVAPI_GPU_PERF_VOLTAGE_INFO_DOMAIN_UNDEFINED) { continue; }
-        std::printf("    voltage[%u] %s editable=%u base=%u uV delta=%d uV (min=%d max=%d)\n", v,
-                    VoltageDomainName(volt.domainId), volt.bIsEditable ? 1 : 0, volt.volt_uV, volt.voltDelta_uV.value,
-                    volt.voltDelta_uV.valueRange.min, volt.voltDelta_uV.valueRange.max);
+        Printf("    voltage[%u] %s editable=%u base=%u uV delta=%d uV (min=%d max=%d)\n", v,
+               VoltageDomainName(volt.domainId), volt.bIsEditable ? 1 : 0, volt.volt_uV, volt.voltDelta_uV.value,
+               volt.voltDelta_uV.valueRange.min, volt.voltDelta_uV.valueRange.max);
       }
 
       if (info.ov.numVoltages > 0) {
-        std::printf("    ov voltages: %u\n", info.ov.numVoltages);
+        Printf("    ov voltages: %u\n", info.ov.numVoltages);
         for (NvU32 v = 0; v < info.ov.numVoltages; ++v) {
           const auto &ov = info.ov.voltages[v];
-          std::printf("      ov[%u] %s editable=%u base=%u uV delta=%d uV (min=%d max=%d)\n", v,
-                      VoltageDomainName(ov.domainId), ov.bIsEditable ? 1 : 0, ov.volt_uV, ov.voltDelta_uV.value,
-                      ov.voltDelta_uV.valueRange.min, ov.voltDelta_uV.valueRange.max);
+          Printf("      ov[%u] %s editable=%u base=%u uV delta=%d uV (min=%d max=%d)\n", v,
+                 VoltageDomainName(ov.domainId), ov.bIsEditable ? 1 : 0, ov.volt_uV, ov.voltDelta_uV.value,
+                 ov.voltDelta_uV.valueRange.min, ov.voltDelta_uV.valueRange.max);
         }
       }
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuPstates20Private(int argc, char **argv) {
@@ -208,81 +186,78 @@ int CmdGpuPstates20Private(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_PSTATES20_PRIVATE_INFO info = {};
     info.version = NV_GPU_PERF_PSTATES20_PRIVATE_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_GetPstates20Private(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetPstates20Private(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetPstates20Private failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  Pstates20 private editable=%u pstates=%u clocks=%u voltages=%u ov=%u\n", info.bIsEditable ? 1 : 0,
-                info.numPstates, info.numClocks, info.numVoltages, info.ov.numVoltages);
+    Printf("  Pstates20 private editable=%u pstates=%u clocks=%u voltages=%u ov=%u\n", info.bIsEditable ? 1 : 0,
+           info.numPstates, info.numClocks, info.numVoltages, info.ov.numVoltages);
 
     for (NvU32 p = 0; p < info.numPstates; ++p) {
       const auto &pstate = info.pstates[p];
-      std::printf("  %s editable=%u\n", PstateName(pstate.pstateId), pstate.bIsEditable ? 1 : 0);
+      Printf("  %s editable=%u\n", PstateName(pstate.pstateId), pstate.bIsEditable ? 1 : 0);
 
       for (NvU32 c = 0; c < info.numClocks; ++c) {
         const auto &clock = pstate.clocks[c];
         if (clock.domainId == NVAPI_GPU_CLOCK_DOMAIN_UNDEFINED) { continue; }
 
-        std::printf("    clock[%u] id=%u (%s) usage=%s editable=%u\n", c, clock.domainId,
-                    ClockDomainIdName(clock.domainId), ClockPstateUsageName(clock.usage), clock.bIsEditable ? 1 : 0);
+        Printf("    clock[%u] id=%u (%s) usage=%s editable=%u\n", c, clock.domainId, ClockDomainIdName(clock.domainId),
+               ClockPstateUsageName(clock.usage), clock.bIsEditable ? 1 : 0);
 
         switch (clock.usage) {
-        case NV_GPU_CLOCK_PSTATE_USAGE_FIXED: std::printf("      freq=%u kHz\n", clock.data.fixed.freq_kHz); break;
-        case NV_GPU_CLOCK_PSTATE_USAGE_PSTATE: std::printf("      freq=%u kHz\n", clock.data.pstate.freq_kHz); break;
+        case NV_GPU_CLOCK_PSTATE_USAGE_FIXED: Printf("      freq=%u kHz\n", clock.data.fixed.freq_kHz); break;
+        case NV_GPU_CLOCK_PSTATE_USAGE_PSTATE: Printf("      freq=%u kHz\n", clock.data.pstate.freq_kHz); break;
         case NV_GPU_CLOCK_PSTATE_USAGE_DECOUPLED:
-          std::printf("      freqRange=%u-%u kHz voltageDomain=%s(%u) minV=%u maxV=%u\n",
-                      clock.data.decoupled.minFreq_kHz, clock.data.decoupled.maxFreq_kHz,
-                      PerfVoltageDomainName(clock.data.decoupled.domainId), clock.data.decoupled.domainId,
-                      clock.data.decoupled.minVoltage_uV, clock.data.decoupled.maxVoltage_uV);
+          Printf("      freqRange=%u-%u kHz voltageDomain=%s(%u) minV=%u maxV=%u\n", clock.data.decoupled.minFreq_kHz,
+                 clock.data.decoupled.maxFreq_kHz, PerfVoltageDomainName(clock.data.decoupled.domainId),
+                 clock.data.decoupled.domainId, clock.data.decoupled.minVoltage_uV, clock.data.decoupled.maxVoltage_uV);
           break;
         case NV_GPU_CLOCK_PSTATE_USAGE_RATIO:
-          std::printf("      freqRange=%u-%u kHz\n", clock.data.ratio.minFreq_kHz, clock.data.ratio.maxFreq_kHz);
+          Printf("      freqRange=%u-%u kHz\n", clock.data.ratio.minFreq_kHz, clock.data.ratio.maxFreq_kHz);
           break;
         default: break;
         }
 
-        std::printf("      delta=%d kHz (min=%d max=%d)\n", clock.freqDelta_kHz.value,
-                    clock.freqDelta_kHz.valueRange.min, clock.freqDelta_kHz.valueRange.max);
+        Printf("      delta=%d kHz (min=%d max=%d)\n", clock.freqDelta_kHz.value, clock.freqDelta_kHz.valueRange.min,
+               clock.freqDelta_kHz.valueRange.max);
       }
 
       for (NvU32 v = 0; v < info.numVoltages; ++v) {
         const auto &volt = pstate.voltages[v];
         if (volt.domainId == NVAPI_GPU_PERF_VOLTAGE_DOMAIN_UNDEFINED) { continue; }
 
-        std::printf("    voltage[%u] %s(%u) type=%s editable=%u volt=%u uV delta=%d uV (min=%d max=%d)\n", v,
-                    PerfVoltageDomainName(volt.domainId), volt.domainId, VoltageEntryTypeName(volt.type),
-                    volt.bIsEditable ? 1 : 0, volt.volt_uV, volt.voltDelta_uV.value, volt.voltDelta_uV.valueRange.min,
-                    volt.voltDelta_uV.valueRange.max);
+        Printf("    voltage[%u] %s(%u) type=%s editable=%u volt=%u uV delta=%d uV (min=%d max=%d)\n", v,
+               PerfVoltageDomainName(volt.domainId), volt.domainId, VoltageEntryTypeName(volt.type),
+               volt.bIsEditable ? 1 : 0, volt.volt_uV, volt.voltDelta_uV.value, volt.voltDelta_uV.valueRange.min,
+               volt.voltDelta_uV.valueRange.max);
 
         if (volt.type == NV_GPU_PSTATE20_VOLTAGE_ENTRY_TYPE_LOGICAL) {
-          std::printf("      nominal=%u uV\n", volt.data.logical.nominal_uV);
+          Printf("      nominal=%u uV\n", volt.data.logical.nominal_uV);
         } else if (volt.type == NV_GPU_PSTATE20_VOLTAGE_ENTRY_TYPE_VDT) {
-          std::printf("      vdtIndex=%u\n", volt.data.vdt.vdtIndex);
+          Printf("      vdtIndex=%u\n", volt.data.vdt.vdtIndex);
         }
       }
 
       if (info.ov.numVoltages > 0) {
-        std::printf("    ov voltages: %u\n", info.ov.numVoltages);
+        Printf("    ov voltages: %u\n", info.ov.numVoltages);
         for (NvU32 v = 0; v < info.ov.numVoltages; ++v) {
           const auto &ov = info.ov.voltages[v];
           if (ov.domainId == NVAPI_GPU_PERF_VOLTAGE_DOMAIN_UNDEFINED) { continue; }
-          std::printf("      ov[%u] %s(%u) type=%s editable=%u volt=%u uV delta=%d uV (min=%d max=%d)\n", v,
-                      PerfVoltageDomainName(ov.domainId), ov.domainId, VoltageEntryTypeName(ov.type),
-                      ov.bIsEditable ? 1 : 0, ov.volt_uV, ov.voltDelta_uV.value, ov.voltDelta_uV.valueRange.min,
-                      ov.voltDelta_uV.valueRange.max);
+          Printf("      ov[%u] %s(%u) type=%s editable=%u volt=%u uV delta=%d uV (min=%d max=%d)\n", v,
+                 PerfVoltageDomainName(ov.domainId), ov.domainId, VoltageEntryTypeName(ov.type), ov.bIsEditable ? 1 : 0,
+                 ov.volt_uV, ov.voltDelta_uV.value, ov.voltDelta_uV.valueRange.min, ov.voltDelta_uV.valueRange.max);
         }
       }
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuPstates20PrivateSet(int argc, char **argv) {
@@ -304,7 +279,7 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index.\n");
+        Printf("Invalid GPU index.\n");
         return 1;
       }
       hasIndex = true;
@@ -313,7 +288,7 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--pstate") == 0) {
       if (i + 1 >= argc || !ParsePstateId(argv[i + 1], &pstateId)) {
-        std::printf("Invalid pstate.\n");
+        Printf("Invalid pstate.\n");
         return 1;
       }
       hasPstate = true;
@@ -323,7 +298,7 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv) {
     if (std::strcmp(argv[i], "--clock-id") == 0) {
       NvU32 value = 0;
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &value)) {
-        std::printf("Invalid clock id.\n");
+        Printf("Invalid clock id.\n");
         return 1;
       }
       clockId = static_cast<NV_GPU_CLOCK_DOMAIN_ID>(value);
@@ -333,7 +308,7 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--delta-khz") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --delta-khz\n");
+        Printf("Missing value for --delta-khz\n");
         return 1;
       }
       clockDelta = static_cast<NvS32>(std::strtol(argv[i + 1], NULL, 0));
@@ -343,7 +318,7 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--voltage-domain") == 0) {
       if (i + 1 >= argc || !ParsePerfVoltageDomainId(argv[i + 1], &voltageId)) {
-        std::printf("Invalid voltage domain.\n");
+        Printf("Invalid voltage domain.\n");
         return 1;
       }
       hasVoltage = true;
@@ -352,7 +327,7 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--delta-uv") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --delta-uv\n");
+        Printf("Missing value for --delta-uv\n");
         return 1;
       }
       voltageDelta = static_cast<NvS32>(std::strtol(argv[i + 1], NULL, 0));
@@ -362,35 +337,35 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--target-uv") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &voltageTarget)) {
-        std::printf("Invalid target voltage.\n");
+        Printf("Invalid target voltage.\n");
         return 1;
       }
       hasVoltageTarget = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasPstate) {
-    std::printf("Missing required --pstate\n");
+    Printf("Missing required --pstate\n");
     return 1;
   }
   if (hasClock != hasClockDelta) {
-    std::printf("Both --clock-id and --delta-khz are required together.\n");
+    Printf("Both --clock-id and --delta-khz are required together.\n");
     return 1;
   }
   if (hasVoltage && hasVoltageDelta && hasVoltageTarget) {
-    std::printf("Specify only one of --delta-uv or --target-uv.\n");
+    Printf("Specify only one of --delta-uv or --target-uv.\n");
     return 1;
   }
   if (hasVoltage && !hasVoltageDelta && !hasVoltageTarget) {
-    std::printf("Either --delta-uv or --target-uv is required for voltage changes.\n");
+    Printf("Either --delta-uv or --target-uv is required for voltage changes.\n");
     return 1;
   }
   if (!hasClock && !hasVoltage) {
-    std::printf("Specify at least --clock-id/--delta-khz or --voltage-domain with delta/target.\n");
+    Printf("Specify at least --clock-id/--delta-khz or --voltage-domain with delta/target.\n");
     return 1;
   }
 
@@ -398,19 +373,20 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_PSTATES20_PRIVATE_INFO info = {};
     info.version = NV_GPU_PERF_PSTATES20_PRIVATE_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_GetPstates20Private(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetPstates20Private(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetPstates20Private failed", status);
-      continue;
+      return 0;
     }
 
     NV_GPU_PSTATE20_PRIVATE_CLOCK_ENTRY_V1 *clockEntry = NULL;
     NV_GPU_PSTATE20_VOLTAGE_ENTRY_V1 *voltEntry = NULL;
+    NvS32 gpuVoltageDelta = voltageDelta;
     bool foundPstate = false;
     NvU32 pstateIndex = 0;
 
@@ -440,67 +416,65 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv) {
     }
 
     if (!foundPstate) {
-      std::printf("  Pstate not found: %s\n", PstateName(pstateId));
-      continue;
+      Printf("  Pstate not found: %s\n", PstateName(pstateId));
+      return 0;
     }
     if (hasClock && !clockEntry) {
-      std::printf("  Clock domain not found in pstate.\n");
-      continue;
+      Printf("  Clock domain not found in pstate.\n");
+      return 0;
     }
     if (hasVoltage && !voltEntry) {
-      std::printf("  Voltage domain not found in pstate.\n");
-      continue;
+      Printf("  Voltage domain not found in pstate.\n");
+      return 0;
     }
     if (!info.bIsEditable) {
-      std::printf("  Pstates20 private not editable on this GPU.\n");
-      continue;
+      Printf("  Pstates20 private not editable on this GPU.\n");
+      return 0;
     }
 
     if (clockEntry) {
       if (!clockEntry->bIsEditable) {
-        std::printf("  Clock domain not editable.\n");
-        continue;
+        Printf("  Clock domain not editable.\n");
+        return 0;
       }
       if (clockDelta < clockEntry->freqDelta_kHz.valueRange.min ||
           clockDelta > clockEntry->freqDelta_kHz.valueRange.max) {
-        std::printf("  Clock delta out of range (%d to %d kHz).\n", clockEntry->freqDelta_kHz.valueRange.min,
-                    clockEntry->freqDelta_kHz.valueRange.max);
-        continue;
+        Printf("  Clock delta out of range (%d to %d kHz).\n", clockEntry->freqDelta_kHz.valueRange.min,
+               clockEntry->freqDelta_kHz.valueRange.max);
+        return 0;
       }
       clockEntry->freqDelta_kHz.value = clockDelta;
     }
 
     if (voltEntry) {
       if (!voltEntry->bIsEditable) {
-        std::printf("  Voltage domain not editable.\n");
-        continue;
+        Printf("  Voltage domain not editable.\n");
+        return 0;
       }
       if (hasVoltageTarget) {
         long long base =
             static_cast<long long>(voltEntry->volt_uV) - static_cast<long long>(voltEntry->voltDelta_uV.value);
         long long targetDelta = static_cast<long long>(voltageTarget) - base;
-        voltageDelta = static_cast<NvS32>(targetDelta);
+        gpuVoltageDelta = static_cast<NvS32>(targetDelta);
       }
 
-      if (voltageDelta < voltEntry->voltDelta_uV.valueRange.min ||
-          voltageDelta > voltEntry->voltDelta_uV.valueRange.max) {
-        std::printf("  Voltage delta out of range (%d to %d uV).\n", voltEntry->voltDelta_uV.valueRange.min,
-                    voltEntry->voltDelta_uV.valueRange.max);
-        continue;
+      if (gpuVoltageDelta < voltEntry->voltDelta_uV.valueRange.min ||
+          gpuVoltageDelta > voltEntry->voltDelta_uV.valueRange.max) {
+        Printf("  Voltage delta out of range (%d to %d uV).\n", voltEntry->voltDelta_uV.valueRange.min,
+               voltEntry->voltDelta_uV.valueRange.max);
+        return 0;
       }
-      voltEntry->voltDelta_uV.value = voltageDelta;
+      voltEntry->voltDelta_uV.value = gpuVoltageDelta;
     }
 
-    std::printf("  Pstates20 private set request: %s\n", PstateName(pstateId));
-    if (clockEntry) {
-      std::printf("    clock id=%u (%s) delta=%d kHz\n", clockId, ClockDomainIdName(clockId), clockDelta);
-    }
+    Printf("  Pstates20 private set request: %s\n", PstateName(pstateId));
+    if (clockEntry) { Printf("    clock id=%u (%s) delta=%d kHz\n", clockId, ClockDomainIdName(clockId), clockDelta); }
     if (voltEntry) {
       if (hasVoltageTarget) {
-        std::printf("    voltage %s target=%u uV delta=%d uV\n", PerfVoltageDomainName(voltageId), voltageTarget,
-                    voltageDelta);
+        Printf("    voltage %s target=%u uV delta=%d uV\n", PerfVoltageDomainName(voltageId), voltageTarget,
+               gpuVoltageDelta);
       } else {
-        std::printf("    voltage %s delta=%d uV\n", PerfVoltageDomainName(voltageId), voltageDelta);
+        Printf("    voltage %s delta=%d uV\n", PerfVoltageDomainName(voltageId), gpuVoltageDelta);
       }
     }
 
@@ -521,15 +495,15 @@ int CmdGpuPstates20PrivateSet(int argc, char **argv) {
       if (!hasVoltage || entry.domainId != voltageId) { entry.domainId = NVAPI_GPU_PERF_VOLTAGE_DOMAIN_UNDEFINED; }
     }
 
-    status = NvAPI_GPU_SetPstates20Private(handles[i], &setInfo);
+    status = NvApi().NvAPI_GPU_SetPstates20Private(handles[i], &setInfo);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_SetPstates20Private failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  Pstates20 private updated.\n");
-  }
-  return 0;
+    Printf("  Pstates20 private updated.\n");
+    return 0;
+  });
 }
 
 int CmdGpuPstates20Set(int argc, char **argv) {
@@ -549,7 +523,7 @@ int CmdGpuPstates20Set(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index.\n");
+        Printf("Invalid GPU index.\n");
         return 1;
       }
       hasIndex = true;
@@ -558,7 +532,7 @@ int CmdGpuPstates20Set(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--pstate") == 0) {
       if (i + 1 >= argc || !ParsePstateId(argv[i + 1], &pstateId)) {
-        std::printf("Invalid pstate.\n");
+        Printf("Invalid pstate.\n");
         return 1;
       }
       hasPstate = true;
@@ -567,7 +541,7 @@ int CmdGpuPstates20Set(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--clock") == 0) {
       if (i + 1 >= argc || !ParsePublicClockId(argv[i + 1], &clockId)) {
-        std::printf("Invalid clock domain.\n");
+        Printf("Invalid clock domain.\n");
         return 1;
       }
       hasClock = true;
@@ -576,7 +550,7 @@ int CmdGpuPstates20Set(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--delta-khz") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --delta-khz\n");
+        Printf("Missing value for --delta-khz\n");
         return 1;
       }
       clockDelta = static_cast<NvS32>(std::strtol(argv[i + 1], NULL, 0));
@@ -586,7 +560,7 @@ int CmdGpuPstates20Set(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--voltage") == 0) {
       if (i + 1 >= argc || !ParseVoltageDomainId(argv[i + 1], &voltageId)) {
-        std::printf("Invalid voltage domain.\n");
+        Printf("Invalid voltage domain.\n");
         return 1;
       }
       hasVoltage = true;
@@ -595,7 +569,7 @@ int CmdGpuPstates20Set(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--delta-uv") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --delta-uv\n");
+        Printf("Missing value for --delta-uv\n");
         return 1;
       }
       voltageDelta = static_cast<NvS32>(std::strtol(argv[i + 1], NULL, 0));
@@ -603,24 +577,24 @@ int CmdGpuPstates20Set(int argc, char **argv) {
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasPstate) {
-    std::printf("Missing required --pstate\n");
+    Printf("Missing required --pstate\n");
     return 1;
   }
   if (hasClock != hasClockDelta) {
-    std::printf("Both --clock and --delta-khz are required together.\n");
+    Printf("Both --clock and --delta-khz are required together.\n");
     return 1;
   }
   if (hasVoltage != hasVoltageDelta) {
-    std::printf("Both --voltage and --delta-uv are required together.\n");
+    Printf("Both --voltage and --delta-uv are required together.\n");
     return 1;
   }
   if (!hasClock && !hasVoltage) {
-    std::printf("Specify at least --clock/--delta-khz or --voltage/--delta-uv.\n");
+    Printf("Specify at least --clock/--delta-khz or --voltage/--delta-uv.\n");
     return 1;
   }
 
@@ -628,15 +602,15 @@ int CmdGpuPstates20Set(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_PSTATES20_INFO info = {};
     info.version = NV_GPU_PERF_PSTATES20_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_GetPstates20(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetPstates20(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetPstates20 failed", status);
-      continue;
+      return 0;
     }
 
     NV_GPU_PSTATE20_CLOCK_ENTRY_V1 *clockEntry = NULL;
@@ -670,53 +644,53 @@ int CmdGpuPstates20Set(int argc, char **argv) {
     }
 
     if (!foundPstate) {
-      std::printf("  Pstate not found: %s\n", PstateName(pstateId));
-      continue;
+      Printf("  Pstate not found: %s\n", PstateName(pstateId));
+      return 0;
     }
     if (hasClock && !clockEntry) {
-      std::printf("  Clock domain not found in pstate.\n");
-      continue;
+      Printf("  Clock domain not found in pstate.\n");
+      return 0;
     }
     if (hasVoltage && !voltEntry) {
-      std::printf("  Voltage domain not found in pstate.\n");
-      continue;
+      Printf("  Voltage domain not found in pstate.\n");
+      return 0;
     }
     if (!info.bIsEditable) {
-      std::printf("  Pstates20 not editable on this GPU.\n");
-      continue;
+      Printf("  Pstates20 not editable on this GPU.\n");
+      return 0;
     }
 
     if (clockEntry) {
       if (!clockEntry->bIsEditable) {
-        std::printf("  Clock domain not editable.\n");
-        continue;
+        Printf("  Clock domain not editable.\n");
+        return 0;
       }
       if (clockDelta < clockEntry->freqDelta_kHz.valueRange.min ||
           clockDelta > clockEntry->freqDelta_kHz.valueRange.max) {
-        std::printf("  Clock delta out of range (%d to %d kHz).\n", clockEntry->freqDelta_kHz.valueRange.min,
-                    clockEntry->freqDelta_kHz.valueRange.max);
-        continue;
+        Printf("  Clock delta out of range (%d to %d kHz).\n", clockEntry->freqDelta_kHz.valueRange.min,
+               clockEntry->freqDelta_kHz.valueRange.max);
+        return 0;
       }
       clockEntry->freqDelta_kHz.value = clockDelta;
     }
 
     if (voltEntry) {
       if (!voltEntry->bIsEditable) {
-        std::printf("  Voltage domain not editable.\n");
-        continue;
+        Printf("  Voltage domain not editable.\n");
+        return 0;
       }
       if (voltageDelta < voltEntry->voltDelta_uV.valueRange.min ||
           voltageDelta > voltEntry->voltDelta_uV.valueRange.max) {
-        std::printf("  Voltage delta out of range (%d to %d uV).\n", voltEntry->voltDelta_uV.valueRange.min,
-                    voltEntry->voltDelta_uV.valueRange.max);
-        continue;
+        Printf("  Voltage delta out of range (%d to %d uV).\n", voltEntry->voltDelta_uV.valueRange.min,
+               voltEntry->voltDelta_uV.valueRange.max);
+        return 0;
       }
       voltEntry->voltDelta_uV.value = voltageDelta;
     }
 
-    std::printf("  Pstates20 set request: %s\n", PstateName(pstateId));
-    if (clockEntry) { std::printf("    clock %s delta=%d kHz\n", ClockDomainName(clockId), clockDelta); }
-    if (voltEntry) { std::printf("    voltage %s delta=%d uV\n", VoltageDomainName(voltageId), voltageDelta); }
+    Printf("  Pstates20 set request: %s\n", PstateName(pstateId));
+    if (clockEntry) { Printf("    clock %s delta=%d kHz\n", ClockDomainName(clockId), clockDelta); }
+    if (voltEntry) { Printf("    voltage %s delta=%d uV\n", VoltageDomainName(voltageId), voltageDelta); }
 
     NV_GPU_PERF_PSTATES20_INFO setInfo = {};
     setInfo.version = info.version;
@@ -736,15 +710,15 @@ int CmdGpuPstates20Set(int argc, char **argv) {
       if (!hasVoltage || entry.domainId != voltageId) { entry.domainId = NVAPI_GPU_PERF_VOLTAGE_INFO_DOMAIN_UNDEFINED; }
     }
 
-    status = NvAPI_GPU_SetPstates20(handles[i], &setInfo);
+    status = NvApi().NvAPI_GPU_SetPstates20(handles[i], &setInfo);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_SetPstates20 failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  Pstates20 updated.\n");
-  }
-  return 0;
+    Printf("  Pstates20 updated.\n");
+    return 0;
+  });
 }
 
 int CmdGpuVfTables(int argc, char **argv) {
@@ -756,22 +730,22 @@ int CmdGpuVfTables(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VF_TABLES tables = {};
     tables.version = NV_GPU_PERF_VF_TABLES_VER;
-    NvAPI_Status status = NvAPI_GPU_PerfVfTablesGetInfo(handles[i], &tables);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVfTablesGetInfo(handles[i], &tables);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVfTablesGetInfo failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  VF tables: indexes=%u entries=%u\n", tables.numIndexes, tables.numEntries);
+    Printf("  VF tables: indexes=%u entries=%u\n", tables.numIndexes, tables.numEntries);
     for (NvU32 t = 0; t < tables.numIndexes; ++t) {
       const auto &entry = tables.indexes[t];
-      std::printf("    index[%u] pstate=%s domain=%s range=%u-%u\n", t, PstateName(entry.pstateId),
-                  ClockDomainIdName(entry.domainId), entry.entryIndexFirst, entry.entryIndexLast);
+      Printf("    index[%u] pstate=%s domain=%s range=%u-%u\n", t, PstateName(entry.pstateId),
+             ClockDomainIdName(entry.domainId), entry.entryIndexFirst, entry.entryIndexLast);
     }
 
     for (NvU32 e = 0; e < tables.numEntries; ++e) {
@@ -784,17 +758,17 @@ int CmdGpuVfTables(int argc, char **argv) {
       }
 
       if (stepLabel) {
-        std::printf("    entry[%u] maxFreq=%u kHz step=%s pll=%u bypass=%u flags=0x%08X\n", e, entry.maxFreqKHz,
-                    stepLabel, entry.bForcePll ? 1 : 0, entry.bForceBypass ? 1 : 0, entry.flags);
+        Printf("    entry[%u] maxFreq=%u kHz step=%s pll=%u bypass=%u flags=0x%08X\n", e, entry.maxFreqKHz, stepLabel,
+               entry.bForcePll ? 1 : 0, entry.bForceBypass ? 1 : 0, entry.flags);
       } else {
-        std::printf("    entry[%u] maxFreq=%u kHz step=%u kHz pll=%u bypass=%u flags=0x%08X\n", e, entry.maxFreqKHz,
-                    entry.freqStepSizeKHz, entry.bForcePll ? 1 : 0, entry.bForceBypass ? 1 : 0, entry.flags);
+        Printf("    entry[%u] maxFreq=%u kHz step=%u kHz pll=%u bypass=%u flags=0x%08X\n", e, entry.maxFreqKHz,
+               entry.freqStepSizeKHz, entry.bForcePll ? 1 : 0, entry.bForceBypass ? 1 : 0, entry.flags);
       }
-      std::printf("      voltage domain=%s mV=%u vflags=0x%08X\n", PerfVoltageDomainName(entry.voltage.domainId),
-                  entry.voltage.mvolt, entry.voltage.flags);
+      Printf("      voltage domain=%s mV=%u vflags=0x%08X\n", PerfVoltageDomainName(entry.voltage.domainId),
+             entry.voltage.mvolt, entry.voltage.flags);
     }
-  }
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuVfInject(int argc, char **argv) {
@@ -817,11 +791,11 @@ int CmdGpuVfInject(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -830,11 +804,11 @@ int CmdGpuVfInject(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--clk-domain") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --clk-domain\n");
+        Printf("Missing value for --clk-domain\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &clkDomain)) {
-        std::printf("Invalid clk domain: %s\n", argv[i + 1]);
+        Printf("Invalid clk domain: %s\n", argv[i + 1]);
         return 1;
       }
       hasClkDomain = true;
@@ -843,11 +817,11 @@ int CmdGpuVfInject(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--clk-khz") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --clk-khz\n");
+        Printf("Missing value for --clk-khz\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &clkFreqKHz)) {
-        std::printf("Invalid clk-khz: %s\n", argv[i + 1]);
+        Printf("Invalid clk-khz: %s\n", argv[i + 1]);
         return 1;
       }
       hasClkFreq = true;
@@ -856,11 +830,11 @@ int CmdGpuVfInject(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--volt-domain") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --volt-domain\n");
+        Printf("Missing value for --volt-domain\n");
         return 1;
       }
       if (!ParseVoltDomainType(argv[i + 1], &voltDomain)) {
-        std::printf("Invalid volt-domain: %s\n", argv[i + 1]);
+        Printf("Invalid volt-domain: %s\n", argv[i + 1]);
         return 1;
       }
       hasVoltDomain = true;
@@ -869,11 +843,11 @@ int CmdGpuVfInject(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--volt-rail") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --volt-rail\n");
+        Printf("Missing value for --volt-rail\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &voltRail)) {
-        std::printf("Invalid volt-rail: %s\n", argv[i + 1]);
+        Printf("Invalid volt-rail: %s\n", argv[i + 1]);
         return 1;
       }
       hasVoltRail = true;
@@ -882,11 +856,11 @@ int CmdGpuVfInject(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--volt-uv") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --volt-uv\n");
+        Printf("Missing value for --volt-uv\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &voltUv)) {
-        std::printf("Invalid volt-uv: %s\n", argv[i + 1]);
+        Printf("Invalid volt-uv: %s\n", argv[i + 1]);
         return 1;
       }
       hasVoltUv = true;
@@ -895,11 +869,11 @@ int CmdGpuVfInject(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--volt-min-uv") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --volt-min-uv\n");
+        Printf("Missing value for --volt-min-uv\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &voltMinUv)) {
-        std::printf("Invalid volt-min-uv: %s\n", argv[i + 1]);
+        Printf("Invalid volt-min-uv: %s\n", argv[i + 1]);
         return 1;
       }
       hasVoltMin = true;
@@ -908,35 +882,35 @@ int CmdGpuVfInject(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--flags") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --flags\n");
+        Printf("Missing value for --flags\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &flags)) {
-        std::printf("Invalid flags: %s\n", argv[i + 1]);
+        Printf("Invalid flags: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (hasClkDomain != hasClkFreq) {
-    std::printf("Both --clk-domain and --clk-khz must be specified together.\n");
+    Printf("Both --clk-domain and --clk-khz must be specified together.\n");
     return 1;
   }
   if ((hasVoltDomain || hasVoltRail || hasVoltUv || hasVoltMin) &&
       (!hasVoltDomain || !hasVoltRail || (!hasVoltUv && !hasVoltMin))) {
-    std::printf("Voltage change requires --volt-domain, --volt-rail and at least one of --volt-uv/--volt-min-uv.\n");
+    Printf("Voltage change requires --volt-domain, --volt-rail and at least one of --volt-uv/--volt-min-uv.\n");
     return 1;
   }
   if (voltRail > 0xFF) {
-    std::printf("Volt rail index must be 0-255.\n");
+    Printf("Volt rail index must be 0-255.\n");
     return 1;
   }
   if (!hasClkDomain && !hasVoltDomain && !hasVoltUv && !hasVoltMin) {
-    std::printf("Specify at least one clock or voltage change.\n");
+    Printf("Specify at least one clock or voltage change.\n");
     return 1;
   }
 
@@ -944,7 +918,7 @@ int CmdGpuVfInject(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VF_CHANGE_INJECT_PARAMS params = {};
@@ -968,23 +942,22 @@ int CmdGpuVfInject(int argc, char **argv) {
       params.voltList.rails[0].voltageMinNoiseUnawareuV = hasVoltMin ? voltMinUv : 0;
     }
 
-    std::printf("  VF inject request: flags=0x%02X\n", params.flags);
-    if (hasClkDomain) { std::printf("    clock domain=%u freq=%u kHz\n", clkDomain, clkFreqKHz); }
+    Printf("  VF inject request: flags=0x%02X\n", params.flags);
+    if (hasClkDomain) { Printf("    clock domain=%u freq=%u kHz\n", clkDomain, clkFreqKHz); }
     if (hasVoltDomain) {
-      std::printf("    volt domain=%u rail=%u target=%u uV minNoise=%u uV\n", voltDomain, voltRail,
-                  hasVoltUv ? voltUv : 0, hasVoltMin ? voltMinUv : 0);
+      Printf("    volt domain=%u rail=%u target=%u uV minNoise=%u uV\n", voltDomain, voltRail, hasVoltUv ? voltUv : 0,
+             hasVoltMin ? voltMinUv : 0);
     }
 
-    NvAPI_Status status = NvAPI_GPU_PerfVfChangeInject(handles[i], &params);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVfChangeInject(handles[i], &params);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVfChangeInject failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  VF change injected.\n");
-  }
-
-  return 0;
+    Printf("  VF change injected.\n");
+    return 0;
+  });
 }
 
 int CmdGpuVpstatesInfo(int argc, char **argv) {
@@ -996,45 +969,44 @@ int CmdGpuVpstatesInfo(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VPSTATES_INFO info = {};
     info.version = NV_GPU_PERF_VPSTATES_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_PerfVpstatesGetInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVpstatesGetInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVpstatesGetInfo failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  VPSTATES info:\n");
+    Printf("  VPSTATES info:\n");
     for (NvU32 v = 0; v < NV_GPU_PERF_VPSTATE_MAX_V1; ++v) {
       if (!MaskE255Has(info.vpstatesMask, v)) { continue; }
 
       const auto &vp = info.vpstates[v];
-      std::printf("  VPSTATE[%u] type=%s\n", v, VpstateTypeName(vp.type));
+      Printf("  VPSTATE[%u] type=%s\n", v, VpstateTypeName(vp.type));
 
       if (vp.type == NV_GPU_PERF_VPSTATE_TYPE_2X) {
-        std::printf("    vPstateNum=%u reqPower=%u reqSlowdown=%u\n", vp.data.v2x.vPstateNum, vp.data.v2x.reqPower10mW,
-                    vp.data.v2x.reqSlowdownPower10mW);
+        Printf("    vPstateNum=%u reqPower=%u reqSlowdown=%u\n", vp.data.v2x.vPstateNum, vp.data.v2x.reqPower10mW,
+               vp.data.v2x.reqSlowdownPower10mW);
         for (NvU32 g = 0; g < NV_GPU_PERF_VPSTATE_2X_DOMAIN_GROUP_NUM; ++g) {
-          std::printf("    group[%u]=%u\n", g, vp.data.v2x.value[g]);
+          Printf("    group[%u]=%u\n", g, vp.data.v2x.value[g]);
         }
       } else if (vp.type == NV_GPU_PERF_VPSTATE_TYPE_3X) {
-        std::printf("    pstateIdx=%u\n", vp.data.v3x.pstateIdx);
+        Printf("    pstateIdx=%u\n", vp.data.v3x.pstateIdx);
         bool anyClock = false;
         for (NvU32 c = 0; c < NV_GPU_CLOCK_CLK_DOMAINS_MAX_V1; ++c) {
           const auto &clock = vp.data.v3x.clocks[c];
           if (clock.targetFreqMHz == 0 && clock.minEffFreqMHz == 0) { continue; }
           anyClock = true;
-          std::printf("    clock[%u] target=%u MHz minEff=%u MHz\n", c, clock.targetFreqMHz, clock.minEffFreqMHz);
+          Printf("    clock[%u] target=%u MHz minEff=%u MHz\n", c, clock.targetFreqMHz, clock.minEffFreqMHz);
         }
-        if (!anyClock) { std::printf("    clocks: none\n"); }
+        if (!anyClock) { Printf("    clocks: none\n"); }
       }
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuVpstatesControl(int argc, char **argv) {
@@ -1045,11 +1017,11 @@ int CmdGpuVpstatesControl(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -1060,7 +1032,7 @@ int CmdGpuVpstatesControl(int argc, char **argv) {
       original = true;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -1068,43 +1040,42 @@ int CmdGpuVpstatesControl(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VPSTATES_CONTROL control = {};
     control.version = NV_GPU_PERF_VPSTATES_CONTROL_VER;
     control.bOriginal = original ? NV_TRUE : NV_FALSE;
-    NvAPI_Status status = NvAPI_GPU_PerfVpstatesGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVpstatesGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVpstatesGetControl failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  VPSTATES control (original=%u):\n", control.bOriginal ? 1 : 0);
+    Printf("  VPSTATES control (original=%u):\n", control.bOriginal ? 1 : 0);
     for (NvU32 v = 0; v < NV_GPU_PERF_VPSTATE_MAX_V1; ++v) {
       if (!MaskE255Has(control.vpstatesMask, v)) { continue; }
 
       const auto &vp = control.vpstates[v];
-      std::printf("  VPSTATE[%u] type=%s\n", v, VpstateTypeName(vp.type));
+      Printf("  VPSTATE[%u] type=%s\n", v, VpstateTypeName(vp.type));
       if (vp.type == NV_GPU_PERF_VPSTATE_TYPE_2X) {
         for (NvU32 g = 0; g < NV_GPU_PERF_VPSTATE_2X_DOMAIN_GROUP_NUM; ++g) {
-          std::printf("    group[%u]=%u\n", g, vp.data.v2x.value[g]);
+          Printf("    group[%u]=%u\n", g, vp.data.v2x.value[g]);
         }
       } else if (vp.type == NV_GPU_PERF_VPSTATE_TYPE_3X) {
-        std::printf("    pstateIdx=%u\n", vp.data.v3x.pstateIdx);
+        Printf("    pstateIdx=%u\n", vp.data.v3x.pstateIdx);
         bool anyClock = false;
         for (NvU32 c = 0; c < NV_GPU_CLOCK_CLK_DOMAINS_MAX_V1; ++c) {
           const auto &clock = vp.data.v3x.clocks[c];
           if (clock.targetFreqMHz == 0 && clock.minEffFreqMHz == 0) { continue; }
           anyClock = true;
-          std::printf("    clock[%u] target=%u MHz minEff=%u MHz\n", c, clock.targetFreqMHz, clock.minEffFreqMHz);
+          Printf("    clock[%u] target=%u MHz minEff=%u MHz\n", c, clock.targetFreqMHz, clock.minEffFreqMHz);
         }
-        if (!anyClock) { std::printf("    clocks: none\n"); }
+        if (!anyClock) { Printf("    clocks: none\n"); }
       }
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuVpstatesSet(int argc, char **argv) {
@@ -1126,11 +1097,11 @@ int CmdGpuVpstatesSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -1139,11 +1110,11 @@ int CmdGpuVpstatesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--vpstate") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --vpstate\n");
+        Printf("Missing value for --vpstate\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &vpstateIndex)) {
-        std::printf("Invalid vpstate index: %s\n", argv[i + 1]);
+        Printf("Invalid vpstate index: %s\n", argv[i + 1]);
         return 1;
       }
       hasVpstate = true;
@@ -1152,11 +1123,11 @@ int CmdGpuVpstatesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--clock") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --clock\n");
+        Printf("Missing value for --clock\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &clockIndex)) {
-        std::printf("Invalid clock index: %s\n", argv[i + 1]);
+        Printf("Invalid clock index: %s\n", argv[i + 1]);
         return 1;
       }
       hasClock = true;
@@ -1165,11 +1136,11 @@ int CmdGpuVpstatesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--target-mhz") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --target-mhz\n");
+        Printf("Missing value for --target-mhz\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &targetMHz)) {
-        std::printf("Invalid target-mhz: %s\n", argv[i + 1]);
+        Printf("Invalid target-mhz: %s\n", argv[i + 1]);
         return 1;
       }
       hasTarget = true;
@@ -1178,11 +1149,11 @@ int CmdGpuVpstatesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--min-eff-mhz") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --min-eff-mhz\n");
+        Printf("Missing value for --min-eff-mhz\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &minEffMHz)) {
-        std::printf("Invalid min-eff-mhz: %s\n", argv[i + 1]);
+        Printf("Invalid min-eff-mhz: %s\n", argv[i + 1]);
         return 1;
       }
       hasMinEff = true;
@@ -1191,11 +1162,11 @@ int CmdGpuVpstatesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--group") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --group\n");
+        Printf("Missing value for --group\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &groupIndex)) {
-        std::printf("Invalid group index: %s\n", argv[i + 1]);
+        Printf("Invalid group index: %s\n", argv[i + 1]);
         return 1;
       }
       hasGroup = true;
@@ -1204,46 +1175,46 @@ int CmdGpuVpstatesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--value") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --value\n");
+        Printf("Missing value for --value\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &groupValue)) {
-        std::printf("Invalid value: %s\n", argv[i + 1]);
+        Printf("Invalid value: %s\n", argv[i + 1]);
         return 1;
       }
       hasValue = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasVpstate) {
-    std::printf("Missing required --vpstate\n");
+    Printf("Missing required --vpstate\n");
     return 1;
   }
 
   const bool usesClock = hasClock || hasTarget || hasMinEff;
   const bool usesGroup = hasGroup || hasValue;
   if (usesClock == usesGroup) {
-    std::printf("Specify either clock parameters (--clock/--target-mhz) or group parameters (--group/--value).\n");
+    Printf("Specify either clock parameters (--clock/--target-mhz) or group parameters (--group/--value).\n");
     return 1;
   }
   if (usesClock && (!hasClock || !hasTarget)) {
-    std::printf("Clock updates require --clock and --target-mhz.\n");
+    Printf("Clock updates require --clock and --target-mhz.\n");
     return 1;
   }
   if (usesGroup && (!hasGroup || !hasValue)) {
-    std::printf("Group updates require --group and --value.\n");
+    Printf("Group updates require --group and --value.\n");
     return 1;
   }
   if (hasTarget && targetMHz > 0xFFFF) {
-    std::printf("target-mhz must be <= 65535.\n");
+    Printf("target-mhz must be <= 65535.\n");
     return 1;
   }
   if (hasMinEff && minEffMHz > 0xFFFF) {
-    std::printf("min-eff-mhz must be <= 65535.\n");
+    Printf("min-eff-mhz must be <= 65535.\n");
     return 1;
   }
 
@@ -1251,59 +1222,58 @@ int CmdGpuVpstatesSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VPSTATES_CONTROL control = {};
     control.version = NV_GPU_PERF_VPSTATES_CONTROL_VER;
     control.bOriginal = NV_FALSE;
-    NvAPI_Status status = NvAPI_GPU_PerfVpstatesGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVpstatesGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVpstatesGetControl failed", status);
-      continue;
+      return 0;
     }
 
     if (!MaskE255Has(control.vpstatesMask, vpstateIndex)) {
-      std::printf("  VPSTATE index not present: %u\n", vpstateIndex);
-      continue;
+      Printf("  VPSTATE index not present: %u\n", vpstateIndex);
+      return 0;
     }
 
     auto &vp = control.vpstates[vpstateIndex];
     if (usesClock) {
       if (vp.type != NV_GPU_PERF_VPSTATE_TYPE_3X) {
-        std::printf("  VPSTATE[%u] is not 3X.\n", vpstateIndex);
-        continue;
+        Printf("  VPSTATE[%u] is not 3X.\n", vpstateIndex);
+        return 0;
       }
       if (clockIndex >= NV_GPU_CLOCK_CLK_DOMAINS_MAX_V1) {
-        std::printf("  Clock index out of range.\n");
-        continue;
+        Printf("  Clock index out of range.\n");
+        return 0;
       }
       vp.data.v3x.clocks[clockIndex].targetFreqMHz = static_cast<NvU16>(targetMHz);
       if (hasMinEff) { vp.data.v3x.clocks[clockIndex].minEffFreqMHz = static_cast<NvU16>(minEffMHz); }
-      std::printf("  VPSTATE set request: vpstate=%u clock=%u target=%u MHz minEff=%u MHz\n", vpstateIndex, clockIndex,
-                  vp.data.v3x.clocks[clockIndex].targetFreqMHz, vp.data.v3x.clocks[clockIndex].minEffFreqMHz);
+      Printf("  VPSTATE set request: vpstate=%u clock=%u target=%u MHz minEff=%u MHz\n", vpstateIndex, clockIndex,
+             vp.data.v3x.clocks[clockIndex].targetFreqMHz, vp.data.v3x.clocks[clockIndex].minEffFreqMHz);
     } else {
       if (vp.type != NV_GPU_PERF_VPSTATE_TYPE_2X) {
-        std::printf("  VPSTATE[%u] is not 2X.\n", vpstateIndex);
-        continue;
+        Printf("  VPSTATE[%u] is not 2X.\n", vpstateIndex);
+        return 0;
       }
       if (groupIndex >= NV_GPU_PERF_VPSTATE_2X_DOMAIN_GROUP_NUM) {
-        std::printf("  Group index out of range.\n");
-        continue;
+        Printf("  Group index out of range.\n");
+        return 0;
       }
       vp.data.v2x.value[groupIndex] = groupValue;
-      std::printf("  VPSTATE set request: vpstate=%u group=%u value=%u\n", vpstateIndex, groupIndex, groupValue);
+      Printf("  VPSTATE set request: vpstate=%u group=%u value=%u\n", vpstateIndex, groupIndex, groupValue);
     }
 
-    status = NvAPI_GPU_PerfVpstatesSetControl(handles[i], &control);
+    status = NvApi().NvAPI_GPU_PerfVpstatesSetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVpstatesSetControl failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  VPSTATE updated.\n");
-  }
-
-  return 0;
+    Printf("  VPSTATE updated.\n");
+    return 0;
+  });
 }
 
 int CmdGpuVfeVarsInfo(int argc, char **argv) {
@@ -1315,44 +1285,43 @@ int CmdGpuVfeVarsInfo(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VFE_VARS_INFO info = {};
     info.version = NV_GPU_PERF_VFE_VARS_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_PerfVfeVarGetInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVfeVarGetInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVfeVarGetInfo failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  VFE vars info:\n");
+    Printf("  VFE vars info:\n");
     for (NvU32 v = 0; v < NV_GPU_PERF_VFE_VAR_MAX_V1; ++v) {
       if (!MaskE32Has(info.varsMask, v)) { continue; }
 
       const auto &var = info.vars[v];
-      std::printf("  VAR[%u] type=%s\n", v, VfeVarTypeName(var.type));
+      Printf("  VAR[%u] type=%s\n", v, VfeVarTypeName(var.type));
 
       if (var.type == NV_GPU_PERF_VFE_VAR_TYPE_DERIVED_PRODUCT) {
-        std::printf("    product varIdx0=%u varIdx1=%u\n", var.data.derivedProd.varIdx0, var.data.derivedProd.varIdx1);
+        Printf("    product varIdx0=%u varIdx1=%u\n", var.data.derivedProd.varIdx0, var.data.derivedProd.varIdx1);
       } else if (var.type == NV_GPU_PERF_VFE_VAR_TYPE_DERIVED_SUM) {
-        std::printf("    sum varIdx0=%u varIdx1=%u\n", var.data.derivedSum.varIdx0, var.data.derivedSum.varIdx1);
+        Printf("    sum varIdx0=%u varIdx1=%u\n", var.data.derivedSum.varIdx0, var.data.derivedSum.varIdx1);
       } else if (var.type == NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_TEMP) {
-        std::printf("    thermChannelIndex=%u\n", var.data.sensedTemp.thermChannelIndex);
+        Printf("    thermChannelIndex=%u\n", var.data.sensedTemp.thermChannelIndex);
       } else if (var.type == NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE_BASE) {
-        std::printf("    fuseVersion=%u fuseValue=%u fuseHw=%u\n", var.data.sensedFuseBase.fuseVersion,
-                    var.data.sensedFuseBase.fuseValueInteger, var.data.sensedFuseBase.fuseValueHwInteger);
+        Printf("    fuseVersion=%u fuseValue=%u fuseHw=%u\n", var.data.sensedFuseBase.fuseVersion,
+               var.data.sensedFuseBase.fuseValueInteger, var.data.sensedFuseBase.fuseValueHwInteger);
       } else if (var.type == NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE) {
-        std::printf("    fuseVersion=%u fuseValue=%u fuseHw=%u\n", var.data.sensedFuse.super.fuseVersion,
-                    var.data.sensedFuse.super.fuseValueInteger, var.data.sensedFuse.super.fuseValueHwInteger);
+        Printf("    fuseVersion=%u fuseValue=%u fuseHw=%u\n", var.data.sensedFuse.super.fuseVersion,
+               var.data.sensedFuse.super.fuseValueInteger, var.data.sensedFuse.super.fuseValueHwInteger);
       } else if (var.type == NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE_20) {
-        std::printf("    fuseVersion=%u fuseValue=%u fuseHw=%u\n", var.data.sensedFuse20.super.fuseVersion,
-                    var.data.sensedFuse20.super.fuseValueInteger, var.data.sensedFuse20.super.fuseValueHwInteger);
+        Printf("    fuseVersion=%u fuseValue=%u fuseHw=%u\n", var.data.sensedFuse20.super.fuseVersion,
+               var.data.sensedFuse20.super.fuseValueInteger, var.data.sensedFuse20.super.fuseValueHwInteger);
       }
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuVfeVarsControl(int argc, char **argv) {
@@ -1364,37 +1333,36 @@ int CmdGpuVfeVarsControl(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VFE_VARS_CONTROL control = {};
     control.version = NV_GPU_PERF_VFE_VARS_CONTROL_VER;
-    NvAPI_Status status = NvAPI_GPU_PerfVfeVarGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVfeVarGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVfeVarGetControl failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  VFE vars control (polling=%ums):\n", control.pollingPeriodms);
+    Printf("  VFE vars control (polling=%ums):\n", control.pollingPeriodms);
     for (NvU32 v = 0; v < NV_GPU_PERF_VFE_VAR_MAX_V1; ++v) {
       if (!MaskE32Has(control.varsMask, v)) { continue; }
 
       const auto &var = control.vars[v];
-      std::printf("  VAR[%u] type=%s range=%g-%g\n", v, VfeVarTypeName(var.type), var.outRangeMin, var.outRangeMax);
+      Printf("  VAR[%u] type=%s range=%g-%g\n", v, VfeVarTypeName(var.type), var.outRangeMin, var.outRangeMax);
 
       const NV_GPU_PERF_VFE_VAR_CONTROL_SINGLE *single = GetVfeVarSingleControl(var);
       if (single) {
-        std::printf("    override=%s value=%g\n", VfeVarOverrideTypeName(single->overrideType), single->overrideValue);
+        Printf("    override=%s value=%g\n", VfeVarOverrideTypeName(single->overrideType), single->overrideValue);
       }
 
       if (var.type == NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_TEMP) {
-        std::printf("    tempHystPos=%d tempHystNeg=%d\n", var.data.sensedTemp.tempHysteresisPositive,
-                    var.data.sensedTemp.tempHysteresisNegative);
+        Printf("    tempHystPos=%d tempHystNeg=%d\n", var.data.sensedTemp.tempHysteresisPositive,
+               var.data.sensedTemp.tempHysteresisNegative);
       }
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuVfeVarsSet(int argc, char **argv) {
@@ -1415,11 +1383,11 @@ int CmdGpuVfeVarsSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -1428,11 +1396,11 @@ int CmdGpuVfeVarsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--var") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --var\n");
+        Printf("Missing value for --var\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &varIndex)) {
-        std::printf("Invalid var index: %s\n", argv[i + 1]);
+        Printf("Invalid var index: %s\n", argv[i + 1]);
         return 1;
       }
       hasVar = true;
@@ -1441,11 +1409,11 @@ int CmdGpuVfeVarsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--override-type") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --override-type\n");
+        Printf("Missing value for --override-type\n");
         return 1;
       }
       if (!ParseVfeVarOverrideType(argv[i + 1], &overrideType)) {
-        std::printf("Invalid override-type: %s\n", argv[i + 1]);
+        Printf("Invalid override-type: %s\n", argv[i + 1]);
         return 1;
       }
       hasOverrideType = true;
@@ -1454,11 +1422,11 @@ int CmdGpuVfeVarsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--override-value") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --override-value\n");
+        Printf("Missing value for --override-value\n");
         return 1;
       }
       if (!ParseFloat(argv[i + 1], &overrideValue)) {
-        std::printf("Invalid override-value: %s\n", argv[i + 1]);
+        Printf("Invalid override-value: %s\n", argv[i + 1]);
         return 1;
       }
       hasOverrideValue = true;
@@ -1467,11 +1435,11 @@ int CmdGpuVfeVarsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--temp-hyst-pos") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --temp-hyst-pos\n");
+        Printf("Missing value for --temp-hyst-pos\n");
         return 1;
       }
       if (!ParseInt(argv[i + 1], &tempHystPos)) {
-        std::printf("Invalid temp-hyst-pos: %s\n", argv[i + 1]);
+        Printf("Invalid temp-hyst-pos: %s\n", argv[i + 1]);
         return 1;
       }
       hasTempHystPos = true;
@@ -1480,27 +1448,27 @@ int CmdGpuVfeVarsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--temp-hyst-neg") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --temp-hyst-neg\n");
+        Printf("Missing value for --temp-hyst-neg\n");
         return 1;
       }
       if (!ParseInt(argv[i + 1], &tempHystNeg)) {
-        std::printf("Invalid temp-hyst-neg: %s\n", argv[i + 1]);
+        Printf("Invalid temp-hyst-neg: %s\n", argv[i + 1]);
         return 1;
       }
       hasTempHystNeg = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasVar || !hasOverrideType) {
-    std::printf("Missing required --var and --override-type.\n");
+    Printf("Missing required --var and --override-type.\n");
     return 1;
   }
   if (overrideType != NV_GPU_PERF_VFE_VAR_SINGLE_OVERRIDE_TYPE_NONE && !hasOverrideValue) {
-    std::printf("override-value is required when override-type is not none.\n");
+    Printf("override-value is required when override-type is not none.\n");
     return 1;
   }
 
@@ -1508,27 +1476,27 @@ int CmdGpuVfeVarsSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VFE_VARS_CONTROL control = {};
     control.version = NV_GPU_PERF_VFE_VARS_CONTROL_VER;
-    NvAPI_Status status = NvAPI_GPU_PerfVfeVarGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVfeVarGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVfeVarGetControl failed", status);
-      continue;
+      return 0;
     }
 
     if (varIndex >= NV_GPU_PERF_VFE_VAR_MAX_V1 || !MaskE32Has(control.varsMask, varIndex)) {
-      std::printf("  Var index not present: %u\n", varIndex);
-      continue;
+      Printf("  Var index not present: %u\n", varIndex);
+      return 0;
     }
 
     auto &var = control.vars[varIndex];
     NV_GPU_PERF_VFE_VAR_CONTROL_SINGLE *single = GetVfeVarSingleControl(var);
     if (!single) {
-      std::printf("  Var[%u] type %s does not support overrides.\n", varIndex, VfeVarTypeName(var.type));
-      continue;
+      Printf("  Var[%u] type %s does not support overrides.\n", varIndex, VfeVarTypeName(var.type));
+      return 0;
     }
 
     single->overrideType = overrideType;
@@ -1536,26 +1504,25 @@ int CmdGpuVfeVarsSet(int argc, char **argv) {
 
     if (hasTempHystPos || hasTempHystNeg) {
       if (var.type != NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_TEMP) {
-        std::printf("  Var[%u] is not a sensed temperature variable.\n", varIndex);
-        continue;
+        Printf("  Var[%u] is not a sensed temperature variable.\n", varIndex);
+        return 0;
       }
       if (hasTempHystPos) { var.data.sensedTemp.tempHysteresisPositive = tempHystPos; }
       if (hasTempHystNeg) { var.data.sensedTemp.tempHysteresisNegative = tempHystNeg; }
     }
 
-    std::printf("  VFE var set request: var=%u override=%s value=%g\n", varIndex,
-                VfeVarOverrideTypeName(single->overrideType), single->overrideValue);
+    Printf("  VFE var set request: var=%u override=%s value=%g\n", varIndex,
+           VfeVarOverrideTypeName(single->overrideType), single->overrideValue);
 
-    status = NvAPI_GPU_PerfVfeVarSetControl(handles[i], &control);
+    status = NvApi().NvAPI_GPU_PerfVfeVarSetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVfeVarSetControl failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  VFE var updated.\n");
-  }
-
-  return 0;
+    Printf("  VFE var updated.\n");
+    return 0;
+  });
 }
 
 int CmdGpuVfeEqusInfo(int argc, char **argv) {
@@ -1567,27 +1534,26 @@ int CmdGpuVfeEqusInfo(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VFE_EQUS_INFO info = {};
     info.version = NV_GPU_PERF_VFE_EQUS_INFO_VER;
-    NvAPI_Status status = NvAPI_GPU_PerfVfeEquGetInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVfeEquGetInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVfeEquGetInfo failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  VFE equations info:\n");
+    Printf("  VFE equations info:\n");
     for (NvU32 e = 0; e < NV_GPU_PERF_VFE_EQU_MAX_V1; ++e) {
       if (!MaskE255Has(info.equsMask, e)) { continue; }
       const auto &equ = info.equs[e];
-      std::printf("  EQU[%u] type=%s varIdx=%u next=%u output=%s\n", e, VfeEquTypeName(equ.type), equ.varIdx,
-                  equ.equIdxNext, VfeEquOutputTypeName(equ.outputType));
+      Printf("  EQU[%u] type=%s varIdx=%u next=%u output=%s\n", e, VfeEquTypeName(equ.type), equ.varIdx, equ.equIdxNext,
+             VfeEquOutputTypeName(equ.outputType));
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuVfeEqusControl(int argc, char **argv) {
@@ -1599,37 +1565,36 @@ int CmdGpuVfeEqusControl(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VFE_EQUS_CONTROL control = {};
     control.version = NV_GPU_PERF_VFE_EQUS_CONTROL_VER;
-    NvAPI_Status status = NvAPI_GPU_PerfVfeEquGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVfeEquGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVfeEquGetControl failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  VFE equations control:\n");
+    Printf("  VFE equations control:\n");
     for (NvU32 e = 0; e < NV_GPU_PERF_VFE_EQU_MAX_V1; ++e) {
       if (!MaskE255Has(control.equsMask, e)) { continue; }
 
       const auto &equ = control.equs[e];
-      std::printf("  EQU[%u] type=%s range=%g-%g\n", e, VfeEquTypeName(equ.type), equ.outRangeMin, equ.outRangeMax);
+      Printf("  EQU[%u] type=%s range=%g-%g\n", e, VfeEquTypeName(equ.type), equ.outRangeMin, equ.outRangeMax);
 
       if (equ.type == NV_GPU_PERF_VFE_EQU_TYPE_COMPARE) {
-        std::printf("    compare func=%s crit=%g\n", VfeEquCompareFuncName(equ.data.compare.funcId),
-                    equ.data.compare.criteria);
+        Printf("    compare func=%s crit=%g\n", VfeEquCompareFuncName(equ.data.compare.funcId),
+               equ.data.compare.criteria);
       } else if (equ.type == NV_GPU_PERF_VFE_EQU_TYPE_MINMAX) {
-        std::printf("    minmax=%s\n", equ.data.minmax.bMax ? "max" : "min");
+        Printf("    minmax=%s\n", equ.data.minmax.bMax ? "max" : "min");
       } else if (equ.type == NV_GPU_PERF_VFE_EQU_TYPE_QUADRATIC) {
-        std::printf("    coeffs=%g,%g,%g\n", equ.data.quadratic.coeffs[0], equ.data.quadratic.coeffs[1],
-                    equ.data.quadratic.coeffs[2]);
+        Printf("    coeffs=%g,%g,%g\n", equ.data.quadratic.coeffs[0], equ.data.quadratic.coeffs[1],
+               equ.data.quadratic.coeffs[2]);
       }
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuVfeEqusSet(int argc, char **argv) {
@@ -1652,11 +1617,11 @@ int CmdGpuVfeEqusSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -1665,11 +1630,11 @@ int CmdGpuVfeEqusSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--equ") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --equ\n");
+        Printf("Missing value for --equ\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &equIndex)) {
-        std::printf("Invalid equ index: %s\n", argv[i + 1]);
+        Printf("Invalid equ index: %s\n", argv[i + 1]);
         return 1;
       }
       hasEqu = true;
@@ -1678,11 +1643,11 @@ int CmdGpuVfeEqusSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--compare-func") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --compare-func\n");
+        Printf("Missing value for --compare-func\n");
         return 1;
       }
       if (!ParseVfeEquCompareFunc(argv[i + 1], &compareFunc)) {
-        std::printf("Invalid compare-func: %s\n", argv[i + 1]);
+        Printf("Invalid compare-func: %s\n", argv[i + 1]);
         return 1;
       }
       hasCompare = true;
@@ -1691,11 +1656,11 @@ int CmdGpuVfeEqusSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--compare-crit") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --compare-crit\n");
+        Printf("Missing value for --compare-crit\n");
         return 1;
       }
       if (!ParseFloat(argv[i + 1], &compareCrit)) {
-        std::printf("Invalid compare-crit: %s\n", argv[i + 1]);
+        Printf("Invalid compare-crit: %s\n", argv[i + 1]);
         return 1;
       }
       hasCompareCrit = true;
@@ -1704,7 +1669,7 @@ int CmdGpuVfeEqusSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--minmax") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --minmax\n");
+        Printf("Missing value for --minmax\n");
         return 1;
       }
       if (std::strcmp(argv[i + 1], "min") == 0) {
@@ -1712,7 +1677,7 @@ int CmdGpuVfeEqusSet(int argc, char **argv) {
       } else if (std::strcmp(argv[i + 1], "max") == 0) {
         minMaxIsMax = 1;
       } else {
-        std::printf("Invalid minmax: %s\n", argv[i + 1]);
+        Printf("Invalid minmax: %s\n", argv[i + 1]);
         return 1;
       }
       hasMinMax = true;
@@ -1721,33 +1686,33 @@ int CmdGpuVfeEqusSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--coeffs") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --coeffs\n");
+        Printf("Missing value for --coeffs\n");
         return 1;
       }
       if (!ParseCsvFloat3(argv[i + 1], coeffs)) {
-        std::printf("Invalid coeffs: %s\n", argv[i + 1]);
+        Printf("Invalid coeffs: %s\n", argv[i + 1]);
         return 1;
       }
       hasCoeffs = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasEqu) {
-    std::printf("Missing required --equ\n");
+    Printf("Missing required --equ\n");
     return 1;
   }
 
   const int modeCount = (hasCompare ? 1 : 0) + (hasMinMax ? 1 : 0) + (hasCoeffs ? 1 : 0);
   if (modeCount != 1) {
-    std::printf("Specify exactly one of --compare-func/--compare-crit, --minmax, or --coeffs.\n");
+    Printf("Specify exactly one of --compare-func/--compare-crit, --minmax, or --coeffs.\n");
     return 1;
   }
   if (hasCompare && !hasCompareCrit) {
-    std::printf("--compare-crit is required with --compare-func.\n");
+    Printf("--compare-crit is required with --compare-func.\n");
     return 1;
   }
 
@@ -1755,60 +1720,59 @@ int CmdGpuVfeEqusSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_VFE_EQUS_CONTROL control = {};
     control.version = NV_GPU_PERF_VFE_EQUS_CONTROL_VER;
-    NvAPI_Status status = NvAPI_GPU_PerfVfeEquGetControl(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVfeEquGetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVfeEquGetControl failed", status);
-      continue;
+      return 0;
     }
 
     if (equIndex >= NV_GPU_PERF_VFE_EQU_MAX_V1 || !MaskE255Has(control.equsMask, equIndex)) {
-      std::printf("  EQU index not present: %u\n", equIndex);
-      continue;
+      Printf("  EQU index not present: %u\n", equIndex);
+      return 0;
     }
 
     auto &equ = control.equs[equIndex];
     if (hasCompare) {
       if (equ.type != NV_GPU_PERF_VFE_EQU_TYPE_COMPARE) {
-        std::printf("  EQU[%u] type is not COMPARE.\n", equIndex);
-        continue;
+        Printf("  EQU[%u] type is not COMPARE.\n", equIndex);
+        return 0;
       }
       equ.data.compare.funcId = compareFunc;
       equ.data.compare.criteria = compareCrit;
-      std::printf("  VFE equ set request: equ=%u compare=%s crit=%g\n", equIndex, VfeEquCompareFuncName(compareFunc),
-                  compareCrit);
+      Printf("  VFE equ set request: equ=%u compare=%s crit=%g\n", equIndex, VfeEquCompareFuncName(compareFunc),
+             compareCrit);
     } else if (hasMinMax) {
       if (equ.type != NV_GPU_PERF_VFE_EQU_TYPE_MINMAX) {
-        std::printf("  EQU[%u] type is not MINMAX.\n", equIndex);
-        continue;
+        Printf("  EQU[%u] type is not MINMAX.\n", equIndex);
+        return 0;
       }
       equ.data.minmax.bMax = minMaxIsMax;
-      std::printf("  VFE equ set request: equ=%u minmax=%s\n", equIndex, minMaxIsMax ? "max" : "min");
+      Printf("  VFE equ set request: equ=%u minmax=%s\n", equIndex, minMaxIsMax ? "max" : "min");
     } else if (hasCoeffs) {
       if (equ.type != NV_GPU_PERF_VFE_EQU_TYPE_QUADRATIC) {
-        std::printf("  EQU[%u] type is not QUADRATIC.\n", equIndex);
-        continue;
+        Printf("  EQU[%u] type is not QUADRATIC.\n", equIndex);
+        return 0;
       }
       equ.data.quadratic.coeffs[0] = coeffs[0];
       equ.data.quadratic.coeffs[1] = coeffs[1];
       equ.data.quadratic.coeffs[2] = coeffs[2];
-      std::printf("  VFE equ set request: equ=%u coeffs=%g,%g,%g\n", equIndex, coeffs[0], coeffs[1], coeffs[2]);
+      Printf("  VFE equ set request: equ=%u coeffs=%g,%g,%g\n", equIndex, coeffs[0], coeffs[1], coeffs[2]);
     }
 
-    status = NvAPI_GPU_PerfVfeEquSetControl(handles[i], &control);
+    status = NvApi().NvAPI_GPU_PerfVfeEquSetControl(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfVfeEquSetControl failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  VFE equation updated.\n");
-  }
-
-  return 0;
+    Printf("  VFE equation updated.\n");
+    return 0;
+  });
 }
 
 int CmdGpuVf(int argc, char **argv) {
@@ -1822,7 +1786,9 @@ int CmdGpuVf(int argc, char **argv) {
   }
   if (std::strcmp(argv[0], "tables") == 0) { return CmdGpuVfTables(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "inject") == 0) { return CmdGpuVfInject(argc - 1, argv + 1); }
-  std::printf("Unknown vf subcommand: %s\n", argv[0]);
+  if (std::strcmp(argv[0], "curve") == 0) { return CmdGpuVfCurve(argc - 1, argv + 1); }
+  if (std::strcmp(argv[0], "compare") == 0) { return CmdGpuVfCompare(argc - 1, argv + 1); }
+  Printf("Unknown vf subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -1838,7 +1804,7 @@ int CmdGpuVpstates(int argc, char **argv) {
   if (std::strcmp(argv[0], "info") == 0) { return CmdGpuVpstatesInfo(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "control") == 0) { return CmdGpuVpstatesControl(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdGpuVpstatesSet(argc - 1, argv + 1); }
-  std::printf("Unknown vpstates subcommand: %s\n", argv[0]);
+  Printf("Unknown vpstates subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -1854,7 +1820,7 @@ int CmdGpuVfeVar(int argc, char **argv) {
   if (std::strcmp(argv[0], "info") == 0) { return CmdGpuVfeVarsInfo(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "control") == 0) { return CmdGpuVfeVarsControl(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdGpuVfeVarsSet(argc - 1, argv + 1); }
-  std::printf("Unknown vfe-var subcommand: %s\n", argv[0]);
+  Printf("Unknown vfe-var subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -1870,10 +1836,25 @@ int CmdGpuVfeEqu(int argc, char **argv) {
   if (std::strcmp(argv[0], "info") == 0) { return CmdGpuVfeEqusInfo(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "control") == 0) { return CmdGpuVfeEqusControl(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdGpuVfeEqusSet(argc - 1, argv + 1); }
-  std::printf("Unknown vfe-equ subcommand: %s\n", argv[0]);
+  if (std::strcmp(argv[0], "eval") == 0) { return CmdGpuVfeEqusEval(argc - 1, argv + 1); }
+  Printf("Unknown vfe-equ subcommand: %s\n", argv[0]);
   return 1;
 }
 
+NvAPI_Status LoadPerfLimitNames(NvPhysicalGpuHandle handle, std::unordered_map<NvU32, std::string> *names) {
+  std::unique_ptr<NV_GPU_PERF_LIMITS_INFO> info(new NV_GPU_PERF_LIMITS_INFO());
+  info->version = NV_GPU_PERF_LIMITS_INFO_VER;
+  NvAPI_Status status = NvApi().NvAPI_GPU_PerfLimitsGetInfo(handle, info.get());
+  if (status != NVAPI_OK) { return status; }
+  for (NvU32 l = 0; l < info->numLimits && l < NVAPI_PERF_LIMIT_ID_MAX_LIMITS; ++l) {
+    const auto &limit = info->limits[l];
+    char name[NV_GPU_PERF_LIMIT_INFO_NAME_MAX_LENGTH_V1 + 1] = {};
+    std::memcpy(name, limit.szName, NV_GPU_PERF_LIMIT_INFO_NAME_MAX_LENGTH_V1);
+    if (name[0]) { (*names)[static_cast<NvU32>(limit.limitId)] = name; }
+  }
+  return NVAPI_OK;
+}
+
 int CmdGpuPerfLimitsInfo(int argc, char **argv) {
   NvU32 index = 0;
   bool hasIndex = false;
@@ -1883,29 +1864,28 @@ int CmdGpuPerfLimitsInfo(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_GPU_PERF_LIMITS_INFO info = {};
     info.version = NV_GPU_PERF_LIMITS_INFO_VER;
     info.numLimits = 0;
-    NvAPI_Status status = NvAPI_GPU_PerfLimitsGetInfo(handles[i], &info);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfLimitsGetInfo(handles[i], &info);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfLimitsGetInfo failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  Perf limits info: %u\n", info.numLimits);
+    Printf("  Perf limits info: %u\n", info.numLimits);
     for (NvU32 l = 0; l < info.numLimits; ++l) {
       const auto &limit = info.limits[l];
       char name[NV_GPU_PERF_LIMIT_INFO_NAME_MAX_LENGTH_V1 + 1] = {};
       std::memcpy(name, limit.szName, NV_GPU_PERF_LIMIT_INFO_NAME_MAX_LENGTH_V1);
-      std::printf("    id=0x%08X flags=0x%08X priority=%u rm=0x%08X name=%s\n", limit.limitId, limit.flags,
-                  limit.priority, limit.rmLimitId, name);
+      Printf("    id=0x%08X flags=0x%08X priority=%u rm=0x%08X name=%s\n", limit.limitId, limit.flags, limit.priority,
+             limit.rmLimitId, name);
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuPerfLimitsStatus(int argc, char **argv) {
@@ -1917,58 +1897,43 @@ int CmdGpuPerfLimitsStatus(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
-    std::vector<std::string> names(NVAPI_PERF_LIMIT_ID_MAX_LIMITS);
-    NV_GPU_PERF_LIMITS_INFO info = {};
-    info.version = NV_GPU_PERF_LIMITS_INFO_VER;
-    info.numLimits = 0;
-    NvAPI_Status infoStatus = NvAPI_GPU_PerfLimitsGetInfo(handles[i], &info);
-    if (infoStatus == NVAPI_OK) {
-      for (NvU32 l = 0; l < info.numLimits; ++l) {
-        const auto &limit = info.limits[l];
-        NvU32 limitId = static_cast<NvU32>(limit.limitId);
-        if (limitId < NVAPI_PERF_LIMIT_ID_MAX_LIMITS) {
-          char name[NV_GPU_PERF_LIMIT_INFO_NAME_MAX_LENGTH_V1 + 1] = {};
-          std::memcpy(name, limit.szName, NV_GPU_PERF_LIMIT_INFO_NAME_MAX_LENGTH_V1);
-          names[limitId] = name;
-        }
-      }
-    }
+    std::unordered_map<NvU32, std::string> names;
+    LoadPerfLimitNames(handles[i], &names);
 
     NV_GPU_PERF_LIMITS_STATUS status = {};
     status.version = NV_GPU_PERF_LIMITS_STATUS_VER;
     status.numLimits = 0;
-    NvAPI_Status callStatus = NvAPI_GPU_PerfLimitsGetStatus(handles[i], &status);
+    NvAPI_Status callStatus = NvApi().NvAPI_GPU_PerfLimitsGetStatus(handles[i], &status);
     if (callStatus != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfLimitsGetStatus failed", callStatus);
-      continue;
+      return 0;
     }
 
-    std::printf("  Perf limits status: %u\n", status.numLimits);
+    Printf("  Perf limits status: %u\n", status.numLimits);
     for (NvU32 l = 0; l < status.numLimits; ++l) {
       const auto &limit = status.limits[l];
       NvU32 limitId = static_cast<NvU32>(limit.limitId);
-      const char *name = "";
-      if (limitId < NVAPI_PERF_LIMIT_ID_MAX_LIMITS && !names[limitId].empty()) { name = names[limitId].c_str(); }
+      const auto found = names.find(limitId);
+      const char *name = found != names.end() ? found->second.c_str() : "";
 
-      std::printf("    id=0x%08X enabled=%u type=%s value=%u clkDomain=%u %s\n", limit.limitId,
-                  limit.output.bEnabled ? 1 : 0, PerfLimitInputTypeName(limit.input.type), limit.output.value,
-                  limit.output.decoupledClockId, name);
+      Printf("    id=0x%08X enabled=%u type=%s value=%u clkDomain=%u %s\n", limit.limitId,
+             limit.output.bEnabled ? 1 : 0, PerfLimitInputTypeName(limit.input.type), limit.output.value,
+             limit.output.decoupledClockId, name);
 
       if (limit.input.type == NVAPI_PERF_LIMIT_STATUS_INPUT_TYPE_PSTATE) {
-        std::printf("      pstate=%s point=%s\n", PstateName(limit.input.data.pstate.pstateId),
-                    PerfLimitPstatePointName(limit.input.data.pstate.point));
+        Printf("      pstate=%s point=%s\n", PstateName(limit.input.data.pstate.pstateId),
+               PerfLimitPstatePointName(limit.input.data.pstate.point));
       } else if (limit.input.type == NVAPI_PERF_LIMIT_STATUS_INPUT_TYPE_FREQ) {
-        std::printf("      freq=%u kHz domain=%u\n", limit.input.data.freq.freqKHz, limit.input.data.freq.domainId);
+        Printf("      freq=%u kHz domain=%u\n", limit.input.data.freq.freqKHz, limit.input.data.freq.domainId);
       } else if (limit.input.type == NVAPI_PERF_LIMIT_STATUS_INPUT_TYPE_VPSTATE) {
-        std::printf("      vpstate=%u\n", limit.input.data.vpstate.vpstate);
+        Printf("      vpstate=%u\n", limit.input.data.vpstate.vpstate);
       }
     }
-  }
-
-  return 0;
+    return 0;
+  });
 }
 
 int CmdGpuPerfLimitsSet(int argc, char **argv) {
@@ -1992,7 +1957,7 @@ int CmdGpuPerfLimitsSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index.\n");
+        Printf("Invalid GPU index.\n");
         return 1;
       }
       hasIndex = true;
@@ -2001,7 +1966,7 @@ int CmdGpuPerfLimitsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--limit-id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &limitIdRaw)) {
-        std::printf("Invalid limit id.\n");
+        Printf("Invalid limit id.\n");
         return 1;
       }
       hasLimitId = true;
@@ -2010,7 +1975,7 @@ int CmdGpuPerfLimitsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--type") == 0) {
       if (i + 1 >= argc || !ParsePerfLimitInputType(argv[i + 1], &inputType)) {
-        std::printf("Invalid input type.\n");
+        Printf("Invalid input type.\n");
         return 1;
       }
       hasType = true;
@@ -2019,7 +1984,7 @@ int CmdGpuPerfLimitsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--pstate") == 0) {
       if (i + 1 >= argc || !ParsePstateId(argv[i + 1], &pstateId)) {
-        std::printf("Invalid pstate.\n");
+        Printf("Invalid pstate.\n");
         return 1;
       }
       hasPstate = true;
@@ -2028,7 +1993,7 @@ int CmdGpuPerfLimitsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--point") == 0) {
       if (i + 1 >= argc || !ParsePerfLimitPstatePoint(argv[i + 1], &point)) {
-        std::printf("Invalid point.\n");
+        Printf("Invalid point.\n");
         return 1;
       }
       hasPoint = true;
@@ -2037,7 +2002,7 @@ int CmdGpuPerfLimitsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--freq-khz") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &freqKHz)) {
-        std::printf("Invalid freq.\n");
+        Printf("Invalid freq.\n");
         return 1;
       }
       hasFreq = true;
@@ -2046,7 +2011,7 @@ int CmdGpuPerfLimitsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--domain") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &domainId)) {
-        std::printf("Invalid domain.\n");
+        Printf("Invalid domain.\n");
         return 1;
       }
       hasDomain = true;
@@ -2055,32 +2020,32 @@ int CmdGpuPerfLimitsSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--vpstate") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &vpstate)) {
-        std::printf("Invalid vpstate.\n");
+        Printf("Invalid vpstate.\n");
         return 1;
       }
       hasVpstate = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasLimitId || !hasType) {
-    std::printf("Missing required --limit-id and --type\n");
+    Printf("Missing required --limit-id and --type\n");
     return 1;
   }
 
   if (inputType == NVAPI_PERF_LIMIT_STATUS_INPUT_TYPE_PSTATE && !hasPstate) {
-    std::printf("--pstate is required for type pstate.\n");
+    Printf("--pstate is required for type pstate.\n");
     return 1;
   }
   if (inputType == NVAPI_PERF_LIMIT_STATUS_INPUT_TYPE_FREQ && (!hasFreq || !hasDomain)) {
-    std::printf("--freq-khz and --domain are required for type freq.\n");
+    Printf("--freq-khz and --domain are required for type freq.\n");
     return 1;
   }
   if (inputType == NVAPI_PERF_LIMIT_STATUS_INPUT_TYPE_VPSTATE && !hasVpstate) {
-    std::printf("--vpstate is required for type vpstate.\n");
+    Printf("--vpstate is required for type vpstate.\n");
     return 1;
   }
 
@@ -2088,14 +2053,14 @@ int CmdGpuPerfLimitsSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NvU32 rmLimitId = 0;
     NV_GPU_PERF_LIMITS_INFO info = {};
     info.version = NV_GPU_PERF_LIMITS_INFO_VER;
     info.numLimits = 0;
-    NvAPI_Status infoStatus = NvAPI_GPU_PerfLimitsGetInfo(handles[i], &info);
+    NvAPI_Status infoStatus = NvApi().NvAPI_GPU_PerfLimitsGetInfo(handles[i], &info);
     if (infoStatus == NVAPI_OK) {
       for (NvU32 l = 0; l < info.numLimits; ++l) {
         if (static_cast<NvU32>(info.limits[l].limitId) == limitIdRaw) {
@@ -2128,26 +2093,24 @@ int CmdGpuPerfLimitsSet(int argc, char **argv) {
       entry.input.data.vpstate.vpstate = vpstate;
     }
 
-    std::printf("  Perf limit set request: id=0x%08X type=%s\n", limitIdRaw, PerfLimitInputTypeName(inputType));
+    Printf("  Perf limit set request: id=0x%08X type=%s\n", limitIdRaw, PerfLimitInputTypeName(inputType));
     if (inputType == NVAPI_PERF_LIMIT_STATUS_INPUT_TYPE_PSTATE) {
-      std::printf("    pstate=%s point=%s\n", PstateName(pstateId),
-                  PerfLimitPstatePointName(entry.input.data.pstate.point));
+      Printf("    pstate=%s point=%s\n", PstateName(pstateId), PerfLimitPstatePointName(entry.input.data.pstate.point));
     } else if (inputType == NVAPI_PERF_LIMIT_STATUS_INPUT_TYPE_FREQ) {
-      std::printf("    freq=%u kHz domain=%u\n", freqKHz, domainId);
+      Printf("    freq=%u kHz domain=%u\n", freqKHz, domainId);
     } else if (inputType == NVAPI_PERF_LIMIT_STATUS_INPUT_TYPE_VPSTATE) {
-      std::printf("    vpstate=%u\n", vpstate);
+      Printf("    vpstate=%u\n", vpstate);
     }
 
-    NvAPI_Status status = NvAPI_GPU_PerfLimitsSetStatus(handles[i], &limits);
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfLimitsSetStatus(handles[i], &limits);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_PerfLimitsSetStatus failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  Perf limit updated.\n");
-  }
-
-  return 0;
+    Printf("  Perf limit updated.\n");
+    return 0;
+  });
 }
 
 namespace {
@@ -2224,12 +2187,30 @@ int CmdGpuPerfLimits(int argc, char **argv) {
       {"info", CmdGpuPerfLimitsInfo},
       {"status", CmdGpuPerfLimitsStatus},
       {"set", CmdGpuPerfLimitsSet},
+      {"watch", CmdGpuPerfLimitsWatch},
   };
 
   return DispatchSubcommand("perf-limits", argc, argv, kSubcommands, sizeof(kSubcommands) / sizeof(kSubcommands[0]),
                             PrintGpuUsage);
 }
 
+int CmdGpuEnergy(int argc, char **argv) {
+  if (argc < 1) {
+    PrintUsageGroup("gpu");
+    return 1;
+  }
+
+  static const SubcommandEntry kSubcommands[] = {
+      {"start", CmdGpuEnergyStart},
+      {"read", CmdGpuEnergyRead},
+      {"stop", CmdGpuEnergyStop},
+      {"run", CmdGpuEnergyRun},
+  };
+
+  return DispatchSubcommand("energy", argc, argv, kSubcommands, sizeof(kSubcommands) / sizeof(kSubcommands[0]),
+                            PrintGpuUsage);
+}
+
 int CmdGpu(int argc, char **argv) {
   if (argc < 1) {
     PrintUsageGroup("gpu");
@@ -2242,6 +2223,8 @@ int CmdGpu(int argc, char **argv) {
       {"clocks", CmdGpuClocks},
       {"clock", CmdGpuClock},
       {"utilization", CmdGpuUtilization},
+      {"sample", CmdGpuSample},
+      {"pmumon", CmdGpuPmumon},
       {"dynamic-pstates-set", CmdGpuDynamicPstatesSet},
       {"force-pstate", CmdGpuForcePstate},
       {"force-pstate-ex", CmdGpuForcePstateEx},
@@ -2259,9 +2242,11 @@ int CmdGpu(int argc, char **argv) {
       {"board", CmdGpuBoard},
       {"pcie", CmdGpuPcie},
       {"power", CmdGpuPowerDispatch},
+      {"energy", CmdGpuEnergy},
       {"gc6", CmdGpuGc6},
       {"deep-idle", CmdGpuDeepIdle},
       {"oc-scanner", CmdGpuOcScanner},
+      {"tune", CmdGpuTune},
       {"vf", CmdGpuVf},
       {"vpstates", CmdGpuVpstates},
       {"vfe-var", CmdGpuVfeVar},
@@ -0,0 +1,474 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+
+namespace nvcli {
+namespace {
+using PmumonClock = std::chrono::steady_clock;
+
+constexpr NvU32 kPmumonClocks = 0x1;
+constexpr NvU32 kPmumonFans = 0x2;
+constexpr NvU32 kPmumonThermal = 0x4;
+constexpr NvU32 kPmumonPerfPolicies = 0x8;
+constexpr NvU32 kPmumonAll = kPmumonClocks | kPmumonFans | kPmumonThermal | kPmumonPerfPolicies;
+constexpr NvU32 kMaxPmumonSamples = 64;
+// NV_GPU_CLOCK_PMUMON_CLK_DOMAINS_SAMPLE_INVALID expands to NV_U32_MAX, which nvapi.h never defines.
+constexpr NvU32 kPmumonClockInvalid = 0xFFFFFFFFu;
+
+struct PmumonKind;
+
+struct PmumonStream {
+  NvPhysicalGpuHandle handle;
+  NvU32 gpuIndex;
+  const PmumonKind *kind;
+  NvU32 objectMask;
+  NvU64 originNs;
+  std::unique_ptr<NvU8[]> buffer;
+  bool seen;
+  NvU64 lastTimestamp;
+  NvU32 resetCount;
+  NvU64 written;
+  NvU64 duplicates;
+  NvU64 gaps;
+  NvU64 resets;
+  NvU64 failures;
+};
+
+struct PmumonOutput {
+  FILE *file;
+  OutputFramer *framer;
+};
+
+// Every *_GET_SAMPLES_V1 struct shares the layout: version, NV_GPU_PMUMON_GET_SAMPLES_SUPER_V1, rsvd, samples[], and
+// every sample starts with NV_GPU_PMUMON_SAMPLE_SUPER_V1, so one walker handles all of them given offsets and strides.
+struct PmumonKind {
+  const char *name;
+  NvU32 bit;
+  size_t size;
+  NvU32 version;
+  size_t superOffset;
+  size_t samplesOffset;
+  size_t sampleStride;
+  NvU32 sampleCount;
+  NvAPI_Status (*call)(NvPhysicalGpuHandle, void *);
+  NvAPI_Status (*queryMask)(NvPhysicalGpuHandle, NvU32 *);
+  void (*write)(PmumonOutput &, const PmumonStream &, const void *);
+};
+
+NvAPI_Status CallPmumonClocks(NvPhysicalGpuHandle gpu, void *data) {
+  return NvApi().NvAPI_GPU_ClockPmumonClkDomainsGetSamples(
+      gpu, reinterpret_cast<NV_GPU_CLOCK_PMUMON_CLK_DOMAINS_GET_SAMPLES *>(data));
+}
+
+NvAPI_Status CallPmumonFans(NvPhysicalGpuHandle gpu, void *data) {
+  return NvApi().NvAPI_GPU_FanPmumonFanCoolersGetSamples(
+      gpu, reinterpret_cast<NV_GPU_FAN_PMUMON_FAN_COOLERS_GET_SAMPLES *>(data));
+}
+
+NvAPI_Status CallPmumonThermal(NvPhysicalGpuHandle gpu, void *data) {
+  return NvApi().NvAPI_GPU_ThermalPmumonThermChannelsGetSamples(
+      gpu, reinterpret_cast<NV_GPU_THERMAL_PMUMON_THERM_CHANNELS_GET_SAMPLES *>(data));
+}
+
+NvAPI_Status CallPmumonPerfPolicies(NvPhysicalGpuHandle gpu, void *data) {
+  return NvApi().NvAPI_GPU_PerfPmumonPerfPoliciesGetSamples(
+      gpu, reinterpret_cast<NV_GPU_PERF_PMUMON_PERF_POLICIES_GET_SAMPLES *>(data));
+}
+
+NvAPI_Status QueryFanCoolerMask(NvPhysicalGpuHandle gpu, NvU32 *mask) {
+  NV_GPU_FAN_COOLER_INFO_PARAMS info = {};
+  info.version = NV_GPU_FAN_COOLER_INFO_PARAMS_VER;
+  NvAPI_Status status = NvApi().NvAPI_GPU_FanCoolerGetInfo(gpu, &info);
+  if (status == NVAPI_OK) { *mask = info.coolerMask; }
+  return status;
+}
+
+NvAPI_Status QueryThermChannelMask(NvPhysicalGpuHandle gpu, NvU32 *mask) {
+  NV_GPU_THERMAL_THERM_CHANNEL_INFO_PARAMS info = {};
+  info.version = NV_GPU_THERMAL_THERM_CHANNEL_INFO_PARAMS_VER;
+  NvAPI_Status status = NvApi().NvAPI_GPU_ThermChannelGetInfo(gpu, &info);
+  if (status == NVAPI_OK) { *mask = info.channelMask; }
+  return status;
+}
+
+void EmitLine(PmumonOutput &out, const char *line) {
+  if (out.file) {
+    std::fputs(line, out.file);
+  } else {
+    Printf("%s", line);
+  }
+}
+
+// Text timestamps are seconds since the oldest sample the GPU held at start, records carry the raw PMU and CPU
+// timestamps.
+double RelativeSeconds(const PmumonStream &stream, const NV_GPU_PMUMON_SAMPLE_SUPER_V1 &super) {
+  const NvS64 delta = static_cast<NvS64>(super.gpuTimeStamp - stream.originNs);
+  return static_cast<double>(delta) / 1e9;
+}
+
+void BeginSampleRecord(RecordWriter &record, const PmumonStream &stream, const NV_GPU_PMUMON_SAMPLE_SUPER_V1 &super) {
+  record.Field("gpu", stream.gpuIndex)
+      .Field("gpu_time_ns", static_cast<NvU64>(super.gpuTimeStamp))
+      .Field("cpu_time_ns", static_cast<NvU64>(super.cpuTimeStamp));
+}
+
+void WriteClockSample(PmumonOutput &out, const PmumonStream &stream, const void *data) {
+  const auto &sample = *reinterpret_cast<const NV_GPU_CLOCK_PMUMON_CLK_DOMAINS_SAMPLE_V1 *>(data);
+  if (StructuredOutput()) {
+    RecordWriter record("pmumon_clocks", out.framer);
+    BeginSampleRecord(record, stream, sample.super);
+    if (sample.gpcClkFreqKHz != kPmumonClockInvalid) {
+      record.Field("gpc_khz", sample.gpcClkFreqKHz);
+    } else {
+      record.Null("gpc_khz");
+    }
+    if (sample.dramClkFreqKHz != kPmumonClockInvalid) {
+      record.Field("dram_khz", sample.dramClkFreqKHz);
+    } else {
+      record.Null("dram_khz");
+    }
+    return;
+  }
+  char line[160];
+  int length = std::snprintf(line, sizeof(line), "gpu=%u clocks t=%.6f", stream.gpuIndex,
+                             RelativeSeconds(stream, sample.super));
+  if (sample.gpcClkFreqKHz != kPmumonClockInvalid) {
+    length += std::snprintf(line + length, sizeof(line) - length, " gpc=%u kHz", sample.gpcClkFreqKHz);
+  } else {
+    length += std::snprintf(line + length, sizeof(line) - length, " gpc=-");
+  }
+  if (sample.dramClkFreqKHz != kPmumonClockInvalid) {
+    std::snprintf(line + length, sizeof(line) - length, " dram=%u kHz\n", sample.dramClkFreqKHz);
+  } else {
+    std::snprintf(line + length, sizeof(line) - length, " dram=-\n");
+  }
+  EmitLine(out, line);
+}
+
+void WriteFanSample(PmumonOutput &out, const PmumonStream &stream, const void *data) {
+  const auto &sample = *reinterpret_cast<const NV_GPU_FAN_PMUMON_FAN_COOLERS_SAMPLE_V1 *>(data);
+  if (StructuredOutput()) {
+    for (NvU32 i = 0; i < NV_GPU_FAN_COOLER_MAX_COOLERS_V1; ++i) {
+      if ((stream.objectMask & (1u << i)) == 0) { continue; }
+      RecordWriter record("pmumon_fan", out.framer);
+      BeginSampleRecord(record, stream, sample.super);
+      record.Field("cooler", i).Field("rpm", sample.cooler[i].rpm).Field("level", sample.cooler[i].level);
+    }
+    return;
+  }
+  std::string line;
+  char chunk[64];
+  std::snprintf(chunk, sizeof(chunk), "gpu=%u fans t=%.6f", stream.gpuIndex, RelativeSeconds(stream, sample.super));
+  line.append(chunk);
+  for (NvU32 i = 0; i < NV_GPU_FAN_COOLER_MAX_COOLERS_V1; ++i) {
+    if ((stream.objectMask & (1u << i)) == 0) { continue; }
+    std::snprintf(chunk, sizeof(chunk), " cooler%u rpm=%u level=%u", i, sample.cooler[i].rpm, sample.cooler[i].level);
+    line.append(chunk);
+  }
+  line.push_back('\n');
+  EmitLine(out, line.c_str());
+}
+
+void WriteThermalSample(PmumonOutput &out, const PmumonStream &stream, const void *data) {
+  const auto &sample = *reinterpret_cast<const NV_GPU_THERMAL_PMUMON_THERM_CHANNELS_SAMPLE_V1 *>(data);
+  if (StructuredOutput()) {
+    for (NvU32 i = 0; i < NV_GPU_BOARDOBJGRP_E32_MAX_OBJECTS; ++i) {
+      if ((stream.objectMask & (1u << i)) == 0) { continue; }
+      RecordWriter record("pmumon_thermal", out.framer);
+      BeginSampleRecord(record, stream, sample.super);
+      record.Field("channel", i).Field("temp_c", sample.temperature[i] / 256.0);
+    }
+    return;
+  }
+  std::string line;
+  char chunk[64];
+  std::snprintf(chunk, sizeof(chunk), "gpu=%u thermal t=%.6f", stream.gpuIndex, RelativeSeconds(stream, sample.super));
+  line.append(chunk);
+  for (NvU32 i = 0; i < NV_GPU_BOARDOBJGRP_E32_MAX_OBJECTS; ++i) {
+    if ((stream.objectMask & (1u << i)) == 0) { continue; }
+    std::snprintf(chunk, sizeof(chunk), " ch%u=%.2f C", i, sample.temperature[i] / 256.0);
+    line.append(chunk);
+  }
+  line.push_back('\n');
+  EmitLine(out, line.c_str());
+}
+
+void WritePerfPoliciesSample(PmumonOutput &out, const PmumonStream &stream, const void *data) {
+  const auto &sample = *reinterpret_cast<const NV_GPU_PERF_PMUMON_PERF_POLICIES_SAMPLE_V1 *>(data);
+  if (StructuredOutput()) {
+    RecordWriter record("pmumon_perf_policies", out.framer);
+    BeginSampleRecord(record, stream, sample.super);
+    record.Hex("limiting_mask", sample.data.limitingPoliciesMask)
+        .Hex("requested_mask", sample.data.requestedPolicyMask);
+    return;
+  }
+  std::string line;
+  char chunk[96];
+  std::snprintf(chunk, sizeof(chunk), "gpu=%u perf-policies t=%.6f limiting=0x%08X", stream.gpuIndex,
+                RelativeSeconds(stream, sample.super), sample.data.limitingPoliciesMask);
+  line.append(chunk);
+  bool first = true;
+  for (NvU32 i = 0; i < NV_GPU_PERF_POLICY_ID_SW_NUM_V1; ++i) {
+    if ((sample.data.limitingPoliciesMask & (1u << i)) == 0) { continue; }
+    const char *name = PerfPolicyName(i);
+    if (name) {
+      std::snprintf(chunk, sizeof(chunk), "%s%s", first ? " (" : ",", name);
+    } else {
+      std::snprintf(chunk, sizeof(chunk), "%s%u", first ? " (" : ",", i);
+    }
+    line.append(chunk);
+    first = false;
+  }
+  if (!first) { line.push_back(')'); }
+  line.push_back('\n');
+  EmitLine(out, line.c_str());
+}
+
+const PmumonKind kPmumonKinds[] = {
+    {"clocks", kPmumonClocks, sizeof(NV_GPU_CLOCK_PMUMON_CLK_DOMAINS_GET_SAMPLES),
+     NV_GPU_CLOCK_PMUMON_CLK_DOMAINS_GET_SAMPLES_VER, offsetof(NV_GPU_CLOCK_PMUMON_CLK_DOMAINS_GET_SAMPLES, super),
+     offsetof(NV_GPU_CLOCK_PMUMON_CLK_DOMAINS_GET_SAMPLES, samples), sizeof(NV_GPU_CLOCK_PMUMON_CLK_DOMAINS_SAMPLE_V1),
+     NV_GPU_CLOCK_PMUMON_CLK_DOMAINS_SAMPLE_COUNT_V1, CallPmumonClocks, nullptr, WriteClockSample},
+    {"fans", kPmumonFans, sizeof(NV_GPU_FAN_PMUMON_FAN_COOLERS_GET_SAMPLES),
+     NV_GPU_FAN_PMUMON_FAN_COOLERS_GET_SAMPLES_VER, offsetof(NV_GPU_FAN_PMUMON_FAN_COOLERS_GET_SAMPLES, super),
+     offsetof(NV_GPU_FAN_PMUMON_FAN_COOLERS_GET_SAMPLES, samples), sizeof(NV_GPU_FAN_PMUMON_FAN_COOLERS_SAMPLE_V1),
+     NV_GPU_FAN_PMUMON_FAN_COOLERS_SAMPLE_COUNT_V1, CallPmumonFans, QueryFanCoolerMask, WriteFanSample},
+    {"thermal", kPmumonThermal, sizeof(NV_GPU_THERMAL_PMUMON_THERM_CHANNELS_GET_SAMPLES),
+     NV_GPU_THERMAL_PMUMON_THERM_CHANNELS_GET_SAMPLES_VER,
+     offsetof(NV_GPU_THERMAL_PMUMON_THERM_CHANNELS_GET_SAMPLES, super),
+     offsetof(NV_GPU_THERMAL_PMUMON_THERM_CHANNELS_GET_SAMPLES, samples),
+     sizeof(NV_GPU_THERMAL_PMUMON_THERM_CHANNELS_SAMPLE_V1), NV_GPU_THERMAL_PMUMON_THERM_CHANNELS_SAMPLE_COUNT_V1,
+     CallPmumonThermal, QueryThermChannelMask, WriteThermalSample},
+    {"perf-policies", kPmumonPerfPolicies, sizeof(NV_GPU_PERF_PMUMON_PERF_POLICIES_GET_SAMPLES),
+     NV_GPU_PERF_PMUMON_PERF_POLICIES_GET_SAMPLES_VER, offsetof(NV_GPU_PERF_PMUMON_PERF_POLICIES_GET_SAMPLES, super),
+     offsetof(NV_GPU_PERF_PMUMON_PERF_POLICIES_GET_SAMPLES, samples),
+     sizeof(NV_GPU_PERF_PMUMON_PERF_POLICIES_SAMPLE_V1), NV_GPU_PERF_PMUMON_PERF_POLICIES_SAMPLE_COUNT_V1,
+     CallPmumonPerfPolicies, nullptr, WritePerfPoliciesSample},
+};
+
+bool ParsePmumonSources(const char *value, NvU32 *mask) {
+  *mask = 0;
+  std::string list(value);
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t comma = list.find(',', start);
+    if (comma == std::string::npos) { comma = list.size(); }
+    const std::string name = list.substr(start, comma - start);
+    NvU32 bit = 0;
+    if (name == "all") { bit = kPmumonAll; }
+    for (const auto &kind : kPmumonKinds) {
+      if (name == kind.name) { bit = kind.bit; }
+    }
+    if (bit == 0) {
+      Printf("Unknown PMUMON source: %s\n", name.c_str());
+      return false;
+    }
+    *mask |= bit;
+    start = comma + 1;
+  }
+  return true;
+}
+
+NvAPI_Status FetchPmumonSamples(PmumonStream &stream) {
+  const PmumonKind &kind = *stream.kind;
+  std::memset(stream.buffer.get(), 0, kind.size);
+  *reinterpret_cast<NvU32 *>(stream.buffer.get()) = kind.version;
+  return kind.call(stream.handle, stream.buffer.get());
+}
+
+// The PMU keeps a fixed ring of recent samples, so consecutive polls overlap. Samples are ordered by PMU timestamp and
+// only those newer than the last written one are emitted. A poll whose oldest sample is already newer than that means
+// the ring wrapped between polls and samples were lost.
+void DrainPmumonStream(PmumonStream &stream, PmumonOutput &out) {
+  const PmumonKind &kind = *stream.kind;
+  if (FetchPmumonSamples(stream) != NVAPI_OK) {
+    ++stream.failures;
+    return;
+  }
+
+  const NvU8 *base = stream.buffer.get();
+  const auto &super = *reinterpret_cast<const NV_GPU_PMUMON_GET_SAMPLES_SUPER_V1 *>(base + kind.superOffset);
+  if (stream.seen && super.resetCount != stream.resetCount) {
+    ++stream.resets;
+    stream.seen = false;
+  }
+  stream.resetCount = super.resetCount;
+
+  const NvU8 *order[kMaxPmumonSamples];
+  NvU32 count = 0;
+  for (NvU32 i = 0; i < kind.sampleCount && i < kMaxPmumonSamples; ++i) {
+    const NvU8 *sample = base + kind.samplesOffset + i * kind.sampleStride;
+    if (reinterpret_cast<const NV_GPU_PMUMON_SAMPLE_SUPER_V1 *>(sample)->gpuTimeStamp == 0) { continue; }
+    order[count++] = sample;
+  }
+  auto timestamp = [](const NvU8 *sample) {
+    return reinterpret_cast<const NV_GPU_PMUMON_SAMPLE_SUPER_V1 *>(sample)->gpuTimeStamp;
+  };
+  std::sort(order, order + count, [&](const NvU8 *a, const NvU8 *b) { return timestamp(a) < timestamp(b); });
+
+  if (stream.seen && count > 0 && timestamp(order[0]) > stream.lastTimestamp) { ++stream.gaps; }
+  for (NvU32 i = 0; i < count; ++i) {
+    const NvU64 current = timestamp(order[i]);
+    if (stream.seen && current <= stream.lastTimestamp) {
+      ++stream.duplicates;
+      continue;
+    }
+    kind.write(out, stream, order[i]);
+    stream.lastTimestamp = current;
+    stream.seen = true;
+    ++stream.written;
+  }
+  if (out.file) { std::fflush(out.file); }
+}
+} // namespace
+
+int CmdGpuPmumon(int argc, char **argv) {
+  NvU32 index = 0;
+  bool hasIndex = false;
+  NvU32 intervalMs = 1000;
+  NvU32 durationSec = 10;
+  NvU32 sources = kPmumonAll;
+  const char *outPath = nullptr;
+
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--index") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
+        Printf("Invalid GPU index.\n");
+        return 1;
+      }
+      hasIndex = true;
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--source") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --source\n");
+        return 1;
+      }
+      if (!ParsePmumonSources(argv[i + 1], &sources)) { return 1; }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--interval-ms") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &intervalMs) || intervalMs == 0) {
+        Printf("Invalid value for --interval-ms\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--duration") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &durationSec)) {
+        Printf("Invalid value for --duration\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--out") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --out\n");
+        return 1;
+      }
+      outPath = argv[i + 1];
+      ++i;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+
+  std::vector<NvPhysicalGpuHandle> handles;
+  std::vector<NvU32> indices;
+  if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
+
+  std::vector<PmumonStream> streams;
+  for (size_t i = 0; i < handles.size(); ++i) {
+    const size_t first = streams.size();
+    NvU64 originNs = 0;
+    for (const auto &kind : kPmumonKinds) {
+      if ((sources & kind.bit) == 0) { continue; }
+      PmumonStream stream = {};
+      stream.handle = handles[i];
+      stream.gpuIndex = indices[i];
+      stream.kind = &kind;
+      stream.buffer.reset(new NvU8[kind.size]);
+      // Fan coolers and thermal channels are decoded only for the entries the info mask marks as present.
+      NvAPI_Status status = kind.queryMask ? kind.queryMask(handles[i], &stream.objectMask) : NVAPI_OK;
+      if (status == NVAPI_OK) { status = FetchPmumonSamples(stream); }
+      if (status != NVAPI_OK) {
+        char prefix[96];
+        std::snprintf(prefix, sizeof(prefix), "GPU %u: %s PMUMON samples unavailable", indices[i], kind.name);
+        PrintNvapiError(prefix, status);
+        continue;
+      }
+      for (NvU32 s = 0; s < kind.sampleCount && s < kMaxPmumonSamples; ++s) {
+        const NvU64 timestamp = reinterpret_cast<const NV_GPU_PMUMON_SAMPLE_SUPER_V1 *>(
+                                    stream.buffer.get() + kind.samplesOffset + s * kind.sampleStride)
+                                    ->gpuTimeStamp;
+        if (timestamp != 0 && (originNs == 0 || timestamp < originNs)) { originNs = timestamp; }
+      }
+      streams.push_back(std::move(stream));
+    }
+    for (size_t s = first; s < streams.size(); ++s) { streams[s].originNs = originNs; }
+  }
+  if (streams.empty()) {
+    Printf("No PMUMON sample source available.\n");
+    return 1;
+  }
+
+  FILE *file = nullptr;
+  if (outPath) {
+    if (fopen_s(&file, outPath, "w") != 0 || !file) {
+      Printf("Failed to open %s\n", outPath);
+      return 1;
+    }
+  }
+  auto fileFramer = std::make_unique<OutputFramer>(file);
+  PmumonOutput out = {file, file ? fileFramer.get() : nullptr};
+
+  // A zero duration drains the history currently held by the PMU once and exits.
+  const auto interval = std::chrono::milliseconds(intervalMs);
+  const auto end = PmumonClock::now() + std::chrono::seconds(durationSec);
+  auto deadline = PmumonClock::now();
+  do {
+    std::this_thread::sleep_until(deadline);
+    for (auto &stream : streams) { DrainPmumonStream(stream, out); }
+    deadline += interval;
+    const auto after = PmumonClock::now();
+    if (after > deadline + interval) { deadline = after - (after - deadline) % interval; }
+  } while (deadline < end);
+
+  if (file) {
+    if (StructuredOutput()) { fileFramer->Finish(); }
+    std::fclose(file);
+  }
+
+  for (const auto &stream : streams) {
+    if (StructuredOutput()) {
+      RecordWriter("pmumon_summary")
+          .Field("gpu", stream.gpuIndex)
+          .Field("source", stream.kind->name)
+          .Field("written", stream.written)
+          .Field("duplicates", stream.duplicates)
+          .Field("gaps", stream.gaps)
+          .Field("resets", stream.resets)
+          .Field("failures", stream.failures);
+      continue;
+    }
+    Printf("GPU %u %s: %llu written, %llu duplicates skipped, %llu gaps, %llu resets, %llu failed polls\n",
+           stream.gpuIndex, stream.kind->name, static_cast<unsigned long long>(stream.written),
+           static_cast<unsigned long long>(stream.duplicates), static_cast<unsigned long long>(stream.gaps),
+           static_cast<unsigned long long>(stream.resets), static_cast<unsigned long long>(stream.failures));
+  }
+  return 0;
+}
+} // namespace nvcli
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/common.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace nvcli {
+namespace {
+// Worker threads shared by every ForEachGpu call, created on first use and kept for the life of the process so batch
+// and serve do not pay thread startup per command.
+class GpuWorkerPool {
+public:
+  ~GpuWorkerPool() {
+    {
+      std::lock_guard<std::mutex> guard(m_lock);
+      m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto &thread : m_threads) { thread.join(); }
+  }
+
+  // Runs task(0..count-1) on up to `workers` threads including the caller and returns once every task finished.
+  void Run(size_t count, size_t workers, const std::function<void(size_t)> &task) {
+    std::unique_lock<std::mutex> guard(m_lock);
+    while (m_threads.size() + 1 < workers) { m_threads.emplace_back(&GpuWorkerPool::WorkerLoop, this); }
+    m_task = &task;
+    m_count = count;
+    m_next = 0;
+    m_active = std::min(workers, m_threads.size() + 1) - 1;
+    m_pending = count;
+    ++m_generation;
+    guard.unlock();
+    m_wake.notify_all();
+
+    RunTasks();
+
+    guard.lock();
+    m_done.wait(guard, [this] { return m_pending == 0; });
+    m_task = nullptr;
+  }
+
+private:
+  void RunTasks() {
+    for (;;) {
+      size_t index = 0;
+      {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (m_next >= m_count) { return; }
+        index = m_next++;
+      }
+      (*m_task)(index);
+      {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (--m_pending == 0) { m_done.notify_all(); }
+      }
+    }
+  }
+
+  void WorkerLoop() {
+    NvU64 seen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> guard(m_lock);
+        m_wake.wait(guard, [&] { return m_stop || (m_generation != seen && m_active > 0); });
+        if (m_stop) { return; }
+        seen = m_generation;
+        --m_active;
+      }
+      RunTasks();
+    }
+  }
+
+  std::mutex m_lock;
+  std::condition_variable m_wake;
+  std::condition_variable m_done;
+  std::vector<std::thread> m_threads;
+  const std::function<void(size_t)> *m_task = nullptr;
+  size_t m_count = 0;
+  size_t m_next = 0;
+  size_t m_active = 0;
+  size_t m_pending = 0;
+  NvU64 m_generation = 0;
+  bool m_stop = false;
+};
+
+GpuWorkerPool &Pool() {
+  static GpuWorkerPool pool;
+  return pool;
+}
+
+NvU32 g_gpuJobs = 0;
+thread_local bool t_inGpuWorker = false;
+} // namespace
+
+void SetGpuJobs(NvU32 jobs) { g_gpuJobs = jobs; }
+
+int ForEachGpu(size_t count, const std::function<int(size_t i)> &body) {
+  const size_t workers = g_gpuJobs == 0 ? count : std::min<size_t>(g_gpuJobs, count);
+  if (workers <= 1 || t_inGpuWorker) {
+    int result = 0;
+    for (size_t i = 0; i < count; ++i) {
+      const int status = body(i);
+      if (result == 0) { result = status; }
+    }
+    ClearRecordGpu();
+    return result;
+  }
+
+  std::vector<std::string> outputs(count);
+  std::vector<int> results(count, 0);
+  Pool().Run(count, workers, [&](size_t i) {
+    t_inGpuWorker = true;
+    OutputCapture capture(&outputs[i]);
+    results[i] = body(i);
+    ClearRecordGpu();
+    t_inGpuWorker = false;
+  });
+
+  int result = 0;
+  for (size_t i = 0; i < count; ++i) {
+    WriteOutput(outputs[i]);
+    if (result == 0) { result = results[i]; }
+  }
+  return result;
+}
+} // namespace nvcli
@@ -167,11 +167,11 @@ int CmdGpuDynamicPstatesSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -180,23 +180,23 @@ int CmdGpuDynamicPstatesSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--enable") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --enable\n");
+        Printf("Missing value for --enable\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &enable)) {
-        std::printf("Invalid value for --enable: %s\n", argv[i + 1]);
+        Printf("Invalid value for --enable: %s\n", argv[i + 1]);
         return 1;
       }
       hasEnable = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasEnable) {
-    std::printf("Missing required --enable\n");
+    Printf("Missing required --enable\n");
     return 1;
   }
 
@@ -204,16 +204,16 @@ int CmdGpuDynamicPstatesSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
-    NvAPI_Status status = NvAPI_GPU_EnableDynamicPstates(handles[i], enable ? 1 : 0);
+    NvAPI_Status status = NvApi().NvAPI_GPU_EnableDynamicPstates(handles[i], enable ? 1 : 0);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_EnableDynamicPstates failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  Dynamic Pstates: %s\n", enable ? "enabled" : "disabled");
-  }
-  return 0;
+    Printf("  Dynamic Pstates: %s\n", enable ? "enabled" : "disabled");
+    return 0;
+  });
 }
 
 int CmdGpuPcieAspmSet(int argc, char **argv) {
@@ -225,11 +225,11 @@ int CmdGpuPcieAspmSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -238,23 +238,23 @@ int CmdGpuPcieAspmSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--enable") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --enable\n");
+        Printf("Missing value for --enable\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &enable)) {
-        std::printf("Invalid value for --enable: %s\n", argv[i + 1]);
+        Printf("Invalid value for --enable: %s\n", argv[i + 1]);
         return 1;
       }
       hasEnable = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasEnable) {
-    std::printf("Missing required --enable\n");
+    Printf("Missing required --enable\n");
     return 1;
   }
 
@@ -262,19 +262,19 @@ int CmdGpuPcieAspmSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_ASPM_CONTROL_DATA data = {};
     data.version = NV_GPU_ASPM_CONTROL_DATA_VER;
     data.bEnable = enable ? 1 : 0;
-    NvAPI_Status status = NvAPI_GPU_ControlASPM(handles[i], &data);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ControlASPM(handles[i], &data);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ControlASPM failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  ASPM: %s\n", enable ? "enabled" : "disabled");
-  }
-  return 0;
+    Printf("  ASPM: %s\n", enable ? "enabled" : "disabled");
+    return 0;
+  });
 }
 
 int CmdGpuGc6Control(int argc, char **argv) {
@@ -286,11 +286,11 @@ int CmdGpuGc6Control(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -299,23 +299,23 @@ int CmdGpuGc6Control(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--op") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --op\n");
+        Printf("Missing value for --op\n");
         return 1;
       }
       opValue = argv[i + 1];
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!opValue) {
-    std::printf("Missing required --op\n");
+    Printf("Missing required --op\n");
     return 1;
   }
   if (!ParseGc6ControlOp(opValue, &op)) {
-    std::printf("Invalid GC6 op: %s\n", opValue);
+    Printf("Invalid GC6 op: %s\n", opValue);
     return 1;
   }
 
@@ -323,20 +323,20 @@ int CmdGpuGc6Control(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_GPU_GC6_CONTROL control = {};
     control.version = NV_GPU_GC6_CONTROL_VER;
     control.controlOp = op;
-    NvAPI_Status status = NvAPI_GPU_GC6Control(handles[i], &control);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GC6Control(handles[i], &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GC6Control failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  GC6 op=%s status=%s (%u)\n", Gc6ControlOpName(op), Gc6ControlStatusName(control.controlStatus),
-                static_cast<unsigned>(control.controlStatus));
-  }
-  return 0;
+    Printf("  GC6 op=%s status=%s (%u)\n", Gc6ControlOpName(op), Gc6ControlStatusName(control.controlStatus),
+           static_cast<unsigned>(control.controlStatus));
+    return 0;
+  });
 }
 
 int CmdGpuGc6ForceExit(int argc, char **argv) {
@@ -348,26 +348,26 @@ int CmdGpuGc6ForceExit(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
-    NvAPI_Status status = NvAPI_GPU_ForceGC6Exit(handles[i]);
+    NvAPI_Status status = NvApi().NvAPI_GPU_ForceGC6Exit(handles[i]);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_ForceGC6Exit failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  GC6 exit requested.\n");
-  }
-  return 0;
+    Printf("  GC6 exit requested.\n");
+    return 0;
+  });
 }
 
 int CmdGpuGc6(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing gc6 subcommand.\n");
+    Printf("Missing gc6 subcommand.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "control") == 0) { return CmdGpuGc6Control(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "force-exit") == 0) { return CmdGpuGc6ForceExit(argc - 1, argv + 1); }
-  std::printf("Unknown gc6 subcommand: %s\n", argv[0]);
+  Printf("Unknown gc6 subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -380,17 +380,17 @@ int CmdGpuThermalLevel(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_EVENT_LEVEL level = UNKNOWN_LEVEL;
-    NvAPI_Status status = NvAPI_GPU_GetCurrentThermalLevel(handles[i], &level);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetCurrentThermalLevel(handles[i], &level);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetCurrentThermalLevel failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  Thermal level: %s (%u)\n", EventLevelName(level), static_cast<unsigned>(level));
-  }
-  return 0;
+    Printf("  Thermal level: %s (%u)\n", EventLevelName(level), static_cast<unsigned>(level));
+    return 0;
+  });
 }
 
 int CmdGpuDeepIdleState(int argc, char **argv) {
@@ -402,25 +402,24 @@ int CmdGpuDeepIdleState(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NvLogicalGpuHandle logical = NULL;
-    NvAPI_Status status = NvAPI_GetLogicalGPUFromPhysicalGPU(handles[i], &logical);
+    NvAPI_Status status = NvApi().NvAPI_GetLogicalGPUFromPhysicalGPU(handles[i], &logical);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GetLogicalGPUFromPhysicalGPU failed", status);
-      continue;
+      return 0;
     }
 
     NV_DEEP_IDLE_STATE state = NV_DEEP_IDLE_NOT_SUPPORTED;
-    status = NvAPI_GPU_GetDeepIdleState(logical, &state);
+    status = NvApi().NvAPI_GPU_GetDeepIdleState(logical, &state);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetDeepIdleState failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  Deep idle: %s (%d)\n", DeepIdleStateName(state), static_cast<int>(state));
-  }
-
-  return 0;
+    Printf("  Deep idle: %s (%d)\n", DeepIdleStateName(state), static_cast<int>(state));
+    return 0;
+  });
 }
 
 int CmdGpuDeepIdleSet(int argc, char **argv) {
@@ -432,11 +431,11 @@ int CmdGpuDeepIdleSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -445,23 +444,23 @@ int CmdGpuDeepIdleSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--state") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --state\n");
+        Printf("Missing value for --state\n");
         return 1;
       }
       if (!ParseDeepIdleState(argv[i + 1], &state)) {
-        std::printf("Invalid deep idle state: %s\n", argv[i + 1]);
+        Printf("Invalid deep idle state: %s\n", argv[i + 1]);
         return 1;
       }
       hasState = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasState) {
-    std::printf("Missing required --state\n");
+    Printf("Missing required --state\n");
     return 1;
   }
 
@@ -469,23 +468,22 @@ int CmdGpuDeepIdleSet(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NvLogicalGpuHandle logical = NULL;
-    NvAPI_Status status = NvAPI_GetLogicalGPUFromPhysicalGPU(handles[i], &logical);
+    NvAPI_Status status = NvApi().NvAPI_GetLogicalGPUFromPhysicalGPU(handles[i], &logical);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GetLogicalGPUFromPhysicalGPU failed", status);
-      continue;
+      return 0;
     }
-    status = NvAPI_GPU_SetDeepIdleState(logical, state);
+    status = NvApi().NvAPI_GPU_SetDeepIdleState(logical, state);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_SetDeepIdleState failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  Deep idle set: %s\n", DeepIdleStateName(state));
-  }
-
-  return 0;
+    Printf("  Deep idle set: %s\n", DeepIdleStateName(state));
+    return 0;
+  });
 }
 
 int CmdGpuDeepIdleStatsMode(int argc, char **argv) {
@@ -498,11 +496,11 @@ int CmdGpuDeepIdleStatsMode(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -511,11 +509,11 @@ int CmdGpuDeepIdleStatsMode(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--mode") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --mode\n");
+        Printf("Missing value for --mode\n");
         return 1;
       }
       if (!ParseDeepIdleStatsMode(argv[i + 1], &mode)) {
-        std::printf("Invalid deep idle stats mode: %s\n", argv[i + 1]);
+        Printf("Invalid deep idle stats mode: %s\n", argv[i + 1]);
         return 1;
       }
       hasMode = true;
@@ -524,22 +522,22 @@ int CmdGpuDeepIdleStatsMode(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--reset") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --reset\n");
+        Printf("Missing value for --reset\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &reset)) {
-        std::printf("Invalid value for --reset: %s\n", argv[i + 1]);
+        Printf("Invalid value for --reset: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasMode) {
-    std::printf("Missing required --mode\n");
+    Printf("Missing required --mode\n");
     return 1;
   }
 
@@ -547,17 +545,16 @@ int CmdGpuDeepIdleStatsMode(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
-    NvAPI_Status status = NvAPI_GPU_SetDeepIdleStatisticsMode(handles[i], mode, reset ? 1 : 0);
+    NvAPI_Status status = NvApi().NvAPI_GPU_SetDeepIdleStatisticsMode(handles[i], mode, reset ? 1 : 0);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_SetDeepIdleStatisticsMode failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  Deep idle stats mode: %s reset=%u\n", DeepIdleStatsModeName(mode), reset ? 1u : 0u);
-  }
-
-  return 0;
+    Printf("  Deep idle stats mode: %s reset=%u\n", DeepIdleStatsModeName(mode), reset ? 1u : 0u);
+    return 0;
+  });
 }
 
 int CmdGpuDeepIdleStats(int argc, char **argv) {
@@ -569,35 +566,34 @@ int CmdGpuDeepIdleStats(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_DEEP_IDLE_STATISTICS stats = {};
     stats.version = NV_DEEP_IDLE_STATISTICS_VER;
-    NvAPI_Status status = NvAPI_GPU_GetDeepIdleStatistics(handles[i], &stats);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetDeepIdleStatistics(handles[i], &stats);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetDeepIdleStatistics failed", status);
-      continue;
+      return 0;
     }
-    std::printf("  Deep idle attempts=%u entries=%u exits=%u time=%u us\n", stats.attempts, stats.entries, stats.exits,
-                stats.time);
-    std::printf("  Max latency: entry=%u us exit=%u us\n", stats.maxEntryLatency, stats.maxExitLatency);
-    std::printf("  VE stats: frames=%u vblankExits=%u deepL1Exits=%u\n", stats.veFrames, stats.veVblankExits,
-                stats.veDeepL1Exits);
-  }
-
-  return 0;
+    Printf("  Deep idle attempts=%u entries=%u exits=%u time=%u us\n", stats.attempts, stats.entries, stats.exits,
+           stats.time);
+    Printf("  Max latency: entry=%u us exit=%u us\n", stats.maxEntryLatency, stats.maxExitLatency);
+    Printf("  VE stats: frames=%u vblankExits=%u deepL1Exits=%u\n", stats.veFrames, stats.veVblankExits,
+           stats.veDeepL1Exits);
+    return 0;
+  });
 }
 
 int CmdGpuDeepIdle(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing deep-idle subcommand.\n");
+    Printf("Missing deep-idle subcommand.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "state") == 0) { return CmdGpuDeepIdleState(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "set") == 0) { return CmdGpuDeepIdleSet(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "stats-mode") == 0) { return CmdGpuDeepIdleStatsMode(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "stats") == 0) { return CmdGpuDeepIdleStats(argc - 1, argv + 1); }
-  std::printf("Unknown deep-idle subcommand: %s\n", argv[0]);
+  Printf("Unknown deep-idle subcommand: %s\n", argv[0]);
   return 1;
 }
 
@@ -611,11 +607,11 @@ int CmdGpuForcePstate(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -624,11 +620,11 @@ int CmdGpuForcePstate(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--pstate") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --pstate\n");
+        Printf("Missing value for --pstate\n");
         return 1;
       }
       if (!ParseForcePstateId(argv[i + 1], &pstate)) {
-        std::printf("Invalid pstate: %s\n", argv[i + 1]);
+        Printf("Invalid pstate: %s\n", argv[i + 1]);
         return 1;
       }
       hasPstate = true;
@@ -637,22 +633,22 @@ int CmdGpuForcePstate(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--fallback") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --fallback\n");
+        Printf("Missing value for --fallback\n");
         return 1;
       }
       if (!ParsePstateFallback(argv[i + 1], &fallback)) {
-        std::printf("Invalid fallback: %s\n", argv[i + 1]);
+        Printf("Invalid fallback: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasPstate) {
-    std::printf("Missing required --pstate\n");
+    Printf("Missing required --pstate\n");
     return 1;
   }
 
@@ -660,19 +656,18 @@ int CmdGpuForcePstate(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
-    NvAPI_Status status = NvAPI_GPU_SetForcePstate(handles[i], pstate, fallback);
+    NvAPI_Status status = NvApi().NvAPI_GPU_SetForcePstate(handles[i], pstate, fallback);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_SetForcePstate failed", status);
-      if (status == NVAPI_INVALID_USER_PRIVILEGE) { std::printf("  Try running the terminal as Administrator.\n"); }
-      continue;
+      if (status == NVAPI_INVALID_USER_PRIVILEGE) { Printf("  Try running the terminal as Administrator.\n"); }
+      return 0;
     }
     const char *pstateName = (pstate == NVAPI_GPU_PERF_PSTATE_UNDEFINED) ? "AUTO" : PstateName(pstate);
-    std::printf("  Force pstate: %s fallback=%s\n", pstateName, PstateFallbackName(fallback));
-  }
-
-  return 0;
+    Printf("  Force pstate: %s fallback=%s\n", pstateName, PstateFallbackName(fallback));
+    return 0;
+  });
 }
 
 int CmdGpuForcePstateEx(int argc, char **argv) {
@@ -686,11 +681,11 @@ int CmdGpuForcePstateEx(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --index\n");
+        Printf("Missing value for --index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid GPU index: %s\n", argv[i + 1]);
+        Printf("Invalid GPU index: %s\n", argv[i + 1]);
         return 1;
       }
       hasIndex = true;
@@ -699,11 +694,11 @@ int CmdGpuForcePstateEx(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--pstate") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --pstate\n");
+        Printf("Missing value for --pstate\n");
         return 1;
       }
       if (!ParseForcePstateId(argv[i + 1], &pstate)) {
-        std::printf("Invalid pstate: %s\n", argv[i + 1]);
+        Printf("Invalid pstate: %s\n", argv[i + 1]);
         return 1;
       }
       hasPstate = true;
@@ -712,11 +707,11 @@ int CmdGpuForcePstateEx(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--fallback") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --fallback\n");
+        Printf("Missing value for --fallback\n");
         return 1;
       }
       if (!ParsePstateFallback(argv[i + 1], &fallback)) {
-        std::printf("Invalid fallback: %s\n", argv[i + 1]);
+        Printf("Invalid fallback: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
@@ -724,22 +719,22 @@ int CmdGpuForcePstateEx(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--async") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --async\n");
+        Printf("Missing value for --async\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &async)) {
-        std::printf("Invalid value for --async: %s\n", argv[i + 1]);
+        Printf("Invalid value for --async: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasPstate) {
-    std::printf("Missing required --pstate\n");
+    Printf("Missing required --pstate\n");
     return 1;
   }
 
@@ -748,19 +743,18 @@ int CmdGpuForcePstateEx(int argc, char **argv) {
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
   NvU32 flags = async ? NV_GPU_PERF_SET_FORCE_PSTATE_FLAGS_ASYNC : 0;
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
-    NvAPI_Status status = NvAPI_GPU_SetForcePstateEx(handles[i], pstate, fallback, flags);
+    NvAPI_Status status = NvApi().NvAPI_GPU_SetForcePstateEx(handles[i], pstate, fallback, flags);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_SetForcePstateEx failed", status);
-      if (status == NVAPI_INVALID_USER_PRIVILEGE) { std::printf("  Try running the terminal as Administrator.\n"); }
-      continue;
+      if (status == NVAPI_INVALID_USER_PRIVILEGE) { Printf("  Try running the terminal as Administrator.\n"); }
+      return 0;
     }
     const char *pstateName = (pstate == NVAPI_GPU_PERF_PSTATE_UNDEFINED) ? "AUTO" : PstateName(pstate);
-    std::printf("  Force pstate: %s fallback=%s async=%u\n", pstateName, PstateFallbackName(fallback), async ? 1u : 0u);
-  }
-
-  return 0;
+    Printf("  Force pstate: %s fallback=%s async=%u\n", pstateName, PstateFallbackName(fallback), async ? 1u : 0u);
+    return 0;
+  });
 }
 
 } // namespace nvcli
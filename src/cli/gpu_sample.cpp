@@ -0,0 +1,496 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/ring_buffer.h"
+#include "cli/telemetry_log.h"
+#include "cli/timer_resolution.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace nvcli {
+namespace {
+using SampleClock = std::chrono::steady_clock;
+
+constexpr size_t kSampleRingCapacity = 4096;
+constexpr NvU32 kSampleHasUtilization = 0x1;
+constexpr NvU32 kSampleHasClocks = 0x2;
+constexpr NvU32 kSampleHasPower = 0x4;
+constexpr NvU32 kSampleHasTemperature = 0x8;
+constexpr NvU32 kSampleHasFan = 0x10;
+constexpr NvU32 kSampleHasPerfLimits = 0x20;
+
+struct GpuSample {
+  NvU64 timestampUs;
+  NvU64 latenessUs;
+  NvU32 gpuIndex;
+  NvU32 flags;
+  NvU32 utilization[4];
+  NvU32 graphicsKHz;
+  NvU32 memoryKHz;
+  NvU32 totalPowermW;
+  NvU32 channelPowermW[NV_GPU_POWER_MONITOR_MAX_CHANNELS_V1];
+  NvS32 temperatureC[NVAPI_MAX_THERMAL_SENSORS_PER_GPU];
+  NvU32 fanRpm;
+  NvU32 perfLimitMask;
+};
+
+struct SampleSource {
+  NvPhysicalGpuHandle handle;
+  NvU32 index;
+  NvU32 clockVersion;
+  NvU32 powerChannelMask;
+  bool hasPowerMonitor;
+  // Only probed and queried when writing a telemetry log.
+  NvU32 thermalSensors;
+  bool hasFan;
+  bool hasPerfLimits;
+  size_t logColumn;
+};
+
+struct SampleStats {
+  NvU64 written;
+  NvU64 maxLatenessUs;
+};
+
+bool QuerySampleClocks(SampleSource &source, GpuSample &sample) {
+  static const NvU32 kVersions[] = {NV_GPU_CLOCK_FREQUENCIES_VER, NV_GPU_CLOCK_FREQUENCIES_VER_2,
+                                    NV_GPU_CLOCK_FREQUENCIES_VER_1};
+  NV_GPU_CLOCK_FREQUENCIES clocks = {};
+  NvAPI_Status status = NVAPI_INCOMPATIBLE_STRUCT_VERSION;
+  if (source.clockVersion != 0) {
+    clocks.version = source.clockVersion;
+    clocks.ClockType = NV_GPU_CLOCK_FREQUENCIES_CURRENT_FREQ;
+    status = NvApi().NvAPI_GPU_GetAllClockFrequencies(source.handle, &clocks);
+  } else {
+    for (NvU32 version : kVersions) {
+      std::memset(&clocks, 0, sizeof(clocks));
+      clocks.version = version;
+      clocks.ClockType = NV_GPU_CLOCK_FREQUENCIES_CURRENT_FREQ;
+      status = NvApi().NvAPI_GPU_GetAllClockFrequencies(source.handle, &clocks);
+      if (status != NVAPI_INCOMPATIBLE_STRUCT_VERSION) { break; }
+    }
+    if (status == NVAPI_OK) { source.clockVersion = clocks.version; }
+  }
+  if (status != NVAPI_OK) { return false; }
+
+  const auto &graphics = clocks.domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS];
+  const auto &memory = clocks.domain[NVAPI_GPU_PUBLIC_CLOCK_MEMORY];
+  sample.graphicsKHz = graphics.bIsPresent ? graphics.frequency : 0;
+  sample.memoryKHz = memory.bIsPresent ? memory.frequency : 0;
+  return true;
+}
+
+bool QuerySampleUtilization(const SampleSource &source, GpuSample &sample) {
+  NV_GPU_DYNAMIC_PSTATES_INFO_EX pstates = {};
+  pstates.version = NV_GPU_DYNAMIC_PSTATES_INFO_EX_VER;
+  if (NvApi().NvAPI_GPU_GetDynamicPstatesInfoEx(source.handle, &pstates) != NVAPI_OK) { return false; }
+  for (NvU32 i = 0; i < 4; ++i) {
+    sample.utilization[i] = pstates.utilization[i].bIsPresent ? pstates.utilization[i].percentage : 0;
+  }
+  return true;
+}
+
+bool QuerySamplePower(const SampleSource &source, GpuSample &sample) {
+  if (!source.hasPowerMonitor) { return false; }
+  NV_GPU_POWER_MONITOR_GET_STATUS statusData = {};
+  statusData.version = NV_GPU_POWER_MONITOR_GET_STATUS_VER;
+  statusData.channelMask = source.powerChannelMask;
+  if (NvApi().NvAPI_GPU_PowerMonitorGetStatus(source.handle, &statusData) != NVAPI_OK) { return false; }
+  sample.totalPowermW = statusData.totalGpuPowermW;
+  for (NvU32 i = 0; i < NV_GPU_POWER_MONITOR_MAX_CHANNELS_V1; ++i) {
+    if (source.powerChannelMask & (1u << i)) { sample.channelPowermW[i] = statusData.channels[i].pwrAvgmW; }
+  }
+  return true;
+}
+
+bool QuerySampleTemperature(const SampleSource &source, GpuSample &sample) {
+  if (source.thermalSensors == 0) { return false; }
+  NV_GPU_THERMAL_SETTINGS thermal = {0};
+  thermal.version = NV_GPU_THERMAL_SETTINGS_VER;
+  if (NvApi().NvAPI_GPU_GetThermalSettings(source.handle, NVAPI_THERMAL_TARGET_ALL, &thermal) != NVAPI_OK) {
+    return false;
+  }
+  for (NvU32 i = 0; i < source.thermalSensors && i < thermal.count; ++i) {
+    sample.temperatureC[i] = thermal.sensor[i].currentTemp;
+  }
+  return true;
+}
+
+bool QuerySampleFan(const SampleSource &source, GpuSample &sample) {
+  if (!source.hasFan) { return false; }
+  NvU32 rpm = 0;
+  if (NvApi().NvAPI_GPU_GetTachReading(source.handle, &rpm) != NVAPI_OK) { return false; }
+  sample.fanRpm = rpm;
+  return true;
+}
+
+bool QuerySamplePerfLimits(const SampleSource &source, GpuSample &sample) {
+  if (!source.hasPerfLimits) { return false; }
+  NV_GPU_PERF_POLICIES_STATUS_PARAMS status = {};
+  status.version = NV_GPU_PERF_POLICIES_STATUS_PARAMS_VER;
+  if (NvApi().NvAPI_GPU_PerfPoliciesGetStatus(source.handle, &status) != NVAPI_OK) { return false; }
+  sample.perfLimitMask = status.limitingPoliciesMask;
+  return true;
+}
+
+void TakeSample(SampleSource &source, NvU64 timestampUs, NvU64 latenessUs, GpuSample &sample) {
+  std::memset(&sample, 0, sizeof(sample));
+  sample.timestampUs = timestampUs;
+  sample.latenessUs = latenessUs;
+  sample.gpuIndex = source.index;
+  if (QuerySampleUtilization(source, sample)) { sample.flags |= kSampleHasUtilization; }
+  if (QuerySampleClocks(source, sample)) { sample.flags |= kSampleHasClocks; }
+  if (QuerySamplePower(source, sample)) { sample.flags |= kSampleHasPower; }
+  if (QuerySampleTemperature(source, sample)) { sample.flags |= kSampleHasTemperature; }
+  if (QuerySampleFan(source, sample)) { sample.flags |= kSampleHasFan; }
+  if (QuerySamplePerfLimits(source, sample)) { sample.flags |= kSampleHasPerfLimits; }
+}
+
+// Probes the metrics that only go into the telemetry log, so unsupported ones cost nothing per tick.
+void ProbeLogMetrics(SampleSource &source) {
+  NV_GPU_THERMAL_SETTINGS thermal = {0};
+  thermal.version = NV_GPU_THERMAL_SETTINGS_VER;
+  if (NvApi().NvAPI_GPU_GetThermalSettings(source.handle, NVAPI_THERMAL_TARGET_ALL, &thermal) == NVAPI_OK) {
+    source.thermalSensors = std::min<NvU32>(thermal.count, NVAPI_MAX_THERMAL_SENSORS_PER_GPU);
+  }
+  NvU32 rpm = 0;
+  source.hasFan = NvApi().NvAPI_GPU_GetTachReading(source.handle, &rpm) == NVAPI_OK;
+  NV_GPU_PERF_POLICIES_STATUS_PARAMS status = {};
+  status.version = NV_GPU_PERF_POLICIES_STATUS_PARAMS_VER;
+  source.hasPerfLimits = NvApi().NvAPI_GPU_PerfPoliciesGetStatus(source.handle, &status) == NVAPI_OK;
+}
+
+// Column names are "gpuN.<metric>", the order here is the order LogSample fills them in.
+void AddLogColumns(SampleSource &source, std::vector<std::string> &columns) {
+  static const char *const kUtilizationColumns[] = {"util.gpu_pct", "util.fb_pct", "util.vid_pct", "util.bus_pct"};
+  source.logColumn = columns.size();
+  char name[64];
+  auto add = [&](const char *metric) {
+    std::snprintf(name, sizeof(name), "gpu%u.%s", source.index, metric);
+    columns.push_back(name);
+  };
+  for (const char *metric : kUtilizationColumns) { add(metric); }
+  add("clock.graphics_khz");
+  add("clock.memory_khz");
+  if (source.hasPowerMonitor) {
+    add("power.total_mw");
+    for (NvU32 i = 0; i < NV_GPU_POWER_MONITOR_MAX_CHANNELS_V1; ++i) {
+      if ((source.powerChannelMask & (1u << i)) == 0) { continue; }
+      char metric[32];
+      std::snprintf(metric, sizeof(metric), "power.ch%u_mw", i);
+      add(metric);
+    }
+  }
+  for (NvU32 i = 0; i < source.thermalSensors; ++i) {
+    char metric[32];
+    std::snprintf(metric, sizeof(metric), "temp.sensor%u_c", i);
+    add(metric);
+  }
+  if (source.hasFan) { add("fan.rpm"); }
+  if (source.hasPerfLimits) { add("perf_limit.mask"); }
+}
+
+void LogSample(TelemetryLogWriter *log, const SampleSource &source, const GpuSample &sample) {
+  size_t column = source.logColumn;
+  for (NvU32 i = 0; i < 4; ++i, ++column) {
+    if (sample.flags & kSampleHasUtilization) { log->Set(column, sample.utilization[i]); }
+  }
+  if (sample.flags & kSampleHasClocks) {
+    log->Set(column, sample.graphicsKHz);
+    log->Set(column + 1, sample.memoryKHz);
+  }
+  column += 2;
+  if (source.hasPowerMonitor) {
+    if (sample.flags & kSampleHasPower) { log->Set(column, sample.totalPowermW); }
+    ++column;
+    for (NvU32 i = 0; i < NV_GPU_POWER_MONITOR_MAX_CHANNELS_V1; ++i) {
+      if ((source.powerChannelMask & (1u << i)) == 0) { continue; }
+      if (sample.flags & kSampleHasPower) { log->Set(column, sample.channelPowermW[i]); }
+      ++column;
+    }
+  }
+  for (NvU32 i = 0; i < source.thermalSensors; ++i, ++column) {
+    if (sample.flags & kSampleHasTemperature) { log->Set(column, sample.temperatureC[i]); }
+  }
+  if (source.hasFan) {
+    if (sample.flags & kSampleHasFan) { log->Set(column, sample.fanRpm); }
+    ++column;
+  }
+  if (source.hasPerfLimits && (sample.flags & kSampleHasPerfLimits)) { log->Set(column, sample.perfLimitMask); }
+}
+
+void WriteSampleRecord(OutputFramer *framer, const GpuSample &sample) {
+  static const char *const kUtilizationKeys[] = {"gpu_pct", "fb_pct", "vid_pct", "bus_pct"};
+  RecordWriter record("sample", framer);
+  record.Field("timestamp_us", sample.timestampUs)
+      .Field("lateness_us", sample.latenessUs)
+      .Field("gpu", sample.gpuIndex);
+  for (NvU32 i = 0; i < 4; ++i) {
+    if (sample.flags & kSampleHasUtilization) {
+      record.Field(kUtilizationKeys[i], sample.utilization[i]);
+    } else {
+      record.Null(kUtilizationKeys[i]);
+    }
+  }
+  if (sample.flags & kSampleHasClocks) {
+    record.Field("graphics_khz", sample.graphicsKHz).Field("memory_khz", sample.memoryKHz);
+  } else {
+    record.Null("graphics_khz").Null("memory_khz");
+  }
+  if (sample.flags & kSampleHasPower) {
+    record.Field("power_mw", sample.totalPowermW);
+  } else {
+    record.Null("power_mw");
+  }
+}
+
+// Samples for stdout go through Printf, so the writer thread follows the caller's capture like any other output.
+void WriteSample(FILE *out, OutputFramer *framer, const GpuSample &sample) {
+  if (StructuredOutput()) {
+    WriteSampleRecord(framer, sample);
+    return;
+  }
+  char line[256];
+  int length = std::snprintf(line, sizeof(line), "t=%llu.%03llu gpu=%u",
+                             static_cast<unsigned long long>(sample.timestampUs / 1000000),
+                             static_cast<unsigned long long>((sample.timestampUs / 1000) % 1000), sample.gpuIndex);
+  const auto append = [&](const char *format, auto... args) {
+    if (length < 0 || static_cast<size_t>(length) >= sizeof(line)) { return; }
+    length += std::snprintf(line + length, sizeof(line) - static_cast<size_t>(length), format, args...);
+  };
+  if (sample.flags & kSampleHasUtilization) {
+    append(" util=%u%% fb=%u%% vid=%u%% bus=%u%%", sample.utilization[0], sample.utilization[1],
+           sample.utilization[2], sample.utilization[3]);
+  } else {
+    append(" util=- fb=- vid=- bus=-");
+  }
+  if (sample.flags & kSampleHasClocks) {
+    append(" graphics=%u kHz memory=%u kHz", sample.graphicsKHz, sample.memoryKHz);
+  } else {
+    append(" graphics=- memory=-");
+  }
+  if (sample.flags & kSampleHasPower) {
+    append(" power=%u mW\n", sample.totalPowermW);
+  } else {
+    append(" power=-\n");
+  }
+  if (out == stdout) {
+    Printf("%s", line);
+  } else {
+    std::fputs(line, out);
+  }
+}
+
+struct SampleLog {
+  TelemetryLogWriter *writer;
+  const std::vector<SampleSource> *sources;
+  NvU64 startUs;
+  bool rowOpen;
+  NvU64 rowTimestampUs;
+};
+
+// Samples of one tick share a timestamp and are merged into one log row, timestamps are wall-clock microseconds.
+void AppendLogSample(SampleLog *log, const GpuSample &sample) {
+  if (!log->rowOpen || sample.timestampUs != log->rowTimestampUs) {
+    if (log->rowOpen) { log->writer->EndRow(); }
+    log->writer->BeginRow(log->startUs + sample.timestampUs);
+    log->rowOpen = true;
+    log->rowTimestampUs = sample.timestampUs;
+  }
+  for (const auto &source : *log->sources) {
+    if (source.index == sample.gpuIndex) { LogSample(log->writer, source, sample); }
+  }
+}
+
+void DrainSamples(SpscRing<GpuSample, kSampleRingCapacity> *ring, const std::atomic<bool> *done, FILE *out,
+                  OutputFramer *framer, OutputShare *share, SampleLog *log, SampleStats *stats) {
+  OutputShare::Worker worker(*share);
+  GpuSample sample = {};
+  for (;;) {
+    // Read the flag before draining so every sample pushed ahead of it is written before exiting.
+    const bool finished = done->load(std::memory_order_acquire);
+    bool popped = false;
+    while (ring->TryPop(&sample)) {
+      if (out) { WriteSample(out, framer, sample); }
+      if (log) { AppendLogSample(log, sample); }
+      ++stats->written;
+      stats->maxLatenessUs = std::max(stats->maxLatenessUs, sample.latenessUs);
+      popped = true;
+    }
+    if (finished) { break; }
+    if (popped) {
+      if (out) { std::fflush(out); }
+    } else {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  if (out) { std::fflush(out); }
+  if (log && log->rowOpen) { log->writer->EndRow(); }
+}
+} // namespace
+
+int CmdGpuSample(int argc, char **argv) {
+  NvU32 index = 0;
+  bool hasIndex = false;
+  NvU32 intervalMs = 100;
+  NvU32 durationSec = 10;
+  const char *outPath = nullptr;
+  const char *logPath = nullptr;
+
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--index") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
+        Printf("Invalid GPU index.\n");
+        return 1;
+      }
+      hasIndex = true;
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--interval-ms") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &intervalMs) || intervalMs == 0) {
+        Printf("Invalid value for --interval-ms\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--duration") == 0) {
+      if (i + 1 >= argc || !ParseUint(argv[i + 1], &durationSec) || durationSec == 0) {
+        Printf("Invalid value for --duration\n");
+        return 1;
+      }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--out") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --out\n");
+        return 1;
+      }
+      outPath = argv[i + 1];
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--log") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --log\n");
+        return 1;
+      }
+      logPath = argv[i + 1];
+      ++i;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+
+  std::vector<NvPhysicalGpuHandle> handles;
+  std::vector<NvU32> indices;
+  if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
+
+  std::vector<SampleSource> sources;
+  for (size_t i = 0; i < handles.size(); ++i) {
+    SampleSource source = {};
+    source.handle = handles[i];
+    source.index = indices[i];
+    NV_GPU_POWER_MONITOR_GET_INFO info = {};
+    info.version = NV_GPU_POWER_MONITOR_GET_INFO_VER;
+    if (NvApi().NvAPI_GPU_PowerMonitorGetInfo(handles[i], &info) == NVAPI_OK && info.bSupported) {
+      source.hasPowerMonitor = true;
+      source.powerChannelMask = info.channelMask;
+    }
+    if (logPath) { ProbeLogMetrics(source); }
+    sources.push_back(source);
+  }
+
+  TelemetryLogWriter logWriter;
+  SampleLog log = {};
+  if (logPath) {
+    std::vector<std::string> columns;
+    for (auto &source : sources) { AddLogColumns(source, columns); }
+    if (!logWriter.Open(logPath, columns)) { return 1; }
+    log.writer = &logWriter;
+    log.sources = &sources;
+    log.startUs = static_cast<NvU64>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                         std::chrono::system_clock::now().time_since_epoch())
+                                         .count());
+  }
+
+  // With --log the samples only go to the log, unless --out asks for a copy.
+  FILE *out = logPath && !outPath ? nullptr : stdout;
+  if (outPath) {
+    if (fopen_s(&out, outPath, "w") != 0 || !out) {
+      Printf("Failed to open %s\n", outPath);
+      return 1;
+    }
+  }
+
+  // Records and lines for stdout go to the caller's destination (its capture under serve) with the shared framing,
+  // a file gets its own document.
+  auto fileFramer = std::make_unique<OutputFramer>(out);
+  OutputFramer *framer = out == stdout ? nullptr : fileFramer.get();
+  auto ring = std::make_unique<SpscRing<GpuSample, kSampleRingCapacity>>();
+  std::atomic<bool> done{false};
+  SampleStats stats = {};
+  NvU64 dropped = 0;
+  NvU64 taken = 0;
+
+  {
+    TimerResolution resolution;
+    OutputShare share;
+    std::thread writer(DrainSamples, ring.get(), &done, out, framer, &share, logPath ? &log : nullptr, &stats);
+
+    const auto interval = std::chrono::milliseconds(intervalMs);
+    const auto start = SampleClock::now();
+    const auto end = start + std::chrono::seconds(durationSec);
+    auto deadline = start;
+    while (deadline < end) {
+      std::this_thread::sleep_until(deadline);
+      const auto now = SampleClock::now();
+      const NvU64 timestampUs =
+          static_cast<NvU64>(std::chrono::duration_cast<std::chrono::microseconds>(now - start).count());
+      const NvU64 latenessUs =
+          static_cast<NvU64>(std::chrono::duration_cast<std::chrono::microseconds>(now - deadline).count());
+      for (auto &source : sources) {
+        GpuSample sample;
+        TakeSample(source, timestampUs, latenessUs, sample);
+        ++taken;
+        if (!ring->TryPush(sample)) { ++dropped; }
+      }
+
+      // Skip ticks that were missed entirely instead of bursting to catch up.
+      deadline += interval;
+      const auto after = SampleClock::now();
+      if (after > deadline + interval) { deadline = after - (after - deadline) % interval; }
+    }
+
+    done.store(true, std::memory_order_release);
+    writer.join();
+  }
+
+  if (out && out != stdout) {
+    if (StructuredOutput()) { fileFramer->Finish(); }
+    std::fclose(out);
+  }
+  if (logPath && !logWriter.Close()) { return 1; }
+  if (StructuredOutput()) {
+    RecordWriter("sample_summary")
+        .Field("taken", taken)
+        .Field("written", stats.written)
+        .Field("dropped", dropped)
+        .Field("max_lateness_us", stats.maxLatenessUs);
+    return 0;
+  }
+  Printf("Samples: %llu taken, %llu written, %llu dropped, max lateness %llu us\n",
+         static_cast<unsigned long long>(taken), static_cast<unsigned long long>(stats.written),
+         static_cast<unsigned long long>(dropped), static_cast<unsigned long long>(stats.maxLatenessUs));
+  return 0;
+}
+} // namespace nvcli
@@ -0,0 +1,822 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+
+#include <io.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace nvcli {
+namespace {
+using TuneClock = std::chrono::steady_clock;
+
+enum TuneKnob { kTuneClock = 0, kTuneVoltage = 1 };
+enum TuneStrategy { kTuneGolden = 0, kTuneBisect = 1 };
+
+const char *TuneKnobName(TuneKnob knob) { return knob == kTuneVoltage ? "voltage" : "clock"; }
+
+// The pstates20 delta a tune walks: a clock domain offset in kHz or a base voltage offset in uV.
+struct TuneTarget {
+  TuneKnob knob;
+  NV_GPU_PERF_PSTATE_ID pstateId;
+  NvU32 domainId;
+};
+
+const char *TuneDomainName(const TuneTarget &target) {
+  if (target.knob == kTuneVoltage) {
+    return VoltageDomainName(static_cast<NV_GPU_PERF_VOLTAGE_INFO_DOMAIN_ID>(target.domainId));
+  }
+  return ClockDomainName(target.domainId);
+}
+
+const char *TuneUnit(const TuneTarget &target) { return target.knob == kTuneVoltage ? "uV" : "kHz"; }
+
+// The delta of the targeted entry inside info, NULL with the reason printed when the pstate or domain is missing or
+// not editable.
+NV_GPU_PERF_PSTATES20_PARAM_DELTA *FindTuneDelta(NV_GPU_PERF_PSTATES20_INFO &info, const TuneTarget &target,
+                                                 NvU32 *pstateIndex) {
+  if (!info.bIsEditable) {
+    Printf("  Pstates20 not editable on this GPU.\n");
+    return NULL;
+  }
+  for (NvU32 p = 0; p < info.numPstates && p < NVAPI_MAX_GPU_PSTATE20_PSTATES; ++p) {
+    auto &pstate = info.pstates[p];
+    if (pstate.pstateId != target.pstateId) { continue; }
+    *pstateIndex = p;
+    if (target.knob == kTuneClock) {
+      for (NvU32 c = 0; c < info.numClocks && c < NVAPI_MAX_GPU_PSTATE20_CLOCKS; ++c) {
+        if (pstate.clocks[c].domainId != static_cast<NV_GPU_PUBLIC_CLOCK_ID>(target.domainId)) { continue; }
+        if (!pstate.clocks[c].bIsEditable) { break; }
+        return &pstate.clocks[c].freqDelta_kHz;
+      }
+    } else {
+      for (NvU32 v = 0; v < info.numBaseVoltages && v < NVAPI_MAX_GPU_PSTATE20_BASE_VOLTAGES; ++v) {
+        const auto domainId = static_cast<NV_GPU_PERF_VOLTAGE_INFO_DOMAIN_ID>(target.domainId);
+        if (pstate.baseVoltages[v].domainId != domainId) { continue; }
+        if (!pstate.baseVoltages[v].bIsEditable) { break; }
+        return &pstate.baseVoltages[v].voltDelta_uV;
+      }
+    }
+    Printf("  %s %s not found or not editable in %s.\n", TuneDomainName(target), TuneKnobName(target.knob),
+           PstateName(target.pstateId));
+    return NULL;
+  }
+  Printf("  Pstate not found: %s\n", PstateName(target.pstateId));
+  return NULL;
+}
+
+bool ReadTuneDelta(NvPhysicalGpuHandle handle, const TuneTarget &target, NV_GPU_PERF_PSTATES20_PARAM_DELTA *out) {
+  std::unique_ptr<NV_GPU_PERF_PSTATES20_INFO> info(new NV_GPU_PERF_PSTATES20_INFO());
+  info->version = NV_GPU_PERF_PSTATES20_INFO_VER;
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetPstates20(handle, info.get());
+  if (status != NVAPI_OK) {
+    PrintNvapiError("  NvAPI_GPU_GetPstates20 failed", status);
+    return false;
+  }
+  NvU32 pstateIndex = 0;
+  const NV_GPU_PERF_PSTATES20_PARAM_DELTA *delta = FindTuneDelta(*info, target, &pstateIndex);
+  if (!delta) { return false; }
+  *out = *delta;
+  return true;
+}
+
+// Writes one delta the same way pstates20-set does, only the targeted entry stays defined in the request.
+NvAPI_Status WriteTuneDelta(NvPhysicalGpuHandle handle, const TuneTarget &target, NvS32 value) {
+  std::unique_ptr<NV_GPU_PERF_PSTATES20_INFO> info(new NV_GPU_PERF_PSTATES20_INFO());
+  info->version = NV_GPU_PERF_PSTATES20_INFO_VER;
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetPstates20(handle, info.get());
+  if (status != NVAPI_OK) { return status; }
+  NvU32 pstateIndex = 0;
+  NV_GPU_PERF_PSTATES20_PARAM_DELTA *delta = FindTuneDelta(*info, target, &pstateIndex);
+  if (!delta) { return NVAPI_NOT_SUPPORTED; }
+  delta->value = value;
+
+  std::unique_ptr<NV_GPU_PERF_PSTATES20_INFO> setInfo(new NV_GPU_PERF_PSTATES20_INFO());
+  setInfo->version = info->version;
+  setInfo->bIsEditable = info->bIsEditable;
+  setInfo->numPstates = 1;
+  setInfo->numClocks = info->numClocks;
+  setInfo->numBaseVoltages = info->numBaseVoltages;
+  setInfo->pstates[0] = info->pstates[pstateIndex];
+  setInfo->ov.numVoltages = 0;
+  for (NvU32 c = 0; c < setInfo->numClocks && c < NVAPI_MAX_GPU_PSTATE20_CLOCKS; ++c) {
+    auto &entry = setInfo->pstates[0].clocks[c];
+    if (target.knob != kTuneClock || entry.domainId != static_cast<NV_GPU_PUBLIC_CLOCK_ID>(target.domainId)) {
+      entry.domainId = NVAPI_GPU_PUBLIC_CLOCK_UNDEFINED;
+    }
+  }
+  for (NvU32 v = 0; v < setInfo->numBaseVoltages && v < NVAPI_MAX_GPU_PSTATE20_BASE_VOLTAGES; ++v) {
+    auto &entry = setInfo->pstates[0].baseVoltages[v];
+    if (target.knob != kTuneVoltage ||
+        entry.domainId != static_cast<NV_GPU_PERF_VOLTAGE_INFO_DOMAIN_ID>(target.domainId)) {
+      entry.domainId = NVAPI_GPU_PERF_VOLTAGE_INFO_DOMAIN_UNDEFINED;
+    }
+  }
+  return NvApi().NvAPI_GPU_SetPstates20(handle, setInfo.get());
+}
+
+// Append-only text journal of a tune, flushed to disk before every write it describes. A "tune" line without a later
+// "restore ... ok" or "keep" means the GPU may still carry a trial offset, the next run writes the original back
+// before doing anything else.
+//   tune <gpu> <clock|voltage> <pstateId> <domainId> <original>
+//   set <gpu> <value>
+//   result <gpu> <value> <mhzPerW|failed>
+//   restore <gpu> <ok|status>
+//   keep <gpu> <value>
+class TuneJournal {
+public:
+  struct Pending {
+    TuneTarget target;
+    NvS32 original;
+  };
+
+  ~TuneJournal() {
+    if (m_file) { std::fclose(m_file); }
+  }
+
+  bool Open(const char *path) {
+    FILE *existing = nullptr;
+    if (fopen_s(&existing, path, "r") == 0 && existing) {
+      char line[256];
+      while (std::fgets(line, sizeof(line), existing)) {
+        char verb[16] = {0};
+        char word[16] = {0};
+        unsigned gpu = 0;
+        unsigned pstateId = 0;
+        unsigned domainId = 0;
+        int original = 0;
+        if (std::sscanf(line, "%15s %u %15s", verb, &gpu, word) < 3) { continue; }
+        if (std::strcmp(verb, "tune") == 0 &&
+            std::sscanf(line, "%*s %*u %*s %u %u %d", &pstateId, &domainId, &original) == 3) {
+          const TuneKnob knob = std::strcmp(word, "voltage") == 0 ? kTuneVoltage : kTuneClock;
+          m_pending[gpu] = {{knob, static_cast<NV_GPU_PERF_PSTATE_ID>(pstateId), domainId}, original};
+        }
+        if ((std::strcmp(verb, "restore") == 0 && std::strcmp(word, "ok") == 0) || std::strcmp(verb, "keep") == 0) {
+          m_pending.erase(gpu);
+        }
+      }
+      std::fclose(existing);
+    }
+    if (fopen_s(&m_file, path, "a") != 0 || !m_file) {
+      Printf("Failed to open journal %s\n", path);
+      m_file = nullptr;
+      return false;
+    }
+    return true;
+  }
+
+  const std::map<NvU32, Pending> &PendingRestores() const { return m_pending; }
+
+  // GPUs are tuned in parallel, lines of different GPUs interleave but never tear.
+  void Write(const char *format, ...) {
+    std::lock_guard<std::mutex> guard(m_lock);
+    va_list args;
+    va_start(args, format);
+    std::vfprintf(m_file, format, args);
+    va_end(args);
+    std::fputc('\n', m_file);
+    std::fflush(m_file);
+    _commit(_fileno(m_file));
+  }
+
+private:
+  FILE *m_file = nullptr;
+  std::mutex m_lock;
+  std::map<NvU32, Pending> m_pending;
+};
+
+bool RestoreTuneDelta(NvU32 gpu, NvPhysicalGpuHandle handle, const TuneTarget &target, NvS32 original,
+                      TuneJournal *journal) {
+  NvAPI_Status status = WriteTuneDelta(handle, target, original);
+  journal->Write("restore %u %s", gpu, status == NVAPI_OK ? "ok" : NvapiStatusString(status).c_str());
+  if (status != NVAPI_OK) {
+    PrintNvapiError("  Restoring the original pstates20 delta failed", status);
+    return false;
+  }
+  return true;
+}
+
+std::atomic<bool> g_tuneStop{false};
+
+BOOL WINAPI TuneCtrlHandler(DWORD type) {
+  if (type != CTRL_C_EVENT && type != CTRL_BREAK_EVENT) { return FALSE; }
+  g_tuneStop = true;
+  return TRUE;
+}
+
+struct TuneSettings {
+  TuneTarget target;
+  TuneStrategy strategy;
+  NvS32 minValue;
+  NvS32 maxValue;
+  NvS32 step;
+  double targetPpw;
+  NvU32 maxSteps;
+  NvU32 settleMs;
+  NvU32 windowMs;
+  NvU32 intervalMs;
+  NvU32 rejectMask;
+  bool apply;
+};
+
+struct TuneProbe {
+  NvU32 powerChannelMask;
+  NvU32 totalChannel;
+  NvU32 clockVersion;
+};
+
+struct TuneMeasure {
+  double clockMhz;
+  double powerW;
+  double mhzPerW;
+  NvU32 limitMask;
+  // A policy from --reject-limit limited the window, the point scores zero.
+  bool rejected;
+};
+
+bool ReadTuneClock(NvPhysicalGpuHandle handle, TuneProbe *probe, NvU32 *khz) {
+  static const NvU32 kVersions[] = {NV_GPU_CLOCK_FREQUENCIES_VER, NV_GPU_CLOCK_FREQUENCIES_VER_2,
+                                    NV_GPU_CLOCK_FREQUENCIES_VER_1};
+  NV_GPU_CLOCK_FREQUENCIES clocks = {};
+  NvAPI_Status status = NVAPI_INCOMPATIBLE_STRUCT_VERSION;
+  for (NvU32 version : kVersions) {
+    if (probe->clockVersion != 0 && version != probe->clockVersion) { continue; }
+    std::memset(&clocks, 0, sizeof(clocks));
+    clocks.version = version;
+    clocks.ClockType = NV_GPU_CLOCK_FREQUENCIES_CURRENT_FREQ;
+    status = NvApi().NvAPI_GPU_GetAllClockFrequencies(handle, &clocks);
+    if (status != NVAPI_INCOMPATIBLE_STRUCT_VERSION) { break; }
+  }
+  if (status != NVAPI_OK) { return false; }
+  probe->clockVersion = clocks.version;
+  const auto &graphics = clocks.domain[NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS];
+  if (!graphics.bIsPresent) { return false; }
+  *khz = graphics.frequency;
+  return true;
+}
+
+bool ReadTunePower(NvPhysicalGpuHandle handle, const TuneProbe &probe, NvU32 *powermW, NvU64 *energymJ) {
+  NV_GPU_POWER_MONITOR_GET_STATUS status = {};
+  status.version = NV_GPU_POWER_MONITOR_GET_STATUS_VER;
+  status.channelMask = probe.powerChannelMask;
+  if (NvApi().NvAPI_GPU_PowerMonitorGetStatus(handle, &status) != NVAPI_OK) { return false; }
+  *powermW = status.totalGpuPowermW;
+  *energymJ = probe.totalChannel < NV_GPU_POWER_MONITOR_MAX_CHANNELS_V1 ? status.channels[probe.totalChannel].energymJ
+                                                                         : 0;
+  return true;
+}
+
+// Perf is the average graphics clock under whatever steady load runs during the window, power comes from the
+// total-GPU channel energy counter, or the average of the instantaneous readings when the counter does not move.
+bool MeasureTune(NvPhysicalGpuHandle handle, TuneProbe *probe, const TuneSettings &settings, TuneMeasure *out) {
+  NvU32 powermW = 0;
+  NvU64 startEnergy = 0;
+  if (!ReadTunePower(handle, *probe, &powermW, &startEnergy)) { return false; }
+  const auto start = TuneClock::now();
+  const auto end = start + std::chrono::milliseconds(settings.windowMs);
+
+  double clockSum = 0.0;
+  double powerSum = 0.0;
+  NvU32 clockSamples = 0;
+  NvU32 powerSamples = 0;
+  NvU64 endEnergy = startEnergy;
+  out->limitMask = 0;
+  for (auto next = start + std::chrono::milliseconds(settings.intervalMs); next <= end;
+       next += std::chrono::milliseconds(settings.intervalMs)) {
+    std::this_thread::sleep_until(next);
+    NvU32 khz = 0;
+    if (ReadTuneClock(handle, probe, &khz)) {
+      clockSum += khz / 1000.0;
+      ++clockSamples;
+    }
+    if (ReadTunePower(handle, *probe, &powermW, &endEnergy)) {
+      powerSum += powermW / 1000.0;
+      ++powerSamples;
+    }
+    NV_GPU_PERF_POLICIES_STATUS_PARAMS policies = {};
+    policies.version = NV_GPU_PERF_POLICIES_STATUS_PARAMS_VER;
+    if (NvApi().NvAPI_GPU_PerfPoliciesGetStatus(handle, &policies) == NVAPI_OK) {
+      out->limitMask |= policies.limitingPoliciesMask;
+    }
+  }
+  if (clockSamples == 0 || powerSamples == 0) { return false; }
+
+  const double elapsedMs = std::chrono::duration<double, std::milli>(TuneClock::now() - start).count();
+  out->clockMhz = clockSum / clockSamples;
+  // mJ per ms is W.
+  out->powerW = endEnergy > startEnergy && elapsedMs > 0.0 ? (endEnergy - startEnergy) / elapsedMs
+                                                           : powerSum / powerSamples;
+  out->mhzPerW = out->powerW > 0.0 ? out->clockMhz / out->powerW : 0.0;
+  out->rejected = (out->limitMask & settings.rejectMask) != 0;
+  return true;
+}
+
+std::string PolicyMaskNames(NvU32 mask) {
+  std::string names;
+  for (NvU32 id = 0; id < 32; ++id) {
+    if (!(mask & (1u << id))) { continue; }
+    if (!names.empty()) { names += ","; }
+    const char *name = PerfPolicyName(id);
+    names += name ? name : "policy" + std::to_string(id);
+  }
+  return names.empty() ? "-" : names;
+}
+
+// One GPU's search over the offset grid minValue + k * step, every point is measured at most once.
+class TuneRun {
+public:
+  TuneRun(NvU32 gpu, NvPhysicalGpuHandle handle, const TuneSettings &settings, TuneJournal *journal)
+      : m_gpu(gpu), m_handle(handle), m_settings(settings), m_journal(journal) {}
+
+  bool Probe() {
+    NV_GPU_POWER_MONITOR_GET_INFO info = {};
+    info.version = NV_GPU_POWER_MONITOR_GET_INFO_VER;
+    NvAPI_Status status = NvApi().NvAPI_GPU_PowerMonitorGetInfo(m_handle, &info);
+    if (status != NVAPI_OK) {
+      PrintNvapiError("  NvAPI_GPU_PowerMonitorGetInfo failed", status);
+      return false;
+    }
+    if (!info.bSupported) {
+      Printf("  Power monitor not supported, perf per watt cannot be measured.\n");
+      return false;
+    }
+    m_probe.powerChannelMask = info.channelMask;
+    m_probe.totalChannel = info.channelMask & (1u << info.totalGpuChannelIdx) ? info.totalGpuChannelIdx
+                                                                              : NV_GPU_POWER_MONITOR_MAX_CHANNELS_V1;
+    return true;
+  }
+
+  // Scores the offset currently on the GPU without writing anything.
+  bool Baseline(NvS32 original) {
+    TuneMeasure measure = {};
+    if (!MeasureTune(m_handle, &m_probe, m_settings, &measure)) {
+      Printf("  Baseline measurement failed.\n");
+      return false;
+    }
+    m_baseline = measure;
+    PrintStep("baseline", original, measure);
+    return true;
+  }
+
+  bool Search() {
+    const NvU32 last = static_cast<NvU32>((m_settings.maxValue - m_settings.minValue) / m_settings.step);
+    return m_settings.strategy == kTuneBisect ? Bisect(last) : Golden(last);
+  }
+
+  bool HasBest() const { return m_hasBest; }
+  NvS32 Best() const { return m_best; }
+  const TuneMeasure &BestMeasure() const { return m_points.at(m_best); }
+  const TuneMeasure &BaselineMeasure() const { return m_baseline; }
+  NvU32 Steps() const { return m_steps; }
+  bool Failed() const { return m_failed; }
+  bool Interrupted() const { return m_interrupted; }
+  bool Reached() const { return m_reached; }
+
+private:
+  NvS32 Value(NvU32 k) const { return m_settings.minValue + static_cast<NvS32>(k) * m_settings.step; }
+
+  double Score(const TuneMeasure &measure) const { return measure.rejected ? 0.0 : measure.mhzPerW; }
+
+  // Applies and measures grid point k, false when the search has to stop (write or read failure, step budget, or
+  // Ctrl+C). A stop leaves *score untouched.
+  bool Evaluate(NvU32 k, double *score) {
+    const NvS32 value = Value(k);
+    auto cached = m_points.find(value);
+    if (cached != m_points.end()) {
+      *score = Score(cached->second);
+      return true;
+    }
+    if (g_tuneStop) {
+      m_interrupted = true;
+      return false;
+    }
+    if (m_steps >= m_settings.maxSteps) { return false; }
+    ++m_steps;
+
+    m_journal->Write("set %u %d", m_gpu, value);
+    NvAPI_Status status = WriteTuneDelta(m_handle, m_settings.target, value);
+    if (status != NVAPI_OK) {
+      PrintNvapiError("  NvAPI_GPU_SetPstates20 failed", status);
+      m_failed = true;
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(m_settings.settleMs));
+    TuneMeasure measure = {};
+    if (!MeasureTune(m_handle, &m_probe, m_settings, &measure)) {
+      m_journal->Write("result %u %d failed", m_gpu, value);
+      Printf("  Measurement at %d %s failed.\n", value, TuneUnit(m_settings.target));
+      m_failed = true;
+      return false;
+    }
+    m_journal->Write("result %u %d %.4f", m_gpu, value, measure.mhzPerW);
+    m_points[value] = measure;
+    PrintStep("step", value, measure);
+    *score = Score(measure);
+    return true;
+  }
+
+  void Consider(NvU32 k, double score) {
+    if (m_hasBest && score <= Score(m_points.at(m_best))) { return; }
+    m_best = Value(k);
+    m_hasBest = score > 0.0;
+  }
+
+  bool MeetsTarget(double score) const { return m_settings.targetPpw > 0.0 && score >= m_settings.targetPpw; }
+
+  // Highest offset whose score still meets the target, assuming perf per watt falls as the offset rises.
+  bool Bisect(NvU32 last) {
+    double score = 0.0;
+    if (!Evaluate(0, &score)) { return !m_failed; }
+    if (!MeetsTarget(score)) { return true; }
+    m_best = Value(0);
+    m_hasBest = true;
+    m_reached = true;
+    if (!Evaluate(last, &score)) { return !m_failed; }
+    if (MeetsTarget(score)) {
+      m_best = Value(last);
+      return true;
+    }
+    NvU32 good = 0;
+    NvU32 bad = last;
+    while (bad - good > 1) {
+      const NvU32 mid = good + (bad - good) / 2;
+      if (!Evaluate(mid, &score)) { return !m_failed; }
+      if (MeetsTarget(score)) {
+        good = mid;
+        m_best = Value(mid);
+      } else {
+        bad = mid;
+      }
+    }
+    return true;
+  }
+
+  // Golden-section search for the highest perf per watt, assuming one peak over the range. Stops early at the first
+  // point that meets --target.
+  bool Golden(NvU32 last) {
+    NvU32 a = 0;
+    NvU32 b = last;
+    double score = 0.0;
+    while (b - a > 2) {
+      NvU32 c = a + static_cast<NvU32>((b - a) * 0.381966 + 0.5);
+      NvU32 d = a + static_cast<NvU32>((b - a) * 0.618034 + 0.5);
+      if (c == d) { ++d; }
+      double scoreC = 0.0;
+      double scoreD = 0.0;
+      if (!Evaluate(c, &scoreC)) { return !m_failed; }
+      Consider(c, scoreC);
+      if (MeetsTarget(scoreC)) { return Reach(c); }
+      if (!Evaluate(d, &scoreD)) { return !m_failed; }
+      Consider(d, scoreD);
+      if (MeetsTarget(scoreD)) { return Reach(d); }
+      if (scoreC >= scoreD) {
+        b = d;
+      } else {
+        a = c;
+      }
+    }
+    for (NvU32 k = a; k <= b; ++k) {
+      if (!Evaluate(k, &score)) { return !m_failed; }
+      Consider(k, score);
+      if (MeetsTarget(score)) { return Reach(k); }
+    }
+    return true;
+  }
+
+  bool Reach(NvU32 k) {
+    m_best = Value(k);
+    m_hasBest = true;
+    m_reached = true;
+    return true;
+  }
+
+  void PrintStep(const char *kind, NvS32 value, const TuneMeasure &measure) const {
+    const std::string limits = PolicyMaskNames(measure.limitMask);
+    if (StructuredOutput()) {
+      RecordWriter("tune_step")
+          .Field("kind", kind)
+          .Field("knob", TuneKnobName(m_settings.target.knob))
+          .Field("offset", value)
+          .Field("clock_mhz", measure.clockMhz)
+          .Field("power_w", measure.powerW)
+          .Field("mhz_per_w", measure.mhzPerW)
+          .Hex("limit_mask", measure.limitMask)
+          .Field("limits", limits)
+          .Field("rejected", measure.rejected);
+      return;
+    }
+    Printf("  %-8s %+9d %-3s %9.1f MHz %8.1f W %8.3f MHz/W  %s%s\n", kind, value, TuneUnit(m_settings.target),
+           measure.clockMhz, measure.powerW, measure.mhzPerW, limits.c_str(), measure.rejected ? " (rejected)" : "");
+  }
+
+  NvU32 m_gpu;
+  NvPhysicalGpuHandle m_handle;
+  const TuneSettings &m_settings;
+  TuneJournal *m_journal;
+  TuneProbe m_probe = {};
+  TuneMeasure m_baseline = {};
+  std::map<NvS32, TuneMeasure> m_points;
+  NvS32 m_best = 0;
+  bool m_hasBest = false;
+  bool m_reached = false;
+  bool m_failed = false;
+  bool m_interrupted = false;
+  NvU32 m_steps = 0;
+};
+
+bool ParseTuneStrategy(const char *value, TuneStrategy *out) {
+  if (std::strcmp(value, "golden") == 0) {
+    *out = kTuneGolden;
+    return true;
+  }
+  if (std::strcmp(value, "bisect") == 0) {
+    *out = kTuneBisect;
+    return true;
+  }
+  return false;
+}
+
+bool ParsePolicyName(const char *value, NvU32 *mask) {
+  const std::string lowered = ToLowerAscii(value);
+  for (NvU32 id = 0; id < 32; ++id) {
+    const char *name = PerfPolicyName(id);
+    if (name && lowered == name) {
+      *mask |= 1u << id;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Writes back every original an interrupted run left on a GPU.
+bool RestorePendingTunes(TuneJournal *journal) {
+  for (const auto &entry : journal->PendingRestores()) {
+    std::vector<NvPhysicalGpuHandle> handles;
+    std::vector<NvU32> indices;
+    if (!CollectGpus(true, entry.first, handles, indices)) { return false; }
+    const TuneTarget &target = entry.second.target;
+    Printf("Restoring GPU[%u] %s %s %s delta %d %s left by an interrupted tune\n", entry.first,
+           PstateName(target.pstateId), TuneDomainName(target), TuneKnobName(target.knob), entry.second.original,
+           TuneUnit(target));
+    if (!RestoreTuneDelta(entry.first, handles[0], target, entry.second.original, journal)) { return false; }
+  }
+  return true;
+}
+} // namespace
+
+int CmdGpuTune(int argc, char **argv) {
+  NvU32 index = 0;
+  bool hasIndex = false;
+  const char *journalPath = nullptr;
+  bool hasMin = false;
+  bool hasMax = false;
+  bool hasStep = false;
+  NV_GPU_PERF_PSTATE_ID pstateId = NVAPI_GPU_PERF_PSTATE_P0;
+  NV_GPU_PUBLIC_CLOCK_ID clockId = NVAPI_GPU_PUBLIC_CLOCK_GRAPHICS;
+  NV_GPU_PERF_VOLTAGE_INFO_DOMAIN_ID voltageId = NVAPI_GPU_PERF_VOLTAGE_INFO_DOMAIN_CORE;
+  TuneSettings settings = {};
+  settings.target.knob = kTuneClock;
+  settings.strategy = kTuneGolden;
+  settings.maxSteps = 16;
+  settings.settleMs = 2000;
+  settings.windowMs = 5000;
+  settings.intervalMs = 100;
+
+  for (int i = 0; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (std::strcmp(arg, "--apply") == 0) {
+      settings.apply = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      Printf("Missing value for %s\n", arg);
+      return 1;
+    }
+    const char *value = argv[++i];
+    if (std::strcmp(arg, "--index") == 0) {
+      if (!ParseUint(value, &index)) {
+        Printf("Invalid GPU index.\n");
+        return 1;
+      }
+      hasIndex = true;
+    } else if (std::strcmp(arg, "--journal") == 0) {
+      journalPath = value;
+    } else if (std::strcmp(arg, "--knob") == 0) {
+      if (std::strcmp(value, "clock") == 0) {
+        settings.target.knob = kTuneClock;
+      } else if (std::strcmp(value, "voltage") == 0) {
+        settings.target.knob = kTuneVoltage;
+      } else {
+        Printf("Invalid --knob value, expected clock|voltage.\n");
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--pstate") == 0) {
+      if (!ParsePstateId(value, &pstateId)) {
+        Printf("Invalid pstate.\n");
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--clock") == 0) {
+      if (!ParsePublicClockId(value, &clockId)) {
+        Printf("Invalid clock domain.\n");
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--voltage") == 0) {
+      if (!ParseVoltageDomainId(value, &voltageId)) {
+        Printf("Invalid voltage domain.\n");
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--min") == 0) {
+      if (!ParseInt(value, &settings.minValue)) {
+        Printf("Invalid --min value.\n");
+        return 1;
+      }
+      hasMin = true;
+    } else if (std::strcmp(arg, "--max") == 0) {
+      if (!ParseInt(value, &settings.maxValue)) {
+        Printf("Invalid --max value.\n");
+        return 1;
+      }
+      hasMax = true;
+    } else if (std::strcmp(arg, "--step") == 0) {
+      if (!ParseInt(value, &settings.step) || settings.step <= 0) {
+        Printf("Invalid --step value.\n");
+        return 1;
+      }
+      hasStep = true;
+    } else if (std::strcmp(arg, "--strategy") == 0) {
+      if (!ParseTuneStrategy(value, &settings.strategy)) {
+        Printf("Invalid --strategy value, expected golden|bisect.\n");
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--target") == 0) {
+      if (!ParseDoubleValue(value, &settings.targetPpw) || settings.targetPpw <= 0.0) {
+        Printf("Invalid --target value.\n");
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--max-steps") == 0) {
+      if (!ParseUint(value, &settings.maxSteps) || settings.maxSteps == 0) {
+        Printf("Invalid --max-steps value.\n");
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--settle-ms") == 0) {
+      if (!ParseUint(value, &settings.settleMs)) {
+        Printf("Invalid --settle-ms value.\n");
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--window-ms") == 0) {
+      if (!ParseUint(value, &settings.windowMs) || settings.windowMs == 0) {
+        Printf("Invalid --window-ms value.\n");
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--interval-ms") == 0) {
+      if (!ParseUint(value, &settings.intervalMs) || settings.intervalMs == 0) {
+        Printf("Invalid --interval-ms value.\n");
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--reject-limit") == 0) {
+      if (!ParsePolicyName(value, &settings.rejectMask)) {
+        Printf("Invalid --reject-limit value, expected power|thermal|reliability|operating|utilization|sli-sync.\n");
+        return 1;
+      }
+    } else {
+      Printf("Unknown option: %s\n", arg);
+      return 1;
+    }
+  }
+
+  settings.target.pstateId = pstateId;
+  settings.target.domainId = settings.target.knob == kTuneVoltage ? static_cast<NvU32>(voltageId)
+                                                                   : static_cast<NvU32>(clockId);
+  if (!hasStep) { settings.step = settings.target.knob == kTuneVoltage ? 12500 : 15000; }
+  if (!journalPath) {
+    Printf("Missing required --journal\n");
+    return 1;
+  }
+  if (hasMin != hasMax) {
+    Printf("Both --min and --max are required together.\n");
+    return 1;
+  }
+  if (hasMin && settings.minValue >= settings.maxValue) {
+    Printf("--min must be below --max\n");
+    return 1;
+  }
+  if (settings.strategy == kTuneBisect && settings.targetPpw <= 0.0) {
+    Printf("--strategy bisect needs --target\n");
+    return 1;
+  }
+  if (settings.intervalMs > settings.windowMs) {
+    Printf("--interval-ms must not exceed --window-ms\n");
+    return 1;
+  }
+
+  // Offsets an interrupted run left behind are restored before anything else, with only --journal that is all it does.
+  TuneJournal journal;
+  if (!journal.Open(journalPath)) { return 1; }
+  if (!RestorePendingTunes(&journal)) { return 1; }
+  if (!hasMin) { return 0; }
+
+  std::vector<NvPhysicalGpuHandle> handles;
+  std::vector<NvU32> indices;
+  if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
+
+  g_tuneStop = false;
+  SetConsoleCtrlHandler(TuneCtrlHandler, TRUE);
+  const auto tuneGpu = [&](size_t i) {
+    const TuneTarget &target = settings.target;
+
+    NV_GPU_PERF_PSTATES20_PARAM_DELTA original = {};
+    if (!ReadTuneDelta(handles[i], target, &original)) { return 1; }
+    if (settings.minValue < original.valueRange.min || settings.maxValue > original.valueRange.max) {
+      Printf("  Range %d to %d %s is outside the allowed %d to %d.\n", settings.minValue, settings.maxValue,
+             TuneUnit(target), original.valueRange.min, original.valueRange.max);
+      return 1;
+    }
+
+    TuneRun run(indices[i], handles[i], settings, &journal);
+    if (!run.Probe()) { return 1; }
+    if (!StructuredOutput()) {
+      Printf("  Tuning %s %s %s delta, original %d %s\n", PstateName(target.pstateId), TuneDomainName(target),
+             TuneKnobName(target.knob), original.value, TuneUnit(target));
+    }
+    if (!run.Baseline(original.value)) { return 1; }
+
+    journal.Write("tune %u %s %u %u %d", indices[i], TuneKnobName(target.knob), static_cast<NvU32>(target.pstateId),
+                  target.domainId, original.value);
+    const bool searched = run.Search();
+
+    // Anything short of --apply with a result puts the original back. When that write fails the journal keeps the
+    // tune pending and the next run retries it.
+    bool kept = false;
+    if (searched && !run.Interrupted() && settings.apply && run.HasBest()) {
+      NvAPI_Status status = WriteTuneDelta(handles[i], target, run.Best());
+      if (status == NVAPI_OK) {
+        journal.Write("keep %u %d", indices[i], run.Best());
+        kept = true;
+      } else {
+        PrintNvapiError("  Applying the best offset failed", status);
+      }
+    }
+    if (!kept && !RestoreTuneDelta(indices[i], handles[i], target, original.value, &journal)) { return 1; }
+
+    const char *stop = run.Failed() ? "failed" : run.Interrupted() ? "interrupted" : run.Reached() ? "target" : "done";
+    if (StructuredOutput()) {
+      RecordWriter record("tune_summary");
+      record.Field("knob", TuneKnobName(target.knob))
+          .Field("strategy", settings.strategy == kTuneBisect ? "bisect" : "golden")
+          .Field("original", original.value)
+          .Field("baseline_mhz_per_w", run.BaselineMeasure().mhzPerW);
+      if (run.HasBest()) {
+        record.Field("best", run.Best()).Field("best_mhz_per_w", run.BestMeasure().mhzPerW);
+      } else {
+        record.Null("best").Null("best_mhz_per_w");
+      }
+      record.Field("steps", run.Steps()).Field("applied", kept).Field("stop", stop);
+    } else if (run.HasBest()) {
+      Printf("  Best %d %s at %.3f MHz/W (baseline %.3f) after %u steps, %s, %s\n", run.Best(), TuneUnit(target),
+             run.BestMeasure().mhzPerW, run.BaselineMeasure().mhzPerW, run.Steps(), stop,
+             kept ? "applied" : "original restored");
+    } else {
+      Printf("  No offset %s after %u steps, %s, original restored\n",
+             settings.targetPpw > 0.0 ? "met the target" : "scored", run.Steps(), stop);
+    }
+    return run.Failed() || run.Interrupted() ? 1 : 0;
+  };
+
+  // A tune takes minutes per GPU, so unlike ForEachGpu nothing is held back until every GPU is done: each GPU runs on
+  // its own thread and every step is printed as it is measured. Text lines carry a GPU[n] prefix, records the gpu field.
+  int result = 0;
+  if (handles.size() == 1) {
+    PrintGpuHeader(indices[0], handles[0]);
+    result = tuneGpu(0);
+    ClearRecordGpu();
+  } else {
+    std::vector<int> results(handles.size(), 0);
+    OutputShare share;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < handles.size(); ++i) {
+      threads.emplace_back([&, i] {
+        OutputShare::Worker worker(share);
+        PrintGpuHeader(indices[i], handles[i]);
+        OutputLinePrefix prefix("GPU[" + std::to_string(indices[i]) + "]");
+        results[i] = tuneGpu(i);
+        ClearRecordGpu();
+      });
+    }
+    for (size_t i = 0; i < threads.size(); ++i) {
+      threads[i].join();
+      if (result == 0) { result = results[i]; }
+    }
+  }
+  SetConsoleCtrlHandler(TuneCtrlHandler, FALSE);
+  return result;
+}
+} // namespace nvcli
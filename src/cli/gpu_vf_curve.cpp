@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/vf_curve.h"
+
+#include <map>
+#include <memory>
+
+namespace nvcli {
+namespace {
+enum VfCurveSource { kVfSourceClient = 0, kVfSourceTables = 1 };
+
+bool ParseVfCurveSource(const char *value, VfCurveSource *out) {
+  if (std::strcmp(value, "client") == 0) {
+    *out = kVfSourceClient;
+    return true;
+  }
+  if (std::strcmp(value, "tables") == 0) {
+    *out = kVfSourceTables;
+    return true;
+  }
+  return false;
+}
+
+// GRAPHICS matches the client curve and every GRAPHICS/Pn tables curve, GPC/P0 only that one.
+bool DomainMatches(const std::string &domain, const std::string &filter) {
+  if (filter.empty()) { return true; }
+  std::string lowered = ToLowerAscii(domain.c_str());
+  if (lowered == filter) { return true; }
+  return lowered.compare(0, filter.size(), filter) == 0 && lowered[filter.size()] == '/';
+}
+
+bool LoadVfCurves(NvPhysicalGpuHandle handle, VfCurveSource source, const std::string &label,
+                  std::vector<VfCurve> *out) {
+  if (source == kVfSourceTables) {
+    std::unique_ptr<NV_GPU_PERF_VF_TABLES> tables(new NV_GPU_PERF_VF_TABLES());
+    tables->version = NV_GPU_PERF_VF_TABLES_VER;
+    NvAPI_Status status = NvApi().NvAPI_GPU_PerfVfTablesGetInfo(handle, tables.get());
+    if (status != NVAPI_OK) {
+      PrintNvapiError("  NvAPI_GPU_PerfVfTablesGetInfo failed", status);
+      return false;
+    }
+    VfCurvesFromTables(*tables, label, out);
+    return true;
+  }
+
+  std::unique_ptr<NV_GPU_CLOCK_CLIENT_CLK_DOMAINS_INFO> domains(new NV_GPU_CLOCK_CLIENT_CLK_DOMAINS_INFO());
+  std::unique_ptr<NV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_STATUS> points(new NV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_STATUS());
+  domains->version = NV_GPU_CLOCK_CLIENT_CLK_DOMAINS_INFO_VER;
+  points->version = NV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_STATUS_VER;
+  NvAPI_Status status = NvApi().NvAPI_GPU_ClockClientClkDomainsGetInfo(handle, domains.get());
+  if (status != NVAPI_OK) {
+    PrintNvapiError("  NvAPI_GPU_ClockClientClkDomainsGetInfo failed", status);
+    return false;
+  }
+  status = NvApi().NvAPI_GPU_ClockClientClkVfPointsGetStatus(handle, points.get());
+  if (status != NVAPI_OK) {
+    PrintNvapiError("  NvAPI_GPU_ClockClientClkVfPointsGetStatus failed", status);
+    return false;
+  }
+  VfCurvesFromClient(*domains, *points, label, out);
+  return true;
+}
+
+std::string GpuCurveLabel(const std::string &prefix, NvU32 index) {
+  std::string label = "gpu" + std::to_string(index);
+  return prefix.empty() ? label : prefix + ":" + label;
+}
+
+bool ValidLabel(const char *value) {
+  if (!value || !*value) { return false; }
+  for (const char *c = value; *c; ++c) {
+    if (*c == ' ' || *c == '\t' || *c == '\r' || *c == '\n') { return false; }
+  }
+  return true;
+}
+
+void PrintCurve(const VfCurve &curve, bool showPoints, const std::vector<double> &atUv,
+                const std::vector<double> &atMhz) {
+  const std::vector<VfPoint> &points = curve.Points();
+  if (StructuredOutput()) {
+    RecordWriter("vf_curve")
+        .Field("label", curve.Label())
+        .Field("domain", curve.Domain())
+        .Field("points", static_cast<NvU32>(points.size()))
+        .Field("min_uv", points.front().voltageUv)
+        .Field("max_uv", points.back().voltageUv)
+        .Field("min_mhz", points.front().freqKhz / 1000.0)
+        .Field("max_mhz", points.back().freqKhz / 1000.0)
+        .Field("adjusted", curve.Adjusted());
+  } else {
+    Printf("  %s: %u points, %u-%u uV, %.3f-%.3f MHz", curve.Domain().c_str(), static_cast<NvU32>(points.size()),
+           points.front().voltageUv, points.back().voltageUv, points.front().freqKhz / 1000.0,
+           points.back().freqKhz / 1000.0);
+    if (curve.Adjusted()) { Printf(", %u adjusted to keep it monotone", curve.Adjusted()); }
+    Printf("\n");
+  }
+
+  if (showPoints) {
+    for (const VfPoint &point : points) {
+      if (StructuredOutput()) {
+        RecordWriter("vf_point")
+            .Field("domain", curve.Domain())
+            .Field("voltage_uv", point.voltageUv)
+            .Field("freq_mhz", point.freqKhz / 1000.0);
+      } else {
+        Printf("    %u uV %.3f MHz\n", point.voltageUv, point.freqKhz / 1000.0);
+      }
+    }
+  }
+
+  for (double uv : atUv) {
+    double mhz = curve.FreqAt(uv) / 1000.0;
+    if (StructuredOutput()) {
+      RecordWriter("vf_at").Field("domain", curve.Domain()).Field("voltage_uv", uv).Field("freq_mhz", mhz);
+    } else {
+      Printf("    at %.0f uV: %.3f MHz\n", uv, mhz);
+    }
+  }
+  for (double mhz : atMhz) {
+    double uv = curve.VoltageFor(mhz * 1000.0);
+    if (StructuredOutput()) {
+      RecordWriter record("vf_at");
+      record.Field("domain", curve.Domain());
+      if (uv < 0.0) {
+        record.Null("voltage_uv");
+      } else {
+        record.Field("voltage_uv", uv);
+      }
+      record.Field("freq_mhz", mhz);
+    } else if (uv < 0.0) {
+      Printf("    %.3f MHz: above the curve\n", mhz);
+    } else {
+      Printf("    %.3f MHz: needs %.0f uV\n", mhz, uv);
+    }
+  }
+}
+} // namespace
+
+int CmdGpuVfCurve(int argc, char **argv) {
+  NvU32 index = 0;
+  bool hasIndex = false;
+  VfCurveSource source = kVfSourceClient;
+  std::string domainFilter;
+  std::vector<double> atUv;
+  std::vector<double> atMhz;
+  const char *savePath = NULL;
+  std::string labelPrefix;
+  bool showPoints = true;
+
+  for (int i = 0; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (std::strcmp(arg, "--summary") == 0) {
+      showPoints = false;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      Printf("Missing value for %s\n", arg);
+      return 1;
+    }
+    const char *value = argv[++i];
+    double number = 0.0;
+    if (std::strcmp(arg, "--index") == 0) {
+      if (!ParseUint(value, &index)) {
+        Printf("Invalid GPU index: %s\n", value);
+        return 1;
+      }
+      hasIndex = true;
+    } else if (std::strcmp(arg, "--source") == 0) {
+      if (!ParseVfCurveSource(value, &source)) {
+        Printf("Invalid source: %s (expected client|tables)\n", value);
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--domain") == 0) {
+      domainFilter = ToLowerAscii(value);
+    } else if (std::strcmp(arg, "--at") == 0) {
+      if (!ParseDoubleValue(value, &number) || number <= 0.0) {
+        Printf("Invalid voltage: %s\n", value);
+        return 1;
+      }
+      atUv.push_back(number);
+    } else if (std::strcmp(arg, "--at-mhz") == 0) {
+      if (!ParseDoubleValue(value, &number) || number <= 0.0) {
+        Printf("Invalid frequency: %s\n", value);
+        return 1;
+      }
+      atMhz.push_back(number);
+    } else if (std::strcmp(arg, "--save") == 0) {
+      savePath = value;
+    } else if (std::strcmp(arg, "--label") == 0) {
+      if (!ValidLabel(value)) {
+        Printf("Invalid label: %s (no whitespace)\n", value);
+        return 1;
+      }
+      labelPrefix = value;
+    } else {
+      Printf("Unknown option: %s\n", arg);
+      return 1;
+    }
+  }
+
+  std::vector<NvPhysicalGpuHandle> handles;
+  std::vector<NvU32> indices;
+  if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
+
+  // Each worker fills its own slot, the file is written once all of them are done.
+  std::vector<std::vector<VfCurve>> perGpu(handles.size());
+  int result = ForEachGpu(handles.size(), [&](size_t i) {
+    PrintGpuHeader(indices[i], handles[i]);
+
+    std::vector<VfCurve> curves;
+    if (!LoadVfCurves(handles[i], source, GpuCurveLabel(labelPrefix, indices[i]), &curves)) { return 1; }
+    for (const VfCurve &curve : curves) {
+      if (!DomainMatches(curve.Domain(), domainFilter)) { continue; }
+      PrintCurve(curve, showPoints, atUv, atMhz);
+      perGpu[i].push_back(curve);
+    }
+    if (perGpu[i].empty() && !StructuredOutput()) { Printf("  No VF curve found.\n"); }
+    return 0;
+  });
+
+  if (savePath) {
+    std::vector<VfCurve> all;
+    for (const std::vector<VfCurve> &curves : perGpu) { all.insert(all.end(), curves.begin(), curves.end()); }
+    if (!WriteVfCurveFile(savePath, all)) { return 1; }
+    if (!StructuredOutput()) { Printf("Saved %u curves to %s\n", static_cast<NvU32>(all.size()), savePath); }
+  }
+  return result;
+}
+
+int CmdGpuVfCompare(int argc, char **argv) {
+  NvU32 index = 0;
+  bool hasIndex = false;
+  VfCurveSource source = kVfSourceClient;
+  std::string domainFilter;
+  std::vector<const char *> loadPaths;
+  bool live = true;
+  double stepUv = 0.0;
+  bool showPoints = false;
+
+  for (int i = 0; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (std::strcmp(arg, "--no-live") == 0) {
+      live = false;
+      continue;
+    }
+    if (std::strcmp(arg, "--points") == 0) {
+      showPoints = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      Printf("Missing value for %s\n", arg);
+      return 1;
+    }
+    const char *value = argv[++i];
+    if (std::strcmp(arg, "--index") == 0) {
+      if (!ParseUint(value, &index)) {
+        Printf("Invalid GPU index: %s\n", value);
+        return 1;
+      }
+      hasIndex = true;
+    } else if (std::strcmp(arg, "--source") == 0) {
+      if (!ParseVfCurveSource(value, &source)) {
+        Printf("Invalid source: %s (expected client|tables)\n", value);
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--domain") == 0) {
+      domainFilter = ToLowerAscii(value);
+    } else if (std::strcmp(arg, "--load") == 0) {
+      loadPaths.push_back(value);
+    } else if (std::strcmp(arg, "--step") == 0) {
+      if (!ParseDoubleValue(value, &stepUv) || stepUv <= 0.0) {
+        Printf("Invalid step: %s\n", value);
+        return 1;
+      }
+    } else {
+      Printf("Unknown option: %s\n", arg);
+      return 1;
+    }
+  }
+  if (!live && loadPaths.empty()) {
+    Printf("--no-live needs at least one --load FILE\n");
+    return 1;
+  }
+
+  std::vector<VfCurve> curves;
+  for (const char *path : loadPaths) {
+    if (!ReadVfCurveFile(path, &curves)) { return 1; }
+  }
+  if (live) {
+    std::vector<NvPhysicalGpuHandle> handles;
+    std::vector<NvU32> indices;
+    if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
+    for (size_t i = 0; i < handles.size(); ++i) {
+      if (!LoadVfCurves(handles[i], source, GpuCurveLabel("", indices[i]), &curves)) { return 1; }
+    }
+  }
+
+  // Curves are only comparable within one domain, std::map keeps the domains in a stable order.
+  std::map<std::string, std::vector<const VfCurve *>> byDomain;
+  for (const VfCurve &curve : curves) {
+    if (DomainMatches(curve.Domain(), domainFilter)) { byDomain[curve.Domain()].push_back(&curve); }
+  }
+  if (byDomain.empty()) {
+    Printf("No VF curve found.\n");
+    return 1;
+  }
+
+  int result = 0;
+  for (const auto &entry : byDomain) {
+    const std::vector<const VfCurve *> &group = entry.second;
+    VfComparison comparison;
+    std::string error;
+    if (!CompareVfCurves(group, stepUv, &comparison, &error)) {
+      Printf("%s: %s\n", entry.first.c_str(), error.c_str());
+      result = 1;
+      continue;
+    }
+
+    const std::vector<double> &grid = comparison.gridUv;
+    if (StructuredOutput()) {
+      RecordWriter("vf_compare")
+          .Field("domain", entry.first)
+          .Field("curves", static_cast<NvU32>(group.size()))
+          .Field("min_uv", grid.front())
+          .Field("max_uv", grid.back())
+          .Field("grid_points", static_cast<NvU32>(grid.size()));
+    } else {
+      Printf("%s: %u curves compared over %.0f-%.0f uV (%u points), offsets to the median curve\n",
+             entry.first.c_str(), static_cast<NvU32>(group.size()), grid.front(), grid.back(),
+             static_cast<NvU32>(grid.size()));
+    }
+
+    for (size_t rank = 0; rank < comparison.order.size(); ++rank) {
+      const size_t c = comparison.order[rank];
+      const double mean = comparison.meanDeltaKhz[c] / 1000.0;
+      const double low = comparison.minDeltaKhz[c] / 1000.0;
+      const double high = comparison.maxDeltaKhz[c] / 1000.0;
+      if (StructuredOutput()) {
+        RecordWriter("vf_rank")
+            .Field("domain", entry.first)
+            .Field("rank", static_cast<NvU32>(rank + 1))
+            .Field("label", group[c]->Label())
+            .Field("mean_delta_mhz", mean)
+            .Field("min_delta_mhz", low)
+            .Field("max_delta_mhz", high);
+      } else {
+        Printf("  #%-4u %-24s mean %+9.3f MHz  min %+9.3f  max %+9.3f\n", static_cast<NvU32>(rank + 1),
+               group[c]->Label().c_str(), mean, low, high);
+      }
+      if (!showPoints) { continue; }
+      for (size_t g = 0; g < grid.size(); ++g) {
+        const double delta = comparison.deltaKhz[c][g] / 1000.0;
+        if (StructuredOutput()) {
+          RecordWriter("vf_compare_point")
+              .Field("domain", entry.first)
+              .Field("label", group[c]->Label())
+              .Field("voltage_uv", grid[g])
+              .Field("median_mhz", comparison.medianKhz[g] / 1000.0)
+              .Field("delta_mhz", delta);
+        } else {
+          Printf("        %.0f uV %+9.3f MHz (median %.3f)\n", grid[g], delta, comparison.medianKhz[g] / 1000.0);
+        }
+      }
+    }
+  }
+  return result;
+}
+} // namespace nvcli
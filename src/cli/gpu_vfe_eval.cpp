@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/vfe_eval.h"
+
+#include <chrono>
+#include <memory>
+
+namespace nvcli {
+namespace {
+constexpr NvU64 kMaxEvalPoints = 1000000;
+// Results are kept until the timed evaluation pass is done, this bounds points x equations.
+constexpr NvU64 kMaxEvalResults = 16000000;
+
+// One swept input: every var in vars takes each of values in turn.
+struct EvalAxis {
+  std::string name;
+  std::vector<NvU8> vars;
+  std::vector<double> values;
+};
+
+struct EvalOverride {
+  NvU8 var;
+  NvU8 type;
+  double value;
+};
+
+// V, or A-B:STEP for every value from A up to and including B. A leading minus belongs to the number.
+bool ParseEvalRange(const char *text, std::vector<double> *out) {
+  if (!text || !out) { return false; }
+  char *end = NULL;
+  double first = std::strtod(text, &end);
+  if (end == text) { return false; }
+  if (*end == '\0') {
+    out->assign(1, first);
+    return true;
+  }
+  if (*end != '-') { return false; }
+  const char *cursor = end + 1;
+  double last = std::strtod(cursor, &end);
+  if (end == cursor || *end != ':') { return false; }
+  cursor = end + 1;
+  double step = std::strtod(cursor, &end);
+  if (end == cursor || *end != '\0' || step <= 0.0 || last < first) { return false; }
+  if ((last - first) / step >= static_cast<double>(kMaxEvalPoints)) { return false; }
+
+  out->clear();
+  for (NvU64 n = 0;; ++n) {
+    double value = first + step * static_cast<double>(n);
+    if (value > last + step * 1e-9) { break; }
+    out->push_back(value);
+  }
+  return true;
+}
+
+// IDX=none or IDX=value|offset|scale:F.
+bool ParseEvalOverride(const char *text, EvalOverride *out) {
+  const char *equals = std::strchr(text, '=');
+  if (!equals) { return false; }
+  NvU32 var = 0;
+  if (!ParseUint(std::string(text, equals).c_str(), &var) || var >= kVfeVarCount) { return false; }
+  out->var = static_cast<NvU8>(var);
+  out->value = 0.0;
+
+  const char *colon = std::strchr(equals + 1, ':');
+  std::string type = colon ? std::string(equals + 1, colon) : std::string(equals + 1);
+  if (!ParseVfeVarOverrideType(type.c_str(), &out->type)) { return false; }
+  if (out->type == NV_GPU_PERF_VFE_VAR_SINGLE_OVERRIDE_TYPE_NONE) { return colon == NULL; }
+  return colon && ParseDoubleValue(colon + 1, &out->value);
+}
+
+bool IsInputVar(NV_GPU_PERF_VFE_VAR_TYPE type) {
+  return type == NV_GPU_PERF_VFE_VAR_TYPE_SINGLE || type == NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_FREQUENCY ||
+         type == NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED || type == NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_TEMP ||
+         type == NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_VOLTAGE;
+}
+
+const char *EvalUnit(NvU8 outputType) {
+  switch (outputType) {
+  case NV_GPU_PERF_VFE_EQU_OUTPUT_TYPE_FREQ_MHZ: return " MHz";
+  case NV_GPU_PERF_VFE_EQU_OUTPUT_TYPE_VOLT_UV:
+  case NV_GPU_PERF_VFE_EQU_OUTPUT_TYPE_VOLT_DELTA_UV: return " uV";
+  default: return "";
+  }
+}
+
+bool LoadVfeDefs(NvPhysicalGpuHandle handle, std::vector<VfeVarDef> *vars, std::vector<VfeEquDef> *equs) {
+  // The four structs are close to 500 KB together, too much for a ForEachGpu worker stack.
+  std::unique_ptr<NV_GPU_PERF_VFE_VARS_INFO> varsInfo(new NV_GPU_PERF_VFE_VARS_INFO());
+  std::unique_ptr<NV_GPU_PERF_VFE_VARS_CONTROL> varsControl(new NV_GPU_PERF_VFE_VARS_CONTROL());
+  std::unique_ptr<NV_GPU_PERF_VFE_EQUS_INFO> equsInfo(new NV_GPU_PERF_VFE_EQUS_INFO());
+  std::unique_ptr<NV_GPU_PERF_VFE_EQUS_CONTROL> equsControl(new NV_GPU_PERF_VFE_EQUS_CONTROL());
+  varsInfo->version = NV_GPU_PERF_VFE_VARS_INFO_VER;
+  varsControl->version = NV_GPU_PERF_VFE_VARS_CONTROL_VER;
+  equsInfo->version = NV_GPU_PERF_VFE_EQUS_INFO_VER;
+  equsControl->version = NV_GPU_PERF_VFE_EQUS_CONTROL_VER;
+
+  NvAPI_Status status = NvApi().NvAPI_GPU_PerfVfeVarGetInfo(handle, varsInfo.get());
+  if (status != NVAPI_OK) {
+    PrintNvapiError("  NvAPI_GPU_PerfVfeVarGetInfo failed", status);
+    return false;
+  }
+  status = NvApi().NvAPI_GPU_PerfVfeVarGetControl(handle, varsControl.get());
+  if (status != NVAPI_OK) {
+    PrintNvapiError("  NvAPI_GPU_PerfVfeVarGetControl failed", status);
+    return false;
+  }
+  status = NvApi().NvAPI_GPU_PerfVfeEquGetInfo(handle, equsInfo.get());
+  if (status != NVAPI_OK) {
+    PrintNvapiError("  NvAPI_GPU_PerfVfeEquGetInfo failed", status);
+    return false;
+  }
+  status = NvApi().NvAPI_GPU_PerfVfeEquGetControl(handle, equsControl.get());
+  if (status != NVAPI_OK) {
+    PrintNvapiError("  NvAPI_GPU_PerfVfeEquGetControl failed", status);
+    return false;
+  }
+
+  VfeDefsFromNvapi(*varsInfo, *varsControl, *equsInfo, *equsControl, vars, equs);
+  return true;
+}
+
+void PrintProgram(const VfeProgram &program) {
+  const std::vector<VfeNode> &nodes = program.Nodes();
+  for (size_t n = 0; n < nodes.size(); ++n) {
+    const VfeNode &node = nodes[n];
+    bool isVar = node.op <= kVfeOpSum;
+    if (StructuredOutput()) {
+      RecordWriter("vfe_node")
+          .Field("node", static_cast<NvU32>(n))
+          .Field("op", VfeOpName(node.op))
+          .Field(isVar ? "var" : "equ", static_cast<NvU32>(node.source))
+          .Field("a", node.a)
+          .Field("b", node.b)
+          .Field("c", node.c)
+          .Field("range_min", node.rangeMin)
+          .Field("range_max", node.rangeMax);
+      continue;
+    }
+    Printf("  node[%u] %-9s %s[%u] a=%d b=%d c=%d", static_cast<NvU32>(n), VfeOpName(node.op), isVar ? "VAR" : "EQU",
+           node.source, node.a, node.b, node.c);
+    if (node.op == kVfeOpQuadratic) { Printf(" coeffs=%g,%g,%g", node.k[0], node.k[1], node.k[2]); }
+    if (node.op == kVfeOpCompare) { Printf(" %s %g", VfeEquCompareFuncName(node.compareFunc), node.k[0]); }
+    if (node.op == kVfeOpMinMax) { Printf(" %s", node.max ? "max" : "min"); }
+    if (node.op == kVfeOpConst) { Printf(" value=%g", node.k[0]); }
+    if (node.op == kVfeOpInput && node.overrideType != NV_GPU_PERF_VFE_VAR_SINGLE_OVERRIDE_TYPE_NONE) {
+      Printf(" override=%s:%g", VfeVarOverrideTypeName(node.overrideType), node.k[0]);
+    }
+    if (node.rangeMin < node.rangeMax) { Printf(" range=%g-%g", node.rangeMin, node.rangeMax); }
+    Printf("\n");
+  }
+}
+} // namespace
+
+int CmdGpuVfeEqusEval(int argc, char **argv) {
+  NvU32 index = 0;
+  bool hasIndex = false;
+  std::vector<NvU8> equSelection;
+  std::vector<double> temps;
+  std::vector<double> volts;
+  std::vector<double> freqs;
+  std::vector<EvalAxis> varAxes;
+  std::vector<EvalOverride> overrides;
+  bool noOverrides = false;
+  bool showProgram = false;
+
+  for (int i = 0; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (std::strcmp(arg, "--no-overrides") == 0) {
+      noOverrides = true;
+      continue;
+    }
+    if (std::strcmp(arg, "--program") == 0) {
+      showProgram = true;
+      continue;
+    }
+    if (i + 1 >= argc) {
+      Printf("Missing value for %s\n", arg);
+      return 1;
+    }
+    const char *value = argv[++i];
+    if (std::strcmp(arg, "--index") == 0) {
+      if (!ParseUint(value, &index)) {
+        Printf("Invalid GPU index: %s\n", value);
+        return 1;
+      }
+      hasIndex = true;
+    } else if (std::strcmp(arg, "--equ") == 0) {
+      NvU32 equ = 0;
+      if (!ParseUint(value, &equ) || equ >= kVfeEquCount) {
+        Printf("Invalid equ index: %s\n", value);
+        return 1;
+      }
+      equSelection.push_back(static_cast<NvU8>(equ));
+    } else if (std::strcmp(arg, "--temp") == 0 || std::strcmp(arg, "--voltage") == 0 ||
+               std::strcmp(arg, "--freq") == 0) {
+      std::vector<double> *target = &freqs;
+      if (std::strcmp(arg, "--temp") == 0) { target = &temps; }
+      if (std::strcmp(arg, "--voltage") == 0) { target = &volts; }
+      if (!ParseEvalRange(value, target)) {
+        Printf("Invalid %s: %s (expected V or A-B:STEP)\n", arg, value);
+        return 1;
+      }
+    } else if (std::strcmp(arg, "--var") == 0) {
+      const char *equals = std::strchr(value, '=');
+      NvU32 var = 0;
+      EvalAxis axis;
+      if (!equals || !ParseUint(std::string(value, equals).c_str(), &var) || var >= kVfeVarCount ||
+          !ParseEvalRange(equals + 1, &axis.values)) {
+        Printf("Invalid --var: %s (expected IDX=V or IDX=A-B:STEP)\n", value);
+        return 1;
+      }
+      axis.name = "var" + std::to_string(var);
+      axis.vars.push_back(static_cast<NvU8>(var));
+      varAxes.push_back(axis);
+    } else if (std::strcmp(arg, "--override") == 0) {
+      EvalOverride entry = {};
+      if (!ParseEvalOverride(value, &entry)) {
+        Printf("Invalid --override: %s (expected IDX=none or IDX=value|offset|scale:F)\n", value);
+        return 1;
+      }
+      overrides.push_back(entry);
+    } else {
+      Printf("Unknown option: %s\n", arg);
+      return 1;
+    }
+  }
+
+  std::vector<NvPhysicalGpuHandle> handles;
+  std::vector<NvU32> indices;
+  if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
+
+  return ForEachGpu(handles.size(), [&](size_t i) {
+    PrintGpuHeader(indices[i], handles[i]);
+
+    std::vector<VfeVarDef> vars;
+    std::vector<VfeEquDef> equs;
+    if (!LoadVfeDefs(handles[i], &vars, &equs)) { return 1; }
+
+    // What-if overrides replace the ones read back, as vfe-var set would, but only in the copy being compiled.
+    for (VfeVarDef &def : vars) {
+      if (noOverrides) { def.overrideType = NV_GPU_PERF_VFE_VAR_SINGLE_OVERRIDE_TYPE_NONE; }
+    }
+    for (const EvalOverride &entry : overrides) {
+      VfeVarDef *target = NULL;
+      for (VfeVarDef &def : vars) {
+        if (def.index == entry.var) { target = &def; }
+      }
+      if (!target || (!IsInputVar(target->type) && !target->hasFuse)) {
+        Printf("  Var[%u] does not exist or does not support overrides.\n", entry.var);
+        return 1;
+      }
+      target->overrideType = entry.type;
+      target->overrideValue = entry.value;
+    }
+
+    VfeProgram program;
+    std::string error;
+    if (!program.Compile(vars, equs, &error)) {
+      Printf("  VFE program does not compile: %s\n", error.c_str());
+      return 1;
+    }
+
+    std::vector<NvU8> selected = equSelection.empty() ? program.Roots() : equSelection;
+    for (NvU8 equ : selected) {
+      if (program.EquationNode(equ) < 0) {
+        Printf("  EQU[%u] does not exist.\n", equ);
+        return 1;
+      }
+    }
+
+    // Temperature, voltage and frequency drive every var of that type together, --var pins one var.
+    std::vector<EvalAxis> axes;
+    const struct {
+      const char *name;
+      NV_GPU_PERF_VFE_VAR_TYPE type;
+      const std::vector<double> *values;
+    } typed[] = {{"temp", NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_TEMP, &temps},
+                 {"voltage", NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_VOLTAGE, &volts},
+                 {"freq", NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_FREQUENCY, &freqs}};
+    bool pinned[kVfeVarCount] = {};
+    for (const EvalAxis &axis : varAxes) {
+      if (program.VarNode(axis.vars[0]) < 0) {
+        Printf("  Var[%u] does not exist.\n", axis.vars[0]);
+        return 1;
+      }
+      pinned[axis.vars[0]] = true;
+    }
+    for (const auto &entry : typed) {
+      if (entry.values->empty()) { continue; }
+      EvalAxis axis;
+      axis.name = entry.name;
+      axis.values = *entry.values;
+      for (const VfeVarDef &def : vars) {
+        if (def.type == entry.type && !pinned[def.index]) { axis.vars.push_back(def.index); }
+      }
+      if (axis.vars.empty()) {
+        Printf("  No %s var to apply --%s to.\n", VfeVarTypeName(entry.type), entry.name);
+        return 1;
+      }
+      for (NvU8 var : axis.vars) { pinned[var] = true; }
+      axes.push_back(axis);
+    }
+    axes.insert(axes.end(), varAxes.begin(), varAxes.end());
+
+    NvU64 points = 1;
+    for (const EvalAxis &axis : axes) { points *= axis.values.size(); }
+    if (points > kMaxEvalPoints || points * selected.size() > kMaxEvalResults) {
+      Printf("  %llu points x %u equations is too many, narrow the ranges or select equations with --equ.\n",
+             static_cast<unsigned long long>(points), static_cast<NvU32>(selected.size()));
+      return 1;
+    }
+
+    if (!StructuredOutput()) {
+      Printf("  VFE program: %u vars, %u equs, %u nodes, %u roots\n", static_cast<NvU32>(vars.size()),
+             static_cast<NvU32>(equs.size()), static_cast<NvU32>(program.Nodes().size()),
+             static_cast<NvU32>(program.Roots().size()));
+      for (const VfeVarDef &def : vars) {
+        if (IsInputVar(def.type) && !pinned[def.index] &&
+            def.overrideType != NV_GPU_PERF_VFE_VAR_SINGLE_OVERRIDE_TYPE_VALUE) {
+          Printf("  VAR[%u] %s has no input, using 0\n", def.index, VfeVarTypeName(def.type));
+        }
+      }
+    }
+    if (showProgram) { PrintProgram(program); }
+
+    // Every point is evaluated before anything is printed so the timing covers the evaluator alone.
+    double inputs[kVfeVarCount] = {};
+    std::vector<double> values;
+    std::vector<double> results(static_cast<size_t>(points * selected.size()));
+    std::vector<size_t> position(axes.size(), 0);
+    auto start = std::chrono::steady_clock::now();
+    for (NvU64 p = 0; p < points; ++p) {
+      for (size_t a = 0; a < axes.size(); ++a) {
+        for (NvU8 var : axes[a].vars) { inputs[var] = axes[a].values[position[a]]; }
+      }
+      program.Evaluate(inputs, &values);
+      for (size_t e = 0; e < selected.size(); ++e) {
+        results[p * selected.size() + e] = values[program.EquationNode(selected[e])];
+      }
+      // The last axis varies fastest.
+      for (size_t a = axes.size(); a-- > 0;) {
+        if (++position[a] < axes[a].values.size()) { break; }
+        position[a] = 0;
+      }
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::fill(position.begin(), position.end(), 0);
+    for (NvU64 p = 0; p < points; ++p) {
+      const double *row = &results[p * selected.size()];
+      if (StructuredOutput()) {
+        RecordWriter record("vfe_eval");
+        record.Field("point", static_cast<NvU64>(p));
+        for (size_t a = 0; a < axes.size(); ++a) { record.Field(axes[a].name.c_str(), axes[a].values[position[a]]); }
+        for (size_t e = 0; e < selected.size(); ++e) {
+          record.Field(("equ" + std::to_string(selected[e])).c_str(), row[e]);
+        }
+      } else {
+        std::string line = " ";
+        char buffer[96] = {};
+        for (size_t a = 0; a < axes.size(); ++a) {
+          std::snprintf(buffer, sizeof(buffer), " %s=%g", axes[a].name.c_str(), axes[a].values[position[a]]);
+          line += buffer;
+        }
+        for (size_t e = 0; e < selected.size(); ++e) {
+          std::snprintf(buffer, sizeof(buffer), " EQU[%u]=%.3f%s", selected[e], row[e],
+                        EvalUnit(program.OutputType(selected[e])));
+          line += buffer;
+        }
+        Printf("%s\n", line.c_str());
+      }
+      for (size_t a = axes.size(); a-- > 0;) {
+        if (++position[a] < axes[a].values.size()) { break; }
+        position[a] = 0;
+      }
+    }
+
+    if (StructuredOutput()) {
+      RecordWriter("vfe_eval_summary")
+          .Field("points", points)
+          .Field("equs", static_cast<NvU32>(selected.size()))
+          .Field("nodes", static_cast<NvU32>(program.Nodes().size()))
+          .Field("elapsed_ms", elapsedMs);
+    } else {
+      Printf("  Evaluated %llu points x %u equations in %.3f ms\n", static_cast<unsigned long long>(points),
+             static_cast<NvU32>(selected.size()), elapsedMs);
+    }
+    return 0;
+  });
+}
+} // namespace nvcli
@@ -163,14 +163,14 @@ bool ParseGsyncDisplayState(const char *value, NVAPI_GSYNC_DISPLAY_SYNC_STATE *o
 int CmdGsyncList() {
   NvGSyncDeviceHandle handles[NVAPI_MAX_GSYNC_DEVICES] = {};
   NvU32 count = 0;
-  NvAPI_Status status = NvAPI_GSync_EnumSyncDevices(handles, &count);
+  NvAPI_Status status = NvApi().NvAPI_GSync_EnumSyncDevices(handles, &count);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_EnumSyncDevices failed", status);
     return 1;
   }
 
-  std::printf("G-Sync devices: %u\n", count);
-  for (NvU32 i = 0; i < count; ++i) { std::printf("  [%u] handle=0x%p\n", i, handles[i]); }
+  Printf("G-Sync devices: %u\n", count);
+  for (NvU32 i = 0; i < count; ++i) { Printf("  [%u] handle=0x%p\n", i, handles[i]); }
   return 0;
 }
 
@@ -180,19 +180,19 @@ int CmdGsyncCaps(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid index.\n");
+        Printf("Invalid index.\n");
         return 1;
       }
       hasIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasIndex) {
-    std::printf("Missing required --index\n");
+    Printf("Missing required --index\n");
     return 1;
   }
 
@@ -201,17 +201,17 @@ int CmdGsyncCaps(int argc, char **argv) {
 
   NV_GSYNC_CAPABILITIES caps = {};
   caps.version = NV_GSYNC_CAPABILITIES_VER;
-  NvAPI_Status status = NvAPI_GSync_QueryCapabilities(handle, &caps);
+  NvAPI_Status status = NvApi().NvAPI_GSync_QueryCapabilities(handle, &caps);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_QueryCapabilities failed", status);
     return 1;
   }
 
-  std::printf("G-Sync caps: boardId=0x%08X revId=0x%08X revision=%u extendedRevision=%u\n", caps.boardId, caps.revId,
-              caps.revision, caps.extendedRevision);
-  std::printf("  capFlags=0x%08X\n", caps.capFlags);
-  std::printf("  maxSyncSkew=%u syncSkewResolution=%u ns\n", caps.maxSyncSkew, caps.syncSkewResolution);
-  std::printf("  maxStartDelay=%u startDelayResolution=%u ns\n", caps.maxStartDelay, caps.startDelayResolution);
+  Printf("G-Sync caps: boardId=0x%08X revId=0x%08X revision=%u extendedRevision=%u\n", caps.boardId, caps.revId,
+         caps.revision, caps.extendedRevision);
+  Printf("  capFlags=0x%08X\n", caps.capFlags);
+  Printf("  maxSyncSkew=%u syncSkewResolution=%u ns\n", caps.maxSyncSkew, caps.syncSkewResolution);
+  Printf("  maxStartDelay=%u startDelayResolution=%u ns\n", caps.maxStartDelay, caps.startDelayResolution);
   return 0;
 }
 
@@ -221,19 +221,19 @@ int CmdGsyncTopology(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid index.\n");
+        Printf("Invalid index.\n");
         return 1;
       }
       hasIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasIndex) {
-    std::printf("Missing required --index\n");
+    Printf("Missing required --index\n");
     return 1;
   }
 
@@ -242,13 +242,13 @@ int CmdGsyncTopology(int argc, char **argv) {
 
   NvU32 gpuCount = 0;
   NvU32 displayCount = 0;
-  NvAPI_Status status = NvAPI_GSync_GetTopology(handle, &gpuCount, NULL, &displayCount, NULL);
+  NvAPI_Status status = NvApi().NvAPI_GSync_GetTopology(handle, &gpuCount, NULL, &displayCount, NULL);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
   }
   if (gpuCount == 0 && displayCount == 0) {
-    std::printf("No G-Sync topology entries found.\n");
+    Printf("No G-Sync topology entries found.\n");
     return 1;
   }
 
@@ -257,23 +257,23 @@ int CmdGsyncTopology(int argc, char **argv) {
   for (NvU32 i = 0; i < gpuCount; ++i) { gpus[i].version = NV_GSYNC_GPU_VER; }
   for (NvU32 i = 0; i < displayCount; ++i) { displays[i].version = NV_GSYNC_DISPLAY_VER; }
 
-  status = NvAPI_GSync_GetTopology(handle, &gpuCount, gpus.data(), &displayCount, displays.data());
+  status = NvApi().NvAPI_GSync_GetTopology(handle, &gpuCount, gpus.data(), &displayCount, displays.data());
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
   }
 
-  std::printf("G-Sync topology: gpus=%u displays=%u\n", gpuCount, displayCount);
+  Printf("G-Sync topology: gpus=%u displays=%u\n", gpuCount, displayCount);
   for (NvU32 i = 0; i < gpuCount; ++i) {
     NvAPI_ShortString name = {0};
-    NvAPI_GPU_GetFullName(gpus[i].hPhysicalGpu, name);
-    std::printf("  GPU[%u] handle=0x%p name=%s connector=%s proxy=0x%p synced=%u\n", i, gpus[i].hPhysicalGpu, name,
-                GsyncConnectorName(gpus[i].connector), gpus[i].hProxyPhysicalGpu, gpus[i].isSynced ? 1u : 0u);
+    NvApi().NvAPI_GPU_GetFullName(gpus[i].hPhysicalGpu, name);
+    Printf("  GPU[%u] handle=0x%p name=%s connector=%s proxy=0x%p synced=%u\n", i, gpus[i].hPhysicalGpu, name,
+           GsyncConnectorName(gpus[i].connector), gpus[i].hProxyPhysicalGpu, gpus[i].isSynced ? 1u : 0u);
   }
 
   for (NvU32 i = 0; i < displayCount; ++i) {
-    std::printf("  display[%u] id=0x%08X state=%s masterable=%u\n", i, displays[i].displayId,
-                GsyncDisplaySyncStateName(displays[i].syncState), displays[i].isMasterable ? 1u : 0u);
+    Printf("  display[%u] id=0x%08X state=%s masterable=%u\n", i, displays[i].displayId,
+           GsyncDisplaySyncStateName(displays[i].syncState), displays[i].isMasterable ? 1u : 0u);
   }
 
   return 0;
@@ -286,19 +286,19 @@ int CmdGsyncSyncGet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid index.\n");
+        Printf("Invalid index.\n");
         return 1;
       }
       hasIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasIndex) {
-    std::printf("Missing required --index\n");
+    Printf("Missing required --index\n");
     return 1;
   }
 
@@ -306,29 +306,29 @@ int CmdGsyncSyncGet(int argc, char **argv) {
   if (!GetGsyncHandleByIndex(index, &handle)) { return 1; }
 
   NvU32 displayCount = 0;
-  NvAPI_Status status = NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, NULL);
+  NvAPI_Status status = NvApi().NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, NULL);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
   }
   if (displayCount == 0) {
-    std::printf("No G-Sync displays found.\n");
+    Printf("No G-Sync displays found.\n");
     return 1;
   }
 
   std::vector<NV_GSYNC_DISPLAY> displays(displayCount);
   for (NvU32 i = 0; i < displayCount; ++i) { displays[i].version = NV_GSYNC_DISPLAY_VER; }
 
-  status = NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, displays.data());
+  status = NvApi().NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, displays.data());
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
   }
 
-  std::printf("G-Sync displays: %u\n", displayCount);
+  Printf("G-Sync displays: %u\n", displayCount);
   for (NvU32 i = 0; i < displayCount; ++i) {
-    std::printf("  display[%u] id=0x%08X state=%s masterable=%u\n", i, displays[i].displayId,
-                GsyncDisplaySyncStateName(displays[i].syncState), displays[i].isMasterable ? 1u : 0u);
+    Printf("  display[%u] id=0x%08X state=%s masterable=%u\n", i, displays[i].displayId,
+           GsyncDisplaySyncStateName(displays[i].syncState), displays[i].isMasterable ? 1u : 0u);
   }
 
   return 0;
@@ -346,7 +346,7 @@ int CmdGsyncSyncSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid index.\n");
+        Printf("Invalid index.\n");
         return 1;
       }
       hasIndex = true;
@@ -355,7 +355,7 @@ int CmdGsyncSyncSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--display-id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -364,7 +364,7 @@ int CmdGsyncSyncSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--state") == 0) {
       if (i + 1 >= argc || !ParseGsyncDisplayState(argv[i + 1], &state)) {
-        std::printf("Invalid --state value.\n");
+        Printf("Invalid --state value.\n");
         return 1;
       }
       hasState = true;
@@ -379,12 +379,12 @@ int CmdGsyncSyncSet(int argc, char **argv) {
       flags |= NV_SET_SYNC_FLAGS_SEND_START_EVENT;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasIndex || !hasDisplayId || !hasState) {
-    std::printf("Missing required --index, --display-id, and --state\n");
+    Printf("Missing required --index, --display-id, and --state\n");
     return 1;
   }
 
@@ -392,20 +392,20 @@ int CmdGsyncSyncSet(int argc, char **argv) {
   if (!GetGsyncHandleByIndex(index, &handle)) { return 1; }
 
   NvU32 displayCount = 0;
-  NvAPI_Status status = NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, NULL);
+  NvAPI_Status status = NvApi().NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, NULL);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
   }
   if (displayCount == 0) {
-    std::printf("No G-Sync displays found.\n");
+    Printf("No G-Sync displays found.\n");
     return 1;
   }
 
   std::vector<NV_GSYNC_DISPLAY> displays(displayCount);
   for (NvU32 i = 0; i < displayCount; ++i) { displays[i].version = NV_GSYNC_DISPLAY_VER; }
 
-  status = NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, displays.data());
+  status = NvApi().NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, displays.data());
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
@@ -421,20 +421,20 @@ int CmdGsyncSyncSet(int argc, char **argv) {
   }
 
   if (!found) {
-    std::printf("DisplayId 0x%08X not found in G-Sync topology.\n", displayId);
+    Printf("DisplayId 0x%08X not found in G-Sync topology.\n", displayId);
     return 1;
   }
 
-  std::printf("G-Sync sync state update: displayId=0x%08X state=%s flags=0x%08X\n", displayId,
-              GsyncDisplaySyncStateName(state), flags);
+  Printf("G-Sync sync state update: displayId=0x%08X state=%s flags=0x%08X\n", displayId,
+         GsyncDisplaySyncStateName(state), flags);
 
-  status = NvAPI_GSync_SetSyncStateSettings(displayCount, displays.data(), flags);
+  status = NvApi().NvAPI_GSync_SetSyncStateSettings(displayCount, displays.data(), flags);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_SetSyncStateSettings failed", status);
     return 1;
   }
 
-  std::printf("G-Sync sync state updated.\n");
+  Printf("G-Sync sync state updated.\n");
   return 0;
 }
 
@@ -449,7 +449,7 @@ int CmdGsyncSyncEnable(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid index.\n");
+        Printf("Invalid index.\n");
         return 1;
       }
       hasIndex = true;
@@ -458,7 +458,7 @@ int CmdGsyncSyncEnable(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--display-id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
@@ -467,23 +467,23 @@ int CmdGsyncSyncEnable(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--state") == 0) {
       if (i + 1 >= argc || !ParseGsyncDisplayState(argv[i + 1], &state)) {
-        std::printf("Invalid --state value.\n");
+        Printf("Invalid --state value.\n");
         return 1;
       }
       hasState = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasIndex || !hasDisplayId || !hasState) {
-    std::printf("Missing required --index, --display-id, and/or --state\n");
+    Printf("Missing required --index, --display-id, and/or --state\n");
     return 1;
   }
   if (state == NVAPI_GSYNC_DISPLAY_SYNC_STATE_UNSYNCED) {
-    std::printf("--state must be master or slave for sync enable.\n");
+    Printf("--state must be master or slave for sync enable.\n");
     return 1;
   }
 
@@ -491,20 +491,20 @@ int CmdGsyncSyncEnable(int argc, char **argv) {
   if (!GetGsyncHandleByIndex(index, &handle)) { return 1; }
 
   NvU32 displayCount = 0;
-  NvAPI_Status status = NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, NULL);
+  NvAPI_Status status = NvApi().NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, NULL);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
   }
   if (displayCount == 0) {
-    std::printf("No G-Sync displays found.\n");
+    Printf("No G-Sync displays found.\n");
     return 1;
   }
 
   std::vector<NV_GSYNC_DISPLAY> displays(displayCount);
   for (NvU32 i = 0; i < displayCount; ++i) { displays[i].version = NV_GSYNC_DISPLAY_VER; }
 
-  status = NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, displays.data());
+  status = NvApi().NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, displays.data());
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
@@ -522,23 +522,23 @@ int CmdGsyncSyncEnable(int argc, char **argv) {
   }
 
   if (!found) {
-    std::printf("DisplayId 0x%08X not found in G-Sync topology.\n", displayId);
+    Printf("DisplayId 0x%08X not found in G-Sync topology.\n", displayId);
     return 1;
   }
   if (state == NVAPI_GSYNC_DISPLAY_SYNC_STATE_MASTER && !masterable) {
-    std::printf("DisplayId 0x%08X is not masterable.\n", displayId);
+    Printf("DisplayId 0x%08X is not masterable.\n", displayId);
     return 1;
   }
 
-  std::printf("G-Sync sync state update: displayId=0x%08X state=%s\n", displayId, GsyncDisplaySyncStateName(state));
+  Printf("G-Sync sync state update: displayId=0x%08X state=%s\n", displayId, GsyncDisplaySyncStateName(state));
 
-  status = NvAPI_GSync_SetSyncStateSettings(displayCount, displays.data(), 0);
+  status = NvApi().NvAPI_GSync_SetSyncStateSettings(displayCount, displays.data(), 0);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_SetSyncStateSettings failed", status);
     return 1;
   }
 
-  std::printf("G-Sync sync state updated.\n");
+  Printf("G-Sync sync state updated.\n");
   return 0;
 }
 
@@ -551,7 +551,7 @@ int CmdGsyncSyncDisable(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid index.\n");
+        Printf("Invalid index.\n");
         return 1;
       }
       hasIndex = true;
@@ -560,19 +560,19 @@ int CmdGsyncSyncDisable(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--display-id") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &displayId)) {
-        std::printf("Invalid display id.\n");
+        Printf("Invalid display id.\n");
         return 1;
       }
       hasDisplayId = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasIndex || !hasDisplayId) {
-    std::printf("Missing required --index and/or --display-id\n");
+    Printf("Missing required --index and/or --display-id\n");
     return 1;
   }
 
@@ -580,20 +580,20 @@ int CmdGsyncSyncDisable(int argc, char **argv) {
   if (!GetGsyncHandleByIndex(index, &handle)) { return 1; }
 
   NvU32 displayCount = 0;
-  NvAPI_Status status = NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, NULL);
+  NvAPI_Status status = NvApi().NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, NULL);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
   }
   if (displayCount == 0) {
-    std::printf("No G-Sync displays found.\n");
+    Printf("No G-Sync displays found.\n");
     return 1;
   }
 
   std::vector<NV_GSYNC_DISPLAY> displays(displayCount);
   for (NvU32 i = 0; i < displayCount; ++i) { displays[i].version = NV_GSYNC_DISPLAY_VER; }
 
-  status = NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, displays.data());
+  status = NvApi().NvAPI_GSync_GetTopology(handle, NULL, NULL, &displayCount, displays.data());
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
@@ -609,20 +609,20 @@ int CmdGsyncSyncDisable(int argc, char **argv) {
   }
 
   if (!found) {
-    std::printf("DisplayId 0x%08X not found in G-Sync topology.\n", displayId);
+    Printf("DisplayId 0x%08X not found in G-Sync topology.\n", displayId);
     return 1;
   }
 
-  std::printf("G-Sync sync state update: displayId=0x%08X state=%s\n", displayId,
-              GsyncDisplaySyncStateName(NVAPI_GSYNC_DISPLAY_SYNC_STATE_UNSYNCED));
+  Printf("G-Sync sync state update: displayId=0x%08X state=%s\n", displayId,
+         GsyncDisplaySyncStateName(NVAPI_GSYNC_DISPLAY_SYNC_STATE_UNSYNCED));
 
-  status = NvAPI_GSync_SetSyncStateSettings(displayCount, displays.data(), 0);
+  status = NvApi().NvAPI_GSync_SetSyncStateSettings(displayCount, displays.data(), 0);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_SetSyncStateSettings failed", status);
     return 1;
   }
 
-  std::printf("G-Sync sync state updated.\n");
+  Printf("G-Sync sync state updated.\n");
   return 0;
 }
 
@@ -635,7 +635,7 @@ int CmdGsyncStatus(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid index.\n");
+        Printf("Invalid index.\n");
         return 1;
       }
       hasIndex = true;
@@ -644,19 +644,19 @@ int CmdGsyncStatus(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--gpu-index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &gpuIndex)) {
-        std::printf("Invalid gpu index.\n");
+        Printf("Invalid gpu index.\n");
         return 1;
       }
       hasGpuIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasIndex) {
-    std::printf("Missing required --index\n");
+    Printf("Missing required --index\n");
     return 1;
   }
 
@@ -665,20 +665,20 @@ int CmdGsyncStatus(int argc, char **argv) {
 
   NvU32 gpuCount = 0;
   NvU32 displayCount = 0;
-  NvAPI_Status status = NvAPI_GSync_GetTopology(handle, &gpuCount, NULL, &displayCount, NULL);
+  NvAPI_Status status = NvApi().NvAPI_GSync_GetTopology(handle, &gpuCount, NULL, &displayCount, NULL);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
   }
   if (gpuCount == 0) {
-    std::printf("No G-Sync GPUs found.\n");
+    Printf("No G-Sync GPUs found.\n");
     return 1;
   }
 
   std::vector<NV_GSYNC_GPU> gpus(gpuCount);
   for (NvU32 i = 0; i < gpuCount; ++i) { gpus[i].version = NV_GSYNC_GPU_VER; }
 
-  status = NvAPI_GSync_GetTopology(handle, &gpuCount, gpus.data(), &displayCount, NULL);
+  status = NvApi().NvAPI_GSync_GetTopology(handle, &gpuCount, gpus.data(), &displayCount, NULL);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetTopology failed", status);
     return 1;
@@ -690,7 +690,7 @@ int CmdGsyncStatus(int argc, char **argv) {
     std::vector<NvU32> indices;
     if (!CollectGpus(true, gpuIndex, handles, indices)) { return 1; }
     if (handles.empty()) {
-      std::printf("GPU index %u not found.\n", gpuIndex);
+      Printf("GPU index %u not found.\n", gpuIndex);
       return 1;
     }
     targetGpu = handles[0];
@@ -698,7 +698,7 @@ int CmdGsyncStatus(int argc, char **argv) {
 
   NV_GSYNC_STATUS statusInfo = {};
   statusInfo.version = NV_GSYNC_STATUS_VER;
-  status = NvAPI_GSync_GetSyncStatus(handle, targetGpu, &statusInfo);
+  status = NvApi().NvAPI_GSync_GetSyncStatus(handle, targetGpu, &statusInfo);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetSyncStatus failed", status);
     return 1;
@@ -706,21 +706,21 @@ int CmdGsyncStatus(int argc, char **argv) {
 
   NV_GSYNC_STATUS_PARAMS statusParams = {};
   statusParams.version = NV_GSYNC_STATUS_PARAMS_VER;
-  status = NvAPI_GSync_GetStatusParameters(handle, &statusParams);
+  status = NvApi().NvAPI_GSync_GetStatusParameters(handle, &statusParams);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetStatusParameters failed", status);
     return 1;
   }
 
-  std::printf("G-Sync status:\n");
-  std::printf("  synced=%u stereoSynced=%u signalAvailable=%u\n", statusInfo.bIsSynced ? 1u : 0u,
-              statusInfo.bIsStereoSynced ? 1u : 0u, statusInfo.bIsSyncSignalAvailable ? 1u : 0u);
-  std::printf("  refreshRate=%u Hz houseSyncIncoming=%u Hz houseSync=%u\n", statusParams.refreshRate,
-              statusParams.houseSyncIncoming, statusParams.bHouseSync ? 1u : 0u);
-  std::printf("  internalSlave=%u\n", statusParams.bInternalSlave ? 1u : 0u);
+  Printf("G-Sync status:\n");
+  Printf("  synced=%u stereoSynced=%u signalAvailable=%u\n", statusInfo.bIsSynced ? 1u : 0u,
+         statusInfo.bIsStereoSynced ? 1u : 0u, statusInfo.bIsSyncSignalAvailable ? 1u : 0u);
+  Printf("  refreshRate=%u Hz houseSyncIncoming=%u Hz houseSync=%u\n", statusParams.refreshRate,
+         statusParams.houseSyncIncoming, statusParams.bHouseSync ? 1u : 0u);
+  Printf("  internalSlave=%u\n", statusParams.bInternalSlave ? 1u : 0u);
   for (NvU32 i = 0; i < NVAPI_MAX_RJ45_PER_GSYNC; ++i) {
-    std::printf("  rj45[%u] io=%s ethernet=%u\n", i, GsyncRj45IoName(statusParams.RJ45_IO[i]),
-                statusParams.RJ45_Ethernet[i]);
+    Printf("  rj45[%u] io=%s ethernet=%u\n", i, GsyncRj45IoName(statusParams.RJ45_IO[i]),
+           statusParams.RJ45_Ethernet[i]);
   }
 
   return 0;
@@ -733,19 +733,19 @@ int CmdGsyncControlGet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid index.\n");
+        Printf("Invalid index.\n");
         return 1;
       }
       hasIndex = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasIndex) {
-    std::printf("Missing required --index\n");
+    Printf("Missing required --index\n");
     return 1;
   }
 
@@ -757,20 +757,20 @@ int CmdGsyncControlGet(int argc, char **argv) {
   params.syncSkew.version = NV_GSYNC_DELAY_VER;
   params.startupDelay.version = NV_GSYNC_DELAY_VER;
 
-  NvAPI_Status status = NvAPI_GSync_GetControlParameters(handle, &params);
+  NvAPI_Status status = NvApi().NvAPI_GSync_GetControlParameters(handle, &params);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetControlParameters failed", status);
     return 1;
   }
 
-  std::printf("G-Sync control parameters:\n");
-  std::printf("  polarity=%s videoMode=%s interval=%u\n", GsyncPolarityName(params.polarity),
-              GsyncVideoModeName(params.vmode), params.interval);
-  std::printf("  source=%s interlace=%u syncSourceOutput=%u\n", GsyncSyncSourceName(params.source),
-              params.interlaceMode ? 1u : 0u, params.syncSourceIsOutput ? 1u : 0u);
-  std::printf("  skew=%d startDelay=%d\n", params.skew, params.startDelay);
-  std::printf("  syncSkew lines=%u pixels=%u\n", params.syncSkew.numLines, params.syncSkew.numPixels);
-  std::printf("  startupDelay lines=%u pixels=%u\n", params.startupDelay.numLines, params.startupDelay.numPixels);
+  Printf("G-Sync control parameters:\n");
+  Printf("  polarity=%s videoMode=%s interval=%u\n", GsyncPolarityName(params.polarity),
+         GsyncVideoModeName(params.vmode), params.interval);
+  Printf("  source=%s interlace=%u syncSourceOutput=%u\n", GsyncSyncSourceName(params.source),
+         params.interlaceMode ? 1u : 0u, params.syncSourceIsOutput ? 1u : 0u);
+  Printf("  skew=%d startDelay=%d\n", params.skew, params.startDelay);
+  Printf("  syncSkew lines=%u pixels=%u\n", params.syncSkew.numLines, params.syncSkew.numPixels);
+  Printf("  startupDelay lines=%u pixels=%u\n", params.startupDelay.numLines, params.startupDelay.numPixels);
   return 0;
 }
 
@@ -793,7 +793,7 @@ int CmdGsyncControlSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--index") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &index)) {
-        std::printf("Invalid index.\n");
+        Printf("Invalid index.\n");
         return 1;
       }
       hasIndex = true;
@@ -802,7 +802,7 @@ int CmdGsyncControlSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--polarity") == 0) {
       if (i + 1 >= argc || !ParseGsyncPolarity(argv[i + 1], &polarity)) {
-        std::printf("Invalid --polarity value.\n");
+        Printf("Invalid --polarity value.\n");
         return 1;
       }
       hasPolarity = true;
@@ -811,7 +811,7 @@ int CmdGsyncControlSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--video-mode") == 0) {
       if (i + 1 >= argc || !ParseGsyncVideoMode(argv[i + 1], &videoMode)) {
-        std::printf("Invalid --video-mode value.\n");
+        Printf("Invalid --video-mode value.\n");
         return 1;
       }
       hasVideoMode = true;
@@ -820,7 +820,7 @@ int CmdGsyncControlSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--interval") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &interval)) {
-        std::printf("Invalid --interval value.\n");
+        Printf("Invalid --interval value.\n");
         return 1;
       }
       hasInterval = true;
@@ -829,7 +829,7 @@ int CmdGsyncControlSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--source") == 0) {
       if (i + 1 >= argc || !ParseGsyncSyncSource(argv[i + 1], &source)) {
-        std::printf("Invalid --source value.\n");
+        Printf("Invalid --source value.\n");
         return 1;
       }
       hasSource = true;
@@ -838,7 +838,7 @@ int CmdGsyncControlSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--interlace") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &interlace)) {
-        std::printf("Invalid --interlace value.\n");
+        Printf("Invalid --interlace value.\n");
         return 1;
       }
       hasInterlace = true;
@@ -847,19 +847,19 @@ int CmdGsyncControlSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--sync-source-output") == 0) {
       if (i + 1 >= argc || !ParseBoolValue(argv[i + 1], &syncSourceOutput)) {
-        std::printf("Invalid --sync-source-output value.\n");
+        Printf("Invalid --sync-source-output value.\n");
         return 1;
       }
       hasSyncSourceOutput = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasIndex) {
-    std::printf("Missing required --index\n");
+    Printf("Missing required --index\n");
     return 1;
   }
 
@@ -871,7 +871,7 @@ int CmdGsyncControlSet(int argc, char **argv) {
   params.syncSkew.version = NV_GSYNC_DELAY_VER;
   params.startupDelay.version = NV_GSYNC_DELAY_VER;
 
-  NvAPI_Status status = NvAPI_GSync_GetControlParameters(handle, &params);
+  NvAPI_Status status = NvApi().NvAPI_GSync_GetControlParameters(handle, &params);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_GetControlParameters failed", status);
     return 1;
@@ -884,13 +884,13 @@ int CmdGsyncControlSet(int argc, char **argv) {
   if (hasInterlace) { params.interlaceMode = interlace ? 1u : 0u; }
   if (hasSyncSourceOutput) { params.syncSourceIsOutput = syncSourceOutput ? 1u : 0u; }
 
-  status = NvAPI_GSync_SetControlParameters(handle, &params);
+  status = NvApi().NvAPI_GSync_SetControlParameters(handle, &params);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_SetControlParameters failed", status);
     return 1;
   }
 
-  std::printf("G-Sync control parameters updated.\n");
+  Printf("G-Sync control parameters updated.\n");
   return 0;
 }
 
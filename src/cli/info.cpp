@@ -8,7 +8,7 @@
 namespace nvcli {
 int CmdInfo() {
   NvAPI_ShortString iface = {0};
-  NvAPI_Status status = NvAPI_GetInterfaceVersionString(iface);
+  NvAPI_Status status = NvApi().NvAPI_GetInterfaceVersionString(iface);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GetInterfaceVersionString failed", status);
     return 1;
@@ -16,173 +16,166 @@ int CmdInfo() {
 
   NvU32 driverVersion = 0;
   NvAPI_ShortString branch = {0};
-  status = NvAPI_SYS_GetDriverAndBranchVersion(&driverVersion, branch);
+  status = NvApi().NvAPI_SYS_GetDriverAndBranchVersion(&driverVersion, branch);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_SYS_GetDriverAndBranchVersion failed", status);
     return 1;
   }
 
-  std::printf("NVAPI Interface: %s\n", iface);
-  std::printf("Driver Version: %u\n", driverVersion);
-  std::printf("Driver Branch: %s\n", branch);
+  if (StructuredOutput()) {
+    RecordWriter("driver").Field("interface", iface).Field("version", driverVersion).Field("branch", branch);
+    return 0;
+  }
+  Printf("NVAPI Interface: %s\n", iface);
+  Printf("Driver Version: %u\n", driverVersion);
+  Printf("Driver Branch: %s\n", branch);
   return 0;
 }
 
 void PrintGpuHeader(NvU32 index, NvPhysicalGpuHandle handle) {
   NvAPI_ShortString name = {0};
-  NvAPI_Status status = NvAPI_GPU_GetFullName(handle, name);
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetFullName(handle, name);
   if (status != NVAPI_OK) { strncpy_s(name, sizeof(name), "<name unavailable>", _TRUNCATE); }
-  std::printf("GPU[%u] %s\n", index, name);
+  SetRecordGpu(index);
+  if (StructuredOutput()) {
+    RecordWriter("gpu").Field("name", name);
+    return;
+  }
+  Printf("GPU[%u] %s\n", index, name);
 }
 
 void PrintBusInfo(NvPhysicalGpuHandle handle) {
+  RecordWriter record("bus");
   NvU32 deviceId = 0;
   NvU32 subSystemId = 0;
   NvU32 revisionId = 0;
   NvU32 extDeviceId = 0;
-  NvAPI_Status status = NvAPI_GPU_GetPCIIdentifiers(handle, &deviceId, &subSystemId, &revisionId, &extDeviceId);
-  if (status == NVAPI_OK) {
-    std::printf("  PCI: device=0x%04X subsystem=0x%08X revision=0x%02X ext=0x%08X\n", deviceId, subSystemId, revisionId,
-                extDeviceId);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetPCIIdentifiers failed", status);
-  }
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetPCIIdentifiers(handle, &deviceId, &subSystemId, &revisionId, &extDeviceId);
+  ReportResult(
+      status, "  NvAPI_GPU_GetPCIIdentifiers failed",
+      [&] {
+        record.Hex("device_id", deviceId, 4).Hex("subsystem_id", subSystemId).Hex("revision_id", revisionId, 2);
+        record.Hex("ext_device_id", extDeviceId);
+      },
+      [&] {
+        Printf("  PCI: device=0x%04X subsystem=0x%08X revision=0x%02X ext=0x%08X\n", deviceId, subSystemId, revisionId,
+               extDeviceId);
+      });
 
   NV_GPU_BUS_TYPE busType = NVAPI_GPU_BUS_TYPE_UNDEFINED;
-  status = NvAPI_GPU_GetBusType(handle, &busType);
-  if (status == NVAPI_OK) {
-    std::printf("  Bus: %s\n", BusTypeName(busType));
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetBusType failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetBusType(handle, &busType);
+  ReportResult(status, "  NvAPI_GPU_GetBusType failed", [&] { record.Field("bus_type", BusTypeName(busType)); },
+               [&] { Printf("  Bus: %s\n", BusTypeName(busType)); });
 
   NvU32 busId = 0;
-  status = NvAPI_GPU_GetBusId(handle, &busId);
-  if (status == NVAPI_OK) {
-    std::printf("  Bus ID: %u\n", busId);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetBusId failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetBusId(handle, &busId);
+  ReportResult(status, "  NvAPI_GPU_GetBusId failed", [&] { record.Field("bus_id", busId); },
+               [&] { Printf("  Bus ID: %u\n", busId); });
 
   NvU32 busSlotId = 0;
-  status = NvAPI_GPU_GetBusSlotId(handle, &busSlotId);
-  if (status == NVAPI_OK) {
-    std::printf("  Bus Slot: %u\n", busSlotId);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetBusSlotId failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetBusSlotId(handle, &busSlotId);
+  ReportResult(status, "  NvAPI_GPU_GetBusSlotId failed", [&] { record.Field("bus_slot", busSlotId); },
+               [&] { Printf("  Bus Slot: %u\n", busSlotId); });
 
   NvU32 irq = 0;
-  status = NvAPI_GPU_GetIRQ(handle, &irq);
-  if (status == NVAPI_OK) {
-    std::printf("  IRQ: %u\n", irq);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetIRQ failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetIRQ(handle, &irq);
+  ReportResult(status, "  NvAPI_GPU_GetIRQ failed", [&] { record.Field("irq", irq); },
+               [&] { Printf("  IRQ: %u\n", irq); });
 }
 
 void PrintVbiosInfo(NvPhysicalGpuHandle handle) {
+  RecordWriter record("vbios");
   NvAPI_ShortString vbios = {0};
-  NvAPI_Status status = NvAPI_GPU_GetVbiosVersionString(handle, vbios);
-  if (status == NVAPI_OK) {
-    std::printf("  VBIOS: %s\n", vbios);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetVbiosVersionString failed", status);
-  }
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetVbiosVersionString(handle, vbios);
+  ReportResult(status, "  NvAPI_GPU_GetVbiosVersionString failed", [&] { record.Field("version", vbios); },
+               [&] { Printf("  VBIOS: %s\n", vbios); });
 
   NvU32 revision = 0;
-  status = NvAPI_GPU_GetVbiosRevision(handle, &revision);
-  if (status == NVAPI_OK) {
-    std::printf("  VBIOS Revision: 0x%08X\n", revision);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetVbiosRevision failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetVbiosRevision(handle, &revision);
+  ReportResult(status, "  NvAPI_GPU_GetVbiosRevision failed", [&] { record.Hex("revision", revision); },
+               [&] { Printf("  VBIOS Revision: 0x%08X\n", revision); });
 
   NvU32 oemRevision = 0;
-  status = NvAPI_GPU_GetVbiosOEMRevision(handle, &oemRevision);
-  if (status == NVAPI_OK) {
-    std::printf("  VBIOS OEM Revision: 0x%08X\n", oemRevision);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetVbiosOEMRevision failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetVbiosOEMRevision(handle, &oemRevision);
+  ReportResult(status, "  NvAPI_GPU_GetVbiosOEMRevision failed", [&] { record.Hex("oem_revision", oemRevision); },
+               [&] { Printf("  VBIOS OEM Revision: 0x%08X\n", oemRevision); });
 }
 
 void PrintMemoryInfo(NvPhysicalGpuHandle handle) {
+  RecordWriter record("memory");
   NV_DISPLAY_DRIVER_MEMORY_INFO memory = {};
   memory.version = NV_DISPLAY_DRIVER_MEMORY_INFO_VER;
-  NvAPI_Status status = NvAPI_GPU_GetMemoryInfo(handle, &memory);
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetMemoryInfo(handle, &memory);
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     memory.version = NV_DISPLAY_DRIVER_MEMORY_INFO_VER_2;
-    status = NvAPI_GPU_GetMemoryInfo(handle, &memory);
+    status = NvApi().NvAPI_GPU_GetMemoryInfo(handle, &memory);
   }
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     memory.version = NV_DISPLAY_DRIVER_MEMORY_INFO_VER_1;
-    status = NvAPI_GPU_GetMemoryInfo(handle, &memory);
-  }
-
-  if (status == NVAPI_OK) {
-    std::printf("  Memory (driver):\n");
-    std::printf("    dedicated: %u KB (%.1f MiB)\n", memory.dedicatedVideoMemory, KBToMiB(memory.dedicatedVideoMemory));
-    std::printf("    available: %u KB (%.1f MiB)\n", memory.availableDedicatedVideoMemory,
-                KBToMiB(memory.availableDedicatedVideoMemory));
-    std::printf("    current available: %u KB (%.1f MiB)\n", memory.curAvailableDedicatedVideoMemory,
-                KBToMiB(memory.curAvailableDedicatedVideoMemory));
-    std::printf("    system: %u KB (%.1f MiB)\n", memory.systemVideoMemory, KBToMiB(memory.systemVideoMemory));
-    std::printf("    shared: %u KB (%.1f MiB)\n", memory.sharedSystemMemory, KBToMiB(memory.sharedSystemMemory));
-    std::printf("    eviction size: %u KB\n", memory.dedicatedVideoMemoryEvictionsSize);
-    std::printf("    eviction count: %u\n", memory.dedicatedVideoMemoryEvictionCount);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetMemoryInfo failed", status);
-  }
+    status = NvApi().NvAPI_GPU_GetMemoryInfo(handle, &memory);
+  }
+
+  ReportResult(
+      status, "  NvAPI_GPU_GetMemoryInfo failed",
+      [&] {
+        record.Field("dedicated_kb", memory.dedicatedVideoMemory)
+            .Field("available_kb", memory.availableDedicatedVideoMemory)
+            .Field("current_available_kb", memory.curAvailableDedicatedVideoMemory)
+            .Field("system_kb", memory.systemVideoMemory)
+            .Field("shared_kb", memory.sharedSystemMemory)
+            .Field("eviction_size_kb", memory.dedicatedVideoMemoryEvictionsSize)
+            .Field("eviction_count", memory.dedicatedVideoMemoryEvictionCount);
+      },
+      [&] {
+        Printf("  Memory (driver):\n");
+        Printf("    dedicated: %u KB (%.1f MiB)\n", memory.dedicatedVideoMemory, KBToMiB(memory.dedicatedVideoMemory));
+        Printf("    available: %u KB (%.1f MiB)\n", memory.availableDedicatedVideoMemory,
+               KBToMiB(memory.availableDedicatedVideoMemory));
+        Printf("    current available: %u KB (%.1f MiB)\n", memory.curAvailableDedicatedVideoMemory,
+               KBToMiB(memory.curAvailableDedicatedVideoMemory));
+        Printf("    system: %u KB (%.1f MiB)\n", memory.systemVideoMemory, KBToMiB(memory.systemVideoMemory));
+        Printf("    shared: %u KB (%.1f MiB)\n", memory.sharedSystemMemory, KBToMiB(memory.sharedSystemMemory));
+        Printf("    eviction size: %u KB\n", memory.dedicatedVideoMemoryEvictionsSize);
+        Printf("    eviction count: %u\n", memory.dedicatedVideoMemoryEvictionCount);
+      });
 
   NvU32 physicalFb = 0;
-  status = NvAPI_GPU_GetPhysicalFrameBufferSize(handle, &physicalFb);
-  if (status == NVAPI_OK) {
-    std::printf("  Framebuffer (physical): %u KB (%.1f MiB)\n", physicalFb, KBToMiB(physicalFb));
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetPhysicalFrameBufferSize failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetPhysicalFrameBufferSize(handle, &physicalFb);
+  ReportResult(
+      status, "  NvAPI_GPU_GetPhysicalFrameBufferSize failed",
+      [&] { record.Field("physical_framebuffer_kb", physicalFb); },
+      [&] { Printf("  Framebuffer (physical): %u KB (%.1f MiB)\n", physicalFb, KBToMiB(physicalFb)); });
 
   NvU32 virtualFb = 0;
-  status = NvAPI_GPU_GetVirtualFrameBufferSize(handle, &virtualFb);
-  if (status == NVAPI_OK) {
-    std::printf("  Framebuffer (virtual): %u KB (%.1f MiB)\n", virtualFb, KBToMiB(virtualFb));
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetVirtualFrameBufferSize failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetVirtualFrameBufferSize(handle, &virtualFb);
+  ReportResult(
+      status, "  NvAPI_GPU_GetVirtualFrameBufferSize failed",
+      [&] { record.Field("virtual_framebuffer_kb", virtualFb); },
+      [&] { Printf("  Framebuffer (virtual): %u KB (%.1f MiB)\n", virtualFb, KBToMiB(virtualFb)); });
 
   NV_GPU_RAM_TYPE ramType = NV_GPU_RAM_TYPE_UNKNOWN;
-  status = NvAPI_GPU_GetRamType(handle, &ramType);
-  if (status == NVAPI_OK) {
-    std::printf("  RAM Type: %s\n", RamTypeName(ramType));
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetRamType failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetRamType(handle, &ramType);
+  ReportResult(status, "  NvAPI_GPU_GetRamType failed", [&] { record.Field("ram_type", RamTypeName(ramType)); },
+               [&] { Printf("  RAM Type: %s\n", RamTypeName(ramType)); });
 
   NvU32 ramBusWidth = 0;
-  status = NvAPI_GPU_GetRamBusWidth(handle, &ramBusWidth);
-  if (status == NVAPI_OK) {
-    std::printf("  RAM Bus Width: %u-bit\n", ramBusWidth);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetRamBusWidth failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetRamBusWidth(handle, &ramBusWidth);
+  ReportResult(status, "  NvAPI_GPU_GetRamBusWidth failed", [&] { record.Field("ram_bus_width", ramBusWidth); },
+               [&] { Printf("  RAM Bus Width: %u-bit\n", ramBusWidth); });
 
   NvU32 ramBankCount = 0;
-  status = NvAPI_GPU_GetRamBankCount(handle, &ramBankCount);
-  if (status == NVAPI_OK) {
-    std::printf("  RAM Bank Count: %u\n", ramBankCount);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetRamBankCount failed", status);
-  }
+  status = NvApi().NvAPI_GPU_GetRamBankCount(handle, &ramBankCount);
+  ReportResult(status, "  NvAPI_GPU_GetRamBankCount failed", [&] { record.Field("ram_bank_count", ramBankCount); },
+               [&] { Printf("  RAM Bank Count: %u\n", ramBankCount); });
 }
 
 void PrintBarInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_BAR_INFO barInfo = {};
   barInfo.version = NV_GPU_BAR_INFO_VER;
-  NvAPI_Status status = NvAPI_GPU_GetBarInfo(handle, &barInfo);
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetBarInfo(handle, &barInfo);
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     barInfo.version = NV_GPU_BAR_INFO_VER_1;
-    status = NvAPI_GPU_GetBarInfo(handle, &barInfo);
+    status = NvApi().NvAPI_GPU_GetBarInfo(handle, &barInfo);
   }
 
   if (status != NVAPI_OK) {
@@ -190,10 +183,20 @@ void PrintBarInfo(NvPhysicalGpuHandle handle) {
     return;
   }
 
-  std::printf("  BARs: %u\n", barInfo.count);
+  if (StructuredOutput()) {
+    for (NvU32 i = 0; i < barInfo.count && i < NV_GPU_MAX_BAR_COUNT; ++i) {
+      RecordWriter("bar")
+          .Field("index", i)
+          .Field("size_bytes", static_cast<NvU64>(barInfo.barInfo[i].barSizeBytes))
+          .Hex("offset", barInfo.barInfo[i].barOffset);
+    }
+    return;
+  }
+
+  Printf("  BARs: %u\n", barInfo.count);
   for (NvU32 i = 0; i < barInfo.count && i < NV_GPU_MAX_BAR_COUNT; ++i) {
-    std::printf("    BAR[%u]: size=%.1f MiB offset=0x%llX\n", i, BytesToMiB(barInfo.barInfo[i].barSizeBytes),
-                static_cast<unsigned long long>(barInfo.barInfo[i].barOffset));
+    Printf("    BAR[%u]: size=%.1f MiB offset=0x%llX\n", i, BytesToMiB(barInfo.barInfo[i].barSizeBytes),
+           static_cast<unsigned long long>(barInfo.barInfo[i].barOffset));
   }
 }
 
@@ -202,39 +205,58 @@ void PrintPowerInfo(NvPhysicalGpuHandle handle) {
   NvU32 connectionAtBoot = 0;
   NvU32 currentConnection = 0;
   NvAPI_Status status =
-      NvAPI_GPU_GetPowerConnectorStatus(handle, &connectorCount, &connectionAtBoot, &currentConnection);
-  if (status == NVAPI_OK) {
-    std::printf("  Power connectors: %u\n", connectorCount);
-    std::printf("  Power connected (boot): 0x%08X\n", connectionAtBoot);
-    std::printf("  Power connected (current): 0x%08X\n", currentConnection);
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetPowerConnectorStatus failed", status);
-  }
+      NvApi().NvAPI_GPU_GetPowerConnectorStatus(handle, &connectorCount, &connectionAtBoot, &currentConnection);
+  ReportResult(
+      status, "  NvAPI_GPU_GetPowerConnectorStatus failed",
+      [&] {
+        RecordWriter("power_connectors")
+            .Field("count", connectorCount)
+            .Hex("connected_at_boot", connectionAtBoot)
+            .Hex("connected", currentConnection);
+      },
+      [&] {
+        Printf("  Power connectors: %u\n", connectorCount);
+        Printf("  Power connected (boot): 0x%08X\n", connectionAtBoot);
+        Printf("  Power connected (current): 0x%08X\n", currentConnection);
+      });
 }
 
 void PrintPstateInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_PERF_PSTATE_ID pstate = NVAPI_GPU_PERF_PSTATE_UNDEFINED;
-  NvAPI_Status status = NvAPI_GPU_GetCurrentPstate(handle, &pstate);
-  if (status == NVAPI_OK) {
-    std::printf("  Current Pstate: %s\n", PstateName(pstate));
-  } else {
-    PrintNvapiError("  NvAPI_GPU_GetCurrentPstate failed", status);
-  }
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetCurrentPstate(handle, &pstate);
+  ReportResult(
+      status, "  NvAPI_GPU_GetCurrentPstate failed",
+      [&] { RecordWriter("pstate").Field("current", PstateName(pstate)); },
+      [&] { Printf("  Current Pstate: %s\n", PstateName(pstate)); });
 }
 
 void PrintUtilizationInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_DYNAMIC_PSTATES_INFO_EX pstates = {};
   pstates.version = NV_GPU_DYNAMIC_PSTATES_INFO_EX_VER;
-  NvAPI_Status status = NvAPI_GPU_GetDynamicPstatesInfoEx(handle, &pstates);
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetDynamicPstatesInfoEx(handle, &pstates);
   if (status != NVAPI_OK) {
     PrintNvapiError("  NvAPI_GPU_GetDynamicPstatesInfoEx failed", status);
     return;
   }
 
-  std::printf("  Utilization (dynamic Pstate): %s\n", (pstates.flags & 0x1) ? "enabled" : "disabled");
+  if (StructuredOutput()) {
+    static const char *const kPercentKeys[] = {"gpu_pct", "fb_pct", "vid_pct", "bus_pct"};
+    RecordWriter record("utilization");
+    record.Field("dynamic_pstate", (pstates.flags & 0x1) != 0);
+    for (NvU32 i = 0; i < NVAPI_MAX_GPU_UTILIZATIONS && i < 4; ++i) {
+      if (pstates.utilization[i].bIsPresent) {
+        record.Field(kPercentKeys[i], pstates.utilization[i].percentage);
+      } else {
+        record.Null(kPercentKeys[i]);
+      }
+    }
+    return;
+  }
+
+  Printf("  Utilization (dynamic Pstate): %s\n", (pstates.flags & 0x1) ? "enabled" : "disabled");
   for (NvU32 i = 0; i < NVAPI_MAX_GPU_UTILIZATIONS; ++i) {
     if (!pstates.utilization[i].bIsPresent) { continue; }
-    std::printf("    %s: %u%%\n", UtilizationDomainName(i), pstates.utilization[i].percentage);
+    Printf("    %s: %u%%\n", UtilizationDomainName(i), pstates.utilization[i].percentage);
   }
 }
 
@@ -242,14 +264,14 @@ void PrintClockInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_CLOCK_FREQUENCIES clocks = {};
   clocks.version = NV_GPU_CLOCK_FREQUENCIES_VER;
   clocks.ClockType = NV_GPU_CLOCK_FREQUENCIES_CURRENT_FREQ;
-  NvAPI_Status status = NvAPI_GPU_GetAllClockFrequencies(handle, &clocks);
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetAllClockFrequencies(handle, &clocks);
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     clocks.version = NV_GPU_CLOCK_FREQUENCIES_VER_2;
-    status = NvAPI_GPU_GetAllClockFrequencies(handle, &clocks);
+    status = NvApi().NvAPI_GPU_GetAllClockFrequencies(handle, &clocks);
   }
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     clocks.version = NV_GPU_CLOCK_FREQUENCIES_VER_1;
-    status = NvAPI_GPU_GetAllClockFrequencies(handle, &clocks);
+    status = NvApi().NvAPI_GPU_GetAllClockFrequencies(handle, &clocks);
   }
 
   if (status != NVAPI_OK) {
@@ -257,28 +279,36 @@ void PrintClockInfo(NvPhysicalGpuHandle handle) {
     return;
   }
 
-  std::printf("  Clocks (kHz):\n");
+  if (StructuredOutput()) {
+    for (NvU32 i = 0; i < NVAPI_MAX_GPU_PUBLIC_CLOCKS; ++i) {
+      if (!clocks.domain[i].bIsPresent) { continue; }
+      RecordWriter("clock").Field("domain", ClockDomainName(i)).Field("id", i).Field("khz", clocks.domain[i].frequency);
+    }
+    return;
+  }
+
+  Printf("  Clocks (kHz):\n");
   for (NvU32 i = 0; i < NVAPI_MAX_GPU_PUBLIC_CLOCKS; ++i) {
     if (!clocks.domain[i].bIsPresent) { continue; }
-    std::printf("    %s[%u]: %u kHz\n", ClockDomainName(i), i, clocks.domain[i].frequency);
+    Printf("    %s[%u]: %u kHz\n", ClockDomainName(i), i, clocks.domain[i].frequency);
   }
 }
 
 void PrintCoolerInfo(NvPhysicalGpuHandle handle) {
   NV_GPU_GETCOOLER_SETTINGS coolers = {};
   coolers.version = NV_GPU_GETCOOLER_SETTINGS_VER;
-  NvAPI_Status status = NvAPI_GPU_GetCoolerSettings(handle, NVAPI_COOLER_TARGET_ALL, &coolers);
+  NvAPI_Status status = NvApi().NvAPI_GPU_GetCoolerSettings(handle, NVAPI_COOLER_TARGET_ALL, &coolers);
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     coolers.version = NV_GPU_GETCOOLER_SETTINGS_VER3;
-    status = NvAPI_GPU_GetCoolerSettings(handle, NVAPI_COOLER_TARGET_ALL, &coolers);
+    status = NvApi().NvAPI_GPU_GetCoolerSettings(handle, NVAPI_COOLER_TARGET_ALL, &coolers);
   }
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     coolers.version = NV_GPU_GETCOOLER_SETTINGS_VER2;
-    status = NvAPI_GPU_GetCoolerSettings(handle, NVAPI_COOLER_TARGET_ALL, &coolers);
+    status = NvApi().NvAPI_GPU_GetCoolerSettings(handle, NVAPI_COOLER_TARGET_ALL, &coolers);
   }
   if (status == NVAPI_INCOMPATIBLE_STRUCT_VERSION) {
     coolers.version = NV_GPU_GETCOOLER_SETTINGS_VER1;
-    status = NvAPI_GPU_GetCoolerSettings(handle, NVAPI_COOLER_TARGET_ALL, &coolers);
+    status = NvApi().NvAPI_GPU_GetCoolerSettings(handle, NVAPI_COOLER_TARGET_ALL, &coolers);
   }
 
   if (status != NVAPI_OK) {
@@ -286,30 +316,60 @@ void PrintCoolerInfo(NvPhysicalGpuHandle handle) {
     return;
   }
 
-  std::printf("  Coolers: %u\n", coolers.count);
-  for (NvU32 i = 0; i < coolers.count; ++i) {
-    const auto &cooler = coolers.cooler[i];
-    const bool manualSupported = (cooler.supportedPolicies & NVAPI_COOLER_POLICY_MANUAL) != 0;
-    std::printf("    cooler[%u]: level=%u%% min=%u%% max=%u%% policy=%u target=%u active=%u\n", i, cooler.currentLevel,
-                cooler.currentMinLevel, cooler.currentMaxLevel, cooler.currentPolicy, cooler.target, cooler.active);
-    std::printf("      control=%s supportedPolicies=0x%08X manual=%s\n", CoolerControlName(cooler.controlType),
-                cooler.supportedPolicies, manualSupported ? "yes" : "no");
-    if (cooler.tachometer.bSupported) {
-      std::printf("      tach: %u RPM (min=%u max=%u)\n", cooler.tachometer.speedRPM, cooler.tachometer.minSpeedRPM,
-                  cooler.tachometer.maxSpeedRPM);
+  if (StructuredOutput()) {
+    for (NvU32 i = 0; i < coolers.count; ++i) {
+      const auto &cooler = coolers.cooler[i];
+      RecordWriter record("cooler");
+      record.Field("index", i)
+          .Field("level_pct", cooler.currentLevel)
+          .Field("min_pct", cooler.currentMinLevel)
+          .Field("max_pct", cooler.currentMaxLevel)
+          .Field("policy", static_cast<NvU32>(cooler.currentPolicy))
+          .Field("target", static_cast<NvU32>(cooler.target))
+          .Field("active", static_cast<NvU32>(cooler.active))
+          .Field("control", CoolerControlName(cooler.controlType))
+          .Hex("supported_policies", cooler.supportedPolicies)
+          .Field("manual", (cooler.supportedPolicies & NVAPI_COOLER_POLICY_MANUAL) != 0);
+      // Null when unsupported keeps one column set, so CSV writes every cooler into one table.
+      if (cooler.tachometer.bSupported) {
+        record.Field("tach_rpm", cooler.tachometer.speedRPM)
+            .Field("tach_min_rpm", cooler.tachometer.minSpeedRPM)
+            .Field("tach_max_rpm", cooler.tachometer.maxSpeedRPM);
+      } else {
+        record.Null("tach_rpm").Null("tach_min_rpm").Null("tach_max_rpm");
+      }
+    }
+  } else {
+    Printf("  Coolers: %u\n", coolers.count);
+    for (NvU32 i = 0; i < coolers.count; ++i) {
+      const auto &cooler = coolers.cooler[i];
+      const bool manualSupported = (cooler.supportedPolicies & NVAPI_COOLER_POLICY_MANUAL) != 0;
+      Printf("    cooler[%u]: level=%u%% min=%u%% max=%u%% policy=%u target=%u active=%u\n", i, cooler.currentLevel,
+             cooler.currentMinLevel, cooler.currentMaxLevel, cooler.currentPolicy, cooler.target, cooler.active);
+      Printf("      control=%s supportedPolicies=0x%08X manual=%s\n", CoolerControlName(cooler.controlType),
+             cooler.supportedPolicies, manualSupported ? "yes" : "no");
+      if (cooler.tachometer.bSupported) {
+        Printf("      tach: %u RPM (min=%u max=%u)\n", cooler.tachometer.speedRPM, cooler.tachometer.minSpeedRPM,
+               cooler.tachometer.maxSpeedRPM);
+      }
     }
   }
 
   NvU32 tachReading = 0;
-  status = NvAPI_GPU_GetTachReading(handle, &tachReading);
-  if (status == NVAPI_OK) { std::printf("  Tachometer: %u RPM\n", tachReading); }
+  status = NvApi().NvAPI_GPU_GetTachReading(handle, &tachReading);
+  if (status != NVAPI_OK) { return; }
+  if (StructuredOutput()) {
+    RecordWriter("tachometer").Field("rpm", tachReading);
+  } else {
+    Printf("  Tachometer: %u RPM\n", tachReading);
+  }
 }
 
 void PrintHexBytes(const NvU8 *data, NvU32 size) {
   for (NvU32 i = 0; i < size; ++i) {
-    if (i % 16 == 0) { std::printf("    "); }
-    std::printf("%02X ", data[i]);
-    if (i % 16 == 15 || i + 1 == size) { std::printf("\n"); }
+    if (i % 16 == 0) { Printf("    "); }
+    Printf("%02X ", data[i]);
+    if (i % 16 == 15 || i + 1 == size) { Printf("\n"); }
   }
 }
 
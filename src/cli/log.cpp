@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/telemetry_log.h"
+
+namespace nvcli {
+namespace {
+void PrintLogUsage() { PrintUsageGroup("log"); }
+
+// --from/--to are seconds relative to the first row of the log.
+bool ParseLogTime(const char *value, double *out) {
+  if (!ParseDoubleValue(value, out) || *out < 0.0) {
+    Printf("Invalid time value: %s\n", value ? value : "");
+    return false;
+  }
+  return true;
+}
+
+bool SelectColumns(const std::vector<std::string> &columns, const char *metrics, std::vector<size_t> *wanted) {
+  wanted->clear();
+  if (!metrics) {
+    for (size_t i = 0; i < columns.size(); ++i) { wanted->push_back(i); }
+    return true;
+  }
+  std::string list(metrics);
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t comma = list.find(',', start);
+    if (comma == std::string::npos) { comma = list.size(); }
+    const std::string pattern = list.substr(start, comma - start);
+    bool matched = false;
+    for (size_t i = 0; i < columns.size(); ++i) {
+      // A pattern without a GPU prefix selects the metric on every GPU ("power.total_mw" = "gpu*.power.total_mw").
+      const size_t dot = columns[i].find('.');
+      const char *metric = dot == std::string::npos ? columns[i].c_str() : columns[i].c_str() + dot + 1;
+      if (!WildcardMatch(pattern.c_str(), columns[i].c_str()) && !WildcardMatch(pattern.c_str(), metric)) {
+        continue;
+      }
+      if (std::find(wanted->begin(), wanted->end(), i) == wanted->end()) { wanted->push_back(i); }
+      matched = true;
+    }
+    if (!matched) {
+      Printf("No metric matches %s\n", pattern.c_str());
+      return false;
+    }
+    start = comma + 1;
+  }
+  return true;
+}
+
+int CmdLogRead(int argc, char **argv) {
+  const char *path = nullptr;
+  const char *metrics = nullptr;
+  double fromSec = 0.0;
+  double toSec = -1.0;
+
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--from") == 0) {
+      if (i + 1 >= argc || !ParseLogTime(argv[i + 1], &fromSec)) { return 1; }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--to") == 0) {
+      if (i + 1 >= argc || !ParseLogTime(argv[i + 1], &toSec)) { return 1; }
+      ++i;
+      continue;
+    }
+    if (std::strcmp(argv[i], "--metric") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --metric\n");
+        return 1;
+      }
+      metrics = argv[i + 1];
+      ++i;
+      continue;
+    }
+    if (argv[i][0] == '-' || path) {
+      Printf("Unknown option: %s\n", argv[i]);
+      return 1;
+    }
+    path = argv[i];
+  }
+  if (!path) {
+    PrintLogUsage();
+    return 1;
+  }
+
+  TelemetryLogReader reader;
+  if (!reader.Open(path)) { return 1; }
+  std::vector<size_t> wanted;
+  if (!SelectColumns(reader.columns(), metrics, &wanted)) { return 1; }
+  if (reader.blocks().empty()) { return 0; }
+
+  const NvU64 originUs = reader.blocks().front().firstUs;
+  const NvU64 fromUs = originUs + static_cast<NvU64>(fromSec * 1e6);
+  const NvU64 toUs = toSec < 0.0 ? ~0ull : originUs + static_cast<NvU64>(toSec * 1e6);
+
+  std::vector<NvU64> timestamps;
+  std::vector<NvS64> values;
+  std::vector<NvU8> present;
+  std::string line;
+  char chunk[96];
+  for (size_t block = reader.FindBlock(fromUs); block < reader.blocks().size(); ++block) {
+    if (reader.blocks()[block].firstUs > toUs) { break; }
+    if (!reader.ReadBlock(block, wanted, &timestamps, &values, &present)) {
+      Printf("Failed to decode block %zu of %s\n", block, path);
+      return 1;
+    }
+    for (size_t row = 0; row < timestamps.size(); ++row) {
+      if (timestamps[row] < fromUs || timestamps[row] > toUs) { continue; }
+      const NvS64 *rowValues = values.data() + row * wanted.size();
+      const NvU8 *rowPresent = present.data() + row * wanted.size();
+      if (std::find(rowPresent, rowPresent + wanted.size(), 1) == rowPresent + wanted.size()) { continue; }
+
+      const double seconds = static_cast<double>(timestamps[row] - originUs) / 1e6;
+      if (StructuredOutput()) {
+        RecordWriter record("log_row");
+        record.Field("t", seconds).Field("time_us", timestamps[row]);
+        for (size_t i = 0; i < wanted.size(); ++i) {
+          const char *name = reader.columns()[wanted[i]].c_str();
+          if (rowPresent[i]) {
+            record.Field(name, static_cast<NvS64>(rowValues[i]));
+          } else {
+            record.Null(name);
+          }
+        }
+        continue;
+      }
+      std::snprintf(chunk, sizeof(chunk), "t=%.6f", seconds);
+      line.assign(chunk);
+      for (size_t i = 0; i < wanted.size(); ++i) {
+        if (rowPresent[i]) {
+          std::snprintf(chunk, sizeof(chunk), " %s=%lld", reader.columns()[wanted[i]].c_str(),
+                        static_cast<long long>(rowValues[i]));
+        } else {
+          std::snprintf(chunk, sizeof(chunk), " %s=-", reader.columns()[wanted[i]].c_str());
+        }
+        line.append(chunk);
+      }
+      Printf("%s\n", line.c_str());
+    }
+  }
+  return 0;
+}
+
+int CmdLogInfo(int argc, char **argv) {
+  if (argc != 1) {
+    PrintLogUsage();
+    return 1;
+  }
+  TelemetryLogReader reader;
+  if (!reader.Open(argv[0])) { return 1; }
+
+  NvU64 rows = 0;
+  for (const auto &block : reader.blocks()) { rows += block.rows; }
+  double spanSec = 0.0;
+  if (!reader.blocks().empty()) {
+    spanSec = static_cast<double>(reader.blocks().back().lastUs - reader.blocks().front().firstUs) / 1e6;
+  }
+  if (StructuredOutput()) {
+    RecordWriter("log_info")
+        .Field("path", argv[0])
+        .Field("columns", static_cast<NvU32>(reader.columns().size()))
+        .Field("blocks", static_cast<NvU32>(reader.blocks().size()))
+        .Field("rows", rows)
+        .Field("span_s", spanSec)
+        .Field("bytes", reader.dataEnd())
+        .Field("indexed", reader.indexed());
+    for (const auto &name : reader.columns()) { RecordWriter("log_metric").Field("name", name); }
+    return 0;
+  }
+  Printf("%s\n", argv[0]);
+  Printf("  Rows: %llu in %zu blocks, %.3f s\n", static_cast<unsigned long long>(rows), reader.blocks().size(),
+         spanSec);
+  Printf("  Data: %llu bytes (%.1f bytes/row)%s\n", static_cast<unsigned long long>(reader.dataEnd()),
+         rows > 0 ? static_cast<double>(reader.dataEnd()) / rows : 0.0,
+         reader.indexed() ? "" : ", no block index (not closed cleanly)");
+  Printf("  Metrics (%zu):\n", reader.columns().size());
+  for (const auto &name : reader.columns()) { Printf("    %s\n", name.c_str()); }
+  return 0;
+}
+
+const SubcommandEntry kLogCommands[] = {
+    {"read", CmdLogRead},
+    {"info", CmdLogInfo},
+};
+} // namespace
+
+int CmdLog(int argc, char **argv) {
+  return DispatchSubcommand("log", argc, argv, kLogCommands, sizeof(kLogCommands) / sizeof(kLogCommands[0]),
+                            PrintLogUsage);
+}
+} // namespace nvcli
@@ -4,6 +4,7 @@
  */
 
 #include "cli/commands.h"
+#include "cli/topology.h"
 
 namespace nvcli {
 namespace {
@@ -24,32 +25,30 @@ int CmdMosaicCaps(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
 
     NV_MOSAIC_CAPS caps = {};
     caps.version = NV_MOSAIC_CAPS_VER;
-    NvAPI_Status status = NvAPI_Mosaic_GetSingleGpuMosaicCaps(handles[i], &caps);
+    NvAPI_Status status = NvApi().NvAPI_Mosaic_GetSingleGpuMosaicCaps(handles[i], &caps);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_Mosaic_GetSingleGpuMosaicCaps failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  Mosaic caps:\n");
-    std::printf("    supportsMosaic=%u supportsImmersiveGaming=%u supportsPassiveStereo=%u\n",
-                caps.bSupportsMosaic ? 1 : 0, caps.bSupportsImmersiveGaming ? 1 : 0,
-                caps.bSupportsPassiveStereo ? 1 : 0);
-    std::printf("    supportsOverlap=%u supportsGaps=%u supportsUnevenGapping=%u\n", caps.bSupportsOverlap ? 1 : 0,
-                caps.bSupportsGaps ? 1 : 0, caps.bSupportsUnevenGapping ? 1 : 0);
-    std::printf("    supportsPerDisplaySettings=%u supportsPerDisplayRotation=%u supportsGlobalRotation=%u\n",
-                caps.bSupportsPerDisplaySettings ? 1 : 0, caps.bSupportsPerDisplayRotation ? 1 : 0,
-                caps.bSupportsGlobalRotation ? 1 : 0);
-    std::printf("    supportsPixelShift=%u supports4QuadrantPixelShift=%u supportsPerDisplayMirroring=%u\n",
-                caps.bSupportsPixelShift ? 1 : 0, caps.bSupports4QuadrantPixelShift ? 1 : 0,
-                caps.bSupportsPerDisplayMirroring ? 1 : 0);
-  }
-
-  return 0;
+    Printf("  Mosaic caps:\n");
+    Printf("    supportsMosaic=%u supportsImmersiveGaming=%u supportsPassiveStereo=%u\n", caps.bSupportsMosaic ? 1 : 0,
+           caps.bSupportsImmersiveGaming ? 1 : 0, caps.bSupportsPassiveStereo ? 1 : 0);
+    Printf("    supportsOverlap=%u supportsGaps=%u supportsUnevenGapping=%u\n", caps.bSupportsOverlap ? 1 : 0,
+           caps.bSupportsGaps ? 1 : 0, caps.bSupportsUnevenGapping ? 1 : 0);
+    Printf("    supportsPerDisplaySettings=%u supportsPerDisplayRotation=%u supportsGlobalRotation=%u\n",
+           caps.bSupportsPerDisplaySettings ? 1 : 0, caps.bSupportsPerDisplayRotation ? 1 : 0,
+           caps.bSupportsGlobalRotation ? 1 : 0);
+    Printf("    supportsPixelShift=%u supports4QuadrantPixelShift=%u supportsPerDisplayMirroring=%u\n",
+           caps.bSupportsPixelShift ? 1 : 0, caps.bSupports4QuadrantPixelShift ? 1 : 0,
+           caps.bSupportsPerDisplayMirroring ? 1 : 0);
+    return 0;
+  });
 }
 
 int CmdMosaicSupported(int argc, char **argv) {
@@ -58,7 +57,7 @@ int CmdMosaicSupported(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--type") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --type\n");
+        Printf("Missing value for --type\n");
         return 1;
       }
       std::string value = ToLowerAscii(argv[i + 1]);
@@ -73,7 +72,7 @@ int CmdMosaicSupported(int argc, char **argv) {
       } else if (value == "passive-stereo-scaled-clone") {
         type = NV_MOSAIC_TOPO_TYPE_PASSIVE_STEREO_SCALED_CLONE;
       } else {
-        std::printf("Unknown type: %s\n", argv[i + 1]);
+        Printf("Unknown type: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
@@ -81,43 +80,43 @@ int CmdMosaicSupported(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--limit") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --limit\n");
+        Printf("Missing value for --limit\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &limit)) {
-        std::printf("Invalid limit: %s\n", argv[i + 1]);
+        Printf("Invalid limit: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   NV_MOSAIC_SUPPORTED_TOPO_INFO info = {};
   info.version = NVAPI_MOSAIC_SUPPORTED_TOPO_INFO_VER;
-  NvAPI_Status status = NvAPI_Mosaic_GetSupportedTopoInfo(&info, type);
+  NvAPI_Status status = NvApi().NvAPI_Mosaic_GetSupportedTopoInfo(&info, type);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Mosaic_GetSupportedTopoInfo failed", status);
     return 1;
   }
 
-  std::printf("Mosaic supported topologies (type=%s): %u\n", MosaicTopoTypeName(type), info.topoBriefsCount);
+  Printf("Mosaic supported topologies (type=%s): %u\n", MosaicTopoTypeName(type), info.topoBriefsCount);
   for (NvU32 i = 0; i < info.topoBriefsCount; ++i) {
     const NV_MOSAIC_TOPO_BRIEF &brief = info.topoBriefs[i];
-    std::printf("  topo=0x%08X (%s) enabled=%u possible=%u\n", brief.topo, MosaicTopoName(brief.topo), brief.enabled,
-                brief.isPossible);
+    Printf("  topo=0x%08X (%s) enabled=%u possible=%u\n", brief.topo, MosaicTopoName(brief.topo), brief.enabled,
+           brief.isPossible);
   }
 
-  std::printf("Display settings: %u\n", info.displaySettingsCount);
+  Printf("Display settings: %u\n", info.displaySettingsCount);
   NvU32 displayLimit = info.displaySettingsCount < limit ? info.displaySettingsCount : limit;
   for (NvU32 i = 0; i < displayLimit; ++i) {
     const NV_MOSAIC_DISPLAY_SETTING &setting = info.displaySettings[i];
-    std::printf("  [%u] %ux%u bpp=%u freq=%u rrx1k=%u\n", i, setting.width, setting.height, setting.bpp, setting.freq,
-                setting.rrx1k);
+    Printf("  [%u] %ux%u bpp=%u freq=%u rrx1k=%u\n", i, setting.width, setting.height, setting.bpp, setting.freq,
+           setting.rrx1k);
   }
-  if (info.displaySettingsCount > displayLimit) { std::printf("  ... (use --limit to show more)\n"); }
+  if (info.displaySettingsCount > displayLimit) { Printf("  ... (use --limit to show more)\n"); }
 
   return 0;
 }
@@ -130,17 +129,17 @@ int CmdMosaicCurrent() {
   NvS32 overlapX = 0;
   NvS32 overlapY = 0;
 
-  NvAPI_Status status = NvAPI_Mosaic_GetCurrentTopo(&topo, &display, &overlapX, &overlapY);
+  NvAPI_Status status = NvApi().NvAPI_Mosaic_GetCurrentTopo(&topo, &display, &overlapX, &overlapY);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Mosaic_GetCurrentTopo failed", status);
     return 1;
   }
 
-  std::printf("Current mosaic topology:\n");
-  std::printf("  topo=0x%08X (%s) enabled=%u possible=%u\n", topo.topo, MosaicTopoName(topo.topo), topo.enabled,
-              topo.isPossible);
-  std::printf("  display=%ux%u bpp=%u freq=%u rrx1k=%u overlapX=%d overlapY=%d\n", display.width, display.height,
-              display.bpp, display.freq, display.rrx1k, overlapX, overlapY);
+  Printf("Current mosaic topology:\n");
+  Printf("  topo=0x%08X (%s) enabled=%u possible=%u\n", topo.topo, MosaicTopoName(topo.topo), topo.enabled,
+         topo.isPossible);
+  Printf("  display=%ux%u bpp=%u freq=%u rrx1k=%u overlapX=%d overlapY=%d\n", display.width, display.height,
+         display.bpp, display.freq, display.rrx1k, overlapX, overlapY);
   return 0;
 }
 
@@ -151,34 +150,35 @@ int CmdMosaicEnable(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--state") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --state\n");
+        Printf("Missing value for --state\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &state)) {
-        std::printf("Invalid state: %s\n", argv[i + 1]);
+        Printf("Invalid state: %s\n", argv[i + 1]);
         return 1;
       }
       hasState = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasState) {
-    std::printf("Missing required --state 0|1\n");
+    Printf("Missing required --state 0|1\n");
     return 1;
   }
 
-  std::printf("Mosaic enable request: %s\n", state ? "on" : "off");
-  NvAPI_Status status = NvAPI_Mosaic_EnableCurrentTopo(state ? 1 : 0);
+  Printf("Mosaic enable request: %s\n", state ? "on" : "off");
+  NvAPI_Status status = NvApi().NvAPI_Mosaic_EnableCurrentTopo(state ? 1 : 0);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Mosaic_EnableCurrentTopo failed", status);
     return 1;
   }
+  Topology().Invalidate();
 
-  std::printf("Mosaic state updated.\n");
+  Printf("Mosaic state updated.\n");
   return 0;
 }
 
@@ -187,36 +187,36 @@ int CmdMosaicDisplayCaps(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--limit") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --limit\n");
+        Printf("Missing value for --limit\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &limit)) {
-        std::printf("Invalid limit: %s\n", argv[i + 1]);
+        Printf("Invalid limit: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   NV_MOSAIC_DISPLAY_CAPS caps = {};
   caps.version = NV_MOSAIC_DISPLAY_CAPS_VER;
-  NvAPI_Status status = NvAPI_Mosaic_GetDisplayCapabilities(&caps);
+  NvAPI_Status status = NvApi().NvAPI_Mosaic_GetDisplayCapabilities(&caps);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Mosaic_GetDisplayCapabilities failed", status);
     return 1;
   }
 
-  std::printf("Mosaic display capabilities: %u settings\n", caps.displaySettingsCount);
+  Printf("Mosaic display capabilities: %u settings\n", caps.displaySettingsCount);
   NvU32 displayLimit = caps.displaySettingsCount < limit ? caps.displaySettingsCount : limit;
   for (NvU32 i = 0; i < displayLimit; ++i) {
     const NV_MOSAIC_DISPLAY_SETTING &setting = caps.displaySettings[i];
-    std::printf("  [%u] %ux%u bpp=%u freq=%u rrx1k=%u\n", i, setting.width, setting.height, setting.bpp, setting.freq,
-                setting.rrx1k);
+    Printf("  [%u] %ux%u bpp=%u freq=%u rrx1k=%u\n", i, setting.width, setting.height, setting.bpp, setting.freq,
+           setting.rrx1k);
   }
-  if (caps.displaySettingsCount > displayLimit) { std::printf("  ... (use --limit to show more)\n"); }
+  if (caps.displaySettingsCount > displayLimit) { Printf("  ... (use --limit to show more)\n"); }
   return 0;
 }
 
@@ -13,9 +13,9 @@ void PrintOglContextInfo() {
   const char *vendor = reinterpret_cast<const char *>(glGetString(GL_VENDOR));
   const char *renderer = reinterpret_cast<const char *>(glGetString(GL_RENDERER));
   const char *version = reinterpret_cast<const char *>(glGetString(GL_VERSION));
-  std::printf("OpenGL vendor: %s\n", vendor ? vendor : "<null>");
-  std::printf("OpenGL renderer: %s\n", renderer ? renderer : "<null>");
-  std::printf("OpenGL version: %s\n", version ? version : "<null>");
+  Printf("OpenGL vendor: %s\n", vendor ? vendor : "<null>");
+  Printf("OpenGL renderer: %s\n", renderer ? renderer : "<null>");
+  Printf("OpenGL version: %s\n", version ? version : "<null>");
 }
 
 struct OglContext {
@@ -61,13 +61,13 @@ HWND CreateHiddenWindow() {
 bool CreateOglContext(OglContext &ctx) {
   ctx.window = CreateHiddenWindow();
   if (!ctx.window) {
-    std::printf("Failed to create hidden window.\n");
+    Printf("Failed to create hidden window.\n");
     return false;
   }
 
   ctx.dc = GetDC(ctx.window);
   if (!ctx.dc) {
-    std::printf("Failed to get device context.\n");
+    Printf("Failed to get device context.\n");
     return false;
   }
 
@@ -82,22 +82,22 @@ bool CreateOglContext(OglContext &ctx) {
 
   int pixelFormat = ChoosePixelFormat(ctx.dc, &pfd);
   if (pixelFormat == 0) {
-    std::printf("ChoosePixelFormat failed.\n");
+    Printf("ChoosePixelFormat failed.\n");
     return false;
   }
   if (!SetPixelFormat(ctx.dc, pixelFormat, &pfd)) {
-    std::printf("SetPixelFormat failed.\n");
+    Printf("SetPixelFormat failed.\n");
     return false;
   }
 
   ctx.rc = wglCreateContext(ctx.dc);
   if (!ctx.rc) {
-    std::printf("wglCreateContext failed.\n");
+    Printf("wglCreateContext failed.\n");
     return false;
   }
 
   if (!wglMakeCurrent(ctx.dc, ctx.rc)) {
-    std::printf("wglMakeCurrent failed.\n");
+    Printf("wglMakeCurrent failed.\n");
     return false;
   }
 
@@ -105,16 +105,16 @@ bool CreateOglContext(OglContext &ctx) {
 }
 
 void PrintOglUsage() {
-  std::printf("OpenGL toolchain commands:\n");
-  std::printf("  %s ogl expert get\n", kToolName);
-  std::printf("  %s ogl expert set --detail MASK --report MASK --output MASK\n", kToolName);
-  std::printf("  %s ogl expert defaults-get\n", kToolName);
-  std::printf("  %s ogl expert defaults-set --detail MASK --report MASK --output MASK\n", kToolName);
+  Printf("OpenGL toolchain commands:\n");
+  Printf("  %s ogl expert get\n", kToolName);
+  Printf("  %s ogl expert set --detail MASK --report MASK --output MASK\n", kToolName);
+  Printf("  %s ogl expert defaults-get\n", kToolName);
+  Printf("  %s ogl expert defaults-set --detail MASK --report MASK --output MASK\n", kToolName);
 }
 
 int CmdOglExpert(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing expert command.\n");
+    Printf("Missing expert command.\n");
     return 1;
   }
 
@@ -129,7 +129,7 @@ int CmdOglExpert(int argc, char **argv) {
     NvU32 report = 0;
     NvU32 output = 0;
     NVAPI_OGLEXPERT_CALLBACK callback = nullptr;
-    NvAPI_Status status = NvAPI_OGL_ExpertModeGet(&detail, &report, &output, &callback);
+    NvAPI_Status status = NvApi().NvAPI_OGL_ExpertModeGet(&detail, &report, &output, &callback);
     if (status != NVAPI_OK) {
       PrintOglContextInfo();
       PrintNvapiError("NvAPI_OGL_ExpertModeGet failed", status);
@@ -137,9 +137,9 @@ int CmdOglExpert(int argc, char **argv) {
       return 1;
     }
 
-    std::printf("Expert detail mask: 0x%08X\n", detail);
-    std::printf("Expert report mask: 0x%08X\n", report);
-    std::printf("Expert output mask: 0x%08X\n", output);
+    Printf("Expert detail mask: 0x%08X\n", detail);
+    Printf("Expert report mask: 0x%08X\n", report);
+    Printf("Expert output mask: 0x%08X\n", output);
 
     ctx.Cleanup();
     return 0;
@@ -156,11 +156,11 @@ int CmdOglExpert(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--detail") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --detail\n");
+          Printf("Missing value for --detail\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &detail)) {
-          std::printf("Invalid detail mask: %s\n", argv[i + 1]);
+          Printf("Invalid detail mask: %s\n", argv[i + 1]);
           return 1;
         }
         hasDetail = true;
@@ -169,11 +169,11 @@ int CmdOglExpert(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--report") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --report\n");
+          Printf("Missing value for --report\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &report)) {
-          std::printf("Invalid report mask: %s\n", argv[i + 1]);
+          Printf("Invalid report mask: %s\n", argv[i + 1]);
           return 1;
         }
         hasReport = true;
@@ -182,23 +182,23 @@ int CmdOglExpert(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--output") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --output\n");
+          Printf("Missing value for --output\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &output)) {
-          std::printf("Invalid output mask: %s\n", argv[i + 1]);
+          Printf("Invalid output mask: %s\n", argv[i + 1]);
           return 1;
         }
         hasOutput = true;
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
 
     if (!hasDetail || !hasReport || !hasOutput) {
-      std::printf("Missing required masks (--detail, --report, --output).\n");
+      Printf("Missing required masks (--detail, --report, --output).\n");
       return 1;
     }
 
@@ -208,7 +208,7 @@ int CmdOglExpert(int argc, char **argv) {
       return 1;
     }
 
-    NvAPI_Status status = NvAPI_OGL_ExpertModeSet(detail, report, output, nullptr);
+    NvAPI_Status status = NvApi().NvAPI_OGL_ExpertModeSet(detail, report, output, nullptr);
     if (status != NVAPI_OK) {
       PrintOglContextInfo();
       PrintNvapiError("NvAPI_OGL_ExpertModeSet failed", status);
@@ -216,7 +216,7 @@ int CmdOglExpert(int argc, char **argv) {
       return 1;
     }
 
-    std::printf("Expert mode updated.\n");
+    Printf("Expert mode updated.\n");
     ctx.Cleanup();
     return 0;
   }
@@ -225,14 +225,14 @@ int CmdOglExpert(int argc, char **argv) {
     NvU32 detail = 0;
     NvU32 report = 0;
     NvU32 output = 0;
-    NvAPI_Status status = NvAPI_OGL_ExpertModeDefaultsGet(&detail, &report, &output);
+    NvAPI_Status status = NvApi().NvAPI_OGL_ExpertModeDefaultsGet(&detail, &report, &output);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_OGL_ExpertModeDefaultsGet failed", status);
       return 1;
     }
-    std::printf("Default detail mask: 0x%08X\n", detail);
-    std::printf("Default report mask: 0x%08X\n", report);
-    std::printf("Default output mask: 0x%08X\n", output);
+    Printf("Default detail mask: 0x%08X\n", detail);
+    Printf("Default report mask: 0x%08X\n", report);
+    Printf("Default output mask: 0x%08X\n", output);
     return 0;
   }
 
@@ -247,11 +247,11 @@ int CmdOglExpert(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--detail") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --detail\n");
+          Printf("Missing value for --detail\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &detail)) {
-          std::printf("Invalid detail mask: %s\n", argv[i + 1]);
+          Printf("Invalid detail mask: %s\n", argv[i + 1]);
           return 1;
         }
         hasDetail = true;
@@ -260,11 +260,11 @@ int CmdOglExpert(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--report") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --report\n");
+          Printf("Missing value for --report\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &report)) {
-          std::printf("Invalid report mask: %s\n", argv[i + 1]);
+          Printf("Invalid report mask: %s\n", argv[i + 1]);
           return 1;
         }
         hasReport = true;
@@ -273,36 +273,36 @@ int CmdOglExpert(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--output") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --output\n");
+          Printf("Missing value for --output\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &output)) {
-          std::printf("Invalid output mask: %s\n", argv[i + 1]);
+          Printf("Invalid output mask: %s\n", argv[i + 1]);
           return 1;
         }
         hasOutput = true;
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
 
     if (!hasDetail || !hasReport || !hasOutput) {
-      std::printf("Missing required masks (--detail, --report, --output).\n");
+      Printf("Missing required masks (--detail, --report, --output).\n");
       return 1;
     }
 
-    NvAPI_Status status = NvAPI_OGL_ExpertModeDefaultsSet(detail, report, output);
+    NvAPI_Status status = NvApi().NvAPI_OGL_ExpertModeDefaultsSet(detail, report, output);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_OGL_ExpertModeDefaultsSet failed", status);
       return 1;
     }
-    std::printf("Expert defaults updated.\n");
+    Printf("Expert defaults updated.\n");
     return 0;
   }
 
-  std::printf("Unknown expert command: %s\n", argv[0]);
+  Printf("Unknown expert command: %s\n", argv[0]);
   return 1;
 }
 } // namespace
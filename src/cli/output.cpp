@@ -0,0 +1,554 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/common.h"
+
+#include <cmath>
+#include <cstdarg>
+#include <mutex>
+
+namespace nvcli {
+namespace {
+// Marks a CSV header line inside a record stream, the framer strips it and sorts the rows after it into its table.
+constexpr char kCsvHeaderMarker = '\x01';
+// Room kept free at the end of a record for the closing bytes and the truncated flag.
+constexpr size_t kRecordReserve = 32;
+
+OutputFormat g_outputFormat = OutputFormat::Text;
+std::mutex g_stdoutLock;
+thread_local std::string *t_outputBuffer = nullptr;
+// Set while t_outputBuffer is shared with other threads through an OutputShare.
+thread_local std::mutex *t_outputLock = nullptr;
+thread_local PendingText t_pendingText;
+thread_local std::string t_linePrefix;
+thread_local bool t_atLineStart = true;
+thread_local bool t_hasRecordGpu = false;
+thread_local NvU32 t_recordGpu = 0;
+
+OutputFramer &StdoutFramer() {
+  static OutputFramer framer(stdout);
+  return framer;
+}
+
+void AppendOutputBuffer(const char *head, size_t headSize, const char *data, size_t size) {
+  std::unique_lock<std::mutex> guard;
+  if (t_outputLock) { guard = std::unique_lock<std::mutex>(*t_outputLock); }
+  if (headSize > 0) { t_outputBuffer->append(head, headSize); }
+  t_outputBuffer->append(data, size);
+}
+
+// Writes both parts under one lock so a CSV header and its row are never split by another thread.
+void EmitRecord(OutputFramer *target, const char *head, size_t headSize, const char *data, size_t size) {
+  if (target) {
+    target->Write(head, headSize);
+    target->Write(data, size);
+    return;
+  }
+  if (t_outputBuffer) {
+    AppendOutputBuffer(head, headSize, data, size);
+    return;
+  }
+  std::lock_guard<std::mutex> guard(g_stdoutLock);
+  StdoutFramer().Write(head, headSize);
+  StdoutFramer().Write(data, size);
+}
+
+void EmitTextRecord(const char *line, size_t length) {
+  char text[kMaxRecordSize];
+  length = std::min(length, sizeof(text) - 1);
+  std::memcpy(text, line, length);
+  text[length] = '\0';
+  RecordWriter("text").Field("text", text);
+}
+
+// A line longer than one record is cut here already, EmitTextRecord would drop the rest anyway.
+void AppendPendingText(const char *data, size_t size) {
+  size = std::min(size, sizeof(t_pendingText.data) - t_pendingText.size);
+  std::memcpy(t_pendingText.data + t_pendingText.size, data, size);
+  t_pendingText.size += size;
+}
+
+// Collects Printf output until a full line is available, structured formats carry free text one line per record.
+void EmitText(const char *data, size_t size) {
+  while (size > 0) {
+    const char *newline = static_cast<const char *>(std::memchr(data, '\n', size));
+    if (!newline) {
+      AppendPendingText(data, size);
+      return;
+    }
+    const size_t length = static_cast<size_t>(newline - data);
+    if (t_pendingText.size == 0) {
+      EmitTextRecord(data, length);
+    } else {
+      AppendPendingText(data, length);
+      EmitTextRecord(t_pendingText.data, t_pendingText.size);
+      t_pendingText.size = 0;
+    }
+    data += length + 1;
+    size -= length + 1;
+  }
+}
+
+// One write per Printf under the stdout or share lock, so prefixed lines from different threads never mix within a
+// line, captured or not.
+void WriteText(const char *data, size_t size) {
+  std::string prefixed;
+  if (!t_linePrefix.empty()) {
+    prefixed.reserve(size + t_linePrefix.size() * 2);
+    for (size_t i = 0; i < size; ++i) {
+      if (t_atLineStart) { prefixed += t_linePrefix; }
+      prefixed += data[i];
+      t_atLineStart = data[i] == '\n';
+    }
+    data = prefixed.data();
+    size = prefixed.size();
+  }
+  if (t_outputBuffer) {
+    AppendOutputBuffer(nullptr, 0, data, size);
+    return;
+  }
+  std::lock_guard<std::mutex> guard(g_stdoutLock);
+  std::fwrite(data, 1, size, stdout);
+}
+
+void FlushPendingText() {
+  if (t_pendingText.size == 0) { return; }
+  const size_t size = t_pendingText.size;
+  t_pendingText.size = 0;
+  EmitTextRecord(t_pendingText.data, size);
+}
+
+// Moves the partial line of the calling thread to saved, an OutputCapture or Worker restores it when it ends.
+void SavePendingText(PendingText *saved) {
+  std::memcpy(saved->data, t_pendingText.data, t_pendingText.size);
+  saved->size = t_pendingText.size;
+  t_pendingText.size = 0;
+}
+
+void RestorePendingText(const PendingText &saved) {
+  std::memcpy(t_pendingText.data, saved.data, saved.size);
+  t_pendingText.size = saved.size;
+}
+
+bool JsonNeedsEscape(char c) { return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20; }
+
+bool CsvNeedsQuotes(const char *data, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    if (data[i] == ',' || data[i] == '"' || data[i] == '\n' || data[i] == '\r') { return true; }
+  }
+  return false;
+}
+} // namespace
+
+std::string CsvField(const char *value) {
+  const size_t length = std::strlen(value);
+  if (!CsvNeedsQuotes(value, length)) { return value; }
+  std::string field = "\"";
+  for (size_t i = 0; i < length; ++i) {
+    field += value[i];
+    if (value[i] == '"') { field += '"'; }
+  }
+  field += '"';
+  return field;
+}
+
+bool ParseOutputFormat(const char *value, OutputFormat *out) {
+  if (!value || !out) { return false; }
+  const std::string lower = ToLowerAscii(value);
+  if (lower == "text") {
+    *out = OutputFormat::Text;
+  } else if (lower == "json") {
+    *out = OutputFormat::Json;
+  } else if (lower == "ndjson") {
+    *out = OutputFormat::Ndjson;
+  } else if (lower == "csv") {
+    *out = OutputFormat::Csv;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void SetOutputFormat(OutputFormat format) { g_outputFormat = format; }
+
+OutputFormat GetOutputFormat() { return g_outputFormat; }
+
+bool StructuredOutput() { return g_outputFormat != OutputFormat::Text; }
+
+int Printf(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  if (!t_outputBuffer && !StructuredOutput() && t_linePrefix.empty()) {
+    const int written = std::vprintf(format, args);
+    va_end(args);
+    return written;
+  }
+
+  char stackBuffer[1024];
+  std::string heapBuffer;
+  const char *text = stackBuffer;
+  va_list sizeArgs;
+  va_copy(sizeArgs, args);
+  const int written = std::vsnprintf(stackBuffer, sizeof(stackBuffer), format, sizeArgs);
+  va_end(sizeArgs);
+  if (written >= static_cast<int>(sizeof(stackBuffer))) {
+    heapBuffer.resize(static_cast<size_t>(written) + 1);
+    std::vsnprintf(&heapBuffer[0], heapBuffer.size(), format, args);
+    text = heapBuffer.data();
+  }
+  va_end(args);
+  if (written <= 0) { return written; }
+
+  if (StructuredOutput()) {
+    EmitText(text, static_cast<size_t>(written));
+  } else {
+    WriteText(text, static_cast<size_t>(written));
+  }
+  return written;
+}
+
+void WriteOutput(const std::string &data) {
+  if (data.empty()) { return; }
+  if (!t_outputBuffer && !StructuredOutput()) {
+    std::fwrite(data.data(), 1, data.size(), stdout);
+    return;
+  }
+  EmitRecord(nullptr, nullptr, 0, data.data(), data.size());
+}
+
+void FinishOutput() {
+  FlushPendingText();
+  std::lock_guard<std::mutex> guard(g_stdoutLock);
+  StdoutFramer().Finish();
+  std::fflush(stdout);
+}
+
+void FinishCapturedOutput(std::string *output) {
+  if (!output || !StructuredOutput()) { return; }
+  std::string document;
+  OutputFramer framer(&document);
+  framer.Write(output->data(), output->size());
+  framer.Finish();
+  output->swap(document);
+}
+
+void SetRecordGpu(NvU32 index) {
+  t_hasRecordGpu = true;
+  t_recordGpu = index;
+}
+
+void ClearRecordGpu() { t_hasRecordGpu = false; }
+
+OutputCapture::OutputCapture(std::string *buffer) : m_previous(t_outputBuffer), m_previousLock(t_outputLock) {
+  SavePendingText(&m_previousPending);
+  t_outputBuffer = buffer;
+  t_outputLock = nullptr;
+}
+
+OutputCapture::~OutputCapture() {
+  FlushPendingText();
+  t_outputBuffer = m_previous;
+  t_outputLock = m_previousLock;
+  RestorePendingText(m_previousPending);
+}
+
+// A share made inside another share's worker keeps that share's lock, the buffer is still written by its threads.
+OutputShare::OutputShare() : m_buffer(t_outputBuffer), m_previousLock(t_outputLock) {
+  m_sharedLock = t_outputLock ? t_outputLock : &m_lock;
+  if (m_buffer) { t_outputLock = m_sharedLock; }
+}
+
+OutputShare::~OutputShare() { t_outputLock = m_previousLock; }
+
+OutputShare::Worker::Worker(OutputShare &share) : m_previous(t_outputBuffer), m_previousLock(t_outputLock) {
+  SavePendingText(&m_previousPending);
+  t_outputBuffer = share.m_buffer;
+  t_outputLock = share.m_buffer ? share.m_sharedLock : nullptr;
+}
+
+OutputShare::Worker::~Worker() {
+  FlushPendingText();
+  t_outputBuffer = m_previous;
+  t_outputLock = m_previousLock;
+  RestorePendingText(m_previousPending);
+}
+
+OutputLinePrefix::OutputLinePrefix(const std::string &prefix) : m_previous(t_linePrefix) {
+  t_linePrefix = prefix;
+  t_atLineStart = true;
+}
+
+OutputLinePrefix::~OutputLinePrefix() { t_linePrefix = m_previous; }
+
+void OutputFramer::Put(const char *data, size_t size) {
+  if (m_buffer) {
+    m_buffer->append(data, size);
+  } else {
+    std::fwrite(data, 1, size, m_file);
+  }
+}
+
+void OutputFramer::Write(const char *data, size_t size) {
+  if (g_outputFormat == OutputFormat::Text || g_outputFormat == OutputFormat::Ndjson) {
+    Put(data, size);
+    return;
+  }
+
+  while (size > 0) {
+    const char *newline = static_cast<const char *>(std::memchr(data, '\n', size));
+    const size_t length = newline ? static_cast<size_t>(newline - data) + 1 : size;
+    if (g_outputFormat == OutputFormat::Json) {
+      Put(m_started ? ",\n" : "[\n", 2);
+      Put(data, newline ? length - 1 : length);
+      m_started = true;
+    } else {
+      PutCsvLine(data, length);
+    }
+    data += length;
+    size -= length;
+  }
+}
+
+// The first header starts the streamed table. A row is streamed while its header matches that one, any other header
+// collects its rows in a held table until Finish().
+void OutputFramer::PutCsvLine(const char *data, size_t size) {
+  if (data[0] != kCsvHeaderMarker) {
+    if (m_table == SIZE_MAX) {
+      Put(data, size);
+    } else {
+      m_tables[m_table].rows.append(data, size);
+    }
+    return;
+  }
+
+  ++data;
+  --size;
+  if (m_headerSize == 0) {
+    m_headerSize = std::min(size, sizeof(m_header));
+    std::memcpy(m_header, data, m_headerSize);
+    Put(data, size);
+  }
+  if (size == m_headerSize && std::memcmp(data, m_header, m_headerSize) == 0) {
+    m_table = SIZE_MAX;
+    return;
+  }
+  for (m_table = 0; m_table < m_tables.size(); ++m_table) {
+    const std::string &header = m_tables[m_table].header;
+    if (header.size() == size && std::memcmp(header.data(), data, size) == 0) { return; }
+  }
+  m_tables.push_back({std::string(data, size), std::string()});
+}
+
+void OutputFramer::Finish() {
+  if (g_outputFormat == OutputFormat::Json) {
+    if (m_started) {
+      Put("\n]\n", 3);
+    } else {
+      Put("[]\n", 3);
+    }
+  }
+  // Held CSV tables follow the streamed one, each after an empty line.
+  for (const CsvTable &table : m_tables) {
+    Put("\n", 1);
+    Put(table.header.data(), table.header.size());
+    Put(table.rows.data(), table.rows.size());
+  }
+  m_tables.clear();
+  m_table = SIZE_MAX;
+  m_started = false;
+  m_headerSize = 0;
+}
+
+RecordWriter::RecordWriter(const char *type, OutputFramer *target) : m_target(target), m_active(StructuredOutput()) {
+  if (!m_active) { return; }
+  if (g_outputFormat == OutputFormat::Csv) {
+    Append(m_header, &m_headerSize, &kCsvHeaderMarker, 1);
+    Append(m_header, &m_headerSize, "type", 4);
+    AppendValue(type, std::strlen(type), true);
+  } else {
+    Append(m_row, &m_rowSize, "{\"type\":", 8);
+    AppendValue(type, std::strlen(type), true);
+  }
+  if (t_hasRecordGpu && !target) { Field("gpu", t_recordGpu); }
+  m_fields = 0;
+}
+
+void RecordWriter::Append(char *buffer, size_t *size, const char *data, size_t length) {
+  if (m_overflow || *size + length > kMaxRecordSize - kRecordReserve) {
+    m_overflow = true;
+    return;
+  }
+  std::memcpy(buffer + *size, data, length);
+  *size += length;
+}
+
+void RecordWriter::AppendValue(const char *data, size_t length, bool quoted) {
+  if (g_outputFormat == OutputFormat::Csv) {
+    if (m_rowSize > 0) { Append(m_row, &m_rowSize, ",", 1); }
+    if (!quoted || !CsvNeedsQuotes(data, length)) {
+      Append(m_row, &m_rowSize, data, length);
+      return;
+    }
+    Append(m_row, &m_rowSize, "\"", 1);
+    for (size_t i = 0; i < length; ++i) {
+      Append(m_row, &m_rowSize, &data[i], 1);
+      if (data[i] == '"') { Append(m_row, &m_rowSize, "\"", 1); }
+    }
+    Append(m_row, &m_rowSize, "\"", 1);
+    return;
+  }
+
+  if (!quoted) {
+    Append(m_row, &m_rowSize, data, length);
+    return;
+  }
+  Append(m_row, &m_rowSize, "\"", 1);
+  size_t start = 0;
+  for (size_t i = 0; i < length; ++i) {
+    if (!JsonNeedsEscape(data[i])) { continue; }
+    Append(m_row, &m_rowSize, data + start, i - start);
+    char escape[8];
+    if (data[i] == '"' || data[i] == '\\') {
+      escape[0] = '\\';
+      escape[1] = data[i];
+      Append(m_row, &m_rowSize, escape, 2);
+    } else {
+      std::snprintf(escape, sizeof(escape), "\\u%04X", static_cast<unsigned char>(data[i]));
+      Append(m_row, &m_rowSize, escape, 6);
+    }
+    start = i + 1;
+  }
+  Append(m_row, &m_rowSize, data + start, length - start);
+  Append(m_row, &m_rowSize, "\"", 1);
+}
+
+void RecordWriter::BeginField(const char *key) {
+  m_rowMark = m_rowSize;
+  m_headerMark = m_headerSize;
+  const size_t length = std::strlen(key);
+  if (g_outputFormat == OutputFormat::Csv) {
+    Append(m_header, &m_headerSize, ",", 1);
+    Append(m_header, &m_headerSize, key, length);
+  } else {
+    Append(m_row, &m_rowSize, ",\"", 2);
+    Append(m_row, &m_rowSize, key, length);
+    Append(m_row, &m_rowSize, "\":", 2);
+  }
+}
+
+// A field that does not fit is dropped as a whole and the record is flagged instead of being cut mid-value.
+void RecordWriter::EndField() {
+  if (!m_overflow) {
+    ++m_fields;
+    return;
+  }
+  m_overflow = false;
+  m_rowSize = m_rowMark;
+  m_headerSize = m_headerMark;
+  m_truncated = true;
+}
+
+RecordWriter &RecordWriter::Field(const char *key, const char *value) {
+  if (!m_active) { return *this; }
+  if (!value) { return Null(key); }
+  BeginField(key);
+  AppendValue(value, std::strlen(value), true);
+  EndField();
+  return *this;
+}
+
+RecordWriter &RecordWriter::Field(const char *key, NvU32 value) { return Field(key, static_cast<NvU64>(value)); }
+
+RecordWriter &RecordWriter::Field(const char *key, NvS32 value) { return Field(key, static_cast<NvS64>(value)); }
+
+RecordWriter &RecordWriter::Field(const char *key, NvU64 value) {
+  if (!m_active) { return *this; }
+  char text[32];
+  const int length = std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(value));
+  BeginField(key);
+  AppendValue(text, static_cast<size_t>(length), false);
+  EndField();
+  return *this;
+}
+
+RecordWriter &RecordWriter::Field(const char *key, NvS64 value) {
+  if (!m_active) { return *this; }
+  char text[32];
+  const int length = std::snprintf(text, sizeof(text), "%lld", static_cast<long long>(value));
+  BeginField(key);
+  AppendValue(text, static_cast<size_t>(length), false);
+  EndField();
+  return *this;
+}
+
+RecordWriter &RecordWriter::Field(const char *key, double value) {
+  if (!m_active) { return *this; }
+  if (!std::isfinite(value)) { return Null(key); }
+  char text[64];
+  const int length = std::snprintf(text, sizeof(text), "%.3f", value);
+  BeginField(key);
+  AppendValue(text, static_cast<size_t>(length), false);
+  EndField();
+  return *this;
+}
+
+RecordWriter &RecordWriter::Field(const char *key, bool value) {
+  if (!m_active) { return *this; }
+  BeginField(key);
+  AppendValue(value ? "true" : "false", value ? 4 : 5, false);
+  EndField();
+  return *this;
+}
+
+RecordWriter &RecordWriter::Hex(const char *key, NvU64 value, int digits) {
+  if (!m_active) { return *this; }
+  char text[32];
+  const int length = std::snprintf(text, sizeof(text), "0x%0*llX", digits, static_cast<unsigned long long>(value));
+  BeginField(key);
+  AppendValue(text, static_cast<size_t>(length), true);
+  EndField();
+  return *this;
+}
+
+RecordWriter &RecordWriter::Null(const char *key) {
+  if (!m_active) { return *this; }
+  BeginField(key);
+  if (g_outputFormat == OutputFormat::Csv) {
+    AppendValue("", 0, false);
+  } else {
+    AppendValue("null", 4, false);
+  }
+  EndField();
+  return *this;
+}
+
+void RecordWriter::End() {
+  if (!m_active) { return; }
+  m_active = false;
+  if (m_fields == 0 && !m_truncated) { return; }
+
+  // The reserve kept by Append always leaves room for the closing bytes below.
+  if (g_outputFormat == OutputFormat::Csv) {
+    if (m_truncated) {
+      std::memcpy(m_header + m_headerSize, ",truncated", 10);
+      m_headerSize += 10;
+      std::memcpy(m_row + m_rowSize, ",true", 5);
+      m_rowSize += 5;
+    }
+    m_header[m_headerSize++] = '\n';
+    m_row[m_rowSize++] = '\n';
+    EmitRecord(m_target, m_header, m_headerSize, m_row, m_rowSize);
+    return;
+  }
+
+  if (m_truncated) {
+    std::memcpy(m_row + m_rowSize, ",\"truncated\":true", 17);
+    m_rowSize += 17;
+  }
+  m_row[m_rowSize++] = '}';
+  m_row[m_rowSize++] = '\n';
+  EmitRecord(m_target, nullptr, 0, m_row, m_rowSize);
+}
+} // namespace nvcli
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/commands.h"
+#include "cli/topology.h"
+
+#include <chrono>
+
+namespace nvcli {
+namespace {
+constexpr DWORD kPipeBufferSize = 64 * 1024;
+constexpr const char *kDefaultPipeName = "nvapi-cli";
+
+bool ReadRequest(HANDLE pipe, std::string &pending, std::string *line) {
+  size_t newline = pending.find('\n');
+  while (newline == std::string::npos) {
+    char buffer[4096];
+    DWORD read = 0;
+    if (!ReadFile(pipe, buffer, sizeof(buffer), &read, NULL) && GetLastError() != ERROR_MORE_DATA) { return false; }
+    if (read == 0) { return false; }
+    pending.append(buffer, read);
+    newline = pending.find('\n');
+  }
+  line->assign(pending, 0, newline);
+  pending.erase(0, newline + 1);
+  if (!line->empty() && line->back() == '\r') { line->pop_back(); }
+  return true;
+}
+
+bool WritePipe(HANDLE pipe, const char *data, size_t size) {
+  while (size > 0) {
+    DWORD written = 0;
+    const DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, kPipeBufferSize));
+    if (!WriteFile(pipe, data, chunk, &written, NULL) || written == 0) { return false; }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+bool WriteResponse(HANDLE pipe, int result, const std::string &output) {
+  char header[64];
+  const int length =
+      std::snprintf(header, sizeof(header), "%d %llu\n", result, static_cast<unsigned long long>(output.size()));
+  return WritePipe(pipe, header, static_cast<size_t>(length)) && WritePipe(pipe, output.data(), output.size());
+}
+
+bool ReloadResidentDrs() {
+  NvDRSSessionHandle session = ResidentDrsSession();
+  if (!session) {
+    Printf("No resident DRS session.\n");
+    return false;
+  }
+  NvAPI_Status status = NvApi().NvAPI_DRS_LoadSettings(session);
+  if (status != NVAPI_OK) {
+    PrintNvapiError("NvAPI_DRS_LoadSettings failed", status);
+    return false;
+  }
+  return true;
+}
+
+int HandleRequest(const std::string &line, std::string *output, bool *shutdown) {
+  output->clear();
+  OutputCapture capture(output);
+  std::vector<std::string> args;
+  if (!SplitCommandLine(line, args)) {
+    Printf("Unterminated quote.\n");
+    return 1;
+  }
+  if (args.empty()) { return 0; }
+
+  if (args.size() == 1 && args[0] == "ping") {
+    Printf("pong\n");
+    return 0;
+  }
+  if (args.size() == 1 && args[0] == "reload") { return ReloadResidentDrs() ? 0 : 1; }
+  if (args.size() == 1 && args[0] == "refresh") {
+    Topology().Invalidate();
+    return 0;
+  }
+  if (args.size() == 1 && args[0] == "shutdown") {
+    *shutdown = true;
+    return 0;
+  }
+
+  std::vector<char *> argvLine;
+  for (auto &arg : args) { argvLine.push_back(&arg[0]); }
+  argvLine.push_back(nullptr);
+  const int result = RunCommand(static_cast<int>(args.size()), argvLine.data());
+
+  // A failed DRS command may leave unsaved edits in the shared session, drop them so the next request starts clean.
+  if (result != 0 && args[0] == "drs") { ReloadResidentDrs(); }
+  return result;
+}
+} // namespace
+
+int CmdServe(int argc, char **argv) {
+  const char *pipeName = kDefaultPipeName;
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--pipe") == 0) {
+      if (i + 1 >= argc) {
+        Printf("Missing value for --pipe\n");
+        return 1;
+      }
+      pipeName = argv[i + 1];
+      ++i;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[i]);
+    return 1;
+  }
+
+  DrsSession drs;
+  if (drs.ok()) {
+    SetResidentDrsSession(drs.handle());
+  } else {
+    PrintNvapiError("NvAPI_DRS_CreateSession/LoadSettings failed, drs requests open their own session", drs.status());
+  }
+
+  // Cached GPU and display handles are dropped when Windows reports a display change.
+  TopologyWatcher watcher;
+  if (!watcher.Start()) { Printf("Display change watcher unavailable, use refresh after topology changes.\n"); }
+
+  const std::string pipePath = std::string("\\\\.\\pipe\\") + pipeName;
+  HANDLE pipe = CreateNamedPipeA(pipePath.c_str(), PIPE_ACCESS_DUPLEX,
+                                 PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS, 1,
+                                 kPipeBufferSize, kPipeBufferSize, 0, NULL);
+  if (pipe == INVALID_HANDLE_VALUE) {
+    Printf("CreateNamedPipe failed for %s: %lu\n", pipePath.c_str(), GetLastError());
+    SetResidentDrsSession(NULL);
+    return 1;
+  }
+
+  Printf("Serving on %s\n", pipePath.c_str());
+  std::fflush(stdout);
+
+  using Clock = std::chrono::steady_clock;
+  int exitCode = 0;
+  bool shutdown = false;
+  std::string pending;
+  std::string line;
+  std::string output;
+  while (!shutdown) {
+    if (!ConnectNamedPipe(pipe, NULL) && GetLastError() != ERROR_PIPE_CONNECTED) {
+      Printf("ConnectNamedPipe failed: %lu\n", GetLastError());
+      exitCode = 1;
+      break;
+    }
+
+    pending.clear();
+    while (!shutdown && ReadRequest(pipe, pending, &line)) {
+      const auto start = Clock::now();
+      const int result = HandleRequest(line, &output, &shutdown);
+      FinishCapturedOutput(&output);
+      const double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+      Printf("%s exit=%d %.3f ms\n", line.c_str(), result, elapsedMs);
+      std::fflush(stdout);
+      if (!WriteResponse(pipe, result, output)) { break; }
+    }
+
+    FlushFileBuffers(pipe);
+    DisconnectNamedPipe(pipe);
+  }
+
+  CloseHandle(pipe);
+  SetResidentDrsSession(NULL);
+  return exitCode;
+}
+} // namespace nvcli
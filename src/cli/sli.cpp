@@ -4,6 +4,7 @@
  */
 
 #include "cli/commands.h"
+#include "cli/topology.h"
 
 namespace nvcli {
 namespace {
@@ -19,83 +20,74 @@ void PrintSliUsage() { PrintUsageGroup("sli"); }
 int CmdSliStatus() {
   NV_CHIPSET_SLI_BOND_INFO bondInfo = {};
   bondInfo.version = NV_CHIPSET_SLI_BOND_INFO_VER;
-  NvAPI_Status status = NvAPI_SYS_GetChipSetSliBondInfo(&bondInfo);
+  NvAPI_Status status = NvApi().NvAPI_SYS_GetChipSetSliBondInfo(&bondInfo);
   if (status == NVAPI_OK) {
-    std::printf("Chipset SLI bond: id=0x%08X name=%s\n", bondInfo.sliBondId, bondInfo.szSliBondName);
+    Printf("Chipset SLI bond: id=0x%08X name=%s\n", bondInfo.sliBondId, bondInfo.szSliBondName);
   } else {
     PrintNvapiError("NvAPI_SYS_GetChipSetSliBondInfo failed", status);
   }
 
-  NvPhysicalGpuHandle physical[NVAPI_MAX_PHYSICAL_GPUS] = {};
-  NvU32 physicalCount = 0;
-  status = NvAPI_EnumPhysicalGPUs(physical, &physicalCount);
+  std::vector<NvPhysicalGpuHandle> physical;
+  status = Topology().PhysicalGpus(&physical);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_EnumPhysicalGPUs failed", status);
     return 1;
   }
+  const NvU32 physicalCount = static_cast<NvU32>(physical.size());
 
-  NvLogicalGpuHandle logical[NVAPI_MAX_LOGICAL_GPUS] = {};
-  NvU32 logicalCount = 0;
-  status = NvAPI_EnumLogicalGPUs(logical, &logicalCount);
+  std::vector<TopologyLogicalGpu> logical;
+  status = Topology().LogicalGpus(&logical);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_EnumLogicalGPUs failed", status);
     return 1;
   }
 
-  std::printf("Logical GPUs: %u\n", logicalCount);
-  for (NvU32 i = 0; i < logicalCount; ++i) {
-    NvPhysicalGpuHandle group[NVAPI_MAX_PHYSICAL_GPUS] = {};
-    NvU32 groupCount = 0;
-    status = NvAPI_GetPhysicalGPUsFromLogicalGPU(logical[i], group, &groupCount);
-    if (status != NVAPI_OK) {
-      PrintNvapiError("  NvAPI_GetPhysicalGPUsFromLogicalGPU failed", status);
+  Printf("Logical GPUs: %zu\n", logical.size());
+  for (size_t i = 0; i < logical.size(); ++i) {
+    if (logical[i].status != NVAPI_OK) {
+      PrintNvapiError("  NvAPI_GetPhysicalGPUsFromLogicalGPU failed", logical[i].status);
       continue;
     }
 
-    std::printf("  Logical[%u] physicalCount=%u\n", i, groupCount);
-    for (NvU32 j = 0; j < groupCount; ++j) {
-      NvU32 physIndex = NVAPI_MAX_PHYSICAL_GPUS;
-      for (NvU32 k = 0; k < physicalCount; ++k) {
-        if (physical[k] == group[j]) {
-          physIndex = k;
-          break;
-        }
-      }
+    const std::vector<NvPhysicalGpuHandle> &group = logical[i].physical;
+    Printf("  Logical[%zu] physicalCount=%zu\n", i, group.size());
+    for (NvPhysicalGpuHandle member : group) {
+      NvU32 physIndex = 0;
       NvAPI_ShortString name = {0};
-      NvAPI_GPU_GetFullName(group[j], name);
-      if (physIndex < physicalCount) {
-        std::printf("    GPU[%u] %s\n", physIndex, name);
+      NvApi().NvAPI_GPU_GetFullName(member, name);
+      if (Topology().PhysicalGpuIndex(member, &physIndex)) {
+        Printf("    GPU[%u] %s\n", physIndex, name);
       } else {
-        std::printf("    GPU[?] %s\n", name);
+        Printf("    GPU[?] %s\n", name);
       }
     }
   }
 
   for (NvU32 i = 0; i < physicalCount; ++i) {
     NvAPI_ShortString name = {0};
-    NvAPI_GPU_GetFullName(physical[i], name);
+    NvApi().NvAPI_GPU_GetFullName(physical[i], name);
     NvU32 displayIdCount = 0;
-    // Deprecated in release 290: status = NvAPI_GPU_GetConnectedSLIOutputs(physical[i], &mask);
-    status = NvAPI_GPU_GetConnectedDisplayIds(physical[i], NULL, &displayIdCount, 0);
+    // Deprecated in release 290: status = NvApi().NvAPI_GPU_GetConnectedSLIOutputs(physical[i], &mask);
+    status = NvApi().NvAPI_GPU_GetConnectedDisplayIds(physical[i], NULL, &displayIdCount, 0);
     if (status != NVAPI_OK) {
-      std::printf("GPU[%u] %s\n", i, name);
+      Printf("GPU[%u] %s\n", i, name);
       PrintNvapiError("  NvAPI_GPU_GetConnectedDisplayIds failed", status);
       continue;
     }
     if (displayIdCount == 0) {
-      std::printf("GPU[%u] %s connected display IDs: 0\n", i, name);
+      Printf("GPU[%u] %s connected display IDs: 0\n", i, name);
       continue;
     }
     std::vector<NV_GPU_DISPLAYIDS> displayIds(displayIdCount);
     for (NvU32 j = 0; j < displayIdCount; ++j) { displayIds[j].version = NV_GPU_DISPLAYIDS_VER; }
-    status = NvAPI_GPU_GetConnectedDisplayIds(physical[i], displayIds.data(), &displayIdCount, 0);
+    status = NvApi().NvAPI_GPU_GetConnectedDisplayIds(physical[i], displayIds.data(), &displayIdCount, 0);
     if (status != NVAPI_OK) {
-      std::printf("GPU[%u] %s\n", i, name);
+      Printf("GPU[%u] %s\n", i, name);
       PrintNvapiError("  NvAPI_GPU_GetConnectedDisplayIds failed", status);
       continue;
     }
-    std::printf("GPU[%u] %s connected display IDs: %u\n", i, name, displayIdCount);
-    for (NvU32 j = 0; j < displayIdCount; ++j) { std::printf("  displayId=0x%08X\n", displayIds[j].displayId); }
+    Printf("GPU[%u] %s connected display IDs: %u\n", i, name, displayIdCount);
+    for (NvU32 j = 0; j < displayIdCount; ++j) { Printf("  displayId=0x%08X\n", displayIds[j].displayId); }
   }
 
   return 0;
@@ -110,21 +102,20 @@ int CmdSliViews(int argc, char **argv) {
   std::vector<NvU32> indices;
   if (!CollectGpus(hasIndex, index, handles, indices)) { return 1; }
 
-  for (size_t i = 0; i < handles.size(); ++i) {
+  return ForEachGpu(handles.size(), [&](size_t i) {
     PrintGpuHeader(indices[i], handles[i]);
     NV_TARGET_VIEW_MODE views[NVAPI_MAX_VIEW_MODES] = {};
     NvU32 viewCount = NVAPI_MAX_VIEW_MODES;
-    NvAPI_Status status = NvAPI_GPU_GetSupportedSLIViews(handles[i], views, &viewCount);
+    NvAPI_Status status = NvApi().NvAPI_GPU_GetSupportedSLIViews(handles[i], views, &viewCount);
     if (status != NVAPI_OK) {
       PrintNvapiError("  NvAPI_GPU_GetSupportedSLIViews failed", status);
-      continue;
+      return 0;
     }
 
-    std::printf("  Supported SLI views: %u\n", viewCount);
-    for (NvU32 v = 0; v < viewCount; ++v) { std::printf("    %u (%s)\n", views[v], TargetViewModeName(views[v])); }
-  }
-
-  return 0;
+    Printf("  Supported SLI views: %u\n", viewCount);
+    for (NvU32 v = 0; v < viewCount; ++v) { Printf("    %u (%s)\n", views[v], TargetViewModeName(views[v])); }
+    return 0;
+  });
 }
 
 int CmdSli(int argc, char **argv) {
@@ -156,13 +147,13 @@ bool GetGsyncHandleByIndex(NvU32 index, NvGSyncDeviceHandle *outHandle) {
   if (!outHandle) { return false; }
   NvGSyncDeviceHandle handles[NVAPI_MAX_GSYNC_DEVICES] = {};
   NvU32 count = 0;
-  NvAPI_Status status = NvAPI_GSync_EnumSyncDevices(handles, &count);
+  NvAPI_Status status = NvApi().NvAPI_GSync_EnumSyncDevices(handles, &count);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GSync_EnumSyncDevices failed", status);
     return false;
   }
   if (index >= count) {
-    std::printf("G-Sync device index %u out of range (0-%u)\n", index, count ? count - 1 : 0);
+    Printf("G-Sync device index %u out of range (0-%u)\n", index, count ? count - 1 : 0);
     return false;
   }
   *outHandle = handles[index];
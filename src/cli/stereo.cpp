@@ -8,6 +8,7 @@
 #include <windows.h>
 
 #include "cli/commands.h"
+#include "cli/topology.h"
 
 #include <vector>
 #include <string>
@@ -50,7 +51,7 @@ struct StereoContext {
 
   void Cleanup() {
     if (handle) {
-      NvAPI_Stereo_DestroyHandle(handle);
+      NvApi().NvAPI_Stereo_DestroyHandle(handle);
       handle = nullptr;
     }
     d3d.Cleanup();
@@ -58,7 +59,7 @@ struct StereoContext {
 };
 
 void PrintHresult(const char *prefix, HRESULT hr) {
-  std::printf("%s: 0x%08X\n", prefix, static_cast<unsigned int>(hr));
+  Printf("%s: 0x%08X\n", prefix, static_cast<unsigned int>(hr));
 }
 
 bool CreateD3D11Device(D3DContext &ctx) {
@@ -90,7 +91,7 @@ bool CreateD3D11Device(D3DContext &ctx) {
   factory->Release();
 
   if (!adapter) {
-    std::printf("No NVIDIA adapter found for D3D device creation.\n");
+    Printf("No NVIDIA adapter found for D3D device creation.\n");
     return false;
   }
 
@@ -126,22 +127,22 @@ bool ReadBinaryFile(const char *path, void *data, size_t size) {
   if (!path || !data || size == 0) { return false; }
   FILE *file = nullptr;
   if (fopen_s(&file, path, "rb") != 0 || !file) {
-    std::printf("Failed to open input file: %s\n", path);
+    Printf("Failed to open input file: %s\n", path);
     return false;
   }
   if (fseek(file, 0, SEEK_END) != 0) {
-    std::printf("Failed to seek input file: %s\n", path);
+    Printf("Failed to seek input file: %s\n", path);
     std::fclose(file);
     return false;
   }
   long length = ftell(file);
   if (length < 0) {
-    std::printf("Failed to read input file size: %s\n", path);
+    Printf("Failed to read input file size: %s\n", path);
     std::fclose(file);
     return false;
   }
   if (static_cast<size_t>(length) != size) {
-    std::printf("Input file size mismatch: %s (expected %zu bytes, got %ld)\n", path, size, length);
+    Printf("Input file size mismatch: %s (expected %zu bytes, got %ld)\n", path, size, length);
     std::fclose(file);
     return false;
   }
@@ -149,7 +150,7 @@ bool ReadBinaryFile(const char *path, void *data, size_t size) {
   size_t read = std::fread(data, 1, size, file);
   std::fclose(file);
   if (read != size) {
-    std::printf("Failed to read input file: %s\n", path);
+    Printf("Failed to read input file: %s\n", path);
     return false;
   }
   return true;
@@ -159,13 +160,13 @@ bool WriteBinaryFile(const char *path, const void *data, size_t size) {
   if (!path || !data || size == 0) { return false; }
   FILE *file = nullptr;
   if (fopen_s(&file, path, "wb") != 0 || !file) {
-    std::printf("Failed to open output file: %s\n", path);
+    Printf("Failed to open output file: %s\n", path);
     return false;
   }
   size_t written = std::fwrite(data, 1, size, file);
   std::fclose(file);
   if (written != size) {
-    std::printf("Failed to write output file: %s\n", path);
+    Printf("Failed to write output file: %s\n", path);
     return false;
   }
   return true;
@@ -259,13 +260,19 @@ bool GetMonitorHandleByIndex(NvU32 index, NvMonitorHandle *out) {
 bool GetMonitorHandleByDisplayId(NvU32 displayId, NvMonitorHandle *out) {
   if (!out) { return false; }
   NvDisplayHandle displayHandle = nullptr;
-  NvAPI_Status status = NvAPI_DISP_GetDisplayHandleFromDisplayId(displayId, &displayHandle);
-  if (status != NVAPI_OK) {
-    PrintNvapiError("NvAPI_DISP_GetDisplayHandleFromDisplayId failed", status);
-    return false;
+  TopologyDisplay display = {};
+  NvAPI_Status status = NVAPI_OK;
+  if (Topology().DisplayById(displayId, &display)) {
+    displayHandle = display.handle;
+  } else {
+    status = NvApi().NvAPI_DISP_GetDisplayHandleFromDisplayId(displayId, &displayHandle);
+    if (status != NVAPI_OK) {
+      PrintNvapiError("NvAPI_DISP_GetDisplayHandleFromDisplayId failed", status);
+      return false;
+    }
   }
   NvAPI_ShortString displayName = {0};
-  status = NvAPI_GetAssociatedNvidiaDisplayName(displayHandle, displayName);
+  status = NvApi().NvAPI_GetAssociatedNvidiaDisplayName(displayHandle, displayName);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_GetAssociatedNvidiaDisplayName failed", status);
     return false;
@@ -603,116 +610,114 @@ bool ParseHandshakeCommand(const char *text, NVAPI_STEREO_HANDSHAKE_COMMANDS *ou
 void DumpHex(const void *data, size_t size) {
   const unsigned char *bytes = static_cast<const unsigned char *>(data);
   for (size_t i = 0; i < size; ++i) {
-    if (i % 16 == 0) { std::printf("    "); }
-    std::printf("%02X ", bytes[i]);
-    if (i % 16 == 15 || i + 1 == size) { std::printf("\n"); }
+    if (i % 16 == 0) { Printf("    "); }
+    Printf("%02X ", bytes[i]);
+    if (i % 16 == 15 || i + 1 == size) { Printf("\n"); }
   }
 }
 
 void PrintStereoCaps(const NVAPI_STEREO_CAPS &caps) {
-  std::printf("  windowedOff=%u windowedAuto=%u windowedPersistent=%u\n", caps.supportsWindowedModeOff,
-              caps.supportsWindowedModeAutomatic, caps.supportsWindowedModePersistent);
+  Printf("  windowedOff=%u windowedAuto=%u windowedPersistent=%u\n", caps.supportsWindowedModeOff,
+         caps.supportsWindowedModeAutomatic, caps.supportsWindowedModePersistent);
 }
 void PrintStereoUsage() {
-  std::printf("Stereo commands:\n");
-  std::printf("  %s stereo enable\n", kToolName);
-  std::printf("  %s stereo disable\n", kToolName);
-  std::printf("  %s stereo is-enabled\n", kToolName);
-  std::printf("  %s stereo windowed get\n", kToolName);
-  std::printf("  %s stereo windowed set --mode off|auto|persistent [--flags N]\n", kToolName);
-  std::printf("  %s stereo windowed supported\n", kToolName);
-  std::printf("  %s stereo caps get|internal\n", kToolName);
-  std::printf("  %s stereo caps monitor --monitor-index N | --id HEX\n", kToolName);
-  std::printf("  %s stereo info [--handle-index N]\n", kToolName);
-  std::printf("  %s stereo app-info [--handle-index N]\n", kToolName);
-  std::printf("  %s stereo mode-enum get\n", kToolName);
-  std::printf("  %s stereo mode-enum set --command enable|disable [--data N]\n", kToolName);
-  std::printf("  %s stereo accessory\n", kToolName);
-  std::printf("  %s stereo dongle control --command NAME [--data N] [--handle-index N]\n", kToolName);
-  std::printf("  %s stereo dongle status --id HEX --param N\n", kToolName);
-  std::printf("  %s stereo aegis --panel-id N\n", kToolName);
-  std::printf("  %s stereo default-profile get\n", kToolName);
-  std::printf("  %s stereo default-profile set --name NAME\n", kToolName);
-  std::printf("  %s stereo profile create|delete --type default|dx9|dx10\n", kToolName);
-  std::printf("  %s stereo profile set --type TYPE --id convergence|frustum (--dword N|--float F)\n", kToolName);
-  std::printf("  %s stereo profile delete-value --type TYPE --id convergence|frustum\n", kToolName);
-  std::printf("  %s stereo driver-mode set --mode automatic|direct\n", kToolName);
-  std::printf("  %s stereo activate|deactivate|is-activated\n", kToolName);
-  std::printf("  %s stereo separation get|set|inc|dec [--value PCT]\n", kToolName);
-  std::printf("  %s stereo convergence get|set|inc|dec [--value F]\n", kToolName);
-  std::printf("  %s stereo frustum get|set --mode none|stretch|clear-edges\n", kToolName);
-  std::printf("  %s stereo capture jpeg --quality 0-100\n", kToolName);
-  std::printf("  %s stereo capture png\n", kToolName);
-  std::printf("  %s stereo init-activation --flag immediate|delayed\n", kToolName);
-  std::printf("  %s stereo trigger-activation\n", kToolName);
-  std::printf("  %s stereo reverse-blit --enable 0|1\n", kToolName);
-  std::printf("  %s stereo notify --hwnd HEX --message-id N\n", kToolName);
-  std::printf("  %s stereo active-eye set --eye left|right|mono\n", kToolName);
-  std::printf("  %s stereo eye-separation get\n", kToolName);
-  std::printf("  %s stereo cursor supported|get|set [--value PCT]\n", kToolName);
-  std::printf("  %s stereo surface get|set --mode auto|force-stereo|force-mono\n", kToolName);
-  std::printf("  %s stereo debug last-draw\n", kToolName);
-  std::printf("  %s stereo force-to-screen --enable 0|1\n", kToolName);
-  std::printf("  %s stereo video-control --layout NAME --client-id N --enable 0|1\n", kToolName);
-  std::printf("  %s stereo video-metadata --width W --height H --src HEX --dst HEX\n", kToolName);
-  std::printf("  %s stereo handshake challenge\n", kToolName);
-  std::printf("  %s stereo handshake response --guid GUID --response-hex HEX\n", kToolName);
-  std::printf("  %s stereo handshake-trigger\n", kToolName);
-  std::printf("  %s stereo handshake-message --enable 0|1\n", kToolName);
-  std::printf("  %s stereo profile-name set --name NAME [--flags N]\n", kToolName);
-  std::printf("  %s stereo diag\n", kToolName);
-  std::printf(
-      "  %s stereo shader set --stage vs|ps --type f|i|b --start N --count N --mono PATH --left PATH --right PATH\n",
-      kToolName);
-  std::printf(
-      "  %s stereo shader get --stage vs|ps --type f|i|b --start N --count N --mono PATH --left PATH --right PATH\n",
-      kToolName);
+  Printf("Stereo commands:\n");
+  Printf("  %s stereo enable\n", kToolName);
+  Printf("  %s stereo disable\n", kToolName);
+  Printf("  %s stereo is-enabled\n", kToolName);
+  Printf("  %s stereo windowed get\n", kToolName);
+  Printf("  %s stereo windowed set --mode off|auto|persistent [--flags N]\n", kToolName);
+  Printf("  %s stereo windowed supported\n", kToolName);
+  Printf("  %s stereo caps get|internal\n", kToolName);
+  Printf("  %s stereo caps monitor --monitor-index N | --id HEX\n", kToolName);
+  Printf("  %s stereo info [--handle-index N]\n", kToolName);
+  Printf("  %s stereo app-info [--handle-index N]\n", kToolName);
+  Printf("  %s stereo mode-enum get\n", kToolName);
+  Printf("  %s stereo mode-enum set --command enable|disable [--data N]\n", kToolName);
+  Printf("  %s stereo accessory\n", kToolName);
+  Printf("  %s stereo dongle control --command NAME [--data N] [--handle-index N]\n", kToolName);
+  Printf("  %s stereo dongle status --id HEX --param N\n", kToolName);
+  Printf("  %s stereo aegis --panel-id N\n", kToolName);
+  Printf("  %s stereo default-profile get\n", kToolName);
+  Printf("  %s stereo default-profile set --name NAME\n", kToolName);
+  Printf("  %s stereo profile create|delete --type default|dx9|dx10\n", kToolName);
+  Printf("  %s stereo profile set --type TYPE --id convergence|frustum (--dword N|--float F)\n", kToolName);
+  Printf("  %s stereo profile delete-value --type TYPE --id convergence|frustum\n", kToolName);
+  Printf("  %s stereo driver-mode set --mode automatic|direct\n", kToolName);
+  Printf("  %s stereo activate|deactivate|is-activated\n", kToolName);
+  Printf("  %s stereo separation get|set|inc|dec [--value PCT]\n", kToolName);
+  Printf("  %s stereo convergence get|set|inc|dec [--value F]\n", kToolName);
+  Printf("  %s stereo frustum get|set --mode none|stretch|clear-edges\n", kToolName);
+  Printf("  %s stereo capture jpeg --quality 0-100\n", kToolName);
+  Printf("  %s stereo capture png\n", kToolName);
+  Printf("  %s stereo init-activation --flag immediate|delayed\n", kToolName);
+  Printf("  %s stereo trigger-activation\n", kToolName);
+  Printf("  %s stereo reverse-blit --enable 0|1\n", kToolName);
+  Printf("  %s stereo notify --hwnd HEX --message-id N\n", kToolName);
+  Printf("  %s stereo active-eye set --eye left|right|mono\n", kToolName);
+  Printf("  %s stereo eye-separation get\n", kToolName);
+  Printf("  %s stereo cursor supported|get|set [--value PCT]\n", kToolName);
+  Printf("  %s stereo surface get|set --mode auto|force-stereo|force-mono\n", kToolName);
+  Printf("  %s stereo debug last-draw\n", kToolName);
+  Printf("  %s stereo force-to-screen --enable 0|1\n", kToolName);
+  Printf("  %s stereo video-control --layout NAME --client-id N --enable 0|1\n", kToolName);
+  Printf("  %s stereo video-metadata --width W --height H --src HEX --dst HEX\n", kToolName);
+  Printf("  %s stereo handshake challenge\n", kToolName);
+  Printf("  %s stereo handshake response --guid GUID --response-hex HEX\n", kToolName);
+  Printf("  %s stereo handshake-trigger\n", kToolName);
+  Printf("  %s stereo handshake-message --enable 0|1\n", kToolName);
+  Printf("  %s stereo profile-name set --name NAME [--flags N]\n", kToolName);
+  Printf("  %s stereo diag\n", kToolName);
+  Printf("  %s stereo shader set --stage vs|ps --type f|i|b --start N --count N --mono PATH --left PATH --right PATH\n",
+         kToolName);
+  Printf("  %s stereo shader get --stage vs|ps --type f|i|b --start N --count N --mono PATH --left PATH --right PATH\n",
+         kToolName);
 }
 
 int CmdStereoEnable(bool enable) {
-  NvAPI_Status status = enable ? NvAPI_Stereo_Enable() : NvAPI_Stereo_Disable();
+  NvAPI_Status status = enable ? NvApi().NvAPI_Stereo_Enable() : NvApi().NvAPI_Stereo_Disable();
   if (status != NVAPI_OK) {
     PrintNvapiError(enable ? "NvAPI_Stereo_Enable failed" : "NvAPI_Stereo_Disable failed", status);
     return 1;
   }
-  std::printf("Stereo %s.\n", enable ? "enabled" : "disabled");
+  Printf("Stereo %s.\n", enable ? "enabled" : "disabled");
   return 0;
 }
 
 int CmdStereoIsEnabled() {
   NvU8 enabled = 0;
-  NvAPI_Status status = NvAPI_Stereo_IsEnabled(&enabled);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_IsEnabled(&enabled);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Stereo_IsEnabled failed", status);
     return 1;
   }
-  std::printf("Stereo enabled: %s\n", enabled ? "yes" : "no");
+  Printf("Stereo enabled: %s\n", enabled ? "yes" : "no");
   return 0;
 }
 
 int CmdStereoWindowed(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing windowed command.\n");
+    Printf("Missing windowed command.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "get") == 0) {
     NVAPI_STEREO_WINDOWED_MODE mode = WINDOWED_MODE_STEREO_OFF;
-    NvAPI_Status status = NvAPI_Stereo_GetWindowedMode(&mode);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_GetWindowedMode(&mode);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_GetWindowedMode failed", status);
       return 1;
     }
-    std::printf("Windowed mode: %s\n", WindowedModeName(mode));
+    Printf("Windowed mode: %s\n", WindowedModeName(mode));
     return 0;
   }
   if (std::strcmp(argv[0], "supported") == 0) {
     NvU8 supported = 0;
-    NvAPI_Status status = NvAPI_Stereo_IsWindowedModeSupported(&supported);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_IsWindowedModeSupported(&supported);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_IsWindowedModeSupported failed", status);
       return 1;
     }
-    std::printf("Windowed mode supported: %s\n", supported ? "yes" : "no");
+    Printf("Windowed mode supported: %s\n", supported ? "yes" : "no");
     return 0;
   }
   if (std::strcmp(argv[0], "set") == 0) {
@@ -723,11 +728,11 @@ int CmdStereoWindowed(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--mode") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --mode\n");
+          Printf("Missing value for --mode\n");
           return 1;
         }
         if (!ParseWindowedMode(argv[i + 1], &mode)) {
-          std::printf("Invalid mode: %s\n", argv[i + 1]);
+          Printf("Invalid mode: %s\n", argv[i + 1]);
           return 1;
         }
         hasMode = true;
@@ -736,47 +741,47 @@ int CmdStereoWindowed(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--flags") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --flags\n");
+          Printf("Missing value for --flags\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &flags)) {
-          std::printf("Invalid flags: %s\n", argv[i + 1]);
+          Printf("Invalid flags: %s\n", argv[i + 1]);
           return 1;
         }
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
 
     if (!hasMode) {
-      std::printf("Missing required --mode.\n");
+      Printf("Missing required --mode.\n");
       return 1;
     }
 
-    NvAPI_Status status = NvAPI_Stereo_SetWindowedMode(mode, flags);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_SetWindowedMode(mode, flags);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_SetWindowedMode failed", status);
       return 1;
     }
-    std::printf("Windowed mode updated to %s.\n", WindowedModeName(mode));
+    Printf("Windowed mode updated to %s.\n", WindowedModeName(mode));
     return 0;
   }
 
-  std::printf("Unknown windowed command: %s\n", argv[0]);
+  Printf("Unknown windowed command: %s\n", argv[0]);
   return 1;
 }
 
 int CmdStereoCaps(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing caps command.\n");
+    Printf("Missing caps command.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "get") == 0) {
     NVAPI_STEREO_CAPS caps = {};
     caps.version = NVAPI_STEREO_CAPS_VER;
-    NvAPI_Status status = NvAPI_Stereo_GetStereoCaps(&caps);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_GetStereoCaps(&caps);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_GetStereoCaps failed", status);
       return 1;
@@ -787,7 +792,7 @@ int CmdStereoCaps(int argc, char **argv) {
   if (std::strcmp(argv[0], "internal") == 0) {
     NVAPI_STEREO_CAPS caps = {};
     caps.version = NVAPI_STEREO_CAPS_VER;
-    NvAPI_Status status = NvAPI_Stereo_GetStereoCapsInternal(&caps);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_GetStereoCapsInternal(&caps);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_GetStereoCapsInternal failed", status);
       return 1;
@@ -805,11 +810,11 @@ int CmdStereoCaps(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--monitor-index") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --monitor-index\n");
+          Printf("Missing value for --monitor-index\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &monitorIndex)) {
-          std::printf("Invalid monitor index: %s\n", argv[i + 1]);
+          Printf("Invalid monitor index: %s\n", argv[i + 1]);
           return 1;
         }
         hasMonitorIndex = true;
@@ -818,39 +823,39 @@ int CmdStereoCaps(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--id") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --id\n");
+          Printf("Missing value for --id\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &displayId)) {
-          std::printf("Invalid display id: %s\n", argv[i + 1]);
+          Printf("Invalid display id: %s\n", argv[i + 1]);
           return 1;
         }
         hasDisplayId = true;
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
 
     if (hasMonitorIndex) {
       if (!GetMonitorHandleByIndex(monitorIndex, &monitor)) {
-        std::printf("Failed to resolve monitor index %u.\n", monitorIndex);
+        Printf("Failed to resolve monitor index %u.\n", monitorIndex);
         return 1;
       }
     } else if (hasDisplayId) {
       if (!GetMonitorHandleByDisplayId(displayId, &monitor)) {
-        std::printf("Failed to resolve monitor for display id 0x%08X.\n", displayId);
+        Printf("Failed to resolve monitor for display id 0x%08X.\n", displayId);
         return 1;
       }
     } else {
-      std::printf("Missing --monitor-index or --id for monitor caps.\n");
+      Printf("Missing --monitor-index or --id for monitor caps.\n");
       return 1;
     }
 
     NVAPI_STEREO_CAPS caps = {};
     caps.version = NVAPI_STEREO_CAPS_VER;
-    NvAPI_Status status = NvAPI_Stereo_GetStereoSupport(monitor, &caps);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_GetStereoSupport(monitor, &caps);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_GetStereoSupport failed", status);
       return 1;
@@ -859,7 +864,7 @@ int CmdStereoCaps(int argc, char **argv) {
     return 0;
   }
 
-  std::printf("Unknown caps command: %s\n", argv[0]);
+  Printf("Unknown caps command: %s\n", argv[0]);
   return 1;
 }
 int CmdStereoInfo(int argc, char **argv) {
@@ -867,48 +872,47 @@ int CmdStereoInfo(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--handle-index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --handle-index\n");
+        Printf("Missing value for --handle-index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &handleIndex)) {
-        std::printf("Invalid handle index: %s\n", argv[i + 1]);
+        Printf("Invalid handle index: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   NvDisplayHandle displayHandle = nullptr;
   if (!GetDisplayHandleByIndex(handleIndex, &displayHandle)) {
-    std::printf("Failed to resolve display handle %u.\n", handleIndex);
+    Printf("Failed to resolve display handle %u.\n", handleIndex);
     return 1;
   }
 
   NV_STEREO_DIAG_INFO info = {};
   info.version = NV_STEREO_DIAG_INFO_VER;
   info.queryId = NV_STEREO_DIAG_INFO_QUERY_ID_COMMON;
-  NvAPI_Status status = NvAPI_Stereo_GetInfo(displayHandle, &info);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_GetInfo(displayHandle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Stereo_GetInfo failed", status);
     return 1;
   }
 
   const NV_STEREO_DIAG_COMMON_INFO &common = info.commonInfo;
-  std::printf("Stereo info result=%u\n", info.result);
-  std::printf("  enabled=%u active=%u clients=%u devices=%d\n", common.status.isStereoEnabled,
-              common.status.isStereoActive, common.status.numStereoClients, common.status.stereoDeviceCount);
+  Printf("Stereo info result=%u\n", info.result);
+  Printf("  enabled=%u active=%u clients=%u devices=%d\n", common.status.isStereoEnabled, common.status.isStereoActive,
+         common.status.numStereoClients, common.status.stereoDeviceCount);
   for (NvU32 i = 0; i < NV_STEREO_MAX_HEADS; ++i) {
-    std::printf("  head[%u] config=0x%08X pending=0x%08X persistent=0x%08X\n", i, common.status.stereoConfig[i],
-                common.status.pendingStereoConfig[i], common.status.persistentStereoConfig[i]);
-  }
-  std::printf("  emitter init=%u connected=%u activated=%u activeHead=%u activeCount=%u\n", common.emitter.isInit,
-              common.emitter.isConnected, common.emitter.isActivated, common.emitter.activatedHead,
-              common.emitter.activeCount);
-  std::printf("  aero appCount=%u appPid=%u originalRR=%u\n", common.aero.appCount, common.aero.appPid,
-              common.aero.orgRR);
+    Printf("  head[%u] config=0x%08X pending=0x%08X persistent=0x%08X\n", i, common.status.stereoConfig[i],
+           common.status.pendingStereoConfig[i], common.status.persistentStereoConfig[i]);
+  }
+  Printf("  emitter init=%u connected=%u activated=%u activeHead=%u activeCount=%u\n", common.emitter.isInit,
+         common.emitter.isConnected, common.emitter.isActivated, common.emitter.activatedHead,
+         common.emitter.activeCount);
+  Printf("  aero appCount=%u appPid=%u originalRR=%u\n", common.aero.appCount, common.aero.appPid, common.aero.orgRR);
   return 0;
 }
 
@@ -917,23 +921,23 @@ int CmdStereoAppInfo(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--handle-index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --handle-index\n");
+        Printf("Missing value for --handle-index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &handleIndex)) {
-        std::printf("Invalid handle index: %s\n", argv[i + 1]);
+        Printf("Invalid handle index: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   NvDisplayHandle displayHandle = nullptr;
   if (!GetDisplayHandleByIndex(handleIndex, &displayHandle)) {
-    std::printf("Failed to resolve display handle %u.\n", handleIndex);
+    Printf("Failed to resolve display handle %u.\n", handleIndex);
     return 1;
   }
 
@@ -941,13 +945,13 @@ int CmdStereoAppInfo(int argc, char **argv) {
   info.version = NV_STEREO_DIAG_APP_INFO_VER;
   info.appCount = NV_STEREO_INFO_MAX_APPS;
   info.appDataSize = NV_STEREO_APP_INFO_SIZE;
-  NvAPI_Status status = NvAPI_Stereo_GetAppInfo(displayHandle, &info);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_GetAppInfo(displayHandle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Stereo_GetAppInfo failed", status);
     return 1;
   }
 
-  std::printf("App info count=%u dataSize=%u\n", info.appCount, info.appDataSize);
+  Printf("App info count=%u dataSize=%u\n", info.appCount, info.appDataSize);
   for (NvU32 i = 0; i < info.appCount && i < NV_STEREO_INFO_MAX_APPS; ++i) {
     const NV_STEREO_APP_INFO &app = info.info[i];
     const char *dxName = "unknown";
@@ -956,14 +960,14 @@ int CmdStereoAppInfo(int argc, char **argv) {
     } else if (app.dxVersion == NV_STEREO_INFO_DX10_APP) {
       dxName = "dx10";
     }
-    std::printf("  app[%u] dx=%s pid=%u\n", i, dxName, app.processId);
+    Printf("  app[%u] dx=%s pid=%u\n", i, dxName, app.processId);
   }
   return 0;
 }
 
 int CmdStereoModeEnum(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing mode-enum command.\n");
+    Printf("Missing mode-enum command.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "get") == 0) {
@@ -971,12 +975,12 @@ int CmdStereoModeEnum(int argc, char **argv) {
     control.version = NVAPI_STEREO_MODE_ENUM_CONTROL_VER;
     control.command = STEREO_MODE_ENUM_STATUS;
     control.data = 0;
-    NvAPI_Status status = NvAPI_Stereo_ModeEnumControl(&control);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_ModeEnumControl(&control);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_ModeEnumControl failed", status);
       return 1;
     }
-    std::printf("Mode enum status: command=%s data=%u\n", ModeEnumCommandName(control.command), control.data);
+    Printf("Mode enum status: command=%s data=%u\n", ModeEnumCommandName(control.command), control.data);
     return 0;
   }
   if (std::strcmp(argv[0], "set") == 0) {
@@ -987,11 +991,11 @@ int CmdStereoModeEnum(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--command") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --command\n");
+          Printf("Missing value for --command\n");
           return 1;
         }
         if (!ParseModeEnumCommand(argv[i + 1], &command)) {
-          std::printf("Invalid command: %s\n", argv[i + 1]);
+          Printf("Invalid command: %s\n", argv[i + 1]);
           return 1;
         }
         hasCommand = true;
@@ -1000,22 +1004,22 @@ int CmdStereoModeEnum(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--data") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --data\n");
+          Printf("Missing value for --data\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &data)) {
-          std::printf("Invalid data: %s\n", argv[i + 1]);
+          Printf("Invalid data: %s\n", argv[i + 1]);
           return 1;
         }
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
 
     if (!hasCommand) {
-      std::printf("Missing required --command.\n");
+      Printf("Missing required --command.\n");
       return 1;
     }
 
@@ -1023,33 +1027,33 @@ int CmdStereoModeEnum(int argc, char **argv) {
     control.version = NVAPI_STEREO_MODE_ENUM_CONTROL_VER;
     control.command = command;
     control.data = data;
-    NvAPI_Status status = NvAPI_Stereo_ModeEnumControl(&control);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_ModeEnumControl(&control);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_ModeEnumControl failed", status);
       return 1;
     }
-    std::printf("Mode enum updated: command=%s data=%u\n", ModeEnumCommandName(control.command), control.data);
+    Printf("Mode enum updated: command=%s data=%u\n", ModeEnumCommandName(control.command), control.data);
     return 0;
   }
 
-  std::printf("Unknown mode-enum command: %s\n", argv[0]);
+  Printf("Unknown mode-enum command: %s\n", argv[0]);
   return 1;
 }
 
 int CmdStereoAccessory() {
   NvU32 enabled = 0;
-  NvAPI_Status status = NvAPI_Stereo_IsAccessoryDisplayEnabled(&enabled);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_IsAccessoryDisplayEnabled(&enabled);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Stereo_IsAccessoryDisplayEnabled failed", status);
     return 1;
   }
-  std::printf("Accessory display enabled: %s\n", enabled ? "yes" : "no");
+  Printf("Accessory display enabled: %s\n", enabled ? "yes" : "no");
   return 0;
 }
 
 int CmdStereoDongle(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing dongle command.\n");
+    Printf("Missing dongle command.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "status") == 0) {
@@ -1061,11 +1065,11 @@ int CmdStereoDongle(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--id") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --id\n");
+          Printf("Missing value for --id\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &displayId)) {
-          std::printf("Invalid display id: %s\n", argv[i + 1]);
+          Printf("Invalid display id: %s\n", argv[i + 1]);
           return 1;
         }
         hasDisplayId = true;
@@ -1074,33 +1078,33 @@ int CmdStereoDongle(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--param") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --param\n");
+          Printf("Missing value for --param\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &param)) {
-          std::printf("Invalid param: %s\n", argv[i + 1]);
+          Printf("Invalid param: %s\n", argv[i + 1]);
           return 1;
         }
         hasParam = true;
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
 
     if (!hasDisplayId || !hasParam) {
-      std::printf("Missing --id or --param for dongle status.\n");
+      Printf("Missing --id or --param for dongle status.\n");
       return 1;
     }
 
     NvU32 result = 0;
-    NvAPI_Status status = NvAPI_Stereo_Dongle_Status(displayId, static_cast<NvU8>(param), &result);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_Dongle_Status(displayId, static_cast<NvU8>(param), &result);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_Dongle_Status failed", status);
       return 1;
     }
-    std::printf("Dongle status result=%u\n", result);
+    Printf("Dongle status result=%u\n", result);
     return 0;
   }
   if (std::strcmp(argv[0], "control") == 0) {
@@ -1112,11 +1116,11 @@ int CmdStereoDongle(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--handle-index") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --handle-index\n");
+          Printf("Missing value for --handle-index\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &handleIndex)) {
-          std::printf("Invalid handle index: %s\n", argv[i + 1]);
+          Printf("Invalid handle index: %s\n", argv[i + 1]);
           return 1;
         }
         ++i;
@@ -1124,11 +1128,11 @@ int CmdStereoDongle(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--command") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --command\n");
+          Printf("Missing value for --command\n");
           return 1;
         }
         if (!ParseDongleCommand(argv[i + 1], &command)) {
-          std::printf("Invalid dongle command: %s\n", argv[i + 1]);
+          Printf("Invalid dongle command: %s\n", argv[i + 1]);
           return 1;
         }
         hasCommand = true;
@@ -1137,28 +1141,28 @@ int CmdStereoDongle(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--data") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --data\n");
+          Printf("Missing value for --data\n");
           return 1;
         }
         if (!ParseUint(argv[i + 1], &data)) {
-          std::printf("Invalid data: %s\n", argv[i + 1]);
+          Printf("Invalid data: %s\n", argv[i + 1]);
           return 1;
         }
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
 
     if (!hasCommand) {
-      std::printf("Missing required --command.\n");
+      Printf("Missing required --command.\n");
       return 1;
     }
 
     NvDisplayHandle displayHandle = nullptr;
     if (!GetDisplayHandleByIndex(handleIndex, &displayHandle)) {
-      std::printf("Failed to resolve display handle %u.\n", handleIndex);
+      Printf("Failed to resolve display handle %u.\n", handleIndex);
       return 1;
     }
 
@@ -1166,17 +1170,17 @@ int CmdStereoDongle(int argc, char **argv) {
     control.version = NVAPI_STEREO_DONGLE_CONTROL_VER;
     control.command = command;
     control.data = data;
-    NvAPI_Status status = NvAPI_Stereo_DongleControl(displayHandle, &control);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_DongleControl(displayHandle, &control);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_DongleControl failed", status);
       return 1;
     }
-    std::printf("Dongle control ok: command=%s data=%u result=%u\n", DongleCommandName(control.command), control.data,
-                control.result);
+    Printf("Dongle control ok: command=%s data=%u result=%u\n", DongleCommandName(control.command), control.data,
+           control.result);
     return 0;
   }
 
-  std::printf("Unknown dongle command: %s\n", argv[0]);
+  Printf("Unknown dongle command: %s\n", argv[0]);
   return 1;
 }
 
@@ -1186,48 +1190,48 @@ int CmdStereoAegis(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--panel-id") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --panel-id\n");
+        Printf("Missing value for --panel-id\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &panelId)) {
-        std::printf("Invalid panel id: %s\n", argv[i + 1]);
+        Printf("Invalid panel id: %s\n", argv[i + 1]);
         return 1;
       }
       hasPanel = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
   if (!hasPanel) {
-    std::printf("Missing required --panel-id.\n");
+    Printf("Missing required --panel-id.\n");
     return 1;
   }
   NvU8 detected = 0;
-  NvAPI_Status status = NvAPI_Stereo_IsDisplayAegisDTType(panelId, &detected);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_IsDisplayAegisDTType(panelId, &detected);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Stereo_IsDisplayAegisDTType failed", status);
     return 1;
   }
-  std::printf("Aegis DT detected: %s\n", detected ? "yes" : "no");
+  Printf("Aegis DT detected: %s\n", detected ? "yes" : "no");
   return 0;
 }
 
 int CmdStereoDefaultProfile(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing default-profile command.\n");
+    Printf("Missing default-profile command.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "get") == 0) {
     NvAPI_String name = {};
     NvU32 sizeOut = 0;
-    NvAPI_Status status = NvAPI_Stereo_GetDefaultProfile(sizeof(name), name, &sizeOut);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_GetDefaultProfile(sizeof(name), name, &sizeOut);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_GetDefaultProfile failed", status);
       return 1;
     }
-    std::printf("Default profile: %s\n", name);
+    Printf("Default profile: %s\n", name);
     return 0;
   }
   if (std::strcmp(argv[0], "set") == 0) {
@@ -1235,35 +1239,35 @@ int CmdStereoDefaultProfile(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--name") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --name\n");
+          Printf("Missing value for --name\n");
           return 1;
         }
         name = argv[i + 1];
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
     if (!name) {
-      std::printf("Missing required --name.\n");
+      Printf("Missing required --name.\n");
       return 1;
     }
-    NvAPI_Status status = NvAPI_Stereo_SetDefaultProfile(name);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_SetDefaultProfile(name);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_SetDefaultProfile failed", status);
       return 1;
     }
-    std::printf("Default profile updated.\n");
+    Printf("Default profile updated.\n");
     return 0;
   }
-  std::printf("Unknown default-profile command: %s\n", argv[0]);
+  Printf("Unknown default-profile command: %s\n", argv[0]);
   return 1;
 }
 
 int CmdStereoProfile(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing profile command.\n");
+    Printf("Missing profile command.\n");
     return 1;
   }
   NV_STEREO_REGISTRY_PROFILE_TYPE type = NVAPI_STEREO_DEFAULT_REGISTRY_PROFILE;
@@ -1279,11 +1283,11 @@ int CmdStereoProfile(int argc, char **argv) {
     for (int i = start; i < argc; ++i) {
       if (std::strcmp(argv[i], "--type") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --type\n");
+          Printf("Missing value for --type\n");
           return false;
         }
         if (!ParseRegistryProfileType(argv[i + 1], &type)) {
-          std::printf("Invalid profile type: %s\n", argv[i + 1]);
+          Printf("Invalid profile type: %s\n", argv[i + 1]);
           return false;
         }
         hasType = true;
@@ -1292,11 +1296,11 @@ int CmdStereoProfile(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--id") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --id\n");
+          Printf("Missing value for --id\n");
           return false;
         }
         if (!ParseRegistryId(argv[i + 1], &id)) {
-          std::printf("Invalid registry id: %s\n", argv[i + 1]);
+          Printf("Invalid registry id: %s\n", argv[i + 1]);
           return false;
         }
         hasId = true;
@@ -1305,11 +1309,11 @@ int CmdStereoProfile(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--dword") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --dword\n");
+          Printf("Missing value for --dword\n");
           return false;
         }
         if (!ParseUint(argv[i + 1], &dwordValue)) {
-          std::printf("Invalid dword: %s\n", argv[i + 1]);
+          Printf("Invalid dword: %s\n", argv[i + 1]);
           return false;
         }
         hasDword = true;
@@ -1318,18 +1322,18 @@ int CmdStereoProfile(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--float") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --float\n");
+          Printf("Missing value for --float\n");
           return false;
         }
         if (!ParseFloatValue(argv[i + 1], &floatValue)) {
-          std::printf("Invalid float: %s\n", argv[i + 1]);
+          Printf("Invalid float: %s\n", argv[i + 1]);
           return false;
         }
         hasFloat = true;
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return false;
     }
     return true;
@@ -1338,77 +1342,77 @@ int CmdStereoProfile(int argc, char **argv) {
   if (std::strcmp(argv[0], "create") == 0) {
     if (!ParseCommon(1)) { return 1; }
     if (!hasType) {
-      std::printf("Missing required --type.\n");
+      Printf("Missing required --type.\n");
       return 1;
     }
-    NvAPI_Status status = NvAPI_Stereo_CreateConfigurationProfileRegistryKey(type);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_CreateConfigurationProfileRegistryKey(type);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_CreateConfigurationProfileRegistryKey failed", status);
       return 1;
     }
-    std::printf("Profile key created.\n");
+    Printf("Profile key created.\n");
     return 0;
   }
   if (std::strcmp(argv[0], "delete") == 0) {
     if (!ParseCommon(1)) { return 1; }
     if (!hasType) {
-      std::printf("Missing required --type.\n");
+      Printf("Missing required --type.\n");
       return 1;
     }
-    NvAPI_Status status = NvAPI_Stereo_DeleteConfigurationProfileRegistryKey(type);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_DeleteConfigurationProfileRegistryKey(type);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_DeleteConfigurationProfileRegistryKey failed", status);
       return 1;
     }
-    std::printf("Profile key deleted.\n");
+    Printf("Profile key deleted.\n");
     return 0;
   }
   if (std::strcmp(argv[0], "set") == 0) {
     if (!ParseCommon(1)) { return 1; }
     if (!hasType || !hasId) {
-      std::printf("Missing required --type or --id.\n");
+      Printf("Missing required --type or --id.\n");
       return 1;
     }
     if (!hasDword && !hasFloat) {
-      std::printf("Missing --dword or --float value.\n");
+      Printf("Missing --dword or --float value.\n");
       return 1;
     }
 
     NvAPI_Status status = NVAPI_OK;
     if (hasDword) {
-      status = NvAPI_Stereo_SetConfigurationProfileValue(type, id, &dwordValue);
+      status = NvApi().NvAPI_Stereo_SetConfigurationProfileValue(type, id, &dwordValue);
     } else {
-      status = NvAPI_Stereo_SetConfigurationProfileValue(type, id, &floatValue);
+      status = NvApi().NvAPI_Stereo_SetConfigurationProfileValue(type, id, &floatValue);
     }
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_SetConfigurationProfileValue failed", status);
       return 1;
     }
-    std::printf("Profile value updated.\n");
+    Printf("Profile value updated.\n");
     return 0;
   }
   if (std::strcmp(argv[0], "delete-value") == 0) {
     if (!ParseCommon(1)) { return 1; }
     if (!hasType || !hasId) {
-      std::printf("Missing required --type or --id.\n");
+      Printf("Missing required --type or --id.\n");
       return 1;
     }
-    NvAPI_Status status = NvAPI_Stereo_DeleteConfigurationProfileValue(type, id);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_DeleteConfigurationProfileValue(type, id);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_DeleteConfigurationProfileValue failed", status);
       return 1;
     }
-    std::printf("Profile value deleted.\n");
+    Printf("Profile value deleted.\n");
     return 0;
   }
 
-  std::printf("Unknown profile command: %s\n", argv[0]);
+  Printf("Unknown profile command: %s\n", argv[0]);
   return 1;
 }
 
 int CmdStereoDriverMode(int argc, char **argv) {
   if (argc < 1 || std::strcmp(argv[0], "set") != 0) {
-    std::printf("Driver-mode command requires: set --mode automatic|direct\n");
+    Printf("Driver-mode command requires: set --mode automatic|direct\n");
     return 1;
   }
   NV_STEREO_DRIVER_MODE mode = NVAPI_STEREO_DRIVER_MODE_AUTOMATIC;
@@ -1416,30 +1420,30 @@ int CmdStereoDriverMode(int argc, char **argv) {
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "--mode") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --mode\n");
+        Printf("Missing value for --mode\n");
         return 1;
       }
       if (!ParseDriverMode(argv[i + 1], &mode)) {
-        std::printf("Invalid mode: %s\n", argv[i + 1]);
+        Printf("Invalid mode: %s\n", argv[i + 1]);
         return 1;
       }
       hasMode = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
   if (!hasMode) {
-    std::printf("Missing required --mode.\n");
+    Printf("Missing required --mode.\n");
     return 1;
   }
-  NvAPI_Status status = NvAPI_Stereo_SetDriverMode(mode);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_SetDriverMode(mode);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Stereo_SetDriverMode failed", status);
     return 1;
   }
-  std::printf("Driver mode set to %s.\n", DriverModeName(mode));
+  Printf("Driver mode set to %s.\n", DriverModeName(mode));
   return 0;
 }
 int CmdStereoActivation(const char *command) {
@@ -1447,15 +1451,15 @@ int CmdStereoActivation(const char *command) {
   if (!ctx.Init()) { return 1; }
   NvAPI_Status status = NVAPI_OK;
   if (std::strcmp(command, "activate") == 0) {
-    status = NvAPI_Stereo_Activate(ctx.handle);
+    status = NvApi().NvAPI_Stereo_Activate(ctx.handle);
   } else if (std::strcmp(command, "deactivate") == 0) {
-    status = NvAPI_Stereo_Deactivate(ctx.handle);
+    status = NvApi().NvAPI_Stereo_Deactivate(ctx.handle);
   } else if (std::strcmp(command, "is-activated") == 0) {
     NvU8 active = 0;
-    status = NvAPI_Stereo_IsActivated(ctx.handle, &active);
-    if (status == NVAPI_OK) { std::printf("Stereo activated: %s\n", active ? "yes" : "no"); }
+    status = NvApi().NvAPI_Stereo_IsActivated(ctx.handle, &active);
+    if (status == NVAPI_OK) { Printf("Stereo activated: %s\n", active ? "yes" : "no"); }
   } else {
-    std::printf("Unknown activation command: %s\n", command);
+    Printf("Unknown activation command: %s\n", command);
     ctx.Cleanup();
     return 1;
   }
@@ -1466,7 +1470,7 @@ int CmdStereoActivation(const char *command) {
 
 int CmdStereoSeparation(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing separation command.\n");
+    Printf("Missing separation command.\n");
     return 1;
   }
   float value = 0.0f;
@@ -1474,18 +1478,18 @@ int CmdStereoSeparation(int argc, char **argv) {
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "--value") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --value\n");
+        Printf("Missing value for --value\n");
         return 1;
       }
       if (!ParseFloatValue(argv[i + 1], &value)) {
-        std::printf("Invalid value: %s\n", argv[i + 1]);
+        Printf("Invalid value: %s\n", argv[i + 1]);
         return 1;
       }
       hasValue = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -1493,21 +1497,21 @@ int CmdStereoSeparation(int argc, char **argv) {
   if (!ctx.Init()) { return 1; }
   NvAPI_Status status = NVAPI_OK;
   if (std::strcmp(argv[0], "get") == 0) {
-    status = NvAPI_Stereo_GetSeparation(ctx.handle, &value);
-    if (status == NVAPI_OK) { std::printf("Separation: %.3f\n", value); }
+    status = NvApi().NvAPI_Stereo_GetSeparation(ctx.handle, &value);
+    if (status == NVAPI_OK) { Printf("Separation: %.3f\n", value); }
   } else if (std::strcmp(argv[0], "set") == 0) {
     if (!hasValue) {
-      std::printf("Missing required --value.\n");
+      Printf("Missing required --value.\n");
       ctx.Cleanup();
       return 1;
     }
-    status = NvAPI_Stereo_SetSeparation(ctx.handle, value);
+    status = NvApi().NvAPI_Stereo_SetSeparation(ctx.handle, value);
   } else if (std::strcmp(argv[0], "inc") == 0) {
-    status = NvAPI_Stereo_IncreaseSeparation(ctx.handle);
+    status = NvApi().NvAPI_Stereo_IncreaseSeparation(ctx.handle);
   } else if (std::strcmp(argv[0], "dec") == 0) {
-    status = NvAPI_Stereo_DecreaseSeparation(ctx.handle);
+    status = NvApi().NvAPI_Stereo_DecreaseSeparation(ctx.handle);
   } else {
-    std::printf("Unknown separation command: %s\n", argv[0]);
+    Printf("Unknown separation command: %s\n", argv[0]);
     ctx.Cleanup();
     return 1;
   }
@@ -1519,7 +1523,7 @@ int CmdStereoSeparation(int argc, char **argv) {
 
 int CmdStereoConvergence(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing convergence command.\n");
+    Printf("Missing convergence command.\n");
     return 1;
   }
   float value = 0.0f;
@@ -1527,18 +1531,18 @@ int CmdStereoConvergence(int argc, char **argv) {
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "--value") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --value\n");
+        Printf("Missing value for --value\n");
         return 1;
       }
       if (!ParseFloatValue(argv[i + 1], &value)) {
-        std::printf("Invalid value: %s\n", argv[i + 1]);
+        Printf("Invalid value: %s\n", argv[i + 1]);
         return 1;
       }
       hasValue = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -1546,21 +1550,21 @@ int CmdStereoConvergence(int argc, char **argv) {
   if (!ctx.Init()) { return 1; }
   NvAPI_Status status = NVAPI_OK;
   if (std::strcmp(argv[0], "get") == 0) {
-    status = NvAPI_Stereo_GetConvergence(ctx.handle, &value);
-    if (status == NVAPI_OK) { std::printf("Convergence: %.3f\n", value); }
+    status = NvApi().NvAPI_Stereo_GetConvergence(ctx.handle, &value);
+    if (status == NVAPI_OK) { Printf("Convergence: %.3f\n", value); }
   } else if (std::strcmp(argv[0], "set") == 0) {
     if (!hasValue) {
-      std::printf("Missing required --value.\n");
+      Printf("Missing required --value.\n");
       ctx.Cleanup();
       return 1;
     }
-    status = NvAPI_Stereo_SetConvergence(ctx.handle, value);
+    status = NvApi().NvAPI_Stereo_SetConvergence(ctx.handle, value);
   } else if (std::strcmp(argv[0], "inc") == 0) {
-    status = NvAPI_Stereo_IncreaseConvergence(ctx.handle);
+    status = NvApi().NvAPI_Stereo_IncreaseConvergence(ctx.handle);
   } else if (std::strcmp(argv[0], "dec") == 0) {
-    status = NvAPI_Stereo_DecreaseConvergence(ctx.handle);
+    status = NvApi().NvAPI_Stereo_DecreaseConvergence(ctx.handle);
   } else {
-    std::printf("Unknown convergence command: %s\n", argv[0]);
+    Printf("Unknown convergence command: %s\n", argv[0]);
     ctx.Cleanup();
     return 1;
   }
@@ -1572,7 +1576,7 @@ int CmdStereoConvergence(int argc, char **argv) {
 
 int CmdStereoFrustum(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing frustum command.\n");
+    Printf("Missing frustum command.\n");
     return 1;
   }
   NV_FRUSTUM_ADJUST_MODE mode = NVAPI_NO_FRUSTUM_ADJUST;
@@ -1580,18 +1584,18 @@ int CmdStereoFrustum(int argc, char **argv) {
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "--mode") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --mode\n");
+        Printf("Missing value for --mode\n");
         return 1;
       }
       if (!ParseFrustumAdjustMode(argv[i + 1], &mode)) {
-        std::printf("Invalid mode: %s\n", argv[i + 1]);
+        Printf("Invalid mode: %s\n", argv[i + 1]);
         return 1;
       }
       hasMode = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
@@ -1599,17 +1603,17 @@ int CmdStereoFrustum(int argc, char **argv) {
   if (!ctx.Init()) { return 1; }
   NvAPI_Status status = NVAPI_OK;
   if (std::strcmp(argv[0], "get") == 0) {
-    status = NvAPI_Stereo_GetFrustumAdjustMode(ctx.handle, &mode);
-    if (status == NVAPI_OK) { std::printf("Frustum adjust mode: %s\n", FrustumAdjustModeName(mode)); }
+    status = NvApi().NvAPI_Stereo_GetFrustumAdjustMode(ctx.handle, &mode);
+    if (status == NVAPI_OK) { Printf("Frustum adjust mode: %s\n", FrustumAdjustModeName(mode)); }
   } else if (std::strcmp(argv[0], "set") == 0) {
     if (!hasMode) {
-      std::printf("Missing required --mode.\n");
+      Printf("Missing required --mode.\n");
       ctx.Cleanup();
       return 1;
     }
-    status = NvAPI_Stereo_SetFrustumAdjustMode(ctx.handle, mode);
+    status = NvApi().NvAPI_Stereo_SetFrustumAdjustMode(ctx.handle, mode);
   } else {
-    std::printf("Unknown frustum command: %s\n", argv[0]);
+    Printf("Unknown frustum command: %s\n", argv[0]);
     ctx.Cleanup();
     return 1;
   }
@@ -1621,7 +1625,7 @@ int CmdStereoFrustum(int argc, char **argv) {
 
 int CmdStereoCapture(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing capture command.\n");
+    Printf("Missing capture command.\n");
     return 1;
   }
   StereoContext ctx;
@@ -1632,27 +1636,27 @@ int CmdStereoCapture(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--quality") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --quality\n");
+          Printf("Missing value for --quality\n");
           ctx.Cleanup();
           return 1;
         }
         if (!ParseUint(argv[i + 1], &quality)) {
-          std::printf("Invalid quality: %s\n", argv[i + 1]);
+          Printf("Invalid quality: %s\n", argv[i + 1]);
           ctx.Cleanup();
           return 1;
         }
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       ctx.Cleanup();
       return 1;
     }
-    status = NvAPI_Stereo_CaptureJpegImage(ctx.handle, quality);
+    status = NvApi().NvAPI_Stereo_CaptureJpegImage(ctx.handle, quality);
   } else if (std::strcmp(argv[0], "png") == 0) {
-    status = NvAPI_Stereo_CapturePngImage(ctx.handle);
+    status = NvApi().NvAPI_Stereo_CapturePngImage(ctx.handle);
   } else {
-    std::printf("Unknown capture command: %s\n", argv[0]);
+    Printf("Unknown capture command: %s\n", argv[0]);
     ctx.Cleanup();
     return 1;
   }
@@ -1667,27 +1671,27 @@ int CmdStereoInitActivation(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--flag") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --flag\n");
+        Printf("Missing value for --flag\n");
         return 1;
       }
       if (!ParseInitActivationFlag(argv[i + 1], &flag)) {
-        std::printf("Invalid flag: %s\n", argv[i + 1]);
+        Printf("Invalid flag: %s\n", argv[i + 1]);
         return 1;
       }
       hasFlag = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
   if (!hasFlag) {
-    std::printf("Missing required --flag.\n");
+    Printf("Missing required --flag.\n");
     return 1;
   }
   StereoContext ctx;
   if (!ctx.Init()) { return 1; }
-  NvAPI_Status status = NvAPI_Stereo_InitActivation(ctx.handle, flag);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_InitActivation(ctx.handle, flag);
   if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_InitActivation failed", status); }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
@@ -1696,7 +1700,7 @@ int CmdStereoInitActivation(int argc, char **argv) {
 int CmdStereoTriggerActivation() {
   StereoContext ctx;
   if (!ctx.Init()) { return 1; }
-  NvAPI_Status status = NvAPI_Stereo_Trigger_Activation(ctx.handle);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_Trigger_Activation(ctx.handle);
   if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_Trigger_Activation failed", status); }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
@@ -1708,27 +1712,27 @@ int CmdStereoReverseBlit(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--enable") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --enable\n");
+        Printf("Missing value for --enable\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &enable)) {
-        std::printf("Invalid enable value: %s\n", argv[i + 1]);
+        Printf("Invalid enable value: %s\n", argv[i + 1]);
         return 1;
       }
       hasEnable = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
   if (!hasEnable) {
-    std::printf("Missing required --enable.\n");
+    Printf("Missing required --enable.\n");
     return 1;
   }
   StereoContext ctx;
   if (!ctx.Init()) { return 1; }
-  NvAPI_Status status = NvAPI_Stereo_ReverseStereoBlitControl(ctx.handle, enable ? 1 : 0);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_ReverseStereoBlitControl(ctx.handle, enable ? 1 : 0);
   if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_ReverseStereoBlitControl failed", status); }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
@@ -1742,11 +1746,11 @@ int CmdStereoNotify(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--hwnd") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --hwnd\n");
+        Printf("Missing value for --hwnd\n");
         return 1;
       }
       if (!ParseU64(argv[i + 1], &hwndValue)) {
-        std::printf("Invalid hwnd: %s\n", argv[i + 1]);
+        Printf("Invalid hwnd: %s\n", argv[i + 1]);
         return 1;
       }
       hasHwnd = true;
@@ -1755,27 +1759,27 @@ int CmdStereoNotify(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--message-id") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --message-id\n");
+        Printf("Missing value for --message-id\n");
         return 1;
       }
       if (!ParseU64(argv[i + 1], &msgId)) {
-        std::printf("Invalid message id: %s\n", argv[i + 1]);
+        Printf("Invalid message id: %s\n", argv[i + 1]);
         return 1;
       }
       hasMsg = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
   if (!hasHwnd || !hasMsg) {
-    std::printf("Missing required --hwnd and --message-id.\n");
+    Printf("Missing required --hwnd and --message-id.\n");
     return 1;
   }
   StereoContext ctx;
   if (!ctx.Init()) { return 1; }
-  NvAPI_Status status = NvAPI_Stereo_SetNotificationMessage(ctx.handle, hwndValue, msgId);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_SetNotificationMessage(ctx.handle, hwndValue, msgId);
   if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_SetNotificationMessage failed", status); }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
@@ -1783,7 +1787,7 @@ int CmdStereoNotify(int argc, char **argv) {
 
 int CmdStereoActiveEye(int argc, char **argv) {
   if (argc < 1 || std::strcmp(argv[0], "set") != 0) {
-    std::printf("Active-eye command requires: set --eye left|right|mono\n");
+    Printf("Active-eye command requires: set --eye left|right|mono\n");
     return 1;
   }
   NV_STEREO_ACTIVE_EYE eye = NVAPI_STEREO_EYE_LEFT;
@@ -1791,27 +1795,27 @@ int CmdStereoActiveEye(int argc, char **argv) {
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "--eye") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --eye\n");
+        Printf("Missing value for --eye\n");
         return 1;
       }
       if (!ParseActiveEye(argv[i + 1], &eye)) {
-        std::printf("Invalid eye: %s\n", argv[i + 1]);
+        Printf("Invalid eye: %s\n", argv[i + 1]);
         return 1;
       }
       hasEye = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
   if (!hasEye) {
-    std::printf("Missing required --eye.\n");
+    Printf("Missing required --eye.\n");
     return 1;
   }
   StereoContext ctx;
   if (!ctx.Init()) { return 1; }
-  NvAPI_Status status = NvAPI_Stereo_SetActiveEye(ctx.handle, eye);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_SetActiveEye(ctx.handle, eye);
   if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_SetActiveEye failed", status); }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
@@ -1821,11 +1825,11 @@ int CmdStereoEyeSeparation() {
   StereoContext ctx;
   if (!ctx.Init()) { return 1; }
   float separation = 0.0f;
-  NvAPI_Status status = NvAPI_Stereo_GetEyeSeparation(ctx.handle, &separation);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_GetEyeSeparation(ctx.handle, &separation);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Stereo_GetEyeSeparation failed", status);
   } else {
-    std::printf("Eye separation: %.6f\n", separation);
+    Printf("Eye separation: %.6f\n", separation);
   }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
@@ -1833,18 +1837,18 @@ int CmdStereoEyeSeparation() {
 
 int CmdStereoCursor(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing cursor command.\n");
+    Printf("Missing cursor command.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "supported") == 0) {
     StereoContext ctx;
     if (!ctx.Init()) { return 1; }
     NvU8 supported = 0;
-    NvAPI_Status status = NvAPI_Stereo_Is3DCursorSupported(ctx.handle, &supported);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_Is3DCursorSupported(ctx.handle, &supported);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_Is3DCursorSupported failed", status);
     } else {
-      std::printf("3D cursor supported: %s\n", supported ? "yes" : "no");
+      Printf("3D cursor supported: %s\n", supported ? "yes" : "no");
     }
     ctx.Cleanup();
     return status == NVAPI_OK ? 0 : 1;
@@ -1853,11 +1857,11 @@ int CmdStereoCursor(int argc, char **argv) {
     StereoContext ctx;
     if (!ctx.Init()) { return 1; }
     float value = 0.0f;
-    NvAPI_Status status = NvAPI_Stereo_GetCursorSeparation(ctx.handle, &value);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_GetCursorSeparation(ctx.handle, &value);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_GetCursorSeparation failed", status);
     } else {
-      std::printf("Cursor separation: %.3f\n", value);
+      Printf("Cursor separation: %.3f\n", value);
     }
     ctx.Cleanup();
     return status == NVAPI_OK ? 0 : 1;
@@ -1868,49 +1872,49 @@ int CmdStereoCursor(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--value") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --value\n");
+          Printf("Missing value for --value\n");
           return 1;
         }
         if (!ParseFloatValue(argv[i + 1], &value)) {
-          std::printf("Invalid value: %s\n", argv[i + 1]);
+          Printf("Invalid value: %s\n", argv[i + 1]);
           return 1;
         }
         hasValue = true;
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
     if (!hasValue) {
-      std::printf("Missing required --value.\n");
+      Printf("Missing required --value.\n");
       return 1;
     }
     StereoContext ctx;
     if (!ctx.Init()) { return 1; }
-    NvAPI_Status status = NvAPI_Stereo_SetCursorSeparation(ctx.handle, value);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_SetCursorSeparation(ctx.handle, value);
     if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_SetCursorSeparation failed", status); }
     ctx.Cleanup();
     return status == NVAPI_OK ? 0 : 1;
   }
-  std::printf("Unknown cursor command: %s\n", argv[0]);
+  Printf("Unknown cursor command: %s\n", argv[0]);
   return 1;
 }
 
 int CmdStereoSurface(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing surface command.\n");
+    Printf("Missing surface command.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "get") == 0) {
     StereoContext ctx;
     if (!ctx.Init()) { return 1; }
     NVAPI_STEREO_SURFACECREATEMODE mode = NVAPI_STEREO_SURFACECREATEMODE_AUTO;
-    NvAPI_Status status = NvAPI_Stereo_GetSurfaceCreationMode(ctx.handle, &mode);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_GetSurfaceCreationMode(ctx.handle, &mode);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_GetSurfaceCreationMode failed", status);
     } else {
-      std::printf("Surface creation mode: %s\n", SurfaceCreationModeName(mode));
+      Printf("Surface creation mode: %s\n", SurfaceCreationModeName(mode));
     }
     ctx.Cleanup();
     return status == NVAPI_OK ? 0 : 1;
@@ -1921,32 +1925,32 @@ int CmdStereoSurface(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--mode") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --mode\n");
+          Printf("Missing value for --mode\n");
           return 1;
         }
         if (!ParseSurfaceCreationMode(argv[i + 1], &mode)) {
-          std::printf("Invalid mode: %s\n", argv[i + 1]);
+          Printf("Invalid mode: %s\n", argv[i + 1]);
           return 1;
         }
         hasMode = true;
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       return 1;
     }
     if (!hasMode) {
-      std::printf("Missing required --mode.\n");
+      Printf("Missing required --mode.\n");
       return 1;
     }
     StereoContext ctx;
     if (!ctx.Init()) { return 1; }
-    NvAPI_Status status = NvAPI_Stereo_SetSurfaceCreationMode(ctx.handle, mode);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_SetSurfaceCreationMode(ctx.handle, mode);
     if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_SetSurfaceCreationMode failed", status); }
     ctx.Cleanup();
     return status == NVAPI_OK ? 0 : 1;
   }
-  std::printf("Unknown surface command: %s\n", argv[0]);
+  Printf("Unknown surface command: %s\n", argv[0]);
   return 1;
 }
 
@@ -1954,11 +1958,11 @@ int CmdStereoDebugLastDraw() {
   StereoContext ctx;
   if (!ctx.Init()) { return 1; }
   NvU8 stereoized = 0;
-  NvAPI_Status status = NvAPI_Stereo_Debug_WasLastDrawStereoized(ctx.handle, &stereoized);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_Debug_WasLastDrawStereoized(ctx.handle, &stereoized);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Stereo_Debug_WasLastDrawStereoized failed", status);
   } else {
-    std::printf("Last draw stereoized: %s\n", stereoized ? "yes" : "no");
+    Printf("Last draw stereoized: %s\n", stereoized ? "yes" : "no");
   }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
@@ -1970,27 +1974,27 @@ int CmdStereoForceToScreen(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--enable") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --enable\n");
+        Printf("Missing value for --enable\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &enable)) {
-        std::printf("Invalid enable value: %s\n", argv[i + 1]);
+        Printf("Invalid enable value: %s\n", argv[i + 1]);
         return 1;
       }
       hasEnable = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
   if (!hasEnable) {
-    std::printf("Missing required --enable.\n");
+    Printf("Missing required --enable.\n");
     return 1;
   }
   StereoContext ctx;
   if (!ctx.Init()) { return 1; }
-  NvAPI_Status status = NvAPI_Stereo_ForceToScreenDepth(ctx.handle, enable ? 1 : 0);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_ForceToScreenDepth(ctx.handle, enable ? 1 : 0);
   if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_ForceToScreenDepth failed", status); }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
@@ -2006,11 +2010,11 @@ int CmdStereoVideoControl(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--layout") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --layout\n");
+        Printf("Missing value for --layout\n");
         return 1;
       }
       if (!ParseStereoSrcLayout(argv[i + 1], &layout)) {
-        std::printf("Invalid layout: %s\n", argv[i + 1]);
+        Printf("Invalid layout: %s\n", argv[i + 1]);
         return 1;
       }
       hasLayout = true;
@@ -2019,11 +2023,11 @@ int CmdStereoVideoControl(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--client-id") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --client-id\n");
+        Printf("Missing value for --client-id\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &clientId)) {
-        std::printf("Invalid client id: %s\n", argv[i + 1]);
+        Printf("Invalid client id: %s\n", argv[i + 1]);
         return 1;
       }
       hasClient = true;
@@ -2032,23 +2036,23 @@ int CmdStereoVideoControl(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--enable") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --enable\n");
+        Printf("Missing value for --enable\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &enable)) {
-        std::printf("Invalid enable value: %s\n", argv[i + 1]);
+        Printf("Invalid enable value: %s\n", argv[i + 1]);
         return 1;
       }
       hasEnable = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasLayout || !hasClient || !hasEnable) {
-    std::printf("Missing required --layout, --client-id, or --enable.\n");
+    Printf("Missing required --layout, --client-id, or --enable.\n");
     return 1;
   }
 
@@ -2059,7 +2063,7 @@ int CmdStereoVideoControl(int argc, char **argv) {
   control.eStereoSrcLayout = layout;
   control.dwClientIdentifier = clientId;
   control.dwStereoEnable = enable ? 1 : 0;
-  NvAPI_Status status = NvAPI_Stereo_SetVideoControl(ctx.handle, &control);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_SetVideoControl(ctx.handle, &control);
   if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_SetVideoControl failed", status); }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
@@ -2078,11 +2082,11 @@ int CmdStereoVideoMetadata(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--width") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --width\n");
+        Printf("Missing value for --width\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &width)) {
-        std::printf("Invalid width: %s\n", argv[i + 1]);
+        Printf("Invalid width: %s\n", argv[i + 1]);
         return 1;
       }
       hasWidth = true;
@@ -2091,11 +2095,11 @@ int CmdStereoVideoMetadata(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--height") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --height\n");
+        Printf("Missing value for --height\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &height)) {
-        std::printf("Invalid height: %s\n", argv[i + 1]);
+        Printf("Invalid height: %s\n", argv[i + 1]);
         return 1;
       }
       hasHeight = true;
@@ -2104,11 +2108,11 @@ int CmdStereoVideoMetadata(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--src") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --src\n");
+        Printf("Missing value for --src\n");
         return 1;
       }
       if (!ParseU64(argv[i + 1], &src)) {
-        std::printf("Invalid src: %s\n", argv[i + 1]);
+        Printf("Invalid src: %s\n", argv[i + 1]);
         return 1;
       }
       hasSrc = true;
@@ -2117,23 +2121,23 @@ int CmdStereoVideoMetadata(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--dst") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --dst\n");
+        Printf("Missing value for --dst\n");
         return 1;
       }
       if (!ParseU64(argv[i + 1], &dst)) {
-        std::printf("Invalid dst: %s\n", argv[i + 1]);
+        Printf("Invalid dst: %s\n", argv[i + 1]);
         return 1;
       }
       hasDst = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasWidth || !hasHeight || !hasSrc || !hasDst) {
-    std::printf("Missing required --width, --height, --src, or --dst.\n");
+    Printf("Missing required --width, --height, --src, or --dst.\n");
     return 1;
   }
 
@@ -2145,14 +2149,14 @@ int CmdStereoVideoMetadata(int argc, char **argv) {
   meta.dwVideoHeight = height;
   meta.hSrcLuma = src;
   meta.hDst = dst;
-  NvAPI_Status status = NvAPI_Stereo_SetVideoMetadata(ctx.handle, &meta);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_SetVideoMetadata(ctx.handle, &meta);
   if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_SetVideoMetadata failed", status); }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
 }
 int CmdStereoHandshake(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing handshake command.\n");
+    Printf("Missing handshake command.\n");
     return 1;
   }
   StereoContext ctx;
@@ -2162,17 +2166,17 @@ int CmdStereoHandshake(int argc, char **argv) {
 
   if (std::strcmp(argv[0], "challenge") == 0) {
     params.dwCommand = NVAPI_STEREO_HANDSHAKE_CMD_CHALLENGE;
-    NvAPI_Status status = NvAPI_Stereo_AppHandShake(ctx.handle, &params);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_AppHandShake(ctx.handle, &params);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_AppHandShake failed", status);
       ctx.Cleanup();
       return 1;
     }
-    std::printf("Handshake challenge: ");
+    Printf("Handshake challenge: ");
     for (NvU32 i = 0; i < NVAPI_STEREO_HANDSHAKE_CHALLENGE_SIZE; ++i) {
-      std::printf("%02X", params.ChallengeParams.challenge[i]);
+      Printf("%02X", params.ChallengeParams.challenge[i]);
     }
-    std::printf("\n");
+    Printf("\n");
     ctx.Cleanup();
     return 0;
   }
@@ -2184,7 +2188,7 @@ int CmdStereoHandshake(int argc, char **argv) {
     for (int i = 1; i < argc; ++i) {
       if (std::strcmp(argv[i], "--guid") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --guid\n");
+          Printf("Missing value for --guid\n");
           ctx.Cleanup();
           return 1;
         }
@@ -2194,7 +2198,7 @@ int CmdStereoHandshake(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--response-hex") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --response-hex\n");
+          Printf("Missing value for --response-hex\n");
           ctx.Cleanup();
           return 1;
         }
@@ -2204,12 +2208,12 @@ int CmdStereoHandshake(int argc, char **argv) {
       }
       if (std::strcmp(argv[i], "--flags") == 0) {
         if (i + 1 >= argc) {
-          std::printf("Missing value for --flags\n");
+          Printf("Missing value for --flags\n");
           ctx.Cleanup();
           return 1;
         }
         if (!ParseUint(argv[i + 1], &flags)) {
-          std::printf("Invalid flags: %s\n", argv[i + 1]);
+          Printf("Invalid flags: %s\n", argv[i + 1]);
           ctx.Cleanup();
           return 1;
         }
@@ -2217,24 +2221,24 @@ int CmdStereoHandshake(int argc, char **argv) {
         ++i;
         continue;
       }
-      std::printf("Unknown option: %s\n", argv[i]);
+      Printf("Unknown option: %s\n", argv[i]);
       ctx.Cleanup();
       return 1;
     }
     if (!guidText || !respText) {
-      std::printf("Missing required --guid or --response-hex.\n");
+      Printf("Missing required --guid or --response-hex.\n");
       ctx.Cleanup();
       return 1;
     }
     NvGUID guid = {};
     if (!ParseGuidString(guidText, &guid)) {
-      std::printf("Invalid GUID: %s\n", guidText);
+      Printf("Invalid GUID: %s\n", guidText);
       ctx.Cleanup();
       return 1;
     }
     std::vector<NvU8> bytes;
     if (!ParseHexBytes(respText, bytes) || bytes.size() != NVAPI_STEREO_HANDSHAKE_RESPONSE_SIZE) {
-      std::printf("Invalid response hex; expected %u bytes.\n", NVAPI_STEREO_HANDSHAKE_RESPONSE_SIZE);
+      Printf("Invalid response hex; expected %u bytes.\n", NVAPI_STEREO_HANDSHAKE_RESPONSE_SIZE);
       ctx.Cleanup();
       return 1;
     }
@@ -2244,18 +2248,18 @@ int CmdStereoHandshake(int argc, char **argv) {
     std::memcpy(params.ResponseParams.response, bytes.data(), bytes.size());
     params.ResponseParams.flags = hasFlags ? flags : 0;
 
-    NvAPI_Status status = NvAPI_Stereo_AppHandShake(ctx.handle, &params);
+    NvAPI_Status status = NvApi().NvAPI_Stereo_AppHandShake(ctx.handle, &params);
     if (status != NVAPI_OK) {
       PrintNvapiError("NvAPI_Stereo_AppHandShake failed", status);
       ctx.Cleanup();
       return 1;
     }
-    std::printf("Handshake response submitted.\n");
+    Printf("Handshake response submitted.\n");
     ctx.Cleanup();
     return 0;
   }
 
-  std::printf("Unknown handshake command: %s\n", argv[0]);
+  Printf("Unknown handshake command: %s\n", argv[0]);
   ctx.Cleanup();
   return 1;
 }
@@ -2263,7 +2267,7 @@ int CmdStereoHandshake(int argc, char **argv) {
 int CmdStereoHandshakeTrigger() {
   StereoContext ctx;
   if (!ctx.Init()) { return 1; }
-  NvAPI_Status status = NvAPI_Stereo_HandShake_Trigger_Activation(ctx.handle);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_HandShake_Trigger_Activation(ctx.handle);
   if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_HandShake_Trigger_Activation failed", status); }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
@@ -2275,34 +2279,34 @@ int CmdStereoHandshakeMessage(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--enable") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --enable\n");
+        Printf("Missing value for --enable\n");
         return 1;
       }
       if (!ParseBoolValue(argv[i + 1], &enable)) {
-        std::printf("Invalid enable value: %s\n", argv[i + 1]);
+        Printf("Invalid enable value: %s\n", argv[i + 1]);
         return 1;
       }
       hasEnable = true;
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
   if (!hasEnable) {
-    std::printf("Missing required --enable.\n");
+    Printf("Missing required --enable.\n");
     return 1;
   }
   StereoContext ctx;
   if (!ctx.Init()) { return 1; }
-  NvAPI_Status status = NvAPI_Stereo_HandShake_Message_Control(ctx.handle, enable ? 1 : 0);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_HandShake_Message_Control(ctx.handle, enable ? 1 : 0);
   if (status != NVAPI_OK) { PrintNvapiError("NvAPI_Stereo_HandShake_Message_Control failed", status); }
   ctx.Cleanup();
   return status == NVAPI_OK ? 0 : 1;
 }
 int CmdStereoProfileName(int argc, char **argv) {
   if (argc < 1 || std::strcmp(argv[0], "set") != 0) {
-    std::printf("Profile-name command requires: set --name NAME\n");
+    Printf("Profile-name command requires: set --name NAME\n");
     return 1;
   }
   const char *name = nullptr;
@@ -2310,7 +2314,7 @@ int CmdStereoProfileName(int argc, char **argv) {
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "--name") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --name\n");
+        Printf("Missing value for --name\n");
         return 1;
       }
       name = argv[i + 1];
@@ -2319,21 +2323,21 @@ int CmdStereoProfileName(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--flags") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --flags\n");
+        Printf("Missing value for --flags\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &flags)) {
-        std::printf("Invalid flags: %s\n", argv[i + 1]);
+        Printf("Invalid flags: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
   if (!name) {
-    std::printf("Missing required --name.\n");
+    Printf("Missing required --name.\n");
     return 1;
   }
   StereoContext ctx;
@@ -2356,17 +2360,15 @@ int CmdStereoDiag() {
   diag.pKMDData = &kmd;
   diag.pUMDData = nullptr;
 
-  NvAPI_Status status = NvAPI_Stereo_GetStereoDiag(ctx.handle, &diag);
+  NvAPI_Status status = NvApi().NvAPI_Stereo_GetStereoDiag(ctx.handle, &diag);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Stereo_GetStereoDiag failed", status);
     ctx.Cleanup();
     return 1;
   }
 
-  std::printf("Stereo diag: dongleActiveCount=%u\n", kmd.ulDongleActiveCount);
-  for (NvU32 i = 0; i < NV_MAX_HEADS; ++i) {
-    std::printf("  head[%u] stereoConfig=0x%08X\n", i, kmd.ulStereoConfig[i]);
-  }
+  Printf("Stereo diag: dongleActiveCount=%u\n", kmd.ulDongleActiveCount);
+  for (NvU32 i = 0; i < NV_MAX_HEADS; ++i) { Printf("  head[%u] stereoConfig=0x%08X\n", i, kmd.ulStereoConfig[i]); }
   ctx.Cleanup();
   return 0;
 }
@@ -2407,7 +2409,7 @@ bool ParseShaderType(const char *text, ShaderType *out) {
 }
 int CmdStereoShader(int argc, char **argv) {
   if (argc < 1) {
-    std::printf("Missing shader command.\n");
+    Printf("Missing shader command.\n");
     return 1;
   }
   bool isSet = false;
@@ -2416,7 +2418,7 @@ int CmdStereoShader(int argc, char **argv) {
   } else if (std::strcmp(argv[0], "get") == 0) {
     isSet = false;
   } else {
-    std::printf("Unknown shader command: %s\n", argv[0]);
+    Printf("Unknown shader command: %s\n", argv[0]);
     return 1;
   }
 
@@ -2435,11 +2437,11 @@ int CmdStereoShader(int argc, char **argv) {
   for (int i = 1; i < argc; ++i) {
     if (std::strcmp(argv[i], "--stage") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --stage\n");
+        Printf("Missing value for --stage\n");
         return 1;
       }
       if (!ParseShaderStage(argv[i + 1], &stage)) {
-        std::printf("Invalid stage: %s\n", argv[i + 1]);
+        Printf("Invalid stage: %s\n", argv[i + 1]);
         return 1;
       }
       hasStage = true;
@@ -2448,11 +2450,11 @@ int CmdStereoShader(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--type") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --type\n");
+        Printf("Missing value for --type\n");
         return 1;
       }
       if (!ParseShaderType(argv[i + 1], &type)) {
-        std::printf("Invalid type: %s\n", argv[i + 1]);
+        Printf("Invalid type: %s\n", argv[i + 1]);
         return 1;
       }
       hasType = true;
@@ -2461,11 +2463,11 @@ int CmdStereoShader(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--start") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --start\n");
+        Printf("Missing value for --start\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &startReg)) {
-        std::printf("Invalid start: %s\n", argv[i + 1]);
+        Printf("Invalid start: %s\n", argv[i + 1]);
         return 1;
       }
       hasStart = true;
@@ -2474,11 +2476,11 @@ int CmdStereoShader(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--count") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --count\n");
+        Printf("Missing value for --count\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &count)) {
-        std::printf("Invalid count: %s\n", argv[i + 1]);
+        Printf("Invalid count: %s\n", argv[i + 1]);
         return 1;
       }
       hasCount = true;
@@ -2487,7 +2489,7 @@ int CmdStereoShader(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--mono") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --mono\n");
+        Printf("Missing value for --mono\n");
         return 1;
       }
       monoPath = argv[i + 1];
@@ -2496,7 +2498,7 @@ int CmdStereoShader(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--left") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --left\n");
+        Printf("Missing value for --left\n");
         return 1;
       }
       leftPath = argv[i + 1];
@@ -2505,27 +2507,27 @@ int CmdStereoShader(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--right") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --right\n");
+        Printf("Missing value for --right\n");
         return 1;
       }
       rightPath = argv[i + 1];
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!hasStage || !hasType || !hasStart || !hasCount) {
-    std::printf("Missing required --stage, --type, --start, or --count.\n");
+    Printf("Missing required --stage, --type, --start, or --count.\n");
     return 1;
   }
   if (isSet && (!monoPath || !leftPath || !rightPath)) {
-    std::printf("Missing required --mono/--left/--right files for set.\n");
+    Printf("Missing required --mono/--left/--right files for set.\n");
     return 1;
   }
   if (!isSet && (!monoPath || !leftPath || !rightPath)) {
-    std::printf("Missing required --mono/--left/--right output files for get.\n");
+    Printf("Missing required --mono/--left/--right output files for get.\n");
     return 1;
   }
   size_t elementCount = (type == ShaderType::Bool) ? count : static_cast<size_t>(count) * 4;
@@ -2692,7 +2694,7 @@ int CmdStereo(int argc, char **argv) {
   if (std::strcmp(argv[0], "surface") == 0) { return CmdStereoSurface(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "debug") == 0) {
     if (argc > 1 && std::strcmp(argv[1], "last-draw") == 0) { return CmdStereoDebugLastDraw(); }
-    std::printf("Unknown debug command.\n");
+    Printf("Unknown debug command.\n");
     return 1;
   }
   if (std::strcmp(argv[0], "force-to-screen") == 0) { return CmdStereoForceToScreen(argc - 1, argv + 1); }
@@ -2705,7 +2707,7 @@ int CmdStereo(int argc, char **argv) {
   if (std::strcmp(argv[0], "diag") == 0) { return CmdStereoDiag(); }
   if (std::strcmp(argv[0], "shader") == 0) { return CmdStereoShader(argc - 1, argv + 1); }
 
-  std::printf("Unknown stereo command: %s\n", argv[0]);
+  Printf("Unknown stereo command: %s\n", argv[0]);
   PrintStereoUsage();
   return 1;
 }
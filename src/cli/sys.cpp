@@ -17,7 +17,7 @@ static bool ParseSysSmpArgs(int argc, char **argv, bool *useDefault) {
       *useDefault = true;
       continue;
     }
-    std::printf("Unknown sys smp option: %s\n", argv[i]);
+    Printf("Unknown sys smp option: %s\n", argv[i]);
     return false;
   }
   return true;
@@ -26,43 +26,43 @@ static bool ParseSysSmpArgs(int argc, char **argv, bool *useDefault) {
 static int CmdSysGpuCount() {
   NV_GPU_COUNT_DATA data = {};
   data.version = NV_GPU_COUNT_DATA_VER;
-  NvAPI_Status status = NvAPI_SYS_GetGpuCount(&data);
+  NvAPI_Status status = NvApi().NvAPI_SYS_GetGpuCount(&data);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_SYS_GetGpuCount failed", status);
     return 1;
   }
-  std::printf("GPU count:\n");
-  std::printf("  fromBus=%u\n", data.gpuCountFromBus);
-  std::printf("  active=%u\n", data.activeGpuCount);
+  Printf("GPU count:\n");
+  Printf("  fromBus=%u\n", data.gpuCountFromBus);
+  Printf("  active=%u\n", data.activeGpuCount);
   return 0;
 }
 
 static int CmdSysSmpInfo(int argc, char **argv) {
   bool useDefault = false;
   if (!ParseSysSmpArgs(argc, argv, &useDefault)) {
-    std::printf("Usage: %s sys smp [--default]\n", kToolName);
+    Printf("Usage: %s sys smp [--default]\n", kToolName);
     return 1;
   }
   NV_SMP_INFO info = {};
   info.version = NV_SMP_INFO_VER;
   info.bDefault = useDefault ? 1u : 0u;
-  NvAPI_Status status = NvAPI_SYS_GetSMPInfo(&info);
+  NvAPI_Status status = NvApi().NvAPI_SYS_GetSMPInfo(&info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_SYS_GetSMPInfo failed", status);
     return 1;
   }
-  std::printf("SMP info:\n");
-  std::printf("  tilt=%.3f\n", info.tilt);
-  std::printf("  verticalFOV=%.3f\n", info.verticalFOV);
-  std::printf("  cameraMode=%u\n", info.cameraMode);
-  std::printf("  default=%u\n", info.bDefault);
+  Printf("SMP info:\n");
+  Printf("  tilt=%.3f\n", info.tilt);
+  Printf("  verticalFOV=%.3f\n", info.verticalFOV);
+  Printf("  cameraMode=%u\n", info.cameraMode);
+  Printf("  default=%u\n", info.bDefault);
   return 0;
 }
 
 static int CmdSysChipsetSliBondInfo() {
   NV_CHIPSET_SLI_BOND_INFO info = {};
   info.version = NV_CHIPSET_SLI_BOND_INFO_VER;
-  NvAPI_Status status = NvAPI_SYS_GetChipSetSliBondInfo(&info);
+  NvAPI_Status status = NvApi().NvAPI_SYS_GetChipSetSliBondInfo(&info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_SYS_GetChipSetSliBondInfo failed", status);
     return 1;
@@ -71,12 +71,12 @@ static int CmdSysChipsetSliBondInfo() {
   for (; len < sizeof(info.szSliBondName); ++len) {
     if (info.szSliBondName[len] == '\0') { break; }
   }
-  std::printf("Chipset SLI bond:\n");
-  std::printf("  bondId=%u\n", info.sliBondId);
+  Printf("Chipset SLI bond:\n");
+  Printf("  bondId=%u\n", info.sliBondId);
   if (len == 0) {
-    std::printf("  name=<empty>\n");
+    Printf("  name=<empty>\n");
   } else {
-    std::printf("  name=%.*s\n", static_cast<int>(len), info.szSliBondName);
+    Printf("  name=%.*s\n", static_cast<int>(len), info.szSliBondName);
   }
   return 0;
 }
@@ -96,7 +96,7 @@ int CmdSys(int argc, char **argv) {
   if (std::strcmp(argv[0], "gpu-count") == 0) { return CmdSysGpuCount(); }
   if (std::strcmp(argv[0], "smp") == 0) { return CmdSysSmpInfo(argc - 1, argv + 1); }
   if (std::strcmp(argv[0], "chipset-sli") == 0) { return CmdSysChipsetSliBondInfo(); }
-  std::printf("Unknown sys command: %s\n", argv[0]);
+  Printf("Unknown sys command: %s\n", argv[0]);
   PrintSysUsage();
   return 1;
 }
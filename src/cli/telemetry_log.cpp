@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/telemetry_log.h"
+#include "cli/common.h"
+
+#include <io.h>
+
+namespace nvcli {
+namespace {
+// File layout (little endian):
+//   header:  "NVTLOG01", u32 column count, per column u16 name length + name bytes
+//   block:   u32 kBlockMagic, u32 rows, u64 first us, u64 last us, u32 payload size,
+//            u32 offsets[column count + 1] into the payload (timestamps first), payload
+//   index:   per block u64 offset, u64 first us, u64 last us, u32 rows
+//   trailer: u64 index offset, u32 block count, "NVTLIDX1"
+// Every column in the payload is a u8 flag (0 = all rows present, 1 = bitmap follows), the bitmap, then zigzag varint
+// deltas of the present values. Timestamps are always present.
+constexpr char kLogMagic[8] = {'N', 'V', 'T', 'L', 'O', 'G', '0', '1'};
+constexpr char kIndexMagic[8] = {'N', 'V', 'T', 'L', 'I', 'D', 'X', '1'};
+constexpr NvU32 kBlockMagic = 0x4B4C4254; // "TBLK"
+constexpr size_t kBlockHeaderSize = 4 + 4 + 8 + 8 + 4;
+constexpr size_t kIndexEntrySize = 8 + 8 + 8 + 4;
+constexpr size_t kTrailerSize = 8 + 4 + 8;
+constexpr NvU32 kMaxColumns = 4096;
+
+void PutU32(std::vector<NvU8> &out, NvU32 value) {
+  for (int i = 0; i < 4; ++i) { out.push_back(static_cast<NvU8>(value >> (8 * i))); }
+}
+
+void PutU64(std::vector<NvU8> &out, NvU64 value) {
+  for (int i = 0; i < 8; ++i) { out.push_back(static_cast<NvU8>(value >> (8 * i))); }
+}
+
+NvU32 GetU32(const NvU8 *data) {
+  return static_cast<NvU32>(data[0]) | (static_cast<NvU32>(data[1]) << 8) | (static_cast<NvU32>(data[2]) << 16) |
+         (static_cast<NvU32>(data[3]) << 24);
+}
+
+NvU64 GetU64(const NvU8 *data) {
+  return static_cast<NvU64>(GetU32(data)) | (static_cast<NvU64>(GetU32(data + 4)) << 32);
+}
+
+void PutVarint(std::vector<NvU8> &out, NvU64 value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<NvU8>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<NvU8>(value));
+}
+
+bool GetVarint(const NvU8 *&data, const NvU8 *end, NvU64 *value) {
+  NvU64 result = 0;
+  for (int shift = 0; shift < 64 && data < end; shift += 7) {
+    const NvU8 byte = *data++;
+    result |= static_cast<NvU64>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+NvU64 ZigZag(NvS64 value) { return (static_cast<NvU64>(value) << 1) ^ static_cast<NvU64>(value >> 63); }
+
+NvS64 UnZigZag(NvU64 value) { return static_cast<NvS64>(value >> 1) ^ -static_cast<NvS64>(value & 1); }
+
+bool WriteAll(FILE *file, const std::vector<NvU8> &data) {
+  return data.empty() || std::fwrite(data.data(), 1, data.size(), file) == data.size();
+}
+
+bool ReadAt(FILE *file, NvU64 offset, void *data, size_t size) {
+  if (_fseeki64(file, static_cast<long long>(offset), SEEK_SET) != 0) { return false; }
+  return std::fread(data, 1, size, file) == size;
+}
+
+NvU64 FileSize(FILE *file) {
+  if (_fseeki64(file, 0, SEEK_END) != 0) { return 0; }
+  const long long size = _ftelli64(file);
+  return size > 0 ? static_cast<NvU64>(size) : 0;
+}
+
+bool DecodeColumn(const NvU8 *data, const NvU8 *end, NvU32 rows, NvS64 *values, NvU8 *present, size_t stride) {
+  if (data >= end) { return false; }
+  const NvU8 flag = *data++;
+  const NvU8 *bitmap = nullptr;
+  if (flag == 1) {
+    if (static_cast<size_t>(end - data) < (rows + 7) / 8) { return false; }
+    bitmap = data;
+    data += (rows + 7) / 8;
+  } else if (flag != 0) {
+    return false;
+  }
+  NvS64 previous = 0;
+  for (NvU32 row = 0; row < rows; ++row) {
+    const bool has = !bitmap || (bitmap[row / 8] & (1u << (row % 8))) != 0;
+    present[row * stride] = has ? 1 : 0;
+    values[row * stride] = 0;
+    if (!has) { continue; }
+    NvU64 encoded = 0;
+    if (!GetVarint(data, end, &encoded)) { return false; }
+    previous += UnZigZag(encoded);
+    values[row * stride] = previous;
+  }
+  return true;
+}
+} // namespace
+
+bool TelemetryLogWriter::Open(const char *path, const std::vector<std::string> &columns) {
+  Close();
+  m_failed = false;
+  m_blocks.clear();
+  m_columnCount = columns.size();
+
+  NvU64 appendAt = 0;
+  {
+    TelemetryLogReader existing;
+    FILE *probe = nullptr;
+    const bool exists = fopen_s(&probe, path, "rb") == 0 && probe;
+    if (probe) { std::fclose(probe); }
+    if (exists) {
+      if (!existing.Open(path)) { return false; }
+      if (existing.columns() != columns) {
+        Printf("%s was written with different metrics, use a new log file.\n", path);
+        return false;
+      }
+      m_blocks = existing.blocks();
+      appendAt = existing.dataEnd();
+    }
+  }
+
+  if (appendAt == 0) {
+    if (fopen_s(&m_file, path, "wb") != 0 || !m_file) {
+      Printf("Failed to open %s\n", path);
+      m_file = nullptr;
+      return false;
+    }
+    std::vector<NvU8> header(kLogMagic, kLogMagic + sizeof(kLogMagic));
+    PutU32(header, static_cast<NvU32>(columns.size()));
+    for (const auto &name : columns) {
+      header.push_back(static_cast<NvU8>(name.size()));
+      header.push_back(static_cast<NvU8>(name.size() >> 8));
+      header.insert(header.end(), name.begin(), name.end());
+    }
+    if (!WriteAll(m_file, header)) {
+      Printf("Failed to write %s\n", path);
+      Close();
+      return false;
+    }
+  } else {
+    // Drop the index (and any torn block) behind the last complete block, it is rewritten on Close.
+    if (fopen_s(&m_file, path, "r+b") != 0 || !m_file) {
+      Printf("Failed to open %s\n", path);
+      m_file = nullptr;
+      return false;
+    }
+    if (_chsize_s(_fileno(m_file), static_cast<long long>(appendAt)) != 0 ||
+        _fseeki64(m_file, static_cast<long long>(appendAt), SEEK_SET) != 0) {
+      Printf("Failed to truncate %s\n", path);
+      Close();
+      return false;
+    }
+  }
+
+  m_timestamps.clear();
+  m_timestamps.reserve(kTelemetryRowsPerBlock);
+  m_values.assign(static_cast<size_t>(kTelemetryRowsPerBlock) * m_columnCount, 0);
+  m_present.assign(static_cast<size_t>(kTelemetryRowsPerBlock) * m_columnCount, 0);
+  return true;
+}
+
+void TelemetryLogWriter::BeginRow(NvU64 timestampUs) {
+  if (!m_file || m_failed) { return; }
+  const size_t row = m_timestamps.size();
+  m_timestamps.push_back(timestampUs);
+  std::memset(&m_present[row * m_columnCount], 0, m_columnCount);
+}
+
+void TelemetryLogWriter::Set(size_t column, NvS64 value) {
+  if (!m_file || m_failed || m_timestamps.empty() || column >= m_columnCount) { return; }
+  const size_t slot = (m_timestamps.size() - 1) * m_columnCount + column;
+  m_values[slot] = value;
+  m_present[slot] = 1;
+}
+
+void TelemetryLogWriter::EndRow() {
+  if (m_file && m_timestamps.size() >= kTelemetryRowsPerBlock) { FlushBlock(); }
+}
+
+bool TelemetryLogWriter::FlushBlock() {
+  const NvU32 rows = static_cast<NvU32>(m_timestamps.size());
+  if (rows == 0 || m_failed) { return !m_failed; }
+
+  std::vector<NvU8> payload;
+  std::vector<NvU32> offsets;
+  offsets.push_back(0);
+  payload.push_back(0);
+  NvS64 previous = 0;
+  for (NvU64 timestamp : m_timestamps) {
+    PutVarint(payload, ZigZag(static_cast<NvS64>(timestamp) - previous));
+    previous = static_cast<NvS64>(timestamp);
+  }
+
+  for (size_t column = 0; column < m_columnCount; ++column) {
+    offsets.push_back(static_cast<NvU32>(payload.size()));
+    bool all = true;
+    for (NvU32 row = 0; row < rows && all; ++row) { all = m_present[row * m_columnCount + column] != 0; }
+    payload.push_back(all ? 0 : 1);
+    if (!all) {
+      const size_t bitmap = payload.size();
+      payload.resize(bitmap + (rows + 7) / 8, 0);
+      for (NvU32 row = 0; row < rows; ++row) {
+        if (!m_present[row * m_columnCount + column]) { continue; }
+        payload[bitmap + row / 8] |= static_cast<NvU8>(1u << (row % 8));
+      }
+    }
+    previous = 0;
+    for (NvU32 row = 0; row < rows; ++row) {
+      const size_t slot = row * m_columnCount + column;
+      if (!m_present[slot]) { continue; }
+      PutVarint(payload, ZigZag(m_values[slot] - previous));
+      previous = m_values[slot];
+    }
+  }
+
+  TelemetryBlockInfo info = {};
+  info.offset = static_cast<NvU64>(_ftelli64(m_file));
+  info.firstUs = m_timestamps.front();
+  info.lastUs = m_timestamps.back();
+  info.rows = rows;
+
+  std::vector<NvU8> header;
+  PutU32(header, kBlockMagic);
+  PutU32(header, rows);
+  PutU64(header, info.firstUs);
+  PutU64(header, info.lastUs);
+  PutU32(header, static_cast<NvU32>(payload.size()));
+  for (NvU32 offset : offsets) { PutU32(header, offset); }
+  if (!WriteAll(m_file, header) || !WriteAll(m_file, payload) || std::fflush(m_file) != 0) {
+    Printf("Failed to write telemetry log block.\n");
+    m_failed = true;
+    m_timestamps.clear();
+    return false;
+  }
+  m_blocks.push_back(info);
+  m_timestamps.clear();
+  return true;
+}
+
+bool TelemetryLogWriter::Close() {
+  if (!m_file) { return true; }
+  bool ok = FlushBlock();
+  if (ok) {
+    std::vector<NvU8> index;
+    const NvU64 indexOffset = static_cast<NvU64>(_ftelli64(m_file));
+    for (const auto &block : m_blocks) {
+      PutU64(index, block.offset);
+      PutU64(index, block.firstUs);
+      PutU64(index, block.lastUs);
+      PutU32(index, block.rows);
+    }
+    PutU64(index, indexOffset);
+    PutU32(index, static_cast<NvU32>(m_blocks.size()));
+    index.insert(index.end(), kIndexMagic, kIndexMagic + sizeof(kIndexMagic));
+    ok = WriteAll(m_file, index);
+  }
+  ok = std::fclose(m_file) == 0 && ok;
+  m_file = nullptr;
+  if (!ok) { Printf("Failed to finish telemetry log.\n"); }
+  return ok;
+}
+
+TelemetryLogReader::~TelemetryLogReader() {
+  if (m_file) { std::fclose(m_file); }
+}
+
+bool TelemetryLogReader::Open(const char *path) {
+  if (fopen_s(&m_file, path, "rb") != 0 || !m_file) {
+    Printf("Failed to open %s\n", path);
+    m_file = nullptr;
+    return false;
+  }
+  if (!ReadHeader()) {
+    Printf("%s is not a telemetry log.\n", path);
+    return false;
+  }
+  const NvU64 fileSize = FileSize(m_file);
+  m_indexed = ReadIndex(fileSize);
+  if (!m_indexed && !ScanBlocks(fileSize)) {
+    Printf("%s has a damaged block table.\n", path);
+    return false;
+  }
+  return true;
+}
+
+bool TelemetryLogReader::ReadHeader() {
+  NvU8 fixed[sizeof(kLogMagic) + 4];
+  if (!ReadAt(m_file, 0, fixed, sizeof(fixed)) || std::memcmp(fixed, kLogMagic, sizeof(kLogMagic)) != 0) {
+    return false;
+  }
+  const NvU32 count = GetU32(fixed + sizeof(kLogMagic));
+  if (count > kMaxColumns) { return false; }
+  m_columns.clear();
+  for (NvU32 i = 0; i < count; ++i) {
+    NvU8 length[2];
+    if (std::fread(length, 1, sizeof(length), m_file) != sizeof(length)) { return false; }
+    std::string name(static_cast<size_t>(length[0] | (length[1] << 8)), '\0');
+    if (!name.empty() && std::fread(&name[0], 1, name.size(), m_file) != name.size()) { return false; }
+    m_columns.push_back(std::move(name));
+  }
+  m_headerSize = static_cast<NvU64>(_ftelli64(m_file));
+  return true;
+}
+
+bool TelemetryLogReader::ReadIndex(NvU64 fileSize) {
+  if (fileSize < m_headerSize + kTrailerSize) { return false; }
+  NvU8 trailer[kTrailerSize];
+  if (!ReadAt(m_file, fileSize - kTrailerSize, trailer, sizeof(trailer)) ||
+      std::memcmp(trailer + 12, kIndexMagic, sizeof(kIndexMagic)) != 0) {
+    return false;
+  }
+  const NvU64 indexOffset = GetU64(trailer);
+  const NvU32 count = GetU32(trailer + 8);
+  const NvU64 indexSize = static_cast<NvU64>(count) * kIndexEntrySize;
+  if (indexOffset < m_headerSize || indexOffset + indexSize + kTrailerSize != fileSize) {
+    return false;
+  }
+  std::vector<NvU8> index(static_cast<size_t>(count) * kIndexEntrySize);
+  if (!index.empty() && !ReadAt(m_file, indexOffset, index.data(), index.size())) { return false; }
+  m_blocks.clear();
+  for (NvU32 i = 0; i < count; ++i) {
+    const NvU8 *entry = index.data() + static_cast<size_t>(i) * kIndexEntrySize;
+    m_blocks.push_back({GetU64(entry), GetU64(entry + 8), GetU64(entry + 16), GetU32(entry + 24)});
+  }
+  m_dataEnd = indexOffset;
+  return true;
+}
+
+// Without an index (the writer did not get to Close) the block headers are walked, a trailing torn block is ignored.
+bool TelemetryLogReader::ScanBlocks(NvU64 fileSize) {
+  m_blocks.clear();
+  const NvU64 directory = (static_cast<NvU64>(m_columns.size()) + 1) * 4;
+  NvU64 offset = m_headerSize;
+  while (offset + kBlockHeaderSize + directory <= fileSize) {
+    NvU8 header[kBlockHeaderSize];
+    if (!ReadAt(m_file, offset, header, sizeof(header)) || GetU32(header) != kBlockMagic) { break; }
+    const NvU64 end = offset + kBlockHeaderSize + directory + GetU32(header + 24);
+    if (end > fileSize) { break; }
+    m_blocks.push_back({offset, GetU64(header + 8), GetU64(header + 16), GetU32(header + 4)});
+    offset = end;
+  }
+  m_dataEnd = offset;
+  return true;
+}
+
+size_t TelemetryLogReader::FindBlock(NvU64 timestampUs) const {
+  auto it = std::lower_bound(m_blocks.begin(), m_blocks.end(), timestampUs,
+                             [](const TelemetryBlockInfo &block, NvU64 value) { return block.lastUs < value; });
+  return static_cast<size_t>(it - m_blocks.begin());
+}
+
+bool TelemetryLogReader::ReadBlock(size_t block, const std::vector<size_t> &wanted, std::vector<NvU64> *timestamps,
+                                   std::vector<NvS64> *values, std::vector<NvU8> *present) {
+  if (block >= m_blocks.size()) { return false; }
+  const TelemetryBlockInfo &info = m_blocks[block];
+  NvU8 header[kBlockHeaderSize];
+  if (!ReadAt(m_file, info.offset, header, sizeof(header)) || GetU32(header) != kBlockMagic) { return false; }
+  const NvU32 rows = GetU32(header + 4);
+  const NvU32 payloadSize = GetU32(header + 24);
+  std::vector<NvU8> directory((m_columns.size() + 1) * 4);
+  if (std::fread(directory.data(), 1, directory.size(), m_file) != directory.size()) { return false; }
+  const NvU64 payloadOffset = info.offset + kBlockHeaderSize + directory.size();
+  auto columnRange = [&](size_t slot, NvU32 *begin, NvU32 *end) {
+    *begin = GetU32(directory.data() + slot * 4);
+    *end = slot + 1 <= m_columns.size() ? GetU32(directory.data() + (slot + 1) * 4) : payloadSize;
+    return *begin <= *end && *end <= payloadSize;
+  };
+
+  // Only the timestamp column and the wanted columns are read from disk.
+  std::vector<NvU8> data;
+  NvU32 begin = 0;
+  NvU32 end = 0;
+  if (!columnRange(0, &begin, &end)) { return false; }
+  data.resize(end - begin);
+  if (!data.empty() && !ReadAt(m_file, payloadOffset + begin, data.data(), data.size())) { return false; }
+  std::vector<NvS64> times(rows);
+  std::vector<NvU8> timesPresent(rows);
+  if (!DecodeColumn(data.data(), data.data() + data.size(), rows, times.data(), timesPresent.data(), 1)) {
+    return false;
+  }
+  timestamps->assign(times.begin(), times.end());
+
+  values->assign(static_cast<size_t>(rows) * wanted.size(), 0);
+  present->assign(static_cast<size_t>(rows) * wanted.size(), 0);
+  for (size_t i = 0; i < wanted.size(); ++i) {
+    if (wanted[i] >= m_columns.size() || !columnRange(wanted[i] + 1, &begin, &end)) { return false; }
+    data.resize(end - begin);
+    if (!data.empty() && !ReadAt(m_file, payloadOffset + begin, data.data(), data.size())) { return false; }
+    if (!DecodeColumn(data.data(), data.data() + data.size(), rows, values->data() + i, present->data() + i,
+                      wanted.size())) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace nvcli
@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/timing_calc.h"
+#include "cli/common.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace nvcli {
+namespace {
+// CVT 1.2 and GTF default parameters, times in microseconds and clocks in MHz.
+constexpr double kCvtMinVsyncBp = 550.0;
+constexpr double kCvtMinVPorch = 3.0;
+constexpr double kCvtMinVBackPorch = 6.0;
+constexpr double kCvtCPrime = 30.0;
+constexpr double kCvtMPrime = 300.0;
+constexpr double kCvtHSyncPercent = 8.0;
+constexpr double kCvtClockStep = 0.25;
+constexpr NvU32 kCvtCellGran = 8;
+constexpr double kRbMinVBlank = 460.0;
+constexpr NvU32 kRbHBlank = 160;
+constexpr NvU32 kRbHSync = 32;
+constexpr NvU32 kRb2HBlank = 80;
+constexpr NvU32 kRb2HSync = 32;
+constexpr NvU32 kRb2HFrontPorch = 8;
+constexpr NvU32 kRb2VSync = 8;
+constexpr double kRb2MinVPorch = 1.0;
+constexpr double kRb2ClockStep = 0.001;
+constexpr double kGtfMinPorch = 1.0;
+constexpr double kGtfVSync = 3.0;
+// HDMI 2.1 FRL packs 16 bits into 18 and loses a few percent more to RS FEC and packet overhead, 3% is used here.
+constexpr NvU64 kFrlOverheadPercent = 3;
+
+// CVT sync width encodes the aspect ratio, 10 lines for anything non-standard.
+NvU32 CvtVSyncLines(NvU32 width, NvU32 height) {
+  if (height % 3 == 0 && height * 4 / 3 == width) { return 4; }
+  if (height % 9 == 0 && height * 16 / 9 == width) { return 5; }
+  if (height % 10 == 0 && height * 16 / 10 == width) { return 6; }
+  if (height % 4 == 0 && height * 5 / 4 == width) { return 7; }
+  if (height % 9 == 0 && height * 15 / 9 == width) { return 7; }
+  return 10;
+}
+
+NvU32 Gcd(NvU32 a, NvU32 b) {
+  while (b != 0) {
+    const NvU32 t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+// Field timing shared by every formula before it is written to NV_TIMING.
+struct FieldTiming {
+  NvU32 hActive;
+  NvU32 hFrontPorch;
+  NvU32 hSync;
+  NvU32 hTotal;
+  NvU32 vActive;
+  NvU32 vFrontPorch;
+  NvU32 vSync;
+  // Lines per field without the half line of interlaced modes.
+  NvU32 vTotal;
+  double pixelClockMhz;
+  bool hSyncPositive;
+  bool vSyncPositive;
+};
+
+bool ComputeCvt(NvU32 width, NvU32 height, double fieldRate, bool interlaced, FieldTiming *out) {
+  const double interlace = interlaced ? 0.5 : 0.0;
+  const NvU32 hActive = width / kCvtCellGran * kCvtCellGran;
+  const NvU32 vLines = interlaced ? height / 2 : height;
+  const NvU32 vSync = CvtVSyncLines(hActive, height);
+  const double hPeriod = (1000000.0 / fieldRate - kCvtMinVsyncBp) / (vLines + kCvtMinVPorch + interlace);
+  if (hPeriod <= 0.0) { return false; }
+
+  NvU32 vSyncBp = static_cast<NvU32>(kCvtMinVsyncBp / hPeriod) + 1;
+  if (vSyncBp < vSync + kCvtMinVBackPorch) { vSyncBp = vSync + static_cast<NvU32>(kCvtMinVBackPorch); }
+
+  double dutyCycle = kCvtCPrime - kCvtMPrime * hPeriod / 1000.0;
+  if (dutyCycle < 20.0) { dutyCycle = 20.0; }
+  const NvU32 hBlank = static_cast<NvU32>(hActive * dutyCycle / (100.0 - dutyCycle) / (2 * kCvtCellGran)) *
+                       (2 * kCvtCellGran);
+  const NvU32 hTotal = hActive + hBlank;
+  const NvU32 hSync = static_cast<NvU32>(kCvtHSyncPercent / 100.0 * hTotal / kCvtCellGran) * kCvtCellGran;
+
+  out->hActive = hActive;
+  out->hSync = hSync;
+  out->hFrontPorch = hBlank - hSync - hBlank / 2;
+  out->hTotal = hTotal;
+  out->vActive = vLines;
+  out->vFrontPorch = static_cast<NvU32>(kCvtMinVPorch);
+  out->vSync = vSync;
+  out->vTotal = vLines + vSyncBp + static_cast<NvU32>(kCvtMinVPorch);
+  out->pixelClockMhz = kCvtClockStep * std::floor(hTotal / hPeriod / kCvtClockStep);
+  out->hSyncPositive = false;
+  out->vSyncPositive = true;
+  return true;
+}
+
+bool ComputeCvtReduced(NvU32 width, NvU32 height, double fieldRate, bool interlaced, bool v2, FieldTiming *out) {
+  const double interlace = interlaced ? 0.5 : 0.0;
+  const NvU32 hActive = v2 ? width : width / kCvtCellGran * kCvtCellGran;
+  const NvU32 vLines = interlaced ? height / 2 : height;
+  const NvU32 vSync = v2 ? kRb2VSync : CvtVSyncLines(hActive, height);
+  const double vPorch = v2 ? kRb2MinVPorch : kCvtMinVPorch;
+  const double hPeriod = (1000000.0 / fieldRate - kRbMinVBlank) / vLines;
+  if (hPeriod <= 0.0) { return false; }
+
+  NvU32 vbiLines = static_cast<NvU32>(kRbMinVBlank / hPeriod) + 1;
+  const NvU32 minVbi = static_cast<NvU32>(vPorch + kCvtMinVBackPorch) + vSync;
+  if (vbiLines < minVbi) { vbiLines = minVbi; }
+
+  const NvU32 hTotal = hActive + (v2 ? kRb2HBlank : kRbHBlank);
+  const double totalLines = vLines + vbiLines + interlace;
+  const double step = v2 ? kRb2ClockStep : kCvtClockStep;
+
+  out->hActive = hActive;
+  out->hSync = v2 ? kRb2HSync : kRbHSync;
+  out->hFrontPorch = v2 ? kRb2HFrontPorch : 48;
+  out->hTotal = hTotal;
+  out->vActive = vLines;
+  // RB v2 fixes the back porch at 6 lines and gives the rest of the blanking to the front porch.
+  out->vFrontPorch = v2 ? vbiLines - vSync - static_cast<NvU32>(kCvtMinVBackPorch) : static_cast<NvU32>(vPorch);
+  out->vSync = vSync;
+  out->vTotal = vLines + vbiLines;
+  out->pixelClockMhz = step * std::floor(fieldRate * totalLines * hTotal / 1000000.0 / step);
+  out->hSyncPositive = true;
+  out->vSyncPositive = false;
+  return true;
+}
+
+bool ComputeGtf(NvU32 width, NvU32 height, double fieldRate, bool interlaced, FieldTiming *out) {
+  const double interlace = interlaced ? 0.5 : 0.0;
+  const NvU32 hActive = static_cast<NvU32>(std::lround(static_cast<double>(width) / kCvtCellGran)) * kCvtCellGran;
+  const NvU32 vLines = interlaced ? static_cast<NvU32>(std::lround(height / 2.0)) : height;
+  const double hPeriodEst =
+      (1.0 / fieldRate - kCvtMinVsyncBp / 1000000.0) / (vLines + kGtfMinPorch + interlace) * 1000000.0;
+  if (hPeriodEst <= 0.0) { return false; }
+
+  const NvU32 vSyncBp = static_cast<NvU32>(std::lround(kCvtMinVsyncBp / hPeriodEst));
+  if (vSyncBp <= kGtfVSync) { return false; }
+  const double totalLines = vLines + vSyncBp + interlace + kGtfMinPorch;
+  const double fieldRateEst = 1.0 / hPeriodEst / totalLines * 1000000.0;
+  const double hPeriod = hPeriodEst / (fieldRate / fieldRateEst);
+
+  const double dutyCycle = kCvtCPrime - kCvtMPrime * hPeriod / 1000.0;
+  if (dutyCycle <= 0.0 || dutyCycle >= 100.0) { return false; }
+  const NvU32 hBlank =
+      static_cast<NvU32>(std::lround(hActive * dutyCycle / (100.0 - dutyCycle) / (2 * kCvtCellGran))) *
+      (2 * kCvtCellGran);
+  const NvU32 hTotal = hActive + hBlank;
+  const NvU32 hSync =
+      static_cast<NvU32>(std::lround(kCvtHSyncPercent / 100.0 * hTotal / kCvtCellGran)) * kCvtCellGran;
+  if (hSync >= hBlank / 2) { return false; }
+
+  out->hActive = hActive;
+  out->hSync = hSync;
+  out->hFrontPorch = hBlank / 2 - hSync;
+  out->hTotal = hTotal;
+  out->vActive = vLines;
+  out->vFrontPorch = static_cast<NvU32>(kGtfMinPorch);
+  out->vSync = static_cast<NvU32>(kGtfVSync);
+  out->vTotal = vLines + vSyncBp + static_cast<NvU32>(kGtfMinPorch);
+  out->pixelClockMhz = hTotal / hPeriod;
+  out->hSyncPositive = false;
+  out->vSyncPositive = true;
+  return true;
+}
+
+double TimingFieldRateHz(const NV_TIMING &timing) {
+  if (timing.HTotal == 0 || timing.VTotal == 0) { return 0.0; }
+  const double frameRate = timing.pclk * 10000.0 / (static_cast<double>(timing.HTotal) * timing.VTotal);
+  return timing.interlaced ? frameRate * 2.0 : frameRate;
+}
+} // namespace
+
+const char *TimingFormulaName(TimingFormula formula) {
+  switch (formula) {
+  case kTimingCvt: return "cvt";
+  case kTimingCvtRb: return "cvt-rb";
+  case kTimingCvtRb2: return "cvt-rb2";
+  case kTimingGtf: return "gtf";
+  default: return "unknown";
+  }
+}
+
+bool ParseTimingFormula(const char *value, TimingFormula *out) {
+  if (!value || !out) { return false; }
+  for (NvU8 i = kTimingCvt; i <= kTimingGtf; ++i) {
+    if (std::strcmp(value, TimingFormulaName(static_cast<TimingFormula>(i))) == 0) {
+      *out = static_cast<TimingFormula>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ComputeTiming(TimingFormula formula, NvU32 width, NvU32 height, double refreshHz, bool interlaced,
+                   NV_TIMING *out) {
+  if (!out || width < 64 || height < 64 || width > 0xFFFF || height > 0xFFFF) { return false; }
+  if (!(refreshHz > 0.0) || refreshHz > 1000.0) { return false; }
+
+  const double fieldRate = interlaced ? refreshHz * 2.0 : refreshHz;
+  FieldTiming field = {};
+  bool ok = false;
+  switch (formula) {
+  case kTimingCvt: ok = ComputeCvt(width, height, fieldRate, interlaced, &field); break;
+  case kTimingCvtRb: ok = ComputeCvtReduced(width, height, fieldRate, interlaced, false, &field); break;
+  case kTimingCvtRb2: ok = ComputeCvtReduced(width, height, fieldRate, interlaced, true, &field); break;
+  case kTimingGtf: ok = ComputeGtf(width, height, fieldRate, interlaced, &field); break;
+  default: break;
+  }
+  if (!ok || field.pixelClockMhz <= 0.0) { return false; }
+
+  // A frame of an interlaced mode is two fields plus the extra half line.
+  const NvU32 frameActive = interlaced ? field.vActive * 2 : field.vActive;
+  const NvU32 frameTotal = interlaced ? field.vTotal * 2 + 1 : field.vTotal;
+  const NvU64 pclk = static_cast<NvU64>(std::llround(field.pixelClockMhz * 100.0));
+  if (field.hTotal > 0xFFFF || frameTotal > 0xFFFF || pclk > 0xFFFFFFFFull) { return false; }
+
+  std::memset(out, 0, sizeof(*out));
+  out->HVisible = static_cast<NvU16>(field.hActive);
+  out->HFrontPorch = static_cast<NvU16>(field.hFrontPorch);
+  out->HSyncWidth = static_cast<NvU16>(field.hSync);
+  out->HTotal = static_cast<NvU16>(field.hTotal);
+  out->HSyncPol = field.hSyncPositive ? NV_TIMING_H_SYNC_POSITIVE : NV_TIMING_H_SYNC_NEGATIVE;
+  out->VVisible = static_cast<NvU16>(frameActive);
+  out->VFrontPorch = static_cast<NvU16>(field.vFrontPorch);
+  out->VSyncWidth = static_cast<NvU16>(field.vSync);
+  out->VTotal = static_cast<NvU16>(frameTotal);
+  out->VSyncPol = field.vSyncPositive ? NV_TIMING_V_SYNC_POSITIVE : NV_TIMING_V_SYNC_NEGATIVE;
+  out->interlaced = interlaced ? NV_TIMING_INTERLACED : NV_TIMING_PROGRESSIVE;
+  out->pclk = static_cast<NvU32>(pclk);
+
+  const double actual = pclk * 10000.0 / (static_cast<double>(field.hTotal) * frameTotal);
+  const NvU32 divisor = Gcd(field.hActive, frameActive);
+  out->etc.rr = static_cast<NvU16>(std::lround(actual));
+  out->etc.rrx1k = static_cast<NvU32>(std::lround(actual * 1000.0));
+  out->etc.aspect = divisor ? ((field.hActive / divisor) << 16) | (frameActive / divisor) : 0;
+  out->etc.rep = 1;
+  out->etc.status = formula == kTimingGtf ? NV_TIMING_TYPE_GTF
+                    : formula == kTimingCvt ? NV_TIMING_TYPE_CVT
+                                            : NV_TIMING_TYPE_CVT_RB;
+  std::snprintf(reinterpret_cast<char *>(out->etc.name), sizeof(out->etc.name), "%s:%ux%ux%.3fHz%s",
+                TimingFormulaName(formula), field.hActive, frameActive, actual, interlaced ? "/i" : "");
+  return true;
+}
+
+bool ParseTimingModeSpec(const char *value, std::vector<TimingMode> *out) {
+  unsigned width = 0;
+  unsigned height = 0;
+  int consumed = 0;
+  if (std::sscanf(value, "%ux%u@%n", &width, &height, &consumed) != 2 || consumed == 0) { return false; }
+  const char *rate = value + consumed;
+  const char *dash = std::strchr(rate, '-');
+  if (!dash) {
+    double refresh = 0.0;
+    if (!ParseDoubleValue(rate, &refresh) || refresh <= 0.0) { return false; }
+    out->push_back(TimingMode{width, height, refresh});
+    return true;
+  }
+
+  double first = 0.0;
+  double last = 0.0;
+  double step = 0.0;
+  char extra = 0;
+  if (std::sscanf(rate, "%lf-%lf:%lf%c", &first, &last, &step, &extra) != 3) { return false; }
+  if (first <= 0.0 || last < first || step <= 0.0 || (last - first) / step > 100000.0) { return false; }
+  const NvU32 steps = static_cast<NvU32>(std::floor((last - first) / step + 1e-9));
+  for (NvU32 i = 0; i <= steps; ++i) { out->push_back(TimingMode{width, height, first + step * i}); }
+  return true;
+}
+
+bool ReadTimingModesFile(const char *path, std::vector<TimingMode> *out) {
+  FILE *file = nullptr;
+  if (fopen_s(&file, path, "r") != 0 || !file) {
+    Printf("Failed to open %s\n", path);
+    return false;
+  }
+  char line[256];
+  NvU32 lineNumber = 0;
+  bool ok = true;
+  while (ok && std::fgets(line, sizeof(line), file)) {
+    ++lineNumber;
+    char *start = line;
+    while (*start == ' ' || *start == '\t') { ++start; }
+    char *end = start + std::strlen(start);
+    while (end > start && (end[-1] == '\n' || end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t')) { *--end = '\0'; }
+    if (*start == '\0' || *start == '#') { continue; }
+    if (!ParseTimingModeSpec(start, out)) {
+      Printf("%s:%u: invalid mode %s\n", path, lineNumber, start);
+      ok = false;
+    }
+  }
+  std::fclose(file);
+  return ok;
+}
+
+bool ParseTimingLink(const char *value, TimingLimits *limits) {
+  if (!value || !limits) { return false; }
+  char kind[8] = {0};
+  double first = 0.0;
+  double second = 0.0;
+  char extra = 0;
+  const int fields = std::sscanf(value, "%7[a-z]:%lf:%lf%c", kind, &first, &second, &extra);
+  if (std::strcmp(kind, "tmds") == 0 && fields == 2 && first > 0.0) {
+    limits->link = kTimingLinkTmds;
+    limits->maxTmdsKhz = static_cast<NvU32>(std::lround(first * 1000.0));
+    return true;
+  }
+  // DP trains 1, 2 or 4 lanes, FRL runs 3 or 4.
+  const bool dp = std::strcmp(kind, "dp") == 0;
+  const NvU32 lanes = first >= 1.0 && first <= 4.0 ? static_cast<NvU32>(first) : 0;
+  const bool validLanes = dp ? lanes == 1 || lanes == 2 || lanes == 4 : lanes == 3 || lanes == 4;
+  if ((dp || std::strcmp(kind, "frl") == 0) && fields == 3 && validLanes && lanes == first && second > 0.0) {
+    limits->link = dp ? kTimingLinkDp : kTimingLinkFrl;
+    limits->lanes = lanes;
+    limits->laneMbps = static_cast<NvU32>(std::lround(second * 1000.0));
+    return true;
+  }
+  return false;
+}
+
+std::string DescribeTimingLink(const TimingLimits &limits) {
+  char text[48];
+  switch (limits.link) {
+  case kTimingLinkDp:
+  case kTimingLinkFrl:
+    std::snprintf(text, sizeof(text), "%s %ux%.2f Gbps", limits.link == kTimingLinkDp ? "DP" : "FRL", limits.lanes,
+                  limits.laneMbps / 1000.0);
+    break;
+  case kTimingLinkTmds: std::snprintf(text, sizeof(text), "TMDS %.2f MHz", limits.maxTmdsKhz / 1000.0); break;
+  default: std::snprintf(text, sizeof(text), "none"); break;
+  }
+  return text;
+}
+
+NvU64 TimingLinkLoad(const NV_TIMING &timing, NvU32 bpc, TimingLinkType link) {
+  const NvU64 pixelKhz = static_cast<NvU64>(timing.pclk) * 10;
+  // Deep color TMDS runs the character clock faster, 8 bpc and below run at the pixel clock.
+  if (link == kTimingLinkTmds) { return bpc > 8 ? pixelKhz * bpc / 8 : pixelKhz; }
+  return pixelKhz * bpc * 3;
+}
+
+NvU64 TimingLinkCapacity(const TimingLimits &limits) {
+  const NvU64 raw = static_cast<NvU64>(limits.lanes) * limits.laneMbps * 1000;
+  switch (limits.link) {
+  case kTimingLinkDp: return raw * 8 / 10;
+  case kTimingLinkFrl: return raw * 16 / 18 * (100 - kFrlOverheadPercent) / 100;
+  case kTimingLinkTmds: return limits.maxTmdsKhz;
+  default: return 0;
+  }
+}
+
+bool ValidateTiming(const NV_TIMING &timing, NvU32 bpc, const TimingLimits &limits,
+                    std::vector<std::string> *problems) {
+  const size_t before = problems->size();
+  char message[96];
+  const NvU64 pixelKhz = static_cast<NvU64>(timing.pclk) * 10;
+  if (limits.maxPixelClockKhz && pixelKhz > limits.maxPixelClockKhz) {
+    std::snprintf(message, sizeof(message), "pixel clock %.3f MHz above %.3f MHz", pixelKhz / 1000.0,
+                  limits.maxPixelClockKhz / 1000.0);
+    problems->push_back(message);
+  }
+
+  if (limits.hasRange) {
+    const double vHz = TimingFieldRateHz(timing);
+    const double hKhz = timing.HTotal ? static_cast<double>(pixelKhz) / timing.HTotal : 0.0;
+    if ((limits.minVHz && vHz < limits.minVHz) || (limits.maxVHz && vHz > limits.maxVHz)) {
+      std::snprintf(message, sizeof(message), "vertical %.3f Hz outside %u-%u Hz", vHz, limits.minVHz, limits.maxVHz);
+      problems->push_back(message);
+    }
+    if ((limits.minHKhz && hKhz < limits.minHKhz) || (limits.maxHKhz && hKhz > limits.maxHKhz)) {
+      std::snprintf(message, sizeof(message), "horizontal %.3f kHz outside %u-%u kHz", hKhz, limits.minHKhz,
+                    limits.maxHKhz);
+      problems->push_back(message);
+    }
+  }
+
+  const NvU64 capacity = TimingLinkCapacity(limits);
+  if (capacity) {
+    const NvU64 load = TimingLinkLoad(timing, bpc, limits.link);
+    if (load > capacity) {
+      if (limits.link == kTimingLinkTmds) {
+        std::snprintf(message, sizeof(message), "TMDS clock %.3f MHz at %u bpc above %.3f MHz", load / 1000.0, bpc,
+                      capacity / 1000.0);
+      } else {
+        std::snprintf(message, sizeof(message), "%.3f Gbps at %u bpc above %s (%.3f Gbps payload)", load / 1e6, bpc,
+                      DescribeTimingLink(limits).c_str(), capacity / 1e6);
+      }
+      problems->push_back(message);
+    }
+  }
+  return problems->size() == before;
+}
+} // namespace nvcli
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/topology.h"
+
+namespace nvcli {
+bool TopologyCache::LoadGpusLocked() {
+  if (m_gpusLoaded) { return true; }
+  NvPhysicalGpuHandle gpus[NVAPI_MAX_PHYSICAL_GPUS] = {};
+  NvU32 count = 0;
+  m_gpuStatus = NvApi().NvAPI_EnumPhysicalGPUs(gpus, &count);
+  if (m_gpuStatus != NVAPI_OK) { return false; }
+  m_gpus.assign(gpus, gpus + count);
+  m_gpuIndex.clear();
+  for (NvU32 i = 0; i < count; ++i) { m_gpuIndex.emplace(gpus[i], i); }
+  m_gpusLoaded = true;
+  return true;
+}
+
+bool TopologyCache::LoadLogicalGpusLocked() {
+  if (m_logicalLoaded) { return true; }
+  NvLogicalGpuHandle logical[NVAPI_MAX_LOGICAL_GPUS] = {};
+  NvU32 count = 0;
+  m_logicalStatus = NvApi().NvAPI_EnumLogicalGPUs(logical, &count);
+  if (m_logicalStatus != NVAPI_OK) { return false; }
+  m_logical.assign(count, TopologyLogicalGpu{});
+  for (NvU32 i = 0; i < count; ++i) {
+    TopologyLogicalGpu &entry = m_logical[i];
+    entry.handle = logical[i];
+    NvPhysicalGpuHandle physical[NVAPI_MAX_PHYSICAL_GPUS] = {};
+    NvU32 physicalCount = 0;
+    entry.status = NvApi().NvAPI_GetPhysicalGPUsFromLogicalGPU(logical[i], physical, &physicalCount);
+    if (entry.status == NVAPI_OK) { entry.physical.assign(physical, physical + physicalCount); }
+  }
+  m_logicalLoaded = true;
+  return true;
+}
+
+// The handle walk ends at the first failing index (NVAPI_END_ENUMERATION), the same as every earlier caller did.
+void TopologyCache::LoadDisplaysLocked() {
+  if (m_displaysLoaded) { return; }
+  m_displays.clear();
+  NvDisplayHandle handle = NULL;
+  for (NvU32 index = 0; NvApi().NvAPI_EnumNvidiaDisplayHandle(index, &handle) == NVAPI_OK; ++index) {
+    TopologyDisplay entry = {};
+    entry.index = index;
+    entry.handle = handle;
+    m_displays.push_back(entry);
+  }
+  m_displayIdsResolved = false;
+  m_displayById.clear();
+  m_displaysLoaded = true;
+}
+
+void TopologyCache::ResolveDisplayIdsLocked() {
+  if (m_displayIdsResolved) { return; }
+  for (size_t i = 0; i < m_displays.size(); ++i) {
+    TopologyDisplay &entry = m_displays[i];
+    entry.hasDisplayId = NvApi().NvAPI_DISP_GetDisplayIdFromDisplayHandle(entry.handle, &entry.displayId) == NVAPI_OK;
+    entry.hasOutputId = NvApi().NvAPI_GetAssociatedDisplayOutputId(entry.handle, &entry.outputId) == NVAPI_OK;
+    if (entry.hasDisplayId) { m_displayById.emplace(entry.displayId, i); }
+  }
+  m_displayIdsResolved = true;
+}
+
+NvAPI_Status TopologyCache::PhysicalGpus(std::vector<NvPhysicalGpuHandle> *out) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  if (!LoadGpusLocked()) { return m_gpuStatus; }
+  *out = m_gpus;
+  return NVAPI_OK;
+}
+
+NvAPI_Status TopologyCache::LogicalGpus(std::vector<TopologyLogicalGpu> *out) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  if (!LoadLogicalGpusLocked()) { return m_logicalStatus; }
+  *out = m_logical;
+  return NVAPI_OK;
+}
+
+bool TopologyCache::PhysicalGpuIndex(NvPhysicalGpuHandle handle, NvU32 *index) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  if (!LoadGpusLocked()) { return false; }
+  auto found = m_gpuIndex.find(handle);
+  if (found == m_gpuIndex.end()) { return false; }
+  *index = found->second;
+  return true;
+}
+
+NvU32 TopologyCache::DisplayCount() {
+  std::lock_guard<std::mutex> guard(m_lock);
+  LoadDisplaysLocked();
+  return static_cast<NvU32>(m_displays.size());
+}
+
+bool TopologyCache::DisplayByIndex(NvU32 index, TopologyDisplay *out) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  LoadDisplaysLocked();
+  if (index >= m_displays.size()) { return false; }
+  ResolveDisplayIdsLocked();
+  *out = m_displays[index];
+  return true;
+}
+
+bool TopologyCache::DisplayById(NvU32 displayId, TopologyDisplay *out) {
+  std::lock_guard<std::mutex> guard(m_lock);
+  LoadDisplaysLocked();
+  ResolveDisplayIdsLocked();
+  auto found = m_displayById.find(displayId);
+  if (found == m_displayById.end()) { return false; }
+  *out = m_displays[found->second];
+  return true;
+}
+
+void TopologyCache::Invalidate() {
+  std::lock_guard<std::mutex> guard(m_lock);
+  m_gpusLoaded = false;
+  m_logicalLoaded = false;
+  m_displaysLoaded = false;
+  m_displayIdsResolved = false;
+}
+
+TopologyCache &Topology() {
+  static TopologyCache cache;
+  return cache;
+}
+
+namespace {
+LRESULT CALLBACK TopologyWindowProc(HWND window, UINT message, WPARAM wParam, LPARAM lParam) {
+  // WM_DEVICECHANGE with DBT_DEVNODES_CHANGED (0x0007) covers hot-plugged GPUs and docks that WM_DISPLAYCHANGE misses.
+  if (message == WM_DISPLAYCHANGE || (message == WM_DEVICECHANGE && wParam == 0x0007)) { Topology().Invalidate(); }
+  return DefWindowProcA(window, message, wParam, lParam);
+}
+} // namespace
+
+void TopologyWatcher::Run(std::promise<bool> *created) {
+  static const char kClassName[] = "NvapiCliTopology";
+  HINSTANCE instance = GetModuleHandleA(NULL);
+  WNDCLASSEXA wc = {};
+  wc.cbSize = sizeof(wc);
+  wc.lpfnWndProc = TopologyWindowProc;
+  wc.hInstance = instance;
+  wc.lpszClassName = kClassName;
+  RegisterClassExA(&wc);
+
+  // A hidden top-level window, message-only windows do not get the broadcast WM_DISPLAYCHANGE.
+  HWND window = CreateWindowExA(0, kClassName, "nvapi-cli", WS_OVERLAPPED, 0, 0, 0, 0, NULL, NULL, instance, NULL);
+  created->set_value(window != NULL);
+  if (!window) { return; }
+
+  MSG message;
+  while (GetMessageA(&message, NULL, 0, 0) > 0) {
+    TranslateMessage(&message);
+    DispatchMessageA(&message);
+  }
+  DestroyWindow(window);
+}
+
+bool TopologyWatcher::Start() {
+  if (m_thread.joinable()) { return true; }
+  std::promise<bool> created;
+  std::future<bool> result = created.get_future();
+  m_thread = std::thread([this, &created] {
+    m_threadId = GetCurrentThreadId();
+    Run(&created);
+  });
+  if (result.get()) { return true; }
+  m_thread.join();
+  return false;
+}
+
+void TopologyWatcher::Stop() {
+  if (!m_thread.joinable()) { return; }
+  PostThreadMessageA(m_threadId, WM_QUIT, 0, 0);
+  m_thread.join();
+}
+} // namespace nvcli
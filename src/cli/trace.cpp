@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/trace.h"
+#include "cli/common.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace nvcli {
+namespace {
+using TraceClock = std::chrono::steady_clock;
+
+// Per-thread cap so a long serve session cannot grow the trace without bound, later calls are only counted.
+constexpr size_t kMaxTraceEventsPerThread = 1u << 20;
+constexpr size_t kInitialTraceEvents = 4096;
+
+struct TraceEvent {
+  NvApiId id;
+  NvAPI_Status status;
+  NvU32 version;
+  const void *gpu;
+  const void *display;
+  NvU64 startNs;
+  NvU64 durationNs;
+};
+
+struct TraceSpanEvent {
+  std::string name;
+  NvU64 startNs;
+  NvU64 durationNs;
+};
+
+struct TraceBuffer {
+  NvU32 tid;
+  NvU64 dropped;
+  std::vector<TraceEvent> events;
+  std::vector<TraceSpanEvent> spans;
+};
+
+struct TraceState {
+  std::mutex lock;
+  bool enabled = false;
+  FILE *file = nullptr;
+  NvApiBackend inner = {};
+  TraceClock::time_point origin;
+  std::vector<std::unique_ptr<TraceBuffer>> buffers;
+  std::vector<const void *> gpus;
+  std::vector<const void *> displays;
+};
+
+TraceState &Tracer() {
+  static TraceState state;
+  return state;
+}
+
+thread_local TraceBuffer *t_traceBuffer = nullptr;
+
+TraceBuffer &ThreadTraceBuffer() {
+  if (t_traceBuffer) { return *t_traceBuffer; }
+  TraceState &state = Tracer();
+  std::lock_guard<std::mutex> guard(state.lock);
+  state.buffers.push_back(std::make_unique<TraceBuffer>());
+  t_traceBuffer = state.buffers.back().get();
+  t_traceBuffer->tid = static_cast<NvU32>(state.buffers.size());
+  t_traceBuffer->dropped = 0;
+  t_traceBuffer->events.reserve(kInitialTraceEvents);
+  return *t_traceBuffer;
+}
+
+NvU64 TraceNowNs() {
+  return static_cast<NvU64>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(TraceClock::now() - Tracer().origin).count());
+}
+
+// NVAPI handles are pointers to NV_DECLARE_HANDLE structs, which are never dereferenced.
+template <typename T, typename = void> struct IsNvHandleStruct : std::false_type {};
+template <typename T> struct IsNvHandleStruct<T, decltype((void)std::declval<T &>().unused)> : std::true_type {};
+
+void DescribeArg(TraceEvent &event, NvPhysicalGpuHandle gpu) {
+  if (!event.gpu) { event.gpu = gpu; }
+}
+
+void DescribeArg(TraceEvent &event, NvDisplayHandle display) {
+  if (!event.display) { event.display = display; }
+}
+
+// The first struct argument whose leading NvU32 reads as MAKE_NVAPI_VERSION(type, n) supplies the struct version.
+// Callers that fall back to an older version pass a smaller size than the declared struct, so any nonzero size up to
+// sizeof counts.
+template <typename T> void DescribeArg(TraceEvent &event, T *data) {
+  using Struct = typename std::remove_cv<T>::type;
+  if constexpr (std::is_class<Struct>::value && !IsNvHandleStruct<Struct>::value) {
+    if (sizeof(Struct) < sizeof(NvU32) || event.version != 0 || !data) { return; }
+    NvU32 tag = 0;
+    std::memcpy(&tag, data, sizeof(tag));
+    const NvU32 size = tag & 0xFFFF;
+    if (size != 0 && size <= sizeof(Struct)) { event.version = tag >> 16; }
+  }
+}
+
+template <typename T> void DescribeArg(TraceEvent &, T) {}
+
+void RememberHandles(std::vector<const void *> *list, const void *const *handles, NvU32 count) {
+  std::lock_guard<std::mutex> guard(Tracer().lock);
+  list->assign(handles, handles + count);
+}
+
+void RememberHandle(std::vector<const void *> *list, NvU32 index, const void *handle) {
+  std::lock_guard<std::mutex> guard(Tracer().lock);
+  if (index >= list->size()) { list->resize(index + 1, nullptr); }
+  (*list)[index] = handle;
+}
+
+template <NvApiId Id, typename... Args> void ObserveCall(NvAPI_Status status, Args... args) {
+  if (status != NVAPI_OK) { return; }
+  if constexpr (Id == NvApiId::NvAPI_EnumPhysicalGPUs) {
+    auto observe = [](NvPhysicalGpuHandle *handles, NvU32 *count) {
+      if (handles && count) {
+        RememberHandles(&Tracer().gpus, reinterpret_cast<const void *const *>(handles), *count);
+      }
+    };
+    observe(args...);
+  } else if constexpr (Id == NvApiId::NvAPI_EnumNvidiaDisplayHandle) {
+    auto observe = [](NvU32 index, NvDisplayHandle *handle) {
+      if (handle) { RememberHandle(&Tracer().displays, index, *handle); }
+    };
+    observe(args...);
+  }
+}
+
+template <NvApiId Id, typename Fn = typename NvApiEntry<Id>::Fn> struct TraceEntry;
+
+template <NvApiId Id, typename... Args> struct TraceEntry<Id, NvAPI_Status(__cdecl *)(Args...)> {
+  static NvAPI_Status __cdecl Call(Args... args) {
+    TraceEvent event = {};
+    event.id = Id;
+    (DescribeArg(event, args), ...);
+    event.startNs = TraceNowNs();
+    const NvAPI_Status status = NvApiEntry<Id>::Slot(Tracer().inner)(args...);
+    event.durationNs = TraceNowNs() - event.startNs;
+    event.status = status;
+    ObserveCall<Id>(status, args...);
+
+    TraceBuffer &buffer = ThreadTraceBuffer();
+    if (buffer.events.size() < kMaxTraceEventsPerThread) {
+      buffer.events.push_back(event);
+    } else {
+      ++buffer.dropped;
+    }
+    return status;
+  }
+};
+
+int HandleIndex(const std::vector<const void *> &list, const void *handle) {
+  for (size_t i = 0; i < list.size(); ++i) {
+    if (list[i] == handle) { return static_cast<int>(i); }
+  }
+  return -1;
+}
+
+void WriteJsonString(FILE *file, const char *text) {
+  std::fputc('"', file);
+  for (const char *c = text; *c; ++c) {
+    if (*c == '"' || *c == '\\') {
+      std::fputc('\\', file);
+      std::fputc(*c, file);
+    } else if (static_cast<unsigned char>(*c) < 0x20) {
+      std::fprintf(file, "\\u%04X", static_cast<unsigned char>(*c));
+    } else {
+      std::fputc(*c, file);
+    }
+  }
+  std::fputc('"', file);
+}
+
+const std::string &StatusText(std::map<NvAPI_Status, std::string> &cache, NvAPI_Status status) {
+  auto it = cache.find(status);
+  if (it != cache.end()) { return it->second; }
+  NvAPI_ShortString text = {0};
+  if (Tracer().inner.NvAPI_GetErrorMessage(status, text) != NVAPI_OK) {
+    std::snprintf(text, sizeof(text), "NVAPI status %d", static_cast<int>(status));
+  }
+  return cache.emplace(status, text).first->second;
+}
+} // namespace
+
+bool EnableNvApiTrace(const char *path) {
+  TraceState &state = Tracer();
+  if (state.enabled) { return true; }
+  if (fopen_s(&state.file, path, "wb") != 0 || !state.file) {
+    Printf("Failed to open trace file %s\n", path);
+    state.file = nullptr;
+    return false;
+  }
+
+  NvApiBackend traced = {};
+#define NVCLI_NVAPI_ENTRY(fn) traced.fn = &TraceEntry<NvApiId::fn>::Call;
+#include "cli/nvapi_entries.h"
+#undef NVCLI_NVAPI_ENTRY
+  state.origin = TraceClock::now();
+  state.inner = ReplaceNvApiBackend(traced);
+  state.enabled = true;
+  return true;
+}
+
+bool NvApiTraceEnabled() { return Tracer().enabled; }
+
+bool WriteNvApiTrace() {
+  TraceState &state = Tracer();
+  if (!state.enabled || !state.file) { return false; }
+  std::lock_guard<std::mutex> guard(state.lock);
+  FILE *file = state.file;
+  std::map<NvAPI_Status, std::string> statusText;
+
+  std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+  std::fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"%s\"}}", kToolName);
+  for (const auto &buffer : state.buffers) {
+    char threadName[32];
+    if (buffer->tid == 1) {
+      std::snprintf(threadName, sizeof(threadName), "main");
+    } else {
+      std::snprintf(threadName, sizeof(threadName), "worker %u", buffer->tid - 1);
+    }
+    std::fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"",
+                 buffer->tid, threadName);
+    if (buffer->dropped > 0) {
+      std::fprintf(file, ",\"dropped_calls\":%llu", static_cast<unsigned long long>(buffer->dropped));
+    }
+    std::fprintf(file, "}}");
+
+    for (const auto &span : buffer->spans) {
+      std::fprintf(file, ",\n{\"name\":");
+      WriteJsonString(file, span.name.c_str());
+      std::fprintf(file, ",\"cat\":\"command\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                   span.startNs / 1000.0, span.durationNs / 1000.0, buffer->tid);
+    }
+
+    for (const auto &event : buffer->events) {
+      std::fprintf(file,
+                   ",\n{\"name\":\"%s\",\"cat\":\"nvapi\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u,"
+                   "\"args\":{",
+                   NvApiName(event.id), event.startNs / 1000.0, event.durationNs / 1000.0, buffer->tid);
+      std::fprintf(file, "\"status\":%d,\"result\":", static_cast<int>(event.status));
+      WriteJsonString(file, StatusText(statusText, event.status).c_str());
+      if (event.gpu) { std::fprintf(file, ",\"gpu\":%d", HandleIndex(state.gpus, event.gpu)); }
+      if (event.display) { std::fprintf(file, ",\"display\":%d", HandleIndex(state.displays, event.display)); }
+      if (event.version != 0) { std::fprintf(file, ",\"version\":%u", event.version); }
+      std::fprintf(file, "}}");
+    }
+  }
+  std::fprintf(file, "\n]}\n");
+  const bool ok = std::ferror(file) == 0;
+  std::fclose(file);
+  state.file = nullptr;
+  if (!ok) { Printf("Failed to write trace file\n"); }
+  return ok;
+}
+
+TraceSpan::TraceSpan(int argc, char **argv) : m_argc(argc), m_argv(argv), m_startNs(0) {
+  if (Tracer().enabled) { m_startNs = TraceNowNs(); }
+}
+
+TraceSpan::~TraceSpan() {
+  if (!Tracer().enabled) { return; }
+  TraceSpanEvent span;
+  span.startNs = m_startNs;
+  span.durationNs = TraceNowNs() - m_startNs;
+  for (int i = 0; i < m_argc; ++i) {
+    if (i > 0) { span.name.push_back(' '); }
+    span.name.append(m_argv[i]);
+  }
+  ThreadTraceBuffer().spans.push_back(std::move(span));
+}
+} // namespace nvcli
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/vf_curve.h"
+#include "cli/common.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace nvcli {
+namespace {
+constexpr NvU32 kDefaultGridIntervals = 32;
+constexpr NvU32 kMaxGridPoints = 4096;
+
+std::string DomainKey(const char *name, NvU32 id) {
+  if (std::strcmp(name, "OTHER") != 0 && std::strcmp(name, "UNKNOWN") != 0) { return name; }
+  return "CLK" + std::to_string(id);
+}
+
+double Median(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  const size_t mid = values.size() / 2;
+  return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+}
+} // namespace
+
+VfCurve::VfCurve(const std::string &label, const std::string &domain, std::vector<VfPoint> points)
+    : m_label(label), m_domain(domain) {
+  points.erase(std::remove_if(points.begin(), points.end(),
+                              [](const VfPoint &point) { return point.voltageUv == 0 || point.freqKhz == 0; }),
+               points.end());
+  std::sort(points.begin(), points.end(), [](const VfPoint &a, const VfPoint &b) {
+    return a.voltageUv != b.voltageUv ? a.voltageUv < b.voltageUv : a.freqKhz > b.freqKhz;
+  });
+  for (const VfPoint &point : points) {
+    if (!m_points.empty() && m_points.back().voltageUv == point.voltageUv) { continue; }
+    VfPoint kept = point;
+    if (!m_points.empty() && kept.freqKhz < m_points.back().freqKhz) {
+      kept.freqKhz = m_points.back().freqKhz;
+      ++m_adjusted;
+    }
+    m_points.push_back(kept);
+  }
+
+  // Fritsch-Carlson tangents: zero where the curve is flat on either side, otherwise the weighted harmonic mean of the
+  // neighbouring secants, which keeps every segment monotone.
+  const size_t count = m_points.size();
+  m_slopes.assign(count, 0.0);
+  if (count < 2) { return; }
+  std::vector<double> secant(count - 1);
+  std::vector<double> width(count - 1);
+  for (size_t i = 0; i + 1 < count; ++i) {
+    width[i] = static_cast<double>(m_points[i + 1].voltageUv) - m_points[i].voltageUv;
+    secant[i] = (static_cast<double>(m_points[i + 1].freqKhz) - m_points[i].freqKhz) / width[i];
+  }
+  m_slopes[0] = secant[0];
+  m_slopes[count - 1] = secant[count - 2];
+  for (size_t i = 1; i + 1 < count; ++i) {
+    if (secant[i - 1] <= 0.0 || secant[i] <= 0.0) { continue; }
+    double w1 = 2.0 * width[i] + width[i - 1];
+    double w2 = width[i] + 2.0 * width[i - 1];
+    m_slopes[i] = (w1 + w2) / (w1 / secant[i - 1] + w2 / secant[i]);
+  }
+}
+
+double VfCurve::Segment(size_t i, double voltageUv) const {
+  const double x0 = m_points[i].voltageUv;
+  const double h = static_cast<double>(m_points[i + 1].voltageUv) - x0;
+  const double t = (voltageUv - x0) / h;
+  const double t2 = t * t;
+  const double t3 = t2 * t;
+  return (2.0 * t3 - 3.0 * t2 + 1.0) * m_points[i].freqKhz + (t3 - 2.0 * t2 + t) * h * m_slopes[i] +
+         (-2.0 * t3 + 3.0 * t2) * m_points[i + 1].freqKhz + (t3 - t2) * h * m_slopes[i + 1];
+}
+
+double VfCurve::FreqAt(double voltageUv) const {
+  if (m_points.empty()) { return 0.0; }
+  if (voltageUv <= m_points.front().voltageUv) { return m_points.front().freqKhz; }
+  if (voltageUv >= m_points.back().voltageUv) { return m_points.back().freqKhz; }
+  auto upper = std::upper_bound(m_points.begin(), m_points.end(), voltageUv,
+                                [](double value, const VfPoint &point) { return value < point.voltageUv; });
+  return Segment(static_cast<size_t>(upper - m_points.begin()) - 1, voltageUv);
+}
+
+double VfCurve::VoltageFor(double freqKhz) const {
+  if (m_points.empty() || freqKhz > m_points.back().freqKhz) { return -1.0; }
+  if (freqKhz <= m_points.front().freqKhz) { return m_points.front().voltageUv; }
+  auto upper = std::lower_bound(m_points.begin(), m_points.end(), freqKhz,
+                                [](const VfPoint &point, double value) { return point.freqKhz < value; });
+  const size_t i = static_cast<size_t>(upper - m_points.begin()) - 1;
+  // The segment is monotone, so bisection converges on the lowest voltage reaching the frequency.
+  double low = m_points[i].voltageUv;
+  double high = m_points[i + 1].voltageUv;
+  for (int step = 0; step < 48 && high - low > 0.01; ++step) {
+    double mid = (low + high) / 2.0;
+    if (Segment(i, mid) >= freqKhz) {
+      high = mid;
+    } else {
+      low = mid;
+    }
+  }
+  return high;
+}
+
+std::string VfCurve::Serialize() const {
+  std::string line = "vf1 " + m_label + " " + m_domain + " " + std::to_string(m_points.size());
+  for (size_t i = 0; i < m_points.size(); ++i) {
+    char buffer[48] = {};
+    if (i == 0) {
+      std::snprintf(buffer, sizeof(buffer), " %u:%u", m_points[i].voltageUv, m_points[i].freqKhz);
+    } else {
+      std::snprintf(buffer, sizeof(buffer), " %u:%d", m_points[i].voltageUv - m_points[i - 1].voltageUv,
+                    static_cast<NvS32>(m_points[i].freqKhz - m_points[i - 1].freqKhz));
+    }
+    line += buffer;
+  }
+  return line;
+}
+
+bool VfCurve::Parse(const std::string &line, VfCurve *out) {
+  std::istringstream stream(line);
+  std::string magic;
+  std::string label;
+  std::string domain;
+  size_t count = 0;
+  if (!(stream >> magic >> label >> domain >> count) || magic != "vf1" || count == 0) { return false; }
+
+  std::vector<VfPoint> points;
+  NvS64 voltage = 0;
+  NvS64 freq = 0;
+  std::string token;
+  while (stream >> token) {
+    char *end = NULL;
+    long long dv = std::strtoll(token.c_str(), &end, 10);
+    if (*end != ':') { return false; }
+    const char *cursor = end + 1;
+    long long df = std::strtoll(cursor, &end, 10);
+    if (end == cursor || *end != '\0') { return false; }
+    voltage += dv;
+    freq += df;
+    if (voltage <= 0 || freq <= 0 || voltage > 0xFFFFFFFFll || freq > 0xFFFFFFFFll) { return false; }
+    points.push_back({static_cast<NvU32>(voltage), static_cast<NvU32>(freq)});
+  }
+  if (points.size() != count) { return false; }
+  VfCurve curve(label, domain, points);
+  if (curve.Empty()) { return false; }
+  *out = curve;
+  return true;
+}
+
+void VfCurvesFromClient(const NV_GPU_CLOCK_CLIENT_CLK_DOMAINS_INFO &domains,
+                        const NV_GPU_CLOCK_CLIENT_CLK_VF_POINTS_STATUS &status, const std::string &label,
+                        std::vector<VfCurve> *out) {
+  for (NvU32 d = 0; d < NV_GPU_BOARDOBJGRP_E32_MAX_OBJECTS; ++d) {
+    if (!MaskE32Has(domains.domainMask, d)) { continue; }
+    const NV_GPU_CLOCK_CLIENT_CLK_DOMAIN_INFO_V1 &domain = domains.domains[d];
+    if (domain.type != NV_GPU_CLOCK_CLIENT_CLK_DOMAIN_TYPE_PROG) { continue; }
+
+    std::vector<VfPoint> points;
+    for (NvU32 p = domain.data.prog.vfPointIdxFirst; p <= domain.data.prog.vfPointIdxLast; ++p) {
+      if (!MaskE255Has(status.vfPointMask, p)) { continue; }
+      points.push_back({status.vfPoints[p].voltageuV, status.vfPoints[p].freqkHz});
+    }
+    VfCurve curve(label, DomainKey(ClockDomainName(domain.domainId), domain.domainId), points);
+    if (!curve.Empty()) { out->push_back(curve); }
+  }
+}
+
+void VfCurvesFromTables(const NV_GPU_PERF_VF_TABLES &tables, const std::string &label, std::vector<VfCurve> *out) {
+  const NvU32 indexCount = std::min<NvU32>(tables.numIndexes, NV_GPU_PERF_VF_INDEXES_TABLE_MAX_ENTRIES_V1);
+  const NvU32 entryCount = std::min<NvU32>(tables.numEntries, NV_GPU_PERF_VF_ENTRIES_TABLE_MAX_ENTRIES_V2);
+  for (NvU32 t = 0; t < indexCount; ++t) {
+    const NV_GPU_PERF_VF_INDEXES_TABLE_ENTRY_V1 &index = tables.indexes[t];
+    std::vector<VfPoint> points;
+    for (NvU32 e = index.entryIndexFirst; e <= index.entryIndexLast && e < entryCount; ++e) {
+      points.push_back({tables.entries[e].voltage.mvolt * 1000, tables.entries[e].maxFreqKHz});
+    }
+    const std::string domain = DomainKey(ClockDomainIdName(index.domainId), index.domainId);
+    VfCurve curve(label, domain + "/" + PstateName(index.pstateId), points);
+    if (!curve.Empty()) { out->push_back(curve); }
+  }
+}
+
+bool ReadVfCurveFile(const char *path, std::vector<VfCurve> *out) {
+  FILE *file = nullptr;
+  if (fopen_s(&file, path, "r") != 0 || !file) {
+    Printf("Failed to open %s\n", path);
+    return false;
+  }
+  // A full curve is a few KB on one line, so lines are assembled from fgets chunks.
+  char chunk[1024];
+  std::string line;
+  NvU32 lineNumber = 0;
+  bool ok = true;
+  while (ok && std::fgets(chunk, sizeof(chunk), file)) {
+    line += chunk;
+    if (line.back() != '\n' && !std::feof(file)) { continue; }
+    ++lineNumber;
+    size_t start = line.find_first_not_of(" \t\r\n");
+    if (start != std::string::npos && line[start] != '#') {
+      VfCurve curve;
+      if (VfCurve::Parse(line, &curve)) {
+        out->push_back(curve);
+      } else {
+        Printf("%s:%u: invalid curve\n", path, lineNumber);
+        ok = false;
+      }
+    }
+    line.clear();
+  }
+  std::fclose(file);
+  return ok;
+}
+
+bool WriteVfCurveFile(const char *path, const std::vector<VfCurve> &curves) {
+  FILE *file = nullptr;
+  if (fopen_s(&file, path, "w") != 0 || !file) {
+    Printf("Failed to open %s\n", path);
+    return false;
+  }
+  bool ok = true;
+  for (const VfCurve &curve : curves) {
+    std::string line = curve.Serialize() + "\n";
+    if (std::fwrite(line.data(), 1, line.size(), file) != line.size()) { ok = false; }
+  }
+  if (std::fclose(file) != 0) { ok = false; }
+  if (!ok) { Printf("Failed to write %s\n", path); }
+  return ok;
+}
+
+bool CompareVfCurves(const std::vector<const VfCurve *> &curves, double stepUv, VfComparison *out,
+                     std::string *error) {
+  *out = VfComparison();
+  if (curves.empty()) {
+    if (error) { *error = "no curves to compare"; }
+    return false;
+  }
+  double low = 0.0;
+  double high = 1e18;
+  for (const VfCurve *curve : curves) {
+    if (curve->Empty()) {
+      if (error) { *error = "curve " + curve->Label() + " has no points"; }
+      return false;
+    }
+    low = std::max(low, static_cast<double>(curve->Points().front().voltageUv));
+    high = std::min(high, static_cast<double>(curve->Points().back().voltageUv));
+  }
+  if (low > high) {
+    if (error) { *error = "the curves share no voltage range"; }
+    return false;
+  }
+  if (stepUv <= 0.0) { stepUv = high > low ? (high - low) / kDefaultGridIntervals : 1.0; }
+  if ((high - low) / stepUv >= kMaxGridPoints) {
+    if (error) { *error = "voltage step too small for the shared range"; }
+    return false;
+  }
+  for (double v = low; v <= high + stepUv * 1e-9; v += stepUv) { out->gridUv.push_back(v); }
+
+  const size_t count = curves.size();
+  out->deltaKhz.assign(count, std::vector<double>(out->gridUv.size()));
+  std::vector<double> column(count);
+  for (size_t g = 0; g < out->gridUv.size(); ++g) {
+    for (size_t c = 0; c < count; ++c) { column[c] = curves[c]->FreqAt(out->gridUv[g]); }
+    double median = Median(column);
+    out->medianKhz.push_back(median);
+    for (size_t c = 0; c < count; ++c) { out->deltaKhz[c][g] = column[c] - median; }
+  }
+
+  for (size_t c = 0; c < count; ++c) {
+    const std::vector<double> &delta = out->deltaKhz[c];
+    double sum = 0.0;
+    for (double value : delta) { sum += value; }
+    out->meanDeltaKhz.push_back(sum / static_cast<double>(delta.size()));
+    out->minDeltaKhz.push_back(*std::min_element(delta.begin(), delta.end()));
+    out->maxDeltaKhz.push_back(*std::max_element(delta.begin(), delta.end()));
+    out->order.push_back(c);
+  }
+  std::stable_sort(out->order.begin(), out->order.end(),
+                   [&](size_t a, size_t b) { return out->meanDeltaKhz[a] > out->meanDeltaKhz[b]; });
+  return true;
+}
+} // namespace nvcli
@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2026 Noverse (Nohuto). All rights reserved.
+ * Proprietary and confidential. Unauthorized copying or redistribution is strictly prohibited.
+ */
+
+#include "cli/vfe_eval.h"
+#include "cli/common.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace nvcli {
+namespace {
+constexpr NvU8 kVisiting = 1;
+constexpr NvU8 kCompiled = 2;
+
+bool Fail(std::string *error, const char *format, NvU32 index, NvU32 other = 0) {
+  char buffer[128] = {};
+  std::snprintf(buffer, sizeof(buffer), format, index, other);
+  if (error) { *error = buffer; }
+  return false;
+}
+
+double ApplyOverride(NvU8 type, double overrideValue, double value) {
+  switch (type) {
+  case NV_GPU_PERF_VFE_VAR_SINGLE_OVERRIDE_TYPE_VALUE: return overrideValue;
+  case NV_GPU_PERF_VFE_VAR_SINGLE_OVERRIDE_TYPE_OFFSET: return value + overrideValue;
+  case NV_GPU_PERF_VFE_VAR_SINGLE_OVERRIDE_TYPE_SCALE: return value * overrideValue;
+  default: return value;
+  }
+}
+
+double Clamp(double value, double rangeMin, double rangeMax) {
+  if (rangeMin >= rangeMax) { return value; }
+  if (value < rangeMin) { return rangeMin; }
+  if (value > rangeMax) { return rangeMax; }
+  return value;
+}
+
+bool UsesVar(NV_GPU_PERF_VFE_EQU_TYPE type) {
+  return type == NV_GPU_PERF_VFE_EQU_TYPE_COMPARE || type == NV_GPU_PERF_VFE_EQU_TYPE_QUADRATIC ||
+         type == NV_GPU_PERF_VFE_EQU_TYPE_EQUATION_SCALAR;
+}
+
+VfeNode MakeNode(VfeOp op, double rangeMin, double rangeMax) {
+  VfeNode node = {};
+  node.op = op;
+  node.a = -1;
+  node.b = -1;
+  node.c = -1;
+  node.rangeMin = rangeMin;
+  node.rangeMax = rangeMax;
+  return node;
+}
+
+const NV_GPU_PERF_VFE_VAR_INFO_SINGLE_SENSED_FUSE_BASE *FuseBase(const NV_GPU_PERF_VFE_VAR_INFO &var) {
+  switch (var.type) {
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE_BASE: return &var.data.sensedFuseBase;
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE: return &var.data.sensedFuse.super;
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE_20: return &var.data.sensedFuse20.super;
+  default: return NULL;
+  }
+}
+} // namespace
+
+NV_GPU_PERF_VFE_VAR_CONTROL_SINGLE *GetVfeVarSingleControl(NV_GPU_PERF_VFE_VAR_CONTROL_V1 &var) {
+  switch (var.type) {
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE: return &var.data.single;
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_FREQUENCY: return &var.data.singleFreq.super;
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED: return &var.data.sensed.super;
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE:
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE_20: return &var.data.sensedFuse.super.super;
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_TEMP: return &var.data.sensedTemp.super.super;
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_VOLTAGE: return &var.data.singleVolt.super.super;
+  default: return NULL;
+  }
+}
+
+const NV_GPU_PERF_VFE_VAR_CONTROL_SINGLE *GetVfeVarSingleControl(const NV_GPU_PERF_VFE_VAR_CONTROL_V1 &var) {
+  return GetVfeVarSingleControl(const_cast<NV_GPU_PERF_VFE_VAR_CONTROL_V1 &>(var));
+}
+
+void VfeDefsFromNvapi(const NV_GPU_PERF_VFE_VARS_INFO &varsInfo, const NV_GPU_PERF_VFE_VARS_CONTROL &varsControl,
+                      const NV_GPU_PERF_VFE_EQUS_INFO &equsInfo, const NV_GPU_PERF_VFE_EQUS_CONTROL &equsControl,
+                      std::vector<VfeVarDef> *vars, std::vector<VfeEquDef> *equs) {
+  vars->clear();
+  equs->clear();
+
+  for (NvU32 v = 0; v < kVfeVarCount; ++v) {
+    if (!MaskE32Has(varsInfo.varsMask, v)) { continue; }
+    const NV_GPU_PERF_VFE_VAR_INFO &info = varsInfo.vars[v];
+    VfeVarDef def = {};
+    def.index = static_cast<NvU8>(v);
+    def.type = info.type;
+    def.varIdx0 = kVfeIdxInvalid;
+    def.varIdx1 = kVfeIdxInvalid;
+    if (info.type == NV_GPU_PERF_VFE_VAR_TYPE_DERIVED_PRODUCT) {
+      def.varIdx0 = info.data.derivedProd.varIdx0;
+      def.varIdx1 = info.data.derivedProd.varIdx1;
+    } else if (info.type == NV_GPU_PERF_VFE_VAR_TYPE_DERIVED_SUM) {
+      def.varIdx0 = info.data.derivedSum.varIdx0;
+      def.varIdx1 = info.data.derivedSum.varIdx1;
+    }
+    if (const NV_GPU_PERF_VFE_VAR_INFO_SINGLE_SENSED_FUSE_BASE *fuse = FuseBase(info)) {
+      def.hasFuse = true;
+      def.fuseValue = fuse->fuseValue.bSigned ? static_cast<double>(fuse->fuseValue.data.signedValue)
+                                              : static_cast<double>(fuse->fuseValue.data.unsignedValue);
+    }
+
+    // The control block is only trusted when it describes the same var type.
+    if (MaskE32Has(varsControl.varsMask, v) && varsControl.vars[v].type == info.type) {
+      const NV_GPU_PERF_VFE_VAR_CONTROL_V1 &control = varsControl.vars[v];
+      def.rangeMin = control.outRangeMin;
+      def.rangeMax = control.outRangeMax;
+      if (const NV_GPU_PERF_VFE_VAR_CONTROL_SINGLE *single = GetVfeVarSingleControl(control)) {
+        def.overrideType = single->overrideType;
+        def.overrideValue = single->overrideValue;
+      }
+    }
+    vars->push_back(def);
+  }
+
+  for (NvU32 e = 0; e < kVfeEquCount; ++e) {
+    if (!MaskE255Has(equsInfo.equsMask, e)) { continue; }
+    const NV_GPU_PERF_VFE_EQU_INFO_V1 &info = equsInfo.equs[e];
+    VfeEquDef def = {};
+    def.index = static_cast<NvU8>(e);
+    def.type = info.type;
+    def.varIdx = info.varIdx;
+    def.equIdxNext = info.equIdxNext;
+    def.outputType = info.outputType;
+    def.child0 = kVfeIdxInvalid;
+    def.child1 = kVfeIdxInvalid;
+    if (info.type == NV_GPU_PERF_VFE_EQU_TYPE_COMPARE) {
+      def.child0 = info.data.compare.equIdxTrue;
+      def.child1 = info.data.compare.equIdxFalse;
+    } else if (info.type == NV_GPU_PERF_VFE_EQU_TYPE_MINMAX) {
+      def.child0 = info.data.minmax.equIdx0;
+      def.child1 = info.data.minmax.equIdx1;
+    } else if (info.type == NV_GPU_PERF_VFE_EQU_TYPE_EQUATION_SCALAR) {
+      def.child0 = info.data.equScalar.equIdxToScale;
+    }
+
+    if (MaskE255Has(equsControl.equsMask, e) && equsControl.equs[e].type == info.type) {
+      const NV_GPU_PERF_VFE_EQU_CONTROL_V1 &control = equsControl.equs[e];
+      def.rangeMin = control.outRangeMin;
+      def.rangeMax = control.outRangeMax;
+      def.compareFunc = control.data.compare.funcId;
+      def.criteria = control.data.compare.criteria;
+      def.max = control.data.minmax.bMax != 0;
+      for (NvU32 k = 0; k < NV_GPU_PERF_VFE_EQU_QUADRATIC_COEFF_COUNT; ++k) {
+        def.coeffs[k] = control.data.quadratic.coeffs[k];
+      }
+    }
+    equs->push_back(def);
+  }
+}
+
+bool VfeProgram::Compile(const std::vector<VfeVarDef> &vars, const std::vector<VfeEquDef> &equs,
+                         std::string *error) {
+  std::memset(m_varDefs, 0, sizeof(m_varDefs));
+  std::memset(m_equDefs, 0, sizeof(m_equDefs));
+  std::memset(m_varState, 0, sizeof(m_varState));
+  std::memset(m_equState, 0, sizeof(m_equState));
+  std::memset(m_outputType, 0, sizeof(m_outputType));
+  for (NvU32 v = 0; v < kVfeVarCount; ++v) { m_varNode[v] = -1; }
+  for (NvU32 e = 0; e < kVfeEquCount; ++e) { m_equNode[e] = -1; }
+  m_roots.clear();
+  m_nodes.clear();
+
+  for (const VfeVarDef &def : vars) {
+    if (def.index < kVfeVarCount) { m_varDefs[def.index] = &def; }
+  }
+  bool referenced[kVfeEquCount] = {};
+  for (const VfeEquDef &def : equs) {
+    if (def.index >= kVfeEquCount) { continue; }
+    m_equDefs[def.index] = &def;
+    if (def.equIdxNext < kVfeEquCount) { referenced[def.equIdxNext] = true; }
+    if (def.child0 < kVfeEquCount) { referenced[def.child0] = true; }
+    if (def.child1 < kVfeEquCount) { referenced[def.child1] = true; }
+  }
+
+  // Vars first so the equations only ever point back at them, then every list. Compiling each list recursively
+  // before its own node is pushed is what puts the nodes in topological order.
+  for (NvU32 v = 0; v < kVfeVarCount; ++v) {
+    if (m_varDefs[v] && !CompileVar(v, error)) { return false; }
+  }
+  for (NvU32 e = 0; e < kVfeEquCount; ++e) {
+    if (!m_equDefs[e]) { continue; }
+    if (!CompileList(e, error)) { return false; }
+    if (!referenced[e]) { m_roots.push_back(static_cast<NvU8>(e)); }
+  }
+  return true;
+}
+
+bool VfeProgram::CompileVar(NvU32 var, std::string *error) {
+  if (var >= kVfeVarCount || !m_varDefs[var]) { return Fail(error, "VAR[%u] is referenced but not defined", var); }
+  if (m_varState[var] == kCompiled) { return true; }
+  if (m_varState[var] == kVisiting) { return Fail(error, "VAR[%u] depends on itself", var); }
+  m_varState[var] = kVisiting;
+
+  const VfeVarDef &def = *m_varDefs[var];
+  VfeNode node = MakeNode(kVfeOpInput, def.rangeMin, def.rangeMax);
+  node.source = def.index;
+  switch (def.type) {
+  case NV_GPU_PERF_VFE_VAR_TYPE_DERIVED_PRODUCT:
+  case NV_GPU_PERF_VFE_VAR_TYPE_DERIVED_SUM:
+    if (!CompileVar(def.varIdx0, error) || !CompileVar(def.varIdx1, error)) { return false; }
+    node.op = def.type == NV_GPU_PERF_VFE_VAR_TYPE_DERIVED_PRODUCT ? kVfeOpProduct : kVfeOpSum;
+    node.a = m_varNode[def.varIdx0];
+    node.b = m_varNode[def.varIdx1];
+    break;
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE_BASE:
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE:
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_FUSE_20:
+    node.op = kVfeOpConst;
+    node.k[0] = Clamp(ApplyOverride(def.overrideType, def.overrideValue, def.fuseValue), def.rangeMin, def.rangeMax);
+    break;
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE:
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_FREQUENCY:
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED:
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_SENSED_TEMP:
+  case NV_GPU_PERF_VFE_VAR_TYPE_SINGLE_VOLTAGE:
+    node.overrideType = def.overrideType;
+    node.k[0] = def.overrideValue;
+    break;
+  default: return Fail(error, "VAR[%u] has type %u which cannot be evaluated", var, static_cast<NvU32>(def.type));
+  }
+
+  m_varNode[var] = static_cast<NvS32>(m_nodes.size());
+  m_nodes.push_back(node);
+  m_varState[var] = kCompiled;
+  return true;
+}
+
+bool VfeProgram::CompileList(NvU32 equ, std::string *error) {
+  if (equ >= kVfeEquCount || !m_equDefs[equ]) { return Fail(error, "EQU[%u] is referenced but not defined", equ); }
+  if (m_equState[equ] == kCompiled) { return true; }
+  if (m_equState[equ] == kVisiting) { return Fail(error, "EQU[%u] is part of a cycle", equ); }
+  m_equState[equ] = kVisiting;
+
+  const VfeEquDef &def = *m_equDefs[equ];
+  if (UsesVar(def.type) && !CompileVar(def.varIdx, error)) { return false; }
+  VfeNode node = MakeNode(kVfeOpQuadratic, def.rangeMin, def.rangeMax);
+  node.source = def.index;
+  switch (def.type) {
+  case NV_GPU_PERF_VFE_EQU_TYPE_QUADRATIC:
+    node.a = m_varNode[def.varIdx];
+    for (NvU32 k = 0; k < NV_GPU_PERF_VFE_EQU_QUADRATIC_COEFF_COUNT; ++k) { node.k[k] = def.coeffs[k]; }
+    break;
+  case NV_GPU_PERF_VFE_EQU_TYPE_COMPARE:
+    if (def.compareFunc > NV_GPU_PERF_VFE_EQU_COMPARE_FUNCTION_GREATER) {
+      return Fail(error, "EQU[%u] has compare function %u", equ, def.compareFunc);
+    }
+    if (!CompileList(def.child0, error) || !CompileList(def.child1, error)) { return false; }
+    node.op = kVfeOpCompare;
+    node.compareFunc = def.compareFunc;
+    node.k[0] = def.criteria;
+    node.a = m_varNode[def.varIdx];
+    node.b = m_equNode[def.child0];
+    node.c = m_equNode[def.child1];
+    break;
+  case NV_GPU_PERF_VFE_EQU_TYPE_MINMAX:
+    if (!CompileList(def.child0, error) || !CompileList(def.child1, error)) { return false; }
+    node.op = kVfeOpMinMax;
+    node.max = def.max;
+    node.b = m_equNode[def.child0];
+    node.c = m_equNode[def.child1];
+    break;
+  case NV_GPU_PERF_VFE_EQU_TYPE_EQUATION_SCALAR:
+    if (!CompileList(def.child0, error)) { return false; }
+    node.op = kVfeOpScale;
+    node.a = m_varNode[def.varIdx];
+    node.b = m_equNode[def.child0];
+    break;
+  default: return Fail(error, "EQU[%u] has type %u which cannot be evaluated", equ, static_cast<NvU32>(def.type));
+  }
+  NvS32 single = static_cast<NvS32>(m_nodes.size());
+  m_nodes.push_back(node);
+
+  // A list evaluates to the sum of its members, a one element list is just the equation.
+  NvS32 result = single;
+  if (def.equIdxNext != kVfeIdxInvalid) {
+    if (!CompileList(def.equIdxNext, error)) { return false; }
+    VfeNode list = MakeNode(kVfeOpList, 0.0, 0.0);
+    list.source = def.index;
+    list.a = single;
+    list.b = m_equNode[def.equIdxNext];
+    result = static_cast<NvS32>(m_nodes.size());
+    m_nodes.push_back(list);
+  }
+
+  m_equNode[equ] = result;
+  m_outputType[equ] = def.outputType;
+  m_equState[equ] = kCompiled;
+  return true;
+}
+
+void VfeProgram::Evaluate(const double *inputs, std::vector<double> *values) const {
+  values->resize(m_nodes.size());
+  double *out = values->data();
+  for (size_t i = 0; i < m_nodes.size(); ++i) {
+    const VfeNode &node = m_nodes[i];
+    double value = 0.0;
+    switch (node.op) {
+    case kVfeOpInput: value = ApplyOverride(node.overrideType, node.k[0], inputs[node.source]); break;
+    case kVfeOpConst: value = node.k[0]; break;
+    case kVfeOpProduct: value = out[node.a] * out[node.b]; break;
+    case kVfeOpSum: value = out[node.a] + out[node.b]; break;
+    case kVfeOpQuadratic: {
+      double x = out[node.a];
+      value = node.k[0] + node.k[1] * x + node.k[2] * x * x;
+      break;
+    }
+    case kVfeOpCompare: {
+      double x = out[node.a];
+      bool taken = node.compareFunc == NV_GPU_PERF_VFE_EQU_COMPARE_FUNCTION_EQUAL        ? x == node.k[0]
+                   : node.compareFunc == NV_GPU_PERF_VFE_EQU_COMPARE_FUNCTION_GREATER_EQ ? x >= node.k[0]
+                                                                                          : x > node.k[0];
+      value = taken ? out[node.b] : out[node.c];
+      break;
+    }
+    case kVfeOpMinMax: {
+      double first = out[node.b];
+      double second = out[node.c];
+      value = node.max ? (first > second ? first : second) : (first < second ? first : second);
+      break;
+    }
+    case kVfeOpScale: value = out[node.a] * out[node.b]; break;
+    case kVfeOpList: value = out[node.a] + out[node.b]; break;
+    }
+    out[i] = Clamp(value, node.rangeMin, node.rangeMax);
+  }
+}
+
+const char *VfeOpName(VfeOp op) {
+  switch (op) {
+  case kVfeOpInput: return "input";
+  case kVfeOpConst: return "const";
+  case kVfeOpProduct: return "product";
+  case kVfeOpSum: return "sum";
+  case kVfeOpQuadratic: return "quadratic";
+  case kVfeOpCompare: return "compare";
+  case kVfeOpMinMax: return "minmax";
+  case kVfeOpScale: return "scale";
+  case kVfeOpList: return "list";
+  default: return "unknown";
+  }
+}
+} // namespace nvcli
@@ -12,9 +12,9 @@ int CmdVideoColorGet(NvDisplayHandle handle, bool useDefault) {
   info.version = NV_VIDEO_COLORCONTROL_NVAPI_VER;
   NvAPI_Status status = NVAPI_NOT_SUPPORTED;
   if (useDefault) {
-    // Deprecated in release 455: NvAPI_Video_ColorControl_GetDefault(handle, &info);
+    // Deprecated in release 455: NvApi().NvAPI_Video_ColorControl_GetDefault(handle, &info);
   } else {
-    // Deprecated in release 455: NvAPI_Video_ColorControl_Get(handle, &info);
+    // Deprecated in release 455: NvApi().NvAPI_Video_ColorControl_Get(handle, &info);
   }
   if (status != NVAPI_OK) {
     PrintNvapiError(useDefault ? "NvAPI_Video_ColorControl_GetDefault failed" : "NvAPI_Video_ColorControl_Get failed",
@@ -22,26 +22,26 @@ int CmdVideoColorGet(NvDisplayHandle handle, bool useDefault) {
     return 1;
   }
 
-  std::printf("Video color control (%s):\n", useDefault ? "default" : "current");
-  std::printf("  controlSetting=%u feature=%u caps=%u\n", info.colorControlSettings, info.colorFeature, info.colorCaps);
-  std::printf("  brightness=%u (min=%u max=%u)\n", info.brightnessRangeValue.value, info.brightnessRangeValue.min,
-              info.brightnessRangeValue.max);
-  std::printf("  contrast=%u (min=%u max=%u)\n", info.contrastRangeValue.value, info.contrastRangeValue.min,
-              info.contrastRangeValue.max);
-  std::printf("  hue=%u (min=%u max=%u)\n", info.hueRangeValue.value, info.hueRangeValue.min, info.hueRangeValue.max);
-  std::printf("  saturation=%u (min=%u max=%u)\n", info.saturationRangeValue.value, info.saturationRangeValue.min,
-              info.saturationRangeValue.max);
-  std::printf("  colorTemp=%u (min=%u max=%u) feature=%u caps=%u\n", info.colorTempRangeValue.value,
-              info.colorTempRangeValue.min, info.colorTempRangeValue.max, info.colorTempFeature, info.colorTempCaps);
-  std::printf("  gammaFeature=%u caps=%u\n", info.gammaFeature, info.gammaCaps);
-  std::printf("  yGamma=%u (min=%u max=%u)\n", info.yGammaRangeValue.value, info.yGammaRangeValue.min,
-              info.yGammaRangeValue.max);
-  std::printf("  rgbGammaR=%u (min=%u max=%u)\n", info.rgbGammaRRangeValue.value, info.rgbGammaRRangeValue.min,
-              info.rgbGammaRRangeValue.max);
-  std::printf("  rgbGammaG=%u (min=%u max=%u)\n", info.rgbGammaGRangeValue.value, info.rgbGammaGRangeValue.min,
-              info.rgbGammaGRangeValue.max);
-  std::printf("  rgbGammaB=%u (min=%u max=%u)\n", info.rgbGammaBRangeValue.value, info.rgbGammaBRangeValue.min,
-              info.rgbGammaBRangeValue.max);
+  Printf("Video color control (%s):\n", useDefault ? "default" : "current");
+  Printf("  controlSetting=%u feature=%u caps=%u\n", info.colorControlSettings, info.colorFeature, info.colorCaps);
+  Printf("  brightness=%u (min=%u max=%u)\n", info.brightnessRangeValue.value, info.brightnessRangeValue.min,
+         info.brightnessRangeValue.max);
+  Printf("  contrast=%u (min=%u max=%u)\n", info.contrastRangeValue.value, info.contrastRangeValue.min,
+         info.contrastRangeValue.max);
+  Printf("  hue=%u (min=%u max=%u)\n", info.hueRangeValue.value, info.hueRangeValue.min, info.hueRangeValue.max);
+  Printf("  saturation=%u (min=%u max=%u)\n", info.saturationRangeValue.value, info.saturationRangeValue.min,
+         info.saturationRangeValue.max);
+  Printf("  colorTemp=%u (min=%u max=%u) feature=%u caps=%u\n", info.colorTempRangeValue.value,
+         info.colorTempRangeValue.min, info.colorTempRangeValue.max, info.colorTempFeature, info.colorTempCaps);
+  Printf("  gammaFeature=%u caps=%u\n", info.gammaFeature, info.gammaCaps);
+  Printf("  yGamma=%u (min=%u max=%u)\n", info.yGammaRangeValue.value, info.yGammaRangeValue.min,
+         info.yGammaRangeValue.max);
+  Printf("  rgbGammaR=%u (min=%u max=%u)\n", info.rgbGammaRRangeValue.value, info.rgbGammaRRangeValue.min,
+         info.rgbGammaRRangeValue.max);
+  Printf("  rgbGammaG=%u (min=%u max=%u)\n", info.rgbGammaGRangeValue.value, info.rgbGammaGRangeValue.min,
+         info.rgbGammaGRangeValue.max);
+  Printf("  rgbGammaB=%u (min=%u max=%u)\n", info.rgbGammaBRangeValue.value, info.rgbGammaBRangeValue.min,
+         info.rgbGammaBRangeValue.max);
   return 0;
 }
 
@@ -50,23 +50,23 @@ int CmdVideoColorGet(int argc, char **argv, bool useDefault) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--handle-index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --handle-index\n");
+        Printf("Missing value for --handle-index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &handleIndex)) {
-        std::printf("Invalid handle index: %s\n", argv[i + 1]);
+        Printf("Invalid handle index: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   NvDisplayHandle handle = NULL;
   if (!GetDisplayHandleByIndex(handleIndex, &handle)) {
-    std::printf("Display handle index %u not found.\n", handleIndex);
+    Printf("Display handle index %u not found.\n", handleIndex);
     return 1;
   }
 
@@ -99,11 +99,11 @@ int CmdVideoColorSet(int argc, char **argv) {
   for (int i = 0; i < argc; ++i) {
     if (std::strcmp(argv[i], "--handle-index") == 0) {
       if (i + 1 >= argc) {
-        std::printf("Missing value for --handle-index\n");
+        Printf("Missing value for --handle-index\n");
         return 1;
       }
       if (!ParseUint(argv[i + 1], &handleIndex)) {
-        std::printf("Invalid handle index: %s\n", argv[i + 1]);
+        Printf("Invalid handle index: %s\n", argv[i + 1]);
         return 1;
       }
       ++i;
@@ -111,7 +111,7 @@ int CmdVideoColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--brightness") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &brightness)) {
-        std::printf("Invalid brightness.\n");
+        Printf("Invalid brightness.\n");
         return 1;
       }
       hasBrightness = true;
@@ -120,7 +120,7 @@ int CmdVideoColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--contrast") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &contrast)) {
-        std::printf("Invalid contrast.\n");
+        Printf("Invalid contrast.\n");
         return 1;
       }
       hasContrast = true;
@@ -129,7 +129,7 @@ int CmdVideoColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--hue") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &hue)) {
-        std::printf("Invalid hue.\n");
+        Printf("Invalid hue.\n");
         return 1;
       }
       hasHue = true;
@@ -138,7 +138,7 @@ int CmdVideoColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--saturation") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &saturation)) {
-        std::printf("Invalid saturation.\n");
+        Printf("Invalid saturation.\n");
         return 1;
       }
       hasSaturation = true;
@@ -147,7 +147,7 @@ int CmdVideoColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--color-temp") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &temp)) {
-        std::printf("Invalid color temperature.\n");
+        Printf("Invalid color temperature.\n");
         return 1;
       }
       hasTemp = true;
@@ -156,7 +156,7 @@ int CmdVideoColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--ygamma") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &yGamma)) {
-        std::printf("Invalid yGamma.\n");
+        Printf("Invalid yGamma.\n");
         return 1;
       }
       hasYGamma = true;
@@ -165,7 +165,7 @@ int CmdVideoColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--rgamma") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &rGamma)) {
-        std::printf("Invalid rGamma.\n");
+        Printf("Invalid rGamma.\n");
         return 1;
       }
       hasRGamma = true;
@@ -174,7 +174,7 @@ int CmdVideoColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--ggamma") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &gGamma)) {
-        std::printf("Invalid gGamma.\n");
+        Printf("Invalid gGamma.\n");
         return 1;
       }
       hasGGamma = true;
@@ -183,7 +183,7 @@ int CmdVideoColorSet(int argc, char **argv) {
     }
     if (std::strcmp(argv[i], "--bgamma") == 0) {
       if (i + 1 >= argc || !ParseUint(argv[i + 1], &bGamma)) {
-        std::printf("Invalid bGamma.\n");
+        Printf("Invalid bGamma.\n");
         return 1;
       }
       hasBGamma = true;
@@ -200,26 +200,26 @@ int CmdVideoColorSet(int argc, char **argv) {
       hasControlSetting = true;
       continue;
     }
-    std::printf("Unknown option: %s\n", argv[i]);
+    Printf("Unknown option: %s\n", argv[i]);
     return 1;
   }
 
   if (!(hasBrightness || hasContrast || hasHue || hasSaturation || hasTemp || hasYGamma || hasRGamma || hasGGamma ||
         hasBGamma || hasControlSetting)) {
-    std::printf("No values specified.\n");
+    Printf("No values specified.\n");
     return 1;
   }
 
   NvDisplayHandle handle = NULL;
   if (!GetDisplayHandleByIndex(handleIndex, &handle)) {
-    std::printf("Display handle index %u not found.\n", handleIndex);
+    Printf("Display handle index %u not found.\n", handleIndex);
     return 1;
   }
 
   NV_VIDEO_COLORCONTROL_INFO info = {};
   info.version = NV_VIDEO_COLORCONTROL_NVAPI_VER;
   NvAPI_Status status = NVAPI_NOT_SUPPORTED;
-  // Deprecated in release 455: NvAPI_Video_ColorControl_Get(handle, &info);
+  // Deprecated in release 455: NvApi().NvAPI_Video_ColorControl_Get(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Video_ColorControl_Get failed", status);
     return 1;
@@ -236,26 +236,26 @@ int CmdVideoColorSet(int argc, char **argv) {
   if (hasBGamma) info.rgbGammaBRangeValue.value = bGamma;
   if (hasControlSetting) info.colorControlSettings = controlSetting;
 
-  std::printf("Video color set request:\n");
-  if (hasBrightness) std::printf("  brightness=%u\n", brightness);
-  if (hasContrast) std::printf("  contrast=%u\n", contrast);
-  if (hasHue) std::printf("  hue=%u\n", hue);
-  if (hasSaturation) std::printf("  saturation=%u\n", saturation);
-  if (hasTemp) std::printf("  color-temp=%u\n", temp);
-  if (hasYGamma) std::printf("  ygamma=%u\n", yGamma);
-  if (hasRGamma) std::printf("  rgamma=%u\n", rGamma);
-  if (hasGGamma) std::printf("  ggamma=%u\n", gGamma);
-  if (hasBGamma) std::printf("  bgamma=%u\n", bGamma);
-  if (hasControlSetting) std::printf("  controlSetting=%u\n", controlSetting);
+  Printf("Video color set request:\n");
+  if (hasBrightness) Printf("  brightness=%u\n", brightness);
+  if (hasContrast) Printf("  contrast=%u\n", contrast);
+  if (hasHue) Printf("  hue=%u\n", hue);
+  if (hasSaturation) Printf("  saturation=%u\n", saturation);
+  if (hasTemp) Printf("  color-temp=%u\n", temp);
+  if (hasYGamma) Printf("  ygamma=%u\n", yGamma);
+  if (hasRGamma) Printf("  rgamma=%u\n", rGamma);
+  if (hasGGamma) Printf("  ggamma=%u\n", gGamma);
+  if (hasBGamma) Printf("  bgamma=%u\n", bGamma);
+  if (hasControlSetting) Printf("  controlSetting=%u\n", controlSetting);
 
   status = NVAPI_NOT_SUPPORTED;
-  // Deprecated in release 455: NvAPI_Video_ColorControl_Set(handle, &info);
+  // Deprecated in release 455: NvApi().NvAPI_Video_ColorControl_Set(handle, &info);
   if (status != NVAPI_OK) {
     PrintNvapiError("NvAPI_Video_ColorControl_Set failed", status);
     return 1;
   }
 
-  std::printf("Video color settings updated.\n");
+  Printf("Video color settings updated.\n");
   return 0;
 }
 
@@ -273,11 +273,11 @@ int CmdVideo(int argc, char **argv) {
     if (argc >= 2 && std::strcmp(argv[1], "get") == 0) { return CmdVideoColorGet(argc - 2, argv + 2, false); }
     if (argc >= 2 && std::strcmp(argv[1], "default") == 0) { return CmdVideoColorGet(argc - 2, argv + 2, true); }
     if (argc >= 2 && std::strcmp(argv[1], "set") == 0) { return CmdVideoColorSet(argc - 2, argv + 2); }
-    std::printf("Unknown video color subcommand: %s\n", argc >= 2 ? argv[1] : "");
+    Printf("Unknown video color subcommand: %s\n", argc >= 2 ? argv[1] : "");
     return 1;
   }
 
-  std::printf("Unknown video subcommand: %s\n", argv[0]);
+  Printf("Unknown video subcommand: %s\n", argv[0]);
   return 1;
 }
 
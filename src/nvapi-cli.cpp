@@ -4,12 +4,108 @@
  */
 
 #include "cli/commands.h"
+#include "cli/trace.h"
 
 #include <windows.h>
 
+#include <memory>
+
 using namespace nvcli;
 
-int main(int argc, char **argv) {
+namespace {
+// Commands that only read files or compute from their arguments run without NVAPI. When set, `required` must be one
+// of the arguments and `excluded` must not be; the live paths they keep (setting names, a live drs diff side) load
+// the driver through RequireNvApi.
+struct OfflineCommand {
+  const char *words[3];
+  const char *required;
+  const char *excluded;
+};
+
+const OfflineCommand kOfflineCommands[] = {
+    {{"log", "read", nullptr}, nullptr, nullptr},
+    {{"log", "info", nullptr}, nullptr, nullptr},
+    {{"drs", "diff", nullptr}, nullptr, nullptr},
+    {{"drs", "query", nullptr}, "--image", nullptr},
+    {{"display", "edid", nullptr}, "--file", nullptr},
+    {{"display", "custom", "calc"}, nullptr, nullptr},
+    {{"display", "custom", "validate"}, nullptr, "--id"},
+    {{"gpu", "vf", "compare"}, "--no-live", nullptr},
+};
+
+bool HasArg(int argc, char **argv, const char *arg) {
+  for (int i = 0; i < argc; ++i) {
+    if (std::strcmp(argv[i], arg) == 0) { return true; }
+  }
+  return false;
+}
+
+bool IsOfflineCommand(int argc, char **argv) {
+  for (const OfflineCommand &entry : kOfflineCommands) {
+    int depth = 0;
+    while (depth < 3 && entry.words[depth]) {
+      if (depth >= argc || std::strcmp(argv[depth], entry.words[depth]) != 0) { break; }
+      ++depth;
+    }
+    if (depth == 3 || !entry.words[depth]) {
+      if (entry.required && !HasArg(argc - depth, argv + depth, entry.required)) { continue; }
+      if (entry.excluded && HasArg(argc - depth, argv + depth, entry.excluded)) { continue; }
+      return true;
+    }
+  }
+  return false;
+}
+
+int Run(int argc, char **argv) {
+  const char *tracePath = nullptr;
+  while (argc >= 2 && std::strncmp(argv[1], "--", 2) == 0) {
+    if (std::strcmp(argv[1], "--backend") == 0) {
+      if (argc < 3) {
+        Printf("Missing value for --backend\n");
+        return 1;
+      }
+      if (!SelectNvApiBackend(argv[2])) { return 1; }
+      argc -= 2;
+      argv += 2;
+      continue;
+    }
+    if (std::strcmp(argv[1], "--jobs") == 0) {
+      NvU32 jobs = 0;
+      if (argc < 3 || !ParseUint(argv[2], &jobs)) {
+        Printf("Invalid value for --jobs\n");
+        return 1;
+      }
+      SetGpuJobs(jobs);
+      argc -= 2;
+      argv += 2;
+      continue;
+    }
+    if (std::strcmp(argv[1], "--format") == 0) {
+      OutputFormat format = OutputFormat::Text;
+      if (argc < 3 || !ParseOutputFormat(argv[2], &format)) {
+        Printf("Invalid value for --format (expected text, json, ndjson or csv)\n");
+        return 1;
+      }
+      SetOutputFormat(format);
+      argc -= 2;
+      argv += 2;
+      continue;
+    }
+    if (std::strcmp(argv[1], "--trace") == 0) {
+      if (argc < 3) {
+        Printf("Missing value for --trace\n");
+        return 1;
+      }
+      tracePath = argv[2];
+      argc -= 2;
+      argv += 2;
+      continue;
+    }
+    Printf("Unknown option: %s\n", argv[1]);
+    PrintUsage();
+    return 1;
+  }
+
   if (argc < 2) {
     PrintUsage();
     return 1;
@@ -24,30 +120,34 @@ int main(int argc, char **argv) {
     return 0;
   }
 
-  NvApiSession session;
-  if (!session.ok()) {
-    PrintNvapiError("NvAPI_InitializeEx failed", session.status());
-    return 1;
+  // Installed after the option loop so it wraps the backend selected by --backend regardless of option order.
+  if (tracePath && !EnableNvApiTrace(tracePath)) { return 1; }
+
+  std::unique_ptr<NvApiSession> session;
+  if (IsOfflineCommand(argc - 1, argv + 1)) {
+    DeferNvApi();
+  } else {
+    session.reset(new NvApiSession());
+  }
+  int result = 1;
+  if (session && !session->ok()) {
+    PrintNvapiError("NvAPI_InitializeEx failed", session->status());
+  } else if (std::strcmp(argv[1], "batch") == 0) {
+    result = CmdBatch(argc - 2, argv + 2);
+  } else if (std::strcmp(argv[1], "serve") == 0) {
+    result = CmdServe(argc - 2, argv + 2);
+  } else {
+    result = RunCommand(argc - 1, argv + 1);
   }
 
-  if (std::strcmp(argv[1], "info") == 0) { return CmdInfo(); }
-  if (std::strcmp(argv[1], "gpu") == 0) { return CmdGpu(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "display") == 0) { return CmdDisplay(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "mosaic") == 0) { return CmdMosaic(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "sli") == 0) { return CmdSli(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "gsync") == 0) { return CmdGsync(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "drs") == 0) { return CmdDrs(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "video") == 0) { return CmdVideo(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "hdmi") == 0) { return CmdHdmi(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "dp") == 0) { return CmdDp(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "pcf") == 0) { return CmdPcf(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "d3d") == 0) { return CmdD3d(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "ogl") == 0) { return CmdOgl(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "vr") == 0) { return CmdVr(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "stereo") == 0) { return CmdStereo(argc - 2, argv + 2); }
-  if (std::strcmp(argv[1], "sys") == 0) { return CmdSys(argc - 2, argv + 2); }
-
-  std::printf("Unknown command: %s\n", argv[1]);
-  PrintUsage();
-  return 1;
+  // Written before the session unloads so status strings can still be resolved.
+  if (tracePath && !WriteNvApiTrace() && result == 0) { result = 1; }
+  return result;
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  const int result = Run(argc, argv);
+  FinishOutput();
+  return result;
 }